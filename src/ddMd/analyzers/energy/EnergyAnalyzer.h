@@ -117,6 +117,9 @@ namespace DdMd
       #ifdef INTER_EXTERNAL
       Average* externalAveragePtr_;
       #endif
+      #ifdef INTER_COULOMB
+      Average* coulombAveragePtr_;
+      #endif
 
       // Number of sample per block average
       int nSamplePerBlock_;
@@ -19,6 +19,9 @@
 #ifdef INTER_EXTERNAL
 #include <ddMd/potentials/external/ExternalPotential.h>
 #endif
+#ifdef INTER_COULOMB
+#include <ddMd/potentials/coulomb/CoulombPotential.h>
+#endif
 #include <util/format/Int.h>
 #include <util/format/Dbl.h>
 #include <util/mpi/MpiLoader.h>
@@ -143,6 +146,13 @@ namespace DdMd
                outputFile_ << Dbl(external, 15);
             }
             #endif
+            #ifdef INTER_COULOMB
+            if (sim.hasCoulomb()) {
+               double coulomb = sim.coulombPotential().energy();
+               potential += coulomb;
+               outputFile_ << Dbl(coulomb, 15);
+            }
+            #endif
             outputFile_ << Dbl(kinetic + potential, 20)
                         << std::endl;
          }
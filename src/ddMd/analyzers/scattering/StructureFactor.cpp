@@ -12,7 +12,6 @@
 #include <ddMd/storage/AtomIterator.h>
 #include <ddMd/communicate/Exchanger.h>
 #include <util/boundary/Boundary.h>
-#include <util/math/Constants.h>
 #include <util/space/Dimension.h>
 #include <util/space/IntVector.h>
 #include <util/misc/ioUtil.h>
@@ -157,60 +156,10 @@ namespace DdMd
       }
 
       isFirstStep_ = false;
-      Vector position;
-      std::complex<double> expFactor;
-      double  product;
-      AtomIterator  atomIter;
-      int i, j, typeId;
+      int i, j;
 
       makeWaveVectors();
-
-      // Set all Fourier modes to zero
-      for (i = 0; i < nWave_; ++i) {
-         for (j = 0; j < nMode_; ++j) {
-            fourierModes_(i, j) = std::complex<double>(0.0, 0.0);
-         }
-      }
-
-      simulation().atomStorage().begin(atomIter);
-      for ( ; atomIter.notEnd(); ++atomIter) {
-         position = atomIter->position();
-         typeId   = atomIter->typeId();
- 
-         // Loop over wavevectors
-         for (i = 0; i < nWave_; ++i) {
-            
-            product = position.dot(waveVectors_[i]);
-            expFactor = exp( product*Constants::Im );
-            for (j = 0; j < nMode_; ++j) {
-               fourierModes_(i, j) += modes_(j, typeId)*expFactor;
-            }
-         }
-      }
-
-      for (i = 0; i < nWave_; ++i) {
-         for (j = 0; j < nMode_; ++j) {
-            totalFourierModes_(i, j) = std::complex<double>(0.0, 0.0);
-         }
-      }
- 
-      #ifdef UTIL_MPI
-      // Loop over wavevectors
-      for (int i = 0; i < nWave_; ++i) {
-         for (int j = 0; j < nMode_; ++j) {
-         //Sum values from all processors.
-         simulation().domain().communicator().
-                      Reduce(&fourierModes_(i, j), &totalFourierModes_(i, j),
-                             1, MPI::DOUBLE_COMPLEX, MPI::SUM, 0);
-         }
-      }
-      #else
-      for (int i = 0; i < nWave_; ++i) {
-         for (int j = 0; j < nMode_; ++j) {
-            totalFourierModes_(i, j) = fourierModes_(i, j);
-         }
-      }
-      #endif
+      computeFourierModes();
 
       if (simulation().domain().isMaster()) {
          // Increment structure factors
@@ -243,6 +192,36 @@ namespace DdMd
 
    }
 
+   /*
+   * Compute Fourier modes of local atoms, and sum over processors.
+   */
+   void StructureFactor::computeFourierModes() 
+   {
+      AtomIterator  atomIter;
+      if (!fourierSum_.isAllocated()) {
+         fourierSum_.setup(waveIntVectors_, nWave_, modes_);
+      }
+      fourierSum_.clear(simulation().boundary());
+      simulation().atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         fourierSum_.addAtom(atomIter->position(), atomIter->typeId());
+      }
+      fourierSum_.computeModes(fourierModes_);
+
+      #ifdef UTIL_MPI
+      // Sum values from all processors, in one reduction for all modes.
+      simulation().domain().communicator().
+                   Reduce(&fourierModes_(0, 0), &totalFourierModes_(0, 0),
+                          nWave_*nMode_, MPI::DOUBLE_COMPLEX, MPI::SUM, 0);
+      #else
+      for (int i = 0; i < nWave_; ++i) {
+         for (int j = 0; j < nMode_; ++j) {
+            totalFourierModes_(i, j) = fourierModes_(i, j);
+         }
+      }
+      #endif
+   }
+
    /*
    * Calculate floating point wavevectors.
    */
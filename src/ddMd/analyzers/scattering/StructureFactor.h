@@ -12,6 +12,7 @@
 #include <ddMd/simulation/Simulation.h>
 #include <util/containers/DMatrix.h>              // member template
 #include <util/containers/DArray.h>               // member template
+#include <util/math/FourierSum.h>                 // member
 
 #include <util/global.h>
 
@@ -164,6 +165,11 @@ namespace DdMd
       */
       DMatrix< std::complex<double> >  totalFourierModes_;
 
+      /**
+      * Evaluator for Fourier modes of local atoms.
+      */
+      FourierSum  fourierSum_;
+
       /**
       * Array of Miller index IntVectors for wavevectors.
       */
@@ -204,6 +210,16 @@ namespace DdMd
       */
       void makeWaveVectors();
 
+      /**
+      * Compute totalFourierModes_ for all wavevectors and modes.
+      *
+      * Must be called on all processors. On return, totalFourierModes_
+      * contains sums over all atoms on the master processor. The
+      * default implementation uses a direct sum over local atoms,
+      * followed by a reduction. Subclasses may override this.
+      */
+      virtual void computeFourierModes();
+
    };
 
 }
@@ -0,0 +1,216 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "StructureFactorFft.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <util/boundary/Boundary.h>
+#include <util/archives/Serializable_includes.h>
+#include <util/format/Int.h>
+#include <util/format/Dbl.h>
+
+#include <cstdlib>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   StructureFactorFft::StructureFactorFft(Simulation& simulation) 
+    : StructureFactorGrid(simulation),
+      gridSum_(),
+      shellSums_(),
+      shellCounts_(),
+      gridDimensions_(0),
+      order_(0),
+      qMax_(0.0),
+      nBin_(0)
+   {  setClassName("StructureFactorFft"); }
+
+   /*
+   * Destructor.
+   */
+   StructureFactorFft::~StructureFactorFft()
+   {}
+
+   /*
+   * Read parameters from file, and allocate arrays.
+   */
+   void StructureFactorFft::readParameters(std::istream& in) 
+   {
+      StructureFactorGrid::readParameters(in);
+      read<IntVector>(in, "gridDimensions", gridDimensions_);
+      read<int>(in, "order", order_);
+      read<double>(in, "qMax", qMax_);
+      read<int>(in, "nBin", nBin_);
+
+      // All wavevectors of the grid must lie below the Nyquist index
+      for (int i = 0; i < nWave_; ++i) {
+         for (int j = 0; j < Dimension; ++j) {
+            if (2*abs(waveIntVectors_[i][j]) >= gridDimensions_[j]) {
+               UTIL_THROW("hMax too large for gridDimensions");
+            }
+         }
+      }
+      if (nBin_ <= 0) {
+         UTIL_THROW("nBin must be positive");
+      }
+
+      if (simulation().domain().isMaster()) {
+         shellSums_.allocate(nBin_, nMode_);
+         shellCounts_.allocate(nBin_);
+         for (int i = 0; i < nBin_; ++i) {
+            for (int j = 0; j < nMode_; ++j) {
+               shellSums_(i, j) = 0.0;
+            }
+            shellCounts_[i] = 0.0;
+         }
+      }
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void StructureFactorFft::loadParameters(Serializable::IArchive &ar)
+   {
+      StructureFactorGrid::loadParameters(ar);
+      loadParameter<IntVector>(ar, "gridDimensions", gridDimensions_);
+      loadParameter<int>(ar, "order", order_);
+      loadParameter<double>(ar, "qMax", qMax_);
+      loadParameter<int>(ar, "nBin", nBin_);
+      if (simulation().domain().isMaster()) {
+         shellSums_.allocate(nBin_, nMode_);
+         shellCounts_.allocate(nBin_);
+         ar >> shellSums_;
+         ar >> shellCounts_;
+      }
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void StructureFactorFft::save(Serializable::OArchive &ar)
+   {
+      StructureFactorGrid::save(ar);
+      ar << gridDimensions_;
+      ar << order_;
+      ar << qMax_;
+      ar << nBin_;
+      ar << shellSums_;
+      ar << shellCounts_;
+   }
+
+   /*
+   * Increment structure factors.
+   */
+   void StructureFactorFft::sample(long iStep) 
+   {
+      StructureFactorGrid::sample(iStep);
+      if (simulation().domain().isMaster()) {
+         sampleShells();
+      }
+   }
+
+   /*
+   * Assign local atoms to grids, reduce grids and transform on master.
+   */
+   void StructureFactorFft::computeFourierModes() 
+   {
+      if (!gridSum_.isAllocated()) {
+         gridSum_.setup(gridDimensions_, order_, modes_);
+      }
+      gridSum_.clear(simulation().boundary());
+      AtomIterator atomIter;
+      simulation().atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         gridSum_.addAtom(atomIter->position(), atomIter->typeId());
+      }
+
+      #ifdef UTIL_MPI
+      // Sum density grids of all processors on the master.
+      MPI::Intracomm& communicator = simulation().domain().communicator();
+      const int size = gridSum_.grid().size();
+      for (int j = 0; j < nMode_; ++j) {
+         double* data = &gridSum_.density(j)[0];
+         if (simulation().domain().isMaster()) {
+            communicator.Reduce(MPI::IN_PLACE, data, size,
+                                MPI::DOUBLE, MPI::SUM, 0);
+         } else {
+            communicator.Reduce(data, data, size, MPI::DOUBLE, MPI::SUM, 0);
+         }
+      }
+      #endif
+
+      if (simulation().domain().isMaster()) {
+         gridSum_.computeModes(waveIntVectors_, nWave_, totalFourierModes_);
+      }
+   }
+
+   /*
+   * Add all grid wavevectors below qMax to shell accumulators (private).
+   */
+   void StructureFactorFft::sampleShells()
+   {
+      const Boundary& boundary = simulation().boundary();
+      const double volume = boundary.volume();
+      const double dq = qMax_/double(nBin_);
+      IntVector max, n;
+      Vector q0, q1, q;
+      int i, j, bin;
+      for (i = 0; i < Dimension; ++i) {
+         max[i] = (gridDimensions_[i] - 1)/2;
+      }
+      for (n[0] = -max[0]; n[0] <= max[0]; ++n[0]) {
+         q0.multiply(boundary.reciprocalBasisVector(0), double(n[0]));
+         for (n[1] = -max[1]; n[1] <= max[1]; ++n[1]) {
+            q1.multiply(boundary.reciprocalBasisVector(1), double(n[1]));
+            q1 += q0;
+            for (n[2] = -max[2]; n[2] <= max[2]; ++n[2]) {
+               if (n[0] == 0 && n[1] == 0 && n[2] == 0) continue;
+               q.multiply(boundary.reciprocalBasisVector(2), double(n[2]));
+               q += q1;
+               bin = int(q.abs()/dq);
+               if (bin >= nBin_) continue;
+               for (j = 0; j < nMode_; ++j) {
+                  shellSums_(bin, j) += std::norm(gridSum_.mode(n, j))/volume;
+               }
+               shellCounts_[bin] += 1.0;
+            }
+         }
+      }
+   }
+
+   /*
+   * Output star averages, and shell averages to *_shell.dat.
+   */
+   void StructureFactorFft::output()
+   {
+      StructureFactorGrid::output();
+
+      if (simulation().domain().isMaster()) {
+         simulation().fileMaster().openOutputFile(outputFileName("_shell.dat"),
+                                                  outputFile_);
+         const double dq = qMax_/double(nBin_);
+         for (int i = 0; i < nBin_; ++i) {
+            if (shellCounts_[i] > 0.0) {
+               outputFile_ << Dbl((double(i) + 0.5)*dq, 20, 8);
+               for (int j = 0; j < nMode_; ++j) {
+                  outputFile_ << Dbl(shellSums_(i, j)/shellCounts_[i], 20, 8);
+               }
+               outputFile_ << Int(int(shellCounts_[i]/double(nSample_)), 10);
+               outputFile_ << std::endl;
+            }
+         }
+         outputFile_.close();
+      }
+   }
+
+}
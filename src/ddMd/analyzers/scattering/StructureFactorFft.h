@@ -0,0 +1,137 @@
+#ifndef DDMD_STRUCTURE_FACTOR_FFT_H
+#define DDMD_STRUCTURE_FACTOR_FFT_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "StructureFactorGrid.h"
+#include <util/math/GridFourierSum.h>     // member
+#include <util/space/IntVector.h>         // member
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /**
+   * StructureFactorFft evaluates structure factors using a density grid.
+   *
+   * This class computes the same quantities as StructureFactorGrid, and
+   * writes the same output files, but evaluates Fourier modes by 
+   * assigning atoms to a density grid for each mode and taking a fast
+   * Fourier transform (see Util::GridFourierSum), rather than by a 
+   * direct sum over atoms for every wavevector. 
+   *
+   * Each processor assigns its local atoms to a full copy of each mode
+   * density grid. The grids are then summed onto the master processor,
+   * with one reduction per mode, and the master computes the FFT.
+   *
+   * In addition to star averages, this class outputs spherically 
+   * averaged structure factors, in which values for all wavevectors 
+   * of the FFT grid below the Nyquist index are binned into shells of
+   * equal width in |q|, up to qMax.
+   *
+   * \sa \ref ddMd_analyzer_StructureFactorFft_page "param file format"
+   *
+   * \ingroup DdMd_Analyzer_Module
+   */
+   class StructureFactorFft : public StructureFactorGrid
+   {
+
+   public:
+
+      /**	
+      * Constructor.
+      *
+      * \param simulation reference to parent DdMd::Simulation object
+      */
+      StructureFactorFft(Simulation &simulation);
+
+      /**
+      * Destructor.
+      */
+      ~StructureFactorFft();
+
+      /**
+      * Read parameters from file.
+      *
+      * Input format: parameters of StructureFactorGrid, followed by
+      *
+      *   - IntVector         gridDimensions  number of grid points
+      *   - int               order           B-spline order (2 = CIC)
+      *   - double            qMax            maximum |q| for shells
+      *   - int               nBin            number of shells
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Add particles to structure factor and shell accumulators.
+      *
+      * \param iStep  step counter
+      */
+      virtual void sample(long iStep);
+
+      /**
+      * Output star and shell averaged structure factors.
+      */
+      virtual void output();
+
+   protected:
+
+      /**
+      * Compute totalFourierModes_ by FFT of a reduced density grid.
+      */
+      virtual void computeFourierModes();
+
+   private:
+
+      /// Grid assignment and FFT evaluator.
+      GridFourierSum gridSum_;
+
+      /// Shell accumulators (shell index, mode index).
+      DMatrix<double> shellSums_;
+
+      /// Number of wavevectors added to each shell.
+      DArray<double> shellCounts_;
+
+      /// Number of grid points along each axis.
+      IntVector gridDimensions_;
+
+      /// B-spline assignment order.
+      int order_;
+
+      /// Maximum wavenumber for shells.
+      double qMax_;
+
+      /// Number of shells.
+      int nBin_;
+
+      /*
+      * Add all grid wavevectors to shell accumulators (master only).
+      */
+      void sampleShells();
+
+   };
+
+}
+#endif
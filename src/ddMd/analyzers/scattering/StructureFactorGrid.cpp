@@ -32,6 +32,12 @@ namespace DdMd
       isInitialized_(false)
    {  setClassName("StructureFactorGrid"); }
 
+   /*
+   * Destructor.
+   */
+   StructureFactorGrid::~StructureFactorGrid()
+   {}
+
    /*
    * Read parameters from file, and allocate data array.
    */
@@ -70,6 +70,11 @@ namespace DdMd
       */
       StructureFactorGrid(Simulation &simulation);
 
+      /**
+      * Destructor.
+      */
+      ~StructureFactorGrid();
+
       /**
       * Read parameters from file.
       *
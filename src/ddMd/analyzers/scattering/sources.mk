@@ -1,6 +1,7 @@
 ddMd_analyzers_scattering_=\
      ddMd/analyzers/scattering/StructureFactor.cpp\
      ddMd/analyzers/scattering/StructureFactorGrid.cpp\
+     ddMd/analyzers/scattering/StructureFactorFft.cpp\
      ddMd/analyzers/scattering/VanHove.cpp
 
 ddMd_analyzers_scattering_SRCS=\
@@ -0,0 +1,198 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "DdMdParallelTrajectoryWriter.h"
+
+#ifdef UTIL_MPI
+
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/communicate/Domain.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/chemistry/Atom.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryCounter.h>
+#include <util/misc/FileMaster.h>
+#include <util/space/Vector.h>
+
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   namespace
+   {
+      // Size of one atom record: id and 3 unsigned int coordinates
+      const int RecordSize = sizeof(int) + 3*sizeof(unsigned int);
+   }
+
+   /*
+   * Constructor.
+   */
+   DdMdParallelTrajectoryWriter::DdMdParallelTrajectoryWriter(Simulation& simulation)
+    : Analyzer(simulation),
+      buffer_(),
+      file_(),
+      offset_(0),
+      nAtom_(0),
+      isOpen_(false)
+   {  setClassName("DdMdParallelTrajectoryWriter"); }
+
+   /*
+   * Destructor.
+   */
+   DdMdParallelTrajectoryWriter::~DdMdParallelTrajectoryWriter()
+   {}
+
+   /*
+   * Read interval and outputFileName.
+   */
+   void DdMdParallelTrajectoryWriter::readParameters(std::istream& in)
+   {
+      readInterval(in);
+      readOutputFileName(in);
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void DdMdParallelTrajectoryWriter::loadParameters(Serializable::IArchive &ar)
+   {
+      loadInterval(ar);
+      loadOutputFileName(ar);
+   }
+
+   /*
+   * Save internal state to output archive.
+   */
+   void DdMdParallelTrajectoryWriter::save(Serializable::OArchive& ar)
+   {
+      saveInterval(ar);
+      saveOutputFileName(ar);
+   }
+
+   /*
+   * Open the file collectively and write the number of atoms.
+   */
+   void DdMdParallelTrajectoryWriter::setup()
+   {
+      Simulation& sim = simulation();
+      MPI::Intracomm& communicator = sim.domain().communicator();
+      sim.atomStorage().computeNAtomTotal(communicator);
+      nAtom_ = sim.atomStorage().nAtomTotal();
+      communicator.Bcast(&nAtom_, 1, MPI::INT, 0);
+
+      if (isOpen_) {
+         file_.Close();
+      }
+      std::string path = sim.fileMaster().outputFileName(outputFileName());
+      file_ = MPI::File::Open(communicator, path.c_str(),
+                              MPI::MODE_CREATE | MPI::MODE_WRONLY,
+                              MPI::INFO_NULL);
+      file_.Set_size(0);
+      isOpen_ = true;
+
+      if (sim.domain().isMaster()) {
+         file_.Write_at(0, &nAtom_, sizeof(int), MPI::BYTE);
+      }
+      offset_ = sizeof(int);
+   }
+
+   /*
+   * Write a frame collectively.
+   */
+   void DdMdParallelTrajectoryWriter::sample(long iStep)
+   {
+      if (!isAtInterval(iStep)) return;
+
+      Simulation& sim = simulation();
+      MPI::Intracomm& communicator = sim.domain().communicator();
+      Boundary& boundary = sim.boundary();
+      AtomStorage& storage = sim.atomStorage();
+      bool isMaster = sim.domain().isMaster();
+
+      // Serialize frame header: time step and boundary
+      MemoryOArchive ar;
+      int headerSize = sizeof(long) + memorySize(boundary);
+      ar.allocate(headerSize);
+      ar << iStep;
+      ar << boundary;
+      headerSize = ar.cursor() - ar.begin();
+
+      // Offset of first local atom within the atom records of this frame
+      int nLocal = storage.nAtom();
+      int first = 0;
+      communicator.Exscan(&nLocal, &first, 1, MPI::INT, MPI::SUM);
+      if (isMaster) {
+         first = 0;
+      }
+
+      // Pack local atom records, preceded by header on master
+      int size = nLocal*RecordSize;
+      if (isMaster) {
+         size += headerSize;
+      }
+      buffer_.resize(size);
+      char* cursor = size ? &buffer_[0] : 0;
+      if (isMaster) {
+         std::memcpy(cursor, ar.begin(), headerSize);
+         cursor += headerSize;
+      }
+      Vector r;
+      int id, j;
+      unsigned int ir;
+      bool isCartesian = storage.isCartesian();
+      AtomIterator atomIter;
+      for (storage.begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         id = atomIter->id();
+         if (isCartesian) {
+            boundary.transformCartToGen(atomIter->position(), r);
+         } else {
+            r = atomIter->position();
+         }
+         std::memcpy(cursor, &id, sizeof(int));
+         cursor += sizeof(int);
+         for (j = 0; j < Dimension; ++j) {
+            if (r[j] >= 1.0) r[j] -= 1.0;
+            if (r[j] <  0.0) r[j] += 1.0;
+            ir = floor( UINT_MAX*r[j] + r[j] + 0.5 );
+            std::memcpy(cursor, &ir, sizeof(unsigned int));
+            cursor += sizeof(unsigned int);
+         }
+      }
+
+      MPI::Offset offset = offset_;
+      if (!isMaster) {
+         offset += headerSize + MPI::Offset(first)*RecordSize;
+      }
+      file_.Write_at_all(offset, size ? &buffer_[0] : 0, size, MPI::BYTE);
+      offset_ += headerSize + MPI::Offset(nAtom_)*RecordSize;
+   }
+
+   /*
+   * Close the file.
+   */
+   void DdMdParallelTrajectoryWriter::clear()
+   {
+      if (isOpen_) {
+         file_.Close();
+         isOpen_ = false;
+      }
+   }
+
+   /*
+   * Close the file.
+   */
+   void DdMdParallelTrajectoryWriter::output()
+   {  clear(); }
+
+}
+#endif // ifdef UTIL_MPI
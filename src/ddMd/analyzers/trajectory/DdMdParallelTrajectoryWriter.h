@@ -0,0 +1,118 @@
+#ifndef DDMD_DDMD_PARALLEL_TRAJECTORY_WRITER_H
+#define DDMD_DDMD_PARALLEL_TRAJECTORY_WRITER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/analyzers/Analyzer.h>    // base class
+#include <util/containers/GArray.h>    // member
+#include <util/global.h>
+
+#ifdef UTIL_MPI
+
+namespace DdMd
+{
+
+   class Simulation;
+
+   using namespace Util;
+
+   /**
+   * Native binary trajectory format for ddSim, written with MPI-IO.
+   *
+   * Writes the same file format as DdMdTrajectoryWriter, but each
+   * processor writes the records of its own atoms directly to the
+   * shared file, at an offset obtained from a prefix sum of the number
+   * of atoms on lower ranks. The master processor writes the frame
+   * header (time step and boundary) as part of the same collective
+   * write. Atoms are thus not sorted by id within each frame, and no
+   * atoms are sent to the master.
+   *
+   * \ingroup DdMd_Analyzer_Module
+   */
+   class DdMdParallelTrajectoryWriter : public Analyzer
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent Simulation object
+      */
+      DdMdParallelTrajectoryWriter(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      virtual ~DdMdParallelTrajectoryWriter();
+
+      /**
+      * Read interval and outputFileName.
+      *
+      * \param in input parameter file
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Open the trajectory file and write the header.
+      */
+      virtual void setup();
+
+      /**
+      * Write a frame to file, if iStep is a multiple of interval.
+      *
+      * \param iStep MD time step index
+      */
+      virtual void sample(long iStep);
+
+      /**
+      * Close the trajectory file.
+      */
+      virtual void clear();
+
+      /**
+      * Close the trajectory file.
+      */
+      virtual void output();
+
+   private:
+
+      /// Buffer for local atom records.
+      GArray<char> buffer_;
+
+      /// Output file.
+      MPI::File file_;
+
+      /// Offset of next frame in file, in bytes.
+      MPI::Offset offset_;
+
+      /// Number of atoms in the file.
+      int nAtom_;
+
+      /// Is the output file open?
+      bool isOpen_;
+
+   };
+
+}
+#endif // ifdef UTIL_MPI
+#endif
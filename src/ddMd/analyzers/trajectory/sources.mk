@@ -2,6 +2,7 @@ ddMd_analyzers_trajectory_=\
      ddMd/analyzers/trajectory/ConfigWriter.cpp\
      ddMd/analyzers/trajectory/TrajectoryWriter.cpp\
      ddMd/analyzers/trajectory/DdMdTrajectoryWriter.cpp\
+     ddMd/analyzers/trajectory/DdMdParallelTrajectoryWriter.cpp\
      ddMd/analyzers/trajectory/DdMdGroupTrajectoryWriter.cpp\
      ddMd/analyzers/trajectory/LammpsDumpWriter.cpp
 
@@ -236,6 +236,24 @@ namespace DdMd
       force() += f;
       buffer.decrementRecvSize();
    }
+
+   /*
+   * Pack ghost velocity.
+   */
+   void Atom::packVelocity(Buffer& buffer)
+   {
+      buffer.pack<Vector>(velocity());
+      buffer.incrementSendSize();
+   }
+
+   /*
+   * Unpack ghost velocity.
+   */
+   void Atom::unpackVelocity(Buffer& buffer)
+   {
+      buffer.unpack<Vector>(velocity());
+      buffer.decrementRecvSize();
+   }
    #endif
 
 }
@@ -210,6 +210,16 @@ namespace DdMd
       */
       bool isGhost() const;
 
+      /**
+      * Get the index of this atom within its parent AtomArray.
+      *
+      * Each Atom has a fixed array index that is set when the parent
+      * AtomArray is allocated. Local atoms and ghosts are stored in 
+      * different arrays, so this index is unique only among atoms with
+      * the same value of isGhost().
+      */
+      int arrayId() const;
+
       /**
       * Get the position Vector (const reference).
       */
@@ -334,6 +344,24 @@ namespace DdMd
       */
       void unpackForce(Buffer& buffer);
 
+      /**
+      * Pack ghost Atom velocity into send buffer.
+      *
+      * Packs velocity Vector, increments buffer sendSize counter.
+      *
+      * \param buffer communication buffer
+      */
+      void packVelocity(Buffer& buffer);
+
+      /**
+      * Unpack velocity of ghost Atom from recv buffer.
+      *
+      * Unpacks velocity Vector, decrements buffer recvSize counter.
+      *
+      * \param buffer communication buffer
+      */
+      void unpackVelocity(Buffer& buffer);
+
       //@}
       #endif
 
@@ -446,6 +474,15 @@ namespace DdMd
       return bool(localId_ & 1);
    }
 
+   /*
+   * Get index of this atom in its parent AtomArray.
+   */
+   inline int Atom::arrayId() const
+   {
+      // Strip least significant bit (ghost flag) of localId_
+      return int(localId_ >> 1);
+   }
+
    /*
    * Get position by reference.
    */
@@ -13,11 +13,23 @@ namespace DdMd
 
    using namespace Util;
 
+   /*
+   * Charges are disabled by default.
+   */
+   bool AtomType::hasCharge_ = false;
+
+   /*
+   * Set the hasCharge_ static flag.
+   */
+   void AtomType::setHasCharge(bool hasCharge)
+   {  hasCharge_ = hasCharge; }
+
    /*
    * Constructor
    */
    AtomType::AtomType()
     : mass_(1.0),
+      charge_(0.0),
       name_(),
       id_(-1) 
    {}
@@ -35,6 +47,9 @@ namespace DdMd
    {
       in >> atomType.name_;
       in >> atomType.mass_;
+      if (AtomType::hasCharge_) {
+         in >> atomType.charge_;
+      }
       return in;
    }
    
@@ -49,6 +64,10 @@ namespace DdMd
       out.width(Parameter::Width);
       out.precision(Parameter::Precision);
       out << atomType.mass_;
+      if (AtomType::hasCharge_) {
+         out.width(Parameter::Width);
+         out << atomType.charge_;
+      }
       return out;
    }
 
@@ -74,8 +93,10 @@ namespace Util
    {
       std::string name = data.name();
       double      mass = data.mass();
+      double      charge = data.charge();
       send<std::string>(comm, name, dest, tag);
       send<double>(comm, mass, dest, tag);
+      send<double>(comm, charge, dest, tag);
    }
 
    template <>
@@ -83,10 +104,13 @@ namespace Util
    {
       std::string name;
       double      mass; 
+      double      charge; 
       recv<std::string>(comm, name, source, tag);
       recv<double>(comm, mass, source, tag);
+      recv<double>(comm, charge, source, tag);
       data.setName(name);
       data.setMass(mass);
+      data.setCharge(charge);
    }
 
    template <>
@@ -94,16 +118,20 @@ namespace Util
    {
       std::string name;
       double      mass; 
+      double      charge; 
       int         rank = comm.Get_rank();
       if (rank == root) {
          name = data.name();
          mass = data.mass();
+         charge = data.charge();
       }
       bcast<std::string>(comm, name, root);
       bcast<double>(comm, mass, root);
+      bcast<double>(comm, charge, root);
       if (rank != root) {
          data.setName(name);
          data.setMass(mass);
+         data.setCharge(charge);
       }
    }
 
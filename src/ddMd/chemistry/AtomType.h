@@ -18,8 +18,9 @@ namespace DdMd
    /**
    * Descriptor for a type of Atom.
    *
-   * An AtomTypeType has a mass, a name string, and an integer id.
-   * [It will later acquire a charge.]
+   * An AtomType has a mass, a name string, an integer id and a charge.
+   * The charge is read from and written to file, and serialized, only
+   * if the static hasCharge flag is set (see setHasCharge()).
    *
    * \ingroup DdMd_Chemistry_Module
    */
@@ -57,6 +58,20 @@ namespace DdMd
       */
       void setName(std::string name);
 
+      /**
+      * Set the charge.
+      *
+      * \param charge atom charge
+      */
+      void setCharge(double charge);
+
+      /**
+      * Enable (true) or disable (false) input and output of charges.
+      *
+      * \param hasCharge new value for hasCharge static bool flag.
+      */
+      static void setHasCharge(bool hasCharge);
+
       //@}
       /// \name Accessors
       //@{
@@ -70,6 +85,12 @@ namespace DdMd
       /// Get the index.
       int id() const;
 
+      /// Get the charge.
+      double charge() const;
+
+      /// Are charges enabled?
+      static bool hasCharge();
+
       //@}
 
       #ifdef UTIL_MPI
@@ -81,9 +102,15 @@ namespace DdMd
 
    private:
 
-      /// Name of type.
+      /// Static member determines if charges are read and written.
+      static bool hasCharge_;
+
+      /// Mass of type.
       double       mass_;
 
+      /// Charge of type.
+      double       charge_;
+
       /// Name of type.
       std::string  name_;
 
@@ -122,6 +149,18 @@ namespace DdMd
    inline int  AtomType::id() const
    {  return id_; }
 
+   // Set the charge.
+   inline void AtomType::setCharge(double charge)
+   {  charge_ = charge; }
+
+   // Get the charge.
+   inline double AtomType::charge() const
+   {  return charge_; }
+
+   // Are charges enabled?
+   inline bool AtomType::hasCharge()
+   {  return hasCharge_; }
+
    // Friend operator declarations
 
    /**
@@ -129,7 +168,9 @@ namespace DdMd
    *
    * Format:
    *
-   *    name  mass
+   *    name  mass  [charge]
+   *
+   * The charge is read only if AtomType::hasCharge() is true.
    *
    * \param in        input stream
    * \param atomType  AtomType to be read from stream
@@ -142,7 +183,7 @@ namespace DdMd
    *
    * Format, one one line with no line break:
    *
-   *    name  mass
+   *    name  mass  [charge]
    *
    * \param out      output stream
    * \param atomType AtomType to be written to stream
@@ -162,6 +203,9 @@ namespace DdMd
    {
       ar & atomType.name_;
       ar & atomType.mass_;
+      if (AtomType::hasCharge_) {
+         ar & atomType.charge_;
+      }
    }
 
 }
@@ -40,6 +40,10 @@ namespace DdMd
       atomCapacity_(-1),
       ghostCapacity_(-1),
       maxSendLocal_(0),
+      #ifdef UTIL_MPI
+      sendBytes_(0),
+      isSendRecvActive_(false),
+      #endif
       isInitialized_(false)
    {  setClassName("Buffer"); }
 
@@ -318,13 +322,23 @@ namespace DdMd
    */
    void Buffer::sendRecv(MPI::Intracomm& comm, int source, int dest)
    {
+      beginSendRecv(comm, source, dest);
+      endSendRecv();
+   }
 
-      MPI::Request request[2];
-      int  sendBytes = 0;
+   /*
+   * Begin nonblocking receive from source and send to dest.
+   */
+   void 
+   Buffer::beginSendRecv(MPI::Intracomm& comm, int source, int dest)
+   {
       int  myRank    = comm.Get_rank();
       int  comm_size = comm.Get_size();
 
       // Preconditions
+      if (isSendRecvActive_) {
+         UTIL_THROW("A nonblocking sendRecv is already in progress");
+      }
       if (dest > comm_size - 1 || dest < 0) {
          UTIL_THROW("Destination rank out of bounds");
       }
@@ -339,23 +353,58 @@ namespace DdMd
       }
 
       // Start nonblocking receive.
-      request[0] = comm.Irecv(recvBufferBegin_, bufferCapacity_ ,
-                              MPI::CHAR, source, 5);
+      requests_[0] = comm.Irecv(recvBufferBegin_, bufferCapacity_ ,
+                                MPI::CHAR, source, 5);
 
       // Start nonblocking send.
-      sendBytes = sendPtr_ - sendBufferBegin_;
-      request[1] = comm.Isend(sendBufferBegin_, sendBytes , MPI::CHAR, dest, 5);
+      sendBytes_ = sendPtr_ - sendBufferBegin_;
+      requests_[1] = comm.Isend(sendBufferBegin_, sendBytes_, 
+                                MPI::CHAR, dest, 5);
+
+      isSendRecvActive_ = true;
+   }
+
+   /*
+   * Test for completion of nonblocking sendRecv.
+   */
+   bool Buffer::testSendRecv()
+   {
+      if (!isSendRecvActive_) {
+         UTIL_THROW("No nonblocking sendRecv in progress");
+      }
+      if (!MPI::Request::Testall(2, requests_)) {
+         return false;
+      }
+      recvPtr_ = recvBufferBegin_;
+      isSendRecvActive_ = false;
+
+      // Update statistics.
+      if (sendBytes_ > maxSendLocal_) {
+         maxSendLocal_ = sendBytes_;
+      }
+      return true;
+   }
+
+   /*
+   * Wait for completion of nonblocking sendRecv.
+   */
+   void Buffer::endSendRecv()
+   {
+      if (!isSendRecvActive_) {
+         UTIL_THROW("No nonblocking sendRecv in progress");
+      }
 
       // Wait for completion of receive.
-      request[0].Wait();
+      requests_[0].Wait();
       recvPtr_ = recvBufferBegin_;
 
       // Wait for completion of send.
-      request[1].Wait();
+      requests_[1].Wait();
+      isSendRecvActive_ = false;
 
       // Update statistics.
-      if (sendBytes > maxSendLocal_) {
-         maxSendLocal_ = sendBytes;
+      if (sendBytes_ > maxSendLocal_) {
+         maxSendLocal_ = sendBytes_;
       }
    }
 
@@ -56,12 +56,13 @@ namespace DdMd
    *   - GHOST   : a ghost atom (position, id and typeId)
    *   - UPDATE  : an update of a ghost atom position
    *   - FORCE   : a force vector for use in a reverse update
+   *   - VELOCITY: an update of a ghost atom velocity
    *   - GROUP2  : a Group<2> (bond)
    *   - GROUP3  : a Group<3> (angle)
    *   - GROUP4  : a Group<4> (dihedral)
    *   - SPECIAL : specialized nonstandard data type
    *   
-   * The standard ATOM, GHOST, UPDATE, FORCE, and GROUP(2,3,4) types
+   * The standard ATOM, GHOST, UPDATE, FORCE, VELOCITY and GROUP(2,3,4) types
    * are used in the implementation of the Exchanger class.
    *
    * The DdMd::Atom  class and DdMd::Group class template provide
@@ -222,7 +223,7 @@ namespace DdMd
       /**
       * Enumeration of types of data to be sent in blocks. 
       */
-      enum BlockDataType {NONE, ATOM, GHOST, UPDATE, FORCE, 
+      enum BlockDataType {NONE, ATOM, GHOST, UPDATE, FORCE, VELOCITY,
                           GROUP2, GROUP3, GROUP4, SPECIAL};
 
       /**
@@ -386,6 +387,40 @@ namespace DdMd
       */
       void sendRecv(MPI::Intracomm& comm, int source, int dest);
 
+      /**
+      * Begin a nonblocking sendRecv operation.
+      *
+      * Posts a nonblocking receive from processor source and a 
+      * nonblocking send to processor dest, and returns immediately.
+      * The send buffer may not be modified and the receive buffer may 
+      * not be read until the operation is completed by a call to 
+      * endSendRecv(), or by a call to testSendRecv() that returns true.
+      *
+      * \param comm   MPI communicator object
+      * \param source MPI rank of processor from which data is sent
+      * \param dest   MPI rank of processor to which data is sent
+      */
+      void beginSendRecv(MPI::Intracomm& comm, int source, int dest);
+
+      /**
+      * Test for completion of a nonblocking sendRecv, without waiting.
+      *
+      * If both the send and receive are complete, this function sets
+      * up the receive buffer for unpacking, exactly as endSendRecv(), 
+      * and returns true. Otherwise, it returns false.
+      */
+      bool testSendRecv();
+
+      /**
+      * Wait for completion of a nonblocking sendRecv operation.
+      */
+      void endSendRecv();
+
+      /**
+      * Is a nonblocking sendRecv operation in progress?
+      */
+      bool isSendRecvActive() const;
+
       /**
       * Send a complete buffer.
       *
@@ -549,6 +584,17 @@ namespace DdMd
       /// Maximum size used for send buffers on any processor, in bytes.
       Setable<int> maxSend_;
 
+      #ifdef UTIL_MPI
+      /// Requests for a nonblocking sendRecv (0=receive, 1=send).
+      MPI::Request requests_[2];
+
+      /// Number of bytes sent by a nonblocking sendRecv.
+      int sendBytes_;
+
+      /// Is a nonblocking sendRecv in progress?
+      bool isSendRecvActive_;
+      #endif
+
       /// Has this buffer been initialized ?
       bool isInitialized_;
 
@@ -613,5 +659,13 @@ namespace DdMd
    inline void Buffer::decrementRecvSize()
    { --recvSize_; }
 
+   #ifdef UTIL_MPI
+   /*
+   * Is a nonblocking sendRecv in progress?
+   */
+   inline bool Buffer::isSendRecvActive() const
+   {  return isSendRecvActive_; }
+   #endif
+
 }
 #endif
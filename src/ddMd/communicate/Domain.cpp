@@ -22,9 +22,13 @@ namespace DdMd
       destRanks_(),
       shift_(),
       gridDimensions_(),
+      restartGridDimensions_(),
+      hasRestartGridDimensions_(false),
       gridCoordinates_(),
       gridRank_(-1),
       gridIsPeriodic_(),
+      gridBounds_(),
+      restartGridBounds_(),
       #if UTIL_MPI
       intracommPtr_(0),
       #endif
@@ -104,16 +108,56 @@ namespace DdMd
          UTIL_THROW("Already initialized");
       }
 
-      // Read processor grid dimensions and initialize
+      // Read processor grid dimensions
       loadParameter<IntVector>(ar, "gridDimensions", gridDimensions_);
+
+      // Load non-uniform domain boundaries (optional)
+      int maxN = 0;
+      for (int i = 0; i < Dimension; ++i) {
+         if (gridDimensions_[i] > maxN) maxN = gridDimensions_[i];
+      }
+      bool hasGridBounds 
+         = loadDMatrix<double>(ar, "gridBounds", restartGridBounds_, 
+                               Dimension, maxN + 1, false).isActive();
+
+      // Initialize, and restore boundaries if the grid is unchanged
+      if (hasRestartGridDimensions_) {
+         gridDimensions_ = restartGridDimensions_;
+      }
       initialize();
+      if (hasGridBounds && !hasRestartGridDimensions_) {
+         DArray<double> bounds;
+         bounds.allocate(maxN + 1);
+         int i, k;
+         for (i = 0; i < Dimension; ++i) {
+            for (k = 0; k <= gridDimensions_[i]; ++k) {
+               bounds[k] = restartGridBounds_(i, k);
+            }
+            setGridBounds(i, bounds);
+         }
+      }
    }
 
    /*
    * Save internal state to an archive.
    */
    void Domain::save(Serializable::OArchive &ar)
-   {  ar << gridDimensions_; }
+   {  
+      ar << gridDimensions_; 
+
+      // Save domain boundaries only if they are not uniform
+      bool isUniform = true;
+      int i, k, n;
+      for (i = 0; i < Dimension; ++i) {
+         n = gridDimensions_[i];
+         for (k = 0; k <= n; ++k) {
+            if (gridBounds_(i, k) != double(k)/double(n)) {
+               isUniform = false;
+            }
+         }
+      }
+      Parameter::saveOptional(ar, gridBounds_, !isUniform);
+   }
   
    /*
    * Initialize data - called by readParameters and loadParameters (private).
@@ -147,6 +191,20 @@ namespace DdMd
       // Find grid coordinates for this processor
       gridCoordinates_ = grid_.position(gridRank_);
 
+      // Initialize uniformly spaced domain boundaries
+      int maxN = 0;
+      for (int i = 0; i < Dimension; ++i) {
+         if (gridDimensions_[i] > maxN) maxN = gridDimensions_[i];
+      }
+      gridBounds_.allocate(Dimension, maxN + 1);
+      for (int i = 0; i < Dimension; ++i) {
+         int n = gridDimensions_[i];
+         for (int k = 0; k < n; ++k) {
+            gridBounds_(i, k) = double(k)/double(n);
+         }
+         gridBounds_(i, n) = 1.0;
+      }
+
       IntVector sourceCoordinates;
       int       i, j, k, jp;
 
@@ -185,21 +243,43 @@ namespace DdMd
    }
 
    /*
-   * Return one of the boundaries of the domain owned by this processor.
+   * Override grid dimensions loaded from a restart archive.
    */
-   double Domain::domainBound(int i, int j) const
+   void Domain::setRestartGridDimensions(const IntVector& gridDimensions)
    {
-      // Preconditions
-      assert(isInitialized_);
-      assert(boundaryPtr_);
-      assert(i >= 0);
-      assert(i < Dimension);
-      assert(j >= 0);
-      assert(j < 2);
-
-      double dL;
-      dL = 1.0 / double(gridDimensions_[i]);
-      return (gridCoordinates_[i] + j)*dL;
+      if (isInitialized_) {
+         UTIL_THROW("Already initialized");
+      }
+      restartGridDimensions_ = gridDimensions;
+      hasRestartGridDimensions_ = true;
+   }
+
+   /*
+   * Set the domain boundaries along one axis.
+   */
+   void Domain::setGridBounds(int i, const DArray<double>& bounds)
+   {
+      if (!isInitialized_) {
+         UTIL_THROW("Domain is not initialized");
+      }
+      if (i < 0 || i >= Dimension) {
+         UTIL_THROW("Invalid Cartesian direction index");
+      }
+      int n = gridDimensions_[i];
+      if (bounds.capacity() < n + 1) {
+         UTIL_THROW("Too few grid bounds");
+      }
+      if (bounds[0] != 0.0 || bounds[n] != 1.0) {
+         UTIL_THROW("Outer grid bounds must be 0 and 1");
+      }
+      for (int k = 0; k < n; ++k) {
+         if (bounds[k+1] <= bounds[k]) {
+            UTIL_THROW("Grid bounds are not strictly increasing");
+         }
+      }
+      for (int k = 0; k <= n; ++k) {
+         gridBounds_(i, k) = bounds[k];
+      }
    }
 
    /*
@@ -211,19 +291,26 @@ namespace DdMd
       assert(isInitialized_);
       assert(boundaryPtr_);
 
-      double dL;
       IntVector r;
+      int n;
       for (int i = 0; i < Dimension; ++i) {
-         dL = 1.0 / double(gridDimensions_[i]);
-         r[i] = int(position[i] / dL);
-         if (r[i] < 0 || r[i] >= gridDimensions_[i]) {
+         n = gridDimensions_[i];
+         r[i] = int(position[i]*double(n));
+         if (r[i] < 0 || r[i] >= n) {
             Log::file() << "Cart i   = " << i << std::endl;
             Log::file() << "position = " << position[i] << std::endl;
-            Log::file() << "dL       = " << dL << std::endl;
             Log::file() << "r        = " << r[i] << std::endl;
-            Log::file() << "gridDim  = " << gridDimensions_[i] << std::endl;
+            Log::file() << "gridDim  = " << n << std::endl;
             UTIL_THROW("Invalid grid coordinate");
          }
+
+         // Start from slab for uniform bounds, then search locally
+         while (r[i] > 0 && position[i] < gridBounds_(i, r[i])) {
+            --r[i];
+         }
+         while (r[i] < n - 1 && position[i] >= gridBounds_(i, r[i] + 1)) {
+            ++r[i];
+         }
       }
       return grid_.rank(r);
    }
@@ -237,14 +324,12 @@ namespace DdMd
       assert(isInitialized_);
       assert(boundaryPtr_);
 
-      double dL;
       bool isIn = true;
       for (int i = 0; i < Dimension; ++i) {  
-         dL = 1.0 / double(gridDimensions_[i]);
-         if (position[i] <   gridCoordinates_[i]*dL) {
+         if (position[i] <  gridBounds_(i, gridCoordinates_[i])) {
             isIn = false;
          }
-         if (position[i] >= (gridCoordinates_[i] + 1)*dL) {
+         if (position[i] >= gridBounds_(i, gridCoordinates_[i] + 1)) {
             isIn = false;
          }
       }
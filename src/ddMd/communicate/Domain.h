@@ -12,6 +12,8 @@
 #include <util/boundary/Boundary.h>     // typedef used in interface
 #include <util/containers/FMatrix.h>    // member template
 #include <util/containers/FArray.h>     // member template
+#include <util/containers/DMatrix.h>    // member template
+#include <util/containers/DArray.h>     // used in interface
 #include <util/space/IntVector.h>        // member
 #include <util/space/Grid.h>             // member
 #include <util/space/Dimension.h>        // constant expression
@@ -66,6 +68,38 @@ namespace DdMd
       */
       void setBoundary(Boundary& boundary);
 
+      /**
+      * Set the domain boundaries along one axis of the processor grid.
+      *
+      * Domain boundaries are expressed as scaled (generalized) 
+      * coordinates. Element k of bounds is the lower boundary of 
+      * the slab of domains with gridCoordinate(i) == k, for
+      * 0 <= k < gridDimension(i), and bounds[gridDimension(i)] is 
+      * the upper boundary of the last slab. Boundaries must satisfy
+      * bounds[0] = 0, bounds[gridDimension(i)] = 1, and must be 
+      * strictly increasing.
+      *
+      * This function must be called with the same values on all 
+      * processors. It does not move any atoms: Atoms that lie outside
+      * the new domain are moved by the next call to Exchanger::exchange().
+      *
+      * \param i      index of Cartesian direction 0 <= i < Dimension
+      * \param bounds array of at least gridDimension(i) + 1 values
+      */
+      void setGridBounds(int i, const DArray<double>& bounds);
+
+      /**
+      * Override processor grid dimensions loaded from a restart file.
+      *
+      * If this is called before loadParameters, the dimensions given
+      * here replace those stored in the archive. This allows a job to
+      * be restarted on a different number of processors from a restart
+      * file with a sharded configuration (see ShardConfigIo).
+      *
+      * \param gridDimensions number of processors along each axis
+      */
+      void setRestartGridDimensions(const IntVector& gridDimensions);
+
       /** 
       * Read parameters and initialize.
       *
@@ -83,6 +117,11 @@ namespace DdMd
       /**
       * Save internal state to an archive.
       *
+      * Domain boundaries are saved only if they are not uniformly
+      * spaced, e.g., after they have been moved by a LoadBalancer. 
+      * Loaded boundaries are restored unless the grid dimensions
+      * are replaced by setRestartGridDimensions.
+      *
       * \param ar output/saving archive
       */
       virtual void save(Serializable::OArchive &ar);
@@ -174,6 +213,20 @@ namespace DdMd
       */
       double domainBound(int i, int j) const;
 
+      /**
+      * Get a boundary between slabs of domains along one grid axis.
+      *
+      * Returns the lower boundary of the slab of domains with grid
+      * coordinate k along axis i, or the upper boundary of the last
+      * slab if k == gridDimension(i). Bounds are uniformly spaced 
+      * unless modified by setGridBounds.
+      *
+      * \param i index of Cartesian direction 0 <= i < Dimension
+      * \param k slab index, 0 <= k <= gridDimension(i)
+      * \return boundary coordinate value
+      */
+      double gridBound(int i, int k) const;
+
       /**
       * Return rank of the processor whose domain contains a position.
       *
@@ -217,6 +270,12 @@ namespace DdMd
       // Number of processors in each direction.
       IntVector gridDimensions_;
 
+      // Grid dimensions used in place of those loaded from an archive.
+      IntVector restartGridDimensions_;
+
+      // Has restartGridDimensions_ been set?
+      bool hasRestartGridDimensions_;
+
       // Coordinates of this domain in processor grid.
       IntVector gridCoordinates_;
 
@@ -226,6 +285,12 @@ namespace DdMd
       // Is each direction periodic (1 = true, 0 = false).
       FArray<bool, Dimension> gridIsPeriodic_;
 
+      // Boundaries between slabs of domains (scaled), gridBounds_(axis, k).
+      DMatrix<double> gridBounds_;
+
+      // Non-uniform boundaries loaded from an archive, if any.
+      DMatrix<double> restartGridBounds_;
+
       #if UTIL_MPI
 
       // Pointer to Intracommunicator.
@@ -342,6 +407,25 @@ namespace DdMd
       return shift_(i, j);  
    }
 
+   /*
+   * Return one of the boundaries of the domain owned by this processor.
+   */
+   inline double Domain::domainBound(int i, int j) const
+   {
+      assert(isInitialized_);
+      assert(j >= 0 && j < 2);
+      return gridBounds_(i, gridCoordinates_[i] + j);
+   }
+
+   /*
+   * Return a boundary between slabs of domains along axis i.
+   */
+   inline double Domain::gridBound(int i, int k) const
+   {
+      assert(isInitialized_);
+      return gridBounds_(i, k);
+   }
+
    /*
    * Has this Domain been initialized by calling readParam?
    */
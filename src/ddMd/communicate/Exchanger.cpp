@@ -44,7 +44,8 @@ namespace DdMd
       groupExchangers_(),
       bufferPtr_(0),
       pairCutoff_(-1.0),
-      timer_(Exchanger::NTime)
+      timer_(Exchanger::NTime),
+      updateId_(2*Dimension)
    {  groupExchangers_.reserve(8); }
 
    /*
@@ -816,75 +817,142 @@ namespace DdMd
    * Call on time steps for which no reneighboring is required.
    */
    void Exchanger::update()
+   {
+      beginUpdate();
+      endUpdate();
+   }
+
+   /*
+   * Begin nonblocking update of ghost atom coordinates.
+   */
+   void Exchanger::beginUpdate()
    {
       stamp(START);
       if (!atomStoragePtr_->isCartesian()) {
          UTIL_THROW("Error: Coordinates not Cartesian on entry to update");
       }
+      if (isUpdateActive()) {
+         UTIL_THROW("Error: Update already in progress");
+      }
+      updateId_ = 0;
+      postUpdate();
+   }
 
+   /*
+   * Make progress on a nonblocking update, without waiting.
+   */
+   bool Exchanger::testUpdate()
+   {
+      stamp(START);
+      while (isUpdateActive()) {
+         if (!bufferPtr_->testSendRecv()) {
+            return false;
+         }
+         stamp(SEND_RECV_UPDATE);
+         unpackUpdate();
+         ++updateId_;
+         postUpdate();
+      }
+      return true;
+   }
+
+   /*
+   * Complete nonblocking update of ghost atom coordinates.
+   */
+   void Exchanger::endUpdate()
+   {
+      stamp(START);
+      while (isUpdateActive()) {
+         bufferPtr_->endSendRecv();
+         stamp(SEND_RECV_UPDATE);
+         unpackUpdate();
+         ++updateId_;
+         postUpdate();
+      }
+   }
+
+   /*
+   * Post update message for current direction (private).
+   */
+   void Exchanger::postUpdate()
+   {
       Atom*  atomPtr;
       int    i, j, k, source, dest, size, shift;
 
-      for (i = 0; i < Dimension; ++i) {
-         for (j = 0; j < 2; ++j) {
-
-            // Shift on receiving processor for periodic boundary conditions
-            shift = domainPtr_->shift(i, j);
+      for ( ; updateId_ < 2*Dimension; ++updateId_) {
+         i = updateId_/2;
+         j = updateId_%2;
 
-            if (gridFlags_[i]) {
+         if (gridFlags_[i]) {
 
-               // Pack ghost positions for sending
-               bufferPtr_->clearSendBuffer();
-               bufferPtr_->beginSendBlock(Buffer::UPDATE);
-               size = sendArray_(i, j).size();
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &sendArray_(i, j)[k];
-                  atomPtr->packUpdate(*bufferPtr_);
-               }
-               bufferPtr_->endSendBlock();
-               stamp(PACK_UPDATE);
+            // Pack ghost positions for sending
+            bufferPtr_->clearSendBuffer();
+            bufferPtr_->beginSendBlock(Buffer::UPDATE);
+            size = sendArray_(i, j).size();
+            for (k = 0; k < size; ++k) {
+               atomPtr = &sendArray_(i, j)[k];
+               atomPtr->packUpdate(*bufferPtr_);
+            }
+            bufferPtr_->endSendBlock();
+            stamp(PACK_UPDATE);
 
-               // Send and receive buffers
-               source = domainPtr_->sourceRank(i, j);
-               dest   = domainPtr_->destRank(i, j);
-               bufferPtr_->sendRecv(domainPtr_->communicator(), source, dest);
-               stamp(SEND_RECV_UPDATE);
+            // Post nonblocking send and receive, then return
+            source = domainPtr_->sourceRank(i, j);
+            dest   = domainPtr_->destRank(i, j);
+            bufferPtr_->beginSendRecv(domainPtr_->communicator(), 
+                                      source, dest);
+            return;
 
-               // Unpack ghost positions
-               bufferPtr_->beginRecvBlock();
-               size = recvArray_(i, j).size();
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &recvArray_(i, j)[k];
-                  atomPtr->unpackUpdate(*bufferPtr_);
-                  if (shift) {
-                     boundaryPtr_->applyShift(atomPtr->position(), i, shift);
-                  }
-               }
-               bufferPtr_->endRecvBlock();
-               stamp(UNPACK_UPDATE);
+         } else {
 
-            } else {
+            // If grid().dimension(i) == 1, then copy positions of atoms
+            // listed in sendArray to those listed in the recvArray.
 
-               // If grid().dimension(i) == 1, then copy positions of atoms
-               // listed in sendArray to those listed in the recvArray.
+            // Shift on receiving processor for periodic boundary conditions
+            shift = domainPtr_->shift(i, j);
 
-               size = sendArray_(i, j).size();
-               assert(size == recvArray_(i, j).size());
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &recvArray_(i, j)[k];
-                  atomPtr->position() = sendArray_(i, j)[k].position();
-                  if (shift) {
-                     boundaryPtr_->applyShift(atomPtr->position(), i, shift);
-                  }
+            size = sendArray_(i, j).size();
+            assert(size == recvArray_(i, j).size());
+            for (k = 0; k < size; ++k) {
+               atomPtr = &recvArray_(i, j)[k];
+               atomPtr->position() = sendArray_(i, j)[k].position();
+               if (shift) {
+                  boundaryPtr_->applyShift(atomPtr->position(), i, shift);
                }
-               stamp(LOCAL_UPDATE);
-
             }
+            stamp(LOCAL_UPDATE);
 
-         } // transmit direction j = 0, 1
+         }
 
-      } // Cartesian direction i = 0, ..., Dimension - 1
+      }
+   }
 
+   /*
+   * Unpack ghost positions for current direction (private).
+   */
+   void Exchanger::unpackUpdate()
+   {
+      Atom*  atomPtr;
+      int    i, j, k, size, shift;
+
+      i = updateId_/2;
+      j = updateId_%2;
+
+      // Shift on receiving processor for periodic boundary conditions
+      shift = domainPtr_->shift(i, j);
+
+      // Unpack ghost positions
+      bufferPtr_->beginRecvBlock();
+      size = recvArray_(i, j).size();
+      for (k = 0; k < size; ++k) {
+         atomPtr = &recvArray_(i, j)[k];
+         atomPtr->unpackUpdate(*bufferPtr_);
+         if (shift) {
+            boundaryPtr_->applyShift(atomPtr->position(), i, shift);
+         }
+      }
+      bufferPtr_->endRecvBlock();
+      stamp(UNPACK_UPDATE);
    }
 
    /*
@@ -953,6 +1021,73 @@ namespace DdMd
 
    }
 
+   /*
+   * Update ghost atom velocities.
+   */
+   void Exchanger::updateVelocities()
+   {
+      stamp(START);
+      if (isUpdateActive()) {
+         UTIL_THROW("Error: Position update in progress");
+      }
+      Atom*  atomPtr;
+      int    i, j, k, source, dest, size;
+
+      for (i = 0; i < Dimension; ++i) {
+         for (j = 0; j < 2; ++j) {
+
+            if (gridFlags_[i]) {
+
+               // Pack ghost velocities for sending
+               bufferPtr_->clearSendBuffer();
+               bufferPtr_->beginSendBlock(Buffer::VELOCITY);
+               size = sendArray_(i, j).size();
+               for (k = 0; k < size; ++k) {
+                  atomPtr = &sendArray_(i, j)[k];
+                  atomPtr->packVelocity(*bufferPtr_);
+               }
+               bufferPtr_->endSendBlock();
+               stamp(PACK_UPDATE);
+
+               // Send and receive buffers
+               source = domainPtr_->sourceRank(i, j);
+               dest   = domainPtr_->destRank(i, j);
+               bufferPtr_->sendRecv(domainPtr_->communicator(),
+                                    source, dest);
+               stamp(SEND_RECV_UPDATE);
+
+               // Unpack ghost velocities
+               bufferPtr_->beginRecvBlock();
+               size = recvArray_(i, j).size();
+               for (k = 0; k < size; ++k) {
+                  atomPtr = &recvArray_(i, j)[k];
+                  atomPtr->unpackVelocity(*bufferPtr_);
+               }
+               bufferPtr_->endRecvBlock();
+               stamp(UNPACK_UPDATE);
+
+            } else {
+
+               // If grid().dimension(i) == 1, then copy velocities of
+               // atoms listed in sendArray to those listed in recvArray.
+               // Velocities, unlike positions, require no shift.
+
+               size = sendArray_(i, j).size();
+               assert(size == recvArray_(i, j).size());
+               for (k = 0; k < size; ++k) {
+                  recvArray_(i, j)[k].velocity() = 
+                                          sendArray_(i, j)[k].velocity();
+               }
+               stamp(LOCAL_UPDATE);
+
+            }
+
+         } // transmit direction j = 0 or 1
+
+      } // Cartesian direction i
+
+   }
+
    /*
    * Output statistics.
    */
@@ -99,6 +99,45 @@ namespace DdMd
       */
       void update();
 
+      /**
+      * Begin a nonblocking update of ghost atom coordinates.
+      *
+      * This method and endUpdate() together are equivalent to update(),
+      * but allow computation that does not require ghost coordinates
+      * to proceed while ghost coordinates are in transit. This method
+      * posts the first message, and returns immediately. Messages for
+      * subsequent directions are posted by testUpdate() or endUpdate()
+      * as the preceding messages arrive, because ghosts received in one 
+      * Cartesian direction may be forwarded in later directions.
+      */
+      void beginUpdate();
+
+      /**
+      * Make progress on a nonblocking update, without waiting.
+      *
+      * Unpacks any message that has arrived and posts the message for
+      * the next direction, if any. May be called any number of times
+      * between beginUpdate() and endUpdate().
+      *
+      * \return true if the update is complete, false otherwise.
+      */
+      bool testUpdate();
+
+      /**
+      * Complete a nonblocking update of ghost atom coordinates.
+      *
+      * Does nothing if no update is in progress.
+      */
+      void endUpdate();
+
+      /**
+      * Is a nonblocking ghost update in progress?
+      *
+      * Returns true after beginUpdate() and before completion of the 
+      * update by endUpdate() or testUpdate(). 
+      */
+      bool isUpdateActive() const;
+
       /**
       * Update ghost atom forces.
       * 
@@ -111,6 +150,18 @@ namespace DdMd
       */
       void reverseUpdate();
 
+      /**
+      * Update ghost atom velocities.
+      *
+      * This method uses the same communication pattern as update() to
+      * copy velocities of local atoms to their ghost images. Ghost
+      * velocities are not otherwise communicated, and are only needed 
+      * for velocity dependent pair forces, as in DPD. It may be called
+      * on any step after exchange(), but not while a nonblocking update
+      * of positions is in progress.
+      */
+      void updateVelocities();
+
       /**
       * Output statistics.
       */
@@ -201,6 +252,14 @@ namespace DdMd
       /// Timer
       DdTimer timer_;
 
+      /**
+      * Index of current direction in a nonblocking update.
+      *
+      * Equal to 2*i + j during communication along Cartesian axis i in
+      * direction j, and to 2*Dimension when no update is in progress.
+      */
+      int updateId_;
+
       /**
       * Exchange ownership of local atoms.
       *
@@ -220,6 +279,20 @@ namespace DdMd
       */
       void exchangeGhosts();
 
+      /**
+      * Post update message for current direction updateId_.
+      *
+      * Directions for which the grid dimension is 1 are updated by 
+      * local copying and skipped, until a message is posted or all 
+      * directions are complete.
+      */
+      void postUpdate();
+
+      /**
+      * Unpack received ghost positions for current direction updateId_.
+      */
+      void unpackUpdate();
+
       /**
       * Stamp internal timer.
       */
@@ -233,6 +306,10 @@ namespace DdMd
    inline DdTimer& Exchanger::timer()
    {  return timer_; }
 
+   // Is a nonblocking update in progress? (public).
+   inline bool Exchanger::isUpdateActive() const
+   {  return (updateId_ < 2*Dimension); }
+
    // Stamp internal timer (private)
    inline void Exchanger::stamp(unsigned int timeId) 
    {  timer_.stamp(timeId); }
@@ -0,0 +1,380 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "LoadBalancer.h"
+#include "Domain.h"
+#include <ddMd/storage/AtomStorage.h>
+#include <util/format/Dbl.h>
+#include <util/format/Int.h>
+#include <util/global.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   LoadBalancer::LoadBalancer()
+    : ParamComposite(),
+      bounds_(),
+      slabLoads_(),
+      slabLoadsSum_(),
+      loadMeasure_(),
+      pairTimeRef_(0.0),
+      pairCutoff_(0.0),
+      tolerance_(0.05),
+      initialImbalance_(0.0),
+      lastImbalance_(0.0),
+      currentImbalance_(0.0),
+      interval_(0),
+      lastStep_(0),
+      nBalance_(0),
+      nAttempt_(0),
+      isTimeMeasure_(false),
+      domainPtr_(0),
+      boundaryPtr_(0),
+      atomStoragePtr_(0)
+   {  setClassName("LoadBalancer"); }
+
+   /*
+   * Destructor.
+   */
+   LoadBalancer::~LoadBalancer()
+   {}
+
+   /*
+   * Set pointers to associated objects.
+   */
+   void LoadBalancer::associate(Domain& domain, const Boundary& boundary,
+                                AtomStorage& atomStorage)
+   {
+      domainPtr_ = &domain;
+      boundaryPtr_ = &boundary;
+      atomStoragePtr_ = &atomStorage;
+   }
+
+   /*
+   * Set minimum domain width.
+   */
+   void LoadBalancer::setPairCutoff(double pairCutoff)
+   {  pairCutoff_ = pairCutoff; }
+
+   /*
+   * Read interval, loadMeasure and optional tolerance.
+   */
+   void LoadBalancer::readParameters(std::istream& in)
+   {
+      read<int>(in, "interval", interval_);
+      read<std::string>(in, "loadMeasure", loadMeasure_);
+      tolerance_ = 0.05; // Default value for optional parameter
+      readOptional<double>(in, "tolerance", tolerance_);
+      initialize();
+   }
+
+   /*
+   * Load parameters from archive.
+   */
+   void LoadBalancer::loadParameters(Serializable::IArchive& ar)
+   {
+      loadParameter<int>(ar, "interval", interval_);
+      loadParameter<std::string>(ar, "loadMeasure", loadMeasure_);
+      loadParameter<double>(ar, "tolerance", tolerance_, false);
+      initialize();
+   }
+
+   /*
+   * Save parameters to archive.
+   */
+   void LoadBalancer::save(Serializable::OArchive& ar)
+   {
+      ar << interval_;
+      ar << loadMeasure_;
+      Parameter::saveOptional(ar, tolerance_, true);
+   }
+
+   /*
+   * Validate parameters and allocate arrays (private).
+   */
+   void LoadBalancer::initialize()
+   {
+      if (!domainPtr_) {
+         UTIL_THROW("LoadBalancer not associated");
+      }
+      if (!domainPtr_->isInitialized()) {
+         UTIL_THROW("Domain not initialized before LoadBalancer");
+      }
+      if (interval_ <= 0) {
+         UTIL_THROW("LoadBalancer interval must be positive");
+      }
+      if (loadMeasure_ == "atoms") {
+         isTimeMeasure_ = false;
+      } else
+      if (loadMeasure_ == "time") {
+         isTimeMeasure_ = true;
+      } else {
+         UTIL_THROW("Unknown loadMeasure: must be atoms or time");
+      }
+      if (tolerance_ < 0.0) {
+         UTIL_THROW("Negative LoadBalancer tolerance");
+      }
+
+      int nSlab = 0;
+      int maxN = 0;
+      for (int i = 0; i < Dimension; ++i) {
+         nSlab += domainPtr_->gridDimension(i);
+         if (domainPtr_->gridDimension(i) > maxN) {
+            maxN = domainPtr_->gridDimension(i);
+         }
+      }
+      bounds_.allocate(maxN + 1);
+      slabLoads_.allocate(nSlab);
+      slabLoadsSum_.allocate(nSlab);
+   }
+
+   /*
+   * Prepare to measure load at beginning of a run.
+   */
+   void LoadBalancer::setup(int iStep, double pairTime)
+   {
+      lastStep_ = iStep;
+      pairTimeRef_ = pairTime;
+   }
+
+   /*
+   * Is a balance step due?
+   */
+   bool LoadBalancer::isBalanceStep(int iStep) const
+   {
+      if (!isActive() || interval_ <= 0) {
+         return false;
+      }
+      return (iStep - lastStep_ >= interval_);
+   }
+
+   /*
+   * Move domain boundaries to equalize load per slab.
+   */
+   void LoadBalancer::balance(int iStep, double pairTime)
+   {
+      double load = localLoad(pairTime);
+      lastStep_ = iStep;
+      pairTimeRef_ = pairTime;
+      ++nAttempt_;
+
+      // Compute imbalance over all processors
+      lastImbalance_ = imbalance(load);
+      if (nAttempt_ == 1) {
+         initialImbalance_ = lastImbalance_;
+      }
+      if (lastImbalance_ <= 1.0 + tolerance_) {
+         return;
+      }
+
+      // Sum load of all processors in each slab, for all axes at once
+      int offset = 0;
+      int i, k;
+      for (i = 0; i < Dimension; ++i) {
+         for (k = 0; k < domainPtr_->gridDimension(i); ++k) {
+            slabLoads_[offset + k] = 0.0;
+         }
+         slabLoads_[offset + domainPtr_->gridCoordinate(i)] = load;
+         offset += domainPtr_->gridDimension(i);
+      }
+      #ifdef UTIL_MPI
+      domainPtr_->communicator().Allreduce(&slabLoads_[0], &slabLoadsSum_[0],
+                                  slabLoads_.capacity(), MPI::DOUBLE, MPI::SUM);
+      #else
+      for (k = 0; k < slabLoads_.capacity(); ++k) {
+         slabLoadsSum_[k] = slabLoads_[k];
+      }
+      #endif
+
+      // Compute and apply new boundaries along each axis
+      bool isModified = false;
+      offset = 0;
+      for (i = 0; i < Dimension; ++i) {
+         if (computeBounds(i, &slabLoadsSum_[offset])) {
+            domainPtr_->setGridBounds(i, bounds_);
+            isModified = true;
+         }
+         offset += domainPtr_->gridDimension(i);
+      }
+      if (isModified) {
+         ++nBalance_;
+      }
+   }
+
+   /*
+   * Compute new bounds along axis i (private).
+   */
+   bool LoadBalancer::computeBounds(int i, const double* loads)
+   {
+      int n = domainPtr_->gridDimension(i);
+      DArray<double>& bounds = bounds_;
+      int k, m;
+      for (k = 0; k <= n; ++k) {
+         bounds[k] = domainPtr_->gridBound(i, k);
+      }
+      if (n == 1) {
+         return false;
+      }
+
+      // Minimum width in scaled units, with margin for box fluctuations
+      double minWidth = 1.1*pairCutoff_/boundaryPtr_->length(i);
+      if (n*minWidth >= 1.0) {
+         return false;
+      }
+
+      double total = 0.0;
+      for (k = 0; k < n; ++k) {
+         total += loads[k];
+      }
+      if (total <= 0.0) {
+         return false;
+      }
+
+      // Place each interior bound at k/n of the cumulative load,
+      // interpolating linearly within each old slab.
+      double target, lower, upper, shift, maxShift;
+      double cumulative = 0.0;
+      m = 0;
+      for (k = 1; k < n; ++k) {
+         target = total*double(k)/double(n);
+         while (m < n - 1 && cumulative + loads[m] <= target) {
+            cumulative += loads[m];
+            ++m;
+         }
+         lower = domainPtr_->gridBound(i, m);
+         upper = domainPtr_->gridBound(i, m + 1);
+         shift = lower + (target - cumulative)*(upper - lower)/loads[m];
+         shift -= domainPtr_->gridBound(i, k);
+
+         // Move by at most half the width of either adjacent slab
+         maxShift = domainPtr_->gridBound(i, k)
+                  - domainPtr_->gridBound(i, k - 1);
+         if (domainPtr_->gridBound(i, k + 1)
+             - domainPtr_->gridBound(i, k) < maxShift) {
+            maxShift = domainPtr_->gridBound(i, k + 1)
+                     - domainPtr_->gridBound(i, k);
+         }
+         maxShift *= 0.5;
+         if (shift > maxShift) shift = maxShift;
+         if (shift < -maxShift) shift = -maxShift;
+         bounds[k] = domainPtr_->gridBound(i, k) + shift;
+      }
+
+      // Enforce minimum slab width
+      for (k = 1; k < n; ++k) {
+         if (bounds[k] < bounds[k-1] + minWidth) {
+            bounds[k] = bounds[k-1] + minWidth;
+         }
+      }
+      for (k = n - 1; k > 0; --k) {
+         if (bounds[k] > bounds[k+1] - minWidth) {
+            bounds[k] = bounds[k+1] - minWidth;
+         }
+      }
+
+      // Reject if constraints are violated, or if nothing moved
+      bool isModified = false;
+      double oldWidth;
+      for (k = 1; k < n; ++k) {
+         if (bounds[k] - bounds[k-1] < minWidth*(1.0 - 1.0E-10)) {
+            return false;
+         }
+         oldWidth = domainPtr_->gridBound(i, k) - domainPtr_->gridBound(i, k-1);
+         if (bounds[k] - domainPtr_->gridBound(i, k) < -0.5*oldWidth) {
+            return false;
+         }
+         oldWidth = domainPtr_->gridBound(i, k+1) - domainPtr_->gridBound(i, k);
+         if (bounds[k] - domainPtr_->gridBound(i, k) > 0.5*oldWidth) {
+            return false;
+         }
+         if (bounds[k] != domainPtr_->gridBound(i, k)) {
+            isModified = true;
+         }
+      }
+      return isModified;
+   }
+
+   /*
+   * Return the local load (private).
+   */
+   double LoadBalancer::localLoad(double pairTime) const
+   {
+      if (isTimeMeasure_) {
+         if (pairTime < pairTimeRef_) {
+            return pairTime;
+         }
+         return pairTime - pairTimeRef_;
+      } else {
+         return double(atomStoragePtr_->nAtom());
+      }
+   }
+
+   /*
+   * Return ratio of maximum to mean load (private).
+   */
+   double LoadBalancer::imbalance(double load) const
+   {
+      double max = load;
+      double sum = load;
+      int nProc = 1;
+      #ifdef UTIL_MPI
+      MPI::Intracomm& communicator = domainPtr_->communicator();
+      communicator.Allreduce(&load, &max, 1, MPI::DOUBLE, MPI::MAX);
+      communicator.Allreduce(&load, &sum, 1, MPI::DOUBLE, MPI::SUM);
+      nProc = communicator.Get_size();
+      #endif
+      if (sum <= 0.0) {
+         return 1.0;
+      }
+      return max*double(nProc)/sum;
+   }
+
+   /*
+   * Compute current load imbalance.
+   */
+   void LoadBalancer::computeStatistics(double pairTime)
+   {  currentImbalance_ = imbalance(localLoad(pairTime)); }
+
+   /*
+   * Output statistics (call on master).
+   */
+   void LoadBalancer::outputStatistics(std::ostream& out)
+   {
+      // Precondition
+      if (!domainPtr_->isMaster()) {
+         UTIL_THROW("May be called only on domain master");
+      }
+
+      out << std::endl;
+      out << "Load balance (max/mean ";
+      out << (isTimeMeasure_ ? "pair force time" : "atoms") << ")";
+      out << std::endl;
+      out << "Balance steps      " << Int(nBalance_, 12) << std::endl;
+      if (nAttempt_ > 0) {
+         out << "Initial imbalance  " << Dbl(initialImbalance_, 12, 4)
+             << std::endl;
+         out << "Before last step   " << Dbl(lastImbalance_, 12, 4)
+             << std::endl;
+      }
+      out << "Current imbalance  " << Dbl(currentImbalance_, 12, 4)
+          << std::endl;
+      for (int i = 0; i < Dimension; ++i) {
+         out << "Bounds[" << i << "]          ";
+         for (int k = 0; k <= domainPtr_->gridDimension(i); ++k) {
+            out << Dbl(domainPtr_->gridBound(i, k), 12, 4);
+         }
+         out << std::endl;
+      }
+      out << std::endl;
+   }
+
+}
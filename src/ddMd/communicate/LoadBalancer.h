@@ -0,0 +1,243 @@
+#ifndef DDMD_LOAD_BALANCER_H
+#define DDMD_LOAD_BALANCER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>  // base class
+#include <util/boundary/Boundary.h>     // typedef used in interface
+#include <util/containers/DArray.h>     // member template
+#include <util/space/Dimension.h>       // constant expression
+#include <util/global.h>
+
+#include <string>
+
+namespace DdMd
+{
+
+   class Domain;
+   class AtomStorage;
+
+   using namespace Util;
+
+   /**
+   * Dynamic load balancer that moves domain boundaries.
+   *
+   * A LoadBalancer periodically moves the boundaries between slabs of
+   * processor domains along each axis of the processor grid so as to
+   * equalize the load per slab. The load of each processor is taken to
+   * be either the number of atoms it owns (loadMeasure = atoms) or the
+   * wall clock time it spent computing pair forces since the previous
+   * balance step (loadMeasure = time). Boundaries remain planar, so
+   * each processor keeps the same six neighbors used by the Exchanger.
+   *
+   * New boundaries are obtained by interpolating the cumulative load
+   * along each axis, assuming a uniform load density within each slab.
+   * Each boundary moves by at most half the width of either adjacent
+   * slab, so that no atom needs to move by more than one domain per
+   * axis, and no slab is made thinner than the pair cutoff. Atoms are
+   * then moved to their new owners by the next Exchanger::exchange().
+   *
+   * Balancing is attempted only if the ratio of maximum to mean load
+   * exceeds 1 + tolerance.
+   *
+   * \ingroup DdMd_Communicate_Module
+   */
+   class LoadBalancer : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      LoadBalancer();
+
+      /**
+      * Destructor.
+      */
+      ~LoadBalancer();
+
+      /**
+      * Set pointers to associated objects.
+      *
+      * \param domain      associated Domain object
+      * \param boundary    associated Boundary object
+      * \param atomStorage associated AtomStorage object
+      */
+      void associate(Domain& domain, const Boundary& boundary,
+                     AtomStorage& atomStorage);
+
+      /**
+      * Set minimum domain width (pair cutoff, including skin).
+      *
+      * \param pairCutoff cutoff radius for pair list (potential + skin).
+      */
+      void setPairCutoff(double pairCutoff);
+
+      /**
+      * Read interval, loadMeasure and optional tolerance.
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load parameters from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save parameters to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /**
+      * Prepare to measure load at the beginning of a run.
+      *
+      * Call on all processors after the integrator timer is started.
+      *
+      * \param iStep    current time step index
+      * \param pairTime accumulated pair force time on this processor
+      */
+      void setup(int iStep, double pairTime);
+
+      /**
+      * Is a load balancing step due at time step iStep?
+      *
+      * Returns true if this object was activated in the parameter file
+      * and at least interval steps have passed since the last call to
+      * balance or setup.
+      *
+      * \param iStep current time step index
+      */
+      bool isBalanceStep(int iStep) const;
+
+      /**
+      * Move domain boundaries to equalize load.
+      *
+      * Must be called on all processors on an exchange step, while
+      * atomic coordinates are scaled, before Exchanger::exchange().
+      *
+      * \param iStep    current time step index
+      * \param pairTime accumulated pair force time on this processor
+      */
+      void balance(int iStep, double pairTime);
+
+      /**
+      * Compute current load imbalance (call on all processors).
+      *
+      * \param pairTime accumulated pair force time on this processor
+      */
+      void computeStatistics(double pairTime);
+
+      /**
+      * Output load balance statistics (call only on master).
+      *
+      * Must be preceded by a call to computeStatistics on all processors.
+      *
+      * \param out output stream
+      */
+      void outputStatistics(std::ostream& out);
+
+      /**
+      * Number of balance steps that moved domain boundaries.
+      */
+      int nBalance() const;
+
+   private:
+
+      /// Boundaries along one axis, for use in setGridBounds.
+      DArray<double> bounds_;
+
+      /// Load per slab of domains, concatenated for all axes.
+      DArray<double> slabLoads_;
+
+      /// Work array for reduction of slabLoads_.
+      DArray<double> slabLoadsSum_;
+
+      /// Name of load measure ("atoms" or "time").
+      std::string loadMeasure_;
+
+      /// Pair force time at previous balance or setup.
+      double pairTimeRef_;
+
+      /// Pair cutoff length (minimum domain width).
+      double pairCutoff_;
+
+      /// Threshold for max/mean load imbalance, minus 1.
+      double tolerance_;
+
+      /// Max/mean load before the first balance.
+      double initialImbalance_;
+
+      /// Max/mean load before the most recent balance.
+      double lastImbalance_;
+
+      /// Max/mean load at the most recent call to computeStatistics.
+      double currentImbalance_;
+
+      /// Number of steps between balance attempts.
+      int interval_;
+
+      /// Time step of previous balance attempt or setup.
+      int lastStep_;
+
+      /// Number of balance steps that moved boundaries.
+      int nBalance_;
+
+      /// Number of balance attempts.
+      int nAttempt_;
+
+      /// Is the load measured by pair force time?
+      bool isTimeMeasure_;
+
+      /// Pointer to associated Domain.
+      Domain* domainPtr_;
+
+      /// Pointer to associated Boundary.
+      const Boundary* boundaryPtr_;
+
+      /// Pointer to associated AtomStorage.
+      AtomStorage* atomStoragePtr_;
+
+      /*
+      * Validate loadMeasure_ and allocate arrays.
+      */
+      void initialize();
+
+      /*
+      * Return the local load of this processor.
+      */
+      double localLoad(double pairTime) const;
+
+      /*
+      * Return max/mean ratio of load over all processors.
+      */
+      double imbalance(double load) const;
+
+      /*
+      * Compute new bounds along axis i, given loads of slabs.
+      *
+      * Sets elements 0, ..., gridDimension(i) of bounds_, and returns
+      * true if these differ from the current bounds.
+      */
+      bool computeBounds(int i, const double* loads);
+
+   };
+
+   // Inline method
+
+   inline int LoadBalancer::nBalance() const
+   {  return nBalance_; }
+
+}
+#endif
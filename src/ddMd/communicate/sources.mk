@@ -3,6 +3,7 @@ ddMd_communicate_=\
     ddMd/communicate/Domain.cpp \
     ddMd/communicate/AtomDistributor.cpp \
     ddMd/communicate/Exchanger.cpp \
+    ddMd/communicate/LoadBalancer.cpp \
     ddMd/communicate/AtomCollector.cpp \
     ddMd/communicate/Plan.cpp 
 
@@ -29,6 +29,7 @@
 #include <ddMd/communicate/GroupDistributor.tpp> 
 #include <ddMd/chemistry/Atom.h>
 #include <ddMd/chemistry/MaskPolicy.h>
+#include <util/misc/FileMaster.h>
 #include <util/space/Vector.h>
 #include <util/mpi/MpiSendRecv.h>
 #include <util/mpi/MpiLoader.h>
@@ -194,6 +195,39 @@ namespace DdMd
       return nGroup;
    }
 
+   /*
+   * Open, read and close a configuration file (default implementation).
+   */
+   void ConfigIo::readConfigFile(FileMaster& fileMaster, 
+                                 const std::string& filename,
+                                 MaskPolicy maskPolicy)
+   {
+      std::ifstream inputFile;
+      if (domain().isMaster()) {
+         fileMaster.openInputFile(filename, inputFile);
+      }
+      readConfig(inputFile, maskPolicy);
+      if (domain().isMaster()) {
+         inputFile.close();
+      }
+   }
+
+   /*
+   * Open, write and close a configuration file (default implementation).
+   */
+   void ConfigIo::writeConfigFile(FileMaster& fileMaster, 
+                                  const std::string& filename)
+   {
+      std::ofstream outputFile;
+      if (domain().isMaster()) {
+         fileMaster.openOutputFile(filename, outputFile);
+      }
+      writeConfig(outputFile);
+      if (domain().isMaster()) {
+         outputFile.close();
+      }
+   }
+
    /*
    * Set Mask (exclusion list) for all atoms, based on bond data.
    */ 
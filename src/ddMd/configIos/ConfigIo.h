@@ -24,6 +24,8 @@
 
 #include <ddMd/chemistry/MaskPolicy.h>
 
+namespace Util { class FileMaster; }
+
 namespace DdMd
 {
 
@@ -157,6 +159,36 @@ namespace DdMd
       */
       virtual void writeConfig(std::ofstream& file) = 0;
 
+      /**
+      * Open, read and close a configuration file.
+      *
+      * Call on all processors. The default implementation opens the 
+      * file on the master processor, calls readConfig(std::ifstream&, 
+      * MaskPolicy), and closes the file. Subclasses that read a file 
+      * collectively from all processors may re-implement this.
+      *
+      * \param fileMaster FileMaster used to construct the file path
+      * \param filename   input file name, without prefix
+      * \param maskPolicy MaskPolicy to be used in setting atom masks
+      */
+      virtual void readConfigFile(FileMaster& fileMaster, 
+                                  const std::string& filename,
+                                  MaskPolicy maskPolicy);
+
+      /**
+      * Open, write and close a configuration file.
+      *
+      * Call on all processors. The default implementation opens the 
+      * file on the master processor, calls writeConfig(std::ofstream&),
+      * and closes the file. Subclasses that write a file collectively 
+      * from all processors may re-implement this.
+      *
+      * \param fileMaster FileMaster used to construct the file path
+      * \param filename   output file name, without prefix
+      */
+      virtual void writeConfigFile(FileMaster& fileMaster, 
+                                   const std::string& filename);
+
    protected:
 
       /**
@@ -0,0 +1,744 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "ParallelConfigIo.h"
+
+#ifdef UTIL_MPI
+
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/communicate/Domain.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/GroupStorage.tpp>
+#include <ddMd/storage/GroupIterator.h>
+#include <ddMd/chemistry/Atom.h>
+#include <ddMd/chemistry/Group.h>
+#include <ddMd/chemistry/MaskPolicy.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryIArchive.h>
+#include <util/archives/MemoryCounter.h>
+#include <util/misc/FileMaster.h>
+#include <util/containers/DArray.h>
+#include <util/containers/GArray.h>
+#include <util/space/Vector.h>
+
+#include <fstream>
+#include <cstring>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   namespace
+   {
+
+      // File identifier and format version
+      const char ParallelConfigMagic[8] = {'D','D','M','D','P','I','O','\0'};
+      const int  ParallelConfigVersion = 1;
+
+      // Number of int fields in header after the identifier
+      const int nHeaderInt = 7;
+
+      // Size of header preceding the serialized boundary, in bytes
+      const int HeaderSize = 8 + nHeaderInt*sizeof(int);
+
+      /*
+      * Return address of first element, or null if empty.
+      */
+      inline char* data(GArray<char>& buffer)
+      {  return buffer.size() ? &buffer[0] : 0; }
+
+      inline const char* data(const GArray<char>& buffer)
+      {  return buffer.size() ? &buffer[0] : 0; }
+
+      /*
+      * Append n raw bytes to a buffer.
+      */
+      inline void packBytes(GArray<char>& buffer, const char* ptr, int n)
+      {
+         if (n > 0) {
+            int size = buffer.size();
+            buffer.resize(size + n);
+            std::memcpy(&buffer[size], ptr, n);
+         }
+      }
+
+      /*
+      * Append raw bytes of a value to a buffer.
+      */
+      template <typename T>
+      inline void pack(GArray<char>& buffer, const T& value)
+      {  packBytes(buffer, reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+      /*
+      * Copy a value from a raw buffer and advance the cursor.
+      */
+      template <typename T>
+      inline void unpack(const char*& cursor, T& value)
+      {
+         std::memcpy(&value, cursor, sizeof(T));
+         cursor += sizeof(T);
+      }
+
+      /*
+      * Overwrite a value in a raw buffer and advance the cursor.
+      */
+      template <typename T>
+      inline void repack(char*& cursor, const T& value)
+      {
+         std::memcpy(cursor, &value, sizeof(T));
+         cursor += sizeof(T);
+      }
+
+      /*
+      * Return index of first record of block iRank of nRank.
+      */
+      inline int blockBegin(int nRecord, int iRank, int nRank)
+      {  return int((long(nRecord)*long(iRank))/long(nRank)); }
+
+   }
+
+   /*
+   * Default constructor.
+   */
+   ParallelConfigIo::ParallelConfigIo()
+    : ConfigIo(),
+      owners_(),
+      simulationPtr_(0),
+      dirBlock_(0)
+   {  setClassName("ParallelConfigIo"); }
+
+   /*
+   * Constructor.
+   */
+   ParallelConfigIo::ParallelConfigIo(Simulation& simulation)
+    : ConfigIo(simulation),
+      owners_(),
+      simulationPtr_(&simulation),
+      dirBlock_(0)
+   {  setClassName("ParallelConfigIo"); }
+
+   /*
+   * Stream interface is not supported.
+   */
+   void ParallelConfigIo::readConfig(std::ifstream& file, MaskPolicy maskPolicy)
+   {  UTIL_THROW("ParallelConfigIo requires readConfigFile"); }
+
+   /*
+   * Stream interface is not supported.
+   */
+   void ParallelConfigIo::writeConfig(std::ofstream& file)
+   {  UTIL_THROW("ParallelConfigIo requires writeConfigFile"); }
+
+   /*
+   * Size of one atom record, in bytes.
+   */
+   int ParallelConfigIo::atomRecordSize() const
+   {
+      int size = 2*sizeof(int) + sizeof(unsigned int) + 6*sizeof(double);
+      if (Atom::hasAtomContext()) {
+         size += 3*sizeof(int);
+      }
+      return size;
+   }
+
+   /*
+   * Send fixed size records to processors given by ranks.
+   *
+   * Returns the number of records received.
+   */
+   int ParallelConfigIo::sendRecords(const GArray<char>& sendBuffer,
+                                     const GArray<int>& ranks,
+                                     int recordSize,
+                                     GArray<char>& recvBuffer)
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      int nProc = communicator.Get_size();
+      int nRecord = ranks.size();
+      int i, j;
+
+      // Count records for each destination
+      DArray<int> sendCounts;
+      DArray<int> recvCounts;
+      DArray<int> sendDispls;
+      DArray<int> recvDispls;
+      sendCounts.allocate(nProc);
+      recvCounts.allocate(nProc);
+      sendDispls.allocate(nProc);
+      recvDispls.allocate(nProc);
+      for (j = 0; j < nProc; ++j) {
+         sendCounts[j] = 0;
+         recvCounts[j] = 0;
+         sendDispls[j] = 0;
+         recvDispls[j] = 0;
+      }
+      for (i = 0; i < nRecord; ++i) {
+         ++sendCounts[ranks[i]];
+      }
+      communicator.Alltoall(&sendCounts[0], 1, MPI::INT,
+                            &recvCounts[0], 1, MPI::INT);
+
+      // Compute byte counts and displacements
+      int nRecv = 0;
+      for (j = 0; j < nProc; ++j) {
+         sendCounts[j] *= recordSize;
+         recvCounts[j] *= recordSize;
+         if (j > 0) {
+            sendDispls[j] = sendDispls[j-1] + sendCounts[j-1];
+            recvDispls[j] = recvDispls[j-1] + recvCounts[j-1];
+         }
+         nRecv += recvCounts[j];
+      }
+      nRecv /= recordSize;
+
+      // Sort records by destination
+      GArray<char> sorted;
+      sorted.resize(sendBuffer.size());
+      DArray<int> cursors(sendDispls);
+      for (i = 0; i < nRecord; ++i) {
+         std::memcpy(&sorted[cursors[ranks[i]]],
+                     &sendBuffer[i*recordSize], recordSize);
+         cursors[ranks[i]] += recordSize;
+      }
+
+      recvBuffer.resize(nRecv*recordSize);
+      communicator.Alltoallv(data(sorted), &sendCounts[0], &sendDispls[0],
+                             MPI::BYTE,
+                             data(recvBuffer), &recvCounts[0], &recvDispls[0],
+                             MPI::BYTE);
+      return nRecv;
+   }
+
+   /*
+   * Read a configuration file collectively.
+   */
+   void ParallelConfigIo::readConfigFile(FileMaster& fileMaster,
+                                         const std::string& filename,
+                                         MaskPolicy maskPolicy)
+   {
+      // Preconditions
+      if (atomStorage().nAtom()) {
+         UTIL_THROW("Atom storage is not empty (has local atoms)");
+      }
+      if (atomStorage().nGhost()) {
+         UTIL_THROW("Atom storage is not empty (has ghost atoms)");
+      }
+      if (atomStorage().isCartesian()) {
+         UTIL_THROW("Error: Atom storage is set for Cartesian coordinates");
+      }
+
+      MPI::Intracomm& communicator = domain().communicator();
+      std::string path = fileMaster.inputFileName(filename);
+
+      // Check that file exists, so that all processors can throw
+      int isOpen = 0;
+      if (domain().isMaster()) {
+         std::ifstream test(path.c_str());
+         isOpen = test.is_open() ? 1 : 0;
+      }
+      communicator.Bcast(&isOpen, 1, MPI::INT, 0);
+      if (!isOpen) {
+         Log::file() << "Filename: " << path << std::endl;
+         UTIL_THROW("Error opening parallel config file");
+      }
+      MPI::File file = MPI::File::Open(communicator, path.c_str(),
+                                       MPI::MODE_RDONLY, MPI::INFO_NULL);
+
+      // Read and check header
+      char header[HeaderSize];
+      file.Read_at_all(0, header, HeaderSize, MPI::BYTE);
+      if (std::memcmp(header, ParallelConfigMagic, 8) != 0) {
+         UTIL_THROW("Invalid parallel config file identifier");
+      }
+      int values[nHeaderInt];
+      std::memcpy(values, header + 8, nHeaderInt*sizeof(int));
+      if (values[0] != ParallelConfigVersion) {
+         UTIL_THROW("Unsupported parallel config file version");
+      }
+      if (values[1] != (Atom::hasAtomContext() ? 1 : 0)) {
+         UTIL_THROW("File hasAtomContext differs from Atom::hasAtomContext()");
+      }
+      int nAtom = values[2];
+      int nBond = values[3];
+      int nAngle = values[4];
+      int nDihedral = values[5];
+      int boundarySize = values[6];
+
+      // Read boundary
+      {
+         GArray<char> bytes;
+         bytes.resize(boundarySize);
+         file.Read_at_all(HeaderSize, data(bytes), boundarySize, MPI::BYTE);
+         MemoryOArchive oar;
+         oar.allocate(boundarySize);
+         oar.pack(data(bytes), boundarySize);
+         MemoryIArchive iar;
+         iar = oar;
+         iar >> boundary();
+      }
+      MPI::Offset offset = HeaderSize + boundarySize;
+
+      // Read atoms and distribute them to their owners
+      readAtoms(file, offset, nAtom);
+      offset += MPI::Offset(nAtom)*atomRecordSize();
+
+      // Validate atom distribution
+      atomStorage().unsetNAtomTotal();
+      atomStorage().computeNAtomTotal(communicator);
+      if (domain().isMaster()) {
+         if (atomStorage().nAtomTotal() != nAtom) {
+            UTIL_THROW("nAtomTotal != nAtom after distribution");
+         }
+      }
+
+      // Read groups and distribute them to owners of their atoms
+      if (nBond || nAngle || nDihedral) {
+         makeDirectory();
+      }
+      bool hasGhosts = false;
+      #ifdef INTER_BOND
+      if (bondStorage().capacity()) {
+         readGroups<2>(file, offset, nBond, bondStorage());
+         bondStorage().isValid(atomStorage(), communicator, hasGhosts);
+         if (maskPolicy == MaskBonded) {
+            setAtomMasks();
+         }
+      } else
+      #endif
+      if (nBond) {
+         UTIL_THROW("File contains bonds, but bond storage is disabled");
+      }
+      offset += MPI::Offset(nBond)*(4*sizeof(int));
+      #ifdef INTER_ANGLE
+      if (angleStorage().capacity()) {
+         readGroups<3>(file, offset, nAngle, angleStorage());
+         angleStorage().isValid(atomStorage(), communicator, hasGhosts);
+      } else
+      #endif
+      if (nAngle) {
+         UTIL_THROW("File contains angles, but angle storage is disabled");
+      }
+      offset += MPI::Offset(nAngle)*(5*sizeof(int));
+      #ifdef INTER_DIHEDRAL
+      if (dihedralStorage().capacity()) {
+         readGroups<4>(file, offset, nDihedral, dihedralStorage());
+         dihedralStorage().isValid(atomStorage(), communicator, hasGhosts);
+      } else
+      #endif
+      if (nDihedral) {
+         UTIL_THROW("File contains dihedrals, but dihedral storage is disabled");
+      }
+
+      file.Close();
+      if (owners_.isAllocated()) {
+         owners_.deallocate();
+      }
+   }
+
+   /*
+   * Read a block of atom records and send each atom to its owner.
+   */
+   void ParallelConfigIo::readAtoms(MPI::File& file, MPI::Offset offset,
+                                    int nAtom)
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      int nProc = communicator.Get_size();
+      int myRank = communicator.Get_rank();
+      int recordSize = atomRecordSize();
+      bool hasContext = Atom::hasAtomContext();
+
+      // Read block of records
+      int begin = blockBegin(nAtom, myRank, nProc);
+      int end = blockBegin(nAtom, myRank + 1, nProc);
+      int nRecord = end - begin;
+      GArray<char> buffer;
+      buffer.resize(nRecord*recordSize);
+      file.Read_at_all(offset + MPI::Offset(begin)*recordSize,
+                       data(buffer), nRecord*recordSize, MPI::BYTE);
+
+      // Convert positions to scaled coordinates, and find owners
+      GArray<int> ranks;
+      ranks.resize(nRecord);
+      Vector r, s;
+      char* cursor;
+      const char* ptr;
+      int i, j;
+      for (i = 0; i < nRecord; ++i) {
+         cursor = &buffer[i*recordSize] + 2*sizeof(int) + sizeof(unsigned int);
+         if (hasContext) {
+            cursor += 3*sizeof(int);
+         }
+         ptr = cursor;
+         for (j = 0; j < Dimension; ++j) {
+            unpack(ptr, r[j]);
+         }
+         boundary().transformCartToGen(r, s);
+         boundary().shiftGen(s);
+         for (j = 0; j < Dimension; ++j) {
+            repack(cursor, s[j]);
+         }
+         ranks[i] = domain().ownerRank(s);
+      }
+
+      // Exchange and add atoms
+      GArray<char> recvBuffer;
+      int nRecv = sendRecords(buffer, ranks, recordSize, recvBuffer);
+      int totalAtomCapacity = atomStorage().totalAtomCapacity();
+      Atom* atomPtr;
+      AtomContext* contextPtr;
+      int nAtomType = simulationPtr_ ? simulationPtr_->nAtomType() : -1;
+      int id, typeId;
+      for (i = 0; i < nRecv; ++i) {
+         ptr = &recvBuffer[i*recordSize];
+         unpack(ptr, id);
+         unpack(ptr, typeId);
+         if (id < 0 || id >= totalAtomCapacity) {
+            UTIL_THROW("Invalid atom id");
+         }
+         if (typeId < 0) {
+            UTIL_THROW("Negative atom type id");
+         }
+         if (nAtomType >= 0 && typeId >= nAtomType) {
+            UTIL_THROW("Atom type id >= nAtomType");
+         }
+         atomPtr = atomStorage().newAtomPtr();
+         atomPtr->setId(id);
+         atomPtr->setTypeId(typeId);
+         unpack(ptr, atomPtr->groups());
+         if (hasContext) {
+            contextPtr = &atomPtr->context();
+            unpack(ptr, contextPtr->speciesId);
+            unpack(ptr, contextPtr->moleculeId);
+            unpack(ptr, contextPtr->atomId);
+         }
+         for (j = 0; j < Dimension; ++j) {
+            unpack(ptr, atomPtr->position()[j]);
+         }
+         for (j = 0; j < Dimension; ++j) {
+            unpack(ptr, atomPtr->velocity()[j]);
+         }
+         atomStorage().addNewAtom();
+      }
+   }
+
+   /*
+   * Build the distributed directory of atom owners.
+   *
+   * Processor p holds the owner ranks of atoms with ids in the block
+   * [p*dirBlock_, (p+1)*dirBlock_).
+   */
+   void ParallelConfigIo::makeDirectory()
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      int nProc = communicator.Get_size();
+      int myRank = communicator.Get_rank();
+      int capacity = atomStorage().totalAtomCapacity();
+      dirBlock_ = (capacity + nProc - 1)/nProc;
+      if (owners_.isAllocated()) {
+         owners_.deallocate();
+      }
+      owners_.allocate(dirBlock_);
+      for (int i = 0; i < dirBlock_; ++i) {
+         owners_[i] = -1;
+      }
+
+      // Send (atom id, owner rank) to directory processor of each atom
+      int recordSize = 2*sizeof(int);
+      GArray<char> buffer;
+      GArray<int> ranks;
+      if (atomStorage().nAtom() > 0) {
+         buffer.reserve(atomStorage().nAtom()*recordSize);
+         ranks.reserve(atomStorage().nAtom());
+      }
+      AtomIterator atomIter;
+      int id;
+      for (atomStorage().begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         id = atomIter->id();
+         pack(buffer, id);
+         pack(buffer, myRank);
+         ranks.append(id/dirBlock_);
+      }
+      GArray<char> recvBuffer;
+      int nRecv = sendRecords(buffer, ranks, recordSize, recvBuffer);
+      const char* ptr;
+      int rank;
+      for (int i = 0; i < nRecv; ++i) {
+         ptr = &recvBuffer[i*recordSize];
+         unpack(ptr, id);
+         unpack(ptr, rank);
+         owners_[id - myRank*dirBlock_] = rank;
+      }
+   }
+
+   /*
+   * Read Group<N> records and send each to all owners of its atoms.
+   *
+   * Records are first sent to the directory processors of their atoms,
+   * which forward them to the atom owners.
+   */
+   template <int N>
+   void ParallelConfigIo::readGroups(MPI::File& file, MPI::Offset offset,
+                                     int nGroup, GroupStorage<N>& storage)
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      int nProc = communicator.Get_size();
+      int myRank = communicator.Get_rank();
+      int recordSize = (2 + N)*sizeof(int);
+      int totalAtomCapacity = atomStorage().totalAtomCapacity();
+
+      // Read block of records
+      int begin = blockBegin(nGroup, myRank, nProc);
+      int end = blockBegin(nGroup, myRank + 1, nProc);
+      int nRecord = end - begin;
+      GArray<char> buffer;
+      buffer.resize(nRecord*recordSize);
+      file.Read_at_all(offset + MPI::Offset(begin)*recordSize,
+                       data(buffer), nRecord*recordSize, MPI::BYTE);
+
+      // Send each record once to each directory processor of its atoms
+      GArray<char> sendBuffer;
+      GArray<int> ranks;
+      GArray<char> recvBuffer;
+      int atomIds[N];
+      int dest[N];
+      const char* ptr;
+      const char* record;
+      int i, j, k, nDest, rank;
+      for (i = 0; i < nRecord; ++i) {
+         record = &buffer[i*recordSize];
+         ptr = record + 2*sizeof(int);
+         nDest = 0;
+         for (j = 0; j < N; ++j) {
+            unpack(ptr, atomIds[j]);
+            if (atomIds[j] < 0 || atomIds[j] >= totalAtomCapacity) {
+               UTIL_THROW("Invalid atom id in group");
+            }
+            rank = atomIds[j]/dirBlock_;
+            for (k = 0; k < nDest; ++k) {
+               if (dest[k] == rank) break;
+            }
+            if (k == nDest) {
+               dest[nDest] = rank;
+               ++nDest;
+               packBytes(sendBuffer, record, recordSize);
+               ranks.append(rank);
+            }
+         }
+      }
+      int nRecv = sendRecords(sendBuffer, ranks, recordSize, recvBuffer);
+
+      // Forward each record once to each owner of an atom in my block
+      sendBuffer.clear();
+      ranks.clear();
+      int lower = myRank*dirBlock_;
+      int upper = lower + dirBlock_;
+      for (i = 0; i < nRecv; ++i) {
+         record = &recvBuffer[i*recordSize];
+         ptr = record + 2*sizeof(int);
+         nDest = 0;
+         for (j = 0; j < N; ++j) {
+            unpack(ptr, atomIds[j]);
+            if (atomIds[j] < lower || atomIds[j] >= upper) continue;
+            rank = owners_[atomIds[j] - lower];
+            if (rank < 0) {
+               UTIL_THROW("Atom in group not found");
+            }
+            for (k = 0; k < nDest; ++k) {
+               if (dest[k] == rank) break;
+            }
+            if (k == nDest) {
+               dest[nDest] = rank;
+               ++nDest;
+               packBytes(sendBuffer, record, recordSize);
+               ranks.append(rank);
+            }
+         }
+      }
+      buffer.clear();
+      nRecv = sendRecords(sendBuffer, ranks, recordSize, buffer);
+
+      // Add groups, ignoring duplicates forwarded by different processors
+      Group<N>* groupPtr;
+      int id, typeId, atomId, nAtom;
+      for (i = 0; i < nRecv; ++i) {
+         ptr = &buffer[i*recordSize];
+         unpack(ptr, id);
+         if (storage.find(id)) continue;
+         unpack(ptr, typeId);
+         groupPtr = storage.newPtr();
+         groupPtr->setId(id);
+         groupPtr->setTypeId(typeId);
+         for (j = 0; j < N; ++j) {
+            unpack(ptr, atomId);
+            groupPtr->setAtomId(j, atomId);
+         }
+         nAtom = atomStorage().map().findGroupLocalAtoms(*groupPtr);
+         if (nAtom > 0) {
+            storage.add();
+         } else {
+            storage.returnPtr();
+            UTIL_THROW("Group received by processor that owns none of its atoms");
+         }
+      }
+
+      // Validate total number of groups
+      storage.unsetNTotal();
+      storage.computeNTotal(communicator);
+      if (domain().isMaster()) {
+         if (storage.nTotal() != nGroup) {
+            UTIL_THROW("Number of groups after distribution != nGroup");
+         }
+      }
+   }
+
+   /*
+   * Pack records for groups for which this processor owns atom 0.
+   */
+   template <int N>
+   int ParallelConfigIo::packGroups(GroupStorage<N>& storage,
+                                    GArray<char>& buffer)
+   {
+      GroupIterator<N> iter;
+      Atom* atomPtr;
+      int n = 0;
+      int j;
+      buffer.clear();
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         atomPtr = iter->atomPtr(0);
+         if (atomPtr) {
+            if (!atomPtr->isGhost()) {
+               pack(buffer, iter->id());
+               pack(buffer, iter->typeId());
+               for (j = 0; j < N; ++j) {
+                  pack(buffer, iter->atomId(j));
+               }
+               ++n;
+            }
+         }
+      }
+      return n;
+   }
+
+   /*
+   * Write a configuration file collectively.
+   */
+   void ParallelConfigIo::writeConfigFile(FileMaster& fileMaster,
+                                          const std::string& filename)
+   {
+      MPI::Intracomm& communicator = domain().communicator();
+      bool hasContext = Atom::hasAtomContext();
+
+      // Pack local atoms, with Cartesian positions
+      int recordSize = atomRecordSize();
+      GArray<char> atoms;
+      if (atomStorage().nAtom() > 0) {
+         atoms.reserve(atomStorage().nAtom()*recordSize);
+      }
+      bool isCartesian = atomStorage().isCartesian();
+      AtomIterator atomIter;
+      const AtomContext* contextPtr;
+      Vector r;
+      int j;
+      for (atomStorage().begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         pack(atoms, atomIter->id());
+         pack(atoms, atomIter->typeId());
+         pack(atoms, atomIter->groups());
+         if (hasContext) {
+            contextPtr = &atomIter->context();
+            pack(atoms, contextPtr->speciesId);
+            pack(atoms, contextPtr->moleculeId);
+            pack(atoms, contextPtr->atomId);
+         }
+         if (isCartesian) {
+            r = atomIter->position();
+         } else {
+            boundary().transformGenToCart(atomIter->position(), r);
+         }
+         for (j = 0; j < Dimension; ++j) {
+            pack(atoms, r[j]);
+         }
+         for (j = 0; j < Dimension; ++j) {
+            pack(atoms, atomIter->velocity()[j]);
+         }
+      }
+
+      // Pack groups, each written by the owner of its first atom
+      int nLocal[4] = {atomStorage().nAtom(), 0, 0, 0};
+      GArray<char> bonds, angles, dihedrals;
+      #ifdef INTER_BOND
+      if (bondStorage().capacity()) {
+         nLocal[1] = packGroups<2>(bondStorage(), bonds);
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (angleStorage().capacity()) {
+         nLocal[2] = packGroups<3>(angleStorage(), angles);
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (dihedralStorage().capacity()) {
+         nLocal[3] = packGroups<4>(dihedralStorage(), dihedrals);
+      }
+      #endif
+
+      // Compute offsets of local blocks and totals for each section
+      int first[4] = {0, 0, 0, 0};
+      int total[4];
+      communicator.Exscan(nLocal, first, 4, MPI::INT, MPI::SUM);
+      if (domain().isMaster()) {
+         for (j = 0; j < 4; ++j) {
+            first[j] = 0;
+         }
+      }
+      communicator.Allreduce(nLocal, total, 4, MPI::INT, MPI::SUM);
+
+      // Serialize boundary
+      MemoryOArchive oar;
+      int boundarySize = memorySize(boundary());
+      oar.allocate(boundarySize);
+      oar << boundary();
+      boundarySize = oar.cursor() - oar.begin();
+
+      std::string path = fileMaster.outputFileName(filename);
+      MPI::File file = MPI::File::Open(communicator, path.c_str(),
+                                MPI::MODE_CREATE | MPI::MODE_WRONLY,
+                                MPI::INFO_NULL);
+      file.Set_size(0);
+
+      // Master writes header and boundary
+      if (domain().isMaster()) {
+         GArray<char> header;
+         packBytes(header, ParallelConfigMagic, 8);
+         pack(header, ParallelConfigVersion);
+         pack(header, hasContext ? 1 : 0);
+         for (j = 0; j < 4; ++j) {
+            pack(header, total[j]);
+         }
+         pack(header, boundarySize);
+         packBytes(header, (char*)oar.begin(), boundarySize);
+         file.Write_at(0, data(header), header.size(), MPI::BYTE);
+      }
+
+      // All processors write their blocks of each section
+      MPI::Offset offset = HeaderSize + boundarySize;
+      file.Write_at_all(offset + MPI::Offset(first[0])*recordSize,
+                        data(atoms), atoms.size(), MPI::BYTE);
+      offset += MPI::Offset(total[0])*recordSize;
+      file.Write_at_all(offset + MPI::Offset(first[1])*(4*sizeof(int)),
+                        data(bonds), bonds.size(), MPI::BYTE);
+      offset += MPI::Offset(total[1])*(4*sizeof(int));
+      file.Write_at_all(offset + MPI::Offset(first[2])*(5*sizeof(int)),
+                        data(angles), angles.size(), MPI::BYTE);
+      offset += MPI::Offset(total[2])*(5*sizeof(int));
+      file.Write_at_all(offset + MPI::Offset(first[3])*(6*sizeof(int)),
+                        data(dihedrals), dihedrals.size(), MPI::BYTE);
+
+      file.Close();
+   }
+
+}
+#endif // ifdef UTIL_MPI
@@ -0,0 +1,165 @@
+#ifndef DDMD_PARALLEL_CONFIG_IO_H
+#define DDMD_PARALLEL_CONFIG_IO_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/configIos/ConfigIo.h>
+#include <util/containers/DArray.h>
+#include <util/containers/GArray.h>
+#include <util/global.h>
+
+#include <string>
+
+#ifdef UTIL_MPI
+
+namespace DdMd
+{
+
+   class Simulation;
+
+   using namespace Util;
+
+   /**
+   * Binary configuration file format read and written with MPI-IO.
+   *
+   * ParallelConfigIo reads and writes a binary configuration file
+   * collectively from all processors, rather than funneling all atoms
+   * and groups through the master processor.
+   *
+   * In writeConfigFile, each processor writes the atoms that it owns,
+   * and the groups for which it owns the first atom, into a contiguous
+   * block of fixed-size records in a shared file, at an offset given
+   * by a prefix sum over processors. In readConfigFile, each processor
+   * reads an equal block of records, and atoms and groups are then
+   * sent directly to the processors that own them. Groups are routed
+   * via a distributed directory of atom owners, so no processor ever
+   * holds more than a fraction of the configuration.
+   *
+   * The file begins with a header containing an 8 character
+   * identifier, the format version, the hasAtomContext flag, the
+   * number of atoms, bonds, angles and dihedrals, and the serialized
+   * Boundary. This is followed by atom records (id, typeId, groups,
+   * optional AtomContext, Cartesian position and velocity) and by
+   * bond, angle and dihedral records (id, typeId, atom ids). Data is
+   * stored in the native binary representation, and so files are not
+   * guaranteed to be portable between different types of computer.
+   *
+   * The readConfig and writeConfig functions that take C++ file stream
+   * arguments are not supported, and throw an Exception.
+   *
+   * \ingroup DdMd_ConfigIo_Module
+   */
+   class ParallelConfigIo : public ConfigIo
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      ParallelConfigIo();
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent Simulation object.
+      */
+      ParallelConfigIo(Simulation& simulation);
+
+      /**
+      * Read a configuration file collectively (call on all processors).
+      *
+      * \pre  There are no atoms, ghosts, or groups.
+      * \pre  AtomStorage is set for scaled / generalized coordinates
+      *
+      * \param fileMaster FileMaster used to construct the file path
+      * \param filename   input file name, without prefix
+      * \param maskPolicy MaskPolicy to be used in setting atom masks
+      */
+      virtual void readConfigFile(FileMaster& fileMaster,
+                                  const std::string& filename,
+                                  MaskPolicy maskPolicy);
+
+      /**
+      * Write a configuration file collectively (call on all processors).
+      *
+      * Atom positions may be Cartesian or scaled on entry, and are not
+      * modified.
+      *
+      * \param fileMaster FileMaster used to construct the file path
+      * \param filename   output file name, without prefix
+      */
+      virtual void writeConfigFile(FileMaster& fileMaster,
+                                   const std::string& filename);
+
+      /**
+      * Not supported: Throws an Exception.
+      *
+      * \param file input file stream
+      * \param maskPolicy MaskPolicy to be used in setting atom masks
+      */
+      virtual void readConfig(std::ifstream& file, MaskPolicy maskPolicy);
+
+      /**
+      * Not supported: Throws an Exception.
+      *
+      * \param file output file stream
+      */
+      virtual void writeConfig(std::ofstream& file);
+
+   private:
+
+      /// Owner ranks of atoms in the block of ids assigned to this rank.
+      DArray<int> owners_;
+
+      /// Parent Simulation, if any (null if default constructed).
+      Simulation* simulationPtr_;
+
+      /// Number of atom ids in the directory block of each rank.
+      int dirBlock_;
+
+      /*
+      * Return size of one atom record, in bytes.
+      */
+      int atomRecordSize() const;
+
+      /*
+      * Read atoms and send them to their owners.
+      */
+      void readAtoms(MPI::File& file, MPI::Offset offset, int nAtom);
+
+      /*
+      * Build the distributed directory of atom owners.
+      */
+      void makeDirectory();
+
+      /*
+      * Read Group<N> records and send them to all owners of their atoms.
+      */
+      template <int N>
+      void readGroups(MPI::File& file, MPI::Offset offset, int nGroup,
+                      GroupStorage<N>& storage);
+
+      /*
+      * Pack records for groups for which this processor owns atom 0.
+      */
+      template <int N>
+      int packGroups(GroupStorage<N>& storage, GArray<char>& buffer);
+
+      /*
+      * Send fixed size records to specified processors.
+      */
+      int sendRecords(const GArray<char>& sendBuffer,
+                      const GArray<int>& ranks, int recordSize,
+                      GArray<char>& recvBuffer);
+
+   };
+
+}
+#endif // ifdef UTIL_MPI
+#endif
@@ -0,0 +1,645 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "ShardConfigIo.h"
+
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/communicate/Domain.h>
+
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/storage/GroupIterator.h>
+#ifdef INTER_BOND
+#include <ddMd/storage/BondStorage.h>
+#endif
+#ifdef INTER_ANGLE
+#include <ddMd/storage/AngleStorage.h>
+#endif
+#ifdef INTER_DIHEDRAL
+#include <ddMd/storage/DihedralStorage.h>
+#endif
+
+#include <ddMd/communicate/GroupDistributor.tpp>
+#include <ddMd/chemistry/Atom.h>
+#include <ddMd/chemistry/MaskPolicy.h>
+#include <util/random/Random.h>
+#include <util/misc/FileMaster.h>
+#include <util/misc/ioUtil.h>
+#include <util/containers/DArray.h>
+#include <util/containers/GArray.h>
+#include <util/space/IntVector.h>
+#include <util/space/Vector.h>
+#include <util/mpi/MpiSendRecv.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   ShardConfigIo::ShardConfigIo()
+    : ConfigIo()
+   {  setClassName("ShardConfigIo"); }
+
+   /*
+   * Constructor.
+   */
+   ShardConfigIo::ShardConfigIo(Simulation& simulation)
+    : ConfigIo(simulation)
+   {  setClassName("ShardConfigIo"); }
+
+   /*
+   * Stream interface is not supported.
+   */
+   void ShardConfigIo::readConfig(std::ifstream& file, MaskPolicy maskPolicy)
+   {  UTIL_THROW("ShardConfigIo is used only for restart files"); }
+
+   /*
+   * Stream interface is not supported.
+   */
+   void ShardConfigIo::writeConfig(std::ofstream& file)
+   {  UTIL_THROW("ShardConfigIo is used only for restart files"); }
+
+   /*
+   * Return name of the shard file of processor rank.
+   */
+   std::string
+   ShardConfigIo::shardName(const std::string& filename, int rank) const
+   {  return filename + "." + toString(rank); }
+
+   // Save functions
+
+   /*
+   * Save local groups, with those for which atom 0 is local first.
+   */
+   template <int N>
+   void ShardConfigIo::saveGroups(Serializable::OArchive& ar,
+                                  GroupStorage<N>& storage)
+   {
+      GroupIterator<N> iter;
+      Atom* atomPtr;
+      int nOwned = 0;
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         atomPtr = iter->atomPtr(0);
+         if (atomPtr) {
+            if (!atomPtr->isGhost()) {
+               ++nOwned;
+            }
+         }
+      }
+      int nShared = storage.size() - nOwned;
+
+      ar << nOwned;
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         atomPtr = iter->atomPtr(0);
+         if (atomPtr) {
+            if (!atomPtr->isGhost()) {
+               ar << *iter;
+            }
+         }
+      }
+      ar << nShared;
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         atomPtr = iter->atomPtr(0);
+         if (!atomPtr || atomPtr->isGhost()) {
+            ar << *iter;
+         }
+      }
+   }
+
+   /*
+   * Save manifest on master and write one shard per processor.
+   */
+   void ShardConfigIo::saveConfig(Serializable::OArchive& ar,
+                                  FileMaster& fileMaster,
+                                  const std::string& filename,
+                                  Random& random)
+   {
+      int nShard = 1;
+      int rank = 0;
+      #ifdef UTIL_MPI
+      nShard = domain().communicator().Get_size();
+      rank = domain().communicator().Get_rank();
+      #endif
+
+      // Compute totals, for validation on restart
+      int nAtom = 0;
+      int nBond = 0;
+      int nAngle = 0;
+      int nDihedral = 0;
+      atomStorage().computeNAtomTotal(domain().communicator());
+      nAtom = atomStorage().nAtomTotal();
+      #ifdef INTER_BOND
+      if (bondStorage().capacity()) {
+         bondStorage().computeNTotal(domain().communicator());
+         nBond = bondStorage().nTotal();
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (angleStorage().capacity()) {
+         angleStorage().computeNTotal(domain().communicator());
+         nAngle = angleStorage().nTotal();
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (dihedralStorage().capacity()) {
+         dihedralStorage().computeNTotal(domain().communicator());
+         nDihedral = dihedralStorage().nTotal();
+      }
+      #endif
+
+      // Save manifest
+      if (domain().isMaster()) {
+         IntVector gridDimensions;
+         int i, k;
+         for (i = 0; i < Dimension; ++i) {
+            gridDimensions[i] = domain().gridDimension(i);
+         }
+         ar << nShard;
+         ar << gridDimensions;
+         double bound;
+         for (i = 0; i < Dimension; ++i) {
+            for (k = 0; k <= gridDimensions[i]; ++k) {
+               bound = domain().gridBound(i, k);
+               ar << bound;
+            }
+         }
+         ar << boundary();
+         ar << nAtom;
+         ar << nBond;
+         ar << nAngle;
+         ar << nDihedral;
+      }
+
+      // Write shard of this processor
+      std::ofstream file;
+      fileMaster.openRestartOFile(shardName(filename, rank), file,
+                                  std::ios_base::out | std::ios_base::binary);
+      Serializable::OArchive shard(file);
+      shard << rank;
+
+      int nLocal = atomStorage().nAtom();
+      shard << nLocal;
+      bool isCartesian = atomStorage().isCartesian();
+      AtomIterator atomIter;
+      AtomContext* contextPtr;
+      Vector r;
+      int id, typeId;
+      for (atomStorage().begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         id = atomIter->id();
+         typeId = atomIter->typeId();
+         shard << id;
+         shard << typeId;
+         shard << atomIter->groups();
+         if (Atom::hasAtomContext()) {
+            contextPtr = &atomIter->context();
+            shard << contextPtr->speciesId;
+            shard << contextPtr->moleculeId;
+            shard << contextPtr->atomId;
+         }
+         if (isCartesian) {
+            shard << atomIter->position();
+         } else {
+            boundary().transformGenToCart(atomIter->position(), r);
+            shard << r;
+         }
+         shard << atomIter->velocity();
+      }
+
+      #ifdef INTER_BOND
+      if (bondStorage().capacity()) {
+         saveGroups<2>(shard, bondStorage());
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (angleStorage().capacity()) {
+         saveGroups<3>(shard, angleStorage());
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (dihedralStorage().capacity()) {
+         saveGroups<4>(shard, dihedralStorage());
+      }
+      #endif
+
+      shard << random;
+      file.close();
+   }
+
+   // Load functions
+
+   /*
+   * Load manifest on master, then read shards.
+   */
+   void ShardConfigIo::loadConfig(Serializable::IArchive& ar,
+                                  FileMaster& fileMaster,
+                                  const std::string& filename,
+                                  Random& random, MaskPolicy maskPolicy)
+   {
+      // Preconditions
+      if (atomStorage().nAtom()) {
+         UTIL_THROW("Atom storage is not empty (has local atoms)");
+      }
+      if (atomStorage().nGhost()) {
+         UTIL_THROW("Atom storage is not empty (has ghost atoms)");
+      }
+      if (atomStorage().isCartesian()) {
+         UTIL_THROW("Atom storage is set for Cartesian coordinates");
+      }
+
+      // Load manifest on master. Bounds for all axes are concatenated.
+      int nShard = 0;
+      IntVector gridDimensions;
+      DArray<double> bounds;
+      int totals[4]; // nAtom, nBond, nAngle, nDihedral
+      int nBound, i, k;
+      if (domain().isMaster()) {
+         ar >> nShard;
+         ar >> gridDimensions;
+         nBound = 0;
+         for (i = 0; i < Dimension; ++i) {
+            nBound += gridDimensions[i] + 1;
+         }
+         bounds.allocate(nBound);
+         for (k = 0; k < nBound; ++k) {
+            ar >> bounds[k];
+         }
+         ar >> boundary();
+         for (k = 0; k < 4; ++k) {
+            ar >> totals[k];
+         }
+      }
+
+      // Broadcast manifest
+      #ifdef UTIL_MPI
+      MPI::Intracomm& communicator = domain().communicator();
+      communicator.Bcast(&nShard, 1, MPI::INT, 0);
+      communicator.Bcast(&gridDimensions[0], Dimension, MPI::INT, 0);
+      bcast(communicator, boundary(), 0);
+      int nProc = communicator.Get_size();
+      #else
+      int nProc = 1;
+      #endif
+      bool isSameGrid = (nShard == nProc);
+      for (i = 0; i < Dimension; ++i) {
+         if (gridDimensions[i] != domain().gridDimension(i)) {
+            isSameGrid = false;
+         }
+      }
+
+      if (isSameGrid) {
+
+         // Restore domain bounds, then read shard of this processor
+         int maxN = 0;
+         nBound = 0;
+         for (i = 0; i < Dimension; ++i) {
+            nBound += gridDimensions[i] + 1;
+            if (gridDimensions[i] > maxN) maxN = gridDimensions[i];
+         }
+         if (!domain().isMaster()) {
+            bounds.allocate(nBound);
+         }
+         #ifdef UTIL_MPI
+         communicator.Bcast(&bounds[0], nBound, MPI::DOUBLE, 0);
+         #endif
+         DArray<double> axisBounds;
+         axisBounds.allocate(maxN + 1);
+         int offset = 0;
+         for (i = 0; i < Dimension; ++i) {
+            for (k = 0; k <= gridDimensions[i]; ++k) {
+               axisBounds[k] = bounds[offset + k];
+            }
+            domain().setGridBounds(i, axisBounds);
+            offset += gridDimensions[i] + 1;
+         }
+         loadShard(fileMaster, filename, random, maskPolicy);
+
+      } else {
+
+         if (domain().isMaster()) {
+            Log::file() << "Re-sharding restart from " << nShard
+                        << " processors" << std::endl;
+         }
+         distributeShards(fileMaster, filename, nShard, maskPolicy);
+
+         // Saved random number generator states are not restored. Reseed
+         // each processor with a seed drawn on the master plus its rank.
+         Random::SeedType seed = 0;
+         if (domain().isMaster()) {
+            seed = random.uniformInt(1, 1000000000);
+            Log::file() << "Reseeding random number generators from seed "
+                        << seed << " + rank" << std::endl;
+         }
+         #ifdef UTIL_MPI
+         communicator.Bcast(&seed, 1, MPI::UNSIGNED_LONG, 0);
+         seed += communicator.Get_rank();
+         #endif
+         random.setSeed(seed);
+
+      }
+
+      // Validate totals
+      atomStorage().unsetNAtomTotal();
+      atomStorage().computeNAtomTotal(domain().communicator());
+      if (domain().isMaster()) {
+         if (atomStorage().nAtomTotal() != totals[0]) {
+            UTIL_THROW("Number of atoms in shards != total in manifest");
+         }
+      }
+      #ifdef INTER_BOND
+      if (bondStorage().capacity()) {
+         bondStorage().unsetNTotal();
+         bondStorage().computeNTotal(domain().communicator());
+         if (domain().isMaster()) {
+            if (bondStorage().nTotal() != totals[1]) {
+               UTIL_THROW("Number of bonds in shards != total in manifest");
+            }
+         }
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (angleStorage().capacity()) {
+         angleStorage().unsetNTotal();
+         angleStorage().computeNTotal(domain().communicator());
+         if (domain().isMaster()) {
+            if (angleStorage().nTotal() != totals[2]) {
+               UTIL_THROW("Number of angles in shards != total in manifest");
+            }
+         }
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (dihedralStorage().capacity()) {
+         dihedralStorage().unsetNTotal();
+         dihedralStorage().computeNTotal(domain().communicator());
+         if (domain().isMaster()) {
+            if (dihedralStorage().nTotal() != totals[3]) {
+               UTIL_THROW("Number of dihedrals in shards != total in manifest");
+            }
+         }
+      }
+      #endif
+   }
+
+   /*
+   * Load Group<N> objects of one shard directly into storage.
+   */
+   template <int N>
+   void ShardConfigIo::loadGroups(Serializable::IArchive& ar,
+                                  GroupStorage<N>& storage)
+   {
+      Group<N>* groupPtr;
+      int nGroup, nAtom, i, j;
+      for (j = 0; j < 2; ++j) { // owned groups, then shared groups
+         ar >> nGroup;
+         for (i = 0; i < nGroup; ++i) {
+            groupPtr = storage.newPtr();
+            ar >> *groupPtr;
+            nAtom = atomStorage().map().findGroupLocalAtoms(*groupPtr);
+            if (nAtom == 0) {
+               storage.returnPtr();
+               UTIL_THROW("Group in shard contains no local atom");
+            }
+            storage.add();
+         }
+      }
+   }
+
+   /*
+   * Read shard of this processor, on restart with the same grid.
+   */
+   void ShardConfigIo::loadShard(FileMaster& fileMaster,
+                                 const std::string& filename,
+                                 Random& random, MaskPolicy maskPolicy)
+   {
+      int rank = 0;
+      #ifdef UTIL_MPI
+      rank = domain().communicator().Get_rank();
+      #endif
+
+      std::ifstream file;
+      fileMaster.openRestartIFile(shardName(filename, rank), file,
+                                  std::ios_base::in | std::ios_base::binary);
+      Serializable::IArchive shard(file);
+      int shardRank;
+      shard >> shardRank;
+      if (shardRank != rank) {
+         UTIL_THROW("Incorrect rank in shard file");
+      }
+
+      // Load atoms
+      int totalAtomCapacity = atomStorage().totalAtomCapacity();
+      int nAtom;
+      shard >> nAtom;
+      Atom* atomPtr;
+      AtomContext* contextPtr;
+      Vector r;
+      int id, typeId;
+      for (int i = 0; i < nAtom; ++i) {
+         shard >> id;
+         shard >> typeId;
+         if (id < 0 || id >= totalAtomCapacity) {
+            UTIL_THROW("Invalid atom id");
+         }
+         atomPtr = atomStorage().newAtomPtr();
+         atomPtr->setId(id);
+         atomPtr->setTypeId(typeId);
+         shard >> atomPtr->groups();
+         if (Atom::hasAtomContext()) {
+            contextPtr = &atomPtr->context();
+            shard >> contextPtr->speciesId;
+            shard >> contextPtr->moleculeId;
+            shard >> contextPtr->atomId;
+         }
+         shard >> r;
+         boundary().transformCartToGen(r, atomPtr->position());
+         shard >> atomPtr->velocity();
+         atomStorage().addNewAtom();
+      }
+
+      // Load groups
+      #ifdef INTER_BOND
+      if (bondStorage().capacity()) {
+         loadGroups<2>(shard, bondStorage());
+         if (maskPolicy == MaskBonded) {
+            setAtomMasks();
+         }
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (angleStorage().capacity()) {
+         loadGroups<3>(shard, angleStorage());
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (dihedralStorage().capacity()) {
+         loadGroups<4>(shard, dihedralStorage());
+      }
+      #endif
+
+      shard >> random;
+      file.close();
+   }
+
+   /*
+   * Append owned Group<N> objects of a shard, and skip shared groups.
+   */
+   template <int N>
+   void ShardConfigIo::readOwnedGroups(Serializable::IArchive& ar,
+                                       GArray< Group<N> >& groups)
+   {
+      Group<N> group;
+      int nGroup, i;
+      ar >> nGroup;
+      for (i = 0; i < nGroup; ++i) {
+         ar >> group;
+         groups.append(group);
+      }
+      ar >> nGroup;
+      for (i = 0; i < nGroup; ++i) {
+         ar >> group;
+      }
+   }
+
+   /*
+   * Distribute groups cached on the master.
+   */
+   template <int N>
+   void ShardConfigIo::distributeGroups(const GArray< Group<N> >& groups,
+                                        GroupDistributor<N>& distributor)
+   {
+      if (domain().isMaster()) {
+         distributor.setup();
+         Group<N>* groupPtr;
+         for (int i = 0; i < groups.size(); ++i) {
+            groupPtr = distributor.newPtr();
+            *groupPtr = groups[i];
+            distributor.add();
+         }
+         distributor.send();
+      } else {
+         distributor.receive();
+      }
+   }
+
+   /*
+   * Read all shards on master and distribute, on restart with a
+   * different processor grid.
+   *
+   * Each shard is read once. Atoms are passed to the AtomDistributor
+   * as they are read, and owned groups are cached on the master until
+   * all atoms have been distributed.
+   */
+   void ShardConfigIo::distributeShards(FileMaster& fileMaster,
+                                        const std::string& filename,
+                                        int nShard, MaskPolicy maskPolicy)
+   {
+      #ifdef INTER_BOND
+      GArray< Group<2> > bonds;
+      #endif
+      #ifdef INTER_ANGLE
+      GArray< Group<3> > angles;
+      #endif
+      #ifdef INTER_DIHEDRAL
+      GArray< Group<4> > dihedrals;
+      #endif
+
+      // Read shards, distribute atoms and cache groups
+      if (domain().isMaster()) {
+         #ifdef UTIL_MPI
+         atomDistributor().setup();
+         #endif
+         int totalAtomCapacity = atomStorage().totalAtomCapacity();
+         std::ifstream file;
+         Atom* atomPtr;
+         AtomContext* contextPtr;
+         Vector r;
+         int rank, nAtom, id, typeId, i;
+         for (int s = 0; s < nShard; ++s) {
+            fileMaster.openRestartIFile(shardName(filename, s), file,
+                                  std::ios_base::in | std::ios_base::binary);
+            Serializable::IArchive shard(file);
+            shard >> rank;
+            if (rank != s) {
+               UTIL_THROW("Incorrect rank in shard file");
+            }
+            shard >> nAtom;
+            for (i = 0; i < nAtom; ++i) {
+               atomPtr = atomDistributor().newAtomPtr();
+               shard >> id;
+               shard >> typeId;
+               if (id < 0 || id >= totalAtomCapacity) {
+                  UTIL_THROW("Invalid atom id");
+               }
+               atomPtr->setId(id);
+               atomPtr->setTypeId(typeId);
+               shard >> atomPtr->groups();
+               if (Atom::hasAtomContext()) {
+                  contextPtr = &atomPtr->context();
+                  shard >> contextPtr->speciesId;
+                  shard >> contextPtr->moleculeId;
+                  shard >> contextPtr->atomId;
+               }
+               shard >> r;
+               boundary().transformCartToGen(r, atomPtr->position());
+               shard >> atomPtr->velocity();
+               atomDistributor().addAtom();
+            }
+            #ifdef INTER_BOND
+            if (bondStorage().capacity()) {
+               readOwnedGroups<2>(shard, bonds);
+            }
+            #endif
+            #ifdef INTER_ANGLE
+            if (angleStorage().capacity()) {
+               readOwnedGroups<3>(shard, angles);
+            }
+            #endif
+            #ifdef INTER_DIHEDRAL
+            if (dihedralStorage().capacity()) {
+               readOwnedGroups<4>(shard, dihedrals);
+            }
+            #endif
+            file.close();
+         }
+         atomDistributor().send();
+      } else {
+         atomDistributor().receive();
+      }
+      atomDistributor().validate();
+
+      // Distribute groups
+      bool hasGhosts = false;
+      #ifdef INTER_BOND
+      if (bondStorage().capacity()) {
+         distributeGroups<2>(bonds, bondDistributor());
+         bondStorage().isValid(atomStorage(), domain().communicator(),
+                               hasGhosts);
+         if (maskPolicy == MaskBonded) {
+            setAtomMasks();
+         }
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (angleStorage().capacity()) {
+         distributeGroups<3>(angles, angleDistributor());
+         angleStorage().isValid(atomStorage(), domain().communicator(),
+                                hasGhosts);
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (dihedralStorage().capacity()) {
+         distributeGroups<4>(dihedrals, dihedralDistributor());
+         dihedralStorage().isValid(atomStorage(), domain().communicator(),
+                                   hasGhosts);
+      }
+      #endif
+   }
+
+}
@@ -0,0 +1,178 @@
+#ifndef DDMD_SHARD_CONFIG_IO_H
+#define DDMD_SHARD_CONFIG_IO_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/configIos/ConfigIo.h>
+#include <util/archives/Serializable.h>
+#include <util/containers/GArray.h>
+
+#include <string>
+
+namespace Util { class Random; }
+
+namespace DdMd
+{
+
+   class Simulation;
+
+   using namespace Util;
+
+   /**
+   * Distributed restart format, with one shard file per processor.
+   *
+   * ShardConfigIo saves and loads the configuration part of a restart
+   * file without funneling atoms through the master processor. The
+   * restart archive written by the master holds a small manifest (the
+   * number of shards, the processor grid dimensions and domain bounds,
+   * the boundary, and the total numbers of atoms and groups). Each
+   * processor writes its own atoms, its groups and the state of its
+   * random number generator to a separate shard file, named by adding
+   * a suffix "." + rank to the restart file name.
+   *
+   * On restart with the same processor grid, each processor reads its
+   * own shard, restores the domain bounds and its random number
+   * generator, and the run continues exactly as if uninterrupted. If
+   * the processor grid differs, the master instead reads each shard
+   * once, passing atoms to AtomDistributor and caching owned groups
+   * until all atoms are sent, and then distributes the groups through
+   * GroupDistributor, as for a conventional restart. Random number
+   * generator states are then not restored. Instead, the master draws
+   * a seed from the random number generator loaded from the restart
+   * archive, and each processor is reseeded with this seed plus its
+   * rank, so that a restart on a given grid is reproducible.
+   *
+   * Groups are stored in the shard of every processor that owns one of
+   * their atoms, and are marked as owned in the shard of the processor
+   * that owns atom 0, so that each group is distributed once during
+   * re-sharding.
+   *
+   * This class is used only for restart files. The readConfig and
+   * writeConfig functions throw an Exception.
+   *
+   * \ingroup DdMd_ConfigIo_Module
+   */
+   class ShardConfigIo : public ConfigIo
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      ShardConfigIo();
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent Simulation object.
+      */
+      ShardConfigIo(Simulation& simulation);
+
+      /**
+      * Not supported: Throws an Exception.
+      *
+      * \param file input file stream
+      * \param maskPolicy MaskPolicy to be used in setting atom masks
+      */
+      virtual void readConfig(std::ifstream& file, MaskPolicy maskPolicy);
+
+      /**
+      * Not supported: Throws an Exception.
+      *
+      * \param file output file stream
+      */
+      virtual void writeConfig(std::ofstream& file);
+
+      /**
+      * Save manifest to a restart archive and write shard files.
+      *
+      * Call on all processors. The manifest is saved to the archive only
+      * on the master, and each processor writes its own shard file.
+      * Atom positions may be Cartesian or scaled, and are not modified.
+      *
+      * \param ar         restart archive (used only on master)
+      * \param fileMaster FileMaster used to open shard files
+      * \param filename   restart file name, used as base for shard names
+      * \param random     random number generator of this processor
+      */
+      void saveConfig(Serializable::OArchive& ar, FileMaster& fileMaster,
+                      const std::string& filename, Random& random);
+
+      /**
+      * Load manifest from a restart archive and read shard files.
+      *
+      * Call on all processors. The manifest is loaded from the archive
+      * only on the master.
+      *
+      * \pre  There are no atoms, ghosts, or groups.
+      * \pre  AtomStorage is set for scaled / generalized coordinates
+      *
+      * \post atomic coordinates are scaled / generalized
+      * \post there are no ghosts
+      *
+      * \param ar         restart archive (used only on master)
+      * \param fileMaster FileMaster used to open shard files
+      * \param filename   restart file name, used as base for shard names
+      * \param random     random number generator of this processor
+      * \param maskPolicy MaskPolicy to be used in setting atom masks
+      */
+      void loadConfig(Serializable::IArchive& ar, FileMaster& fileMaster,
+                      const std::string& filename, Random& random,
+                      MaskPolicy maskPolicy);
+
+   private:
+
+      /*
+      * Return name of shard file for processor rank.
+      */
+      std::string shardName(const std::string& filename, int rank) const;
+
+      /*
+      * Read shard of this processor (same processor grid).
+      */
+      void loadShard(FileMaster& fileMaster, const std::string& filename,
+                     Random& random, MaskPolicy maskPolicy);
+
+      /*
+      * Read all shards on master and distribute (different grid).
+      */
+      void distributeShards(FileMaster& fileMaster,
+                            const std::string& filename,
+                            int nShard, MaskPolicy maskPolicy);
+
+      /*
+      * Distribute Group<N> objects cached on the master.
+      */
+      template <int N>
+      void distributeGroups(const GArray< Group<N> >& groups,
+                            GroupDistributor<N>& distributor);
+
+      /*
+      * Save local Group<N> objects to a shard, owned groups first.
+      */
+      template <int N>
+      void saveGroups(Serializable::OArchive& ar, GroupStorage<N>& storage);
+
+      /*
+      * Load Group<N> objects from a shard into storage.
+      */
+      template <int N>
+      void loadGroups(Serializable::IArchive& ar, GroupStorage<N>& storage);
+
+      /*
+      * Append owned Group<N> objects of a shard, and skip shared ones.
+      */
+      template <int N>
+      void readOwnedGroups(Serializable::IArchive& ar,
+                           GArray< Group<N> >& groups);
+
+   };
+
+}
+#endif
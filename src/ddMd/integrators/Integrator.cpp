@@ -25,6 +25,9 @@
 #ifdef INTER_EXTERNAL
 #include <ddMd/potentials/external/ExternalPotential.h>
 #endif
+#ifdef INTER_COULOMB
+#include <ddMd/potentials/coulomb/CoulombPotential.h>
+#endif
 
 #include <util/ensembles/BoundaryEnsemble.h>
 #include <util/mpi/MpiLoader.h>
@@ -46,7 +49,12 @@ namespace DdMd
        timer_(Integrator::NTime),
        isSetup_(false),
        saveFileName_(),
-       saveInterval_(0)
+       saveInterval_(0),
+       saveShards_(false),
+       overlapUpdate_(false),
+       deferExchangeCheck_(false),
+       exchangeNeeded_(0),
+       exchangeNeededAll_(0)
    {}
 
    /*
@@ -56,7 +64,8 @@ namespace DdMd
    {}
 
    /*
-   * Read saveInterval and saveFileName.
+   * Read saveInterval, saveFileName, optional saveShards, overlapUpdate and
+   * deferExchangeCheck.
    */
    void Integrator::readParameters(std::istream& in)
    {
@@ -70,11 +79,18 @@ namespace DdMd
             UTIL_THROW("Analyzer::baseInterval is not positive");
          }
          read<std::string>(in, "saveFileName", saveFileName_);
+         saveShards_ = false; // Default value for optional parameter
+         readOptional<bool>(in, "saveShards", saveShards_);
       }
+      overlapUpdate_ = false; // Default value for optional parameter
+      readOptional<bool>(in, "overlapUpdate", overlapUpdate_);
+      deferExchangeCheck_ = false; // Default value for optional parameter
+      readOptional<bool>(in, "deferExchangeCheck", deferExchangeCheck_);
    }
 
    /*
-   * Load saveInterval and saveFileName from restart archive.
+   * Load saveInterval, saveFileName, saveShards, overlapUpdate and
+   * deferExchangeCheck from archive.
    */
    void Integrator::loadParameters(Serializable::IArchive& ar)
    {
@@ -88,7 +104,11 @@ namespace DdMd
             UTIL_THROW("Analyzer::baseInterval is not positive");
          }
          loadParameter<std::string>(ar, "saveFileName", saveFileName_);
+         loadParameter<bool>(ar, "saveShards", saveShards_, false);
       }
+      loadParameter<bool>(ar, "overlapUpdate", overlapUpdate_, false);
+      loadParameter<bool>(ar, "deferExchangeCheck", deferExchangeCheck_, 
+                          false);
 
       MpiLoader<Serializable::IArchive> loader(*this, ar);
       loader.load(iStep_);
@@ -96,14 +116,18 @@ namespace DdMd
    }
 
    /*
-   * Save saveInterval and saveFileName to restart archive.
+   * Save saveInterval, saveFileName, saveShards, overlapUpdate and
+   * deferExchangeCheck to archive.
    */
    void Integrator::save(Serializable::OArchive& ar)
    {
       ar << saveInterval_;
       if (saveInterval_ > 0) {
          ar << saveFileName_;
+         Parameter::saveOptional(ar, saveShards_, true);
       }
+      Parameter::saveOptional(ar, overlapUpdate_, true);
+      Parameter::saveOptional(ar, deferExchangeCheck_, true);
       ar << iStep_;
       ar << isSetup_;
    }
@@ -149,7 +173,11 @@ namespace DdMd
       timer_.stamp(MISC);
       simulation().zeroForces();
       timer_.stamp(ZERO_FORCE);
-      pairPotential().computeForces();
+      if (exchanger().isUpdateActive()) {
+         pairPotential().computeForcesOverlap(exchanger());
+      } else {
+         pairPotential().computeForces();
+      }
       timer_.stamp(PAIR_FORCE);
       #ifdef INTER_BOND
       if (nBondType()) {
@@ -175,6 +203,12 @@ namespace DdMd
          timer_.stamp(EXTERNAL_FORCE);
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb()) {
+         coulombPotential().computeForces();
+         timer_.stamp(COULOMB_FORCE);
+      }
+      #endif
 
       // Reverse communication (if any)
       if (reverseUpdateFlag()) {
@@ -224,6 +258,12 @@ namespace DdMd
          timer_.stamp(EXTERNAL_FORCE);
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb()) {
+         coulombPotential().computeForcesAndStress(domain().communicator());
+         timer_.stamp(COULOMB_FORCE);
+      }
+      #endif
 
       // Reverse communication (if any)
       if (reverseUpdateFlag()) {
@@ -234,6 +274,53 @@ namespace DdMd
       // simulation().forceSignal().notify();
    }
 
+   /*
+   * Compute fast (bonded and external) forces only, with timing.
+   */
+   void Integrator::computeFastForces()
+   {
+      // Precondition
+      if (!atomStorage().isCartesian()) {
+         UTIL_THROW("Atom coordinates are not Cartesian");
+      }
+      if (exchanger().isUpdateActive()) {
+         exchanger().endUpdate();
+      }
+
+      timer_.stamp(MISC);
+      simulation().zeroForces();
+      timer_.stamp(ZERO_FORCE);
+      #ifdef INTER_BOND
+      if (nBondType()) {
+         bondPotential().computeForces();
+         timer_.stamp(BOND_FORCE);
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (nAngleType()) {
+         anglePotential().computeForces();
+         timer_.stamp(ANGLE_FORCE);
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (nDihedralType()) {
+         dihedralPotential().computeForces();
+         timer_.stamp(DIHEDRAL_FORCE);
+      }
+      #endif
+      #ifdef INTER_EXTERNAL
+      if (hasExternal()) {
+         externalPotential().computeForces();
+         timer_.stamp(EXTERNAL_FORCE);
+      }
+      #endif
+
+      // Reverse communication (if any)
+      if (reverseUpdateFlag()) {
+         exchanger().reverseUpdate();
+      }
+   }
+
    /*
    * Determine whether an atom exchange and reneighboring is needed.
    */
@@ -263,6 +350,63 @@ namespace DdMd
       #endif
    }
 
+   /*
+   * Begin a non-blocking check of whether an exchange is needed.
+   */
+   void Integrator::beginExchangeCheck(double skin) 
+   {
+      if (!atomStorage().isCartesian()) {
+         UTIL_THROW("Error: Coordinates not Cartesian in beginExchangeCheck");
+      } 
+
+      // Calculate maximum square displacment on this node
+      double maxSqDisp = atomStorage().maxSqDisplacement(); 
+      exchangeNeeded_ = 0;
+      if (sqrt(maxSqDisp) > 0.5*skin) {
+         exchangeNeeded_ = 1; 
+      }
+
+      // Post reduction. The MPI-2 C++ bindings have no non-blocking 
+      // collectives, so the C function is used with the same communicator.
+      #ifdef UTIL_MPI
+      MPI_Comm comm = domain().communicator();
+      MPI_Iallreduce(&exchangeNeeded_, &exchangeNeededAll_, 1, MPI_INT, 
+                     MPI_MAX, comm, &exchangeCheckRequest_);
+      #else
+      exchangeNeededAll_ = exchangeNeeded_;
+      #endif
+      timer_.stamp(CHECK);
+   }
+
+   /*
+   * Complete a non-blocking exchange check.
+   */
+   bool Integrator::endExchangeCheck() 
+   {
+      #ifdef UTIL_MPI
+      MPI_Wait(&exchangeCheckRequest_, MPI_STATUS_IGNORE);
+      timer_.stamp(ALLREDUCE);
+      #endif
+      return bool(exchangeNeededAll_);
+   }
+
+   /*
+   * Return a seed for counter-based random forces.
+   */
+   unsigned long Integrator::randomForceSeed() 
+   {
+      unsigned long seed = simulation().random().seed();
+      if (seed == 0) {
+         if (domain().isMaster()) {
+            seed = simulation().random().uniformInt(1, 2147483647);
+         }
+         #ifdef UTIL_MPI
+         bcast<unsigned long>(domain().communicator(), seed, 0);
+         #endif
+      }
+      return seed;
+   }
+
    #if 0
    /*
    * Determine whether an atom exchange and reneighboring is needed.
@@ -316,6 +460,9 @@ namespace DdMd
    {  
       #ifdef UTIL_MPI
       timer().reduce(domain().communicator());  
+      if (pairPotential().nThread() > 1) {
+         pairPotential().threadTimer().reduce(domain().communicator());  
+      }
       #endif
    }
 
@@ -438,6 +585,21 @@ namespace DdMd
           << "   "
           << Dbl(pairForceT*factor2, 12, 6)
           << "   " << Dbl(100.0*pairForceT/time, 12 , 6, true) << std::endl;
+      int nThread = pairPotential().nThread();
+      if (nThread > 1) {
+         // Time per thread in pair force loops (included in Pair Forces)
+         DdTimer& threadTimer = pairPotential().threadTimer();
+         double threadT;
+         for (int i = 0; i < nThread; ++i) {
+            threadT = threadTimer.time(i);
+            out << "   Thread " << Int(i, 4) << "       " 
+                << Dbl(threadT*factor1, 12, 6)
+                << "   "
+                << Dbl(threadT*factor2, 12, 6)
+                << "   " << Dbl(100.0*threadT/time, 12 , 6, true) 
+                << std::endl;
+         }
+      }
       #ifdef INTER_BOND
       if (nBondType()) {
          double bondForceT = timer().time(BOND_FORCE);
@@ -482,6 +644,17 @@ namespace DdMd
              << "   " << Dbl(100.0*externalForceT/time, 12 , 6, true) << std::endl;
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb()) {
+         double coulombForceT = timer().time(COULOMB_FORCE);
+         totalT += coulombForceT;
+         out << "Coulomb Forces       " 
+             << Dbl(coulombForceT*factor1, 12, 6) 
+             << "   "
+             << Dbl(coulombForceT*factor2, 12, 6)
+             << "   " << Dbl(100.0*coulombForceT/time, 12 , 6, true) << std::endl;
+      }
+      #endif
       double integrate2T = timer().time(INTEGRATE2);
       totalT += integrate2T;
       out << "Integrate2           " 
@@ -537,6 +710,7 @@ namespace DdMd
       iStep_ = 0;
       initDynamicalState();
       timer().clear(); 
+      pairPotential().threadTimer().clear();
       simulation().exchanger().timer().clear();
       simulation().buffer().clearStatistics();
       atomStorage().clearStatistics();
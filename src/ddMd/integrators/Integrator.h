@@ -42,21 +42,24 @@ namespace DdMd
       ~Integrator();
 
       /**
-      * Read saveInterval and saveFileName.
+      * Read saveInterval, saveFileName, optional saveShards, overlapUpdate and
+      * deferExchangeCheck.
       *
       * \param in input parameter stream
       */   
       void readParameters(std::istream& in);
 
       /**
-      * Load saveInterval and saveFileName from restart archive.
+      * Load saveInterval, saveFileName, saveShards, overlapUpdate and
+      * deferExchangeCheck from archive.
       *
       * \param ar input archive
       */   
       void loadParameters(Serializable::IArchive& ar);
 
       /**
-      * Save saveInterval and saveFileName from restart archive.
+      * Save saveInterval, saveFileName, saveShards, overlapUpdate and
+      * deferExchangeCheck to archive.
       *
       * \param ar input archive
       */   
@@ -108,19 +111,36 @@ namespace DdMd
       */
       double time() const;
 
+      /**
+      * Get time spent computing pair forces since the timer was cleared.
+      *
+      * On each processor, this is the time for that processor, unless 
+      * computeStatistics has since replaced it by an average.
+      */
+      double pairForceTime() const;
+
       /**
       * Get current time step index.
       */
       int iStep() const;
 
+      /**
+      * Write restart files as per-processor shards?
+      *
+      * If true, the configuration in each restart file is written by
+      * every processor to its own shard file by a ShardConfigIo, and
+      * the restart file itself holds only a manifest.
+      */
+      bool saveShards() const;
+
    protected:
 
       /// Timestamps for loop timing.
       enum TimeId {ANALYZER, INTEGRATE1, CHECK, ALLREDUCE, TRANSFORM_F, 
                    EXCHANGE, CELLLIST, TRANSFORM_R, PAIRLIST, UPDATE, 
                    ZERO_FORCE, PAIR_FORCE, BOND_FORCE, ANGLE_FORCE, 
-                   DIHEDRAL_FORCE, EXTERNAL_FORCE, INTEGRATE2, 
-                   MODIFIER, DEBUG, SIGNAL, MISC, NTime};
+                   DIHEDRAL_FORCE, EXTERNAL_FORCE, COULOMB_FORCE, 
+                   INTEGRATE2, MODIFIER, DEBUG, SIGNAL, MISC, NTime};
 
       /**
       * Set any internal dynamical to default initial values.
@@ -180,6 +200,17 @@ namespace DdMd
       */
       void computeForcesAndVirial();
 
+      /**
+      * Compute fast (bonded and external) forces only, with timing.
+      *
+      * Zeros all forces, then adds bond, angle, dihedral and external
+      * forces, but not pair or coulomb forces. Used by multiple time
+      * step integrators. Ghost atom positions must be current on entry.
+      * Upon return, forces are correct for all local atoms. Executes
+      * reverse communication if needed.
+      */
+      void computeFastForces();
+
       /**
       * Determine whether an atom exchange and reneighboring is needed.
       *
@@ -188,6 +219,38 @@ namespace DdMd
       */
       bool isExchangeNeeded(double skin);
 
+      /**
+      * Begin a non-blocking check of whether an exchange is needed.
+      *
+      * Evaluates the local displacement criterion and posts a 
+      * non-blocking reduction of the result over all processors. 
+      * Every call must be followed by a call to endExchangeCheck() 
+      * before the next collective exchange check.
+      *
+      * \param skin Verlet list skin length
+      */
+      void beginExchangeCheck(double skin);
+
+      /**
+      * Complete a check begun by beginExchangeCheck().
+      *
+      * \return true iff exchange is needed on any processor
+      */
+      bool endExchangeCheck();
+
+      /**
+      * Return a seed for counter-based (Philox) random forces.
+      *
+      * Returns the seed of Simulation::random() if it is nonzero. A
+      * zero seed means that random() was seeded from the clock, with
+      * a different state on each processor. In this case, a nonzero
+      * seed is drawn from random() on the master processor and
+      * broadcast, so that the value differs between runs but is the
+      * same on all processors. Callers should store the result, so
+      * that the same value is used after a restart.
+      */
+      unsigned long randomForceSeed();
+
       /**
       * Get restart file base name. 
       */
@@ -198,6 +261,31 @@ namespace DdMd
       */
       int saveInterval() const;
 
+      /**
+      * Overlap ghost position updates with pair force computation?
+      *
+      * If true, ghost position updates on steps without an exchange
+      * are begun with Exchanger::beginUpdate() and completed within
+      * PairPotential::computeForcesOverlap(), which computes forces 
+      * for pairs of local atoms while ghost positions are in transit.
+      * This is only used with a rigid boundary.
+      */
+      bool overlapUpdate() const;
+
+      /**
+      * Overlap the exchange check reduction with force computation?
+      *
+      * If true, the reduction used to decide whether an exchange is 
+      * needed is posted with beginExchangeCheck(), and forces are 
+      * computed speculatively, without an exchange, while it is in 
+      * transit. If the completed check shows that an exchange was
+      * needed, the speculative forces are discarded, and atoms are 
+      * exchanged and forces recomputed, so that the trajectory is 
+      * identical to that obtained with a blocking check. This is 
+      * only used when no modifiers are active.
+      */
+      bool deferExchangeCheck() const;
+
       /*
       * Return the timer by reference.
       */
@@ -220,6 +308,26 @@ namespace DdMd
       /// Interval for writing restart files (no output if 0)
       int saveInterval_;
 
+      /// Write restart configuration as per-processor shards? (optional)
+      bool saveShards_;
+
+      /// Overlap ghost update with pair force computation? (optional)
+      bool overlapUpdate_;
+
+      /// Overlap exchange check reduction with force computation? (optional)
+      bool deferExchangeCheck_;
+
+      /// Local result of most recent exchange check (0 or 1).
+      int exchangeNeeded_;
+
+      /// Global result of most recent exchange check (0 or 1).
+      int exchangeNeededAll_;
+
+      #ifdef UTIL_MPI
+      /// Request for the non-blocking exchange check reduction.
+      MPI_Request exchangeCheckRequest_;
+      #endif
+
    };
 
    /*
@@ -253,6 +361,12 @@ namespace DdMd
    inline DdTimer& Integrator::timer()
    {  return timer_; }
 
+   /*
+   * Get time spent computing pair forces.
+   */
+   inline double Integrator::pairForceTime() const
+   {  return timer_.time(PAIR_FORCE); }
+
    /*
    * Get restart file base name. 
    */
@@ -265,5 +379,20 @@ namespace DdMd
    inline int Integrator::saveInterval() const
    { return saveInterval_; }
 
+   inline bool Integrator::saveShards() const
+   { return saveShards_; }
+
+   /*
+   * Overlap ghost position updates with pair force computation?
+   */
+   inline bool Integrator::overlapUpdate() const
+   { return overlapUpdate_; }
+
+   /*
+   * Overlap exchange check reduction with force computation?
+   */
+   inline bool Integrator::deferExchangeCheck() const
+   { return deferExchangeCheck_; }
+
 }
 #endif
@@ -0,0 +1,215 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "NveRespaIntegrator.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/communicate/Exchanger.h>
+#include <util/space/Vector.h>
+#include <util/global.h>
+
+#include <iostream>
+
+namespace DdMd
+{
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   NveRespaIntegrator::NveRespaIntegrator(Simulation& simulation)
+    : TwoStepIntegrator(simulation),
+      slowForces_(),
+      prefactors_(),
+      innerPrefactors_(),
+      dt_(0.0),
+      nInner_(1),
+      hasSlowForces_(false)
+   {  setClassName("NveRespaIntegrator"); }
+
+   /*
+   * Destructor.
+   */
+   NveRespaIntegrator::~NveRespaIntegrator()
+   {}
+
+   /*
+   * Read time step dt and number of inner steps nInner.
+   */
+   void NveRespaIntegrator::readParameters(std::istream& in)
+   {
+      read<double>(in, "dt", dt_);
+      read<int>(in, "nInner", nInner_);
+      Integrator::readParameters(in);
+      allocate();
+   }
+
+   /**
+   * Load internal state from an archive.
+   */
+   void NveRespaIntegrator::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<double>(ar, "dt", dt_);
+      loadParameter<int>(ar, "nInner", nInner_);
+      Integrator::loadParameters(ar);
+      allocate();
+      //  Note: Values of prefactors calculated in setup()
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void NveRespaIntegrator::save(Serializable::OArchive &ar)
+   {
+      ar << dt_;
+      ar << nInner_;
+      Integrator::save(ar);
+   }
+
+   /*
+   * Check parameters and allocate arrays (private).
+   */
+   void NveRespaIntegrator::allocate()
+   {
+      if (nInner_ < 1) {
+         UTIL_THROW("nInner < 1");
+      }
+      int nAtomType = simulation().nAtomType();
+      if (!prefactors_.isAllocated()) {
+         prefactors_.allocate(nAtomType);
+         innerPrefactors_.allocate(nAtomType);
+      }
+      if (!slowForces_.isAllocated()) {
+         slowForces_.allocate(atomStorage().atomCapacity());
+      }
+   }
+
+   /*
+   * Setup at beginning of run, before entering main loop.
+   */
+   void NveRespaIntegrator::setup()
+   {
+
+      // Initialize state and clear statistics on first usage.
+      if (!isSetup()) {
+         clear();
+         setIsSetup();
+      }
+
+      // Exchange atoms, build pair list, compute forces.
+      setupAtoms();
+
+      // Atoms may have been exchanged: recompute slow forces
+      hasSlowForces_ = false;
+
+      // Set prefactors for acceleration
+      double dtHalf = 0.5*dt_;
+      double mass;
+      int nAtomType = prefactors_.capacity();
+      for (int i = 0; i < nAtomType; ++i) {
+         mass = simulation().atomType(i).mass();
+         prefactors_[i] = dtHalf/mass;
+         innerPrefactors_[i] = prefactors_[i]/double(nInner_);
+      }
+   }
+
+   /*
+   * Slow half step velocity update and inner loop with fast forces.
+   */
+   void NveRespaIntegrator::integrateStep1()
+   {
+      Vector dv;
+      Vector dr;
+      AtomIterator atomIter;
+      double h = dt_/double(nInner_);
+      double factor;
+      int id, k;
+
+      // Obtain fast forces. Slow forces are stored by integrateStep2,
+      // except in the first step after setup.
+      if (hasSlowForces_) {
+         atomStorage().begin(atomIter);
+         for ( ; atomIter.notEnd(); ++atomIter) {
+            atomIter->force() -= slowForces_[atomIter->arrayId()];
+         }
+      } else {
+         atomStorage().begin(atomIter);
+         for ( ; atomIter.notEnd(); ++atomIter) {
+            slowForces_[atomIter->arrayId()] = atomIter->force();
+         }
+         computeFastForces();
+         atomStorage().begin(atomIter);
+         for ( ; atomIter.notEnd(); ++atomIter) {
+            slowForces_[atomIter->arrayId()] -= atomIter->force();
+         }
+      }
+
+      // Half step velocity update with slow forces
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         dv.multiply(slowForces_[atomIter->arrayId()],
+                     prefactors_[atomIter->typeId()]);
+         atomIter->velocity() += dv;
+      }
+
+      // Inner velocity-Verlet loop with fast forces. The second half
+      // velocity update of each inner step is merged with the first
+      // half update of the next. The last is done by integrateStep2.
+      for (k = 0; k < nInner_; ++k) {
+         if (k > 0) {
+            exchanger().update();
+            computeFastForces();
+         }
+         factor = (k == 0) ? 1.0 : 2.0;
+         atomStorage().begin(atomIter);
+         for ( ; atomIter.notEnd(); ++atomIter) {
+            id = atomIter->typeId();
+            dv.multiply(atomIter->force(), factor*innerPrefactors_[id]);
+            atomIter->velocity() += dv;
+            dr.multiply(atomIter->velocity(), h);
+            atomIter->position() += dr;
+         }
+      }
+   }
+
+   /*
+   * Final half step velocity update with fast and slow forces.
+   */
+   void NveRespaIntegrator::integrateStep2()
+   {
+      Vector dv;
+      AtomIterator atomIter;
+      int id, typeId;
+
+      // Store total forces, then compute fast forces
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         slowForces_[atomIter->arrayId()] = atomIter->force();
+      }
+      computeFastForces();
+
+      // Extract slow forces, update velocities, restore total forces
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         id = atomIter->arrayId();
+         typeId = atomIter->typeId();
+         Vector& slowForce = slowForces_[id];
+         slowForce -= atomIter->force();
+         dv.multiply(atomIter->force(), innerPrefactors_[typeId]);
+         atomIter->velocity() += dv;
+         dv.multiply(slowForce, prefactors_[typeId]);
+         atomIter->velocity() += dv;
+         atomIter->force() += slowForce;
+      }
+      hasSlowForces_ = true;
+
+      // Notify observers of change in velocity
+      simulation().velocitySignal().notify();
+   }
+
+}
@@ -0,0 +1,132 @@
+#ifndef DDMD_NVE_RESPA_INTEGRATOR_H
+#define DDMD_NVE_RESPA_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TwoStepIntegrator.h"      // base class
+#include <util/containers/DArray.h> // member
+#include <util/space/Vector.h>      // member template argument
+
+namespace DdMd
+{
+
+   class Simulation;
+   using namespace Util;
+
+   /**
+   * An NVE multiple time step (r-RESPA) integrator.
+   *
+   * Forces are split into slowly varying pair and coulomb forces and
+   * rapidly varying bond, angle, dihedral and external forces, which
+   * are computed by Integrator::computeFastForces(). Each step of
+   * length dt applies a half step velocity update using the slow
+   * forces, nInner velocity-Verlet steps of length dt/nInner using
+   * only the fast forces, and a final half step velocity update using
+   * slow forces evaluated at the new positions. The integrator is
+   * equivalent to NveIntegrator when nInner = 1.
+   *
+   * Pair forces are computed once per step, by the total force
+   * calculation of the TwoStepIntegrator main loop. Ghost positions
+   * are updated before each inner force evaluation after the first.
+   * Slow forces are obtained by subtracting the fast forces from the
+   * total forces, at the cost of one extra fast force evaluation per
+   * step. They are stored between steps, indexed by Atom::arrayId(),
+   * and recomputed in the first step after setup().
+   *
+   * \sa \ref ddMd_integrator_NveRespaIntegrator_page "parameter file format"
+   * \ingroup DdMd_Integrator_Module
+   */
+   class NveRespaIntegrator : public TwoStepIntegrator
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      NveRespaIntegrator(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      ~NveRespaIntegrator();
+
+      /**
+      * Read required parameters.
+      *
+      * Reads the time step dt and the number nInner of inner steps.
+      */
+      void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+   protected:
+
+      /**
+      * Setup state just before main loop.
+      *
+      * Calls Integrator::setupAtoms(), initializes prefactor arrays.
+      */
+      void setup();
+
+      /**
+      * Execute first step of two-step integrator.
+      *
+      * Half-update velocities with slow forces, then execute the
+      * inner loop with fast forces.
+      */
+      virtual void integrateStep1();
+
+      /**
+      * Execute second step of two-step integrator.
+      *
+      * Second half-update of velocities with fast and slow forces.
+      */
+      virtual void integrateStep2();
+
+   private:
+
+      /// Slow forces on local atoms, indexed by Atom::arrayId().
+      DArray<Vector> slowForces_;
+
+      /// Factors of 0.5*dt_/mass, calculated in setup().
+      DArray<double> prefactors_;
+
+      /// Factors of 0.5*dt_/(nInner*mass), calculated in setup().
+      DArray<double> innerPrefactors_;
+
+      /// Outer time step (parameter).
+      double  dt_;
+
+      /// Number of inner steps per outer step (parameter).
+      int nInner_;
+
+      /// Are slowForces_ valid for the current local atoms?
+      bool hasSlowForces_;
+
+      /*
+      * Check parameters and allocate arrays.
+      */
+      void allocate();
+
+   };
+
+}
+#endif
@@ -0,0 +1,330 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "NvtDpdIntegrator.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/storage/GhostIterator.h>
+#include <ddMd/communicate/Exchanger.h>
+#include <ddMd/neighbor/PairList.h>
+#include <ddMd/neighbor/PairIterator.h>
+#include <ddMd/potentials/pair/PairPotential.h>
+#include <util/ensembles/EnergyEnsemble.h>
+#include <util/space/Vector.h>
+#include <util/mpi/MpiLoader.h>
+#include <util/global.h>
+
+#include <iostream>
+
+/*
+* Choice of DPD weighting function w_R(r) for random forces, as in
+* McMd::NvtDpdVvIntegrator. The dissipative weight is w_D = w_R*w_R.
+*
+* 0: w_R = 1, 1: w_R = 1 - r/cutoff, 2: w_R = 1 - r*r/(cutoff*cutoff)
+*/
+#define DDMD_DPD_TYPE 0
+
+namespace DdMd
+{
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   NvtDpdIntegrator::NvtDpdIntegrator(Simulation& simulation)
+    : TwoStepIntegrator(simulation),
+      dt_(0.0),
+      cutoff_(0.0),
+      gamma_(0.0),
+      sigma_(0.0),
+      cutoffSq_(0.0),
+      prefactors_(),
+      oldVelocities_(),
+      atomCapacity_(0),
+      philox_(),
+      philoxSeed_(0),
+      philoxStream_(0)
+   {  setClassName("NvtDpdIntegrator"); }
+
+   /*
+   * Destructor.
+   */
+   NvtDpdIntegrator::~NvtDpdIntegrator()
+   {}
+
+   /*
+   * Read parameters dt, cutoff, gamma and base class parameters.
+   */
+   void NvtDpdIntegrator::readParameters(std::istream& in)
+   {
+      read<double>(in, "dt", dt_);
+      read<double>(in, "cutoff", cutoff_);
+      read<double>(in, "gamma", gamma_);
+      Integrator::readParameters(in);
+      allocate();
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void NvtDpdIntegrator::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<double>(ar, "dt", dt_);
+      loadParameter<double>(ar, "cutoff", cutoff_);
+      loadParameter<double>(ar, "gamma", gamma_);
+      Integrator::loadParameters(ar);
+      MpiLoader<Serializable::IArchive> loader(*this, ar);
+      loader.load(philoxSeed_);
+      loader.load(philoxStream_);
+      allocate();
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void NvtDpdIntegrator::save(Serializable::OArchive &ar)
+   {
+      ar << dt_;
+      ar << cutoff_;
+      ar << gamma_;
+      Integrator::save(ar);
+      ar << philoxSeed_;
+      ar << philoxStream_;
+   }
+
+   /*
+   * Clear statistics and step counter, and start a new random stream.
+   */
+   void NvtDpdIntegrator::clear()
+   {
+      // The first clear() precedes any run, and so keeps stream 0
+      if (isSetup()) {
+         ++philoxStream_;
+      }
+      Integrator::clear();
+   }
+
+   /*
+   * Check cutoff and allocate arrays (private).
+   */
+   void NvtDpdIntegrator::allocate()
+   {
+      if (cutoff_ > pairPotential().maxPairCutoff()) {
+         UTIL_THROW("DPD cutoff > maxPairCutoff of pair potential");
+      }
+      if (!prefactors_.isAllocated()) {
+         prefactors_.allocate(simulation().nAtomType());
+      }
+      if (!oldVelocities_.isAllocated()) {
+         atomCapacity_ = atomStorage().atomCapacity();
+         oldVelocities_.allocate(atomCapacity_
+                                 + atomStorage().ghostCapacity());
+      }
+   }
+
+   /*
+   * Setup at beginning of run, before entering main loop.
+   */
+   void NvtDpdIntegrator::setup()
+   {
+      // Precondition
+      const EnergyEnsemble& energyEnsemble = simulation().energyEnsemble();
+      if (!energyEnsemble.isIsothermal()) {
+         UTIL_THROW("Energy ensemble is not isothermal");
+      }
+
+      // Initialize state and clear statistics on first usage.
+      if (!isSetup()) {
+         clear();
+         setIsSetup();
+      }
+
+      // Exchange atoms, build pair list, compute forces.
+      setupAtoms();
+
+      // Set constants
+      sigma_ = sqrt(2.0*gamma_*energyEnsemble.temperature()/dt_);
+      cutoffSq_ = cutoff_*cutoff_;
+      double dtHalf = 0.5*dt_;
+      int nAtomType = prefactors_.capacity();
+      for (int i = 0; i < nAtomType; ++i) {
+         prefactors_[i] = dtHalf/simulation().atomType(i).mass();
+      }
+
+      // Key random forces by a seed that is the same on all processors
+      if (philoxSeed_ == 0) {
+         philoxSeed_ = randomForceSeed();
+      }
+      philox_.setSeed(philoxSeed_, philoxStream_);
+
+      // Add dissipative and random forces for the current step
+      addDpdForces(iStep_, false);
+   }
+
+   /*
+   * Index of an atom in oldVelocities_ (private).
+   */
+   inline int NvtDpdIntegrator::velocityId(const Atom& atom) const
+   {
+      if (atom.isGhost()) {
+         return atomCapacity_ + atom.arrayId();
+      } else {
+         return atom.arrayId();
+      }
+   }
+
+   /*
+   * Add dissipative and (optionally) random pair forces (private).
+   */
+   void NvtDpdIntegrator::addDpdForces(int iStep, bool isIncrement)
+   {
+      const int BlockSize = 64;
+      Atom* ptrs0[BlockSize];
+      Atom* ptrs1[BlockSize];
+      int ids0[BlockSize];
+      int ids1[BlockSize];
+      double weights[BlockSize];
+      double noise[BlockSize];
+      Vector units[BlockSize];
+      Vector dr, dv, f;
+      PairIterator iter;
+      Atom* atom0Ptr;
+      Atom* atom1Ptr;
+      double rsq, r, fd;
+      int k, n;
+
+      const bool reverse = simulation().reverseUpdateFlag();
+
+      // Velocities of ghosts are required for dissipative forces.
+      exchanger().updateVelocities();
+
+      // Ghost forces accumulate values for reverse communication.
+      if (reverse) {
+         GhostIterator ghostIter;
+         atomStorage().begin(ghostIter);
+         for ( ; ghostIter.notEnd(); ++ghostIter) {
+            ghostIter->force().zero();
+         }
+      }
+
+      pairPotential().pairList().begin(iter);
+      while (iter.notEnd()) {
+
+         // Gather up to BlockSize pairs within cutoff
+         n = 0;
+         while (n < BlockSize && iter.notEnd()) {
+            iter.getPair(atom0Ptr, atom1Ptr);
+            ++iter;
+            dr.subtract(atom0Ptr->position(), atom1Ptr->position());
+            rsq = dr.square();
+            if (rsq < cutoffSq_) {
+               r = sqrt(rsq);
+               units[n].divide(dr, r);
+               #if DDMD_DPD_TYPE == 0
+               weights[n] = 1.0;
+               #endif
+               #if DDMD_DPD_TYPE == 1
+               weights[n] = 1.0 - r/cutoff_;
+               #endif
+               #if DDMD_DPD_TYPE == 2
+               weights[n] = 1.0 - rsq/cutoffSq_;
+               #endif
+               ptrs0[n] = atom0Ptr;
+               ptrs1[n] = atom1Ptr;
+               ids0[n] = atom0Ptr->id();
+               ids1[n] = atom1Ptr->id();
+               ++n;
+            }
+         }
+
+         // Generate pair noise, independent of which processor visits a pair
+         if (!isIncrement) {
+            philox_.gaussianPairs(iStep, ids0, ids1, n, noise);
+         }
+
+         // Add pair forces
+         for (k = 0; k < n; ++k) {
+            atom0Ptr = ptrs0[k];
+            atom1Ptr = ptrs1[k];
+            dv.subtract(atom0Ptr->velocity(), atom1Ptr->velocity());
+            if (isIncrement) {
+               dv -= oldVelocities_[velocityId(*atom0Ptr)];
+               dv += oldVelocities_[velocityId(*atom1Ptr)];
+               fd = -gamma_*weights[k]*weights[k]*dv.dot(units[k]);
+            } else {
+               fd = -gamma_*weights[k]*weights[k]*dv.dot(units[k])
+                  + sigma_*weights[k]*noise[k];
+            }
+            f.multiply(units[k], fd);
+            atom0Ptr->force() += f;
+            if (reverse || !atom1Ptr->isGhost()) {
+               atom1Ptr->force() -= f;
+            }
+         }
+
+      }
+
+      if (reverse) {
+         exchanger().reverseUpdate();
+      }
+   }
+
+   /*
+   * First half of velocity-Verlet update.
+   */
+   void NvtDpdIntegrator::integrateStep1()
+   {
+      Vector dv;
+      Vector dr;
+      AtomIterator atomIter;
+
+      // Forces include dissipative and random forces from the last step.
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         dv.multiply(atomIter->force(), prefactors_[atomIter->typeId()]);
+         atomIter->velocity() += dv;
+         dr.multiply(atomIter->velocity(), dt_);
+         atomIter->position() += dr;
+      }
+   }
+
+   /*
+   * Second half of velocity-Verlet update.
+   */
+   void NvtDpdIntegrator::integrateStep2()
+   {
+      Vector dv;
+      AtomIterator atomIter;
+      GhostIterator ghostIter;
+
+      // Add dissipative and random forces, using half-step velocities.
+      addDpdForces(iStep_ + 1, false);
+
+      // Store half-step velocities of local and ghost atoms.
+      atomStorage().begin(ghostIter);
+      for ( ; ghostIter.notEnd(); ++ghostIter) {
+         oldVelocities_[velocityId(*ghostIter)] = ghostIter->velocity();
+      }
+
+      // Second half velocity update
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         oldVelocities_[velocityId(*atomIter)] = atomIter->velocity();
+         dv.multiply(atomIter->force(), prefactors_[atomIter->typeId()]);
+         atomIter->velocity() += dv;
+      }
+
+      // Update dissipative forces for new velocities, for the next step.
+      addDpdForces(iStep_ + 1, true);
+
+      // Notify observers of change in velocity
+      simulation().velocitySignal().notify();
+   }
+
+}
+#undef DDMD_DPD_TYPE
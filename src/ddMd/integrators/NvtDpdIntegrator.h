@@ -0,0 +1,170 @@
+#ifndef DDMD_NVT_DPD_INTEGRATOR_H
+#define DDMD_NVT_DPD_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TwoStepIntegrator.h"      // base class
+#include <util/random/Philox.h>     // member
+#include <util/containers/DArray.h> // member template
+
+namespace DdMd
+{
+
+   class Simulation;
+   class Atom;
+   using namespace Util;
+
+   /**
+   * A velocity-Verlet dissipative particle dynamics (DPD) integrator.
+   *
+   * This class implements the DPD-VV algorithm of Besold et al., as
+   * does McMd::NvtDpdVvIntegrator, with pairwise dissipative and random
+   * forces computed over the PairList, including pairs of local and
+   * ghost atoms. Pair random forces are generated by a counter-based
+   * Util::Philox generator keyed by a run index, the step index and the
+   * ids of the two atoms, so that both processors that own atoms of a
+   * pair that spans a domain boundary generate the same value. The run
+   * index is incremented by clear(), so that a run after the step index
+   * is reset by CLEAR_INTEGRATOR does not repeat earlier random forces. Ghost velocities
+   * are communicated by Exchanger::updateVelocities(). Forces on ghost
+   * atoms are returned to their owners by a reverse communication only
+   * if reverse communication is enabled (Simulation::reverseUpdateFlag);
+   * otherwise, pairs that span a boundary are evaluated on both
+   * processors, each of which increments only the force on its local
+   * atom.
+   *
+   * Dissipative and random forces are added to the atomic forces, and
+   * are thus included in the atomic forces seen by analyzers.
+   *
+   * \sa \ref ddMd_integrator_NvtDpdIntegrator_page "parameter file format"
+   * \ingroup DdMd_Integrator_Module
+   */
+   class NvtDpdIntegrator : public TwoStepIntegrator
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      NvtDpdIntegrator(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      ~NvtDpdIntegrator();
+
+      /**
+      * Read parameters dt, cutoff and gamma, and base class parameters.
+      *
+      * \param in input parameter stream
+      */
+      void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Clear statistics and reset step counter, start a new run index.
+      */
+      virtual void clear();
+
+   protected:
+
+      /**
+      * Setup state just before main loop.
+      *
+      * Calls Integrator::setupAtoms(), initializes constants, and adds
+      * dissipative and random forces to the conservative forces.
+      */
+      void setup();
+
+      /**
+      * Execute first step of two-step integrator.
+      *
+      * Update positions and half-update velocities.
+      */
+      virtual void integrateStep1();
+
+      /**
+      * Execute second step of two-step integrator.
+      *
+      * Add dissipative and random forces, complete velocity update,
+      * then update dissipative forces for the new velocities.
+      */
+      virtual void integrateStep2();
+
+   private:
+
+      /// Time step (parameter)
+      double dt_;
+
+      /// Cutoff for DPD pair forces (parameter)
+      double cutoff_;
+
+      /// Dissipative force constant (parameter)
+      double gamma_;
+
+      /// Random force constant, sqrt(2*gamma*T/dt).
+      double sigma_;
+
+      /// Square of cutoff_.
+      double cutoffSq_;
+
+      /// Factors of 0.5*dt_/mass, calculated in setup().
+      DArray<double> prefactors_;
+
+      /// Velocities before final half step, local atoms then ghosts.
+      DArray<Vector> oldVelocities_;
+
+      /// Local atom capacity, offset of ghosts in oldVelocities_.
+      int atomCapacity_;
+
+      /// Counter-based generator for random pair forces.
+      Philox philox_;
+
+      /// Seed of philox_, chosen on first setup and saved for restarts.
+      unsigned long philoxSeed_;
+
+      /// Run index, used as the philox_ stream index, saved for restarts.
+      unsigned int philoxStream_;
+
+      /*
+      * Allocate arrays.
+      */
+      void allocate();
+
+      /*
+      * Add pair dissipative and random forces to atomic forces.
+      *
+      * If isIncrement, add only the change in dissipative forces
+      * arising from the change in velocities since oldVelocities_
+      * were stored, and add no random forces.
+      */
+      void addDpdForces(int iStep, bool isIncrement);
+
+      /*
+      * Index of an atom in oldVelocities_.
+      */
+      int velocityId(const Atom& atom) const;
+
+   };
+
+}
+#endif
@@ -13,6 +13,7 @@
 #include <ddMd/potentials/pair/PairPotential.h>
 #include <util/ensembles/EnergyEnsemble.h>
 #include <util/space/Vector.h>
+#include <util/mpi/MpiLoader.h>
 #include <util/global.h>
 
 #include <iostream>
@@ -30,7 +31,10 @@ namespace DdMd
      gamma_(0.0),
      prefactors_(),
      cv_(),
-     cr_()
+     cr_(),
+     philox_(),
+     philoxSeed_(0),
+     philoxStream_(0)
    {  setClassName("NvtLangevinIntegrator"); }
 
    /*
@@ -62,7 +66,11 @@ namespace DdMd
    void NvtLangevinIntegrator::loadParameters(Serializable::IArchive &ar)
    {
       loadParameter<double>(ar, "dt", dt_);
+      loadParameter<double>(ar, "gamma", gamma_);
       Integrator::loadParameters(ar);
+      MpiLoader<Serializable::IArchive> loader(*this, ar);
+      loader.load(philoxSeed_);
+      loader.load(philoxStream_);
 
       int nAtomType = simulation().nAtomType();
       if (!prefactors_.isAllocated()) {
@@ -81,6 +89,20 @@ namespace DdMd
       ar << dt_;
       ar << gamma_;
       Integrator::save(ar);
+      ar << philoxSeed_;
+      ar << philoxStream_;
+   }
+
+   /*
+   * Clear statistics and step counter, and start a new random stream.
+   */
+   void NvtLangevinIntegrator::clear()
+   {
+      // The first clear() precedes any run, and so keeps stream 0
+      if (isSetup()) {
+         ++philoxStream_;
+      }
+      Integrator::clear();
    }
  
    /*
@@ -109,6 +131,12 @@ namespace DdMd
       double d = 2.0/(1.0 + exp(-dt_*gamma_));
       double cr = 12.0*temp*d*(1.0 - exp(-2.0*dt_*gamma_))/(dt_*dt_);
 
+      // Key random forces by a seed that is the same on all processors
+      if (philoxSeed_ == 0) {
+         philoxSeed_ = randomForceSeed();
+      }
+      philox_.setSeed(philoxSeed_, philoxStream_);
+
       // Loop over atom types
       double dtHalf = 0.5*dt_;
       double mass;
@@ -150,9 +178,9 @@ namespace DdMd
    */
    void NvtLangevinIntegrator::integrateStep2()
    {
-      Util::Random& random = simulation().random();
       Vector dv;
       Vector df;
+      double r[4];
       double cr;
       AtomIterator atomIter;
       int typeId, j;
@@ -165,8 +193,9 @@ namespace DdMd
          // Add Langevin drag and random force to atomic force
          df.multiply(atomIter->velocity(), cv_[typeId]);
          cr = cr_[typeId];
+         philox_.uniform(iStep_, atomIter->id(), 0, r);
          for (j=0; j < Dimension; ++j) {
-            df[j] += (random.uniform() - 0.5)*cr;
+            df[j] += (r[j] - 0.5)*cr;
          }
          atomIter->force() += df;
 
@@ -9,6 +9,7 @@
 */
 
 #include "TwoStepIntegrator.h"      // base class
+#include <util/random/Philox.h>     // member
 
 namespace DdMd
 {
@@ -28,6 +29,14 @@ namespace DdMd
    * in which \f$\gamma\f$ is a velocity relaxation rate (inverse 
    * time) parameter, \f${\bf v}\f$ is a particle velocity, and 
    * \f${\bf f}^{\rm (r)}\f$ is a random force.
+   *
+   * Random forces are generated by a counter-based Util::Philox
+   * generator, keyed by a seed chosen by Integrator::randomForceSeed(),
+   * a run index, the step index and the atom id. The run index is
+   * incremented by clear(), which resets the step index, so that a run
+   * after CLEAR_INTEGRATOR does not repeat the random forces of earlier
+   * runs. The trajectory is thus independent of the number of
+   * processors and of the order in which atoms are stored.
    * 
    * \sa \ref ddMd_integrator_NvtLangevinIntegrator_page "parameter file format"
    * \sa \ref algorithms_Langevin_page "algorithm"
@@ -68,6 +77,11 @@ namespace DdMd
       * \param ar output/saving archive
       */
       virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Clear statistics and reset step counter, start a new run index.
+      */
+      virtual void clear();
   
    protected:
 
@@ -109,6 +123,15 @@ namespace DdMd
       /// Constant for random force.
       DArray<double> cr_;
 
+      /// Counter-based generator for random forces.
+      Philox philox_;
+
+      /// Seed of philox_, chosen on first setup and saved for restarts.
+      unsigned long philoxSeed_;
+
+      /// Run index, used as the philox_ stream index, saved for restarts.
+      unsigned int philoxStream_;
+
    };
 
 }
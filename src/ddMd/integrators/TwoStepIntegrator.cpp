@@ -9,6 +9,7 @@
 #include <ddMd/simulation/Simulation.h>
 #include <ddMd/storage/AtomStorage.h>
 #include <ddMd/communicate/Exchanger.h>
+#include <ddMd/communicate/LoadBalancer.h>
 #ifdef DDMD_MODIFIERS
 #include <ddMd/modifiers/ModifierManager.h>
 #endif
@@ -73,9 +74,20 @@ namespace DdMd
       // Main MD loop
       timer().start();
       exchanger().timer().start();
+      LoadBalancer& loadBalancer = simulation().loadBalancer();
+      loadBalancer.setup(iStep_, pairForceTime());
       int  beginStep = iStep_;
       int  endStep = iStep_ + nStep;
       bool needExchange;
+
+      // Defer exchange checks only if no modifiers are active, since
+      // modifiers may act between the exchange and force computation.
+      bool isDeferred = deferExchangeCheck();
+      #ifdef DDMD_MODIFIERS 
+      if (modifierManager.size()) {
+         isDeferred = false;
+      }
+      #endif
       for ( ; iStep_ < endStep; ++iStep_) {
 
          // Atomic coordinates must be Cartesian on entry to loop body.
@@ -119,9 +131,16 @@ namespace DdMd
          timer().stamp(MODIFIER);
          #endif
    
-         // Check if exchange and reneighboring is necessary
+         // Check if exchange and reneighboring is necessary. If
+         // isDeferred, the global reduction is only begun here, and 
+         // forces are first computed speculatively without an exchange.
          // Note: Integrate::isExchangeNeeded uses timer.
-         needExchange = isExchangeNeeded(pairPotential().skin());
+         if (isDeferred) {
+            beginExchangeCheck(pairPotential().skin());
+            needExchange = false;
+         } else {
+            needExchange = isExchangeNeeded(pairPotential().skin());
+         }
 
          if (!atomStorage().isCartesian()) {
             UTIL_THROW("Error: atomic coordinates are not Cartesian");
@@ -129,49 +148,7 @@ namespace DdMd
 
          // Exchange atoms if necessary
          if (needExchange) {
-
-            #ifdef DDMD_MODIFIERS 
-            modifierManager.preTransform(iStep_);
-            timer().stamp(MODIFIER);
-            #endif
-      
-            // Transform to scaled [0,1] coordinates
-            atomStorage().clearSnapshot();
-            atomStorage().transformCartToGen(boundary());
-            timer().stamp(Integrator::TRANSFORM_F);
-
-            #ifdef DDMD_MODIFIERS 
-            modifierManager.preExchange(iStep_);
-            timer().stamp(MODIFIER);
-            #endif
-      
-            // Exchange atom ownership, reidentify ghosts
-            exchanger().exchange();
-            timer().stamp(Integrator::EXCHANGE);
-
-            #ifdef DDMD_MODIFIERS 
-            modifierManager.postExchange(iStep_);
-            timer().stamp(MODIFIER);
-            #endif
-   
-            // Build cell list 
-            pairPotential().buildCellList();
-            timer().stamp(Integrator::CELLLIST);
-
-            // Transform from scaled [0,1] to Cartesian coordinates.
-            atomStorage().transformGenToCart(boundary());
-            timer().stamp(Integrator::TRANSFORM_R);
-
-            // Build pair list
-            atomStorage().makeSnapshot();
-            pairPotential().buildPairList();
-            timer().stamp(Integrator::PAIRLIST);
-
-            #ifdef DDMD_MODIFIERS 
-            modifierManager.postNeighbor(iStep_);
-            timer().stamp(MODIFIER);
-            #endif
-   
+            exchangeAtoms();
          } else { // Update step (no exchange)
 
             #ifdef DDMD_MODIFIERS 
@@ -179,20 +156,37 @@ namespace DdMd
             timer().stamp(MODIFIER);
             #endif
      
-            // Update all ghost atom positions 
-            exchanger().update();
+            // Update all ghost atom positions. If overlapUpdate() and the 
+            // boundary is rigid, only begin the update here, and complete
+            // it within computeForces() (see PairPotential).
+            if (overlapUpdate() && 
+                simulation().boundaryEnsemble().isRigid()) {
+               exchanger().beginUpdate();
+            } else {
+               exchanger().update();
+            }
             timer().stamp(UPDATE);
 
             #ifdef DDMD_MODIFIERS 
+            // Modifiers may require current ghost positions
+            if (modifierManager.size()) {
+               exchanger().endUpdate();
+            }
             modifierManager.postUpdate(iStep_);
             timer().stamp(MODIFIER);
             #endif
    
          }
-         simulation().exchangeSignal().notify();
+
+         // If isDeferred, the exchange signal is sent only after the 
+         // final exchange decision, once per step.
+         if (!isDeferred) {
+            simulation().exchangeSignal().notify();
+         }
    
          #ifdef DDMD_INTEGRATOR_DEBUG
-         // Sanity check
+         // Sanity check (requires current ghost positions)
+         exchanger().endUpdate();
          simulation().isValid();
          timer().stamp(DEBUG);
          #endif
@@ -217,6 +211,20 @@ namespace DdMd
             computeForcesAndVirial();
          }
 
+         // Complete deferred exchange check. If an exchange was needed,
+         // discard the speculative forces, exchange, and recompute.
+         if (isDeferred) {
+            if (endExchangeCheck()) {
+               exchangeAtoms();
+               if (simulation().boundaryEnsemble().isRigid()) {
+                  computeForces();
+               } else {
+                  computeForcesAndVirial();
+               }
+            }
+            simulation().exchangeSignal().notify();
+         }
+
          #ifdef DDMD_MODIFIERS 
          modifierManager.postForce(iStep_);
          timer().stamp(MODIFIER);
@@ -259,4 +267,62 @@ namespace DdMd
 
    }
 
+   /*
+   * Exchange atoms, and rebuild cell and pair lists (private).
+   */
+   void TwoStepIntegrator::exchangeAtoms()
+   {
+      #ifdef DDMD_MODIFIERS 
+      ModifierManager& modifierManager = simulation().modifierManager();
+      #endif
+      LoadBalancer& loadBalancer = simulation().loadBalancer();
+
+      #ifdef DDMD_MODIFIERS 
+      modifierManager.preTransform(iStep_);
+      timer().stamp(MODIFIER);
+      #endif
+
+      // Transform to scaled [0,1] coordinates
+      atomStorage().clearSnapshot();
+      atomStorage().transformCartToGen(boundary());
+      timer().stamp(Integrator::TRANSFORM_F);
+
+      #ifdef DDMD_MODIFIERS 
+      modifierManager.preExchange(iStep_);
+      timer().stamp(MODIFIER);
+      #endif
+
+      // Move domain boundaries, if scheduled
+      if (loadBalancer.isBalanceStep(iStep_)) {
+         loadBalancer.balance(iStep_, pairForceTime());
+      }
+
+      // Exchange atom ownership, reidentify ghosts
+      exchanger().exchange();
+      timer().stamp(Integrator::EXCHANGE);
+
+      #ifdef DDMD_MODIFIERS 
+      modifierManager.postExchange(iStep_);
+      timer().stamp(MODIFIER);
+      #endif
+   
+      // Build cell list 
+      pairPotential().buildCellList();
+      timer().stamp(Integrator::CELLLIST);
+
+      // Transform from scaled [0,1] to Cartesian coordinates.
+      atomStorage().transformGenToCart(boundary());
+      timer().stamp(Integrator::TRANSFORM_R);
+
+      // Build pair list
+      atomStorage().makeSnapshot();
+      pairPotential().buildPairList();
+      timer().stamp(Integrator::PAIRLIST);
+
+      #ifdef DDMD_MODIFIERS 
+      modifierManager.postNeighbor(iStep_);
+      timer().stamp(MODIFIER);
+      #endif
+   }
+
 }
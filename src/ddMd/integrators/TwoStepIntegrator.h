@@ -62,6 +62,13 @@ namespace DdMd
       */
       virtual void integrateStep2() = 0;
 
+   private:
+
+      /*
+      * Exchange atoms, rebuild cell and pair lists, with modifier hooks.
+      */
+      void exchangeAtoms();
+
    };
 
 }
@@ -2,8 +2,10 @@ ddMd_integrators_=\
    ddMd/integrators/Integrator.cpp \
    ddMd/integrators/TwoStepIntegrator.cpp \
    ddMd/integrators/NveIntegrator.cpp \
+   ddMd/integrators/NveRespaIntegrator.cpp \
    ddMd/integrators/NvtIntegrator.cpp \
    ddMd/integrators/NvtLangevinIntegrator.cpp \
+   ddMd/integrators/NvtDpdIntegrator.cpp \
    ddMd/integrators/NptIntegrator.cpp \
    ddMd/integrators/NphIntegrator.cpp \
    ddMd/integrators/IntegratorFactory.cpp
@@ -41,6 +41,9 @@ namespace DdMd
       previous_ = current;
    }
 
+   void DdTimer::add(int id, double interval)
+   {  times_[id] += interval; }
+
    void DdTimer::stop()
    {  time_ += MPI_Wtime() - begin_; }
 
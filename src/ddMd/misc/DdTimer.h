@@ -44,6 +44,18 @@ namespace DdMd
       */ 
       void stamp(int id);
 
+      /**
+      * Add a measured time interval to the total for interval id.
+      *
+      * This is an alternative to stamp(int) for intervals that are 
+      * measured independently of the timer, e.g., by different threads.
+      * Different threads may safely call add() with different ids.
+      *
+      * \param id  index of interval
+      * \param interval  elapsed time (sec) to add to total for id
+      */ 
+      void add(int id, double interval);
+
       /**
       * Stop total time accumulation.
       */ 
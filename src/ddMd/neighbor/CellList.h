@@ -259,6 +259,23 @@ namespace DdMd
       */
       int nReject() const;
 
+      /**
+      * Return a CellAtom by index in the array of all atoms.
+      *
+      * CellAtom objects are stored in a single array, sorted by cell, 
+      * with indices 0 <= i < nAtom().
+      *
+      * \param i atom index (0 <= i < nAtom())
+      */
+      const CellAtom& atom(int i) const;
+
+      /**
+      * Return the index of a CellAtom in the array of all atoms.
+      *
+      * \param atom CellAtom object that belongs to this CellList
+      */
+      int atomIndex(const CellAtom& atom) const;
+
       #ifdef UTIL_DEBUG
       /**
       * Get maximum number of atoms in one cell.
@@ -441,6 +458,21 @@ namespace DdMd
       return cells_[i]; 
    }
 
+   /*
+   * Return a CellAtom by index.
+   */
+   inline const CellAtom& CellList::atom(int i) const
+   {
+      assert(i >= 0 && i < nAtom_);  
+      return atoms_[i]; 
+   }
+
+   /*
+   * Return the index of a CellAtom in the array of all atoms.
+   */
+   inline int CellList::atomIndex(const CellAtom& atom) const
+   {  return int(&atom - &atoms_[0]); }
+
    /*
    * Return pointer to first Cell.
    */
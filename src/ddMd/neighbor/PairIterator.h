@@ -98,27 +98,38 @@ namespace DdMd
       */
       void getPair(Atom* &atom1Ptr, Atom* &atom2Ptr) const;
 
+      /**
+      * Get atom table indices for current pair of Atoms. 
+      *
+      * \param atom1Id atom table index of current atom 1 (output)
+      * \param atom2Id atom table index of current atom 2 (output)
+      */
+      void getPairIds(int &atom1Id, int &atom2Id) const;
+
    private:
  
-      /// Array of const pointers to primary atom in each pair.
-      Atom* const* atom1Ptrs_;  
+      /// Atom table of the parent PairList.
+      Atom* const* atomPtrs_;  
 
-      /// Array of const pointers to secondary atom in each pair.
-      Atom* const* atom2Ptrs_;  
+      /// Array of atom table indices of the primary atom in each pair.
+      const int*   atom1Ids_;  
 
-      /// Pointer to const index in atom2Ptrs_ of first neighbor of an Atom.
+      /// Array of atom table indices of the secondary atom in each pair.
+      const int*   atom2Ids_;  
+
+      /// Pointer to const index in atom2Ids_ of first neighbor of an Atom.
       const int*   first_; 
 
-      /// Number of primary atoms in atom1Ptrs_.
+      /// Number of primary atoms in atom1Ids_.
       int    nAtom1_;      
   
-      /// Number of secondary atoms in atom2Ptrs_.
+      /// Number of secondary atoms in atom2Ids_.
       int    nAtom2_;      
   
-      /// Current index of first atom in atom1Ptrs_.
+      /// Current index of first atom in atom1Ids_.
       int    atom1Id_;
 
-      /// Current index of second atom in atom2Ptrs_.
+      /// Current index of second atom in atom2Ids_.
       int    atom2Id_;
 
    // friends:
@@ -131,8 +142,9 @@ namespace DdMd
    * Default constructor.
    */
    inline PairIterator::PairIterator()
-    : atom1Ptrs_(0),
-      atom2Ptrs_(0),
+    : atomPtrs_(0),
+      atom1Ids_(0),
+      atom2Ids_(0),
       first_(0),
       nAtom1_(0),
       nAtom2_(0),
@@ -144,8 +156,9 @@ namespace DdMd
    * Constructor, initialized iterator.
    */
    inline PairIterator::PairIterator(const PairList &pairList)
-    : atom1Ptrs_(0),
-      atom2Ptrs_(0),
+    : atomPtrs_(0),
+      atom1Ids_(0),
+      atom2Ids_(0),
       first_(0),
       nAtom1_(0),
       nAtom2_(0),
@@ -162,8 +175,21 @@ namespace DdMd
       assert(atom1Id_ < nAtom1_);
       assert(atom2Id_ >=0);
       assert(atom2Id_ < nAtom2_);
-      atom1Ptr = atom1Ptrs_[atom1Id_];
-      atom2Ptr = atom2Ptrs_[atom2Id_];
+      atom1Ptr = atomPtrs_[atom1Ids_[atom1Id_]];
+      atom2Ptr = atomPtrs_[atom2Ids_[atom2Id_]];
+   }
+
+   /*
+   * Get atom table indices of current pair of Atoms. 
+   */
+   inline void PairIterator::getPairIds(int &atom1Id, int &atom2Id) const
+   {
+      assert(atom1Id_ >=0);
+      assert(atom1Id_ < nAtom1_);
+      assert(atom2Id_ >=0);
+      assert(atom2Id_ < nAtom2_);
+      atom1Id = atom1Ids_[atom1Id_];
+      atom2Id = atom2Ids_[atom2Id_];
    }
  
    /*
@@ -12,6 +12,8 @@
 #include <util/format/Int.h>
 #include <util/global.h>
 
+#include <algorithm>
+
 namespace DdMd
 {
 
@@ -21,8 +23,9 @@ namespace DdMd
    * Default constructor.
    */
    PairList::PairList()
-    : atom1Ptrs_(),
-      atom2Ptrs_(),
+    : atomPtrs_(),
+      atom1Ids_(),
+      atom2Ids_(),
       first_(),
       cutoff_(0.0),
       atomCapacity_(0),
@@ -50,8 +53,9 @@ namespace DdMd
       pairCapacity_ = pairCapacity;
       cutoff_       = cutoff;
 
-      atom1Ptrs_.reserve(atomCapacity_);
-      atom2Ptrs_.reserve(pairCapacity_);
+      atomPtrs_.reserve(atomCapacity_);
+      atom1Ids_.reserve(atomCapacity_);
+      atom2Ids_.reserve(pairCapacity_);
       first_.reserve(atomCapacity_ + 1);
   
       isAllocated_ = true;
@@ -62,8 +66,9 @@ namespace DdMd
    */
    void PairList::clear()
    { 
-      atom1Ptrs_.clear();
-      atom2Ptrs_.clear();
+      atomPtrs_.clear();
+      atom1Ids_.clear();
+      atom2Ids_.clear();
       first_.clear();
    }
  
@@ -84,6 +89,7 @@ namespace DdMd
       Vector dr;
       int na;                 // number of atoms in this cell
       int nn;                 // number of neighbors for a cell
+      int nAtom;              // number of atoms in the cell list
       int i, j;
       bool hasNeighbor;
   
@@ -91,13 +97,20 @@ namespace DdMd
       cutoffSq = cutoff_*cutoff_;
    
       // Initialize counters for primary atoms and neighbors
-      atom1Ptrs_.clear();
-      atom2Ptrs_.clear();
+      atomPtrs_.clear();
+      atom1Ids_.clear();
+      atom2Ids_.clear();
       first_.clear();
       first_.append(0);
 
       // Copy positions and ids into cell list
       cellList.update();
+
+      // Fill atom table, in the order of atoms in the cell list
+      nAtom = cellList.nAtom();
+      for (i = 0; i < nAtom; ++i) {
+         atomPtrs_.append(cellList.atom(i).ptr());
+      }
    
       // Find all neighbors (cell list)
       cellPtr = cellList.begin();
@@ -119,15 +132,15 @@ namespace DdMd
                   atom2Ptr = neighbors[j];
                   dr.subtract(atom2Ptr->position(), atom1Ptr->position()); 
                   if (dr.square() < cutoffSq && !maskPtr->isMasked(atom2Ptr->id())) {
-                     atom2Ptrs_.append(atom2Ptr->ptr());
+                     atom2Ids_.append(cellList.atomIndex(*atom2Ptr));
                      hasNeighbor = true;
                   }
                }
 
                // Complete processing of atom1.
                if (hasNeighbor) {
-                  atom1Ptrs_.append(atom1Ptr->ptr());
-                  first_.append(atom2Ptrs_.size());
+                  atom1Ids_.append(cellList.atomIndex(*atom1Ptr));
+                  first_.append(atom2Ids_.size());
                }
 
             } // for ia 
@@ -138,14 +151,14 @@ namespace DdMd
       }
 
       // Postconditions
-      if (atom1Ptrs_.size()) {
-         if (first_.size() != atom1Ptrs_.size() + 1) {
+      if (atom1Ids_.size()) {
+         if (first_.size() != atom1Ids_.size() + 1) {
             UTIL_THROW("Array size problem");
          }
          if (first_[0] != 0) {
             UTIL_THROW("Incorrect first element of first_");
          }
-         if (first_[atom1Ptrs_.size()] != atom2Ptrs_.size()) {
+         if (first_[atom1Ids_.size()] != atom2Ids_.size()) {
             UTIL_THROW("Incorrect last element of first_");
          }
       }
@@ -154,11 +167,11 @@ namespace DdMd
       ++buildCounter_;
  
       // Increment maxima
-      if (atom1Ptrs_.size() > maxNAtomLocal_) {
-         maxNAtomLocal_ = atom1Ptrs_.size();
+      if (atom1Ids_.size() > maxNAtomLocal_) {
+         maxNAtomLocal_ = atom1Ids_.size();
       }
-      if (atom2Ptrs_.size() > maxNPairLocal_) {
-         maxNPairLocal_ = atom2Ptrs_.size();
+      if (atom2Ids_.size() > maxNPairLocal_) {
+         maxNPairLocal_ = atom2Ids_.size();
       }
    }
 
@@ -167,17 +180,68 @@ namespace DdMd
    */
    void PairList::begin(PairIterator& iterator) const
    {
-      if (atom1Ptrs_.size()) {
-         iterator.atom1Ptrs_ = &atom1Ptrs_[0];
-         iterator.atom2Ptrs_ = &atom2Ptrs_[0];
+      if (atom1Ids_.size()) {
+         iterator.atomPtrs_  = &atomPtrs_[0];
+         iterator.atom1Ids_  = &atom1Ids_[0];
+         iterator.atom2Ids_  = &atom2Ids_[0];
          iterator.first_     = &first_[0];
-         iterator.nAtom1_    = atom1Ptrs_.size();
-         iterator.nAtom2_    = atom2Ptrs_.size();
+         iterator.nAtom1_    = atom1Ids_.size();
+         iterator.nAtom2_    = atom2Ids_.size();
          iterator.atom1Id_   = 0;
          iterator.atom2Id_   = 0;
       }
    }
 
+   /*
+   * Initialize a pair iterator for one block of the pair list.
+   */
+   void 
+   PairList::begin(PairIterator& iterator, int blockId, int nBlock) const
+   {
+      if (atom1Ids_.size()) {
+         int begin, end;
+         getBlock(blockId, nBlock, begin, end);
+         iterator.atomPtrs_  = &atomPtrs_[0];
+         iterator.atom1Ids_  = &atom1Ids_[0];
+         iterator.atom2Ids_  = &atom2Ids_[0];
+         iterator.first_     = &first_[0];
+         iterator.nAtom1_    = atom1Ids_.size();
+         iterator.nAtom2_    = first_[end];
+         iterator.atom1Id_   = begin;
+         iterator.atom2Id_   = first_[begin];
+      }
+   }
+
+   /*
+   * Get the range of primary atoms in one block of the pair list.
+   */
+   void 
+   PairList::getBlock(int blockId, int nBlock, int& begin, int& end) const
+   {
+      assert(nBlock > 0);
+      assert(blockId >= 0);
+      assert(blockId < nBlock);
+      int nAtom1 = atom1Ids_.size();
+      begin = 0;
+      end = nAtom1;
+      if (nAtom1) {
+         int nPair = atom2Ids_.size();
+         const int* firstPtr = &first_[0];
+
+         // Find range [begin, end) of primary atoms in this block. 
+         // Block boundaries are the first primary atoms for which
+         // first_[i] >= blockId*nPair/nBlock.
+         long beginPair = (long(nPair)*long(blockId))/long(nBlock);
+         long endPair = (long(nPair)*long(blockId + 1))/long(nBlock);
+         begin = std::lower_bound(firstPtr, firstPtr + nAtom1, 
+                                  int(beginPair)) - firstPtr;
+         if (blockId < nBlock - 1) {
+            end = std::lower_bound(firstPtr, firstPtr + nAtom1,
+                                   int(endPair)) - firstPtr;
+         }
+      }
+   }
+
    /*
    * Compute memory usage statistics (call on all processors).
    */
@@ -36,6 +36,12 @@ namespace DdMd
    * A PairIterator object must be used to iterate over all of the pairs in
    * in completed PairList (see documentation of PairIterator for usage).
    *
+   * Atoms are identified within the list by integer indices into an atom
+   * table, which contains pointers to all atoms of the CellList, sorted
+   * by cell. Force loops may use these indices to access positions and
+   * forces stored in packed arrays, via the atom1Id(), atom2Ids() and
+   * nNeighbor() functions. 
+   *
    * \ingroup DdMd_Neighbor_Module
    */
    class PairList 
@@ -91,12 +97,77 @@ namespace DdMd
       * \param iterator a PairList, initialized on output
       */
       void begin(PairIterator &iterator) const;
+
+      /**
+      * Initialize a PairIterator for one block of the PairList.
+      *
+      * The list is divided into nBlock consecutive blocks that contain
+      * similar numbers of pairs, such that all pairs with the same
+      * primary atom belong to the same block. Iterating over all blocks, 
+      * in order of increasing blockId, visits every pair exactly once, in
+      * the same order as a single iteration over the whole list. Blocks 
+      * may thus be processed independently (e.g., by different threads).
+      *
+      * \param iterator a PairIterator, initialized on output
+      * \param blockId  index of the desired block (0 <= blockId < nBlock)
+      * \param nBlock   number of blocks
+      */
+      void begin(PairIterator &iterator, int blockId, int nBlock) const;
+
+      /**
+      * Get the range of primary atoms in one block of the PairList.
+      *
+      * On return, primary atoms begin <= i < end belong to the specified
+      * block, as defined in the documentation of begin(PairIterator&, 
+      * int, int).
+      *
+      * \param blockId  index of the desired block (0 <= blockId < nBlock)
+      * \param nBlock   number of blocks
+      * \param begin    index of first primary atom in block (output)
+      * \param end      one past index of last primary atom (output)
+      */
+      void getBlock(int blockId, int nBlock, int& begin, int& end) const;
  
       /**
       * Get the number of primary atoms in the PairList.
       */
       int nAtom() const;
 
+      /**
+      * Get the atom table index of primary atom i.
+      *
+      * \param i  primary atom index (0 <= i < nAtom())
+      */
+      int atom1Id(int i) const;
+
+      /**
+      * Get the atom table indices of all neighbors of primary atom i.
+      *
+      * Returns a pointer to an array of nNeighbor(i) indices.
+      *
+      * \param i  primary atom index (0 <= i < nAtom())
+      */
+      const int* atom2Ids(int i) const;
+
+      /**
+      * Get the number of neighbors of primary atom i.
+      *
+      * \param i  primary atom index (0 <= i < nAtom())
+      */
+      int nNeighbor(int i) const;
+
+      /**
+      * Get the number of atoms in the atom table.
+      */
+      int atomTableSize() const;
+
+      /**
+      * Get a pointer to the atom with a specified atom table index.
+      *
+      * \param id  atom table index (0 <= id < atomTableSize())
+      */
+      Atom* atomPtr(int id) const;
+
       /**
       * Get the number of pairs in the PairList.
       */
@@ -169,22 +240,25 @@ namespace DdMd
 
    private:
   
-      /// Array of pointers to 1st (or primary) atom in each pair.
-      GArray<Atom*>  atom1Ptrs_;  
+      /// Atom table: pointers to all atoms in the CellList, sorted by cell.
+      GArray<Atom*>  atomPtrs_;  
+
+      /// Array of atom table indices of 1st (or primary) atom of each pair.
+      GArray<int>  atom1Ids_;  
 
-      /// Array of pointers to neighbor (or secondary) atom in each pair.
-      GArray<Atom*>  atom2Ptrs_;  
+      /// Array of atom table indices of neighbor (or secondary) atoms.
+      GArray<int>  atom2Ids_;  
 
-      /// Array of indices in atom2Ptrs_ of first neighbor of an Atom.
+      /// Array of indices in atom2Ids_ of first neighbor of an Atom.
       GArray<int>  first_; 
 
       /// Pair list cutoff radius (pair potential cutoff + skin_).
       double cutoff_;
    
-      /// Maximum number of atoms (dimension of atom1Ptrs_).
+      /// Maximum number of atoms (dimension of atom1Ids_).
       int  atomCapacity_;     
    
-      /// Maximum number of distinct pairs (dimension of atom2Ptrs_).
+      /// Maximum number of distinct pairs (dimension of atom2Ids_).
       int  pairCapacity_;     
    
       /// Maximum number of primary atoms on this proc since stats cleared.
@@ -208,16 +282,19 @@ namespace DdMd
       /* 
       * Implementation Notes:
       *
-      * The pair list is stored in Atom* pointer arrays atom1Ptrs_, atom2Ptrs_, 
-      * and in an integer array first_. Each element of atom1Ptrs_ contains a 
-      * pointer to the first atom in a pair (the primary Atom). Each element 
-      * of atom2Ptrs_ contains a pointer to the second atom in a pair (the 
-      * secondary Atom).  Secondary atoms that are neighbors of the same 
-      * primary atom are listed consecutively.  Element first_[i] contains the 
-      * array index of the first element in atom2Ptrs_ that contains a neighbor 
-      * of primary atom atom1Ptrs_[i]. Pointers to neighbors of primary atom
-      * *atom1Ptrs_[i] are thus stored in elements first_[i] <= j < first_[i+1]
-      * of atom2Ptrs_.  Each pair is included only once.
+      * Atoms are identified by indices in the atom table atomPtrs_, which 
+      * contains pointers to all atoms of the CellList, in the order in which 
+      * they are stored in the CellList. The pair list is stored in integer 
+      * arrays atom1Ids_, atom2Ids_ and first_. Each element of atom1Ids_ 
+      * contains the atom table index of the first atom in a pair (the primary
+      * Atom). Each element of atom2Ids_ contains the index of the second atom
+      * in a pair (the secondary Atom).  Secondary atoms that are neighbors of
+      * the same primary atom are listed consecutively.  Element first_[i] 
+      * contains the array index of the first element in atom2Ids_ that 
+      * contains a neighbor of primary atom atom1Ids_[i]. Indices of neighbors
+      * of primary atom atom1Ids_[i] are thus stored in elements 
+      * first_[i] <= j < first_[i+1] of atom2Ids_.  Each pair is included 
+      * only once.
       *
       * The only way legal way to loop over all atom pairs, using the public 
       * interface of a PairList, is to use a PairListIterator. See the 
@@ -230,12 +307,12 @@ namespace DdMd
       *    Atom* atom2Ptr;
       *
       *    \\ Loop over primary Atoms
-      *    for (i = 0; i < atom1Ptrs_.size(); ++i) {
-      *       atom1Ptr = atom1Ptrs_[i];
+      *    for (i = 0; i < atom1Ids_.size(); ++i) {
+      *       atom1Ptr = atomPtrs_[atom1Ids_[i]];
       *
       *       // Loop over secondary atoms
       *       for (j = first_[i]; j < first_[i+1]; ++j) {
-      *           atom2Ptr = atom2Ptrs_[j];
+      *           atom2Ptr = atomPtrs_[atom2Ids_[j]];
       *
       *           // ... Do something with Atoms *atom1Ptr and *atom2Ptr.
       *
@@ -243,7 +320,7 @@ namespace DdMd
       *    }
       *
       * Note that GArray<int> first_ contains one more elements than 
-      * atom1Ptrs_. The element first_[0] is equal to 0, and the last 
+      * atom1Ids_. The element first_[0] is equal to 0, and the last 
       * element is always equal to the total number of pairs.
       */
 
@@ -253,13 +330,43 @@ namespace DdMd
    * Get the current number of primary atoms in the pairlist.
    */ 
    inline int PairList::nAtom() const
-   {  return atom1Ptrs_.size(); }
+   {  return atom1Ids_.size(); }
 
    /*
    * Get the current number of pairs.
    */ 
    inline int PairList::nPair() const
-   {  return atom2Ptrs_.size(); }
+   {  return atom2Ids_.size(); }
+
+   /*
+   * Get the atom table index of primary atom i.
+   */ 
+   inline int PairList::atom1Id(int i) const
+   {  return atom1Ids_[i]; }
+
+   /*
+   * Get the atom table indices of neighbors of primary atom i.
+   */ 
+   inline const int* PairList::atom2Ids(int i) const
+   {  return &atom2Ids_[0] + first_[i]; }
+
+   /*
+   * Get the number of neighbors of primary atom i.
+   */ 
+   inline int PairList::nNeighbor(int i) const
+   {  return first_[i+1] - first_[i]; }
+
+   /*
+   * Get the number of atoms in the atom table.
+   */ 
+   inline int PairList::atomTableSize() const
+   {  return atomPtrs_.size(); }
+
+   /*
+   * Get a pointer to an atom, by atom table index.
+   */ 
+   inline Atom* PairList::atomPtr(int id) const
+   {  return atomPtrs_[id]; }
 
    /**
    * Get the maximum number of pairs. 
@@ -0,0 +1,32 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CoulombPotential.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+
+namespace DdMd
+{
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   CoulombPotential::CoulombPotential(Simulation& simulation)
+    : ewald_(),
+      simulationPtr_(&simulation),
+      boundaryPtr_(&simulation.boundary()),
+      storagePtr_(&simulation.atomStorage())
+   {  setClassName("CoulombPotential"); }
+
+   /*
+   * Destructor.
+   */
+   CoulombPotential::~CoulombPotential()
+   {}
+
+}
@@ -0,0 +1,118 @@
+#ifndef DDMD_COULOMB_POTENTIAL_H
+#define DDMD_COULOMB_POTENTIAL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/potentials/Potential.h>      // base class
+#include <inter/coulomb/EwaldInteraction.h> // member
+#include <util/boundary/Boundary.h>         // typedef
+#include <util/global.h>
+
+#include <string>
+
+namespace DdMd
+{
+
+   class Simulation;
+   class AtomStorage;
+
+   using namespace Util;
+   using namespace Inter;
+
+   /**
+   * Long range (k-space) part of an Ewald Coulomb potential.
+   *
+   * A CoulombPotential computes the k-space part of the Ewald sum, and
+   * the associated self and background energies. The real space part
+   * is computed by a CoulombPair pair interaction, which is constructed
+   * by the pair potential factory with a copy of the EwaldInteraction
+   * held by this object, and so must be read after this object.
+   * Charges are given by AtomType::charge().
+   *
+   * \ingroup DdMd_Coulomb_Module
+   */
+   class CoulombPotential : public Potential
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      CoulombPotential(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      virtual ~CoulombPotential();
+
+      /**
+      * Get Ewald parameters (epsilon, alpha and rSpaceCutoff).
+      */
+      const EwaldInteraction& ewaldInteraction() const;
+
+      /**
+      * Return name of k-space solver class (e.g., "SpmeKSpace").
+      */
+      virtual std::string kSpaceClassName() const = 0;
+
+   protected:
+
+      /**
+      * Get Ewald parameters by non-const reference.
+      */
+      EwaldInteraction& ewaldInteraction();
+
+      /**
+      * Get the parent Simulation by reference.
+      */
+      Simulation& simulation();
+
+      /**
+      * Get the Boundary by reference.
+      */
+      Boundary& boundary();
+
+      /**
+      * Get the AtomStorage by reference.
+      */
+      AtomStorage& storage();
+
+   private:
+
+      // Ewald parameters.
+      EwaldInteraction ewald_;
+
+      // Pointer to parent Simulation object.
+      Simulation* simulationPtr_;
+
+      // Pointer to associated Boundary object.
+      Boundary* boundaryPtr_;
+
+      // Pointer to associated AtomStorage object.
+      AtomStorage* storagePtr_;
+
+   };
+
+   inline const EwaldInteraction& CoulombPotential::ewaldInteraction() const
+   {  return ewald_; }
+
+   inline EwaldInteraction& CoulombPotential::ewaldInteraction()
+   {  return ewald_; }
+
+   inline Simulation& CoulombPotential::simulation()
+   {  return *simulationPtr_; }
+
+   inline Boundary& CoulombPotential::boundary()
+   {  return *boundaryPtr_; }
+
+   inline AtomStorage& CoulombPotential::storage()
+   {  return *storagePtr_; }
+
+}
+#endif
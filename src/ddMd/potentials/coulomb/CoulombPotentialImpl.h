@@ -0,0 +1,432 @@
+#ifndef DDMD_COULOMB_POTENTIAL_IMPL_H
+#define DDMD_COULOMB_POTENTIAL_IMPL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/potentials/coulomb/CoulombPotential.h>
+#include <util/containers/DArray.h>
+#include <util/global.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   class Simulation;
+
+   /**
+   * Implementation template for a CoulombPotential.
+   *
+   * The KSpace template argument is a k-space solver class, such as
+   * Inter::EwaldKSpace or Inter::SpmeKSpace. Each processor adds its
+   * local charges to the k-space accumulator (a structure factor or a
+   * charge mesh), the accumulators are summed over all processors with
+   * one MPI_Allreduce, and each processor then solves the k-space problem
+   * redundantly and computes forces on its own atoms. The accumulator
+   * has the size of the full mesh (or set of wavevectors), so this scheme
+   * is appropriate for meshes that are small compared to the number of
+   * atoms per processor.
+   *
+   * The parameter file block contains the EwaldInteraction parameters,
+   * followed by the parameters of the KSpace class.
+   *
+   * \ingroup DdMd_Coulomb_Module
+   */
+   template <class KSpace>
+   class CoulombPotentialImpl : public CoulombPotential
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      CoulombPotentialImpl(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      virtual ~CoulombPotentialImpl();
+
+      /**
+      * Read Ewald and k-space parameters.
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from archive and initialize, for restart.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive, for restart.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Return k-space solver class name.
+      */
+      virtual std::string kSpaceClassName() const;
+
+      /**
+      * Return k-space solver by reference.
+      */
+      KSpace& kSpace();
+
+      /// \name Total Energy, Forces and Stress
+      //@{
+
+      /**
+      * Add k-space forces to all local atoms.
+      *
+      * Call on all processors.
+      */
+      virtual void computeForces();
+
+      /**
+      * Compute total k-space, self and background energy.
+      *
+      * Call on all processors. The result is stored on the master.
+      */
+      #ifdef UTIL_MPI
+      virtual void computeEnergy(MPI::Intracomm& communicator);
+      #else
+      virtual void computeEnergy();
+      #endif
+
+      /**
+      * Compute k-space and background stress.
+      *
+      * Call on all processors. The result is stored on the master.
+      */
+      #ifdef UTIL_MPI
+      virtual void computeStress(MPI::Intracomm& communicator);
+      #else
+      virtual void computeStress();
+      #endif
+
+      /**
+      * Add k-space forces and compute stress, with one k-space solution.
+      *
+      * Call on all processors.
+      */
+      #ifdef UTIL_MPI
+      virtual void computeForcesAndStress(MPI::Intracomm& communicator);
+      #else
+      virtual void computeForcesAndStress();
+      #endif
+
+      //@}
+
+   private:
+
+      /// K-space solver.
+      KSpace kSpace_;
+
+      /// Charge of each atom type.
+      DArray<double> charges_;
+
+      /// Was this object initialized by (read|load)Parameters?
+      bool isInitialized_;
+
+      /*
+      * Copy atom type charges into charges_.
+      */
+      void initialize();
+
+      /*
+      * Accumulate local charges, reduce, solve, and optionally add forces.
+      */
+      void solve(bool needForce);
+
+      /*
+      * Compute sum of charges and sum of squared charges of local atoms.
+      */
+      void chargeSums(double& chargeSum, double& chargeSqSum);
+
+      /*
+      * Store k-space and background stress on the master processor.
+      */
+      void storeStress();
+
+   };
+
+}
+
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <util/space/Tensor.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   template <class KSpace>
+   CoulombPotentialImpl<KSpace>::CoulombPotentialImpl(Simulation& simulation)
+    : CoulombPotential(simulation),
+      kSpace_(),
+      charges_(),
+      isInitialized_(false)
+   {}
+
+   /*
+   * Destructor.
+   */
+   template <class KSpace>
+   CoulombPotentialImpl<KSpace>::~CoulombPotentialImpl()
+   {}
+
+   /*
+   * Read parameters from file.
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::readParameters(std::istream &in)
+   {
+      UTIL_CHECK(!isInitialized_);
+      bool nextIndent = false; // Do not indent blocks
+      addParamComposite(ewaldInteraction(), nextIndent);
+      ewaldInteraction().readParameters(in);
+      addParamComposite(kSpace_, nextIndent);
+      kSpace_.readParameters(in);
+      initialize();
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   template <class KSpace>
+   void
+   CoulombPotentialImpl<KSpace>::loadParameters(Serializable::IArchive &ar)
+   {
+      UTIL_CHECK(!isInitialized_);
+      bool nextIndent = false; // Do not indent blocks
+      addParamComposite(ewaldInteraction(), nextIndent);
+      ewaldInteraction().loadParameters(ar);
+      addParamComposite(kSpace_, nextIndent);
+      kSpace_.loadParameters(ar);
+      initialize();
+   }
+
+   /*
+   * Save internal state to an archive (call only on master processor).
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::save(Serializable::OArchive &ar)
+   {
+      ewaldInteraction().save(ar);
+      kSpace_.save(ar);
+   }
+
+   /*
+   * Return k-space class name.
+   */
+   template <class KSpace>
+   std::string CoulombPotentialImpl<KSpace>::kSpaceClassName() const
+   {  return kSpace_.className(); }
+
+   /*
+   * Return k-space solver.
+   */
+   template <class KSpace>
+   KSpace& CoulombPotentialImpl<KSpace>::kSpace()
+   {  return kSpace_; }
+
+   /*
+   * Add k-space forces to local atoms.
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::computeForces()
+   {  solve(true); }
+
+   /*
+   * Compute total Coulomb energy on all processors.
+   */
+   template <class KSpace>
+   #ifdef UTIL_MPI
+   void
+   CoulombPotentialImpl<KSpace>::computeEnergy(MPI::Intracomm& communicator)
+   #else
+   void CoulombPotentialImpl<KSpace>::computeEnergy()
+   #endif
+   {
+      if (isEnergySet()) return;
+      solve(false);
+
+      // Self energy is local; k-space and background are added on master
+      double chargeSum, chargeSqSum;
+      chargeSums(chargeSum, chargeSqSum);
+      double localEnergy = ewaldInteraction().selfEnergy(chargeSqSum);
+      double totalCharge = chargeSum;
+      bool isMaster = true;
+      #ifdef UTIL_MPI
+      communicator.Allreduce(&chargeSum, &totalCharge, 1,
+                             MPI::DOUBLE, MPI::SUM);
+      isMaster = (communicator.Get_rank() == 0);
+      #endif
+      if (isMaster) {
+         localEnergy += kSpace_.energy();
+         localEnergy += ewaldInteraction().backgroundEnergy(totalCharge,
+                                                     boundary().volume());
+      }
+      #ifdef UTIL_MPI
+      reduceEnergy(localEnergy, communicator);
+      #else
+      setEnergy(localEnergy);
+      #endif
+   }
+
+   /*
+   * Compute total Coulomb stress on all processors.
+   */
+   template <class KSpace>
+   #ifdef UTIL_MPI
+   void
+   CoulombPotentialImpl<KSpace>::computeStress(MPI::Intracomm& communicator)
+   #else
+   void CoulombPotentialImpl<KSpace>::computeStress()
+   #endif
+   {
+      if (isStressSet()) return;
+      solve(false);
+      storeStress();
+   }
+
+   /*
+   * Add k-space forces and compute stress.
+   */
+   template <class KSpace>
+   #ifdef UTIL_MPI
+   void CoulombPotentialImpl<KSpace>
+        ::computeForcesAndStress(MPI::Intracomm& communicator)
+   #else
+   void CoulombPotentialImpl<KSpace>::computeForcesAndStress()
+   #endif
+   {
+      // If stress is already set, just calculate forces
+      if (isStressSet()) {
+         computeForces();
+         return;
+      }
+      solve(true);
+      storeStress();
+   }
+
+   /*
+   * Copy atom type charges (private).
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::initialize()
+   {
+      int nAtomType = simulation().nAtomType();
+      charges_.allocate(nAtomType);
+      for (int i = 0; i < nAtomType; ++i) {
+         charges_[i] = simulation().atomType(i).charge();
+      }
+      isInitialized_ = true;
+   }
+
+   /*
+   * Accumulate, reduce and solve k-space problem (private).
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::solve(bool needForce)
+   {
+      AtomIterator iter;
+      double charge;
+
+      kSpace_.setup(boundary(), ewaldInteraction());
+      kSpace_.clear();
+      storage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         charge = charges_[iter->typeId()];
+         if (charge != 0.0) {
+            kSpace_.addCharge(iter->position(), charge);
+         }
+      }
+      #ifdef UTIL_MPI
+      simulation().domain().communicator().Allreduce(MPI::IN_PLACE,
+                kSpace_.accumulator(), kSpace_.accumulatorSize(),
+                MPI::DOUBLE, MPI::SUM);
+      #endif
+      kSpace_.solve();
+
+      if (needForce) {
+         storage().begin(iter);
+         for ( ; iter.notEnd(); ++iter) {
+            charge = charges_[iter->typeId()];
+            if (charge != 0.0) {
+               kSpace_.addForce(iter->position(), charge, iter->force());
+            }
+         }
+      }
+   }
+
+   /*
+   * Compute charge sums for local atoms (private).
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::chargeSums(double& chargeSum,
+                                                 double& chargeSqSum)
+   {
+      AtomIterator iter;
+      double charge;
+      chargeSum = 0.0;
+      chargeSqSum = 0.0;
+      storage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         charge = charges_[iter->typeId()];
+         chargeSum += charge;
+         chargeSqSum += charge*charge;
+      }
+   }
+
+   /*
+   * Store stress from the last k-space solution (private).
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::storeStress()
+   {
+      double chargeSum, chargeSqSum;
+      chargeSums(chargeSum, chargeSqSum);
+      double totalCharge = chargeSum;
+      bool isMaster = true;
+      #ifdef UTIL_MPI
+      MPI::Intracomm& communicator = simulation().domain().communicator();
+      communicator.Allreduce(&chargeSum, &totalCharge, 1,
+                             MPI::DOUBLE, MPI::SUM);
+      isMaster = (communicator.Get_rank() == 0);
+      #endif
+
+      // Stress is stored on the master processor, as for other potentials
+      Tensor stress;
+      stress.zero();
+      if (isMaster) {
+         double volume = boundary().volume();
+         double background;
+         background = ewaldInteraction().backgroundEnergy(totalCharge, volume);
+         stress = kSpace_.stress();
+         for (int i = 0; i < Dimension; ++i) {
+            stress(i, i) += background/volume;
+         }
+      }
+      setStress(stress);
+   }
+
+}
+#endif
@@ -0,0 +1,9 @@
+ddMd_potentials_coulomb_=\
+    ddMd/potentials/coulomb/CoulombPotential.cpp \
+    ddMd/potentials/coulomb/CoulombFactory.cpp 
+
+ddMd_potentials_coulomb_SRCS=\
+     $(addprefix $(SRC_DIR)/, $(ddMd_potentials_coulomb_))
+ddMd_potentials_coulomb_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(ddMd_potentials_coulomb_:.cpp=.o))
+
@@ -18,6 +18,10 @@
 #include <util/space/Vector.h>
 #include <util/global.h>
 
+#ifdef UTIL_OPENMP
+#include <omp.h>
+#endif
+
 namespace DdMd
 {
    using namespace Util;
@@ -29,12 +33,19 @@ namespace DdMd
     : skin_(0.0),
       cutoff_(0.0),
       pairCapacity_(0),
+      packedPositions_(),
+      packedTypeIds_(),
+      packedGhostFlags_(),
+      packCapacity_(0),
       domainPtr_(0),
       boundaryPtr_(0),
       storagePtr_(0),
       methodId_(0),
       nPair_(0),
-      pairEnergies_()
+      pairEnergies_(),
+      nThread_(maxNThread()),
+      threadTimer_(maxNThread()),
+      packedForces_()
    {  setClassName("PairPotential"); } 
 
    /*
@@ -44,12 +55,19 @@ namespace DdMd
     : skin_(0.0),
       cutoff_(0.0),
       pairCapacity_(0),
+      packedPositions_(),
+      packedTypeIds_(),
+      packedGhostFlags_(),
+      packCapacity_(0),
       domainPtr_(&simulation.domain()),
       boundaryPtr_(&simulation.boundary()),
       storagePtr_(&simulation.atomStorage()),
       methodId_(0),
       nPair_(0),
-      pairEnergies_()
+      pairEnergies_(),
+      nThread_(maxNThread()),
+      threadTimer_(maxNThread()),
+      packedForces_()
    {  setClassName("PairPotential"); } 
 
    /*
@@ -151,8 +169,110 @@ namespace DdMd
       // Allocate CellList
       int totalCapacity = localCapacity + storage().ghostCapacity();
       cellList_.allocate(totalCapacity, lower, upper, cutoffs, nCellCut_);
+
+      // Allocate packed arrays for all atoms in the cell list
+      packCapacity_ = totalCapacity;
+      packedPositions_.allocate(3*packCapacity_);
+      packedTypeIds_.allocate(packCapacity_);
+      packedGhostFlags_.allocate(packCapacity_);
+      packedForces_.allocate(3*nThread_*packCapacity_);
+      for (int i = 0; i < packedForces_.capacity(); ++i) {
+         packedForces_[i] = 0.0;
+      }
+   }
+
+   /*
+   * Return number of threads available for pair force loops.
+   */
+   int PairPotential::maxNThread()
+   {
+      #ifdef UTIL_OPENMP
+      return omp_get_max_threads();
+      #else
+      return 1;
+      #endif
+   }
+
+   /*
+   * Copy positions of PairList atoms to packed arrays.
+   */
+   void PairPotential::packPositions()
+   {
+      double* xs = &packedPositions_[0];
+      double* ys = xs + packCapacity_;
+      double* zs = ys + packCapacity_;
+      int n = pairList_.atomTableSize();
+      for (int i = 0; i < n; ++i) {
+         const Vector& position = pairList_.atomPtr(i)->position();
+         xs[i] = position[0];
+         ys[i] = position[1];
+         zs[i] = position[2];
+      }
+   }
+
+   /*
+   * Copy positions of ghost atoms in PairList to packed arrays.
+   */
+   void PairPotential::packGhostPositions()
+   {
+      double* xs = &packedPositions_[0];
+      double* ys = xs + packCapacity_;
+      double* zs = ys + packCapacity_;
+      int n = pairList_.atomTableSize();
+      for (int i = 0; i < n; ++i) {
+         if (packedGhostFlags_[i]) {
+            const Vector& position = pairList_.atomPtr(i)->position();
+            xs[i] = position[0];
+            ys[i] = position[1];
+            zs[i] = position[2];
+         }
+      }
    }
 
+   /*
+   * Add packed force increments to atomic forces, and zero them.
+   */
+   void PairPotential::unpackForces()
+   {
+      const int n = cellList_.nAtom();
+      const int nThread = nThread_;
+      const int capacity = packCapacity_;
+      double* forces = &packedForces_[0];
+
+      // Sum increments for each atom, in order of increasing thread id
+      #ifdef UTIL_OPENMP
+      #pragma omp parallel for num_threads(nThread) if (nThread > 1)
+      #endif
+      for (int i = 0; i < n; ++i) {
+         Vector& force = cellList_.atom(i).ptr()->force();
+         double* f;
+         for (int t = 0; t < nThread; ++t) {
+            f = forces + 3*t*capacity + i;
+            force[0] += f[0];
+            force[1] += f[capacity];
+            force[2] += f[2*capacity];
+            f[0] = 0.0;
+            f[capacity] = 0.0;
+            f[2*capacity] = 0.0;
+         }
+      }
+   }
+
+   #ifdef UTIL_OPENMP
+   /*
+   * Fill array of pointers to local cells.
+   */
+   void PairPotential::makeCellPtrs()
+   {
+      cellPtrs_.clear();
+      const Cell* cellPtr = cellList_.begin();
+      while (cellPtr) {
+         cellPtrs_.append(cellPtr);
+         cellPtr = cellPtr->nextCellPtr();
+      }
+   }
+   #endif
+
    /*
    * Build the cell list.
    */
@@ -209,6 +329,15 @@ namespace DdMd
          UTIL_THROW("Coordinates not Cartesian entering buildPairList");
       }
       pairList_.build(cellList_, reverseUpdateFlag());
+
+      // Pack types and ghost flags, which are fixed until the next build
+      Atom* atomPtr;
+      int n = pairList_.atomTableSize();
+      for (int i = 0; i < n; ++i) {
+         atomPtr = pairList_.atomPtr(i);
+         packedTypeIds_[i] = atomPtr->typeId();
+         packedGhostFlags_[i] = int(atomPtr->isGhost());
+      }
    }
 
    /*
@@ -6,6 +6,7 @@
 #include <ddMd/neighbor/PairList.h>     // member
 #include <ddMd/misc/DdTimer.h>          // member
 #include <util/boundary/Boundary.h>     // member (typedef)
+#include <util/containers/DArray.h>     // member
 #include <util/global.h>
 
 #include <iostream>
@@ -28,6 +29,7 @@ namespace DdMd
    class Simulation;
    class AtomStorage;
    class Domain;
+   class Exchanger;
    using namespace Util;
 
    /**
@@ -195,6 +197,27 @@ namespace DdMd
       */
       virtual std::string interactionClassName() const = 0;
 
+      /**
+      * Compute pair forces while completing a ghost position update.
+      *
+      * On entry, exchanger.beginUpdate() must have been called, and all
+      * atomic forces must have been zeroed. Forces for pairs of local
+      * atoms are computed first, with periodic calls to 
+      * exchanger.testUpdate() to make progress on communication. 
+      * The update is then completed by exchanger.endUpdate(), after
+      * which forces for pairs that involve a ghost atom are computed.
+      * The resulting forces are equal to those computed by calling 
+      * Exchanger::update() and then computeForces(), except for the
+      * order in which pair forces are summed.
+      *
+      * Overlap is only implemented for the pair list algorithm without
+      * threads. Otherwise, the update is completed before computing 
+      * all forces.
+      *
+      * \param exchanger Exchanger with a nonblocking update in progress
+      */
+      virtual void computeForcesOverlap(Exchanger& exchanger) = 0;
+
       //@}
       /// \name Pair and Cell Lists.
       //@{
@@ -213,6 +236,9 @@ namespace DdMd
       /**
       * Build the Verlet Pair list.
       *
+      * Also copies the types and ghost flags of all atoms in the pair 
+      * list to the packed arrays used by the pair force loops.
+      *
       * Preconditions:
       *  - Cell List must have been built, by PairPotential::buildCellList.
       *  - Atomic positions must be expressed in Cartesian coordinates.
@@ -295,6 +321,29 @@ namespace DdMd
       */
       int methodId() const;
 
+      /// \name Threads
+      //@{
+
+      /**
+      * Get number of threads used to compute pair forces.
+      *
+      * If UTIL_OPENMP is defined, this is the maximum number of OpenMP
+      * threads when the object was constructed, which may be set by 
+      * the OMP_NUM_THREADS environment variable. Otherwise, it is 1.
+      */
+      int nThread() const;
+
+      /**
+      * Get timer for time spent by each thread in pair force loops.
+      *
+      * Interval i of this timer contains the time spent by thread i
+      * in multi-threaded pair force calculations. Times are accumulated
+      * only if nThread() > 1.
+      */
+      DdTimer& threadTimer();
+
+      //@}
+
    protected:
 
       /// CellList to construct PairList or calculate nonbonded pair forces.
@@ -338,6 +387,66 @@ namespace DdMd
       */
       void setPairEnergies(DMatrix<double> pairEnergies);
 
+      /// Packed x, y and z coordinates of PairList atoms (three blocks).
+      DArray<double> packedPositions_;
+
+      /// Packed atom type ids of PairList atoms, set by buildPairList().
+      DArray<int> packedTypeIds_;
+
+      /// Packed ghost flags of PairList atoms, set by buildPairList().
+      DArray<int> packedGhostFlags_;
+
+      /// Number of elements in each block of a packed array.
+      int packCapacity_;
+
+      /**
+      * Copy positions of PairList atoms to packed arrays.
+      *
+      * Elements of the packed arrays are indexed by the index of each
+      * atom in the atom table of the PairList (see PairList::atomPtr), 
+      * which is also its index in the CellList (see CellList::atom).
+      * Types and ghost flags do not change between pair list builds,
+      * and are packed once by buildPairList().
+      */
+      void packPositions();
+
+      /**
+      * Copy positions of ghost atoms in the PairList to packed arrays.
+      */
+      void packGhostPositions();
+
+      /**
+      * Get packed force increments for one thread.
+      *
+      * Returns a pointer to three consecutive blocks of packCapacity_
+      * elements, which contain x, y and z force components, indexed by 
+      * CellList atom index (equal to the PairList atom table index). All
+      * elements are zero on entry to any pair force calculation, and are 
+      * reset to zero by unpackForces().
+      *
+      * \param threadId  thread index (0 <= threadId < nThread())
+      */
+      double* packedForces(int threadId);
+
+      /**
+      * Add packed force increments from all threads to atomic forces.
+      *
+      * On return, all packed force increments are zero.
+      */
+      void unpackForces();
+
+      #ifdef UTIL_OPENMP
+      /**
+      * Pointers to local cells, for division of cells among threads.
+      */
+      GArray<const Cell*> cellPtrs_;
+
+      /**
+      * Fill cellPtrs_ with pointers to all local cells.
+      */
+      void makeCellPtrs();
+      #endif
+
    private:
 
       /// Pointer to associated Domain object.
@@ -358,6 +467,15 @@ namespace DdMd
       /// Pair energies.
       Setable< DMatrix<double> > pairEnergies_;
 
+      /// Number of threads used for pair force calculations.
+      int nThread_;
+
+      /// Accumulated time spent in pair force loops by each thread.
+      DdTimer threadTimer_;
+
+      /// Packed force increments, nThread_ consecutive sets of 3 blocks.
+      DArray<double> packedForces_;
+
       /// Private methods used to compute number of pairs
       int nPairList(double cutoffSq);
       int nPairCell(double cutoffSq);
@@ -368,6 +486,11 @@ namespace DdMd
       */
       void allocate();
 
+      /**
+      * Return number of threads available when constructed.
+      */
+      static int maxNThread();
+
    };
 
    inline CellList& PairPotential::cellList()
@@ -397,5 +520,14 @@ namespace DdMd
    inline int PairPotential::methodId() const
    {  return methodId_; }
 
+   inline int PairPotential::nThread() const
+   {  return nThread_; }
+
+   inline DdTimer& PairPotential::threadTimer()
+   {  return threadTimer_; }
+
+   inline double* PairPotential::packedForces(int threadId)
+   {  return &packedForces_[3*threadId*packCapacity_]; }
+
 }
 #endif
@@ -14,7 +14,11 @@
 
 #include <algorithm>
 
-#define PAIR_BLOCK_SIZE 16
+/*
+* Maximum number of neighbors of one primary atom that are processed 
+* together in the PairList force loops (see PairPotentialImpl::PairBlock).
+*/
+#define PAIR_BLOCK_SIZE 64
 
 namespace DdMd
 {
@@ -192,6 +196,13 @@ namespace DdMd
       */
       virtual void computeForces();
 
+      /**
+      * Compute pair forces while completing a ghost position update.
+      *
+      * \param exchanger Exchanger with a nonblocking update in progress
+      */
+      virtual void computeForcesOverlap(Exchanger& exchanger);
+
       /**
       * Compute the total nonBonded pair energy for all processors
       * 
@@ -241,11 +252,27 @@ namespace DdMd
 
    private:
 
-      struct PairForce {
-         Vector f;
-         double rsq;
-         Atom*  ptr0;
-         Atom*  ptr1;
+      /*
+      * Selection of pairs, by whether the secondary atom is a ghost.
+      */
+      enum PairSelect {ALL_PAIRS, LOCAL_PAIRS, GHOST_PAIRS};
+
+      /*
+      * Buffer for a block of neighbors of one primary atom.
+      *
+      * Each array element describes one pair. Separation components, 
+      * squared distances, types and forces are stored in separate
+      * contiguous arrays, so that loops over a block can be vectorized
+      * by the compiler.
+      */
+      struct PairBlock {
+         double dx[PAIR_BLOCK_SIZE];
+         double dy[PAIR_BLOCK_SIZE];
+         double dz[PAIR_BLOCK_SIZE];
+         double rsq[PAIR_BLOCK_SIZE];
+         double forceOverR[PAIR_BLOCK_SIZE];
+         int    type1[PAIR_BLOCK_SIZE];
+         int    inIds[PAIR_BLOCK_SIZE];
       };
 
       /**
@@ -260,11 +287,6 @@ namespace DdMd
       */
       int nAtomType_;
 
-      #ifdef PAIR_BLOCK_SIZE
-      PairForce pairs_[PAIR_BLOCK_SIZE];
-      PairForce* inPairs_[PAIR_BLOCK_SIZE];
-      #endif
-
       /**
       * Initialized to false, set true in readParameters or loadParameters.
       */ 
@@ -280,6 +302,27 @@ namespace DdMd
       */
       void computeForcesList();
 
+      /**
+      * Compute pair forces for a range of primary atoms, from packed arrays.
+      *
+      * Adds forces for all pairs with primary atoms begin <= i < end in 
+      * the PairList to the packed force increments forces, using packed 
+      * positions set by packPositions() and types set by buildPairList(). If select is LOCAL_PAIRS 
+      * or GHOST_PAIRS, only pairs in which the secondary atom is
+      * respectively a local or a ghost atom are included. If stressPtr is
+      * not null, the pair stress (not normalized by volume) is also added
+      * to *stressPtr.
+      *
+      * \param begin     index of first primary atom
+      * \param end       one past the index of the last primary atom
+      * \param forces    packed force increments (see packedForces())
+      * \param stressPtr pointer to stress tensor, or null
+      * \param select    selection of pairs to include
+      */
+      void computeForcesPacked(int begin, int end, double* forces, 
+                               Tensor* stressPtr, 
+                               PairSelect select = ALL_PAIRS);
+
       /**
       * Compute atomic pair forces and/or pair potential energy.
       */
@@ -290,6 +333,29 @@ namespace DdMd
       */
       void computeForcesCell();
 
+      #ifdef UTIL_OPENMP
+      /**
+      * Compute atomic pair forces using PairList, with multiple threads.
+      *
+      * The PairList is divided into nThread() blocks of consecutive 
+      * pairs, one per thread. Each thread accumulates forces in its own
+      * packed force increments, which are then added to atomic forces.
+      * If stressPtr is not null, the pair stress (not normalized by
+      * volume) is also added to *stressPtr.
+      *
+      * \param stressPtr pointer to stress tensor, or null
+      */
+      void computeForcesListThreads(Tensor* stressPtr);
+
+      /**
+      * Compute atomic pair forces using CellList, with multiple threads.
+      *
+      * Local cells are distributed among threads, each of which uses
+      * its own array of force increments.
+      */
+      void computeForcesCellThreads();
+      #endif
+
       /**
       * Compute atomic pair energy, using N^2 loop.
       * 
@@ -312,6 +378,7 @@ namespace DdMd
 #include <ddMd/storage/GhostIterator.h>
 #include <ddMd/neighbor/PairIterator.h>
 #include <ddMd/communicate/Domain.h>
+#include <ddMd/communicate/Exchanger.h>
 
 #include <util/space/Dimension.h>
 #include <util/space/Vector.h>
@@ -320,6 +387,10 @@ namespace DdMd
 
 #include <fstream>
 
+#ifdef UTIL_OPENMP
+#include <omp.h>
+#endif
+
 namespace DdMd
 {
 
@@ -468,6 +539,42 @@ namespace DdMd
        }
    }
 
+   /*
+   * Compute pair forces while completing a ghost position update.
+   */
+   template <class Interaction>
+   void PairPotentialImpl<Interaction>::computeForcesOverlap(Exchanger& exchanger)
+   {
+      if (methodId() != 0 || nThread() > 1) {
+         exchanger.endUpdate();
+         computeForces();
+         return;
+      }
+
+      // Number of primary atoms processed between tests for completion
+      const int nTestAtom = 16;
+      double* forces = packedForces(0);
+      int nAtom = pairList_.nAtom();
+      int begin, end;
+      bool isComplete = false;
+
+      // Pairs of local atoms, while ghost positions are in transit
+      packPositions();
+      for (begin = 0; begin < nAtom; begin += nTestAtom) {
+         end = std::min(begin + nTestAtom, nAtom);
+         computeForcesPacked(begin, end, forces, 0, LOCAL_PAIRS);
+         if (!isComplete) {
+            isComplete = exchanger.testUpdate();
+         }
+      }
+      exchanger.endUpdate();
+
+      // Pairs that involve a ghost atom
+      packGhostPositions();
+      computeForcesPacked(0, nAtom, forces, 0, GHOST_PAIRS);
+      unpackForces();
+   }
+
    /*
    * Compute total pair energy on all processors.
    */
@@ -543,116 +650,151 @@ namespace DdMd
    template <class Interaction>
    void PairPotentialImpl<Interaction>::computeForcesList()
    {
-      double rsq;
-      PairIterator iter;
-      Atom*  atom0Ptr;
-      Atom*  atom1Ptr;
-      int    type0, type1;
-
-      if (reverseUpdateFlag()) {
+      #ifdef UTIL_OPENMP
+      if (nThread() > 1) {
+         computeForcesListThreads(0);
+         return;
+      }
+      #endif
 
-         Vector f;
-         for (pairList_.begin(iter); iter.notEnd(); ++iter) {
-            iter.getPair(atom0Ptr, atom1Ptr);
-            f.subtract(atom0Ptr->position(), atom1Ptr->position());
-            rsq = f.square();
-            type0 = atom0Ptr->typeId();
-            type1 = atom1Ptr->typeId();
-            if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
-               f *= interactionPtr_->forceOverR(rsq, type0, type1);
-               atom0Ptr->force() += f;
-               atom1Ptr->force() -= f;
-            }
-         }
+      packPositions();
+      computeForcesPacked(0, pairList_.nAtom(), packedForces(0), 0);
+      unpackForces();
+   }
 
-      } else {
+   /*
+   * Compute pair forces for a range of primary atoms (private).
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::computeForcesPacked(int begin, int end,
+                                                       double* forces,
+                                                       Tensor* stressPtr,
+                                                       PairSelect select)
+   {
+      const Interaction& interaction = *interactionPtr_;
+      const bool reverse = reverseUpdateFlag();
+      const int  selectGhost = (select == GHOST_PAIRS);
+      const double* xs = &packedPositions_[0];
+      const double* ys = xs + packCapacity_;
+      const double* zs = ys + packCapacity_;
+      const int* typeIds = &packedTypeIds_[0];
+      const int* ghostFlags = &packedGhostFlags_[0];
+      double* fxs = forces;
+      double* fys = fxs + packCapacity_;
+      double* fzs = fys + packCapacity_;
+      const int* ids;
+      PairBlock block;
+      Tensor stress;
+      Vector dr, f;
+      double x0, y0, z0, fx0, fy0, fz0, fx, fy, fz;
+      int i, j, k, m, n, id0, id1, type0, nNeighbor, jBegin;
+
+      if (stressPtr) {
+         stress.zero();
+      }
 
-         #ifdef PAIR_BLOCK_SIZE
-         PairForce* pairPtr;
-         Vector*    forcePtr;
-         int i, j, m, n;
-
-         pairList_.begin(iter);
-         j = pairList_.nPair();  // j = # of remaining unprocessed pairs
-         while (j) {
-
-            // Determine n = number of pairs in this block
-            n = std::min(PAIR_BLOCK_SIZE, j);
-
-            // Compute separation for each pair in block
-            for (i = 0; i < n; ++i) {
-               pairPtr = &pairs_[i];
-               iter.getPair(atom0Ptr, atom1Ptr);
-               forcePtr = &(pairPtr->f);
-               forcePtr->subtract(atom0Ptr->position(), atom1Ptr->position());
-               pairPtr->ptr0 = atom0Ptr;
-               pairPtr->ptr1 = atom1Ptr;
-               pairPtr->rsq  = forcePtr->square();
-               ++iter;
+      // Loop over primary atoms
+      for (i = begin; i < end; ++i) {
+         id0 = pairList_.atom1Id(i);
+         x0 = xs[id0];
+         y0 = ys[id0];
+         z0 = zs[id0];
+         type0 = typeIds[id0];
+         fx0 = 0.0;
+         fy0 = 0.0;
+         fz0 = 0.0;
+         nNeighbor = pairList_.nNeighbor(i);
+
+         // Loop over blocks of up to PAIR_BLOCK_SIZE neighbors
+         for (jBegin = 0; jBegin < nNeighbor; jBegin += PAIR_BLOCK_SIZE) {
+            ids = pairList_.atom2Ids(i) + jBegin;
+            n = std::min(PAIR_BLOCK_SIZE, nNeighbor - jBegin);
+
+            // Gather separations and types from packed arrays
+            for (j = 0; j < n; ++j) {
+               id1 = ids[j];
+               block.dx[j] = x0 - xs[id1];
+               block.dy[j] = y0 - ys[id1];
+               block.dz[j] = z0 - zs[id1];
+               block.rsq[j] = block.dx[j]*block.dx[j] 
+                            + block.dy[j]*block.dy[j]
+                            + block.dz[j]*block.dz[j];
+               block.type1[j] = typeIds[id1];
             }
 
-            // Identify pairs in this block with rsq < cutoff
-            // Determine m = number of pairs with rsq < cutoff
-            m = 0; 
-            for (i = 0; i < n; ++i) {
-               pairPtr = &pairs_[i];
-               atom0Ptr = pairPtr->ptr0;
-               atom1Ptr = pairPtr->ptr1; 
-               type0 = atom0Ptr->typeId();
-               type1 = atom1Ptr->typeId();
-               inPairs_[m] = pairPtr;
-               if (pairPtr->rsq < interactionPtr_->cutoffSq(type0, type1)) {
-                  ++m;
+            // Identify selected pairs with rsq < cutoff, without branching
+            m = 0;
+            if (select == ALL_PAIRS) {
+               for (j = 0; j < n; ++j) {
+                  block.inIds[m] = j;
+                  m += (block.rsq[j] 
+                        < interaction.cutoffSq(type0, block.type1[j]));
                }
-            }
-              
-            // Compute and increment forces for pairs with rsq < cutoff 
-            for (i = 0; i < m; ++i) {
-               pairPtr =  inPairs_[i];
-               atom0Ptr = pairPtr->ptr0;
-               atom1Ptr = pairPtr->ptr1; 
-               forcePtr = &(pairPtr->f);
-               type0 = atom0Ptr->typeId();
-               type1 = atom1Ptr->typeId();
-               rsq   = pairPtr->rsq;
-               *forcePtr *= interactionPtr_->forceOverR(rsq, type0, type1);
-               atom0Ptr->force() += *forcePtr;
-               if (!atom1Ptr->isGhost()) {
-                  atom1Ptr->force() -= *forcePtr;
+            } else {
+               for (j = 0; j < n; ++j) {
+                  block.inIds[m] = j;
+                  m += (block.rsq[j] 
+                        < interaction.cutoffSq(type0, block.type1[j]))
+                       & (ghostFlags[ids[j]] == selectGhost);
                }
             }
 
-            // Decrement number of remaining unprocess pairs
-            j = j - n; 
-         }
-
-         #ifdef UTIL_DEBUG
-         if (j != 0) {
-            UTIL_THROW("Error in counting");
-         }
-         if (iter.notEnd()) {
-            UTIL_THROW("Error in iterator");
-         }
-         #endif // ifdef UTIL_DEBUG
+            // Compute forceOverR for selected pairs (inIds[k] >= k)
+            for (k = 0; k < m; ++k) {
+               j = block.inIds[k];
+               block.rsq[k] = block.rsq[j];
+               block.type1[k] = block.type1[j];
+            }
+            for (k = 0; k < m; ++k) {
+               block.forceOverR[k] = 
+                  interaction.forceOverR(block.rsq[k], type0, block.type1[k]);
+            }
 
-         #else  // ifdef PAIR_BLOCK_SIZE
-         Vector f;
-         for (pairList_.begin(iter); iter.notEnd(); ++iter) {
-            iter.getPair(atom0Ptr, atom1Ptr);
-            f.subtract(atom0Ptr->position(), atom1Ptr->position());
-            rsq = f.square();
-            type0 = atom0Ptr->typeId();
-            type1 = atom1Ptr->typeId();
-            if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
-               f *= interactionPtr_->forceOverR(rsq, type0, type1);
-               atom0Ptr->force() += f;
-               if (!atom1Ptr->isGhost()) {
-                  atom1Ptr->force() -= f;
+            // Increment packed forces
+            for (k = 0; k < m; ++k) {
+               j = block.inIds[k];
+               id1 = ids[j];
+               fx = block.dx[j]*block.forceOverR[k];
+               fy = block.dy[j]*block.forceOverR[k];
+               fz = block.dz[j]*block.forceOverR[k];
+               fx0 += fx;
+               fy0 += fy;
+               fz0 += fz;
+               if (reverse || !ghostFlags[id1]) {
+                  fxs[id1] -= fx;
+                  fys[id1] -= fy;
+                  fzs[id1] -= fz;
+                  if (stressPtr) {
+                     dr[0] = block.dx[j];
+                     dr[1] = block.dy[j];
+                     dr[2] = block.dz[j];
+                     f[0] = fx;
+                     f[1] = fy;
+                     f[2] = fz;
+                     incrementPairStress(f, dr, stress);
+                  }
+               } else 
+               if (stressPtr) {
+                  // Atom 1 is a ghost: count half of the pair stress
+                  dr[0] = block.dx[j];
+                  dr[1] = block.dy[j];
+                  dr[2] = block.dz[j];
+                  f[0] = 0.5*fx;
+                  f[1] = 0.5*fy;
+                  f[2] = 0.5*fz;
+                  incrementPairStress(f, dr, stress);
                }
             }
          }
-         #endif // ifdef PAIR_BLOCK_SIZE
 
+         fxs[id0] += fx0;
+         fys[id0] += fy0;
+         fzs[id0] += fz0;
+      }
+
+      if (stressPtr) {
+         *stressPtr += stress;
       }
    }
 
@@ -727,6 +869,13 @@ namespace DdMd
    template <class Interaction>
    void PairPotentialImpl<Interaction>::computeForcesCell()
    {
+      #ifdef UTIL_OPENMP
+      if (nThread() > 1) {
+         computeForcesCellThreads();
+         return;
+      }
+      #endif
+
       // Find all neighbors (cell list)
       Cell::NeighborArray neighbors;
       Vector f;
@@ -794,6 +943,122 @@ namespace DdMd
       } // while (cellPtr) 
    }
 
+   #ifdef UTIL_OPENMP
+   /*
+   * Increment atomic forces using PairList and threads (private).
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::computeForcesListThreads(Tensor* stressPtr)
+   {
+      packPositions();
+
+      #pragma omp parallel num_threads(nThread())
+      {
+         double start = omp_get_wtime();
+         int threadId = omp_get_thread_num();
+         Tensor stress;
+         int begin, end;
+
+         stress.zero();
+         pairList_.getBlock(threadId, omp_get_num_threads(), begin, end);
+         computeForcesPacked(begin, end, packedForces(threadId), 
+                             stressPtr ? &stress : 0);
+
+         if (stressPtr) {
+            #pragma omp critical
+            *stressPtr += stress;
+         }
+         threadTimer().add(threadId, omp_get_wtime() - start);
+      }
+
+      unpackForces();
+   }
+
+   /*
+   * Increment atomic forces using CellList and threads (private).
+   */
+   template <class Interaction>
+   void PairPotentialImpl<Interaction>::computeForcesCellThreads()
+   {
+      const bool reverse = reverseUpdateFlag();
+      makeCellPtrs();
+      const int nCell = cellPtrs_.size();
+
+      #pragma omp parallel num_threads(nThread())
+      {
+         double begin = omp_get_wtime();
+         int threadId = omp_get_thread_num();
+         double* fxs = packedForces(threadId);
+         double* fys = fxs + packCapacity_;
+         double* fzs = fys + packCapacity_;
+         Cell::NeighborArray neighbors;
+         Vector f;
+         double rsq;
+         Atom*  atomPtr0;
+         Atom*  atomPtr1;
+         int    id0, id1, type0, type1, na, nn, i, j, k;
+
+         #pragma omp for schedule(dynamic) nowait
+         for (k = 0; k < nCell; ++k) {
+            cellPtrs_[k]->getNeighbors(neighbors);
+            na = cellPtrs_[k]->nAtom();
+            nn = neighbors.size();
+            for (i = 0; i < na; ++i) {
+               atomPtr0 = neighbors[i]->ptr();
+               id0 = cellList_.atomIndex(*neighbors[i]);
+               type0 = atomPtr0->typeId();
+
+               // Loop over atoms in this cell
+               for (j = 0; j < na; ++j) {
+                  atomPtr1 = neighbors[j]->ptr();
+                  type1 = atomPtr1->typeId();
+                  if (atomPtr1 > atomPtr0) {
+                     f.subtract(atomPtr0->position(), atomPtr1->position());
+                     rsq = f.square();
+                     if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
+                        f *= interactionPtr_->forceOverR(rsq, type0, type1);
+                        id1 = cellList_.atomIndex(*neighbors[j]);
+                        fxs[id0] += f[0];
+                        fys[id0] += f[1];
+                        fzs[id0] += f[2];
+                        fxs[id1] -= f[0];
+                        fys[id1] -= f[1];
+                        fzs[id1] -= f[2];
+                     }
+                  }
+               }
+
+               // Loop over atoms in neighboring cells.
+               for (j = na; j < nn; ++j) {
+                  atomPtr1 = neighbors[j]->ptr();
+                  type1 = atomPtr1->typeId();
+                  f.subtract(atomPtr0->position(), atomPtr1->position());
+                  rsq = f.square();
+                  if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
+                     f *= interactionPtr_->forceOverR(rsq, type0, type1);
+                     fxs[id0] += f[0];
+                     fys[id0] += f[1];
+                     fzs[id0] += f[2];
+                     if (reverse || !atomPtr1->isGhost()) {
+                        id1 = cellList_.atomIndex(*neighbors[j]);
+                        fxs[id1] -= f[0];
+                        fys[id1] -= f[1];
+                        fzs[id1] -= f[2];
+                     }
+                  }
+               }
+
+            }
+         }
+
+         threadTimer().add(threadId, omp_get_wtime() - begin);
+      }
+
+      unpackForces();
+   }
+   #endif
+
    /*
    * Increment atomic forces and/or pair energy (private).
    */
@@ -1025,56 +1290,20 @@ namespace DdMd
       }
  
       Tensor localStress;
-      Vector dr;
-      Vector f;
-      double rsq;
-      PairIterator iter;
-      Atom*  atom0Ptr;
-      Atom*  atom1Ptr;
-      int    type0, type1;
 
       localStress.zero();
-      if (reverseUpdateFlag()) {
-
-         for (pairList_.begin(iter); iter.notEnd(); ++iter) {
-            iter.getPair(atom0Ptr, atom1Ptr);
-            dr.subtract(atom0Ptr->position(), atom1Ptr->position());
-            rsq = dr.square();
-            type0 = atom0Ptr->typeId();
-            type1 = atom1Ptr->typeId();
-            if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
-               f = dr;
-               f *= interactionPtr_->forceOverR(rsq, type0, type1);
-               assert(!atom0Ptr->isGhost());
-               atom0Ptr->force() += f;
-               atom1Ptr->force() -= f;
-               incrementPairStress(f, dr, localStress);
-            }
-         }
-
-      } else {
-
-         for (pairList_.begin(iter); iter.notEnd(); ++iter) {
-            iter.getPair(atom0Ptr, atom1Ptr);
-            dr.subtract(atom0Ptr->position(), atom1Ptr->position());
-            rsq = dr.square();
-            type0 = atom0Ptr->typeId();
-            type1 = atom1Ptr->typeId();
-            if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
-               f  = dr;
-               f *= interactionPtr_->forceOverR(rsq, type0, type1);
-               assert(!atom0Ptr->isGhost());
-               atom0Ptr->force() += f;
-               if (!atom1Ptr->isGhost()) {
-                  atom1Ptr->force() -= f;
-               } else { // if atom 1 is a ghost
-                  f *= 0.5;
-               }
-               incrementPairStress(f, dr, localStress);
-            }
-         }
-
+      #ifdef UTIL_OPENMP
+      if (nThread() > 1) {
+         computeForcesListThreads(&localStress);
+         localStress /= boundary().volume();
+         reduceStress(localStress, communicator);
+         return;
       }
+      #endif
+      packPositions();
+      computeForcesPacked(0, pairList_.nAtom(), packedForces(0), 
+                          &localStress);
+      unpackForces();
 
       // Normalize by volume 
       localStress /= boundary().volume();
@@ -24,6 +24,11 @@ include $(SRC_DIR)/ddMd/potentials/external/sources.mk
 ddMd_potentials_+=$(ddMd_potentials_external_)
 endif
 
+ifdef INTER_COULOMB
+include $(SRC_DIR)/ddMd/potentials/coulomb/sources.mk
+ddMd_potentials_+=$(ddMd_potentials_coulomb_)
+endif
+
 ddMd_potentials_SRCS=\
      $(addprefix $(SRC_DIR)/, $(ddMd_potentials_))
 ddMd_potentials_OBJS=\
@@ -15,6 +15,7 @@
 #include <ddMd/configIos/ConfigIoFactory.h>
 #include <ddMd/configIos/DdMdConfigIo.h>
 #include <ddMd/configIos/SerializeConfigIo.h>
+#include <ddMd/configIos/ShardConfigIo.h>
 #include <ddMd/analyzers/AnalyzerManager.h>
 #ifdef DDMD_MODIFIERS
 #include <ddMd/modifiers/ModifierManager.h>
@@ -41,6 +42,10 @@
 #include <ddMd/potentials/external/ExternalPotentialImpl.h>
 #include <ddMd/potentials/external/ExternalFactory.h>
 #endif
+#ifdef INTER_COULOMB
+#include <ddMd/potentials/coulomb/CoulombPotential.h>
+#include <ddMd/potentials/coulomb/CoulombFactory.h>
+#endif
 
 // namespace Util
 #include <util/misc/FileMaster.h>
@@ -65,6 +70,7 @@
 #include <fstream>
 #include <unistd.h>
 #include <stdlib.h>
+#include <stdio.h>
 
 namespace DdMd
 {
@@ -94,6 +100,7 @@ namespace DdMd
       domain_(),
       buffer_(),
       exchanger_(),
+      loadBalancer_(),
       random_(),
       maxBoundary_(),
       kineticEnergy_(0.0),
@@ -110,12 +117,17 @@ namespace DdMd
       #ifdef INTER_EXTERNAL
       externalPotentialPtr_(0),
       #endif
+      #ifdef INTER_COULOMB
+      coulombPotentialPtr_(0),
+      #endif
       integratorPtr_(0),
       energyEnsemblePtr_(0),
       boundaryEnsemblePtr_(0),
       fileMasterPtr_(0),
       configIoPtr_(0),
       serializeConfigIoPtr_(0),
+      shardConfigIoPtr_(0),
+      restartFileName_(),
       #ifdef DDMD_MODIFIERS
       modifierManagerPtr_(0),
       #endif
@@ -135,6 +147,9 @@ namespace DdMd
       #ifdef INTER_EXTERNAL
       externalFactoryPtr_(0),
       #endif
+      #ifdef INTER_COULOMB
+      coulombFactoryPtr_(0),
+      #endif
       integratorFactoryPtr_(0),
       configIoFactoryPtr_(0),
       #ifndef DDMD_NOPAIR
@@ -152,6 +167,9 @@ namespace DdMd
       #ifdef INTER_EXTERNAL
       externalStyle_(),
       #endif
+      #ifdef INTER_COULOMB
+      coulombStyle_(),
+      #endif
       nAtomType_(0),
       #ifdef INTER_BOND
       nBondType_(0),
@@ -165,6 +183,9 @@ namespace DdMd
       #ifdef INTER_EXTERNAL
       hasExternal_(false),
       #endif
+      #ifdef INTER_COULOMB
+      hasCoulomb_(false),
+      #endif
       hasAtomContext_(false),
       maskedPairPolicy_(MaskBonded),
       reverseUpdateFlag_(false),
@@ -194,6 +215,7 @@ namespace DdMd
       // Set connections between member objects
       domain_.setBoundary(boundary_);
       exchanger_.associate(domain_, boundary_, atomStorage_, buffer_);
+      loadBalancer_.associate(domain_, boundary_, atomStorage_);
       atomStorage_.associate(domain_, boundary_, buffer_);
       #ifdef INTER_BOND
       bondStorage_.associate(domain_, atomStorage_, buffer_);
@@ -257,6 +279,14 @@ namespace DdMd
          delete externalPotentialPtr_;
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (coulombFactoryPtr_) {
+         delete coulombFactoryPtr_;
+      }
+      if (coulombPotentialPtr_) {
+         delete coulombPotentialPtr_;
+      }
+      #endif
       if (configIoFactoryPtr_) {
          delete configIoFactoryPtr_;
       }
@@ -266,6 +296,9 @@ namespace DdMd
       if (serializeConfigIoPtr_) {
          delete serializeConfigIoPtr_;
       }
+      if (shardConfigIoPtr_) {
+         delete shardConfigIoPtr_;
+      }
       if (integratorFactoryPtr_) {
          delete integratorFactoryPtr_;
       }
@@ -309,18 +342,20 @@ namespace DdMd
       bool cFlag = false; // command file name
       bool iFlag = false; // input prefix
       bool oFlag = false; // output prefix
+      bool gFlag = false; // restart grid dimensions
       char* sArg = 0;
       char* rArg = 0;
       char* pArg = 0;
       char* cArg = 0;
       char* iArg = 0;
       char* oArg = 0;
+      char* gArg = 0;
       int  nSystem = 1;
 
       // Read command-line arguments
       int c;
       opterr = 0;
-      while ((c = getopt(argc, argv, "es:p:r:c:i:o:")) != -1) {
+      while ((c = getopt(argc, argv, "es:p:r:c:i:o:g:")) != -1) {
          switch (c) {
          case 'e': // echo parameters
             eFlag = true;
@@ -350,6 +385,10 @@ namespace DdMd
             oFlag = true;
             oArg  = optarg;
             break;
+         case 'g': // restart grid dimensions
+            gFlag = true;
+            gArg  = optarg;
+            break;
          case '?':
             Log::file() << "Unknown option -" << optopt << std::endl;
          }
@@ -411,6 +450,19 @@ namespace DdMd
       }
 
 
+      // If option -g, override grid dimensions stored in restart file
+      if (gFlag) {
+         if (!rFlag) {
+            UTIL_THROW("Option -g requires a restart file (option -r)");
+         }
+         IntVector dimensions;
+         if (sscanf(gArg, "%d,%d,%d", &dimensions[0], &dimensions[1], 
+                    &dimensions[2]) != Dimension) {
+            UTIL_THROW("Option -g requires an argument nx,ny,nz");
+         }
+         domain_.setRestartGridDimensions(dimensions);
+      }
+
       // If option -r, load state from a restart file.
       if (rFlag) {
          if (isIoProcessor()) {
@@ -497,6 +549,11 @@ namespace DdMd
       hasExternal_ = false;
       readOptional<bool>(in, "hasExternal", hasExternal_); 
       #endif
+      #ifdef INTER_COULOMB
+      hasCoulomb_ = false;
+      readOptional<bool>(in, "hasCoulomb", hasCoulomb_); 
+      AtomType::setHasCharge(hasCoulomb_);
+      #endif
 
       hasAtomContext_ = false;
       readOptional<bool>(in, "hasAtomContext", hasAtomContext_); 
@@ -532,6 +589,18 @@ namespace DdMd
 
       // Create and read potential energy classes
 
+      #ifdef INTER_COULOMB
+      // Coulomb potential (must precede the pair potential)
+      if (hasCoulomb_) {
+         assert(coulombPotentialPtr_ == 0);
+         coulombPotentialPtr_ = coulombFactory().factory(coulombStyle());
+         if (!coulombPotentialPtr_) {
+            UTIL_THROW("Unknown coulombStyle");
+         }
+         readParamComposite(in, *coulombPotentialPtr_);
+      }
+      #endif
+
       #ifndef DDMD_NOPAIR
       // Pair Potential
       assert(pairPotentialPtr_ == 0);
@@ -604,6 +673,7 @@ namespace DdMd
          msg += className;
          UTIL_THROW("msg.c_str()");
       }
+      readParamCompositeOptional(in, loadBalancer_);
       #ifdef DDMD_MODIFIERS
       readParamCompositeOptional(in, *modifierManagerPtr_);
       #endif
@@ -614,6 +684,7 @@ namespace DdMd
 
       exchanger_.setPairCutoff(pairPotential().cutoff());
       exchanger_.allocate();
+      loadBalancer_.setPairCutoff(pairPotential().cutoff());
 
       // Set signal observers (i.e., call-back functions for Signal::notify)
       modifySignal().addObserver(*this, &Simulation::unsetKineticEnergy);
@@ -691,6 +762,11 @@ namespace DdMd
       hasExternal_ = false;
       loadParameter<bool>(ar, "hasExternal", hasExternal_, false); // opt
       #endif
+      #ifdef INTER_COULOMB
+      hasCoulomb_ = false;
+      loadParameter<bool>(ar, "hasCoulomb", hasCoulomb_, false); // opt
+      AtomType::setHasCharge(hasCoulomb_);
+      #endif
 
       hasAtomContext_ = false;
       loadParameter<bool>(ar, "hasAtomContext", hasAtomContext_, false); // opt
@@ -724,6 +800,18 @@ namespace DdMd
       // Load potentials styles and parameters
       loadPotentialStyles(ar);
 
+      #ifdef INTER_COULOMB
+      // Coulomb potential (must precede the pair potential)
+      assert(coulombPotentialPtr_ == 0);
+      if (hasCoulomb_) {
+         coulombPotentialPtr_ = coulombFactory().factory(coulombStyle());
+         if (!coulombPotentialPtr_) {
+            UTIL_THROW("Unknown coulombStyle");
+         }
+         loadParamComposite(ar, *coulombPotentialPtr_);
+      }
+      #endif
+
       #ifndef DDMD_NOPAIR
       // Pair Potential
       assert(pairPotentialPtr_ == 0);
@@ -795,6 +883,7 @@ namespace DdMd
          msg += className;
          UTIL_THROW("msg.c_str()");
       }
+      loadParamCompositeOptional(ar, loadBalancer_);
       #ifdef DDMD_MODIFIERS
       loadParamCompositeOptional(ar, *modifierManagerPtr_);
       #endif
@@ -805,6 +894,7 @@ namespace DdMd
 
       exchanger_.setPairCutoff(pairPotential().cutoff());
       exchanger_.allocate();
+      loadBalancer_.setPairCutoff(pairPotential().cutoff());
 
       // Set signal observers (i.e., call-back functions for Signal::notify)
       modifySignal().addObserver(*this, &Simulation::unsetKineticEnergy);
@@ -839,7 +929,12 @@ namespace DdMd
       isInitialized_ = true;
 
       // Load the configuration (boundary + positions + groups)
-      serializeConfigIo().loadConfig(ar, maskedPairPolicy_);
+      if (integrator().saveShards()) {
+         shardConfigIo().loadConfig(ar, fileMaster(), restartFileName_, 
+                                    random_, maskedPairPolicy_);
+      } else {
+         serializeConfigIo().loadConfig(ar, maskedPairPolicy_);
+      }
 
       // There are no ghosts yet, so exchange.
       exchanger_.exchange();
@@ -865,6 +960,7 @@ namespace DdMd
          std::ios_base::openmode mode = std::ios_base::in | std::ios_base::binary;
          fileMaster().openRestartIFile(filename, ar.file(), mode);
       }
+      restartFileName_ = filename;
       // ParamComposite::load() calls Simulation::loadParameters()
       load(ar);
       if (isIoProcessor()) {
@@ -897,6 +993,9 @@ namespace DdMd
       #ifdef INTER_EXTERNAL
       Parameter::saveOptional(ar, hasExternal_, hasExternal_);
       #endif
+      #ifdef INTER_COULOMB
+      Parameter::saveOptional(ar, hasCoulomb_, hasCoulomb_);
+      #endif
       Parameter::saveOptional(ar, hasAtomContext_, hasAtomContext_);
       ar << atomTypes_;
 
@@ -922,6 +1021,11 @@ namespace DdMd
 
       // Potential energy styles and potential classes
       savePotentialStyles(ar);
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().save(ar);
+      }
+      #endif
       #ifndef DDMD_NOPAIR
       pairPotential().save(ar);
       #endif
@@ -946,11 +1050,12 @@ namespace DdMd
       }
       #endif
 
-      // Save ensembles, integrator, modifiers, random, analyzers
+      // Save ensembles, integrator, load balancer, modifiers, random, analyzers
       saveEnsembles(ar);
       std::string name = integrator().className();
       ar << name;
       integrator().save(ar);
+      loadBalancer_.saveOptional(ar);
       #ifdef DDMD_MODIFIERS
       modifierManager().saveOptional(ar);
       #endif
@@ -994,7 +1099,11 @@ namespace DdMd
       }
 
       // Save configuration (call on all processors)
-      serializeConfigIo().saveConfig(ar);
+      if (integratorPtr_ && integrator().saveShards()) {
+         shardConfigIo().saveConfig(ar, fileMaster(), filename, random_);
+      } else {
+         serializeConfigIo().saveConfig(ar);
+      }
 
       if (isIoProcessor()) {
          ar.file().close();
@@ -1057,10 +1166,27 @@ namespace DdMd
          read<std::string>(in, "externalStyle", externalStyle_);
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         read<std::string>(in, "coulombStyle", coulombStyle_);
+      }
+      #endif
 
       // Read policy regarding whether to excluded pair interactions
       // between covalently bonded pairs.
       read<MaskPolicy>(in, "maskedPairPolicy", maskedPairPolicy_);
+      #ifdef INTER_COULOMB
+      // The k-space sum includes all pairs, so no pairs may be masked.
+      if (hasCoulomb_ && maskedPairPolicy_ != MaskNone) {
+         UTIL_THROW("hasCoulomb requires maskedPairPolicy = MaskNone");
+      }
+      #ifndef INTER_NOPAIR
+      // The real space erfc term is only included by CoulombPair styles.
+      if (hasCoulomb_ && pairStyle_.compare(0, 12, "CoulombPair<") != 0) {
+         UTIL_THROW("hasCoulomb requires a CoulombPair<...> pairStyle");
+      }
+      #endif
+      #endif
 
       // Reverse communication (true) or not (false)?
       read<bool>(in, "reverseUpdateFlag", reverseUpdateFlag_);
@@ -1095,7 +1221,22 @@ namespace DdMd
          loadParameter<std::string>(ar, "externalStyle", externalStyle_);
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         loadParameter<std::string>(ar, "coulombStyle", coulombStyle_);
+      }
+      #endif
       loadParameter<MaskPolicy>(ar, "maskedPairPolicy", maskedPairPolicy_);
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_ && maskedPairPolicy_ != MaskNone) {
+         UTIL_THROW("hasCoulomb requires maskedPairPolicy = MaskNone");
+      }
+      #ifndef INTER_NOPAIR
+      if (hasCoulomb_ && pairStyle_.compare(0, 12, "CoulombPair<") != 0) {
+         UTIL_THROW("hasCoulomb requires a CoulombPair<...> pairStyle");
+      }
+      #endif
+      #endif
       loadParameter<bool>(ar, "reverseUpdateFlag", reverseUpdateFlag_);
 
       isInitialized_ = true;
@@ -1129,6 +1270,11 @@ namespace DdMd
          ar << externalStyle_;
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         ar << coulombStyle_;
+      }
+      #endif
       ar << maskedPairPolicy_;
       ar << reverseUpdateFlag_;
    }
@@ -1267,6 +1413,13 @@ namespace DdMd
                   exchanger_.outputStatistics(Log::file(), time, iStep);
                }
             } else
+            if (command == "OUTPUT_LOAD_BALANCE") {
+               // Output load imbalance and domain boundaries.
+               loadBalancer_.computeStatistics(integrator().pairForceTime());
+               if (domain_.isMaster()) {
+                  loadBalancer_.outputStatistics(Log::file());
+               }
+            } else
             if (command == "OUTPUT_MEMORY_STATS") {
                // Output statistics about memory usage during simulation.
                // Also clears statistics after printing output
@@ -1567,6 +1720,11 @@ namespace DdMd
          externalPotential().computeForces();
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeForces();
+      }
+      #endif
 
       // Reverse communication (if any)
       if (reverseUpdateFlag_) {
@@ -1601,6 +1759,11 @@ namespace DdMd
          externalPotential().computeForces();
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeForcesAndStress(domain_.communicator());
+      }
+      #endif
 
       // Reverse communication (if any)
       if (reverseUpdateFlag_) {
@@ -1765,6 +1928,11 @@ namespace DdMd
          externalPotential().computeEnergy(domain_.communicator());
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeEnergy(domain_.communicator());
+      }
+      #endif
    }
 
    #else
@@ -1794,6 +1962,11 @@ namespace DdMd
          externalPotential().computeEnergy();
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeEnergy();
+      }
+      #endif
    }
    #endif
 
@@ -1836,6 +2009,11 @@ namespace DdMd
          energy += externalPotential().energy();
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         energy += coulombPotential().energy();
+      }
+      #endif
       return energy;
    }
 
@@ -1865,6 +2043,11 @@ namespace DdMd
          externalPotential().unsetEnergy();
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().unsetEnergy();
+      }
+      #endif
    }
 
    // --- Virial Stress Methods ----------------------------------------
@@ -1891,6 +2074,11 @@ namespace DdMd
          dihedralPotential().computeStress(domain_.communicator());
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeStress(domain_.communicator());
+      }
+      #endif
    }
    #else
    /*
@@ -1914,6 +2102,11 @@ namespace DdMd
          dihedralPotential().computeStress();
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeStress();
+      }
+      #endif
    }
    #endif
 
@@ -1942,6 +2135,11 @@ namespace DdMd
          stress += dihedralPotential().stress();
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         stress += coulombPotential().stress();
+      }
+      #endif
       return stress;
    }
 
@@ -1968,6 +2166,11 @@ namespace DdMd
          pressure += dihedralPotential().pressure();
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         pressure += coulombPotential().pressure();
+      }
+      #endif
       return pressure;
    }
 
@@ -2017,6 +2220,11 @@ namespace DdMd
          dihedralPotential().unsetStress();
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().unsetStress();
+      }
+      #endif
    }
 
    // --- ConfigIo Accessors -------------------------------------------
@@ -2049,38 +2257,33 @@ namespace DdMd
       return *serializeConfigIoPtr_;
    }
 
+   /*
+   * Return a ShardConfigIo (create if necessary).
+   */
+   ShardConfigIo& Simulation::shardConfigIo()
+   {
+      if (shardConfigIoPtr_ == 0) {
+         shardConfigIoPtr_ = new ShardConfigIo(*this);
+      }
+      return *shardConfigIoPtr_;
+   }
+
    // --- Config File Read and Write -----------------------------------
 
    /*
-   * Read configuration file on master and distribute atoms.
+   * Read configuration file and distribute atoms.
    */
    void Simulation::readConfig(const std::string& filename)
    {
-      std::ifstream inputFile;
-      if (domain_.isMaster()) {
-         fileMaster().openInputFile(filename, inputFile);
-      }
-      configIo().readConfig(inputFile, maskedPairPolicy_);
+      configIo().readConfigFile(fileMaster(), filename, maskedPairPolicy_);
       exchanger_.exchange();
-      if (domain_.isMaster()) {
-         inputFile.close();
-      }
    }
 
    /*
-   * Write configuration file on master.
+   * Write configuration file.
    */
    void Simulation::writeConfig(const std::string& filename)
-   {
-      std::ofstream outputFile;
-      if (domain_.isMaster()) {
-         fileMaster().openOutputFile(filename, outputFile);
-      }
-      configIo().writeConfig(outputFile);
-      if (domain_.isMaster()) {
-         outputFile.close();
-      }
-   }
+   {  configIo().writeConfigFile(fileMaster(), filename); }
 
    // --- Potential Factories and Styles -------------------------------
 
@@ -2184,6 +2387,26 @@ namespace DdMd
    {  return externalStyle_;  }
    #endif
 
+   #ifdef INTER_COULOMB
+   /*
+   * Return the CoulombFactory by reference.
+   */
+   Factory<CoulombPotential>& Simulation::coulombFactory()
+   {
+      if (coulombFactoryPtr_ == 0) {
+         coulombFactoryPtr_ = new CoulombFactory(*this);
+      }
+      assert(coulombFactoryPtr_);
+      return *coulombFactoryPtr_;
+   }
+
+   /*
+   * Get the Coulomb style string.
+   */
+   std::string Simulation::coulombStyle() const
+   {  return coulombStyle_;  }
+   #endif
+
    // --- Integrator and ConfigIo Management ---------------------------
 
    /*
@@ -2364,6 +2587,11 @@ namespace DdMd
          externalPotential().isValid(domain_.communicator());
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().isValid(domain_.communicator());
+      }
+      #endif
       #endif // ifdef UTIL_MPI
 
       return true;
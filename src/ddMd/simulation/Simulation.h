@@ -12,6 +12,7 @@
 #include <ddMd/communicate/Domain.h>             // member
 #include <ddMd/communicate/Buffer.h>             // member
 #include <ddMd/communicate/Exchanger.h>          // member
+#include <ddMd/communicate/LoadBalancer.h>       // member
 #include <ddMd/storage/AtomStorage.h>            // member
 #include <ddMd/storage/BondStorage.h>            // member
 #include <ddMd/storage/AngleStorage.h>           // member
@@ -42,6 +43,7 @@ namespace DdMd
    class Integrator;
    class ConfigIo;
    class SerializeConfigIo;
+   class ShardConfigIo;
    #ifdef DDMD_MODIFIERS
    class ModifierManager;
    #endif
@@ -59,6 +61,9 @@ namespace DdMd
    #ifdef INTER_EXTERNAL
    class ExternalPotential;
    #endif
+   #ifdef INTER_COULOMB
+   class CoulombPotential;
+   #endif
 
    using namespace Util;
 
@@ -134,6 +139,11 @@ namespace DdMd
       *       obtained by adding a suffix ".rst" to the filename argument.
       *       Also sets the default command file name to filename + ".cmd".
       *
+      *   -g  nx,ny,nz [string]
+      *       Overrides the processor grid dimensions stored in the restart
+      *       file, so that a job may be restarted on a different number
+      *       of processors. Requires option -r.
+      *
       *   -c  filename [string]
       *       Specifies the name of a command file. If not specified here,
       *       the command file name may be specified in the FileMaster block
@@ -224,7 +234,9 @@ namespace DdMd
       * Call on all processors. Only writes from communicator ioProcessor.
       * This function opens an archive file with a name given by filename
       * + ".rst" on the ioProcessor, calls save(Serializable::OArchive& ),
-      * and closes the file.
+      * and closes the file. If Integrator::saveShards() is true, the
+      * configuration is written by all processors to separate shard 
+      * files by a ShardConfigIo, and the archive holds only a manifest.
       */
       void save(const std::string& filename);
 
@@ -285,7 +297,7 @@ namespace DdMd
       //@{
 
       /**
-      * Read configuration file on master and distribute atoms.
+      * Read configuration file and distribute atoms.
       *
       * Upon return, all processors should have all atoms and groups,
       * and a full set of ghost atoms, but values for the atomic
@@ -611,6 +623,28 @@ namespace DdMd
       Factory<ExternalPotential>& externalFactory();
       #endif
 
+      #ifdef INTER_COULOMB
+      /**
+      * Get the CoulombPotential by reference.
+      */
+      const CoulombPotential& coulombPotential() const;
+
+      /**
+      * Get the CoulombPotential by reference.
+      */
+      CoulombPotential& coulombPotential();
+
+      /**
+      * Return Coulomb (k-space) potential style string.
+      */
+      std::string coulombStyle() const;
+
+      /**
+      * Get the associated Coulomb Factory by reference.
+      */
+      Factory<CoulombPotential>& coulombFactory();
+      #endif
+
       //@}
       /// \name Atom and Group Containers
       //@{
@@ -692,6 +726,11 @@ namespace DdMd
       */
       Exchanger& exchanger();
 
+      /**
+      * Get the LoadBalancer by reference.
+      */
+      LoadBalancer& loadBalancer();
+
       /**
       * Get the Buffer by reference.
       */
@@ -751,6 +790,13 @@ namespace DdMd
       bool hasExternal();
       #endif
 
+      #ifdef INTER_COULOMB
+      /**
+      * Does this simulation have a Coulomb potential?
+      */
+      bool hasCoulomb();
+      #endif
+
       /**
       * Return the value of the mask policy (MaskNone or MaskBonded).
       */
@@ -892,6 +938,9 @@ namespace DdMd
       /// Exchanges atoms and ghosts for domain decomposition algorithm.
       Exchanger exchanger_;
 
+      /// Moves domain boundaries to balance load (optional).
+      LoadBalancer loadBalancer_;
+
       /// Random number generator.
       Random random_;
 
@@ -927,6 +976,11 @@ namespace DdMd
       ExternalPotential* externalPotentialPtr_;
       #endif
 
+      #ifdef INTER_COULOMB
+      /// Pointer to long range (k-space) part of Coulomb potential.
+      CoulombPotential* coulombPotentialPtr_;
+      #endif
+
       /// Pointer to MD integrator.
       Integrator* integratorPtr_;
 
@@ -945,6 +999,12 @@ namespace DdMd
       /// Pointer to a configuration reader/writer for restart.
       SerializeConfigIo* serializeConfigIoPtr_;
 
+      /// Pointer to a distributed configuration reader/writer for restart.
+      ShardConfigIo* shardConfigIoPtr_;
+
+      /// Name of restart file passed to load(std::string&).
+      std::string restartFileName_;
+
       #ifdef DDMD_MODIFIERS
       /// ModifierManager
       ModifierManager* modifierManagerPtr_;
@@ -978,6 +1038,11 @@ namespace DdMd
       Factory<ExternalPotential>* externalFactoryPtr_;
       #endif
 
+      #ifdef INTER_COULOMB
+      /// Pointer to CoulombPotential Factory
+      Factory<CoulombPotential>* coulombFactoryPtr_;
+      #endif
+
       /// Pointer to MD integrator factory.
       Factory<Integrator>* integratorFactoryPtr_;
 
@@ -1009,6 +1074,11 @@ namespace DdMd
       std::string externalStyle_;
       #endif
 
+      #ifdef INTER_COULOMB
+      /// Name of Coulomb (k-space) potential style.
+      std::string coulombStyle_;
+      #endif
+
       /// Number of distinct atom types.
       int nAtomType_;
 
@@ -1032,6 +1102,11 @@ namespace DdMd
       bool hasExternal_;
       #endif
 
+      #ifdef INTER_COULOMB
+      /// Does this simulation have a Coulomb potential?
+      bool hasCoulomb_;
+      #endif
+
       /// Does this simulation keep track of AtomContext info?
       bool hasAtomContext_;
 
@@ -1080,6 +1155,9 @@ namespace DdMd
       /// Return a SerializeConfigIo (create if necessary)
       SerializeConfigIo& serializeConfigIo();
 
+      /// Return a ShardConfigIo (create if necessary)
+      ShardConfigIo& shardConfigIo();
+
       void setGroup(std::stringstream& inBuffer);
 
    // friends:
@@ -1117,6 +1195,9 @@ namespace DdMd
    inline Exchanger& Simulation::exchanger()
    { return exchanger_; }
 
+   inline LoadBalancer& Simulation::loadBalancer()
+   { return loadBalancer_; }
+
    inline Buffer& Simulation::buffer()
    { return buffer_; }
 
@@ -1188,6 +1269,20 @@ namespace DdMd
    }
    #endif
 
+   #ifdef INTER_COULOMB
+   inline const CoulombPotential& Simulation::coulombPotential() const
+   {
+      assert(coulombPotentialPtr_);
+      return *coulombPotentialPtr_;
+   }
+
+   inline CoulombPotential& Simulation::coulombPotential()
+   {
+      assert(coulombPotentialPtr_);
+      return *coulombPotentialPtr_;
+   }
+   #endif
+
    /// Get the MD integrator by reference.
    inline Integrator& Simulation::integrator()
    {
@@ -1264,6 +1359,12 @@ namespace DdMd
    {  return hasExternal_; }
    #endif
 
+   #ifdef INTER_COULOMB
+   /// Does this simulation have a Coulomb potential?
+   inline bool Simulation::hasCoulomb()
+   {  return hasCoulomb_; }
+   #endif
+
    /// Get an AtomType descriptor for a specific type by reference.
    inline AtomType& Simulation::atomType(int i)
    {  return atomTypes_[i]; }
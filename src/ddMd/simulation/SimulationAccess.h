@@ -39,6 +39,9 @@ namespace DdMd
    #ifdef INTER_EXTERNAL
    class ExternalPotential;
    #endif
+   #ifdef INTER_COULOMB
+   class CoulombPotential;
+   #endif
    class Domain;
    class Exchanger;
    class AtomType;
@@ -127,6 +130,11 @@ namespace DdMd
       ExternalPotential& externalPotential();
       #endif
    
+      #ifdef INTER_COULOMB
+      /// Get the CoulombPotential.
+      CoulombPotential& coulombPotential();
+      #endif
+   
       /// Get the EnergyEnsemble.
       EnergyEnsemble& energyEnsemble();
 
@@ -168,6 +176,11 @@ namespace DdMd
       bool hasExternal();
       #endif
 
+      #ifdef INTER_COULOMB
+      /// Does this simulation have a Coulomb potential?
+      bool hasCoulomb();
+      #endif
+
       /// Get an AtomType descriptor for atomtype i.
       AtomType& atomType(int i);
 
@@ -231,6 +244,11 @@ namespace DdMd
       ExternalPotential* externalPotentialPtr_;
       #endif
 
+      #ifdef INTER_COULOMB
+      /// Pointer to long range part of Coulomb potential.
+      CoulombPotential* coulombPotentialPtr_;
+      #endif
+
       /// Pointer to an EnergyEnsemble.
       EnergyEnsemble* energyEnsemblePtr_;
 
@@ -272,6 +290,11 @@ namespace DdMd
       bool hasExternal_;
       #endif
 
+      #ifdef INTER_COULOMB
+      /// Does this simulation have a Coulomb potential?
+      bool hasCoulomb_;
+      #endif
+
       /**
       * Policy for suppressing pair interactions for some atom pairs.
       *
@@ -362,6 +385,14 @@ namespace DdMd
    }
    #endif
 
+   #ifdef INTER_COULOMB
+   inline CoulombPotential& SimulationAccess::coulombPotential()
+   {  
+      assert(coulombPotentialPtr_);  
+      return *coulombPotentialPtr_; 
+   }
+   #endif
+
    inline EnergyEnsemble& SimulationAccess::energyEnsemble()
    {  return *energyEnsemblePtr_; }
 
@@ -403,6 +434,11 @@ namespace DdMd
    {  return hasExternal_; }
    #endif
 
+   #ifdef INTER_COULOMB
+   inline bool SimulationAccess::hasCoulomb()
+   {  return hasCoulomb_; }
+   #endif
+
    inline AtomType& SimulationAccess::atomType(int i)
    {  return atomTypes_[i]; }
 
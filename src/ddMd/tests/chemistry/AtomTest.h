@@ -97,6 +97,7 @@ void AtomTest::testSubscript()
    TEST_ASSERT(a[1].velocity() == v);
    TEST_ASSERT(a[1].force()    == f);
    TEST_ASSERT(a[1].isGhost());
+   TEST_ASSERT(a[1].arrayId() == 1);
    TEST_ASSERT(a[1].mask().isMasked(39));
    TEST_ASSERT(a[1].mask().isMasked(37));
    TEST_ASSERT(a[1].mask().size() == 2);
@@ -109,6 +110,7 @@ void AtomTest::testSubscript()
    TEST_ASSERT(a[1].velocity() == v);
    TEST_ASSERT(a[1].force()    == f);
    TEST_ASSERT(!a[1].isGhost());
+   TEST_ASSERT(a[1].arrayId() == 1);
    TEST_ASSERT(a[1].mask().isMasked(39));
    TEST_ASSERT(a[1].mask().isMasked(37));
    TEST_ASSERT(!a[1].mask().isMasked(50));
@@ -7,6 +7,8 @@
 #include <util/space/Grid.h>
 #include <util/format/Int.h>
 #include <util/mpi/MpiLogger.h>
+#include <util/archives/BinaryFileOArchive.h>
+#include <util/archives/BinaryFileIArchive.h>
 
 #ifdef UTIL_MPI
 #ifndef TEST_MPI
@@ -130,6 +132,149 @@ public:
 
    }
 
+   void testSetGridBounds()
+   {  
+      printMethod(TEST_FUNC); 
+   
+      Boundary boundary;
+      #if UTIL_MPI
+      openFile("in/Domain"); 
+      #else
+      openFile("in/Domain.111"); 
+      domain_.setRank(0);
+      #endif
+      domain_.setBoundary(boundary);
+      domain_.readParam(file()); 
+
+      // Check initial uniform bounds
+      int i, k, n;
+      for (i = 0; i < Dimension; ++i) {
+         n = domain_.gridDimension(i);
+         TEST_ASSERT(eq(domain_.gridBound(i, 0), 0.0));
+         TEST_ASSERT(eq(domain_.gridBound(i, n), 1.0));
+         for (k = 0; k <= n; ++k) {
+            TEST_ASSERT(eq(domain_.gridBound(i, k), double(k)/double(n)));
+         }
+      }
+
+      // Set non-uniform bounds, with slab widths proportional to k + 1
+      DArray<double> bounds;
+      double norm;
+      for (i = 0; i < Dimension; ++i) {
+         n = domain_.gridDimension(i);
+         if (bounds.isAllocated()) {
+            bounds.deallocate();
+         }
+         bounds.allocate(n + 1);
+         norm = 0.5*double(n*(n + 1));
+         bounds[0] = 0.0;
+         for (k = 0; k < n; ++k) {
+            bounds[k+1] = bounds[k] + double(k + 1)/norm;
+         }
+         bounds[n] = 1.0;
+         domain_.setGridBounds(i, bounds);
+         k = domain_.gridCoordinate(i);
+         TEST_ASSERT(eq(domain_.domainBound(i, 0), bounds[k]));
+         TEST_ASSERT(eq(domain_.domainBound(i, 1), bounds[k+1]));
+      }
+
+      // Check consistency of ownerRank and isInDomain
+      Vector position;
+      int j, m;
+      for (j = 0; j < 7; ++j) {
+         for (i = 0; i < Dimension; ++i) {
+            position[i] = (double(j) + 0.3*(i + 1))/7.0;
+         }
+         m = domain_.ownerRank(position);
+         TEST_ASSERT(m >= 0);
+         TEST_ASSERT(m < domain_.grid().size());
+         TEST_ASSERT((m == domain_.gridRank()) == domain_.isInDomain(position));
+      }
+
+      // Centre of this domain must be owned by this processor
+      for (i = 0; i < Dimension; ++i) {
+         position[i] = 0.5*(domain_.domainBound(i, 0) 
+                          + domain_.domainBound(i, 1));
+      }
+      TEST_ASSERT(domain_.isInDomain(position));
+      TEST_ASSERT(domain_.ownerRank(position) == domain_.gridRank());
+   }
+
+   void testSaveLoadGridBounds()
+   {  
+      printMethod(TEST_FUNC); 
+   
+      Boundary boundary;
+      #if UTIL_MPI
+      openFile("in/Domain"); 
+      #else
+      openFile("in/Domain.111"); 
+      domain_.setRank(0);
+      #endif
+      domain_.setBoundary(boundary);
+      domain_.readParam(file()); 
+
+      // Set non-uniform bounds, with slab widths proportional to k + 1
+      DArray<double> bounds;
+      double norm;
+      int i, k, n;
+      for (i = 0; i < Dimension; ++i) {
+         n = domain_.gridDimension(i);
+         if (bounds.isAllocated()) {
+            bounds.deallocate();
+         }
+         bounds.allocate(n + 1);
+         norm = 0.5*double(n*(n + 1));
+         bounds[0] = 0.0;
+         for (k = 0; k < n; ++k) {
+            bounds[k+1] = bounds[k] + double(k + 1)/norm;
+         }
+         bounds[n] = 1.0;
+         domain_.setGridBounds(i, bounds);
+      }
+
+      // Save to archive
+      if (isIoProcessor()) {
+         BinaryFileOArchive oa;
+         openOutputFile("binary", oa.file());
+         domain_.save(oa);
+         oa.file().close();
+      }
+      #ifdef UTIL_MPI
+      communicator().Barrier();
+      #endif
+
+      // Load into a new Domain
+      Domain other;
+      #ifdef UTIL_MPI  
+      other.setGridCommunicator(communicator()); 
+      other.setIoCommunicator(communicator()); 
+      #else
+      other.setRank(0);
+      #endif
+      other.setBoundary(boundary);
+      BinaryFileIArchive ia;
+      if (isIoProcessor()) {
+         openInputFile("binary", ia.file());
+      }
+      other.load(ia);
+      if (isIoProcessor()) {
+         ia.file().close();
+      }
+
+      // Check that non-uniform boundaries were restored
+      for (i = 0; i < Dimension; ++i) {
+         n = domain_.gridDimension(i);
+         TEST_ASSERT(other.gridDimension(i) == n);
+         TEST_ASSERT(other.gridCoordinate(i) == domain_.gridCoordinate(i));
+         for (k = 0; k <= n; ++k) {
+            TEST_ASSERT(eq(other.gridBound(i, k), domain_.gridBound(i, k)));
+         }
+         TEST_ASSERT(eq(other.domainBound(i, 0), domain_.domainBound(i, 0)));
+         TEST_ASSERT(eq(other.domainBound(i, 1), domain_.domainBound(i, 1)));
+      }
+   }
+
    #if UTIL_MPI
    void testPing()
    {  
@@ -185,6 +330,8 @@ public:
 
 TEST_BEGIN(DomainTest)
 TEST_ADD(DomainTest, testReadParam)
+TEST_ADD(DomainTest, testSetGridBounds)
+TEST_ADD(DomainTest, testSaveLoadGridBounds)
 #ifdef UTIL_MPI
 TEST_ADD(DomainTest, testPing)
 #endif
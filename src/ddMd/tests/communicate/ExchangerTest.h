@@ -70,6 +70,7 @@ public:
    void testDistribute();
    void testExchange();
    void testGhostUpdate();
+   void testNonblockingUpdate();
    void testGhostUpdateCycle();
    void testExchangeUpdateCycle();
 
@@ -368,6 +369,65 @@ void ExchangerTest::testGhostUpdate()
 
 }
 
+void ExchangerTest::testNonblockingUpdate()
+{
+   printMethod(TEST_FUNC);
+
+   GhostIterator  ghostIter;
+   DArray<Vector> ghostPositions;
+   int i, nGhost;
+
+   double range = 0.1;
+   displaceAtoms(range);
+
+   atomStorage.clearSnapshot();
+   exchanger.exchange();
+   exchangeNotify();
+   atomStorage.transformGenToCart(boundary);
+   atomStorage.makeSnapshot();
+
+   // Blocking update, record ghost positions
+   exchanger.update();
+   nGhost = atomStorage.nGhost();
+   ghostPositions.allocate(nGhost);
+   atomStorage.begin(ghostIter);
+   for (i = 0; ghostIter.notEnd(); ++ghostIter, ++i) {
+      ghostPositions[i] = ghostIter->position();
+   }
+
+   // Nonblocking update completed by endUpdate()
+   atomStorage.begin(ghostIter);
+   for ( ; ghostIter.notEnd(); ++ghostIter) {
+      ghostIter->position() = Vector(-1.0);
+   }
+   exchanger.beginUpdate();
+   TEST_ASSERT(exchanger.isUpdateActive());
+   exchanger.endUpdate();
+   TEST_ASSERT(!exchanger.isUpdateActive());
+   TEST_ASSERT(nGhost == atomStorage.nGhost());
+   atomStorage.begin(ghostIter);
+   for (i = 0; ghostIter.notEnd(); ++ghostIter, ++i) {
+      TEST_ASSERT(ghostIter->position() == ghostPositions[i]);
+   }
+
+   // Nonblocking update completed by testUpdate()
+   atomStorage.begin(ghostIter);
+   for ( ; ghostIter.notEnd(); ++ghostIter) {
+      ghostIter->position() = Vector(-1.0);
+   }
+   exchanger.beginUpdate();
+   while (!exchanger.testUpdate()) {}
+   TEST_ASSERT(!exchanger.isUpdateActive());
+   exchanger.endUpdate();
+   atomStorage.begin(ghostIter);
+   for (i = 0; ghostIter.notEnd(); ++ghostIter, ++i) {
+      TEST_ASSERT(ghostIter->position() == ghostPositions[i]);
+   }
+
+   atomStorage.transformCartToGen(boundary);
+   TEST_ASSERT(atomStorage.isValid());
+}
+
 void ExchangerTest::testGhostUpdateCycle()
 {
    printMethod(TEST_FUNC);
@@ -626,6 +686,7 @@ TEST_BEGIN(ExchangerTest)
 TEST_ADD(ExchangerTest, testDistribute)
 TEST_ADD(ExchangerTest, testExchange)
 TEST_ADD(ExchangerTest, testGhostUpdate)
+TEST_ADD(ExchangerTest, testNonblockingUpdate)
 TEST_ADD(ExchangerTest, testGhostUpdateCycle)
 TEST_ADD(ExchangerTest, testExchangeUpdateCycle)
 TEST_END(ExchangerTest)
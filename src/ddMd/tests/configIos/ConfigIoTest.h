@@ -2,6 +2,7 @@
 #define DDMD_CONFIG_IO_TEST_H
 
 #include <ddMd/configIos/DdMdConfigIo.h>
+#include <ddMd/configIos/ParallelConfigIo.h>
 #include <ddMd/communicate/Domain.h>
 #include <ddMd/communicate/Buffer.h>
 #include <ddMd/communicate/GroupDistributor.h>
@@ -13,6 +14,7 @@
 #include <ddMd/storage/BondStorage.h>
 #include <ddMd/storage/AngleStorage.h>
 #include <ddMd/storage/DihedralStorage.h>
+#include <util/misc/FileMaster.h>
 #include <util/mpi/MpiLogger.h>
 
 #ifdef UTIL_MPI
@@ -189,11 +191,86 @@ public:
 
    }
 
+   #ifdef UTIL_MPI
+   void testParallelReadWriteConfig()
+   {
+      printMethod(TEST_FUNC);
+
+      readParam();
+      std::ifstream file;
+      openInputFile("in/config", file);
+      configIo.readConfig(file, MaskBonded);
+
+      ParallelConfigIo parallelIo;
+      parallelIo.associate(domain, boundary, atomStorage, bondStorage, 
+                           #ifdef INTER_ANGLE
+                           angleStorage,
+                           #endif
+                           #ifdef INTER_DIHEDRAL
+                           dihedralStorage,
+                           #endif
+                           buffer);
+      FileMaster fileMaster;
+      fileMaster.setInputPrefix(filePrefix());
+      fileMaster.setOutputPrefix(filePrefix());
+
+      // Record local atoms and total numbers of atoms and bonds
+      atomStorage.computeNAtomTotal(communicator());
+      bondStorage.computeNTotal(communicator());
+      int nAtom = atomStorage.nAtomTotal();
+      int nBond = bondStorage.nTotal();
+      std::vector<Vector> positions(atomStorage.totalAtomCapacity());
+      AtomIterator iter;
+      for (atomStorage.begin(iter); iter.notEnd(); ++iter) {
+         positions[iter->id()] = iter->position();
+      }
+      int nLocal = atomStorage.nAtom();
+
+      parallelIo.writeConfigFile(fileMaster, "outParallel");
+      clearStorage();
+      parallelIo.readConfigFile(fileMaster, "outParallel", MaskBonded);
+
+      // Atoms return to the same processors, at the same positions
+      TEST_ASSERT(atomStorage.nAtom() == nLocal);
+      Vector dr;
+      for (atomStorage.begin(iter); iter.notEnd(); ++iter) {
+         dr.subtract(iter->position(), positions[iter->id()]);
+         TEST_ASSERT(dr.square() < 1.0E-20);
+      }
+      atomStorage.unsetNAtomTotal();
+      atomStorage.computeNAtomTotal(communicator());
+      bondStorage.unsetNTotal();
+      bondStorage.computeNTotal(communicator());
+      if (domain.isMaster()) {
+         TEST_ASSERT(atomStorage.nAtomTotal() == nAtom);
+         TEST_ASSERT(bondStorage.nTotal() == nBond);
+      }
+      TEST_ASSERT(atomStorage.isValid(communicator()));
+      TEST_ASSERT(bondStorage.isValid(atomStorage, communicator(), false));
+   }
+   #endif
+
+   void clearStorage() 
+   {
+      atomStorage.clearAtoms();
+      atomStorage.clearGhosts();
+      bondStorage.clearGroups();
+      #ifdef INTER_ANGLE
+      angleStorage.clearGroups();
+      #endif
+      #ifdef INTER_DIHEDRAL
+      dihedralStorage.clearGroups();
+      #endif
+   }
+
 };
 
 TEST_BEGIN(ConfigIoTest)
 TEST_ADD(ConfigIoTest, testReadConfig)
 TEST_ADD(ConfigIoTest, testReadWriteConfig)
+#ifdef UTIL_MPI
+TEST_ADD(ConfigIoTest, testParallelReadWriteConfig)
+#endif
 TEST_END(ConfigIoTest)
 
 #endif /* CONFIG_IO_TEST_H */
@@ -0,0 +1,19 @@
+#include "ShardConfigIoTest.h"
+
+int main()
+{
+   #ifdef UTIL_MPI
+   MPI::Init();
+   IntVector::commitMpiType();
+   Vector::commitMpiType();
+   #endif
+
+   TEST_RUNNER(ShardConfigIoTest) runner;
+   runner.run();
+
+   #ifdef UTIL_MPI
+   MPI::Finalize();
+   #endif
+
+}
+
@@ -0,0 +1,356 @@
+#ifndef DDMD_SHARD_CONFIG_IO_TEST_H
+#define DDMD_SHARD_CONFIG_IO_TEST_H
+
+#include <ddMd/configIos/DdMdConfigIo.h>
+#include <ddMd/configIos/ShardConfigIo.h>
+#include <ddMd/communicate/Domain.h>
+#include <ddMd/communicate/Buffer.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/storage/GroupStorage.tpp>
+#include <ddMd/storage/BondStorage.h>
+#include <ddMd/storage/AngleStorage.h>
+#include <ddMd/storage/DihedralStorage.h>
+#include <util/archives/BinaryFileOArchive.h>
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/random/Random.h>
+#include <util/misc/FileMaster.h>
+#include <util/mpi/MpiLogger.h>
+
+#ifdef UTIL_MPI
+#ifndef TEST_MPI
+#define TEST_MPI
+#endif
+#endif
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+#include <test/ParamFileTest.h>
+
+#include <vector>
+
+using namespace Util;
+using namespace DdMd;
+
+class ShardConfigIoTest: public ParamFileTest
+{
+
+   DdMdConfigIo configIo;
+   ShardConfigIo shardConfigIo;
+   Boundary boundary;
+   Domain   domain;
+   Buffer   buffer;
+   AtomStorage  atomStorage;
+   BondStorage  bondStorage;
+   #ifdef INTER_ANGLE
+   AngleStorage  angleStorage;
+   #endif
+   #ifdef INTER_DIHEDRAL
+   DihedralStorage  dihedralStorage;
+   #endif
+   FileMaster fileMaster;
+   Random random;
+   #ifdef UTIL_MPI
+   MPI::Intracomm subCommunicator;
+   #endif
+   bool hasAngle;
+   bool hasDihedral;
+
+public:
+
+   ShardConfigIoTest()
+    : configIo(false) // hasMolecules = false
+   {}
+
+   virtual void setUp()
+   {
+      hasAngle = false;
+      #ifdef INTER_ANGLE
+      hasAngle = true;
+      #endif
+      hasDihedral = false;
+      #ifdef INTER_DIHEDRAL
+      hasDihedral = true;
+      #endif
+   }
+
+   /*
+   * Read parameters. The suffix selects a processor grid variant.
+   */
+   void readParam(const std::string& suffix = "")
+   {
+      // Set connections between objects
+      domain.setBoundary(boundary);
+      configIo.associate(domain, boundary, atomStorage, bondStorage,
+                         #ifdef INTER_ANGLE
+                         angleStorage,
+                         #endif
+                         #ifdef INTER_DIHEDRAL
+                         dihedralStorage,
+                         #endif
+                         buffer);
+      shardConfigIo.associate(domain, boundary, atomStorage, bondStorage,
+                              #ifdef INTER_ANGLE
+                              angleStorage,
+                              #endif
+                              #ifdef INTER_DIHEDRAL
+                              dihedralStorage,
+                              #endif
+                              buffer);
+
+      #ifdef UTIL_MPI
+      // Set communicators
+      domain.setGridCommunicator(communicator());
+      domain.setIoCommunicator(communicator());
+      atomStorage.setIoCommunicator(communicator());
+      bondStorage.setIoCommunicator(communicator());
+      #ifdef INTER_ANGLE
+      angleStorage.setIoCommunicator(communicator());
+      #endif
+      #ifdef INTER_DIHEDRAL
+      dihedralStorage.setIoCommunicator(communicator());
+      #endif
+      buffer.setIoCommunicator(communicator());
+      configIo.setIoCommunicator(communicator());
+      shardConfigIo.setIoCommunicator(communicator());
+      #else
+      domain.setRank(0);
+      #endif // ifdef UTIL_MPI
+
+      // Open parameter file
+      std::ifstream file;
+      if (hasDihedral) {
+         openInputFile("in/ConfigIo_a_d" + suffix, file);
+      } else {
+         if (hasAngle) {
+            openInputFile("in/ConfigIo_a" + suffix, file);
+         } else {
+            openInputFile("in/ConfigIo" + suffix, file);
+         }
+      }
+
+      domain.readParam(file);
+      buffer.readParam(file);
+
+      atomStorage.associate(domain, boundary, buffer);
+      atomStorage.readParam(file);
+
+      #ifdef INTER_BOND
+      bondStorage.associate(domain, atomStorage, buffer);
+      bondStorage.readParam(file);
+      #endif
+
+      #ifdef INTER_ANGLE
+      if (hasAngle) {
+         angleStorage.associate(domain, atomStorage, buffer);
+         angleStorage.readParam(file);
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (hasDihedral) {
+         dihedralStorage.associate(domain, atomStorage, buffer);
+         dihedralStorage.readParam(file);
+      }
+      #endif
+
+      configIo.readParam(file);
+      file.close();
+
+      // Shard files are opened relative to the root prefix
+      fileMaster.setRootPrefix(filePrefix());
+      random.setSeed(8712);
+   }
+
+   void clearStorage()
+   {
+      atomStorage.clearAtoms();
+      atomStorage.clearGhosts();
+      bondStorage.clearGroups();
+      #ifdef INTER_ANGLE
+      angleStorage.clearGroups();
+      #endif
+      #ifdef INTER_DIHEDRAL
+      dihedralStorage.clearGroups();
+      #endif
+   }
+
+   /*
+   * Read in/config and record positions of local atoms, by id.
+   */
+   void readConfig(std::vector<Vector>& positions)
+   {
+      std::ifstream inFile;
+      openInputFile("in/config", inFile);
+      configIo.readConfig(inFile, MaskBonded);
+      inFile.close();
+
+      positions.resize(atomStorage.totalAtomCapacity());
+      AtomIterator iter;
+      for (atomStorage.begin(iter); iter.notEnd(); ++iter) {
+         positions[iter->id()] = iter->position();
+      }
+   }
+
+   /*
+   * Check local atoms against recorded positions, and check totals.
+   */
+   void checkConfig(const std::vector<Vector>& positions, int nLocal,
+                    int nAtom, int nBond)
+   {
+      TEST_ASSERT(atomStorage.nAtom() == nLocal);
+      AtomIterator iter;
+      Vector dr;
+      for (atomStorage.begin(iter); iter.notEnd(); ++iter) {
+         dr.subtract(iter->position(), positions[iter->id()]);
+         TEST_ASSERT(dr.square() < 1.0E-20);
+      }
+      atomStorage.unsetNAtomTotal();
+      atomStorage.computeNAtomTotal(communicator());
+      bondStorage.unsetNTotal();
+      bondStorage.computeNTotal(communicator());
+      if (domain.isMaster()) {
+         TEST_ASSERT(atomStorage.nAtomTotal() == nAtom);
+         TEST_ASSERT(bondStorage.nTotal() == nBond);
+      }
+      TEST_ASSERT(atomStorage.isValid(communicator()));
+      TEST_ASSERT(bondStorage.isValid(atomStorage, communicator(), false));
+   }
+
+   void saveShards(const std::string& filename = "outShard")
+   {
+      Serializable::OArchive ar;
+      if (domain.isMaster()) {
+         fileMaster.openRestartOFile(filename, ar.file(),
+                                 std::ios_base::out | std::ios_base::binary);
+      }
+      shardConfigIo.saveConfig(ar, fileMaster, filename, random);
+      if (domain.isMaster()) {
+         ar.file().close();
+      }
+   }
+
+   void loadShards(const std::string& filename = "outShard")
+   {
+      Serializable::IArchive ar;
+      if (domain.isMaster()) {
+         fileMaster.openRestartIFile(filename, ar.file(),
+                                 std::ios_base::in | std::ios_base::binary);
+      }
+      shardConfigIo.loadConfig(ar, fileMaster, filename, random,
+                               MaskBonded);
+      if (domain.isMaster()) {
+         ar.file().close();
+      }
+   }
+
+   void testSaveLoadSameGrid()
+   {
+      printMethod(TEST_FUNC);
+      readParam();
+
+      std::vector<Vector> positions;
+      readConfig(positions);
+      atomStorage.computeNAtomTotal(communicator());
+      bondStorage.computeNTotal(communicator());
+      int nAtom = atomStorage.nAtomTotal();
+      int nBond = bondStorage.nTotal();
+      int nLocal = atomStorage.nAtom();
+
+      saveShards();
+      double next = random.uniform();
+      clearStorage();
+      loadShards();
+
+      // Atoms return to the same processors, and the state of the
+      // random number generator is restored
+      checkConfig(positions, nLocal, nAtom, nBond);
+      TEST_ASSERT(random.uniform() == next);
+   }
+
+   void testLoadNewGrid()
+   {
+      printMethod(TEST_FUNC);
+
+      // Load shards saved by testSaveLoadSameGrid on a 2 x 1 x 3 grid
+      readParam(".312");
+      TEST_ASSERT(domain.grid().dimensions() == IntVector(3, 1, 2));
+
+      // Atoms from all shards are distributed as from in/config
+      std::vector<Vector> positions;
+      readConfig(positions);
+      atomStorage.computeNAtomTotal(communicator());
+      bondStorage.computeNTotal(communicator());
+      int nAtom = atomStorage.nAtomTotal();
+      int nBond = bondStorage.nTotal();
+      int nLocal = atomStorage.nAtom();
+
+      clearStorage();
+      loadShards();
+      checkConfig(positions, nLocal, nAtom, nBond);
+   }
+
+   #ifdef UTIL_MPI
+   void testSaveTwoProcessors()
+   {
+      printMethod(TEST_FUNC);
+
+      // Save shards from the first two processors, on a 2 x 1 x 1 grid
+      int color = (communicator().Get_rank() < 2) ? 0 : 1;
+      subCommunicator = communicator().Split(color, 0);
+      if (color == 0) {
+         setCommunicator(subCommunicator);
+         readParam(".211");
+         TEST_ASSERT(domain.grid().dimensions() == IntVector(2, 1, 1));
+         std::vector<Vector> positions;
+         readConfig(positions);
+         saveShards("outShard2");
+      }
+      subCommunicator.Free();
+   }
+
+   void testLoadNewProcessorCount()
+   {
+      printMethod(TEST_FUNC);
+
+      // Load shards saved by testSaveTwoProcessors on all processors
+      readParam();
+      std::vector<Vector> positions;
+      readConfig(positions);
+      atomStorage.computeNAtomTotal(communicator());
+      bondStorage.computeNTotal(communicator());
+      int nAtom = atomStorage.nAtomTotal();
+      int nBond = bondStorage.nTotal();
+      int nLocal = atomStorage.nAtom();
+
+      clearStorage();
+      loadShards("outShard2");
+      checkConfig(positions, nLocal, nAtom, nBond);
+
+      // Each processor is reseeded with a seed drawn on the master
+      // plus its rank
+      long seed = random.seed();
+      long masterSeed = seed;
+      communicator().Bcast(&masterSeed, 1, MPI::LONG, 0);
+      TEST_ASSERT(seed == masterSeed + communicator().Get_rank());
+
+      // Reseeding is reproducible for the same saved generator state
+      clearStorage();
+      random.setSeed(8712);
+      loadShards("outShard2");
+      checkConfig(positions, nLocal, nAtom, nBond);
+      TEST_ASSERT(random.seed() == seed);
+   }
+   #endif
+
+};
+
+TEST_BEGIN(ShardConfigIoTest)
+TEST_ADD(ShardConfigIoTest, testSaveLoadSameGrid)
+TEST_ADD(ShardConfigIoTest, testLoadNewGrid)
+#ifdef UTIL_MPI
+TEST_ADD(ShardConfigIoTest, testSaveTwoProcessors)
+TEST_ADD(ShardConfigIoTest, testLoadNewProcessorCount)
+#endif
+TEST_END(ShardConfigIoTest)
+
+#endif /* SHARD_CONFIG_IO_TEST_H */
@@ -21,6 +21,7 @@
 #include <test/UnitTestRunner.h>
 
 #include <iostream>
+#include <vector>
 
 using namespace Util;
 using namespace DdMd;
@@ -363,12 +364,94 @@ public:
 
    }
 
+   void testPairIteratorBlocks()
+   {
+      printMethod(TEST_FUNC);
+
+      makeConfiguration();
+      pairList.build(cellList);
+
+      // Store pairs visited by a single iteration over the whole list
+      std::vector<Atom*> ptrs1;
+      std::vector<Atom*> ptrs2;
+      PairIterator iter;
+      Atom* atom1Ptr;
+      Atom* atom2Ptr;
+      for (pairList.begin(iter); iter.notEnd(); ++iter) {
+         iter.getPair(atom1Ptr, atom2Ptr);
+         ptrs1.push_back(atom1Ptr);
+         ptrs2.push_back(atom2Ptr);
+      }
+      TEST_ASSERT(int(ptrs1.size()) == pairList.nPair());
+
+      // Check that consecutive blocks visit the same pairs, in order
+      int nBlock, blockId, i;
+      for (nBlock = 1; nBlock <= 7; ++nBlock) {
+         i = 0;
+         for (blockId = 0; blockId < nBlock; ++blockId) {
+            PairIterator blockIter;
+            pairList.begin(blockIter, blockId, nBlock);
+            for ( ; blockIter.notEnd(); ++blockIter) {
+               blockIter.getPair(atom1Ptr, atom2Ptr);
+               TEST_ASSERT(i < pairList.nPair());
+               TEST_ASSERT(atom1Ptr == ptrs1[i]);
+               TEST_ASSERT(atom2Ptr == ptrs2[i]);
+               ++i;
+            }
+         }
+         TEST_ASSERT(i == pairList.nPair());
+      }
+
+   }
+
+   void testAtomTable()
+   {
+      printMethod(TEST_FUNC);
+
+      makeConfiguration();
+      pairList.build(cellList);
+      TEST_ASSERT(pairList.atomTableSize() == cellList.nAtom());
+
+      // Check that atom table indices give the same pairs as pointers
+      PairIterator iter;
+      Atom* atom1Ptr;
+      Atom* atom2Ptr;
+      int   id1, id2;
+      for (pairList.begin(iter); iter.notEnd(); ++iter) {
+         iter.getPair(atom1Ptr, atom2Ptr);
+         iter.getPairIds(id1, id2);
+         TEST_ASSERT(pairList.atomPtr(id1) == atom1Ptr);
+         TEST_ASSERT(pairList.atomPtr(id2) == atom2Ptr);
+      }
+
+      // Check neighbor arrays of primary atoms against the iterator
+      const int* ids;
+      int i, j, n;
+      pairList.begin(iter);
+      for (i = 0; i < pairList.nAtom(); ++i) {
+         ids = pairList.atom2Ids(i);
+         n = pairList.nNeighbor(i);
+         TEST_ASSERT(n > 0);
+         for (j = 0; j < n; ++j) {
+            TEST_ASSERT(iter.notEnd());
+            iter.getPairIds(id1, id2);
+            TEST_ASSERT(id1 == pairList.atom1Id(i));
+            TEST_ASSERT(id2 == ids[j]);
+            ++iter;
+         }
+      }
+      TEST_ASSERT(iter.isEnd());
+
+   }
+
 };
 
 TEST_BEGIN(PairListTest)
 TEST_ADD(PairListTest, testCountNeighbors)
 TEST_ADD(PairListTest, testCountNeighbors2)
 TEST_ADD(PairListTest, testPairIterator)
+TEST_ADD(PairListTest, testPairIteratorBlocks)
+TEST_ADD(PairListTest, testAtomTable)
 TEST_END(PairListTest)
 
 #endif
@@ -24,6 +24,25 @@
 using namespace Util;
 using namespace DdMd;
 
+/*
+* Observer that counts notifications of a Signal<>.
+*/
+class SignalCounter
+{
+public:
+
+   SignalCounter() : count_(0) {}
+
+   void increment() { ++count_; }
+
+   int count() const { return count_; }
+
+private:
+
+   int count_;
+
+};
+
 class SimulationTest : public ParamFileTest
 {
 private:
@@ -33,6 +52,17 @@ private:
    void displaceAtoms(AtomStorage& atomStorage, const Boundary& boundary, 
                       Random& random, double range);
 
+   double totalEnergy(DdMd::Simulation& simulation);
+
+   void velocitySums(DdMd::Simulation& simulation, 
+                     Vector& momentum, Vector& idMoment);
+
+   void compareTrajectories(const char* paramFile, 
+                            const std::string& configFile, 
+                            int nStep, int nRun);
+
+   void checkClearIntegrator(const char* paramFile);
+
 public:
 
    virtual void setUp()
@@ -60,6 +90,18 @@ public:
 
    void testIntegrate1();
 
+   void testDeferredExchangeCheck();
+
+   void testRespaSingleInnerStep();
+
+   void testRespaEnergyDrift();
+
+   void testDpdMomentum();
+
+   void testLangevinClear();
+
+   void testDpdClear();
+
 };
 
 
@@ -84,6 +126,127 @@ SimulationTest::displaceAtoms(AtomStorage& atomStorage,
    }
 }
 
+/*
+* Return total energy on master, between runs (scaled coordinates).
+*/
+inline double SimulationTest::totalEnergy(DdMd::Simulation& simulation)
+{
+   AtomStorage& atomStorage = simulation.atomStorage();
+   atomStorage.transformGenToCart(simulation.boundary());
+   simulation.unsetKineticEnergy();
+   simulation.unsetPotentialEnergies();
+   simulation.computeKineticEnergy();
+   simulation.computePotentialEnergies();
+   double energy = 0.0;
+   if (simulation.domain().isMaster()) {
+      energy = simulation.kineticEnergy() + simulation.potentialEnergy();
+   }
+   atomStorage.transformCartToGen(simulation.boundary());
+   return energy;
+}
+
+/*
+* Total momentum, and sum of id*velocity, for all atoms on all processors.
+*/
+inline void 
+SimulationTest::velocitySums(DdMd::Simulation& simulation, 
+                             Vector& momentum, Vector& idMoment)
+{
+   Vector localMomentum(0.0);
+   Vector localIdMoment(0.0);
+   Vector dp;
+   double mass;
+   AtomIterator atomIter;
+   simulation.atomStorage().begin(atomIter);
+   for ( ; atomIter.notEnd(); ++atomIter) {
+      mass = simulation.atomType(atomIter->typeId()).mass();
+      dp.multiply(atomIter->velocity(), mass);
+      localMomentum += dp;
+      dp.multiply(atomIter->velocity(), double(atomIter->id()));
+      localIdMoment += dp;
+   }
+   MPI::Intracomm& communicator = simulation.domain().communicator();
+   communicator.Allreduce(&localMomentum[0], &momentum[0], Dimension, 
+                          MPI::DOUBLE, MPI::SUM);
+   communicator.Allreduce(&localIdMoment[0], &idMoment[0], Dimension, 
+                          MPI::DOUBLE, MPI::SUM);
+}
+
+/*
+* Compare trajectories of simulation_, with parameter file in/param2, and
+* of an identical simulation with parameter file paramFile. Both start 
+* from configFile, with the same random velocities, and do nRun runs of
+* nStep steps. The trajectories must be the same, to within round-off.
+*/
+inline void 
+SimulationTest::compareTrajectories(const char* paramFile, 
+                                    const std::string& configFile,
+                                    int nStep, int nRun)
+{
+   // Reference simulation, with NveIntegrator
+   openFile("in/param2"); 
+   simulation_.readParam(file()); 
+   file().close();
+
+   // Simulation to be compared
+   Label::clear();
+   DdMd::Simulation other;
+   other.fileMaster().setRootPrefix(filePrefix()); 
+   openFile(paramFile); 
+   other.readParam(file()); 
+   file().close();
+
+   simulation_.readConfig(configFile);
+   other.readConfig(configFile);
+   AtomStorage& storage = simulation_.atomStorage();
+   AtomStorage& otherStorage = other.atomStorage();
+   AtomIterator atomIter;
+   Atom* otherPtr;
+
+   // Copy random velocities to the other simulation, by atom id
+   double temperature = 1.0;
+   simulation_.setBoltzmannVelocities(temperature);
+   for (storage.begin(atomIter); atomIter.notEnd(); ++atomIter) {
+      otherPtr = otherStorage.map().find(atomIter->id());
+      TEST_ASSERT(otherPtr);
+      otherPtr->velocity() = atomIter->velocity();
+   }
+
+   SignalCounter counter;
+   SignalCounter otherCounter;
+   simulation_.exchangeSignal().addObserver(counter, 
+                                            &SignalCounter::increment);
+   other.exchangeSignal().addObserver(otherCounter, 
+                                      &SignalCounter::increment);
+
+   for (int i = 0; i < nRun; ++i) {
+      simulation_.integrator().run(nStep);
+      other.integrator().run(nStep);
+   }
+   TEST_ASSERT(simulation_.isValid());
+   TEST_ASSERT(other.isValid());
+
+   // Same number of exchanges, and one exchange signal per step
+   int nBuild = simulation_.pairPotential().pairList().buildCounter();
+   TEST_ASSERT(nBuild > 1);
+   TEST_ASSERT(other.pairPotential().pairList().buildCounter() == nBuild);
+   TEST_ASSERT(counter.count() == nRun*nStep);
+   TEST_ASSERT(otherCounter.count() == nRun*nStep);
+
+   // Same trajectory: each local atom is owned by the same processor,
+   // with the same position and velocity (in scaled coordinates).
+   TEST_ASSERT(otherStorage.nAtom() == storage.nAtom());
+   for (storage.begin(atomIter); atomIter.notEnd(); ++atomIter) {
+      otherPtr = otherStorage.map().find(atomIter->id());
+      TEST_ASSERT(otherPtr);
+      TEST_ASSERT(!otherPtr->isGhost());
+      for (int i = 0; i < Dimension; ++i) {
+         TEST_ASSERT(eq(atomIter->position()[i], otherPtr->position()[i]));
+         TEST_ASSERT(eq(atomIter->velocity()[i], otherPtr->velocity()[i]));
+      }
+   }
+}
+
 inline void SimulationTest::testReadParam()
 {  
    printMethod(TEST_FUNC); 
@@ -347,6 +510,166 @@ inline void SimulationTest::testIntegrate1()
 
 }
 
+inline void SimulationTest::testDeferredExchangeCheck()
+{
+   printMethod(TEST_FUNC); 
+
+   // NveIntegrator with a deferred exchange check (in/param3) gives the
+   // same trajectory as with a blocking exchange check (in/param2).
+   compareTrajectories("in/param3", "config2", 200, 1);
+}
+
+inline void SimulationTest::testRespaSingleInnerStep()
+{
+   printMethod(TEST_FUNC); 
+
+   // NveRespaIntegrator with nInner = 1 is identical to NveIntegrator.
+   // Two runs, to check restart of RESPA after setup.
+   compareTrajectories("in/param4", "config3", 100, 2);
+}
+
+inline void SimulationTest::testRespaEnergyDrift()
+{
+   printMethod(TEST_FUNC); 
+
+   // NveRespaIntegrator with dt = 0.01 and nInner = 4, for bead-spring
+   // chains with stiff harmonic bonds (kappa = 400)
+   openFile("in/param5"); 
+   simulation_.readParam(file()); 
+   file().close();
+
+   std::string filename("config3");
+   simulation_.readConfig(filename);
+   double temperature = 1.0;
+   simulation_.setBoltzmannVelocities(temperature);
+
+   // Run zero steps to create ghosts and pair list
+   simulation_.integrator().run(0);
+   double energy0 = totalEnergy(simulation_);
+
+   simulation_.integrator().run(500);
+   TEST_ASSERT(simulation_.isValid());
+   double energy1 = totalEnergy(simulation_);
+
+   // Drift per atom is bounded. With nInner = 1, drift is ~3.0E-3.
+   if (simulation_.domain().isMaster()) {
+      int nAtom = simulation_.atomStorage().nAtomTotal();
+      double drift = fabs(energy1 - energy0)/double(nAtom);
+      if (verbose() > 0) {
+         std::cout << std::endl << "Energy drift per atom = " 
+                   << drift << std::endl;
+      }
+      TEST_ASSERT(drift < 5.0E-4);
+   }
+}
+
+inline void SimulationTest::testDpdMomentum()
+{
+   printMethod(TEST_FUNC); 
+
+   // NvtDpdIntegrator on a 2x1x3 grid, with reverse communication
+   openFile("in/param6"); 
+   simulation_.readParam(file()); 
+   file().close();
+
+   // NvtDpdIntegrator on a 3x2x1 grid, without reverse communication,
+   // for which pairs that span a domain boundary are evaluated on both 
+   // processors, and must receive the same random force.
+   Label::clear();
+   DdMd::Simulation other;
+   other.fileMaster().setRootPrefix(filePrefix()); 
+   openFile("in/param7"); 
+   other.readParam(file()); 
+   file().close();
+
+   // Use velocities from the configuration file
+   std::string filename("config3");
+   simulation_.readConfig(filename);
+   other.readConfig(filename);
+   Vector momentum0, idMoment0;
+   velocitySums(simulation_, momentum0, idMoment0);
+
+   int nStep = 100;
+   simulation_.integrator().run(nStep);
+   other.integrator().run(nStep);
+   TEST_ASSERT(simulation_.isValid());
+   TEST_ASSERT(other.isValid());
+
+   // Momentum is conserved on each grid, and velocities are the same
+   // (to within round-off error) on both grids.
+   Vector momentum, idMoment, otherMomentum, otherIdMoment;
+   velocitySums(simulation_, momentum, idMoment);
+   velocitySums(other, otherMomentum, otherIdMoment);
+   double scale = sqrt(idMoment0.square());
+   for (int i = 0; i < Dimension; ++i) {
+      TEST_ASSERT(eq(momentum[i], momentum0[i]));
+      TEST_ASSERT(eq(otherMomentum[i], momentum0[i]));
+      TEST_ASSERT(eq(otherIdMoment[i]/scale, idMoment[i]/scale));
+      TEST_ASSERT(!eq(idMoment[i]/scale, idMoment0[i]/scale));
+   }
+}
+
+/*
+* Check that a run after CLEAR_INTEGRATOR does not replay random forces.
+*/
+inline void SimulationTest::checkClearIntegrator(const char* paramFile)
+{
+   // Reference simulation, run without CLEAR_INTEGRATOR
+   openFile(paramFile); 
+   simulation_.readParam(file()); 
+   file().close();
+
+   // Identical simulation, with CLEAR_INTEGRATOR after a run of zero 
+   // steps, which resets the step index but must not replay the same
+   // random forces.
+   Label::clear();
+   DdMd::Simulation cleared;
+   cleared.fileMaster().setRootPrefix(filePrefix()); 
+   openFile(paramFile); 
+   cleared.readParam(file()); 
+   file().close();
+
+   std::string filename("config3");
+   simulation_.readConfig(filename);
+   cleared.readConfig(filename);
+   Vector momentum0, idMoment0;
+   velocitySums(simulation_, momentum0, idMoment0);
+
+   int nStep = 20;
+   cleared.integrator().run(0);
+   cleared.integrator().clear();
+   TEST_ASSERT(cleared.integrator().iStep() == 0);
+   simulation_.integrator().run(nStep);
+   cleared.integrator().run(nStep);
+   TEST_ASSERT(simulation_.isValid());
+   TEST_ASSERT(cleared.isValid());
+
+   // Velocities differ after the same number of steps
+   Vector momentum, idMoment, clearedMomentum, clearedIdMoment;
+   velocitySums(simulation_, momentum, idMoment);
+   velocitySums(cleared, clearedMomentum, clearedIdMoment);
+   double scale = sqrt(idMoment0.square());
+   for (int i = 0; i < Dimension; ++i) {
+      TEST_ASSERT(!eq(clearedIdMoment[i]/scale, idMoment[i]/scale));
+   }
+}
+
+inline void SimulationTest::testLangevinClear()
+{
+   printMethod(TEST_FUNC); 
+
+   // NvtLangevinIntegrator
+   checkClearIntegrator("in/param8");
+}
+
+inline void SimulationTest::testDpdClear()
+{
+   printMethod(TEST_FUNC); 
+
+   // NvtDpdIntegrator, with reverse communication
+   checkClearIntegrator("in/param6");
+}
+
 TEST_BEGIN(SimulationTest)
 TEST_ADD(SimulationTest, testReadParam)
 TEST_ADD(SimulationTest, testReadConfig)
@@ -355,6 +678,12 @@ TEST_ADD(SimulationTest, testExchange)
 TEST_ADD(SimulationTest, testUpdate)
 TEST_ADD(SimulationTest, testCalculateForces)
 TEST_ADD(SimulationTest, testIntegrate1)
+TEST_ADD(SimulationTest, testDeferredExchangeCheck)
+TEST_ADD(SimulationTest, testRespaSingleInnerStep)
+TEST_ADD(SimulationTest, testRespaEnergyDrift)
+TEST_ADD(SimulationTest, testDpdMomentum)
+TEST_ADD(SimulationTest, testLangevinClear)
+TEST_ADD(SimulationTest, testDpdClear)
 TEST_END(SimulationTest)
 
 #endif
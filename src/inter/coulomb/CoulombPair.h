@@ -0,0 +1,404 @@
+#ifndef INTER_COULOMB_PAIR_H
+#define INTER_COULOMB_PAIR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>
+#include <util/containers/DArray.h>
+#include <util/containers/DMatrix.h>
+#include <inter/coulomb/EwaldInteraction.h>
+#include <util/global.h>
+
+#include <string>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /**
+   * Short range pair interaction plus real space Ewald Coulomb term.
+   *
+   * CoulombPair<BasePair> adds the screened real space Coulomb energy
+   * qi*qj*erfc(alpha r)/(4 pi epsilon r) to a base pair interaction,
+   * such as LJPair. The long range remainder of the Coulomb interaction
+   * must be computed by a separate k-space solver. The parameter file
+   * format is identical to that of the base interaction. Charges and
+   * the Ewald parameters are not read by this class: They must be set
+   * by calling setEwaldInteraction() and setCharge() before calling
+   * readParameters().
+   *
+   * The cutoff for each type pair is the larger of the base interaction
+   * cutoff and the real space Coulomb cutoff, or the base cutoff alone
+   * if either type is uncharged.
+   *
+   * \sa \ref inter_coulomb_CoulombPair_page
+   *
+   * \ingroup Inter_Coulomb_Module
+   */
+   template <class BasePair>
+   class CoulombPair : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      CoulombPair();
+
+      /// \name Mutators
+      //@{
+
+      /**
+      * Set nAtomType value.
+      *
+      * May be called more than once with the same value: Later calls
+      * do not reset charges set by setCharge.
+      *
+      * \param nAtomType number of atom types.
+      */
+      void setNAtomType(int nAtomType);
+
+      /**
+      * Set Ewald splitting parameters.
+      *
+      * \param ewald  EwaldInteraction (parameters are copied)
+      */
+      void setEwaldInteraction(const EwaldInteraction& ewald);
+
+      /**
+      * Set charge of one atom type.
+      *
+      * \param i       atom type index
+      * \param charge  charge of type i
+      */
+      void setCharge(int i, double charge);
+
+      /**
+      * Read parameters of the base interaction.
+      *
+      * \pre nAtomType, Ewald parameters and charges must have been set.
+      *
+      * \param in  input parameter stream
+      */
+      void readParameters(std::istream &in);
+
+      /**
+      * Load parameters of the base interaction from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save parameters of the base interaction to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Modify a parameter of the base interaction.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      * \param value  new value of parameter
+      */
+      void set(std::string name, int i, int j, double value);
+
+      //@}
+      /// \name Accessors
+      //@{
+
+      /**
+      * Returns interaction energy for a single pair of atoms.
+      *
+      * \param rsq square of distance between atoms
+      * \param i   type of atom 1
+      * \param j   type of atom 2
+      * \return    pair interaction energy
+      */
+      double energy(double rsq, int i, int j) const;
+
+      /**
+      * Returns ratio of scalar pair interaction force to pair separation.
+      *
+      * \pre rsq < cutoffSq(i, j)
+      *
+      * \param rsq square of distance between atoms
+      * \param i   type of atom 1
+      * \param j   type of atom 2
+      * \return    force divided by distance
+      */
+      double forceOverR(double rsq, int i, int j) const;
+
+      /**
+      * Get square of cutoff distance for specific type pair.
+      *
+      * \param i   type of atom 1
+      * \param j   type of atom 2
+      */
+      double cutoffSq(int i, int j) const;
+
+      /**
+      * Get maximum of pair cutoff distance, for all atom type pairs.
+      */
+      double maxPairCutoff() const;
+
+      /**
+      * Get a parameter value of the base interaction.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      */
+      double get(std::string name, int i, int j) const;
+
+      /**
+      * Get the base pair interaction.
+      */
+      const BasePair& basePair() const;
+
+      /**
+      * Get the Ewald parameters.
+      */
+      const EwaldInteraction& ewaldInteraction() const;
+
+      //@}
+
+   private:
+
+      /// Short range base interaction.
+      BasePair basePair_;
+
+      /// Ewald parameters.
+      EwaldInteraction ewald_;
+
+      /// Charges of atom types.
+      DArray<double> charges_;
+
+      /// Charge products qi*qj for type pairs.
+      DMatrix<double> qProducts_;
+
+      /// Total cutoffs squared for type pairs.
+      DMatrix<double> cutoffSq_;
+
+      /// Maximum total pair cutoff.
+      double maxPairCutoff_;
+
+      /// Total number of atom types.
+      int nAtomType_;
+
+      /*
+      * Compute charge products and cutoffs.
+      */
+      void initialize();
+
+   };
+
+   // Inline methods
+
+   /*
+   * Calculate interaction energy for a pair.
+   */
+   template <class BasePair>
+   inline
+   double CoulombPair<BasePair>::energy(double rsq, int i, int j) const
+   {
+      double energy = basePair_.energy(rsq, i, j);
+      if (rsq < ewald_.rSpaceCutoffSq() && qProducts_(i, j) != 0.0) {
+         energy += ewald_.rSpaceEnergy(rsq, qProducts_(i, j));
+      }
+      return energy;
+   }
+
+   /*
+   * Calculate force/distance for a pair.
+   */
+   template <class BasePair>
+   inline
+   double CoulombPair<BasePair>::forceOverR(double rsq, int i, int j) const
+   {
+      double f = 0.0;
+      if (rsq < basePair_.cutoffSq(i, j)) {
+         f = basePair_.forceOverR(rsq, i, j);
+      }
+      if (rsq < ewald_.rSpaceCutoffSq() && qProducts_(i, j) != 0.0) {
+         f += ewald_.rSpaceForceOverR(rsq, qProducts_(i, j));
+      }
+      return f;
+   }
+
+   /*
+   * Return total cutoff squared for a type pair.
+   */
+   template <class BasePair>
+   inline double CoulombPair<BasePair>::cutoffSq(int i, int j) const
+   {  return cutoffSq_(i, j); }
+
+   // Non-inline methods
+
+   /*
+   * Constructor.
+   */
+   template <class BasePair>
+   CoulombPair<BasePair>::CoulombPair()
+    : maxPairCutoff_(0.0),
+      nAtomType_(0)
+   {
+      std::string name("CoulombPair<");
+      name += basePair_.className();
+      name += ">";
+      setClassName(name.c_str());
+   }
+
+   /*
+   * Set nAtomType.
+   */
+   template <class BasePair>
+   void CoulombPair<BasePair>::setNAtomType(int nAtomType)
+   {
+      basePair_.setNAtomType(nAtomType);
+
+      // Repeated calls with the same value retain any charges already set
+      if (charges_.isAllocated()) {
+         if (nAtomType != nAtomType_) {
+            UTIL_THROW("Attempt to change nAtomType");
+         }
+         return;
+      }
+      nAtomType_ = nAtomType;
+      charges_.allocate(nAtomType);
+      qProducts_.allocate(nAtomType, nAtomType);
+      cutoffSq_.allocate(nAtomType, nAtomType);
+      for (int i = 0; i < nAtomType; ++i) {
+         charges_[i] = 0.0;
+      }
+   }
+
+   /*
+   * Set Ewald parameters.
+   */
+   template <class BasePair>
+   void CoulombPair<BasePair>::setEwaldInteraction(const EwaldInteraction& ewald)
+   {  ewald_ = ewald; }
+
+   /*
+   * Set charge of one atom type.
+   */
+   template <class BasePair>
+   void CoulombPair<BasePair>::setCharge(int i, double charge)
+   {
+      if (i < 0 || i >= nAtomType_) {
+         UTIL_THROW("Invalid atom type index");
+      }
+      charges_[i] = charge;
+   }
+
+   /*
+   * Read parameters of base interaction.
+   */
+   template <class BasePair>
+   void CoulombPair<BasePair>::readParameters(std::istream &in)
+   {
+      bool nextIndent = false;
+      addParamComposite(basePair_, nextIndent);
+      basePair_.readParameters(in);
+      initialize();
+   }
+
+   /*
+   * Load parameters of base interaction.
+   */
+   template <class BasePair>
+   void CoulombPair<BasePair>::loadParameters(Serializable::IArchive &ar)
+   {
+      bool nextIndent = false;
+      addParamComposite(basePair_, nextIndent);
+      basePair_.loadParameters(ar);
+      initialize();
+   }
+
+   /*
+   * Save parameters of base interaction.
+   */
+   template <class BasePair>
+   void CoulombPair<BasePair>::save(Serializable::OArchive &ar)
+   {  basePair_.save(ar); }
+
+   /*
+   * Modify a parameter of the base interaction.
+   */
+   template <class BasePair>
+   void
+   CoulombPair<BasePair>::set(std::string name, int i, int j, double value)
+   {
+      basePair_.set(name, i, j, value);
+      initialize();
+   }
+
+   /*
+   * Get a parameter of the base interaction.
+   */
+   template <class BasePair>
+   double CoulombPair<BasePair>::get(std::string name, int i, int j) const
+   {  return basePair_.get(name, i, j); }
+
+   /*
+   * Get maximum pair cutoff.
+   */
+   template <class BasePair>
+   double CoulombPair<BasePair>::maxPairCutoff() const
+   {  return maxPairCutoff_; }
+
+   /*
+   * Get base interaction.
+   */
+   template <class BasePair>
+   const BasePair& CoulombPair<BasePair>::basePair() const
+   {  return basePair_; }
+
+   /*
+   * Get Ewald parameters.
+   */
+   template <class BasePair>
+   const EwaldInteraction& CoulombPair<BasePair>::ewaldInteraction() const
+   {  return ewald_; }
+
+   /*
+   * Compute charge products and total cutoffs (private).
+   */
+   template <class BasePair>
+   void CoulombPair<BasePair>::initialize()
+   {
+      if (nAtomType_ <= 0) {
+         UTIL_THROW("nAtomType must be set before readParameters");
+      }
+      double rcSq = ewald_.rSpaceCutoffSq();
+      double cutSq;
+      int i, j;
+      maxPairCutoff_ = basePair_.maxPairCutoff();
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nAtomType_; ++j) {
+            qProducts_(i, j) = charges_[i]*charges_[j];
+            cutSq = basePair_.cutoffSq(i, j);
+            if (qProducts_(i, j) != 0.0 && rcSq > cutSq) {
+               cutSq = rcSq;
+               if (ewald_.rSpaceCutoff() > maxPairCutoff_) {
+                  maxPairCutoff_ = ewald_.rSpaceCutoff();
+               }
+            }
+            cutoffSq_(i, j) = cutSq;
+         }
+      }
+   }
+
+}
+#endif
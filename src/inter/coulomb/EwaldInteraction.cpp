@@ -0,0 +1,165 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "EwaldInteraction.h"
+#include <util/math/Constants.h>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   EwaldInteraction::EwaldInteraction()
+    : epsilon_(1.0),
+      alpha_(1.0),
+      rSpaceCutoff_(1.0),
+      rSpaceCutoffSq_(1.0),
+      prefactor_(1.0),
+      alphaSq_(1.0),
+      twoAlphaOverSqrtPi_(1.0),
+      isInitialized_(false)
+   {  setClassName("EwaldInteraction"); }
+
+   /*
+   * Copy constructor.
+   */
+   EwaldInteraction::EwaldInteraction(const EwaldInteraction& other)
+    : epsilon_(other.epsilon_),
+      alpha_(other.alpha_),
+      rSpaceCutoff_(other.rSpaceCutoff_),
+      rSpaceCutoffSq_(other.rSpaceCutoffSq_),
+      prefactor_(other.prefactor_),
+      alphaSq_(other.alphaSq_),
+      twoAlphaOverSqrtPi_(other.twoAlphaOverSqrtPi_),
+      isInitialized_(other.isInitialized_)
+   {  setClassName("EwaldInteraction"); }
+
+   /*
+   * Assignment operator.
+   */
+   EwaldInteraction& EwaldInteraction::operator = (const EwaldInteraction& other)
+   {
+      epsilon_ = other.epsilon_;
+      alpha_ = other.alpha_;
+      rSpaceCutoff_ = other.rSpaceCutoff_;
+      rSpaceCutoffSq_ = other.rSpaceCutoffSq_;
+      prefactor_ = other.prefactor_;
+      alphaSq_ = other.alphaSq_;
+      twoAlphaOverSqrtPi_ = other.twoAlphaOverSqrtPi_;
+      isInitialized_ = other.isInitialized_;
+      return *this;
+   }
+
+   /*
+   * Read parameters from file.
+   */
+   void EwaldInteraction::readParameters(std::istream &in)
+   {
+      read<double>(in, "epsilon", epsilon_);
+      read<double>(in, "alpha", alpha_);
+      read<double>(in, "rSpaceCutoff", rSpaceCutoff_);
+      initialize();
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void EwaldInteraction::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<double>(ar, "epsilon", epsilon_);
+      loadParameter<double>(ar, "alpha", alpha_);
+      loadParameter<double>(ar, "rSpaceCutoff", rSpaceCutoff_);
+      initialize();
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void EwaldInteraction::save(Serializable::OArchive &ar)
+   {
+      ar << epsilon_;
+      ar << alpha_;
+      ar << rSpaceCutoff_;
+   }
+
+   /*
+   * Modify a parameter, identified by a string.
+   */
+   void EwaldInteraction::set(std::string name, double value)
+   {
+      if (name == "epsilon") {
+         epsilon_ = value;
+      } else
+      if (name == "alpha") {
+         alpha_ = value;
+      } else
+      if (name == "rSpaceCutoff") {
+         rSpaceCutoff_ = value;
+      } else {
+         UTIL_THROW("Unrecognized parameter name");
+      }
+      initialize();
+   }
+
+   /*
+   * Get a parameter value, identified by a string.
+   */
+   double EwaldInteraction::get(std::string name) const
+   {
+      double value = 0.0;
+      if (name == "epsilon") {
+         value = epsilon_;
+      } else
+      if (name == "alpha") {
+         value = alpha_;
+      } else
+      if (name == "rSpaceCutoff") {
+         value = rSpaceCutoff_;
+      } else {
+         UTIL_THROW("Unrecognized parameter name");
+      }
+      return value;
+   }
+
+   /*
+   * Self energy of all charges.
+   */
+   double EwaldInteraction::selfEnergy(double chargeSqSum) const
+   {  return -prefactor_*alpha_*chargeSqSum/sqrt(Constants::Pi); }
+
+   /*
+   * Energy of neutralizing background.
+   */
+   double
+   EwaldInteraction::backgroundEnergy(double chargeSum, double volume) const
+   {  return -chargeSum*chargeSum/(8.0*volume*epsilon_*alphaSq_); }
+
+   /*
+   * Compute derived constants (private).
+   */
+   void EwaldInteraction::initialize()
+   {
+      if (epsilon_ <= 0.0) {
+         UTIL_THROW("Dielectric permittivity epsilon <= 0");
+      }
+      if (alpha_ <= 0.0) {
+         UTIL_THROW("Ewald parameter alpha <= 0");
+      }
+      if (rSpaceCutoff_ <= 0.0) {
+         UTIL_THROW("Real space cutoff <= 0");
+      }
+      rSpaceCutoffSq_ = rSpaceCutoff_*rSpaceCutoff_;
+      prefactor_ = 1.0/(4.0*Constants::Pi*epsilon_);
+      alphaSq_ = alpha_*alpha_;
+      twoAlphaOverSqrtPi_ = 2.0*alpha_/sqrt(Constants::Pi);
+      isInitialized_ = true;
+   }
+
+}
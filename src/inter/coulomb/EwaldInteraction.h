@@ -0,0 +1,280 @@
+#ifndef INTER_EWALD_INTERACTION_H
+#define INTER_EWALD_INTERACTION_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>
+#include <util/global.h>
+
+#include <math.h>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /**
+   * Ewald splitting of the Coulomb interaction.
+   *
+   * The Coulomb energy of a pair of charges qi and qj separated by a
+   * distance r is qi*qj/(4 pi epsilon r), in which epsilon is the
+   * dielectric permittivity. The Ewald method splits 1/r into a short
+   * range part erfc(alpha r)/r, which is summed in real space up to a
+   * cutoff rSpaceCutoff, and a long range part erf(alpha r)/r, which
+   * is summed in Fourier (k) space. This class holds the parameters
+   * epsilon, alpha and rSpaceCutoff, and provides the real space pair
+   * functions, the Fourier space Green's function, and the self and
+   * neutralizing background energies shared by all k-space solvers.
+   *
+   * The complementary error function is evaluated with the rational
+   * approximation of Abramowitz and Stegun (Eq. 7.1.26), which has a
+   * maximum absolute error of 1.5E-7 and shares one exponential with
+   * the force. The real space energy is not shifted at the cutoff.
+   *
+   * \sa \ref inter_coulomb_EwaldInteraction_page
+   *
+   * \ingroup Inter_Coulomb_Module
+   */
+   class EwaldInteraction : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      EwaldInteraction();
+
+      /**
+      * Copy constructor.
+      *
+      * \param other EwaldInteraction to be copied
+      */
+      EwaldInteraction(const EwaldInteraction& other);
+
+      /**
+      * Assignment.
+      *
+      * \param other EwaldInteraction to be assigned.
+      */
+      EwaldInteraction& operator = (const EwaldInteraction& other);
+
+      /// \name Mutators
+      //@{
+
+      /**
+      * Read epsilon, alpha and rSpaceCutoff.
+      *
+      * \param in  input parameter stream
+      */
+      void readParameters(std::istream &in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Modify a parameter, identified by a string.
+      *
+      * \param name  parameter name (epsilon, alpha or rSpaceCutoff)
+      * \param value new value of parameter
+      */
+      void set(std::string name, double value);
+
+      //@}
+      /// \name Pair and k-space functions
+      //@{
+
+      /**
+      * Real space pair energy, for rsq < rSpaceCutoffSq().
+      *
+      * \param rsq      square of distance between charges
+      * \param qProduct product of the two charges
+      */
+      double rSpaceEnergy(double rsq, double qProduct) const;
+
+      /**
+      * Real space force divided by distance, for rsq < rSpaceCutoffSq().
+      *
+      * A positive value represents a repulsive force.
+      *
+      * \param rsq      square of distance between charges
+      * \param qProduct product of the two charges
+      */
+      double rSpaceForceOverR(double rsq, double qProduct) const;
+
+      /**
+      * Fourier space Green's function exp(-k^2/4 alpha^2)/(epsilon k^2).
+      *
+      * The k-space energy of a periodic system of volume V is given by
+      * a sum (1/2V) sum_k kSpacePotential(k^2) |S(k)|^2 over nonzero
+      * wavevectors k, where S(k) = sum_i q_i exp(i k.r_i).
+      *
+      * \param kSq square of wavevector magnitude (must be nonzero)
+      */
+      double kSpacePotential(double kSq) const;
+
+      /**
+      * Self energy -alpha/(4 pi^(3/2) epsilon) sum_i q_i^2.
+      *
+      * \param chargeSqSum sum of squares of all charges
+      */
+      double selfEnergy(double chargeSqSum) const;
+
+      /**
+      * Energy of a uniform neutralizing background, -Q^2/(8 V epsilon alpha^2).
+      *
+      * This energy is zero for a neutral system. The corresponding
+      * contribution to the stress tensor is isotropic, and equal to
+      * the background energy divided by the volume.
+      *
+      * \param chargeSum total charge Q
+      * \param volume    system volume V
+      */
+      double backgroundEnergy(double chargeSum, double volume) const;
+
+      //@}
+      /// \name Accessors
+      //@{
+
+      /**
+      * Get dielectric permittivity epsilon.
+      */
+      double epsilon() const;
+
+      /**
+      * Get Ewald splitting parameter alpha (inverse length).
+      */
+      double alpha() const;
+
+      /**
+      * Get real space cutoff distance.
+      */
+      double rSpaceCutoff() const;
+
+      /**
+      * Get square of real space cutoff distance.
+      */
+      double rSpaceCutoffSq() const;
+
+      /**
+      * Get a parameter value, identified by a string.
+      *
+      * \param name  parameter name (epsilon, alpha or rSpaceCutoff)
+      */
+      double get(std::string name) const;
+
+      //@}
+
+   private:
+
+      /// Dielectric permittivity.
+      double epsilon_;
+
+      /// Ewald splitting parameter (inverse length).
+      double alpha_;
+
+      /// Real space cutoff distance.
+      double rSpaceCutoff_;
+
+      /// Square of rSpaceCutoff_.
+      double rSpaceCutoffSq_;
+
+      /// Coulomb prefactor 1/(4 pi epsilon).
+      double prefactor_;
+
+      /// Square of alpha_.
+      double alphaSq_;
+
+      /// 2 alpha/sqrt(pi).
+      double twoAlphaOverSqrtPi_;
+
+      /// Was this object initialized by calling (read|load)Parameters ?
+      bool  isInitialized_;
+
+      /*
+      * Compute derived constants from epsilon_, alpha_ and rSpaceCutoff_.
+      */
+      void initialize();
+
+   };
+
+   // Inline methods
+
+   /*
+   * Real space pair energy.
+   */
+   inline
+   double EwaldInteraction::rSpaceEnergy(double rsq, double qProduct) const
+   {
+      double r = sqrt(rsq);
+      double x = alpha_*r;
+      double t = 1.0/(1.0 + 0.3275911*x);
+      double erfcx = t*(0.254829592 + t*(-0.284496736 + t*(1.421413741
+                     + t*(-1.453152027 + t*1.061405429))))*exp(-x*x);
+      return prefactor_*qProduct*erfcx/r;
+   }
+
+   /*
+   * Real space force divided by distance.
+   */
+   inline
+   double EwaldInteraction::rSpaceForceOverR(double rsq, double qProduct)
+   const
+   {
+      double r = sqrt(rsq);
+      double x = alpha_*r;
+      double expx = exp(-x*x);
+      double t = 1.0/(1.0 + 0.3275911*x);
+      double erfcx = t*(0.254829592 + t*(-0.284496736 + t*(1.421413741
+                     + t*(-1.453152027 + t*1.061405429))))*expx;
+      return prefactor_*qProduct*(erfcx/r + twoAlphaOverSqrtPi_*expx)/rsq;
+   }
+
+   /*
+   * Fourier space Green's function.
+   */
+   inline double EwaldInteraction::kSpacePotential(double kSq) const
+   {  return exp(-0.25*kSq/alphaSq_)/(epsilon_*kSq); }
+
+   /*
+   * Get dielectric permittivity.
+   */
+   inline double EwaldInteraction::epsilon() const
+   {  return epsilon_; }
+
+   /*
+   * Get Ewald splitting parameter.
+   */
+   inline double EwaldInteraction::alpha() const
+   {  return alpha_; }
+
+   /*
+   * Get real space cutoff.
+   */
+   inline double EwaldInteraction::rSpaceCutoff() const
+   {  return rSpaceCutoff_; }
+
+   /*
+   * Get square of real space cutoff.
+   */
+   inline double EwaldInteraction::rSpaceCutoffSq() const
+   {  return rSpaceCutoffSq_; }
+
+}
+#endif
@@ -0,0 +1,192 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "EwaldKSpace.h"
+#include "EwaldInteraction.h"
+#include <util/space/IntVector.h>
+#include <util/math/Constants.h>
+
+#include <math.h>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   EwaldKSpace::EwaldKSpace()
+    : waves_(),
+      weights_(),
+      stressFactors_(),
+      structure_(),
+      lengths_(0.0),
+      stress_(),
+      kSpaceCutoff_(0.0),
+      alpha_(0.0),
+      epsilon_(0.0),
+      energy_(0.0)
+   {
+      setClassName("EwaldKSpace");
+      stress_.zero();
+   }
+
+   /*
+   * Destructor.
+   */
+   EwaldKSpace::~EwaldKSpace()
+   {}
+
+   /*
+   * Read parameters from file.
+   */
+   void EwaldKSpace::readParameters(std::istream &in)
+   {
+      read<double>(in, "kSpaceCutoff", kSpaceCutoff_);
+      if (kSpaceCutoff_ <= 0.0) {
+         UTIL_THROW("kSpaceCutoff <= 0");
+      }
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void EwaldKSpace::loadParameters(Serializable::IArchive &ar)
+   {  loadParameter<double>(ar, "kSpaceCutoff", kSpaceCutoff_); }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void EwaldKSpace::save(Serializable::OArchive &ar)
+   {  ar << kSpaceCutoff_; }
+
+   /*
+   * Construct list of wavevectors, if necessary.
+   */
+   void EwaldKSpace::setup(const Boundary& boundary,
+                           const EwaldInteraction& ewald)
+   {
+      const Vector& lengths = boundary.lengths();
+      if (lengths == lengths_ && ewald.alpha() == alpha_
+          && ewald.epsilon() == epsilon_) {
+         return;
+      }
+      lengths_ = lengths;
+      alpha_ = ewald.alpha();
+      epsilon_ = ewald.epsilon();
+
+      Vector unit, k;
+      IntVector maxIndex;
+      double kcSq = kSpaceCutoff_*kSpaceCutoff_;
+      double volume = lengths[0]*lengths[1]*lengths[2];
+      double kSq;
+      int i, m0, m1, m2;
+      for (i = 0; i < Dimension; ++i) {
+         unit[i] = 2.0*Constants::Pi/lengths[i];
+         maxIndex[i] = int(kSpaceCutoff_/unit[i]);
+      }
+
+      // Wavevectors with m0 > 0, or m0 == 0 and m1 > 0, or m0 == m1 == 0
+      // and m2 > 0, which include exactly one of each pair (k, -k).
+      waves_.clear();
+      weights_.clear();
+      stressFactors_.clear();
+      for (m0 = 0; m0 <= maxIndex[0]; ++m0) {
+         k[0] = m0*unit[0];
+         for (m1 = -maxIndex[1]; m1 <= maxIndex[1]; ++m1) {
+            if (m0 == 0 && m1 < 0) continue;
+            k[1] = m1*unit[1];
+            for (m2 = -maxIndex[2]; m2 <= maxIndex[2]; ++m2) {
+               if (m0 == 0 && m1 == 0 && m2 <= 0) continue;
+               k[2] = m2*unit[2];
+               kSq = k.square();
+               if (kSq < kcSq) {
+                  waves_.append(k);
+                  weights_.append(ewald.kSpacePotential(kSq)/volume);
+                  stressFactors_.append(2.0*(1.0/kSq + 0.25/(alpha_*alpha_)));
+               }
+            }
+         }
+      }
+      if (waves_.size() == 0) {
+         UTIL_THROW("No wavevectors with magnitude less than kSpaceCutoff");
+      }
+      structure_.resize(2*waves_.size());
+   }
+
+   /*
+   * Zero structure factor accumulator.
+   */
+   void EwaldKSpace::clear()
+   {
+      int n = structure_.size();
+      for (int i = 0; i < n; ++i) {
+         structure_[i] = 0.0;
+      }
+   }
+
+   /*
+   * Add a charge to the structure factor.
+   */
+   void EwaldKSpace::addCharge(const Vector& position, double charge)
+   {
+      double phase;
+      int n = waves_.size();
+      for (int i = 0; i < n; ++i) {
+         phase = waves_[i].dot(position);
+         structure_[2*i] += charge*cos(phase);
+         structure_[2*i+1] += charge*sin(phase);
+      }
+   }
+
+   /*
+   * Compute energy and stress.
+   */
+   void EwaldKSpace::solve()
+   {
+      double e, factor;
+      int n = waves_.size();
+      int i, a, b;
+      energy_ = 0.0;
+      stress_.zero();
+      for (i = 0; i < n; ++i) {
+         const Vector& k = waves_[i];
+         e = weights_[i]*(structure_[2*i]*structure_[2*i]
+                          + structure_[2*i+1]*structure_[2*i+1]);
+         energy_ += e;
+         factor = stressFactors_[i];
+         for (a = 0; a < Dimension; ++a) {
+            stress_(a, a) += e;
+            for (b = 0; b < Dimension; ++b) {
+               stress_(a, b) -= e*factor*k[a]*k[b];
+            }
+         }
+      }
+      stress_ /= lengths_[0]*lengths_[1]*lengths_[2];
+   }
+
+   /*
+   * Add k-space force on one charge.
+   */
+   void EwaldKSpace::addForce(const Vector& position, double charge,
+                              Vector& force) const
+   {
+      double phase, f;
+      int n = waves_.size();
+      for (int i = 0; i < n; ++i) {
+         const Vector& k = waves_[i];
+         phase = k.dot(position);
+         f = sin(phase)*structure_[2*i] - cos(phase)*structure_[2*i+1];
+         f *= 2.0*charge*weights_[i];
+         force[0] += f*k[0];
+         force[1] += f*k[1];
+         force[2] += f*k[2];
+      }
+   }
+
+}
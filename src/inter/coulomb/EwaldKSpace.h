@@ -0,0 +1,224 @@
+#ifndef INTER_EWALD_K_SPACE_H
+#define INTER_EWALD_K_SPACE_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>
+#include <util/boundary/Boundary.h>
+#include <util/containers/GArray.h>
+#include <util/space/Vector.h>
+#include <util/space/Tensor.h>
+#include <util/global.h>
+
+namespace Inter
+{
+
+   class EwaldInteraction;
+
+   using namespace Util;
+
+   /**
+   * Reference Ewald sum for the k-space part of the Coulomb energy.
+   *
+   * EwaldKSpace computes the long range part of the Ewald sum directly,
+   * by summing over all wavevectors k with magnitude less than a cutoff
+   * kSpaceCutoff. The cost is proportional to the product of the number
+   * of charges and the number of wavevectors, so this class is intended
+   * mainly as a reference for testing SpmeKSpace, and for small systems.
+   *
+   * Only wavevectors in one half of k-space are stored, since the terms
+   * for k and -k are equal. The structure factor S(k) = sum_i q_i
+   * exp(i k.r_i) for these wavevectors is stored in an accumulator array
+   * of real and imaginary parts, which may be summed over processors
+   * between calls to addCharge() and solve().
+   *
+   * Usage, for each force or energy evaluation:
+   * \code
+   * kSpace.setup(boundary, ewald);
+   * kSpace.clear();
+   * for (each charge) kSpace.addCharge(position, charge);
+   * // (sum accumulator() over processors if parallel)
+   * kSpace.solve();
+   * for (each charge) kSpace.addForce(position, charge, force);
+   * \endcode
+   * The k-space energy and stress are available after solve(). They
+   * do not include the self energy or the background energy defined by
+   * EwaldInteraction.
+   *
+   * \sa \ref inter_coulomb_EwaldKSpace_page
+   *
+   * \ingroup Inter_Coulomb_Module
+   */
+   class EwaldKSpace : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      EwaldKSpace();
+
+      /**
+      * Destructor.
+      */
+      virtual ~EwaldKSpace();
+
+      /**
+      * Read kSpaceCutoff.
+      *
+      * \param in  input parameter stream
+      */
+      void readParameters(std::istream &in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Prepare for a calculation with the current boundary.
+      *
+      * The list of wavevectors and their weights are recomputed only
+      * if the boundary or the Ewald parameters have changed.
+      *
+      * \param boundary current periodic boundary
+      * \param ewald    Ewald parameters
+      */
+      void setup(const Boundary& boundary, const EwaldInteraction& ewald);
+
+      /**
+      * Zero the structure factor accumulator.
+      */
+      void clear();
+
+      /**
+      * Add a point charge to the structure factor.
+      *
+      * \param position Cartesian position
+      * \param charge   charge
+      */
+      void addCharge(const Vector& position, double charge);
+
+      /**
+      * Get pointer to the structure factor accumulator.
+      */
+      double* accumulator();
+
+      /**
+      * Get number of elements in the structure factor accumulator.
+      */
+      int accumulatorSize() const;
+
+      /**
+      * Compute energy and stress from the accumulated structure factor.
+      */
+      void solve();
+
+      /**
+      * Add k-space force on a charge to a force vector.
+      *
+      * \param position Cartesian position
+      * \param charge   charge
+      * \param force    force vector (incremented)
+      */
+      void addForce(const Vector& position, double charge, Vector& force)
+      const;
+
+      /**
+      * Get k-space energy (valid after solve).
+      */
+      double energy() const;
+
+      /**
+      * Get k-space stress tensor (valid after solve).
+      */
+      const Tensor& stress() const;
+
+      /**
+      * Get number of wavevectors in one half of k-space.
+      */
+      int nWave() const;
+
+   private:
+
+      /// Wavevectors in one half of k-space.
+      GArray<Vector> waves_;
+
+      /// Weight kSpacePotential(k^2)/V for each wavevector.
+      GArray<double> weights_;
+
+      /// Stress factor 2(1/k^2 + 1/(4 alpha^2)) for each wavevector.
+      GArray<double> stressFactors_;
+
+      /// Real and imaginary parts of S(k) for each wavevector.
+      GArray<double> structure_;
+
+      /// Boundary lengths used to construct waves_.
+      Vector lengths_;
+
+      /// Stress tensor.
+      Tensor stress_;
+
+      /// Wavevector magnitude cutoff.
+      double kSpaceCutoff_;
+
+      /// Ewald alpha used to construct weights_.
+      double alpha_;
+
+      /// Dielectric permittivity used to construct weights_.
+      double epsilon_;
+
+      /// Energy.
+      double energy_;
+
+   };
+
+   // Inline methods
+
+   /*
+   * Get pointer to accumulator.
+   */
+   inline double* EwaldKSpace::accumulator()
+   {  return &structure_[0]; }
+
+   /*
+   * Get number of elements in accumulator.
+   */
+   inline int EwaldKSpace::accumulatorSize() const
+   {  return structure_.size(); }
+
+   /*
+   * Get energy.
+   */
+   inline double EwaldKSpace::energy() const
+   {  return energy_; }
+
+   /*
+   * Get stress.
+   */
+   inline const Tensor& EwaldKSpace::stress() const
+   {  return stress_; }
+
+   /*
+   * Get number of wavevectors.
+   */
+   inline int EwaldKSpace::nWave() const
+   {  return waves_.size(); }
+
+}
+#endif
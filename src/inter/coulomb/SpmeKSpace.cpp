@@ -0,0 +1,325 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "SpmeKSpace.h"
+#include "EwaldInteraction.h"
+#include <util/math/Constants.h>
+#include <util/math/bSpline.h>
+
+#include <math.h>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   SpmeKSpace::SpmeKSpace()
+    : fft_(),
+      charges_(),
+      mesh_(),
+      influence_(),
+      moduli_(),
+      gridDimensions_(0),
+      lengths_(0.0),
+      stress_(),
+      alpha_(0.0),
+      epsilon_(0.0),
+      energy_(0.0),
+      order_(4)
+   {
+      setClassName("SpmeKSpace");
+      stress_.zero();
+   }
+
+   /*
+   * Destructor.
+   */
+   SpmeKSpace::~SpmeKSpace()
+   {}
+
+   /*
+   * Read parameters from file and allocate mesh.
+   */
+   void SpmeKSpace::readParameters(std::istream &in)
+   {
+      read<IntVector>(in, "gridDimensions", gridDimensions_);
+      read<int>(in, "order", order_);
+      allocate();
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void SpmeKSpace::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<IntVector>(ar, "gridDimensions", gridDimensions_);
+      loadParameter<int>(ar, "order", order_);
+      allocate();
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void SpmeKSpace::save(Serializable::OArchive &ar)
+   {
+      ar << gridDimensions_;
+      ar << order_;
+   }
+
+   /*
+   * Allocate arrays and compute B-spline moduli (private).
+   */
+   void SpmeKSpace::allocate()
+   {
+      if (order_ < 2 || order_ > MaxOrder || order_ % 2 != 0) {
+         UTIL_THROW("SPME order must be even, and 2 <= order <= 12");
+      }
+      int i;
+      for (i = 0; i < Dimension; ++i) {
+         if (gridDimensions_[i] < order_) {
+            UTIL_THROW("SPME grid dimension less than B-spline order");
+         }
+      }
+      fft_.setup(gridDimensions_);
+      int size = fft_.size();
+      charges_.allocate(size);
+      mesh_.allocate(size);
+      influence_.allocate(size);
+
+      // Compute B-spline moduli |b(m)|^2 = 1/|sum_k M_p(k+1) e^{2 pi imk/K}|^2
+      double w[MaxOrder];
+      double dw[MaxOrder];
+      bSpline(0.0, order_, w, dw);
+      double arg, re, im;
+      int n, m, k;
+      n = 0;
+      for (i = 0; i < Dimension; ++i) {
+         if (gridDimensions_[i] > n) n = gridDimensions_[i];
+      }
+      moduli_.allocate(Dimension, n);
+      for (i = 0; i < Dimension; ++i) {
+         n = gridDimensions_[i];
+         for (m = 0; m < n; ++m) {
+            re = 0.0;
+            im = 0.0;
+            for (k = 0; k < order_ - 1; ++k) {
+               arg = 2.0*Constants::Pi*double(m*k)/double(n);
+               re += w[k+1]*cos(arg);
+               im += w[k+1]*sin(arg);
+            }
+            moduli_(i, m) = 1.0/(re*re + im*im);
+         }
+      }
+
+      // Force recomputation of influence function by setup()
+      lengths_ = Vector(0.0);
+   }
+
+   /*
+   * Compute influence function, if necessary.
+   */
+   void SpmeKSpace::setup(const Boundary& boundary,
+                          const EwaldInteraction& ewald)
+   {
+      if (fft_.size() == 0) {
+         UTIL_THROW("SpmeKSpace not initialized");
+      }
+      const Vector& lengths = boundary.lengths();
+      if (lengths == lengths_ && ewald.alpha() == alpha_
+          && ewald.epsilon() == epsilon_) {
+         return;
+      }
+      lengths_ = lengths;
+      alpha_ = ewald.alpha();
+      epsilon_ = ewald.epsilon();
+
+      const int n0 = gridDimensions_[0];
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+      double volume = lengths[0]*lengths[1]*lengths[2];
+      Vector unit, k;
+      double b0, b01;
+      int i, i0, i1, i2;
+      for (i = 0; i < Dimension; ++i) {
+         unit[i] = 2.0*Constants::Pi/lengths[i];
+      }
+      i = 0;
+      for (i0 = 0; i0 < n0; ++i0) {
+         k[0] = unit[0]*double(2*i0 <= n0 ? i0 : i0 - n0);
+         b0 = moduli_(0, i0)/volume;
+         for (i1 = 0; i1 < n1; ++i1) {
+            k[1] = unit[1]*double(2*i1 <= n1 ? i1 : i1 - n1);
+            b01 = b0*moduli_(1, i1);
+            for (i2 = 0; i2 < n2; ++i2) {
+               k[2] = unit[2]*double(2*i2 <= n2 ? i2 : i2 - n2);
+               if (i == 0) {
+                  influence_[i] = 0.0;
+               } else {
+                  influence_[i] = b01*moduli_(2, i2)
+                                * ewald.kSpacePotential(k.square());
+               }
+               ++i;
+            }
+         }
+      }
+   }
+
+   /*
+   * Zero the charge mesh.
+   */
+   void SpmeKSpace::clear()
+   {
+      int n = charges_.capacity();
+      for (int i = 0; i < n; ++i) {
+         charges_[i] = 0.0;
+      }
+   }
+
+   /*
+   * Compute B-spline weights and grid indices along one axis (private).
+   */
+   void SpmeKSpace::weights(double x, int axis, double* w, double* dw,
+                            int* index) const
+   {
+      const int n = gridDimensions_[axis];
+      double u = double(n)*x/lengths_[axis];
+      u -= double(n)*floor(u/double(n));
+      int iu = int(u);
+      if (iu >= n) {
+         iu -= n;
+         u -= double(n);
+      }
+      bSpline(u - double(iu), order_, w, dw);
+      for (int j = 0; j < order_; ++j) {
+         index[j] = iu - j < 0 ? iu - j + n : iu - j;
+      }
+   }
+
+   /*
+   * Spread a charge onto the mesh.
+   */
+   void SpmeKSpace::addCharge(const Vector& position, double charge)
+   {
+      double w[Dimension][MaxOrder];
+      double dw[Dimension][MaxOrder];
+      int index[Dimension][MaxOrder];
+      for (int i = 0; i < Dimension; ++i) {
+         weights(position[i], i, w[i], dw[i], index[i]);
+      }
+
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+      double q0, q01;
+      int j0, j1, j2, k0, k01;
+      for (j0 = 0; j0 < order_; ++j0) {
+         q0 = charge*w[0][j0];
+         k0 = index[0][j0]*n1;
+         for (j1 = 0; j1 < order_; ++j1) {
+            q01 = q0*w[1][j1];
+            k01 = (k0 + index[1][j1])*n2;
+            for (j2 = 0; j2 < order_; ++j2) {
+               charges_[k01 + index[2][j2]] += q01*w[2][j2];
+            }
+         }
+      }
+   }
+
+   /*
+   * Compute energy, stress and mesh potential.
+   */
+   void SpmeKSpace::solve()
+   {
+      const int n0 = gridDimensions_[0];
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+      const int size = fft_.size();
+      int i, i0, i1, i2, a, b;
+      for (i = 0; i < size; ++i) {
+         mesh_[i] = std::complex<double>(charges_[i], 0.0);
+      }
+      fft_.forward(mesh_);
+
+      // Energy and stress, then multiply by influence function
+      Vector unit, k;
+      double e, factor;
+      double alphaFactor = 0.25/(alpha_*alpha_);
+      for (a = 0; a < Dimension; ++a) {
+         unit[a] = 2.0*Constants::Pi/lengths_[a];
+      }
+      energy_ = 0.0;
+      stress_.zero();
+      i = 0;
+      for (i0 = 0; i0 < n0; ++i0) {
+         k[0] = unit[0]*double(2*i0 <= n0 ? i0 : i0 - n0);
+         for (i1 = 0; i1 < n1; ++i1) {
+            k[1] = unit[1]*double(2*i1 <= n1 ? i1 : i1 - n1);
+            for (i2 = 0; i2 < n2; ++i2) {
+               if (i > 0) {
+                  k[2] = unit[2]*double(2*i2 <= n2 ? i2 : i2 - n2);
+                  e = 0.5*influence_[i]*std::norm(mesh_[i]);
+                  energy_ += e;
+                  factor = 2.0*(1.0/k.square() + alphaFactor);
+                  for (a = 0; a < Dimension; ++a) {
+                     stress_(a, a) += e;
+                     for (b = 0; b < Dimension; ++b) {
+                        stress_(a, b) -= e*factor*k[a]*k[b];
+                     }
+                  }
+               }
+               mesh_[i] *= influence_[i];
+               ++i;
+            }
+         }
+      }
+      stress_ /= lengths_[0]*lengths_[1]*lengths_[2];
+
+      // Mesh potential (real part of inverse transform)
+      fft_.inverse(mesh_);
+   }
+
+   /*
+   * Add k-space force on one charge.
+   */
+   void SpmeKSpace::addForce(const Vector& position, double charge,
+                             Vector& force) const
+   {
+      double w[Dimension][MaxOrder];
+      double dw[Dimension][MaxOrder];
+      int index[Dimension][MaxOrder];
+      for (int i = 0; i < Dimension; ++i) {
+         weights(position[i], i, w[i], dw[i], index[i]);
+      }
+
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+      Vector grad(0.0);
+      double phi, w01, dw0w1, w0dw1;
+      int j0, j1, j2, k0, k01;
+      for (j0 = 0; j0 < order_; ++j0) {
+         k0 = index[0][j0]*n1;
+         for (j1 = 0; j1 < order_; ++j1) {
+            k01 = (k0 + index[1][j1])*n2;
+            w01 = w[0][j0]*w[1][j1];
+            dw0w1 = dw[0][j0]*w[1][j1];
+            w0dw1 = w[0][j0]*dw[1][j1];
+            for (j2 = 0; j2 < order_; ++j2) {
+               phi = mesh_[k01 + index[2][j2]].real();
+               grad[0] += phi*dw0w1*w[2][j2];
+               grad[1] += phi*w0dw1*w[2][j2];
+               grad[2] += phi*w01*dw[2][j2];
+            }
+         }
+      }
+      for (int i = 0; i < Dimension; ++i) {
+         force[i] -= charge*grad[i]*double(gridDimensions_[i])/lengths_[i];
+      }
+   }
+
+}
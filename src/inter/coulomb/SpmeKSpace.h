@@ -0,0 +1,250 @@
+#ifndef INTER_SPME_K_SPACE_H
+#define INTER_SPME_K_SPACE_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>
+#include <util/boundary/Boundary.h>
+#include <util/containers/DArray.h>
+#include <util/containers/DMatrix.h>
+#include <util/math/Fft.h>
+#include <util/space/Vector.h>
+#include <util/space/IntVector.h>
+#include <util/space/Tensor.h>
+#include <util/global.h>
+
+#include <complex>
+
+namespace Inter
+{
+
+   class EwaldInteraction;
+
+   using namespace Util;
+
+   /**
+   * Smooth particle mesh Ewald (SPME) solver for the k-space energy.
+   *
+   * SpmeKSpace computes the long range part of the Ewald sum by the
+   * smooth particle mesh Ewald method of Essmann et al. (J. Chem. Phys.
+   * 103, 8577, 1995). Charges are spread onto a regular mesh with
+   * cardinal B-splines of a specified order, the mesh is Fourier
+   * transformed with Util::Fft, multiplied by the Ewald Green's function
+   * and the B-spline moduli, and transformed back to obtain a mesh
+   * potential from which forces are interpolated with the derivatives
+   * of the same B-splines. Each mesh dimension must be a power of two.
+   *
+   * The charge mesh is stored in an accumulator array of real values,
+   * which may be summed over processors between calls to addCharge()
+   * and solve(). The interface is otherwise identical to that of
+   * EwaldKSpace, and the two classes may be used interchangeably as
+   * the KSpace template argument of a CoulombPotentialImpl.
+   *
+   * \sa \ref inter_coulomb_SpmeKSpace_page
+   *
+   * \ingroup Inter_Coulomb_Module
+   */
+   class SpmeKSpace : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      SpmeKSpace();
+
+      /**
+      * Destructor.
+      */
+      virtual ~SpmeKSpace();
+
+      /**
+      * Read gridDimensions and order.
+      *
+      * \param in  input parameter stream
+      */
+      void readParameters(std::istream &in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Prepare for a calculation with the current boundary.
+      *
+      * The influence function is recomputed only if the boundary or the
+      * Ewald parameters have changed.
+      *
+      * \param boundary current periodic boundary
+      * \param ewald    Ewald parameters
+      */
+      void setup(const Boundary& boundary, const EwaldInteraction& ewald);
+
+      /**
+      * Zero the charge mesh.
+      */
+      void clear();
+
+      /**
+      * Spread a point charge onto the charge mesh.
+      *
+      * \param position Cartesian position
+      * \param charge   charge
+      */
+      void addCharge(const Vector& position, double charge);
+
+      /**
+      * Get pointer to the charge mesh accumulator.
+      */
+      double* accumulator();
+
+      /**
+      * Get number of elements in the charge mesh accumulator.
+      */
+      int accumulatorSize() const;
+
+      /**
+      * Compute energy, stress and mesh potential from the charge mesh.
+      */
+      void solve();
+
+      /**
+      * Add k-space force on a charge to a force vector.
+      *
+      * \param position Cartesian position
+      * \param charge   charge
+      * \param force    force vector (incremented)
+      */
+      void addForce(const Vector& position, double charge, Vector& force)
+      const;
+
+      /**
+      * Get k-space energy (valid after solve).
+      */
+      double energy() const;
+
+      /**
+      * Get k-space stress tensor (valid after solve).
+      */
+      const Tensor& stress() const;
+
+      /**
+      * Get mesh dimensions.
+      */
+      const IntVector& gridDimensions() const;
+
+      /**
+      * Get B-spline interpolation order.
+      */
+      int order() const;
+
+   private:
+
+      /// Maximum allowed B-spline order.
+      static const int MaxOrder = 12;
+
+      /// Fast Fourier transform.
+      Fft fft_;
+
+      /// Real charge mesh (accumulator).
+      DArray<double> charges_;
+
+      /// Complex mesh for Fourier transform and mesh potential.
+      DArray< std::complex<double> > mesh_;
+
+      /// Green's function times B-spline moduli, divided by volume.
+      DArray<double> influence_;
+
+      /// B-spline moduli |b(m)|^2, moduli_(axis, m).
+      DMatrix<double> moduli_;
+
+      /// Number of grid points along each axis.
+      IntVector gridDimensions_;
+
+      /// Boundary lengths used to construct influence_.
+      Vector lengths_;
+
+      /// Stress tensor.
+      Tensor stress_;
+
+      /// Ewald alpha used to construct influence_.
+      double alpha_;
+
+      /// Dielectric permittivity used to construct influence_.
+      double epsilon_;
+
+      /// Energy.
+      double energy_;
+
+      /// B-spline order.
+      int order_;
+
+      /*
+      * Allocate arrays and compute B-spline moduli.
+      */
+      void allocate();
+
+      /*
+      * Compute B-spline weights and grid indices along one axis.
+      */
+      void weights(double x, int axis, double* w, double* dw, int* index)
+      const;
+
+   };
+
+   // Inline methods
+
+   /*
+   * Get pointer to accumulator.
+   */
+   inline double* SpmeKSpace::accumulator()
+   {  return &charges_[0]; }
+
+   /*
+   * Get number of elements in accumulator.
+   */
+   inline int SpmeKSpace::accumulatorSize() const
+   {  return charges_.capacity(); }
+
+   /*
+   * Get energy.
+   */
+   inline double SpmeKSpace::energy() const
+   {  return energy_; }
+
+   /*
+   * Get stress.
+   */
+   inline const Tensor& SpmeKSpace::stress() const
+   {  return stress_; }
+
+   /*
+   * Get mesh dimensions.
+   */
+   inline const IntVector& SpmeKSpace::gridDimensions() const
+   {  return gridDimensions_; }
+
+   /*
+   * Get B-spline order.
+   */
+   inline int SpmeKSpace::order() const
+   {  return order_; }
+
+}
+#endif
@@ -0,0 +1,13 @@
+namespace Inter
+{
+
+   /**
+   * \defgroup Inter_Coulomb_Module Coulomb Interactions
+   * \ingroup  Inter_Module
+   *
+   * \sa       \ref inter_coulomb_page
+   *
+   * \brief    Ewald real space and k-space Coulomb interactions.
+   */
+
+}
@@ -0,0 +1,10 @@
+inter_coulomb_=\
+    inter/coulomb/EwaldInteraction.cpp \
+    inter/coulomb/EwaldKSpace.cpp \
+    inter/coulomb/SpmeKSpace.cpp
+
+inter_coulomb_SRCS=\
+     $(addprefix $(SRC_DIR)/, $(inter_coulomb_))
+inter_coulomb_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(inter_coulomb_:.cpp=.o))
+
@@ -242,11 +242,9 @@ namespace Inter
    */
    inline double DpdPair::forceOverR(double rsq, int i, int j) const
    {
-      if (rsq < sigmaSq_[i][j]) {
-         return cf_[i][j]*(sigma_[i][j]/sqrt(rsq) - 1.0);
-      } else {
-         return 0.0;
-      }
+      // Select rather than branch, so loops over pairs can vectorize
+      double f = cf_[i][j]*(sigma_[i][j]/sqrt(rsq) - 1.0);
+      return (rsq < sigmaSq_[i][j]) ? f : 0.0;
    }
 
    /* 
@@ -148,7 +148,7 @@ namespace Inter
       if (j != i) {
          sigma_[j][i]   = sigma_[i][j];
          sigmaSq_[j][i] = sigmaSq_[i][j];
-         ljShift_[j][i] = ljShift_[j][i];
+         ljShift_[j][i] = ljShift_[i][j];
       }
 
    } 
@@ -293,7 +293,7 @@ namespace Inter
       r6i = r6i*r6i*r6i;
       ljShift_[i][j] = -4.0*epsilon_[i][j]*(r6i*r6i - r6i);
       if (j != i) {
-         ljShift_[j][i] = ljShift_[j][i];
+         ljShift_[j][i] = ljShift_[i][j];
       }
 
    }
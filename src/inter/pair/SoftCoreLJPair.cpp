@@ -0,0 +1,246 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "SoftCoreLJPair.h"
+#ifdef UTIL_MPI
+#include <util/mpi/MpiLoader.h>
+#endif
+
+#include <iostream>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   SoftCoreLJPair::SoftCoreLJPair()
+    : alpha_(0.5),
+      maxPairCutoff_(0.0),
+      nAtomType_(0),
+      isInitialized_(false)
+   {  setClassName("SoftCoreLJPair"); }
+
+   /*
+   * Set nAtomType
+   */
+   void SoftCoreLJPair::setNAtomType(int nAtomType)
+   {
+      if (nAtomType <= 0) {
+         UTIL_THROW("nAtomType <= 0");
+      }
+      if (nAtomType > MaxAtomType) {
+         UTIL_THROW("nAtomType > SoftCoreLJPair::MaxAtomType");
+      }
+      nAtomType_ = nAtomType;
+   }
+
+   /*
+   * Read potential parameters from file.
+   */
+   void SoftCoreLJPair::readParameters(std::istream &in)
+   {
+      if (nAtomType_ <= 0) {
+         UTIL_THROW( "nAtomType must be set before readParam");
+      }
+      readCArray2D<double> (in, "epsilon", epsilon_[0],
+                            nAtomType_, nAtomType_, MaxAtomType);
+      readCArray2D<double>(in, "sigma", sigma_[0],
+                           nAtomType_, nAtomType_, MaxAtomType);
+      readCArray2D<double>(in, "cutoff", cutoff_[0],
+                           nAtomType_, nAtomType_, MaxAtomType);
+      read<double>(in, "alpha", alpha_);
+      readCArray2D<double>(in, "lambda", lambda_[0],
+                           nAtomType_, nAtomType_, MaxAtomType);
+
+      maxPairCutoff_ = 0.0;
+      for (int i = 0; i < nAtomType_; ++i) {
+         for (int j = 0; j < nAtomType_; ++j) {
+            update(i, j);
+            if (cutoff_[i][j] > maxPairCutoff_) {
+               maxPairCutoff_ = cutoff_[i][j];
+            }
+         }
+      }
+      isInitialized_ = true;
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void SoftCoreLJPair::loadParameters(Serializable::IArchive &ar)
+   {
+      if (nAtomType_ <= 0) {
+         UTIL_THROW( "nAtomType must be set before readParam");
+      }
+      loadCArray2D<double>(ar, "epsilon", epsilon_[0],
+                           nAtomType_, nAtomType_, MaxAtomType);
+      loadCArray2D<double>(ar, "sigma", sigma_[0],
+                           nAtomType_, nAtomType_, MaxAtomType);
+      loadCArray2D<double>(ar, "cutoff", cutoff_[0],
+                           nAtomType_, nAtomType_, MaxAtomType);
+      loadParameter<double>(ar, "alpha", alpha_);
+      loadCArray2D<double>(ar, "lambda", lambda_[0],
+                           nAtomType_, nAtomType_, MaxAtomType);
+      #ifdef UTIL_MPI
+      MpiLoader<Serializable::IArchive> loader(*this, ar);
+      loader.load(maxPairCutoff_);
+      #else
+      ar >> maxPairCutoff_;
+      #endif
+      for (int i = 0; i < nAtomType_; ++i) {
+         for (int j = 0; j < nAtomType_; ++j) {
+            update(i, j);
+         }
+      }
+      isInitialized_ = true;
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void SoftCoreLJPair::save(Serializable::OArchive &ar)
+   {
+      ar.pack(epsilon_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar.pack(sigma_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar.pack(cutoff_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar << alpha_;
+      ar.pack(lambda_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar << maxPairCutoff_;
+   }
+
+   /*
+   * Compute derived quantities for pair (i, j), and symmetrize (private).
+   */
+   void SoftCoreLJPair::update(int i, int j)
+   {
+      sigmaSq_[i][j] = sigma_[i][j]*sigma_[i][j];
+      cutoffSq_[i][j] = cutoff_[i][j]*cutoff_[i][j];
+      double xc = cutoffSq_[i][j]/sigmaSq_[i][j];
+      xCut_[i][j] = xc*xc*xc;
+      if (j != i) {
+         epsilon_[j][i] = epsilon_[i][j];
+         sigma_[j][i] = sigma_[i][j];
+         sigmaSq_[j][i] = sigmaSq_[i][j];
+         cutoff_[j][i] = cutoff_[i][j];
+         cutoffSq_[j][i] = cutoffSq_[i][j];
+         lambda_[j][i] = lambda_[i][j];
+         xCut_[j][i] = xCut_[i][j];
+      }
+   }
+
+   /*
+   * Reset epsilon_[i][j] after initialization.
+   */
+   void SoftCoreLJPair::setEpsilon(int i, int j, double epsilon)
+   {  set("epsilon", i, j, epsilon); }
+
+   /*
+   * Reset lambda_[i][j] after initialization.
+   */
+   void SoftCoreLJPair::setLambda(int i, int j, double lambda)
+   {  set("lambda", i, j, lambda); }
+
+   /*
+   * Modify a parameter, identified by a string.
+   */
+   void SoftCoreLJPair::set(std::string name, int i, int j, double value)
+   {
+      if (!isInitialized_) {
+         UTIL_THROW("Cannot modify parameters before initialization");
+      }
+      if (i < 0 || i >= nAtomType_) {
+         UTIL_THROW("Invalid atom type index i");
+      }
+      if (j < 0 || j >= nAtomType_) {
+         UTIL_THROW("Invalid atom type index j");
+      }
+      if (name == "epsilon") {
+         epsilon_[i][j] = value;
+      } else
+      if (name == "sigma") {
+         sigma_[i][j] = value;
+      } else
+      if (name == "lambda") {
+         if (value < 0.0 || value > 1.0) {
+            UTIL_THROW("lambda must be in the range [0,1]");
+         }
+         lambda_[i][j] = value;
+      } else {
+         UTIL_THROW("Unrecognized parameter name");
+      }
+      update(i, j);
+   }
+
+   /*
+   * Get maximum of pair cutoff distance, for all atom type pairs.
+   */
+   double SoftCoreLJPair::maxPairCutoff() const
+   {  return maxPairCutoff_; }
+
+   /*
+   * Get pair interaction strength.
+   */
+   double SoftCoreLJPair::epsilon(int i, int j) const
+   {
+      assert(i >= 0 && i < nAtomType_);
+      assert(j >= 0 && j < nAtomType_);
+      return epsilon_[i][j];
+   }
+
+   /*
+   * Get pair interaction range.
+   */
+   double SoftCoreLJPair::sigma(int i, int j) const
+   {
+      assert(i >= 0 && i < nAtomType_);
+      assert(j >= 0 && j < nAtomType_);
+      return sigma_[i][j];
+   }
+
+   /*
+   * Get coupling parameter.
+   */
+   double SoftCoreLJPair::lambda(int i, int j) const
+   {
+      assert(i >= 0 && i < nAtomType_);
+      assert(j >= 0 && j < nAtomType_);
+      return lambda_[i][j];
+   }
+
+   /*
+   * Get soft-core parameter alpha.
+   */
+   double SoftCoreLJPair::alpha() const
+   {  return alpha_; }
+
+   /*
+   * Get a parameter value, identified by a string.
+   */
+   double SoftCoreLJPair::get(std::string name, int i, int j) const
+   {
+      double value = 0.0;
+      if (name == "epsilon") {
+         value = epsilon_[i][j];
+      } else
+      if (name == "sigma") {
+         value = sigma_[i][j];
+      } else
+      if (name == "cutoff") {
+         value = cutoff_[i][j];
+      } else
+      if (name == "lambda") {
+         value = lambda_[i][j];
+      } else {
+         UTIL_THROW("Unrecognized parameter name");
+      }
+      return value;
+   }
+
+}
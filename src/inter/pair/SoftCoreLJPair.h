@@ -0,0 +1,361 @@
+#ifndef INTER_SOFT_CORE_LJ_PAIR_H
+#define INTER_SOFT_CORE_LJ_PAIR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>
+#include <util/global.h>
+
+#include <math.h>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /**
+   * A soft-core Lennard-Jones pair interaction with a coupling parameter.
+   *
+   * For each pair of atom types, the potential depends on a coupling
+   * parameter lambda in [0,1] through the soft-core form
+   * \f[
+   *    V(r, \lambda) = 4 \epsilon \lambda \left [ s^{-2} - s^{-1} \right ] ,
+   *    \quad s = \alpha (1 - \lambda) + (r/\sigma)^{6}
+   * \f]
+   * shifted so as to vanish at the cutoff. For lambda = 1, this is the
+   * cutoff, shifted Lennard-Jones potential of LJPair. For lambda = 0,
+   * the interaction vanishes. For intermediate values, the energy is
+   * finite at r = 0, which avoids the singularities that arise in free
+   * energy calculations that linearly scale a Lennard-Jones potential.
+   *
+   * In addition to the standard pair interaction interface, the class
+   * provides functions that return the derivative dV/dlambda, and the
+   * energies for a set of lambda values, for use in free energy
+   * calculations. The function energies() computes the energies at
+   * several values of lambda for one pair in a single call, so that a
+   * single pass over all pairs yields every energy difference needed
+   * by a Bennett or MBAR analysis.
+   *
+   * \sa \ref inter_pair_SoftCoreLJPair_page
+   * \sa \ref inter_pair_interface_page
+   * \sa \ref inter_pair_page
+   *
+   * \ingroup Inter_Pair_Module
+   */
+   class SoftCoreLJPair : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      SoftCoreLJPair();
+
+      /// \name Mutators
+      //@{
+
+      /**
+      * Set nAtomType value.
+      *
+      * \param nAtomType number of atom types.
+      */
+      void setNAtomType(int nAtomType);
+
+      /**
+      * Read epsilon, sigma, cutoff, alpha and lambda.
+      *
+      * \pre nAtomType must have been set, by calling setNAtomType().
+      *
+      * \param in  input parameter stream
+      */
+      void readParameters(std::istream &in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Set LJ interaction energy for a specific pair of Atom types.
+      *
+      * \param i        type of Atom 1
+      * \param j        type of Atom 2
+      * \param epsilon  LJ energy parameter
+      */
+      void setEpsilon(int i, int j, double epsilon);
+
+      /**
+      * Set coupling parameter for a specific pair of Atom types.
+      *
+      * \param i       type of Atom 1
+      * \param j       type of Atom 2
+      * \param lambda  coupling parameter, in [0,1]
+      */
+      void setLambda(int i, int j, double lambda);
+
+      /**
+      * Modify a parameter, identified by a string.
+      *
+      * Recognized names are "epsilon", "sigma" and "lambda".
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      * \param value  new value of parameter
+      */
+      void set(std::string name, int i, int j, double value);
+
+      //@}
+      /// \name Accessors
+      //@{
+
+      /**
+      * Returns interaction energy for a single pair of atoms.
+      *
+      * \param rsq square of distance between atoms
+      * \param i   type of atom 1
+      * \param j   type of atom 2
+      * \return    pair interaction energy
+      */
+      double energy(double rsq, int i, int j) const;
+
+      /**
+      * Returns ratio of scalar pair interaction force to pair separation.
+      *
+      * \pre rsq < cutoffSq(i, j)
+      *
+      * \param rsq square of distance between atoms
+      * \param i   type of atom 1
+      * \param j   type of atom 2
+      * \return    force divided by distance
+      */
+      double forceOverR(double rsq, int i, int j) const;
+
+      /**
+      * Returns derivative of pair energy with respect to lambda.
+      *
+      * \param rsq square of distance between atoms
+      * \param i   type of atom 1
+      * \param j   type of atom 2
+      * \return    dV/dlambda, evaluated at lambda(i, j)
+      */
+      double dEnergyDLambda(double rsq, int i, int j) const;
+
+      /**
+      * Compute pair energies for several values of lambda.
+      *
+      * Sets energies[k] to the pair energy that would be obtained if
+      * lambda(i, j) were equal to lambdas[k], for k = 0, ..., n - 1.
+      * All values are zero for rsq >= cutoffSq(i, j).
+      *
+      * \param rsq       square of distance between atoms
+      * \param i         type of atom 1
+      * \param j         type of atom 2
+      * \param lambdas   array of n lambda values
+      * \param n         number of lambda values
+      * \param energies  array of n energies (output)
+      */
+      void energies(double rsq, int i, int j,
+                    const double* lambdas, int n, double* energies) const;
+
+      /**
+      * Get square of cutoff distance for specific type pair.
+      *
+      * \param i   type of atom 1
+      * \param j   type of atom 2
+      */
+      double cutoffSq(int i, int j) const;
+
+      /**
+      * Get maximum of pair cutoff distance, for all atom type pairs.
+      */
+      double maxPairCutoff() const;
+
+      /**
+      * Get LJ interaction energy for a specific pair of Atom types.
+      *
+      * \param i   type of Atom 1
+      * \param j   type of Atom 2
+      */
+      double epsilon(int i, int j) const;
+
+      /**
+      * Get LJ range for a specific pair of Atom types.
+      *
+      * \param i   type of Atom 1
+      * \param j   type of Atom 2
+      */
+      double sigma(int i, int j) const;
+
+      /**
+      * Get coupling parameter for a specific pair of Atom types.
+      *
+      * \param i   type of Atom 1
+      * \param j   type of Atom 2
+      */
+      double lambda(int i, int j) const;
+
+      /**
+      * Get soft-core parameter alpha.
+      */
+      double alpha() const;
+
+      /**
+      * Get a parameter value, identified by a string.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      */
+      double get(std::string name, int i, int j) const;
+
+      //@}
+
+   private:
+
+      /// Maximum allowed value for nAtomType (# of atom types)
+      static const int MaxAtomType = 4;
+
+      double epsilon_[MaxAtomType][MaxAtomType];  ///< LJ interaction energies.
+      double sigma_[MaxAtomType][MaxAtomType];    ///< LJ range parameters.
+      double sigmaSq_[MaxAtomType][MaxAtomType];  ///< square of sigma[][].
+      double cutoff_[MaxAtomType][MaxAtomType];   ///< LJ cutoff distance.
+      double cutoffSq_[MaxAtomType][MaxAtomType]; ///< square of cutoff[][].
+      double lambda_[MaxAtomType][MaxAtomType];   ///< coupling parameters.
+      double xCut_[MaxAtomType][MaxAtomType];     ///< (cutoff/sigma)^6.
+
+      /// Soft-core parameter alpha.
+      double alpha_;
+
+      /// Maximum pair potential cutoff radius, for all type pairs.
+      double maxPairCutoff_;
+
+      /// Total number of atom types.
+      int nAtomType_;
+
+      /// Was this object initialized by (read|load)Parameters ?
+      bool isInitialized_;
+
+      /*
+      * Compute derived quantities for pair (i, j) and symmetrize.
+      */
+      void update(int i, int j);
+
+      /*
+      * Shifted soft-core energy for given x = (r/sigma)^6 and lambda.
+      */
+      double shiftedEnergy(double x, double xc, double eps4, double lambda)
+      const;
+
+   };
+
+   // Inline methods
+
+   /*
+   * Shifted soft-core energy for given x = (r/sigma)^6 (private).
+   */
+   inline double
+   SoftCoreLJPair::shiftedEnergy(double x, double xc, double eps4,
+                                 double lambda) const
+   {
+      double a = alpha_*(1.0 - lambda);
+      double si = 1.0/(a + x);
+      double sci = 1.0/(a + xc);
+      return eps4*lambda*(si*si - si - sci*sci + sci);
+   }
+
+   /*
+   * Calculate interaction energy for a pair, as function of squared distance.
+   */
+   inline double SoftCoreLJPair::energy(double rsq, int i, int j) const
+   {
+      if (rsq < cutoffSq_[i][j]) {
+         double x = rsq/sigmaSq_[i][j];
+         x = x*x*x;
+         return shiftedEnergy(x, xCut_[i][j], 4.0*epsilon_[i][j],
+                              lambda_[i][j]);
+      } else {
+         return 0.0;
+      }
+   }
+
+   /*
+   * Calculate force/distance for a pair as function of squared distance.
+   */
+   inline double SoftCoreLJPair::forceOverR(double rsq, int i, int j) const
+   {
+      double x = rsq/sigmaSq_[i][j];
+      x = x*x*x;
+      double lambda = lambda_[i][j];
+      double si = 1.0/(alpha_*(1.0 - lambda) + x);
+      return 24.0*epsilon_[i][j]*lambda*(2.0*si - 1.0)*si*si*x/rsq;
+   }
+
+   /*
+   * Calculate derivative of pair energy with respect to lambda.
+   */
+   inline
+   double SoftCoreLJPair::dEnergyDLambda(double rsq, int i, int j) const
+   {
+      if (rsq < cutoffSq_[i][j]) {
+         double x = rsq/sigmaSq_[i][j];
+         x = x*x*x;
+         double lambda = lambda_[i][j];
+         double a = alpha_*(1.0 - lambda);
+         double si = 1.0/(a + x);
+         double sci = 1.0/(a + xCut_[i][j]);
+         double d = si*si - si + alpha_*lambda*(2.0*si - 1.0)*si*si;
+         d -= sci*sci - sci + alpha_*lambda*(2.0*sci - 1.0)*sci*sci;
+         return 4.0*epsilon_[i][j]*d;
+      } else {
+         return 0.0;
+      }
+   }
+
+   /*
+   * Calculate pair energies for several values of lambda.
+   */
+   inline
+   void SoftCoreLJPair::energies(double rsq, int i, int j,
+                                 const double* lambdas, int n,
+                                 double* energies) const
+   {
+      int k;
+      if (rsq < cutoffSq_[i][j]) {
+         double x = rsq/sigmaSq_[i][j];
+         x = x*x*x;
+         double xc = xCut_[i][j];
+         double eps4 = 4.0*epsilon_[i][j];
+         for (k = 0; k < n; ++k) {
+            energies[k] = shiftedEnergy(x, xc, eps4, lambdas[k]);
+         }
+      } else {
+         for (k = 0; k < n; ++k) {
+            energies[k] = 0.0;
+         }
+      }
+   }
+
+   /*
+   * Return square of cutoff distance for a specific atom type pair.
+   */
+   inline double SoftCoreLJPair::cutoffSq(int i, int j) const
+   {  return cutoffSq_[i][j]; }
+
+}
+#endif
@@ -0,0 +1,406 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TablePair.h"
+#include <util/containers/DMatrix.h>
+#include <util/misc/Log.h>
+#ifdef UTIL_MPI
+#include <util/mpi/MpiLoader.h>
+#include <util/mpi/MpiSendRecv.h>
+#endif
+
+#include <fstream>
+#include <cmath>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   namespace {
+
+      /*
+      * Compute second derivatives m of a natural cubic spline through
+      * points (x[k], y[k]), k = 0, ..., n, with increasing x.
+      *
+      * Solves the tridiagonal system for interior points by the Thomas
+      * algorithm, using work array w of n + 1 elements.
+      */
+      void naturalSpline(const double* x, const double* y, int n,
+                         double* m, double* w)
+      {
+         double h0, h1, p;
+         int k;
+         m[0] = 0.0;
+         w[0] = 0.0;
+         for (k = 1; k < n; ++k) {
+            h0 = x[k] - x[k-1];
+            h1 = x[k+1] - x[k];
+            p = 2.0*(h0 + h1) - h0*w[k-1];
+            w[k] = h1/p;
+            m[k] = (6.0*((y[k+1] - y[k])/h1 - (y[k] - y[k-1])/h0)
+                    - h0*m[k-1])/p;
+         }
+         m[n] = 0.0;
+         for (k = n - 1; k > 0; --k) {
+            m[k] -= w[k]*m[k+1];
+         }
+      }
+
+      /*
+      * Evaluate a natural cubic spline at xv, for x[0] <= xv <= x[n].
+      */
+      double splineValue(const double* x, const double* y, const double* m,
+                         int n, double xv)
+      {
+         int lo = 0;
+         int hi = n;
+         int mid;
+         while (hi - lo > 1) {
+            mid = (lo + hi)/2;
+            if (x[mid] > xv) {
+               hi = mid;
+            } else {
+               lo = mid;
+            }
+         }
+         double h = x[hi] - x[lo];
+         double a = (x[hi] - xv)/h;
+         double b = 1.0 - a;
+         return a*y[lo] + b*y[hi]
+              + ((a*a*a - a)*m[lo] + (b*b*b - b)*m[hi])*h*h/6.0;
+      }
+
+      /*
+      * Set polynomial coefficients for a natural spline through values
+      * y[k] at n + 1 equally spaced nodes, in local coordinates t in
+      * [0,1] for each interval. Coefficients of interval k are stored
+      * in c[stride*k], ..., c[stride*k + 3].
+      */
+      void setCoefficients(const double* y, int n, double* c, int stride)
+      {
+         DArray<double> x, m, w;
+         x.allocate(n + 1);
+         m.allocate(n + 1);
+         w.allocate(n + 1);
+         int k;
+         for (k = 0; k <= n; ++k) {
+            x[k] = double(k);
+         }
+         naturalSpline(&x[0], y, n, &m[0], &w[0]);
+         double* p;
+         for (k = 0; k < n; ++k) {
+            p = c + stride*k;
+            p[0] = y[k];
+            p[1] = y[k+1] - y[k] - (2.0*m[k] + m[k+1])/6.0;
+            p[2] = 0.5*m[k];
+            p[3] = (m[k+1] - m[k])/6.0;
+         }
+      }
+
+   }
+
+   /*
+   * Constructor.
+   */
+   TablePair::TablePair()
+    : nPoint_(0),
+      nAtomType_(0),
+      maxPairCutoff_(0.0)
+   {  setClassName("TablePair"); }
+
+   /*
+   * Destructor.
+   */
+   TablePair::~TablePair()
+   {}
+
+   /*
+   * Set nAtomType.
+   */
+   void TablePair::setNAtomType(int nAtomType)
+   {
+      if (nAtomType <= 0) {
+         UTIL_THROW("nAtomType <= 0");
+      }
+      if (tables_.isAllocated() && nAtomType != nAtomType_) {
+         UTIL_THROW("Attempt to change nAtomType");
+      }
+      nAtomType_ = nAtomType;
+   }
+
+   /*
+   * Allocate tables and compute offsets.
+   */
+   void TablePair::allocate()
+   {
+      if (nAtomType_ <= 0) {
+         UTIL_THROW("nAtomType must be set before readParameters");
+      }
+      if (nPoint_ < 2) {
+         UTIL_THROW("nPoint must be at least 2");
+      }
+      if (tables_.isAllocated()) {
+         return;
+      }
+      int nPair = nAtomType_*(nAtomType_ + 1)/2;
+      coeffs_.allocate(nPair*nPoint_*NCoeff);
+      tables_.allocate(nAtomType_*nAtomType_);
+      int i, j, p;
+      p = 0;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = i; j < nAtomType_; ++j) {
+            Table& table = tables_[i*nAtomType_ + j];
+            table.rsqMin = 0.0;
+            table.invDelta = 0.0;
+            table.cutoffSq = 0.0;
+            table.offset = p*nPoint_*NCoeff;
+            symmetrize(i, j);
+            ++p;
+         }
+      }
+      for (i = 0; i < coeffs_.capacity(); ++i) {
+         coeffs_[i] = 0.0;
+      }
+      maxPairCutoff_ = 0.0;
+   }
+
+   /*
+   * Set the table for an unordered type pair.
+   */
+   void TablePair::setTable(int i, int j, double rMin, double cutoff,
+                            const double* energies,
+                            const double* forceOverRs)
+   {
+      if (i < 0 || i >= nAtomType_ || j < 0 || j >= nAtomType_) {
+         UTIL_THROW("Invalid atom type index");
+      }
+      if (rMin <= 0.0 || cutoff <= rMin) {
+         UTIL_THROW("Table requires 0 < rMin < cutoff");
+      }
+      double rsqMin = rMin*rMin;
+      double rsqMax = cutoff*cutoff;
+      Table& table = tables_[i*nAtomType_ + j];
+      table.rsqMin = rsqMin;
+      table.invDelta = double(nPoint_)/(rsqMax - rsqMin);
+      table.cutoffSq = rsqMax;
+      symmetrize(i, j);
+
+      double* c = &coeffs_[table.offset];
+      setCoefficients(energies, nPoint_, c, NCoeff);
+      setCoefficients(forceOverRs, nPoint_, c + 4, NCoeff);
+
+      maxPairCutoff_ = 0.0;
+      for (int k = 0; k < tables_.capacity(); ++k) {
+         if (tables_[k].cutoffSq > maxPairCutoff_*maxPairCutoff_) {
+            maxPairCutoff_ = sqrt(tables_[k].cutoffSq);
+         }
+      }
+   }
+
+   /*
+   * Copy parameters of table (i, j) to table (j, i) (private).
+   */
+   void TablePair::symmetrize(int i, int j)
+   {  tables_[j*nAtomType_ + i] = tables_[i*nAtomType_ + j]; }
+
+   /*
+   * Read fileName and nPoint, and read tables.
+   */
+   void TablePair::readParameters(std::istream &in)
+   {
+      read<std::string>(in, "fileName", fileName_);
+      read<int>(in, "nPoint", nPoint_);
+      allocate();
+      if (isIoProcessor()) {
+         readTables();
+      }
+      #ifdef UTIL_MPI
+      if (hasIoCommunicator()) {
+         bcast<double>(ioCommunicator(), coeffs_, coeffs_.capacity(), 0);
+         for (int k = 0; k < tables_.capacity(); ++k) {
+            Table& table = tables_[k];
+            bcast<double>(ioCommunicator(), table.rsqMin, 0);
+            bcast<double>(ioCommunicator(), table.invDelta, 0);
+            bcast<double>(ioCommunicator(), table.cutoffSq, 0);
+         }
+         bcast<double>(ioCommunicator(), maxPairCutoff_, 0);
+      }
+      #endif
+   }
+
+   /*
+   * Read all tables from file (private).
+   *
+   * Each unordered pair of atom types must appear once, as a line
+   * containing "i j n", followed by n lines containing "r energy force",
+   * in order of increasing r. Values are interpolated with natural
+   * cubic splines in r to the nodes of the table in rsq.
+   */
+   void TablePair::readTables()
+   {
+      std::ifstream file(fileName_.c_str());
+      if (!file.is_open()) {
+         Log::file() << "Table file: " << fileName_ << std::endl;
+         UTIL_THROW("Cannot open table file");
+      }
+
+      DMatrix<int> isSet;
+      isSet.allocate(nAtomType_, nAtomType_);
+      int i, j, k, n, iPair;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nAtomType_; ++j) {
+            isSet(i, j) = 0;
+         }
+      }
+
+      DArray<double> r, e, f, me, mf, w, energies, forceOverRs;
+      energies.allocate(nPoint_ + 1);
+      forceOverRs.allocate(nPoint_ + 1);
+      double rsq, rsqMin, rsqMax, rv;
+      int nPair = nAtomType_*(nAtomType_ + 1)/2;
+      for (iPair = 0; iPair < nPair; ++iPair) {
+         file >> i >> j >> n;
+         if (file.fail()) {
+            UTIL_THROW("Error reading table header line");
+         }
+         if (i < 0 || i >= nAtomType_ || j < 0 || j >= nAtomType_) {
+            UTIL_THROW("Invalid atom type index in table file");
+         }
+         if (isSet(i, j)) {
+            UTIL_THROW("Repeated type pair in table file");
+         }
+         if (n < 2) {
+            UTIL_THROW("Table must contain at least 2 points");
+         }
+         if (r.isAllocated() && r.capacity() < n) {
+            r.deallocate();
+            e.deallocate();
+            f.deallocate();
+            me.deallocate();
+            mf.deallocate();
+            w.deallocate();
+         }
+         if (!r.isAllocated()) {
+            r.allocate(n);
+            e.allocate(n);
+            f.allocate(n);
+            me.allocate(n);
+            mf.allocate(n);
+            w.allocate(n);
+         }
+         for (k = 0; k < n; ++k) {
+            file >> r[k] >> e[k] >> f[k];
+            if (k > 0 && r[k] <= r[k-1]) {
+               UTIL_THROW("Table distances must be increasing");
+            }
+         }
+         if (file.fail()) {
+            UTIL_THROW("Error reading table file");
+         }
+         if (r[0] <= 0.0) {
+            UTIL_THROW("Table requires 0 < rMin < cutoff");
+         }
+
+         // Interpolate in r, and tabulate energy and force/r in rsq
+         naturalSpline(&r[0], &e[0], n - 1, &me[0], &w[0]);
+         naturalSpline(&r[0], &f[0], n - 1, &mf[0], &w[0]);
+         rsqMin = r[0]*r[0];
+         rsqMax = r[n-1]*r[n-1];
+         for (k = 0; k <= nPoint_; ++k) {
+            rsq = rsqMin + double(k)*(rsqMax - rsqMin)/double(nPoint_);
+            if (k == 0) {
+               rv = r[0];
+            } else
+            if (k == nPoint_) {
+               rv = r[n-1];
+            } else {
+               rv = sqrt(rsq);
+            }
+            energies[k] = splineValue(&r[0], &e[0], &me[0], n - 1, rv);
+            forceOverRs[k] = splineValue(&r[0], &f[0], &mf[0], n - 1, rv)/rv;
+         }
+         setTable(i, j, r[0], r[n-1], &energies[0], &forceOverRs[0]);
+         isSet(i, j) = 1;
+         isSet(j, i) = 1;
+      }
+      file.close();
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void TablePair::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<std::string>(ar, "fileName", fileName_);
+      loadParameter<int>(ar, "nPoint", nPoint_);
+      allocate();
+      #ifdef UTIL_MPI
+      MpiLoader<Serializable::IArchive> loader(*this, ar);
+      loader.load(coeffs_, coeffs_.capacity());
+      for (int k = 0; k < tables_.capacity(); ++k) {
+         Table& table = tables_[k];
+         loader.load(table.rsqMin);
+         loader.load(table.invDelta);
+         loader.load(table.cutoffSq);
+      }
+      loader.load(maxPairCutoff_);
+      #else
+      ar >> coeffs_;
+      for (int k = 0; k < tables_.capacity(); ++k) {
+         Table& table = tables_[k];
+         ar >> table.rsqMin;
+         ar >> table.invDelta;
+         ar >> table.cutoffSq;
+      }
+      ar >> maxPairCutoff_;
+      #endif
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void TablePair::save(Serializable::OArchive &ar)
+   {
+      ar << fileName_;
+      ar << nPoint_;
+      ar << coeffs_;
+      for (int k = 0; k < tables_.capacity(); ++k) {
+         Table& table = tables_[k];
+         ar << table.rsqMin;
+         ar << table.invDelta;
+         ar << table.cutoffSq;
+      }
+      ar << maxPairCutoff_;
+   }
+
+   /*
+   * Get maximum of pair cutoff distance, for all atom type pairs.
+   */
+   double TablePair::maxPairCutoff() const
+   {  return maxPairCutoff_; }
+
+   /*
+   * Modify a parameter (not supported).
+   */
+   void TablePair::set(std::string name, int i, int j, double value)
+   {  UTIL_THROW("TablePair parameters cannot be modified"); }
+
+   /*
+   * Get a parameter value, identified by a string.
+   */
+   double TablePair::get(std::string name, int i, int j) const
+   {
+      if (name == "cutoff") {
+         return sqrt(cutoffSq(i, j));
+      } else {
+         UTIL_THROW("Unrecognized parameter name");
+      }
+      return 0.0;
+   }
+
+}
@@ -0,0 +1,298 @@
+#ifndef INTER_TABLE_PAIR_H
+#define INTER_TABLE_PAIR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>
+#include <util/containers/DArray.h>
+#include <util/global.h>
+
+#include <string>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /**
+   * A tabulated nonbonded pair interaction, using cubic splines.
+   *
+   * The energy and the ratio forceOverR of force to distance for each
+   * pair of atom types are represented by natural cubic splines in the
+   * squared distance rsq, on nPoint intervals of equal width between
+   * rMin*rMin and cutoff*cutoff. The cost of evaluating energy() or
+   * forceOverR() is thus independent of the functional form of the
+   * potential, and the same kernel is used for all potentials. For
+   * rsq < rMin*rMin, both functions return their values at rMin.
+   *
+   * This class reads tables from a file, as described on the page
+   * \ref inter_pair_TablePair_page. The subclass template
+   * TabulatedPair instead generates tables from another interaction.
+   *
+   * \sa \ref inter_pair_TablePair_page
+   * \sa \ref inter_pair_interface_page
+   * \sa \ref inter_pair_page
+   *
+   * \ingroup Inter_Pair_Module
+   */
+   class TablePair : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      TablePair();
+
+      /**
+      * Destructor.
+      */
+      virtual ~TablePair();
+
+      /// \name Mutators
+      //@{
+
+      /**
+      * Set nAtomType value.
+      *
+      * \param nAtomType number of atom types.
+      */
+      void setNAtomType(int nAtomType);
+
+      /**
+      * Read fileName and nPoint, and read tables from the file.
+      *
+      * \pre nAtomType must have been set, by calling setNAtomType().
+      *
+      * \param in  input parameter stream
+      */
+      virtual void readParameters(std::istream &in);
+
+      /**
+      * Load internal state, including all tables, from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state, including all tables, to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Modify a parameter, identified by a string.
+      *
+      * Tabulated interactions have no modifiable parameters, so this
+      * function always throws an Exception.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      * \param value  new value of parameter
+      */
+      void set(std::string name, int i, int j, double value);
+
+      //@}
+      /// \name Accessors
+      //@{
+
+      /**
+      * Returns interaction energy for a single pair of atoms.
+      *
+      * \param rsq square of distance between atoms
+      * \param i   type of atom 1
+      * \param j   type of atom 2
+      * \return    pair interaction energy
+      */
+      double energy(double rsq, int i, int j) const;
+
+      /**
+      * Returns ratio of scalar pair interaction force to pair separation.
+      *
+      * \pre rsq < cutoffSq(i, j)
+      *
+      * \param rsq square of distance between atoms
+      * \param i   type of atom 1
+      * \param j   type of atom 2
+      * \return    force divided by distance
+      */
+      double forceOverR(double rsq, int i, int j) const;
+
+      /**
+      * Get square of cutoff distance for specific type pair.
+      *
+      * \param i   type of atom 1
+      * \param j   type of atom 2
+      */
+      double cutoffSq(int i, int j) const;
+
+      /**
+      * Get maximum of pair cutoff distance, for all atom type pairs.
+      */
+      double maxPairCutoff() const;
+
+      /**
+      * Get a parameter value, identified by a string.
+      *
+      * Only the value "cutoff" is recognized.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      */
+      double get(std::string name, int i, int j) const;
+
+      /**
+      * Get the number of spline intervals per type pair.
+      */
+      int nPoint() const;
+
+      //@}
+
+   protected:
+
+      /// Number of spline intervals per type pair (parameter).
+      int nPoint_;
+
+      /// Total number of atom types.
+      int nAtomType_;
+
+      /**
+      * Allocate tables, given nAtomType_ and nPoint_.
+      */
+      void allocate();
+
+      /**
+      * Set the table for an unordered type pair.
+      *
+      * The arrays energies and forceOverRs contain nPoint + 1 values
+      * at squared distances rsq = rsqMin + k*(rsqMax - rsqMin)/nPoint,
+      * for k = 0, ..., nPoint, with rsqMin = rMin*rMin and rsqMax =
+      * cutoff*cutoff. The function maxPairCutoff() is updated.
+      *
+      * \pre 0 < rMin < cutoff
+      *
+      * \param i   atom type index 1
+      * \param j   atom type index 2
+      * \param rMin  minimum tabulated distance
+      * \param cutoff  cutoff distance
+      * \param energies  array of nPoint + 1 energy values
+      * \param forceOverRs  array of nPoint + 1 values of force/distance
+      */
+      void setTable(int i, int j, double rMin, double cutoff,
+                    const double* energies, const double* forceOverRs);
+
+   private:
+
+      /*
+      * Parameters of the table for one ordered type pair.
+      */
+      struct Table
+      {
+         /// Minimum tabulated rsq.
+         double rsqMin;
+         /// Inverse interval width in rsq.
+         double invDelta;
+         /// Square of cutoff distance.
+         double cutoffSq;
+         /// Index of first spline coefficient in coeffs_.
+         int offset;
+      };
+
+      /// Number of values per spline interval (4 energy, 4 force).
+      static const int NCoeff = 8;
+
+      /// Spline coefficients for all unordered type pairs.
+      DArray<double> coeffs_;
+
+      /// Tables for ordered type pairs (i, j), with index i*nAtomType_ + j.
+      DArray<Table> tables_;
+
+      /// Maximum pair cutoff, for all type pairs.
+      double maxPairCutoff_;
+
+      /// Name of table file (parameter).
+      std::string fileName_;
+
+      /*
+      * Read all tables from file fileName_ (I/O processor only).
+      */
+      void readTables();
+
+      /*
+      * Set table parameters of pair (j, i) equal to those of (i, j).
+      */
+      void symmetrize(int i, int j);
+
+      /*
+      * Return pointer to coefficients of the interval for rsq, set t.
+      */
+      const double* interval(const Table& table, double rsq, double& t) 
+      const;
+
+   };
+
+   // Inline methods
+
+   /*
+   * Find spline interval and local coordinate t in [0,1] (private).
+   */
+   inline const double* 
+   TablePair::interval(const Table& table, double rsq, double& t) const
+   {
+      double s = (rsq - table.rsqMin)*table.invDelta;
+      s = (s > 0.0) ? s : 0.0;
+      int k = int(s);
+      k = (k < nPoint_) ? k : nPoint_ - 1;
+      t = s - double(k);
+      return &coeffs_[table.offset + NCoeff*k];
+   }
+
+   /*
+   * Calculate interaction energy for a pair, as function of squared distance.
+   */
+   inline double TablePair::energy(double rsq, int i, int j) const
+   {
+      const Table& table = tables_[i*nAtomType_ + j];
+      if (rsq < table.cutoffSq) {
+         double t;
+         const double* c = interval(table, rsq, t);
+         return c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+      } else {
+         return 0.0;
+      }
+   }
+
+   /*
+   * Calculate force/distance for a pair as function of squared distance.
+   */
+   inline double TablePair::forceOverR(double rsq, int i, int j) const
+   {
+      double t;
+      const double* c = interval(tables_[i*nAtomType_ + j], rsq, t);
+      return c[4] + t*(c[5] + t*(c[6] + t*c[7]));
+   }
+
+   /*
+   * Return square of cutoff distance for a specific atom type pair.
+   */
+   inline double TablePair::cutoffSq(int i, int j) const
+   {  return tables_[i*nAtomType_ + j].cutoffSq; }
+
+   /*
+   * Get number of spline intervals per type pair.
+   */
+   inline int TablePair::nPoint() const
+   {  return nPoint_; }
+
+}
+#endif
@@ -0,0 +1,251 @@
+#ifndef INTER_TABULATED_PAIR_H
+#define INTER_TABULATED_PAIR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <inter/pair/TablePair.h>
+#include <util/containers/DArray.h>
+#include <util/global.h>
+
+#include <string>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /**
+   * Spline table generated from another pair interaction.
+   *
+   * TabulatedPair<BasePair> reads the parameters of a base interaction,
+   * such as LJPair, followed by a minimum distance rMin and a number
+   * nPoint of spline intervals, and tabulates the energy and force of
+   * the base interaction for each type pair between rMin and the base
+   * cutoff, using the spline representation of TablePair. Parameters
+   * of the base interaction may be modified with set(), after which
+   * the affected table is regenerated.
+   *
+   * \sa \ref inter_pair_TablePair_page
+   *
+   * \ingroup Inter_Pair_Module
+   */
+   template <class BasePair>
+   class TabulatedPair : public TablePair
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      TabulatedPair();
+
+      /**
+      * Set nAtomType value.
+      *
+      * \param nAtomType number of atom types.
+      */
+      void setNAtomType(int nAtomType);
+
+      /**
+      * Read base interaction parameters, rMin and nPoint, and tabulate.
+      *
+      * \pre nAtomType must have been set, by calling setNAtomType().
+      *
+      * \param in  input parameter stream
+      */
+      virtual void readParameters(std::istream &in);
+
+      /**
+      * Load base interaction parameters, rMin and nPoint, and tabulate.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save base interaction parameters, rMin and nPoint.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Modify a parameter of the base interaction, and retabulate.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      * \param value  new value of parameter
+      */
+      void set(std::string name, int i, int j, double value);
+
+      /**
+      * Get a parameter value of the base interaction.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      */
+      double get(std::string name, int i, int j) const;
+
+      /**
+      * Get the base pair interaction.
+      */
+      const BasePair& basePair() const;
+
+   private:
+
+      /// Base interaction.
+      BasePair basePair_;
+
+      /// Minimum tabulated distance (parameter).
+      double rMin_;
+
+      /*
+      * Tabulate the base interaction for one unordered type pair.
+      */
+      void tabulate(int i, int j);
+
+      /*
+      * Tabulate the base interaction for all type pairs.
+      */
+      void tabulateAll();
+
+   };
+
+   /*
+   * Constructor.
+   */
+   template <class BasePair>
+   TabulatedPair<BasePair>::TabulatedPair()
+    : TablePair(),
+      basePair_(),
+      rMin_(0.0)
+   {
+      std::string name("TabulatedPair<");
+      name += basePair_.className();
+      name += ">";
+      setClassName(name.c_str());
+   }
+
+   /*
+   * Set nAtomType for this and the base interaction.
+   */
+   template <class BasePair>
+   void TabulatedPair<BasePair>::setNAtomType(int nAtomType)
+   {
+      TablePair::setNAtomType(nAtomType);
+      basePair_.setNAtomType(nAtomType);
+   }
+
+   /*
+   * Read base parameters, rMin and nPoint, and tabulate.
+   */
+   template <class BasePair>
+   void TabulatedPair<BasePair>::readParameters(std::istream &in)
+   {
+      bool nextIndent = false;
+      addParamComposite(basePair_, nextIndent);
+      basePair_.readParameters(in);
+      read<double>(in, "rMin", rMin_);
+      read<int>(in, "nPoint", nPoint_);
+      allocate();
+      tabulateAll();
+   }
+
+   /*
+   * Load base parameters, rMin and nPoint, and tabulate.
+   */
+   template <class BasePair>
+   void TabulatedPair<BasePair>::loadParameters(Serializable::IArchive &ar)
+   {
+      bool nextIndent = false;
+      addParamComposite(basePair_, nextIndent);
+      basePair_.loadParameters(ar);
+      loadParameter<double>(ar, "rMin", rMin_);
+      loadParameter<int>(ar, "nPoint", nPoint_);
+      allocate();
+      tabulateAll();
+   }
+
+   /*
+   * Save base parameters, rMin and nPoint.
+   */
+   template <class BasePair>
+   void TabulatedPair<BasePair>::save(Serializable::OArchive &ar)
+   {
+      basePair_.save(ar);
+      ar << rMin_;
+      ar << nPoint_;
+   }
+
+   /*
+   * Modify a parameter of the base interaction, and retabulate.
+   */
+   template <class BasePair>
+   void
+   TabulatedPair<BasePair>::set(std::string name, int i, int j, double value)
+   {
+      basePair_.set(name, i, j, value);
+      tabulate(i, j);
+   }
+
+   /*
+   * Get a parameter of the base interaction.
+   */
+   template <class BasePair>
+   double TabulatedPair<BasePair>::get(std::string name, int i, int j) const
+   {  return basePair_.get(name, i, j); }
+
+   /*
+   * Get base interaction.
+   */
+   template <class BasePair>
+   const BasePair& TabulatedPair<BasePair>::basePair() const
+   {  return basePair_; }
+
+   /*
+   * Tabulate one unordered type pair (private).
+   */
+   template <class BasePair>
+   void TabulatedPair<BasePair>::tabulate(int i, int j)
+   {
+      if (rMin_ <= 0.0) {
+         UTIL_THROW("Table requires 0 < rMin < cutoff");
+      }
+      DArray<double> energies;
+      DArray<double> forceOverRs;
+      energies.allocate(nPoint_ + 1);
+      forceOverRs.allocate(nPoint_ + 1);
+      double rsqMin = rMin_*rMin_;
+      double rsqMax = basePair_.cutoffSq(i, j);
+      double rsq;
+      for (int k = 0; k <= nPoint_; ++k) {
+         rsq = rsqMin + double(k)*(rsqMax - rsqMin)/double(nPoint_);
+         energies[k] = basePair_.energy(rsq, i, j);
+         forceOverRs[k] = basePair_.forceOverR(rsq, i, j);
+      }
+      setTable(i, j, rMin_, sqrt(rsqMax), &energies[0], &forceOverRs[0]);
+   }
+
+   /*
+   * Tabulate all type pairs (private).
+   */
+   template <class BasePair>
+   void TabulatedPair<BasePair>::tabulateAll()
+   {
+      for (int i = 0; i < nAtomType_; ++i) {
+         for (int j = i; j < nAtomType_; ++j) {
+            tabulate(i, j);
+         }
+      }
+   }
+
+}
+#endif
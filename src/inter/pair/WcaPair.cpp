@@ -76,7 +76,7 @@ namespace Inter
       r6i = r6i*r6i*r6i;
       ljShift_[i][j] = -4.0*epsilon_[i][j]*(r6i*r6i - r6i);
       if (j != i) {
-         ljShift_[j][i] = ljShift_[j][i];
+         ljShift_[j][i] = ljShift_[i][j];
       }
 
    }
@@ -1,6 +1,8 @@
 inter_pair_=\
     inter/pair/DpdPair.cpp \
     inter/pair/LJPair.cpp \
+    inter/pair/SoftCoreLJPair.cpp \
+    inter/pair/TablePair.cpp \
     inter/pair/WcaPair.cpp 
 
 inter_pair_SRCS=\
@@ -28,6 +28,11 @@ include $(SRC_DIR)/inter/external/sources.mk
 inter_+=$(inter_external_)
 endif
 
+ifdef INTER_COULOMB
+include $(SRC_DIR)/inter/coulomb/sources.mk
+inter_+=$(inter_coulomb_)
+endif
+
 inter_SRCS=\
      $(addprefix $(SRC_DIR)/, $(inter_))
 inter_OBJS=\
@@ -11,6 +11,9 @@
 #ifdef INTER_DIHEDRAL
 #include "dihedral/DihedralTestComposite.h"
 #endif
+#ifdef INTER_COULOMB
+#include "coulomb/CoulombTestComposite.h"
+#endif
 
 TEST_COMPOSITE_BEGIN(InteractionTestComposite)
 addChild(new PairTestComposite, "pair/");
@@ -24,6 +27,10 @@ addChild(new AngleTestComposite, "angle/");
 addChild(new DihedralTestComposite, "dihedral/");
 #endif
 
+#ifdef INTER_COULOMB
+addChild(new CoulombTestComposite, "coulomb/");
+#endif
+
 TEST_COMPOSITE_END
 
 #endif
@@ -0,0 +1,131 @@
+#ifndef COULOMB_PAIR_TEST_H
+#define COULOMB_PAIR_TEST_H
+
+#include <inter/coulomb/CoulombPair.h>
+#include <inter/coulomb/EwaldInteraction.h>
+#include <inter/pair/LJPair.h>
+#include <inter/tests/pair/PairTestTemplate.h>
+
+#include <iostream>
+#include <fstream>
+
+using namespace Util;
+using namespace Inter;
+
+class CoulombPairTest : public PairTestTemplate< CoulombPair<LJPair> >
+{
+
+protected:
+
+   using PairTestTemplate< CoulombPair<LJPair> >::setNAtomType;
+   using PairTestTemplate< CoulombPair<LJPair> >::readParamFile;
+   using PairTestTemplate< CoulombPair<LJPair> >::forceOverR;
+   using PairTestTemplate< CoulombPair<LJPair> >::energy;
+
+   EwaldInteraction ewald_;
+
+public:
+
+   void setUp()
+   {
+      eps_ = 1.0E-6;
+      std::ifstream in;
+      openInputFile("in/EwaldInteraction", in);
+      ewald_.readParameters(in);
+      in.close();
+
+      setNAtomType(2);
+      interaction_.setEwaldInteraction(ewald_);
+      interaction_.setCharge(0, 1.0);
+      interaction_.setCharge(1, -1.0);
+      readParamFile("in/LJPair");
+   }
+
+   void testSetUp()
+   {
+      printMethod(TEST_FUNC);
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         interaction_.writeParam(std::cout);
+      }
+      TEST_ASSERT(interaction_.className() == "CoulombPair<LJPair>");
+   }
+
+   void testCutoff()
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(eq(interaction_.maxPairCutoff(), 3.0));
+      TEST_ASSERT(eq(interaction_.cutoffSq(0, 1), 9.0));
+      TEST_ASSERT(eq(interaction_.cutoffSq(1, 1), 9.0));
+
+      // Uncharged type pairs use only the base cutoff
+      interaction_.setCharge(1, 0.0);
+      readParamFile("in/LJPair");
+      TEST_ASSERT(eq(interaction_.cutoffSq(0, 0), 9.0));
+      TEST_ASSERT(eq(interaction_.cutoffSq(0, 1),
+                     interaction_.basePair().cutoffSq(0, 1)));
+   }
+
+   void testEnergy()
+   {
+      printMethod(TEST_FUNC);
+      double e;
+
+      // Beyond LJ cutoff, only the screened Coulomb energy remains
+      e = energy(2.0, 0, 1);
+      TEST_ASSERT(eq(e, ewald_.rSpaceEnergy(2.0, -1.0)));
+      TEST_ASSERT(e < 0.0);
+      e = energy(2.0, 1, 1);
+      TEST_ASSERT(eq(e, ewald_.rSpaceEnergy(2.0, 1.0)));
+      TEST_ASSERT(e > 0.0);
+
+      // Inside LJ cutoff, energies add
+      e = energy(1.0, 0, 1);
+      TEST_ASSERT(eq(e, 2.0 + ewald_.rSpaceEnergy(1.0, -1.0)));
+
+      // Beyond real space cutoff
+      e = energy(9.5, 0, 1);
+      TEST_ASSERT(eq(e, 0.0));
+   }
+
+   void testForceOverR()
+   {
+      printMethod(TEST_FUNC);
+      type1_ = 0;
+      type2_ = 1;
+
+      rsq_ = 0.9;
+      TEST_ASSERT(testForce());
+      rsq_ = 1.0;
+      TEST_ASSERT(testForce());
+      rsq_ = 2.2;
+      TEST_ASSERT(testForce());
+      rsq_ = 4.8;
+      TEST_ASSERT(testForce());
+
+      type1_ = 1;
+      rsq_ = 1.1;
+      TEST_ASSERT(testForce());
+      TEST_ASSERT(forceOverR() > 0.0);
+   }
+
+   void testModify()
+   {
+      printMethod(TEST_FUNC);
+      interaction_.set("epsilon", 0, 1, 1.3);
+      TEST_ASSERT(eq(interaction_.get("epsilon", 0, 1), 1.3));
+      TEST_ASSERT(eq(interaction_.basePair().epsilon(1, 0), 1.3));
+      TEST_ASSERT(eq(interaction_.cutoffSq(0, 1), 9.0));
+   }
+
+};
+
+TEST_BEGIN(CoulombPairTest)
+TEST_ADD(CoulombPairTest, testSetUp)
+TEST_ADD(CoulombPairTest, testCutoff)
+TEST_ADD(CoulombPairTest, testEnergy)
+TEST_ADD(CoulombPairTest, testForceOverR)
+TEST_ADD(CoulombPairTest, testModify)
+TEST_END(CoulombPairTest)
+
+#endif
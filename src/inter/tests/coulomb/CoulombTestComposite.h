@@ -0,0 +1,14 @@
+#ifndef COULOMB_TEST_COMPOSITE_H
+#define COULOMB_TEST_COMPOSITE_H
+
+#include <test/CompositeTestRunner.h>
+
+#include "CoulombPairTest.h"
+#include "KSpaceTest.h"
+
+TEST_COMPOSITE_BEGIN(CoulombTestComposite)
+TEST_COMPOSITE_ADD_UNIT(CoulombPairTest);
+TEST_COMPOSITE_ADD_UNIT(KSpaceTest);
+TEST_COMPOSITE_END
+
+#endif
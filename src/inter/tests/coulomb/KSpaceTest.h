@@ -0,0 +1,282 @@
+#ifndef K_SPACE_TEST_H
+#define K_SPACE_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <inter/coulomb/EwaldInteraction.h>
+#include <inter/coulomb/EwaldKSpace.h>
+#include <inter/coulomb/SpmeKSpace.h>
+#include <util/boundary/Boundary.h>
+#include <util/containers/DArray.h>
+#include <util/random/Random.h>
+#include <util/math/Constants.h>
+
+#include <iostream>
+#include <fstream>
+
+using namespace Util;
+using namespace Inter;
+
+class KSpaceTest : public UnitTest
+{
+
+private:
+
+   EwaldInteraction ewald_;
+   EwaldKSpace ewaldKSpace_;
+   SpmeKSpace spmeKSpace_;
+   Boundary boundary_;
+   DArray<Vector> positions_;
+   DArray<double> charges_;
+   int nCharge_;
+
+   /*
+   * Read parameter file into a ParamComposite.
+   */
+   void readParamFile(std::string filename, ParamComposite& object)
+   {
+      std::ifstream in;
+      openInputFile(filename, in);
+      object.readParameters(in);
+      in.close();
+   }
+
+   /*
+   * Allocate arrays for n charges.
+   */
+   void allocate(int n)
+   {
+      nCharge_ = n;
+      positions_.allocate(n);
+      charges_.allocate(n);
+   }
+
+   /*
+   * Random neutral system of alternating charges in a cubic box.
+   */
+   void makeRandomSystem(int n, double length)
+   {
+      allocate(n);
+      boundary_.setCubic(length);
+      Random random;
+      random.setSeed(5);
+      for (int i = 0; i < n; ++i) {
+         boundary_.randomPosition(random, positions_[i]);
+         charges_[i] = (i % 2) ? 1.0 : -1.0;
+      }
+   }
+
+   /*
+   * Rock salt lattice with nearest neighbor distance 1, and n unit
+   * cells (of 8 ions) along each axis.
+   */
+   void makeRockSalt(int n)
+   {
+      allocate(8*n*n*n);
+      boundary_.setCubic(2.0*n);
+      int i, j, k, m = 0;
+      for (i = 0; i < 2*n; ++i) {
+         for (j = 0; j < 2*n; ++j) {
+            for (k = 0; k < 2*n; ++k) {
+               positions_[m] = Vector(i + 0.5, j + 0.5, k + 0.5);
+               charges_[m] = ((i + j + k) % 2) ? 1.0 : -1.0;
+               ++m;
+            }
+         }
+      }
+   }
+
+   /*
+   * Compute k-space energy, and optionally forces.
+   */
+   template <class KSpace>
+   double kSpaceEnergy(KSpace& kSpace, DArray<Vector>* forces = 0)
+   {
+      int i;
+      kSpace.setup(boundary_, ewald_);
+      kSpace.clear();
+      for (i = 0; i < nCharge_; ++i) {
+         kSpace.addCharge(positions_[i], charges_[i]);
+      }
+      kSpace.solve();
+      if (forces) {
+         for (i = 0; i < nCharge_; ++i) {
+            (*forces)[i].zero();
+            kSpace.addForce(positions_[i], charges_[i], (*forces)[i]);
+         }
+      }
+      return kSpace.energy();
+   }
+
+   /*
+   * Compute real space energy, by a minimum image double loop.
+   */
+   double rSpaceEnergy()
+   {
+      Vector dr;
+      double rsq;
+      double energy = 0.0;
+      int i, j;
+      for (i = 1; i < nCharge_; ++i) {
+         for (j = 0; j < i; ++j) {
+            rsq = boundary_.distanceSq(positions_[i], positions_[j], dr);
+            if (rsq < ewald_.rSpaceCutoffSq()) {
+               energy += ewald_.rSpaceEnergy(rsq, charges_[i]*charges_[j]);
+            }
+         }
+      }
+      return energy;
+   }
+
+   /*
+   * Compare Madelung energy of rock salt to known value.
+   */
+   template <class KSpace>
+   void testMadelung(KSpace& kSpace)
+   {
+      makeRockSalt(4);
+
+      // Unit Coulomb prefactor 1/(4 pi epsilon) = 1
+      ewald_.set("epsilon", 0.25/Constants::Pi);
+      ewald_.set("alpha", 1.0);
+      ewald_.set("rSpaceCutoff", 3.9);
+
+      double chargeSqSum = double(nCharge_);
+      double energy = rSpaceEnergy() + kSpaceEnergy(kSpace)
+                    + ewald_.selfEnergy(chargeSqSum);
+      double madelung = -2.0*energy/double(nCharge_);
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         std::cout << "Madelung constant = " << madelung << std::endl;
+      }
+      TEST_ASSERT(std::abs(madelung - 1.747564594633) < 1.0E-5);
+   }
+
+public:
+
+   KSpaceTest()
+    : nCharge_(0)
+   {}
+
+   void setUp()
+   {
+      readParamFile("in/EwaldInteraction", ewald_);
+      readParamFile("in/EwaldKSpace", ewaldKSpace_);
+      readParamFile("in/SpmeKSpace", spmeKSpace_);
+   }
+
+   void testEwaldMadelung()
+   {
+      printMethod(TEST_FUNC);
+      testMadelung(ewaldKSpace_);
+   }
+
+   void testSpmeMadelung()
+   {
+      printMethod(TEST_FUNC);
+      testMadelung(spmeKSpace_);
+   }
+
+   void testSpmeEnergyForce()
+   {
+      printMethod(TEST_FUNC);
+      makeRandomSystem(20, 6.0);
+      DArray<Vector> ewaldForces;
+      DArray<Vector> spmeForces;
+      ewaldForces.allocate(nCharge_);
+      spmeForces.allocate(nCharge_);
+
+      double ewaldEnergy = kSpaceEnergy(ewaldKSpace_, &ewaldForces);
+      double spmeEnergy  = kSpaceEnergy(spmeKSpace_, &spmeForces);
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         std::cout << "Ewald energy = " << ewaldEnergy << std::endl;
+         std::cout << "SPME energy  = " << spmeEnergy << std::endl;
+      }
+      TEST_ASSERT(std::abs(ewaldEnergy - spmeEnergy) < 1.0E-5);
+
+      int i, j;
+      for (i = 0; i < nCharge_; ++i) {
+         for (j = 0; j < Dimension; ++j) {
+            TEST_ASSERT(std::abs(ewaldForces[i][j] - spmeForces[i][j]) < 1.0E-5);
+         }
+      }
+
+      // Compare SPME forces to finite differences of SPME energy
+      double h = 1.0E-5;
+      double ep, em;
+      Vector r0;
+      for (i = 0; i < 3; ++i) {
+         r0 = positions_[i];
+         for (j = 0; j < Dimension; ++j) {
+            positions_[i][j] = r0[j] + h;
+            ep = kSpaceEnergy(spmeKSpace_);
+            positions_[i][j] = r0[j] - h;
+            em = kSpaceEnergy(spmeKSpace_);
+            positions_[i] = r0;
+            TEST_ASSERT(std::abs(spmeForces[i][j] + 0.5*(ep - em)/h) < 1.0E-7);
+         }
+      }
+   }
+
+   void testStress()
+   {
+      printMethod(TEST_FUNC);
+      makeRandomSystem(20, 6.0);
+
+      // Compare diagonal stress to derivative of energy under a uniaxial
+      // deformation of the box and positions.
+      double length = 6.0;
+      double volume = length*length*length;
+      double eps = 1.0E-6;
+      kSpaceEnergy(ewaldKSpace_);
+      Tensor ewaldStress = ewaldKSpace_.stress();
+      kSpaceEnergy(spmeKSpace_);
+      Tensor spmeStress = spmeKSpace_.stress();
+
+      DArray<Vector> r0;
+      r0.allocate(nCharge_);
+      Vector lengths;
+      double ewaldP, ewaldM, spmeP, spmeM, dEwald, dSpme;
+      int i, j;
+      for (i = 0; i < nCharge_; ++i) {
+         r0[i] = positions_[i];
+      }
+      for (j = 0; j < Dimension; ++j) {
+         lengths = Vector(length);
+         lengths[j] = length*(1.0 + eps);
+         boundary_.setOrthorhombic(lengths);
+         for (i = 0; i < nCharge_; ++i) {
+            positions_[i][j] = r0[i][j]*(1.0 + eps);
+         }
+         ewaldP = kSpaceEnergy(ewaldKSpace_);
+         spmeP = kSpaceEnergy(spmeKSpace_);
+         lengths[j] = length*(1.0 - eps);
+         boundary_.setOrthorhombic(lengths);
+         for (i = 0; i < nCharge_; ++i) {
+            positions_[i][j] = r0[i][j]*(1.0 - eps);
+         }
+         ewaldM = kSpaceEnergy(ewaldKSpace_);
+         spmeM = kSpaceEnergy(spmeKSpace_);
+         for (i = 0; i < nCharge_; ++i) {
+            positions_[i] = r0[i];
+         }
+         dEwald = -0.5*(ewaldP - ewaldM)/(eps*volume);
+         dSpme = -0.5*(spmeP - spmeM)/(eps*volume);
+         TEST_ASSERT(std::abs(ewaldStress(j, j) - dEwald) < 1.0E-9);
+         TEST_ASSERT(std::abs(spmeStress(j, j) - dSpme) < 1.0E-9);
+      }
+      boundary_.setCubic(length);
+   }
+
+};
+
+TEST_BEGIN(KSpaceTest)
+TEST_ADD(KSpaceTest, testEwaldMadelung)
+TEST_ADD(KSpaceTest, testSpmeMadelung)
+TEST_ADD(KSpaceTest, testSpmeEnergyForce)
+TEST_ADD(KSpaceTest, testStress)
+TEST_END(KSpaceTest)
+
+#endif
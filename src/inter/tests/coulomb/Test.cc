@@ -0,0 +1,7 @@
+#include "CoulombTestComposite.h"
+
+int main() 
+{
+   CoulombTestComposite runner;
+   runner.run();
+}
@@ -0,0 +1,7 @@
+inter_tests_coulomb_=inter/tests/coulomb/Test.cc
+
+inter_tests_coulomb_SRCS=\
+     $(addprefix $(SRC_DIR)/, $(inter_tests_coulomb_))
+inter_tests_coulomb_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(inter_tests_coulomb_:.cc=.o))
+
@@ -5,10 +5,14 @@
 
 #include "LJPairTest.h"
 #include "DpdPairTest.h"
+#include "TablePairTest.h"
+#include "SoftCoreLJPairTest.h"
 
 TEST_COMPOSITE_BEGIN(PairTestComposite)
 TEST_COMPOSITE_ADD_UNIT(LJPairTest);
 TEST_COMPOSITE_ADD_UNIT(DpdPairTest);
+TEST_COMPOSITE_ADD_UNIT(TablePairTest);
+TEST_COMPOSITE_ADD_UNIT(SoftCoreLJPairTest);
 TEST_COMPOSITE_END
 
 #endif
@@ -0,0 +1,168 @@
+#ifndef SOFT_CORE_LJ_PAIR_TEST_H
+#define SOFT_CORE_LJ_PAIR_TEST_H
+
+#include <inter/pair/SoftCoreLJPair.h>
+#include <inter/pair/LJPair.h>
+#include <inter/tests/pair/PairTestTemplate.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+using namespace Util;
+using namespace Inter;
+
+class SoftCoreLJPairTest : public PairTestTemplate<SoftCoreLJPair>
+{
+
+protected:
+
+   PairTestTemplate<SoftCoreLJPair>::setNAtomType;
+   PairTestTemplate<SoftCoreLJPair>::readParamFile;
+   PairTestTemplate<SoftCoreLJPair>::forceOverR;
+   PairTestTemplate<SoftCoreLJPair>::energy;
+
+public:
+
+   void setUp()
+   {
+      eps_ = 1.0E-6;
+      setNAtomType(2);
+      readParamFile("in/SoftCoreLJPair");
+   }
+
+   void testSetUp() 
+   {
+      printMethod(TEST_FUNC);
+      if (verbose() > 0) {
+         std::cout << std::endl; 
+         interaction_.writeParam(std::cout);
+      }
+      TEST_ASSERT(eq(interaction_.lambda(0, 1), 0.5));
+      TEST_ASSERT(eq(interaction_.lambda(1, 0), 0.5));
+      TEST_ASSERT(eq(interaction_.lambda(0, 0), 1.0));
+      TEST_ASSERT(eq(interaction_.alpha(), 0.5));
+   }
+
+   void testLJLimit() 
+   {
+      printMethod(TEST_FUNC);
+
+      // For lambda = 1, compare to an equivalent LJPair
+      std::stringstream in;
+      in << "epsilon 1.0 2.0 2.0 1.0 ";
+      in << "sigma   1.0 1.0 1.0 1.0 ";
+      in << "cutoff  2.5 2.5 2.5 2.5 ";
+      LJPair lj;
+      lj.setNAtomType(2);
+      lj.readParameters(in);
+      interaction_.setLambda(0, 1, 1.0);
+
+      double rsq;
+      int i, j, k;
+      for (i = 0; i < 2; ++i) {
+         for (j = 0; j < 2; ++j) {
+            for (k = 0; k < 50; ++k) {
+               rsq = 0.81 + (6.25 - 0.81)*(k + 0.5)/50.0;
+               TEST_ASSERT(eq(energy(rsq, i, j), lj.energy(rsq, i, j)));
+               TEST_ASSERT(eq(forceOverR(rsq, i, j), 
+                              lj.forceOverR(rsq, i, j)));
+            }
+         }
+      }
+   }
+
+   void testForceOverR() 
+   {
+      printMethod(TEST_FUNC);
+ 
+      type1_ = 0;
+      type2_ = 1;
+
+      rsq_ = 0.25;
+      TEST_ASSERT(testForce());
+      rsq_ = 0.64;
+      TEST_ASSERT(testForce());
+      rsq_ = 1.00;
+      TEST_ASSERT(testForce());
+      rsq_ = 2.00;
+      TEST_ASSERT(testForce());
+
+      // Energy is finite at r = 0 for lambda < 1, and zero at cutoff
+      TEST_ASSERT(energy(0.0, 0, 1) > 0.0);
+      TEST_ASSERT(energy(0.0, 0, 1) < 100.0);
+      TEST_ASSERT(eq(energy(6.25, 0, 1), 0.0));
+   }
+
+   void testLambda() 
+   {
+      printMethod(TEST_FUNC);
+
+      double lambdas[4] = {0.0, 0.5, 0.3, 1.0};
+      double energies[4];
+      double rsq, h, dEdL, e0, e1;
+      int k;
+
+      h = 1.0E-5;
+      for (k = 0; k < 20; ++k) {
+         rsq = 0.05 + (6.25 - 0.05)*(k + 0.5)/20.0;
+         interaction_.energies(rsq, 0, 1, lambdas, 4, energies);
+         TEST_ASSERT(eq(energies[0], 0.0));
+         TEST_ASSERT(eq(energies[1], energy(rsq, 0, 1)));
+
+         // Compare dV/dlambda to finite difference at lambda = 0.3
+         interaction_.setLambda(0, 1, 0.3);
+         TEST_ASSERT(eq(energies[2], energy(rsq, 0, 1)));
+         dEdL = interaction_.dEnergyDLambda(rsq, 0, 1);
+         interaction_.setLambda(0, 1, 0.3 + h);
+         e1 = energy(rsq, 0, 1);
+         interaction_.setLambda(0, 1, 0.3 - h);
+         e0 = energy(rsq, 0, 1);
+         TEST_ASSERT(fabs(dEdL - 0.5*(e1 - e0)/h) < 1.0E-5*(fabs(dEdL) + 1.0));
+
+         interaction_.setLambda(0, 1, 1.0);
+         TEST_ASSERT(eq(energies[3], energy(rsq, 0, 1)));
+         interaction_.setLambda(0, 1, 0.5);
+      }
+   }
+
+   void testSaveLoad() 
+   {
+      printMethod(TEST_FUNC);
+
+      interaction_.set("lambda", 0, 1, 0.7);
+      interaction_.set("epsilon", 0, 1, 1.5);
+
+      Serializable::OArchive oar;
+      openOutputFile("out/SoftCoreLJPair.rst", oar.file());
+      interaction_.save(oar);
+      oar.file().close();
+
+      Serializable::IArchive iar;
+      openInputFile("out/SoftCoreLJPair.rst", iar.file());
+      SoftCoreLJPair clone;
+      clone.setNAtomType(2);
+      clone.loadParameters(iar);
+
+      TEST_ASSERT(eq(clone.lambda(1, 0), 0.7));
+      TEST_ASSERT(eq(clone.get("epsilon", 1, 0), 1.5));
+      TEST_ASSERT(eq(clone.alpha(), interaction_.alpha()));
+      TEST_ASSERT(eq(clone.maxPairCutoff(), 2.5));
+      TEST_ASSERT(eq(interaction_.energy(0.95, 0, 1), clone.energy(0.95, 0, 1)));
+      TEST_ASSERT(eq(interaction_.forceOverR(0.95, 0, 1), 
+                     clone.forceOverR(0.95, 0, 1)));
+      TEST_ASSERT(eq(interaction_.dEnergyDLambda(0.95, 0, 1), 
+                     clone.dEnergyDLambda(0.95, 0, 1)));
+   }
+
+};
+
+TEST_BEGIN(SoftCoreLJPairTest)
+TEST_ADD(SoftCoreLJPairTest, testSetUp)
+TEST_ADD(SoftCoreLJPairTest, testLJLimit)
+TEST_ADD(SoftCoreLJPairTest, testForceOverR)
+TEST_ADD(SoftCoreLJPairTest, testLambda)
+TEST_ADD(SoftCoreLJPairTest, testSaveLoad)
+TEST_END(SoftCoreLJPairTest)
+
+#endif
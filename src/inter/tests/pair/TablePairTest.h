@@ -0,0 +1,193 @@
+#ifndef TABLE_PAIR_TEST_H
+#define TABLE_PAIR_TEST_H
+
+#include <inter/pair/TablePair.h>
+#include <inter/pair/TabulatedPair.h>
+#include <inter/pair/LJPair.h>
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/archives/Serializable_includes.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+using namespace Util;
+using namespace Inter;
+
+class TablePairTest : public UnitTest
+{
+
+private:
+
+   LJPair lj_;
+   TabulatedPair<LJPair> tabulated_;
+
+   /*
+   * Return true if the interaction agrees with lj_ to within a
+   * relative tolerance, for all type pairs and rMin < r < cutoff.
+   */
+   template <class Interaction>
+   bool matchesLJ(const Interaction& interaction, double tolerance)
+   {
+      double rsqMin = 0.81;
+      double rsqMax = lj_.cutoffSq(0, 0);
+      double rsq, e, f, e0, f0;
+      int i, j, k;
+      for (i = 0; i < 2; ++i) {
+         for (j = 0; j < 2; ++j) {
+            for (k = 0; k < 97; ++k) {
+               rsq = rsqMin + (rsqMax - rsqMin)*(k + 0.37)/97.0;
+               e0 = lj_.energy(rsq, i, j);
+               f0 = lj_.forceOverR(rsq, i, j);
+               e  = interaction.energy(rsq, i, j);
+               f  = interaction.forceOverR(rsq, i, j);
+               if (fabs(e - e0) > tolerance*(fabs(e0) + 1.0)) {
+                  std::cout << std::endl << "rsq = " << rsq 
+                            << "  energy " << e << " " << e0;
+                  return false;
+               }
+               if (fabs(f - f0) > tolerance*(fabs(f0) + 1.0)) {
+                  std::cout << std::endl << "rsq = " << rsq 
+                            << "  forceOverR " << f << " " << f0;
+                  return false;
+               }
+            }
+         }
+      }
+      return true;
+   }
+
+public:
+
+   void setUp()
+   {
+      std::ifstream in;
+      lj_.setNAtomType(2);
+      openInputFile("in/LJPair", in);
+      lj_.readParameters(in);
+      in.close();
+
+      tabulated_.setNAtomType(2);
+      openInputFile("in/TabulatedPair", in);
+      tabulated_.readParameters(in);
+      in.close();
+   }
+
+   void testTabulated()
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(eq(tabulated_.maxPairCutoff(), lj_.maxPairCutoff()));
+      TEST_ASSERT(eq(tabulated_.cutoffSq(0, 1), lj_.cutoffSq(0, 1)));
+      TEST_ASSERT(matchesLJ(tabulated_, 1.0E-5));
+      TEST_ASSERT(eq(tabulated_.energy(1.3, 0, 1), 0.0));
+
+      // Values below rMin are those at rMin
+      TEST_ASSERT(eq(tabulated_.energy(0.5, 0, 1), 
+                     tabulated_.energy(0.64, 0, 1)));
+      TEST_ASSERT(eq(tabulated_.forceOverR(0.5, 0, 1), 
+                     tabulated_.forceOverR(0.64, 0, 1)));
+   }
+
+   void testModify()
+   {
+      printMethod(TEST_FUNC);
+      tabulated_.set("epsilon", 0, 1, 1.3);
+      lj_.set("epsilon", 0, 1, 1.3);
+      TEST_ASSERT(eq(tabulated_.get("epsilon", 1, 0), 1.3));
+      TEST_ASSERT(matchesLJ(tabulated_, 1.0E-5));
+   }
+
+   void testZeroRMin()
+   {
+      printMethod(TEST_FUNC);
+      std::ifstream in;
+      openInputFile("in/TabulatedPair", in);
+      std::string text;
+      std::getline(in, text, '\0');
+      in.close();
+      std::string::size_type pos = text.find("0.80");
+      text.replace(pos, 4, "0.00");
+
+      TabulatedPair<LJPair> tabulated;
+      tabulated.setNAtomType(2);
+      std::istringstream zeroIn(text);
+      bool thrown = false;
+      try {
+         tabulated.readParameters(zeroIn);
+      } catch (Exception e) {
+         thrown = true;
+      }
+      TEST_ASSERT(thrown);
+   }
+
+   void testReadFile()
+   {
+      printMethod(TEST_FUNC);
+
+      // Write tables for LJPair, on a grid uniform in r 
+      std::ofstream out;
+      openOutputFile("out/TablePair.tab", out);
+      out << std::setprecision(16);
+      double rMin = 0.8;
+      double cutoff = sqrt(lj_.cutoffSq(0, 0));
+      int n = 201;
+      double r, rsq;
+      int i, j, k;
+      for (i = 0; i < 2; ++i) {
+         for (j = i; j < 2; ++j) {
+            out << i << " " << j << " " << n << std::endl;
+            for (k = 0; k < n; ++k) {
+               r = rMin + (cutoff - rMin)*double(k)/double(n - 1);
+               rsq = r*r;
+               out << r << " " << lj_.energy(rsq, i, j) << " " 
+                   << r*lj_.forceOverR(rsq, i, j) << std::endl;
+            }
+         }
+      }
+      out.close();
+
+      // Read tables
+      std::stringstream in;
+      in << "fileName " << filePrefix() << "out/TablePair.tab" << std::endl;
+      in << "nPoint   400" << std::endl;
+      TablePair table;
+      table.setNAtomType(2);
+      table.readParameters(in);
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         table.writeParam(std::cout);
+      }
+      TEST_ASSERT(eq(table.maxPairCutoff(), lj_.maxPairCutoff()));
+      TEST_ASSERT(matchesLJ(table, 1.0E-4));
+
+      // Save and load
+      Serializable::OArchive oar;
+      openOutputFile("out/TablePair.rst", oar.file());
+      table.save(oar);
+      oar.file().close();
+
+      Serializable::IArchive iar;
+      openInputFile("out/TablePair.rst", iar.file());
+      TablePair clone;
+      clone.setNAtomType(2);
+      clone.loadParameters(iar);
+      TEST_ASSERT(eq(clone.maxPairCutoff(), table.maxPairCutoff()));
+      TEST_ASSERT(clone.nPoint() == table.nPoint());
+      TEST_ASSERT(eq(clone.energy(0.95, 0, 1), table.energy(0.95, 0, 1)));
+      TEST_ASSERT(eq(clone.forceOverR(0.95, 0, 1), 
+                     table.forceOverR(0.95, 0, 1)));
+   }
+
+};
+
+TEST_BEGIN(TablePairTest)
+TEST_ADD(TablePairTest, testTabulated)
+TEST_ADD(TablePairTest, testModify)
+TEST_ADD(TablePairTest, testZeroRMin)
+TEST_ADD(TablePairTest, testReadFile)
+TEST_END(TablePairTest)
+
+#endif
@@ -129,6 +129,12 @@ namespace McMd
       ar & outputFileName_;
    }
 
+   /*
+   * Sample from a snapshot (default implementation).
+   */
+   void Analyzer::sampleSnapshot(const SystemSnapshot& snapshot)
+   {  UTIL_THROW("Analyzer does not implement sampleSnapshot"); }
+
    /*
    * Set the FileMaster.
    */
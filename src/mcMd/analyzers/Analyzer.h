@@ -20,6 +20,8 @@ namespace McMd
 
    using namespace Util;
 
+   class SystemSnapshot;
+
    /**
    * Abstract base for periodic output and/or analysis actions.
    *
@@ -47,6 +49,12 @@ namespace McMd
    * SystemAnalyzer<MdSystem> or SystemAnalyzer<MdSystem>, 
    * respectively.
    *
+   * An Analyzer that needs only the atomic positions, atom types and 
+   * boundary may also re-implement isSnapshotAnalyzer() to return true, 
+   * and implement sampleSnapshot(). Such an analyzer may then be run 
+   * asynchronously by the AnalyzerManager, on a copy of the system 
+   * state stored in a SystemSnapshot.
+   *
    * \ingroup McMd_Analyzer_Module
    */
    class Analyzer : public ParamComposite
@@ -129,6 +137,29 @@ namespace McMd
       */
       virtual void sample(long iStep) = 0;
 
+      /**
+      * Calculate, analyze and/or output a quantity from a snapshot.
+      *
+      * This method is called by the AnalyzerManager instead of sample()
+      * for analyzers for which isSnapshotAnalyzer() returns true. It is
+      * called only at steps that are multiples of interval, possibly 
+      * from a worker thread while the simulation continues, and must 
+      * thus not access the parent System or Simulation. 
+      *
+      * The default implementation throws an Exception.
+      *
+      * \param snapshot copy of the system state at snapshot.iStep()
+      */
+      virtual void sampleSnapshot(const SystemSnapshot& snapshot);
+
+      /**
+      * Does this analyzer implement sampleSnapshot()?
+      *
+      * The default implementation returns false.
+      */
+      virtual bool isSnapshotAnalyzer() const
+      {  return false; }
+
       /**
       * Output any results at the end of the simulation.
       *
@@ -5,9 +5,14 @@
 * Distributed under the terms of the GNU General Public License.
 */
 
-#include "AnalyzerManager.h" 
-#include "Analyzer.h" 
+#include "AnalyzerManager.h"
+#include "Analyzer.h"
+#include <mcMd/simulation/System.h>
 #include <util/archives/Serializable_includes.h>
+#include <util/param/Parameter.h>
+#include <util/misc/Log.h>
+
+#include <exception>
 
 namespace McMd
 {
@@ -18,53 +23,236 @@ namespace McMd
    * Constructor.
    */
    AnalyzerManager::AnalyzerManager()
-   : Manager<Analyzer>()
+   : Manager<Analyzer>(),
+     snapshots_(),
+     errorMessage_(),
+     systemPtr_(0),
+     nSnapshot_(0),
+     head_(0),
+     nPending_(0),
+     isStopping_(false),
+     isOk_(true)
    {  setClassName("AnalyzerManager"); }
 
    /*
    * Destructor.
    */
    AnalyzerManager::~AnalyzerManager()
-   {} 
+   {  stop(); }
+
+   /*
+   * Set the parent System.
+   */
+   void AnalyzerManager::setSystem(System& system)
+   {  systemPtr_ = &system; }
 
    /*
-   * Read parameter file. 
+   * Read parameter file.
    *
    * \param in input parameter file stream.
    */
    void AnalyzerManager::readParameters(std::istream &in)
    {
+      nSnapshot_ = 0;
+      readOptional<int>(in, "nSnapshot", nSnapshot_);
+      allocate();
       read<long>(in,"baseInterval", Analyzer::baseInterval);
       Manager<Analyzer>::readParameters(in);
    }
 
+   /*
+   * Allocate the snapshot ring, or a single snapshot (private).
+   */
+   void AnalyzerManager::allocate()
+   {
+      if (nSnapshot_ < 0) {
+         UTIL_THROW("Negative nSnapshot");
+      }
+      if (nSnapshot_ > 0 && !systemPtr_) {
+         UTIL_THROW("No parent System: nSnapshot must be 0");
+      }
+      if (systemPtr_) {
+         #ifdef UTIL_CXX11
+         snapshots_.allocate(nSnapshot_ > 0 ? nSnapshot_ : 1);
+         #else
+         snapshots_.allocate(1);
+         #endif
+      }
+   }
+
    /*
    * Call initialize method of each analyzer.
    */
-   void AnalyzerManager::setup() 
+   void AnalyzerManager::setup()
    {
+      wait();
       for (int i = 0; i < size(); ++i) {
          (*this)[i].setup();
       }
    }
- 
+
    /*
    * Call sample method of each analyzer.
    */
-   void AnalyzerManager::sample(long iStep) 
+   void AnalyzerManager::sample(long iStep)
+   {
+      if (iStep % Analyzer::baseInterval != 0) return;
+
+      // Call sample for all analyzers that are not run on snapshots
+      bool isDue = false;
+      for (int i=0; i < size(); ++i) {
+         Analyzer& analyzer = (*this)[i];
+         if (systemPtr_ && analyzer.isSnapshotAnalyzer()) {
+            if (analyzer.isAtInterval(iStep)) {
+               isDue = true;
+            }
+         } else {
+            analyzer.sample(iStep);
+         }
+      }
+      if (!isDue) return;
+
+      #ifdef UTIL_CXX11
+      if (nSnapshot_ > 0) {
+
+         // Wait for a free snapshot, or for an error
+         std::unique_lock<std::mutex> lock(mutex_);
+         while (nPending_ >= nSnapshot_ && isOk_) {
+            cond_.wait(lock);
+         }
+         if (!isOk_) {
+            lock.unlock();
+            wait();
+            lock.lock();
+         }
+         int slot = head_;
+         lock.unlock();
+
+         // The snapshot at head_ is not pending, and may be overwritten
+         snapshots_[slot].record(*systemPtr_, iStep);
+
+         lock.lock();
+         head_ = (head_ + 1) % nSnapshot_;
+         ++nPending_;
+         lock.unlock();
+         cond_.notify_all();
+
+         if (!worker_.joinable()) {
+            worker_ = std::thread(&AnalyzerManager::work, this);
+         }
+         return;
+      }
+      #endif
+
+      // Sample in this thread, from one snapshot shared by all analyzers
+      snapshots_[0].record(*systemPtr_, iStep);
+      sampleSnapshot(snapshots_[0]);
+   }
+
+   /*
+   * Call sampleSnapshot for each snapshot analyzer due at a step (private).
+   */
+   void AnalyzerManager::sampleSnapshot(const SystemSnapshot& snapshot)
    {
-      if (iStep % Analyzer::baseInterval == 0) { 
-         for (int i=0; i < size(); ++i) {
-            (*this)[i].sample(iStep);
+      long iStep = snapshot.iStep();
+      for (int i=0; i < size(); ++i) {
+         Analyzer& analyzer = (*this)[i];
+         if (analyzer.isSnapshotAnalyzer() && analyzer.isAtInterval(iStep)) {
+            analyzer.sampleSnapshot(snapshot);
+         }
+      }
+   }
+
+   /*
+   * Process pending snapshots in order of recording (private).
+   */
+   void AnalyzerManager::work()
+   {
+      #ifdef UTIL_CXX11
+      std::unique_lock<std::mutex> lock(mutex_);
+      int tail;
+      while (true) {
+         while (nPending_ == 0 && !isStopping_) {
+            cond_.wait(lock);
+         }
+         if (nPending_ == 0) break;
+         tail = (head_ - nPending_ + nSnapshot_) % nSnapshot_;
+         lock.unlock();
+
+         try {
+            sampleSnapshot(snapshots_[tail]);
+         } catch (Exception& e) {
+            setError(e.message());
+         } catch (std::exception& e) {
+            setError(e.what());
+         }
+
+         // Release the snapshot only after it has been processed
+         lock.lock();
+         --nPending_;
+         cond_.notify_all();
+      }
+      #endif
+   }
+
+   /*
+   * Record the first error thrown by the worker thread (private).
+   */
+   void AnalyzerManager::setError(const std::string& message)
+   {
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (isOk_) {
+         errorMessage_ = message;
+         isOk_ = false;
+      }
+      #endif
+   }
+
+   /*
+   * Wait for the worker to process all pending snapshots.
+   */
+   void AnalyzerManager::wait()
+   {
+      #ifdef UTIL_CXX11
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (nPending_ > 0) {
+         cond_.wait(lock);
+      }
+      if (!isOk_) {
+         std::string message = errorMessage_;
+         isOk_ = true;
+         errorMessage_.clear();
+         lock.unlock();
+         Log::file() << message << std::endl;
+         UTIL_THROW("Error in asynchronous analyzer");
+      }
+      #endif
+   }
+
+   /*
+   * Stop and join the worker thread (private).
+   */
+   void AnalyzerManager::stop()
+   {
+      #ifdef UTIL_CXX11
+      if (worker_.joinable()) {
+         {
+            std::lock_guard<std::mutex> lock(mutex_);
+            isStopping_ = true;
          }
+         cond_.notify_all();
+         worker_.join();
       }
+      #endif
    }
- 
+
    /*
    * Call output method of each analyzer.
    */
-   void AnalyzerManager::output() 
+   void AnalyzerManager::output()
    {
+      wait();
       for (int i=0; i < size(); ++i) {
          (*this)[i].output();
       }
@@ -75,6 +263,9 @@ namespace McMd
    */
    void AnalyzerManager::loadParameters(Serializable::IArchive &ar)
    {
+      nSnapshot_ = 0;
+      loadParameter<int>(ar, "nSnapshot", nSnapshot_, false);
+      allocate();
       loadParameter<long>(ar,"baseInterval", Analyzer::baseInterval);
       Manager<Analyzer>::loadParameters(ar);
    }
@@ -84,6 +275,8 @@ namespace McMd
    */
    void AnalyzerManager::save(Serializable::OArchive &ar)
    {
+      wait();
+      Parameter::saveOptional(ar, nSnapshot_, bool(nSnapshot_ > 0));
       ar << Analyzer::baseInterval;
       Manager<Analyzer>::save(ar);
    }
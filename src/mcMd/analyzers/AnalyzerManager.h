@@ -9,16 +9,47 @@
 */
 
 #include "Analyzer.h"                  // template parameter
+#include "SystemSnapshot.h"            // member template parameter
 #include <util/param/Manager.h>          // base class template
+#include <util/containers/DArray.h>      // member template
+
+#include <string>
+
+#ifdef UTIL_CXX11
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
 
 namespace McMd
 {
 
    using namespace Util;
 
+   class System;
+
    /**
    * Manager for a list of Analyzer objects.
    *
+   * The sample() method of every analyzer is called in the main 
+   * simulation loop, except for analyzers for which 
+   * Analyzer::isSnapshotAnalyzer() returns true. At each step at 
+   * which any such analyzer is due, the positions, atom types and 
+   * boundary of the parent System are copied once into a 
+   * SystemSnapshot, and Analyzer::sampleSnapshot() is called for each
+   * due analyzer. By default, this is done in the calling thread. If 
+   * the optional parameter nSnapshot is positive, snapshots are instead
+   * recorded into the next element of a ring of nSnapshot preallocated
+   * SystemSnapshot objects, and are analyzed by a worker thread while
+   * the simulation continues. Snapshots are processed in the order in 
+   * which they were recorded, and analyzers are called in the order in
+   * which they appear in the parameter file, so the output is identical
+   * to that obtained with nSnapshot = 0. If all nSnapshot snapshots are
+   * waiting to be processed, sample() blocks until the worker releases
+   * one. All pending snapshots are processed before setup(), output() 
+   * or save() returns. If UTIL_CXX11 is not defined, nSnapshot is 
+   * accepted but snapshots are always analyzed in the calling thread.
+   *
    * \ingroup McMd_Manager_Module
    * \ingroup McMd_Analyzer_Module
    */
@@ -69,6 +100,11 @@ namespace McMd
  
       /**
       * Call sample method of each Analyzer.
+      *
+      * If nSnapshot > 0, record a snapshot for any snapshot analyzers
+      * that are due at this step, and pass it to the worker thread.
+      *
+      * \param iStep current simulation step index
       */
       void sample(long iStep);
  
@@ -77,7 +113,97 @@ namespace McMd
       */
       void output();
 
+      /**
+      * Wait for the worker thread to process all pending snapshots.
+      *
+      * Throws an Exception if a snapshot analyzer threw an Exception.
+      */
+      void wait();
+
+      /**
+      * Get the maximum number of snapshots awaiting analysis.
+      *
+      * A value of zero indicates synchronous sampling.
+      */
+      int nSnapshot() const;
+
+   protected:
+
+      /**
+      * Set the parent System, from which snapshots are recorded.
+      *
+      * \param system parent System
+      */
+      void setSystem(System& system);
+
+   private:
+
+      /// Ring of snapshots.
+      DArray<SystemSnapshot> snapshots_;
+
+      /// Message of any exception thrown by the worker thread.
+      std::string errorMessage_;
+
+      /// Pointer to parent System.
+      System* systemPtr_;
+
+      /// Capacity of the snapshots_ ring (0 if synchronous).
+      int nSnapshot_;
+
+      /// Index of the next snapshot to be recorded.
+      int head_;
+
+      /// Number of snapshots awaiting analysis.
+      int nPending_;
+
+      /// Has the worker thread been asked to stop?
+      bool isStopping_;
+
+      /// Did all snapshot analyzers complete without error?
+      bool isOk_;
+
+      #ifdef UTIL_CXX11
+      /// Worker thread.
+      std::thread worker_;
+
+      /// Mutex for head_, nPending_, isStopping_, isOk_ and errorMessage_.
+      std::mutex mutex_;
+
+      /// Condition variable, signalled whenever nPending_ changes.
+      std::condition_variable cond_;
+      #endif
+
+      /*
+      * Allocate the snapshot ring, or a single synchronous snapshot.
+      */
+      void allocate();
+
+      /*
+      * Call sampleSnapshot for each snapshot analyzer due at a step.
+      */
+      void sampleSnapshot(const SystemSnapshot& snapshot);
+
+      /*
+      * Process snapshots until asked to stop (worker thread).
+      */
+      void work();
+
+      /*
+      * Record the first error thrown by the worker thread.
+      */
+      void setError(const std::string& message);
+
+      /*
+      * Stop and join the worker thread, if any.
+      */
+      void stop();
+
    };
 
+   // Inline method
+
+   inline int AnalyzerManager::nSnapshot() const
+   {  return nSnapshot_; }
+
 }
 #endif
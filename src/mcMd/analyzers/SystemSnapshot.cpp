@@ -0,0 +1,67 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "SystemSnapshot.h"
+#include <mcMd/simulation/System.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   SystemSnapshot::SystemSnapshot()
+    : positions_(),
+      typeIds_(),
+      boundary_(),
+      iStep_(0),
+      nAtom_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   SystemSnapshot::~SystemSnapshot()
+   {}
+
+   /*
+   * Record the state of a System.
+   */
+   void SystemSnapshot::record(const System& system, long iStep)
+   {
+      if (!positions_.isAllocated()) {
+         int atomCapacity = system.simulation().atomCapacity();
+         positions_.allocate(atomCapacity);
+         typeIds_.allocate(atomCapacity);
+      }
+
+      System::ConstMoleculeIterator molIter;
+      Molecule::ConstAtomIterator atomIter;
+      int nSpecies = system.simulation().nSpecies();
+      int i = 0;
+      for (int iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         system.begin(iSpecies, molIter); 
+         for ( ; molIter.notEnd(); ++molIter) {
+            molIter->begin(atomIter); 
+            for ( ; atomIter.notEnd(); ++atomIter) {
+               positions_[i] = atomIter->position();
+               typeIds_[i] = atomIter->typeId();
+               ++i;
+            }
+         }
+      }
+      nAtom_ = i;
+      boundary_ = system.boundary();
+      iStep_ = iStep;
+   }
+
+}
@@ -0,0 +1,125 @@
+#ifndef MCMD_SYSTEM_SNAPSHOT_H
+#define MCMD_SYSTEM_SNAPSHOT_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/boundary/Boundary.h>        // member
+#include <util/containers/DArray.h>        // member template
+#include <util/space/Vector.h>             // member template parameter
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class System;
+
+   /**
+   * Copy of the atomic positions, atom types and boundary of a System.
+   *
+   * A SystemSnapshot records the state of a System at one step, for 
+   * use by an Analyzer that implements Analyzer::sampleSnapshot(). 
+   * Atoms are stored in the order in which they are visited by a loop
+   * over species, over molecules of each species, and over atoms of 
+   * each molecule. Arrays are allocated with a capacity equal to 
+   * Simulation::atomCapacity() on the first call to record(), and 
+   * are reused thereafter.
+   *
+   * \ingroup McMd_Analyzer_Module
+   */
+   class SystemSnapshot
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      SystemSnapshot();
+
+      /**
+      * Destructor.
+      */
+      ~SystemSnapshot();
+
+      /**
+      * Record the state of a System.
+      *
+      * \param system System to be copied
+      * \param iStep  current simulation step index
+      */
+      void record(const System& system, long iStep);
+
+      /**
+      * Get the step index at which the snapshot was recorded.
+      */
+      long iStep() const;
+
+      /**
+      * Get the boundary.
+      */
+      const Boundary& boundary() const;
+
+      /**
+      * Get the number of atoms.
+      */
+      int nAtom() const;
+
+      /**
+      * Get the position of an atom.
+      *
+      * \param i atom index, 0 <= i < nAtom()
+      */
+      const Vector& position(int i) const;
+
+      /**
+      * Get the atom type id of an atom.
+      *
+      * \param i atom index, 0 <= i < nAtom()
+      */
+      int typeId(int i) const;
+
+   private:
+
+      /// Atomic positions.
+      DArray<Vector> positions_;
+
+      /// Atom type ids.
+      DArray<int> typeIds_;
+
+      /// Copy of the system boundary.
+      Boundary boundary_;
+
+      /// Step index.
+      long iStep_;
+
+      /// Number of atoms.
+      int nAtom_;
+
+   };
+
+   // Inline methods
+
+   inline long SystemSnapshot::iStep() const
+   {  return iStep_; }
+
+   inline const Boundary& SystemSnapshot::boundary() const
+   {  return boundary_; }
+
+   inline int SystemSnapshot::nAtom() const
+   {  return nAtom_; }
+
+   inline const Vector& SystemSnapshot::position(int i) const
+   {  return positions_[i]; }
+
+   inline int SystemSnapshot::typeId(int i) const
+   {  return typeIds_[i]; }
+
+}
+#endif
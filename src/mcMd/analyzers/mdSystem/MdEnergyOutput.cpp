@@ -94,6 +94,13 @@ namespace McMd
             outputFile_ << Dbl(external);
          }
          #endif
+         #ifdef INTER_COULOMB
+         if (system().hasCoulombPotential()) {
+            double coulomb = system().coulombPotential().energy();
+            potential += coulomb;
+            outputFile_ << Dbl(coulomb);
+         }
+         #endif
          #ifdef INTER_TETHER
          if (system().hasTetherPotential()) {
             double tether = system().tetherPotential().energy();
@@ -150,6 +157,11 @@ namespace McMd
          outputFile_ << "[external]   ";
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (system().hasCoulombPotential()) {
+         outputFile_ << "[coulomb]    ";
+      }
+      #endif
       #ifdef INTER_TETHER
       if (system().hasTetherPotential()) {
          outputFile_ << "[tether]     ";
@@ -10,6 +10,7 @@
 #include "BennettsMethod.h"           // class header
 #include <mcMd/perturb/Perturbation.h>  
 #include <mcMd/perturb/LinearPerturbation.h>  
+#include <mcMd/perturb/ReplicaMove.h>
 #include <mcMd/simulation/Simulation.h>
 #include <mcMd/simulation/System.h>
 #include <util/mpi/MpiSendRecv.h>
@@ -46,6 +47,9 @@ namespace McMd
       myParam_(),
       lowerParam_(),
       upperParam_(),
+      partnerIds_(),
+      differences_(),
+      derivatives_(),
       nSamplePerBlock_(1),
       myAccumulator_(),
       upperAccumulator_(),
@@ -75,6 +79,9 @@ namespace McMd
       myParam_.allocate(nParameter_);
       lowerParam_.allocate(nParameter_);
       upperParam_.allocate(nParameter_);
+      partnerIds_.allocate(2);
+      differences_.allocate(2);
+      derivatives_.allocate(nParameter_);
    }
 
    /*
@@ -89,10 +96,9 @@ namespace McMd
  
       #ifdef UTIL_MPI
       if (hasIoCommunicator()) {
-         shifts_.allocate(nProcs_);
-         shifts_[nProcs_-1]=0.0;
+         shifts_.allocate(nProcs_-1);
          readDArray<double>(in, "shifts", shifts_, nProcs_-1);
-         shift_ = shifts_[myId_];
+         shift_ = (myId_ < nProcs_-1) ? shifts_[myId_] : 0.0;
       } else {
          read<double>(in, "shift", shift_);
       }
@@ -122,10 +128,9 @@ namespace McMd
  
       #ifdef UTIL_MPI
       if (hasIoCommunicator()) {
-         shifts_.allocate(nProcs_);
-         shifts_[nProcs_-1] = 0.0;
+         shifts_.allocate(nProcs_-1);
          loadDArray<double>(ar, "shifts", shifts_, nProcs_-1);
-         shift_ = shifts_[myId_];
+         shift_ = (myId_ < nProcs_-1) ? shifts_[myId_] : 0.0;
       } else {
          loadParameter<double>(ar, "shift", shift_);
       }
@@ -171,8 +176,13 @@ namespace McMd
      if (!isInitialized_) {
          UTIL_THROW("Object is not initialized");
       }
+      if (system().hasReplicaMove()) {
+         if (system().replicaMove().isParameterSwap()) {
+            UTIL_THROW("BennettsMethod requires a ReplicaMove without parameterSwap");
+         }
+      }
 
-      communicatorPtr_->Bcast((void*)&shifts_[0], nProcs_, MPI::DOUBLE, 0);
+      communicatorPtr_->Bcast((void*)&shifts_[0], nProcs_-1, MPI::DOUBLE, 0);
       if ( myId_ != 0 ) {
          lowerShift_ = shifts_[lowerId_];
       } else {}
@@ -201,8 +211,13 @@ namespace McMd
             upperParam_[i] = system().perturbation().parameter(i,upperId_);
          }
 
-         myArg_ = system().perturbation().difference(upperParam_);
-         lowerArg_ = system().perturbation().difference(lowerParam_);
+         // Evaluate both differences in a single sweep
+         partnerIds_[0] = upperId_;
+         partnerIds_[1] = lowerId_;
+         system().perturbation().evaluate(partnerIds_, 2, differences_, 
+                                          derivatives_);
+         myArg_ = differences_[0];
+         lowerArg_ = differences_[1];
 
          myArg_ -= shift_;
          lowerArg_ += lowerShift_;
@@ -236,7 +251,10 @@ namespace McMd
                upperParam_[i] = system().perturbation().parameter(i, upperId_);
             }
 
-            myArg_ = system().perturbation().difference(upperParam_);
+            partnerIds_[0] = upperId_;
+            system().perturbation().evaluate(partnerIds_, 1, differences_, 
+                                             derivatives_);
+            myArg_ = differences_[0];
             myArg_ -= shift_;
             
             myFermi_ = 1/(1 + exp(myArg_));
@@ -262,7 +280,10 @@ namespace McMd
                lowerParam_[i] = system().perturbation().parameter(i, lowerId_);
             }
 
-            lowerArg_ = system().perturbation().difference(lowerParam_);
+            partnerIds_[0] = lowerId_;
+            system().perturbation().evaluate(partnerIds_, 1, differences_, 
+                                             derivatives_);
+            lowerArg_ = differences_[0];
             lowerArg_ += lowerShift_;
             
             lowerFermi_ = 1/(1 + exp(lowerArg_));
@@ -313,11 +334,14 @@ namespace McMd
 
       analyze(); 
 
-      communicatorPtr_->Gather((const void *) &shift_, 1, MPI::DOUBLE, (void *) &shifts_[0], 1, MPI::DOUBLE, 0);
+      DArray<double> allShifts;
+      allShifts.allocate(nProcs_);
+      communicatorPtr_->Gather((const void *) &shift_, 1, MPI::DOUBLE, (void *) &allShifts[0], 1, MPI::DOUBLE, 0);
       int i;
       if (myId_ == 0) {
          fileMaster().openOutputFile(outputFileName("_all.dat"), outputFile_);
          for (i = 0; i < nProcs_-1; ++i) {
+            shifts_[i] = allShifts[i];
             outputFile_ << Dbl(shifts_[i]);
             outputFile_ << std::endl;
          }
@@ -101,7 +101,7 @@ namespace McMd
       double lowerShift_;
 
       #ifdef UTIL_MPI
-      // Values of shift constants for all replicas.
+      // Values of shift constants for all replicas except the last.
       DArray<double> shifts_;
       #endif
      
@@ -140,6 +140,15 @@ namespace McMd
       /// Tempering variable of upper replica.
       DArray<double> upperParam_;
 
+      /// Ids of partner replicas passed to Perturbation::evaluate().
+      DArray<int> partnerIds_;
+
+      /// Differences W(partner) - W(current) from Perturbation::evaluate().
+      DArray<double> differences_;
+
+      /// Derivatives from Perturbation::evaluate() (unused).
+      DArray<double> derivatives_;
+
       /// Number of samples per block average output.
       int nSamplePerBlock_;
 
@@ -8,6 +8,9 @@
 
 #include "PerturbDerivative.h"           // class header
 #include <mcMd/perturb/Perturbation.h>  
+#ifdef UTIL_MPI
+#include <mcMd/perturb/ReplicaMove.h>
+#endif
 #include <util/misc/FileMaster.h>  
 
 #include <cstdio> 
@@ -76,6 +79,13 @@ namespace McMd
       if (!isInitialized_) {
          UTIL_THROW("Object is not initialized");
       }
+      #ifdef UTIL_MPI
+      if (system().hasReplicaMove()) {
+         if (system().replicaMove().isParameterSwap()) {
+            UTIL_THROW("PerturbDerivative requires a ReplicaMove without parameterSwap");
+         }
+      }
+      #endif
       accumulator_.clear();
    }
 
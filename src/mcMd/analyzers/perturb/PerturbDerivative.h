@@ -23,6 +23,9 @@ namespace McMd
    /**
    * PerturbDerivative returns average value of Perturbation::derivative().
    *
+   * The average is accumulated for a single state, and so cannot be used
+   * with a ReplicaMove that exchanges perturbation parameters.
+   *
    * \ingroup McMd_Analyzer_McMd_Module
    */
    class PerturbDerivative : public SystemAnalyzer<System>
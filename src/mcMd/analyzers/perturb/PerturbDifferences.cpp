@@ -0,0 +1,161 @@
+#ifdef MCMD_PERTURB
+#ifdef UTIL_MPI
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "PerturbDifferences.h"           // class header
+#include <mcMd/perturb/Perturbation.h>
+#include <mcMd/perturb/ReplicaMove.h>
+#include <mcMd/simulation/Simulation.h>
+#include <util/misc/FileMaster.h>
+#include <util/format/Dbl.h>
+#include <util/format/Int.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   PerturbDifferences::PerturbDifferences(System& system)
+    : SystemAnalyzer<System>(system),
+      outputFile_(),
+      accumulators_(),
+      ids_(),
+      differences_(),
+      derivatives_(),
+      myId_(-1),
+      nProcs_(0),
+      nParameter_(0),
+      isInitialized_(false)
+   {  setClassName("PerturbDifferences"); }
+
+   /*
+   * Read parameters and initialize.
+   */
+   void PerturbDifferences::readParameters(std::istream& in)
+   {
+      readInterval(in);
+      readOutputFileName(in);
+      initialize();
+   }
+
+   /*
+   * Load internal state from archive.
+   */
+   void PerturbDifferences::loadParameters(Serializable::IArchive &ar)
+   {
+      Analyzer::loadParameters(ar);
+      initialize();
+      for (int i = 0; i < nProcs_*nParameter_; ++i) {
+         ar & accumulators_[i];
+      }
+   }
+
+   /*
+   * Save internal state to archive.
+   */
+   void PerturbDifferences::save(Serializable::OArchive &ar)
+   {
+      Analyzer::save(ar);
+      for (int i = 0; i < nProcs_*nParameter_; ++i) {
+         ar & accumulators_[i];
+      }
+   }
+
+   /*
+   * Allocate arrays and open output file (private).
+   */
+   void PerturbDifferences::initialize()
+   {
+      myId_ = system().simulation().communicator().Get_rank();
+      nProcs_ = system().simulation().communicator().Get_size();
+      nParameter_ = system().perturbation().getNParameters();
+      accumulators_.allocate(nProcs_*nParameter_);
+      ids_.allocate(nProcs_);
+      differences_.allocate(nProcs_);
+      derivatives_.allocate(nParameter_);
+      for (int k = 0; k < nProcs_; ++k) {
+         ids_[k] = k;
+      }
+      for (int i = 0; i < nProcs_*nParameter_; ++i) {
+         accumulators_[i].setNSamplePerBlock(0);
+      }
+      fileMaster().openOutputFile(outputFileName(".dat"), outputFile_);
+      isInitialized_ = true;
+   }
+
+   /*
+   * Clear accumulators.
+   */
+   void PerturbDifferences::setup()
+   {
+      if (!isInitialized_) {
+         UTIL_THROW("Object is not initialized");
+      }
+      for (int i = 0; i < nProcs_*nParameter_; ++i) {
+         accumulators_[i].clear();
+      }
+   }
+
+   /*
+   * Evaluate derivatives and all differences in one call, and output.
+   */
+   void PerturbDifferences::sample(long iStep)
+   {
+      if (!isAtInterval(iStep)) return;
+
+      int stateId = myId_;
+      if (system().hasReplicaMove()) {
+         stateId = system().replicaMove().stateId();
+      }
+
+      system().perturbation().evaluate(ids_, nProcs_, differences_,
+                                       derivatives_);
+      outputFile_ << Int(iStep, 10) << Int(stateId, 5);
+      Average* accumulators = &accumulators_[stateId*nParameter_];
+      int i, k;
+      for (i = 0; i < nParameter_; ++i) {
+         accumulators[i].sample(derivatives_[i]);
+         outputFile_ << Dbl(derivatives_[i]);
+      }
+      for (k = 0; k < nProcs_; ++k) {
+         outputFile_ << Dbl(differences_[k]);
+      }
+      outputFile_ << std::endl;
+   }
+
+   /*
+   * Output averages of derivatives after simulation is completed.
+   */
+   void PerturbDifferences::output()
+   {
+      outputFile_.close();
+
+      fileMaster().openOutputFile(outputFileName(".prm"), outputFile_);
+      writeParam(outputFile_);
+      outputFile_.close();
+
+      fileMaster().openOutputFile(outputFileName(".ave"), outputFile_);
+      Average* accumulators;
+      for (int k = 0; k < nProcs_; ++k) {
+         accumulators = &accumulators_[k*nParameter_];
+         if (nParameter_ == 0 || accumulators[0].nSample() == 0) continue;
+         for (int i = 0; i < nParameter_; ++i) {
+            outputFile_ << "state " << k << " derivative " << i << std::endl;
+            accumulators[i].output(outputFile_);
+            outputFile_ << std::endl;
+         }
+      }
+      outputFile_.close();
+   }
+
+}
+#endif // ifdef  UTIL_MPI
+#endif // ifdef  MCMD_PERTURB
@@ -0,0 +1,134 @@
+#ifdef MCMD_PERTURB
+#ifdef UTIL_MPI
+#ifndef MCMD_PERTURB_DIFFERENCES_H
+#define MCMD_PERTURB_DIFFERENCES_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/analyzers/SystemAnalyzer.h>      // base class template
+#include <mcMd/simulation/System.h>             // base template parameter
+#include <util/accumulators/Average.h>          // member
+#include <util/containers/DArray.h>             // member
+
+#include <cstdio>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * PerturbDifferences records W(X, p') - W(X, p) for all replicas.
+   *
+   * At each sample, this analyzer calls Perturbation::evaluate() once
+   * to obtain the derivatives dW/dp[i] and the differences W(X, p[k])
+   * - W(X, p) of the Boltzmann weight of the current microstate X for
+   * the parameters p[k] of every replica k. Each sample is written as
+   * one line of the file {outputFileName}.dat, which contains the step
+   * index, the index of the current state, the nParameters derivatives,
+   * and the differences for all states, in order of increasing state
+   * index. These are the reduced energies required by the multistate
+   * Bennett acceptance ratio (MBAR) method, and the derivatives required
+   * by thermodynamic integration. The current state is the communicator
+   * rank, unless a ReplicaMove exchanges perturbation parameters, in
+   * which case it is given by ReplicaMove::stateId(). Averages of the
+   * derivatives for each state sampled by this processor are written to
+   * the file {outputFileName}.ave at the end of the simulation.
+   *
+   * \ingroup McMd_Analyzer_McMd_Module
+   */
+   class PerturbDifferences : public SystemAnalyzer<System>
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param system parent System
+      */
+      PerturbDifferences(System& system);
+
+      /**
+      * Read parameters and initialize.
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Clear accumulators.
+      */
+      virtual void setup();
+
+      /**
+      * Evaluate derivatives and differences, and output to file.
+      *
+      * \param iStep step counter
+      */
+      virtual void sample(long iStep);
+
+      /**
+      * Output averages of derivatives at end of simulation.
+      */
+      virtual void output();
+
+   private:
+
+      /// Output file stream (samples).
+      std::ofstream outputFile_;
+
+      /// Averages of derivatives, for each state and parameter.
+      DArray<Average> accumulators_;
+
+      /// Ids of all replicas.
+      DArray<int> ids_;
+
+      /// Differences W(X, p[k]) - W(X, p), for all replicas k.
+      DArray<double> differences_;
+
+      /// Derivatives dW/dp[i].
+      DArray<double> derivatives_;
+
+      /// Rank of this processor.
+      int myId_;
+
+      /// Number of replicas (communicator size).
+      int nProcs_;
+
+      /// Number of perturbation parameters.
+      int nParameter_;
+
+      /// Has readParam been called?
+      bool isInitialized_;
+
+      /*
+      * Allocate arrays and open output file.
+      */
+      void initialize();
+
+   };
+
+}
+#endif   // ifndef MCMD_PERTURB_DIFFERENCES_H
+#endif   // ifdef  UTIL_MPI
+#endif   // ifdef  MCMD_PERTURB
@@ -3,7 +3,8 @@ mcMd_analyzers_perturb_=\
 
 ifdef UTIL_MPI
 mcMd_analyzers_perturb_+=\
-    mcMd/analyzers/perturb/BennettsMethod.cpp 
+    mcMd/analyzers/perturb/BennettsMethod.cpp \
+    mcMd/analyzers/perturb/PerturbDifferences.cpp 
 endif
 
 mcMd_analyzers_perturb_SRCS=\
@@ -13,7 +13,8 @@ mcMd_analyzers_=\
     $(mcMd_analyzers_simulation_) \
     $(mcMd_analyzers_mutable_) \
     mcMd/analyzers/Analyzer.cpp \
-    mcMd/analyzers/AnalyzerManager.cpp 
+    mcMd/analyzers/AnalyzerManager.cpp \
+    mcMd/analyzers/SystemSnapshot.cpp 
 
 ifdef MCMD_PERTURB
 include $(SRC_DIR)/mcMd/analyzers/perturb/sources.mk
@@ -10,7 +10,7 @@
 
 #include <mcMd/analyzers/SystemAnalyzer.h>  // base class template
 #include <mcMd/simulation/System.h>             // base class template parameter
-#include <util/accumulators/MeanSqDispArray.h>  // member template 
+#include <util/accumulators/MultiTauMeanSqDispArray.h> // member template
 #include <util/space/Vector.h>                   // member template parameter
 #include <util/containers/DArray.h>             // member template
 
@@ -91,7 +91,7 @@ namespace McMd
       std::ofstream outputFile_;
 
       /// Statistical accumulator
-      MeanSqDispArray<Vector> accumulator_;
+      MultiTauMeanSqDispArray<Vector> accumulator_;
 
       /// Array of position vectors, one per molecule of species.
       DArray<Vector>    truePositions_;
@@ -111,7 +111,7 @@ namespace McMd
       /// Number of molecules in the species (must not change).
       int     nMolecule_;
    
-      /// Maximum length of each sequence in AutoCorrArray.
+      /// Number of values stored per stage of the multiple-tau accumulator.
       int     capacity_;
    
       /// Has readParam been called?
@@ -0,0 +1,323 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CellRDF.h"
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/boundary/Boundary.h>
+#include <util/math/Constants.h>
+#include <util/format/Int.h>
+#include <util/format/Dbl.h>
+#include <util/misc/FileMaster.h>
+#include <util/archives/Serializable_includes.h>
+
+#include <util/global.h>
+
+#include <cmath>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   CellRDF::CellRDF(System& system)
+    : SystemAnalyzer<System>(system),
+      outputFile_(),
+      cellList_(),
+      neighbors_(),
+      interHistograms_(),
+      intraHistograms_(),
+      pairIds_(),
+      normSums_(),
+      typeNumbers_(),
+      cellCapacities_(0),
+      max_(1.0),
+      nBin_(1),
+      nAtomType_(0),
+      nPairType_(0),
+      nSnapshot_(0),
+      isInitialized_(false)
+   {  setClassName("CellRDF"); }
+
+   /*
+   * Read parameters from file, and allocate arrays.
+   */
+   void CellRDF::readParameters(std::istream& in)
+   {
+      Analyzer::readParameters(in);
+      read<double>(in, "max", max_);
+      read<int>(in, "nBin", nBin_);
+      if (max_ <= 0.0) {
+         UTIL_THROW("max must be positive");
+      }
+      if (nBin_ <= 0) {
+         UTIL_THROW("nBin must be positive");
+      }
+
+      nAtomType_ = system().simulation().nAtomType();
+      allocate();
+      isInitialized_ = true;
+   }
+
+   /*
+   * Load state from an archive.
+   */
+   void CellRDF::loadParameters(Serializable::IArchive& ar)
+   {
+      Analyzer::loadParameters(ar);
+      loadParameter<double>(ar, "max", max_);
+      loadParameter<int>(ar, "nBin", nBin_);
+      ar & nAtomType_;
+      if (nAtomType_ != system().simulation().nAtomType()) {
+         UTIL_THROW("Inconsistent nAtomType");
+      }
+      allocate();
+      ar & interHistograms_;
+      ar & intraHistograms_;
+      ar & normSums_;
+      ar & nSnapshot_;
+      isInitialized_ = true;
+   }
+
+   /*
+   * Save state to archive.
+   */
+   void CellRDF::save(Serializable::OArchive& ar)
+   {  ar & *this; }
+
+   /*
+   * Allocate arrays, and index unordered pairs of types (private).
+   */
+   void CellRDF::allocate()
+   {
+      nPairType_ = nAtomType_*(nAtomType_ + 1)/2;
+      interHistograms_.allocate(nPairType_, nBin_);
+      intraHistograms_.allocate(nPairType_, nBin_);
+      normSums_.allocate(nPairType_);
+      typeNumbers_.allocate(nAtomType_);
+      pairIds_.allocate(nAtomType_, nAtomType_);
+      int i, j, k;
+      k = 0;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = i; j < nAtomType_; ++j) {
+            pairIds_(i, j) = k;
+            pairIds_(j, i) = k;
+            ++k;
+         }
+      }
+   }
+
+   /*
+   * Clear accumulators, and allocate the cell list.
+   */
+   void CellRDF::setup()
+   {
+      if (!isInitialized_) {
+         UTIL_THROW("Object not initialized");
+      }
+      int i, j;
+      for (i = 0; i < nPairType_; ++i) {
+         for (j = 0; j < nBin_; ++j) {
+            interHistograms_(i, j) = 0;
+            intraHistograms_(i, j) = 0;
+         }
+         normSums_[i] = 0.0;
+      }
+      nSnapshot_ = 0;
+
+      // Allocate cells for the current boundary. Cells are enlarged
+      // in buildCellList() if the boundary later grows.
+      if (!cellList_.isAllocated()) {
+         cellList_.allocate(system().simulation().atomCapacity(),
+                            system().boundary(), max_);
+         for (i = 0; i < Dimension; ++i) {
+            cellCapacities_[i] = cellList_.gridDimension(i);
+         }
+      }
+   }
+
+   /*
+   * Fill the cell list with all atoms (private).
+   */
+   void CellRDF::buildCellList()
+   {
+      const Boundary& boundary = system().boundary();
+      const Vector& lengths = boundary.lengths();
+      int i;
+      for (i = 0; i < Dimension; ++i) {
+         if (2.0*max_ > lengths[i]) {
+            UTIL_THROW("max exceeds half a boundary length");
+         }
+      }
+
+      // Choose a cutoff >= max_ that requires no more cells than allocated
+      double cutoff = max_;
+      for (i = 0; i < Dimension; ++i) {
+         if (int(lengths[i]/cutoff) > cellCapacities_[i]) {
+            cutoff = lengths[i]/(double(cellCapacities_[i]) + 0.5);
+         }
+      }
+      cellList_.makeGrid(boundary, cutoff);
+      cellList_.clear();
+
+      for (i = 0; i < nAtomType_; ++i) {
+         typeNumbers_[i] = 0.0;
+      }
+
+      // Add atoms at positions shifted into the primary cell. The
+      // atoms themselves are not modified.
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      Vector r;
+      int nSpecies = system().simulation().nSpecies();
+      for (int iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            molIter->begin(atomIter);
+            for ( ; atomIter.notEnd(); ++atomIter) {
+               r = atomIter->position();
+               boundary.shift(r);
+               cellList_.addAtom(*atomIter, r);
+               typeNumbers_[atomIter->typeId()] += 1.0;
+            }
+         }
+      }
+   }
+
+   /*
+   * Add all pairs within max_ to histograms.
+   */
+   void CellRDF::sample(long iStep)
+   {
+      if (!isAtInterval(iStep)) return;
+
+      buildCellList();
+      ++nSnapshot_;
+
+      const Boundary& boundary = system().boundary();
+      const double maxSq = max_*max_;
+      const double binFactor = double(nBin_)/max_;
+      Atom* atom1Ptr;
+      Atom* atom2Ptr;
+      double rsq;
+      int ic, i, j, nNeighbor, nInCell, type1, bin, pairId;
+
+      // Loop over cells, visiting each pair of atoms once
+      for (ic = 0; ic < cellList_.totCells(); ++ic) {
+         cellList_.getHalfCellNeighbors(ic, neighbors_, nInCell);
+         nNeighbor = neighbors_.size();
+         for (i = 0; i < nInCell; ++i) {
+            atom1Ptr = neighbors_[i];
+            type1 = atom1Ptr->typeId();
+            for (j = i + 1; j < nNeighbor; ++j) {
+               atom2Ptr = neighbors_[j];
+               rsq = boundary.distanceSq(atom1Ptr->position(),
+                                         atom2Ptr->position());
+               if (rsq < maxSq) {
+                  bin = int(sqrt(rsq)*binFactor);
+                  if (bin < nBin_) {
+                     pairId = pairIds_(type1, atom2Ptr->typeId());
+                     if (&atom1Ptr->molecule() == &atom2Ptr->molecule()) {
+                        ++intraHistograms_(pairId, bin);
+                     } else {
+                        ++interHistograms_(pairId, bin);
+                     }
+                  }
+               }
+            }
+         }
+      }
+
+      // Increment normalizing factors. Each pair is counted once, so
+      // the expected number of pairs of types (a, b) in a volume dV is
+      // Na*Nb*dV/V for a != b, and Na*Na*dV/(2V) for a == b.
+      const double volume = boundary.volume();
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = i; j < nAtomType_; ++j) {
+            pairId = pairIds_(i, j);
+            if (i == j) {
+               normSums_[pairId] += 0.5*typeNumbers_[i]*typeNumbers_[i]/volume;
+            } else {
+               normSums_[pairId] += typeNumbers_[i]*typeNumbers_[j]/volume;
+            }
+         }
+      }
+   }
+
+   /*
+   * Output one value of g(r), given a histogram value and the sum of
+   * normalizing factors over snapshots (private).
+   */
+   void CellRDF::outputValue(double hist, double dV, double norm)
+   {
+      double g = 0.0;
+      if (norm > 0.0) {
+         g = hist/(dV*norm);
+      }
+      outputFile_ << Dbl(g, 18, 8);
+   }
+
+   /*
+   * Output results to file after simulation is completed.
+   */
+   void CellRDF::output()
+   {
+      int i, j, k, bin;
+
+      // Echo parameters and describe format of data file
+      fileMaster().openOutputFile(outputFileName(".prm"), outputFile_);
+      writeParam(outputFile_);
+      outputFile_ << std::endl;
+      outputFile_ << "nSnapshot  " << nSnapshot_ << std::endl;
+      outputFile_ << std::endl;
+      outputFile_ << "Format of *.dat file:" << std::endl;
+      outputFile_ << "[r]  [g, all pairs]";
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = i; j < nAtomType_; ++j) {
+            outputFile_ << "  [g, g_inter, g_intra for types "
+                        << i << "-" << j << "]";
+         }
+      }
+      outputFile_ << std::endl;
+      outputFile_.close();
+
+      // Total normalization for all pairs, N*N/(2V)
+      double normAll = 0.0;
+      for (k = 0; k < nPairType_; ++k) {
+         normAll += normSums_[k];
+      }
+
+      fileMaster().openOutputFile(outputFileName(".dat"), outputFile_);
+      const double binWidth = max_/double(nBin_);
+      const double prefactor = 4.0*Constants::Pi*binWidth*binWidth*binWidth/3.0;
+      double r, dV, inter, intra, all;
+      for (bin = 0; bin < nBin_; ++bin) {
+         r  = binWidth*(double(bin) + 0.5);
+         dV = prefactor*double(3*bin*bin + 3*bin + 1);
+         all = 0.0;
+         for (k = 0; k < nPairType_; ++k) {
+            all += double(interHistograms_(k, bin) + intraHistograms_(k, bin));
+         }
+         outputFile_ << Dbl(r, 18, 8);
+         outputValue(all, dV, normAll);
+         for (k = 0; k < nPairType_; ++k) {
+            inter = double(interHistograms_(k, bin));
+            intra = double(intraHistograms_(k, bin));
+            outputValue(inter + intra, dV, normSums_[k]);
+            outputValue(inter, dV, normSums_[k]);
+            outputValue(intra, dV, normSums_[k]);
+         }
+         outputFile_ << std::endl;
+      }
+      outputFile_.close();
+   }
+
+}
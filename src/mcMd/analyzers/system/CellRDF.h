@@ -0,0 +1,182 @@
+#ifndef MCMD_CELL_RDF_H
+#define MCMD_CELL_RDF_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/analyzers/SystemAnalyzer.h>      // base class template
+#include <mcMd/simulation/System.h>             // base class template parameter
+#include <mcMd/neighbor/CellList.h>             // member
+#include <util/space/IntVector.h>               // member
+#include <util/containers/DArray.h>             // member template
+#include <util/containers/DMatrix.h>            // member template
+
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * CellRDF evaluates radial distribution functions for all atom type pairs.
+   *
+   * This class evaluates the radial distribution function g(r) for
+   * every pair of atom types, and separates the contributions of
+   * intramolecular and intermolecular pairs, all in a single pass over
+   * pairs of atoms. Atoms are binned into a private CellList with cells
+   * no smaller than the maximum radius, so that only pairs in the same
+   * or neighboring cells are visited, at a cost of order N per sample,
+   * rather than N^2 for the double loop used by McMd::RDF. The maximum
+   * radius may not exceed half the smallest length of the boundary.
+   *
+   * \sa \ref mcMd_analyzer_CellRDF_page "parameter file format"
+   *
+   * \ingroup McMd_Analyzer_McMd_Module
+   */
+   class CellRDF : public SystemAnalyzer<System>
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param system reference to parent System object
+      */
+      CellRDF(System &system);
+
+      /**
+      * Read parameters from file.
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load state from an archive.
+      *
+      * \param ar loading (input) archive.
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save state to archive.
+      *
+      * \param ar saving (output) archive.
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /**
+      * Serialize to/from an archive.
+      *
+      * \param ar      saving or loading archive
+      * \param version archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
+      /**
+      * Clear accumulators, and allocate the cell list if necessary.
+      */
+      virtual void setup();
+
+      /**
+      * Add all pairs within the maximum radius to histograms.
+      *
+      * \param iStep step counter
+      */
+      virtual void sample(long iStep);
+
+      /**
+      * Output results to output file.
+      */
+      virtual void output();
+
+   private:
+
+      /// Output file stream.
+      std::ofstream outputFile_;
+
+      /// Cell list with cells no smaller than max_.
+      CellList cellList_;
+
+      /// Work array of neighbor atoms.
+      CellList::NeighborArray neighbors_;
+
+      /// Histograms of intermolecular pairs (type pair index, bin).
+      DMatrix<long> interHistograms_;
+
+      /// Histograms of intramolecular pairs (type pair index, bin).
+      DMatrix<long> intraHistograms_;
+
+      /// Index of unordered pair of atom types (typeId1, typeId2).
+      DMatrix<int> pairIds_;
+
+      /// Sums of snapshot values of normalizing factors, per type pair.
+      DArray<double> normSums_;
+
+      /// Number of atoms of each type in the current snapshot.
+      DArray<double> typeNumbers_;
+
+      /// Number of cells along each axis for which cellList_ is allocated.
+      IntVector cellCapacities_;
+
+      /// Maximum radius in histograms.
+      double max_;
+
+      /// Number of bins in each histogram.
+      int nBin_;
+
+      /// Number of atom types, copied from Simulation::nAtomType().
+      int nAtomType_;
+
+      /// Number of unordered pairs of atom types.
+      int nPairType_;
+
+      /// Number of sampled snapshots.
+      long nSnapshot_;
+
+      /// Is this initialized (Has readParam or loadParam been called?)
+      bool isInitialized_;
+
+      /*
+      * Allocate arrays and set pair indices, given nAtomType_ and nBin_.
+      */
+      void allocate();
+
+      /*
+      * Fill cellList_ with all atoms, using the current boundary.
+      */
+      void buildCellList();
+
+      /*
+      * Output one g(r) value to outputFile_, given a histogram value
+      * and a sum of normalizing factors over snapshots.
+      */
+      void outputValue(double hist, double dV, double norm);
+
+   };
+
+   /*
+   * Serialize to/from an archive.
+   */
+   template <class Archive>
+   void CellRDF::serialize(Archive& ar, const unsigned int version)
+   {
+      Analyzer::serialize(ar, version);
+      ar & max_;
+      ar & nBin_;
+      ar & nAtomType_;
+      ar & interHistograms_;
+      ar & intraHistograms_;
+      ar & normSums_;
+      ar & nSnapshot_;
+   }
+
+}
+#endif
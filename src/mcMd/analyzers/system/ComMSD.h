@@ -10,7 +10,7 @@
 
 #include <mcMd/analyzers/SystemAnalyzer.h>  // base class template
 #include <mcMd/simulation/System.h>             // base class template parameter
-#include <util/accumulators/MeanSqDispArray.h>  // member template 
+#include <util/accumulators/MultiTauMeanSqDispArray.h> // member template
 #include <util/space/Vector.h>                  // template parameter
 #include <util/space/IntVector.h>               // template parameter
 #include <util/containers/DArray.h>             // member template
@@ -101,7 +101,7 @@ namespace McMd
       std::ofstream outputFile_;
 
       /// Statistical accumulator
-      MeanSqDispArray<Vector> accumulator_;
+      MultiTauMeanSqDispArray<Vector> accumulator_;
 
       /// Array of position vectors, one per molecule of species.
       DArray<Vector>    truePositions_;
@@ -121,7 +121,7 @@ namespace McMd
       /// Number of atoms in per molecule (must not change).
       int     nAtom_;
   
-      /// Maximum length of each sequence in AutoCorrArray.
+      /// Number of values stored per stage of the multiple-tau accumulator.
       int     capacity_;
 
       /// Has readParam been called?
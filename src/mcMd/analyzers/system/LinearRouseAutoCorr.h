@@ -10,7 +10,7 @@
 
 #include <mcMd/analyzers/SystemAnalyzer.h>   // base class template
 #include <mcMd/simulation/System.h>              // base class template parameter
-#include <util/accumulators/AutoCorrArray.h>     // member template 
+#include <util/accumulators/MultiTauAutoCorrArray.h> // member template
 #include <util/space/Vector.h>                   // member template parameter
 #include <util/containers/DArray.h>              // member template
 
@@ -29,6 +29,12 @@ namespace McMd
    /**
    * Autocorrelation for Rouse mode coefficients of a linear molecule.
    *
+   * The autocorrelation function is accumulated by a multiple-tau
+   * algorithm (see Util::MultiTauAutoCorrArray), in which parameter
+   * capacity is the number of values stored per stage. Lags up to
+   * capacity - 1 are output at every sample interval, and longer lags
+   * at intervals that double with each stage.
+   *
    * \ingroup McMd_Analyzer_McMd_Module
    */
    class LinearRouseAutoCorr : public SystemAnalyzer<System>
@@ -101,7 +107,7 @@ namespace McMd
       std::ofstream outputFile_;
 
       /// Statistical accumulator.
-      AutoCorrArray<Vector, double>  accumulator_;
+      MultiTauAutoCorrArray<Vector, double>  accumulator_;
    
       /// Array of Rouse mode coefficients, one per molecule of species.
       DArray<Vector> data_;
@@ -124,7 +130,7 @@ namespace McMd
       /// Index to Rouse mode.
       int      p_;
 
-      /// Maximum length of each sequence in AutoCorrArray.
+      /// Number of values stored per stage of the multiple-tau accumulator.
       int      capacity_;
    
       /// Has readParam been called?
@@ -11,7 +11,6 @@
 #include <util/boundary/Boundary.h>
 #include <mcMd/chemistry/Molecule.h>
 #include <mcMd/chemistry/Atom.h>
-#include <util/math/Constants.h>
 #include <util/space/Dimension.h>
 #include <util/misc/FileMaster.h>
 #include <util/archives/Serializable_includes.h>
@@ -124,109 +123,92 @@ namespace McMd
    }
 
    /* 
-   * Increment structure factors for all wavevectors and modes.
+   * Record a snapshot, and increment structure factors.
    */
    void StructureFactor::sample(long iStep) 
    {
       if (isAtInterval(iStep))  {
+         SystemSnapshot snapshot;
+         snapshot.record(system(), iStep);
+         sampleSnapshot(snapshot);
+      }
+   }
 
-         std::ios_base::openmode mode = std::ios_base::out;
-         if (!isFirstStep_) {
-           mode = std::ios_base::out | std::ios_base::app; 
-         }
-         fileMaster().openOutputFile(outputFileName("_max.dat"), 
-                                     outputFile_, mode);
-
-         //fileMaster().openOutputFile(outputFileName("_max.dat"), 
-         //                            outputFile_, !isFirstStep_);
-         isFirstStep_ = false;
+   /* 
+   * Increment structure factors for all wavevectors and modes.
+   */
+   void StructureFactor::sampleSnapshot(const SystemSnapshot& snapshot) 
+   {
+      std::ios_base::openmode mode = std::ios_base::out;
+      if (!isFirstStep_) {
+        mode = std::ios_base::out | std::ios_base::app; 
+      }
+      fileMaster().openOutputFile(outputFileName("_max.dat"), 
+                                  outputFile_, mode);
+      isFirstStep_ = false;
 
-         Vector position;
-         std::complex<double> expFactor;
-         double product;
-         System::ConstMoleculeIterator molIter;
-         Molecule::ConstAtomIterator atomIter;
-         int nSpecies, iSpecies, typeId, i, j;
+      int i, j;
 
-         makeWaveVectors();
+      makeWaveVectors(snapshot.boundary());
+      computeFourierModes(snapshot);
 
-         // Set all Fourier modes to zero
+      // Increment structure factors
+      double volume = snapshot.boundary().volume();
+      double norm;
+      for (j = 0; j < nMode_; ++j) {
+         double maxValue = 0.0;
+         double maxQ = 0.0;
+         IntVector maxIntVector;
          for (i = 0; i < nWave_; ++i) {
-            for (j = 0; j < nMode_; ++j) {
-               fourierModes_(i, j) = std::complex<double>(0.0, 0.0);
+            norm = std::norm(fourierModes_(i, j));
+            if (double(norm/volume) >= maxValue) {
+               maxValue = double(norm/volume);
+               maxIntVector = waveIntVectors_[i];
+               maxQ = waveVectors_[i].abs();
             }
-         }
- 
-         // Loop over all atoms
-         nSpecies = system().simulation().nSpecies();
-         for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
-            system().begin(iSpecies, molIter); 
-            for ( ; molIter.notEnd(); ++molIter) {
-               molIter->begin(atomIter); 
-               for ( ; atomIter.notEnd(); ++atomIter) {
-                  position = atomIter->position();
-                  typeId   = atomIter->typeId();
- 
-		  // Loop over wavevectors
-                  for (i = 0; i < nWave_; ++i) {
-               
-                     product = position.dot(waveVectors_[i]);
-                     expFactor = exp( product*Constants::Im );
-                     for (j = 0; j < nMode_; ++j) {
-                        fourierModes_(i, j) += modes_(j, typeId)*expFactor;
-                     }
-		 
-                  }
-  
-               }
-            }
-
+            structureFactors_(i, j) += norm/volume;
          }
 
-         // Increment structure factors
-         double volume = system().boundary().volume();
-         double norm;
-         for (j = 0; j < nMode_; ++j) {
-            double maxValue = 0.0;
-            double maxQ = 0.0;
-            IntVector maxIntVector;
-            for (i = 0; i < nWave_; ++i) {
-               norm = std::norm(fourierModes_(i, j));
-               if (double(norm/volume) >= maxValue) {
-                  maxValue = double(norm/volume);
-                  maxIntVector = waveIntVectors_[i];
-                  maxQ = waveVectors_[i].abs();
-               }
-               structureFactors_(i, j) += norm/volume;
-            }
+         // Output current maximum S(q)
+         outputFile_ << maxIntVector;
+         outputFile_ << Dbl(maxQ, 20, 8);
+         outputFile_ << Dbl(maxValue, 20, 8);
+         outputFile_ << std::endl;
+      }
 
-            // Output current maximum S(q)
-            outputFile_ << maxIntVector;
-            outputFile_ << Dbl(maxQ, 20, 8);
-            outputFile_ << Dbl(maxValue, 20, 8);
-            outputFile_ << std::endl;
-         }
+      ++nSample_;
 
-         ++nSample_;
+      outputFile_ << std::endl;
+      outputFile_.close();
+   }
 
-         outputFile_ << std::endl;
-         outputFile_.close();
+   /*
+   * Compute Fourier modes by a direct sum over atoms.
+   */
+   void StructureFactor::computeFourierModes(const SystemSnapshot& snapshot)
+   {
+      if (!fourierSum_.isAllocated()) {
+         fourierSum_.setup(waveIntVectors_, nWave_, modes_);
       }
-
+      fourierSum_.clear(snapshot.boundary());
+      int nAtom = snapshot.nAtom();
+      for (int i = 0; i < nAtom; ++i) {
+         fourierSum_.addAtom(snapshot.position(i), snapshot.typeId(i));
+      }
+      fourierSum_.computeModes(fourierModes_);
    }
 
    /*
    * Calculate floating point wavevectors, using current boundary.
    */
-   void StructureFactor::makeWaveVectors() 
+   void StructureFactor::makeWaveVectors(const Boundary& boundary) 
    {
-      Boundary* boundaryPtr = &system().boundary();
       Vector  dWave;
       int  i, j;
       for (i = 0; i < nWave_; ++i) {
          waveVectors_[i] = Vector::Zero;
          for (j = 0; j < Dimension; ++j) {
-            dWave  = boundaryPtr->reciprocalBasisVector(j);
+            dWave  = boundary.reciprocalBasisVector(j);
             dWave *= waveIntVectors_[i][j];
             waveVectors_[i] += dWave;
          }
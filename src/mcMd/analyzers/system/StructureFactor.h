@@ -10,8 +10,10 @@
 
 #include <mcMd/analyzers/SystemAnalyzer.h>    // base class template
 #include <mcMd/simulation/System.h>               // base class template parameter
+#include <mcMd/analyzers/SystemSnapshot.h>        // function parameter
 #include <util/containers/DMatrix.h>              // member template
 #include <util/containers/DArray.h>               // member template
+#include <util/math/FourierSum.h>                 // member
 
 #include <util/global.h>
 
@@ -48,6 +50,10 @@ namespace McMd
    * an expansion of a reciprocal lattice wavevector as a sum of
    * recprocal lattice basis vectors for the periodic unit cell.
    *
+   * This is a snapshot analyzer: All calculations are implemented by
+   * sampleSnapshot(), and may thus be run asynchronously by the 
+   * AnalyzerManager. 
+   *
    * \sa \ref mcMd_analyzer_StructureFactor_page "parameter file format"
    * 
    * \ingroup McMd_Analyzer_McMd_Module
@@ -107,10 +113,27 @@ namespace McMd
       /**
       * Add particles to StructureFactor accumulators.
       *
+      * Records a temporary snapshot of the system and calls 
+      * sampleSnapshot(). This is used only outside an AnalyzerManager,
+      * which instead calls sampleSnapshot() with a shared snapshot.
+      *
       * \param iStep step counter
       */
       virtual void sample(long iStep);
 
+      /**
+      * Add particles in a snapshot to StructureFactor accumulators.
+      *
+      * \param snapshot copy of the system state
+      */
+      virtual void sampleSnapshot(const SystemSnapshot& snapshot);
+
+      /**
+      * Return true: this class implements sampleSnapshot().
+      */
+      virtual bool isSnapshotAnalyzer() const
+      {  return true; }
+
       /**
       * Output results to predefined output file.
       */
@@ -137,6 +160,11 @@ namespace McMd
       */
       DMatrix< std::complex<double> > fourierModes_;
 
+      /**
+      * Evaluator for Fourier modes.
+      */
+      FourierSum  fourierSum_;
+
       /**
       * Array of Miller index IntVectors for wavevectors.
       */
@@ -168,8 +196,20 @@ namespace McMd
 
       /**
       * Update wavevectors.
+      *
+      * \param boundary current periodic boundary 
+      */
+      void makeWaveVectors(const Boundary& boundary);
+
+      /**
+      * Compute fourierModes_ for all wavevectors and modes.
+      *
+      * The default implementation uses a direct sum over atoms. 
+      * Subclasses may override this to use another method.
+      *
+      * \param snapshot copy of the system state
       */
-      void makeWaveVectors();
+      virtual void computeFourierModes(const SystemSnapshot& snapshot);
 
       /// Is this the first step?
       bool isFirstStep_;
@@ -0,0 +1,186 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "StructureFactorFft.h"
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/boundary/Boundary.h>
+#include <util/archives/Serializable_includes.h>
+#include <util/format/Int.h>
+#include <util/format/Dbl.h>
+
+#include <cstdlib>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   StructureFactorFft::StructureFactorFft(System& system)
+    : StructureFactorGrid(system),
+      gridSum_(),
+      shellSums_(),
+      shellCounts_(),
+      gridDimensions_(0),
+      order_(0),
+      qMax_(0.0),
+      nBin_(0)
+   {  setClassName("StructureFactorFft"); }
+
+   /*
+   * Destructor.
+   */
+   StructureFactorFft::~StructureFactorFft()
+   {}
+
+   /*
+   * Read parameters from file, and allocate arrays.
+   */
+   void StructureFactorFft::readParameters(std::istream& in)
+   {
+      StructureFactorGrid::readParameters(in);
+      read<IntVector>(in, "gridDimensions", gridDimensions_);
+      read<int>(in, "order", order_);
+      read<double>(in, "qMax", qMax_);
+      read<int>(in, "nBin", nBin_);
+
+      // All wavevectors of the grid must lie below the Nyquist index
+      for (int i = 0; i < nWave_; ++i) {
+         for (int j = 0; j < Dimension; ++j) {
+            if (2*abs(waveIntVectors_[i][j]) >= gridDimensions_[j]) {
+               UTIL_THROW("hMax too large for gridDimensions");
+            }
+         }
+      }
+      allocateShells();
+   }
+
+   /*
+   * Load state from an archive.
+   */
+   void StructureFactorFft::loadParameters(Serializable::IArchive& ar)
+   {
+      StructureFactorGrid::loadParameters(ar);
+      loadParameter<IntVector>(ar, "gridDimensions", gridDimensions_);
+      loadParameter<int>(ar, "order", order_);
+      loadParameter<double>(ar, "qMax", qMax_);
+      loadParameter<int>(ar, "nBin", nBin_);
+      shellSums_.allocate(nBin_, nMode_);
+      shellCounts_.allocate(nBin_);
+      ar & shellSums_;
+      ar & shellCounts_;
+   }
+
+   /*
+   * Save state to archive.
+   */
+   void StructureFactorFft::save(Serializable::OArchive& ar)
+   {  ar & *this; }
+
+   /*
+   * Increment structure factors.
+   */
+   void StructureFactorFft::sampleSnapshot(const SystemSnapshot& snapshot)
+   {
+      StructureFactorGrid::sampleSnapshot(snapshot);
+      sampleShells(snapshot.boundary());
+   }
+
+   /*
+   * Compute Fourier modes by grid assignment and FFT.
+   */
+   void StructureFactorFft::computeFourierModes(const SystemSnapshot& snapshot)
+   {
+      if (!gridSum_.isAllocated()) {
+         gridSum_.setup(gridDimensions_, order_, modes_);
+      }
+      gridSum_.clear(snapshot.boundary());
+      int nAtom = snapshot.nAtom();
+      for (int i = 0; i < nAtom; ++i) {
+         gridSum_.addAtom(snapshot.position(i), snapshot.typeId(i));
+      }
+      gridSum_.computeModes(waveIntVectors_, nWave_, fourierModes_);
+   }
+
+   /*
+   * Allocate and zero shell accumulators (private).
+   */
+   void StructureFactorFft::allocateShells()
+   {
+      if (nBin_ <= 0) {
+         UTIL_THROW("nBin must be positive");
+      }
+      shellSums_.allocate(nBin_, nMode_);
+      shellCounts_.allocate(nBin_);
+      for (int i = 0; i < nBin_; ++i) {
+         for (int j = 0; j < nMode_; ++j) {
+            shellSums_(i, j) = 0.0;
+         }
+         shellCounts_[i] = 0.0;
+      }
+   }
+
+   /*
+   * Add all grid wavevectors below qMax to shell accumulators (private).
+   */
+   void StructureFactorFft::sampleShells(const Boundary& boundary)
+   {
+      const double volume = boundary.volume();
+      const double dq = qMax_/double(nBin_);
+      IntVector max, n;
+      Vector q0, q1, q;
+      int i, j, bin;
+      for (i = 0; i < Dimension; ++i) {
+         max[i] = (gridDimensions_[i] - 1)/2;
+      }
+      for (n[0] = -max[0]; n[0] <= max[0]; ++n[0]) {
+         q0.multiply(boundary.reciprocalBasisVector(0), double(n[0]));
+         for (n[1] = -max[1]; n[1] <= max[1]; ++n[1]) {
+            q1.multiply(boundary.reciprocalBasisVector(1), double(n[1]));
+            q1 += q0;
+            for (n[2] = -max[2]; n[2] <= max[2]; ++n[2]) {
+               if (n[0] == 0 && n[1] == 0 && n[2] == 0) continue;
+               q.multiply(boundary.reciprocalBasisVector(2), double(n[2]));
+               q += q1;
+               bin = int(q.abs()/dq);
+               if (bin >= nBin_) continue;
+               for (j = 0; j < nMode_; ++j) {
+                  shellSums_(bin, j) += std::norm(gridSum_.mode(n, j))/volume;
+               }
+               shellCounts_[bin] += 1.0;
+            }
+         }
+      }
+   }
+
+   /*
+   * Output star averages, and shell averages to *_shell.dat.
+   */
+   void StructureFactorFft::output()
+   {
+      StructureFactorGrid::output();
+
+      fileMaster().openOutputFile(outputFileName("_shell.dat"), outputFile_);
+      const double dq = qMax_/double(nBin_);
+      for (int i = 0; i < nBin_; ++i) {
+         if (shellCounts_[i] > 0.0) {
+            outputFile_ << Dbl((double(i) + 0.5)*dq, 20, 8);
+            for (int j = 0; j < nMode_; ++j) {
+               outputFile_ << Dbl(shellSums_(i, j)/shellCounts_[i], 20, 8);
+            }
+            outputFile_ << Int(int(shellCounts_[i]/double(nSample_)), 10);
+            outputFile_ << std::endl;
+         }
+      }
+      outputFile_.close();
+   }
+
+}
@@ -0,0 +1,184 @@
+#ifndef MCMD_STRUCTURE_FACTOR_FFT_H
+#define MCMD_STRUCTURE_FACTOR_FFT_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "StructureFactorGrid.h"
+#include <util/math/GridFourierSum.h>     // member
+#include <util/space/IntVector.h>         // member
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * StructureFactorFft evaluates structure factors using a density grid.
+   *
+   * This class computes the same quantities as StructureFactorGrid,
+   * and writes the same output files, but evaluates the Fourier modes
+   * by assigning atoms to a density grid for each mode and taking a
+   * fast Fourier transform (see Util::GridFourierSum), rather than by
+   * a direct sum over atoms for every wavevector. The cost per sample
+   * is thus O(N) plus the cost of one FFT per mode, independent of
+   * the number of wavevectors, which makes it practical for large
+   * systems.
+   *
+   * In addition to the star averages output by StructureFactorGrid,
+   * this class outputs spherically averaged structure factors, in
+   * which values for all wavevectors of the FFT grid below the Nyquist
+   * index are binned into shells of equal width in |q|, up to qMax.
+   *
+   * Example, for nAtomType = 2:
+   * \code
+   * StructureFactorFft{
+   *    interval                     1000
+   *    outputFileName     StructureFactorFft
+   *    nMode                           2
+   *    modes                     1      1
+   *                              1     -1
+   *    hMax                            5
+   *    lattice                     Cubic
+   *    gridDimensions        64   64   64
+   *    order                           4
+   *    qMax                         10.0
+   *    nBin                          200
+   * }
+   * \endcode
+   *
+   * \sa \ref mcMd_analyzer_StructureFactorFft_page "parameter file format"
+   *
+   * \ingroup McMd_Analyzer_McMd_Module
+   */
+   class StructureFactorFft : public StructureFactorGrid
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param system reference to parent System object
+      */
+      StructureFactorFft(System &system);
+
+      /**
+      * Destructor.
+      */
+      ~StructureFactorFft();
+
+      /**
+      * Read parameters from file.
+      *
+      * Input format: parameters of StructureFactorGrid, followed by
+      *
+      *   - IntVector         gridDimensions  number of grid points
+      *   - int               order           B-spline order (2 = CIC)
+      *   - double            qMax            maximum |q| for shells
+      *   - int               nBin            number of shells
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load state from an archive.
+      *
+      * \param ar loading (input) archive.
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save state to archive.
+      *
+      * \param ar saving (output) archive.
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /**
+      * Serialize to/from an archive.
+      *
+      * \param ar      saving or loading archive
+      * \param version archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
+      /**
+      * Add particles to structure factor and shell accumulators.
+      *
+      * \param snapshot copy of the system state
+      */
+      virtual void sampleSnapshot(const SystemSnapshot& snapshot);
+
+      /**
+      * Output star and shell averaged structure factors.
+      */
+      virtual void output();
+
+   protected:
+
+      /**
+      * Compute fourierModes_ by FFT of a density grid.
+      *
+      * \param snapshot copy of the system state
+      */
+      virtual void computeFourierModes(const SystemSnapshot& snapshot);
+
+   private:
+
+      /// Grid assignment and FFT evaluator.
+      GridFourierSum gridSum_;
+
+      /// Shell accumulators (shell index, mode index).
+      DMatrix<double> shellSums_;
+
+      /// Number of wavevectors added to each shell.
+      DArray<double> shellCounts_;
+
+      /// Number of grid points along each axis.
+      IntVector gridDimensions_;
+
+      /// B-spline assignment order.
+      int order_;
+
+      /// Maximum wavenumber for shells.
+      double qMax_;
+
+      /// Number of shells.
+      int nBin_;
+
+      /*
+      * Allocate and zero shell accumulators.
+      */
+      void allocateShells();
+
+      /*
+      * Add all grid wavevectors to shell accumulators.
+      */
+      void sampleShells(const Boundary& boundary);
+
+   };
+
+   /*
+   * Serialize to/from an archive.
+   */
+   template <class Archive>
+   void StructureFactorFft::serialize(Archive& ar, const unsigned int version)
+   {
+      StructureFactorGrid::serialize(ar, version);
+      ar & gridDimensions_;
+      ar & order_;
+      ar & qMax_;
+      ar & nBin_;
+      ar & shellSums_;
+      ar & shellCounts_;
+   }
+
+}
+#endif
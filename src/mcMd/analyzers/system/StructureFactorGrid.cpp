@@ -30,6 +30,12 @@ namespace McMd
       isInitialized_(false)
    {  setClassName("StructureFactorGrid"); }
 
+   /*
+   * Destructor.
+   */
+   StructureFactorGrid::~StructureFactorGrid()
+   {}
+
    /*
    * Read parameters from file, and allocate data array.
    */
@@ -289,7 +295,7 @@ namespace McMd
    void StructureFactorGrid::setup() 
    {}
 
-   void StructureFactorGrid::sample(long iStep)
+   void StructureFactorGrid::sampleSnapshot(const SystemSnapshot& snapshot)
    {
 
       std::ios_base::openmode mode = std::ios_base::out;
@@ -298,12 +304,10 @@ namespace McMd
       }
       fileMaster().openOutputFile(outputFileName(".dat"), logFile_, mode);
 
-      // fileMaster().openOutputFile(outputFileName(".dat"), logFile_, !isFirstStep_);
-
-      StructureFactor::sample(iStep);
+      StructureFactor::sampleSnapshot(snapshot);
 
       // Log structure factors
-      double volume = system().boundary().volume();
+      double volume = snapshot.boundary().volume();
       double norm;
       for (int i = 0; i < nStar_; ++i) {
          int size = starSizes_[i];
@@ -70,6 +70,11 @@ namespace McMd
       */
       StructureFactorGrid(System &system);
 
+      /**
+      * Destructor.
+      */
+      ~StructureFactorGrid();
+
       /**
       * Read parameters from file.
       *
@@ -119,11 +124,11 @@ namespace McMd
       virtual void output();
 
       /**
-      * Add particles to StructureFactor accumulators.
+      * Add particles to accumulators, and log star averages.
       *
-      * \param iStep step counter
+      * \param snapshot copy of the system state
       */
-      virtual void sample(long iStep);
+      virtual void sampleSnapshot(const SystemSnapshot& snapshot);
 
    private:
 
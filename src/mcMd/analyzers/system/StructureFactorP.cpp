@@ -11,7 +11,6 @@
 #include <util/boundary/Boundary.h>
 #include <mcMd/chemistry/Molecule.h>
 #include <mcMd/chemistry/Atom.h>
-#include <util/math/Constants.h>
 #include <util/space/Dimension.h>
 #include <util/misc/FileMaster.h>
 #include <util/misc/ioUtil.h>
@@ -133,46 +132,40 @@ namespace McMd
    {
       if (isAtInterval(iStep))  {
 
-         Vector  position;
-         std::complex<double> expFactor;
-         double  product;
          System::ConstMoleculeIterator  molIter;
          Molecule::ConstAtomIterator  atomIter;
          int  nSpecies, iSpecies, typeId, i;
 
          makeWaveVectors();
 
-         // Set all Fourier modes to zero
-         for (i = 0; i < nWave_; ++i) {
-            for (typeId = 0; typeId <= nAtomType_; ++typeId) {
-               fourierModes_(i, typeId) = std::complex<double>(0.0, 0.0);
+         // Modes 0, ..., nAtomType_ - 1 are partial densities of each
+         // type, and mode nAtomType_ is the total density.
+         if (!fourierSum_.isAllocated()) {
+            DMatrix<double> modes;
+            modes.allocate(nAtomType_ + 1, nAtomType_);
+            for (i = 0; i <= nAtomType_; ++i) {
+               for (typeId = 0; typeId < nAtomType_; ++typeId) {
+                  modes(i, typeId) = (i == typeId || i == nAtomType_) 
+                                     ? 1.0 : 0.0;
+               }
             }
+            fourierSum_.setup(waveIntVectors_, nWave_, modes);
          }
- 
-         // Loop over all atoms
+
+         // Compute Fourier modes
+         fourierSum_.clear(system().boundary());
          nSpecies = system().simulation().nSpecies();
          for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
             system().begin(iSpecies, molIter); 
             for ( ; molIter.notEnd(); ++molIter) {
                molIter->begin(atomIter); 
                for ( ; atomIter.notEnd(); ++atomIter) {
-                  position = atomIter->position();
-                  typeId   = atomIter->typeId();
- 
-		  // Loop over wavevectors
-                  for (i = 0; i < nWave_; ++i) {
-               
-                     product = position.dot(waveVectors_[i]);
-                     expFactor = exp( product*Constants::Im );
-                     fourierModes_(i, typeId)     += expFactor;
-                     fourierModes_(i, nAtomType_) += expFactor;
-		 
-                  }
-  
+                  fourierSum_.addAtom(atomIter->position(), 
+                                      atomIter->typeId());
                }
             }
-
          }
+         fourierSum_.computeModes(fourierModes_);
 
          // Increment structure factors
          std::complex<double> rho[2];
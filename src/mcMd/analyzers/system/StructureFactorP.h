@@ -13,6 +13,7 @@
 #include <util/containers/DMatrix.h>             // member template
 #include <util/containers/DArray.h>              // member template
 #include <util/containers/Pair.h>                // member template parameter
+#include <util/math/FourierSum.h>                // member
 
 #include <util/global.h>
 
@@ -179,6 +180,11 @@ namespace McMd
       */
       DMatrix< std::complex<double> > fourierModes_;
 
+      /*
+      * Evaluator for Fourier modes of each type, and of all atoms.
+      */
+      FourierSum  fourierSum_;
+
       /// Array of miller index IntVectors for wavevectors.
       DArray<IntVector>  waveIntVectors_;
 
@@ -136,11 +136,28 @@ namespace McMd
       virtual void setup();
    
       /**
-      * Add particle pairs to VanHove histogram.
+      * Add Fourier modes to autocorrelation accumulators.
+      *
+      * Records a temporary snapshot of the system and calls 
+      * sampleSnapshot(). This is used only outside an AnalyzerManager,
+      * which instead calls sampleSnapshot() with a shared snapshot.
       *
       * \param iStep step counter
       */
-      void sample(long iStep);
+      virtual void sample(long iStep);
+
+      /**
+      * Add Fourier modes of a snapshot to autocorrelation accumulators.
+      *
+      * \param snapshot copy of the system state
+      */
+      virtual void sampleSnapshot(const SystemSnapshot& snapshot);
+
+      /**
+      * Return true: this class implements sampleSnapshot().
+      */
+      virtual bool isSnapshotAnalyzer() const
+      {  return true; }
 
       /**
       * Output results to predefined output file.
@@ -184,7 +201,7 @@ namespace McMd
       bool isInitialized_;
 
       /// Update wavevectors.
-      void makeWaveVectors();
+      void makeWaveVectors(const Boundary& boundary);
 
    };
 
@@ -3,8 +3,10 @@ mcMd_analyzers_system_=\
     mcMd/analyzers/system/ComMSD.cpp \
     mcMd/analyzers/system/CompositionProfile.cpp \
     mcMd/analyzers/system/RDF.cpp \
+    mcMd/analyzers/system/CellRDF.cpp \
     mcMd/analyzers/system/StructureFactor.cpp \
     mcMd/analyzers/system/StructureFactorGrid.cpp \
+    mcMd/analyzers/system/StructureFactorFft.cpp \
     mcMd/analyzers/system/StructureFactorP.cpp \
     mcMd/analyzers/system/StructureFactorPGrid.cpp \
     mcMd/analyzers/system/SystemAnalyzerFactory.cpp \
@@ -19,8 +19,9 @@ namespace McMd
    /**
    * Descriptor for a type of Atom.
    *
-   * An AtomTypeType has a mass, a name string, and an integer id.
-   * [It will later acquire a charge.]
+   * An AtomType has a mass, a name string, an integer id and a charge.
+   * The charge is read from and written to file, and serialized, only
+   * if the static hasCharge flag is set (see setHasCharge()).
    *
    * \ingroup McMd_Chemistry_Module
    */
@@ -63,6 +64,20 @@ namespace McMd
       */
       void setName(std::string name);
 
+      /**
+      * Set the charge.
+      *
+      * \param charge atom charge
+      */
+      void setCharge(double charge);
+
+      /**
+      * Enable (true) or disable (false) input and output of charges.
+      *
+      * \param hasCharge new value for hasCharge static bool flag.
+      */
+      static void setHasCharge(bool hasCharge);
+
       //@}
       /// \name Accessors
       //@{
@@ -76,13 +91,25 @@ namespace McMd
       /// Get the index.
       int id() const;
 
+      /// Get the charge.
+      double charge() const;
+
+      /// Are charges enabled?
+      static bool hasCharge();
+
       //@}
 
    private:
 
-      /// Name of type.
+      /// Static member determines if charges are read and written.
+      static bool hasCharge_;
+
+      /// Mass of type.
       double       mass_;
 
+      /// Charge of type.
+      double       charge_;
+
       /// Name of type.
       std::string  name_;
 
@@ -121,6 +148,18 @@ namespace McMd
    inline int  AtomType::id() const
    {  return id_; }
 
+   // Set the charge.
+   inline void AtomType::setCharge(double charge)
+   {  charge_ = charge; }
+
+   // Get the charge.
+   inline double AtomType::charge() const
+   {  return charge_; }
+
+   // Are charges enabled?
+   inline bool AtomType::hasCharge()
+   {  return hasCharge_; }
+
    // Friend operator declarations
 
    /**
@@ -128,7 +167,9 @@ namespace McMd
    *
    * Format:
    *
-   *    name  [string] mass [double]
+   *    name  [string] mass [double] charge [double]
+   *
+   * The charge is read only if AtomType::hasCharge() is true.
    *
    * \param in  input stream
    * \param atomType  AtomType to be read from stream
@@ -141,7 +182,7 @@ namespace McMd
    *
    * Format, one one line with no line break:
    *
-   *    name  mass
+   *    name  mass  [charge]
    *
    * \param  out  output stream
    * \param  atomType  AtomType to be written to stream
@@ -161,6 +202,9 @@ namespace McMd
    {
       ar & atomType.name_;
       ar & atomType.mass_;
+      if (AtomType::hasCharge_) {
+         ar & atomType.charge_;
+      }
    }
 
 }
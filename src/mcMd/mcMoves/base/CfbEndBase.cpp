@@ -63,7 +63,7 @@ namespace McMd
    {
       Vector bondVec;
       Vector pvtPos = pvtPtr->position();
-      double trialEnergy, lengthSq, length;
+      double lengthSq, length;
    
       // Calculate bond length of pvt-end bond
       lengthSq = boundary().distanceSq(pvtPos, endPtr->position());
@@ -125,19 +125,31 @@ namespace McMd
       // This is the final value of inout energy parameter.
       energy += system().bondPotential().energy(lengthSq, bondType);
 
-      // Loop over nTrial - 1 additional trial positions:
-      for (int iTrial=0; iTrial < nTrial_ - 1; ++iTrial) {
-
+      // Generate nTrial - 1 additional trial positions
+      Vector trialPos[MaxTrial_];
+      double trialEnergy[MaxTrial_];
+      int    nTrial = nTrial_ - 1;
+      int    iTrial;
+      for (iTrial = 0; iTrial < nTrial; ++iTrial) {
          random().unitVector(bondVec);
          bondVec *= length;
-         endPtr->position().add(pvtPos, bondVec);  
-         boundary().shift(endPtr->position());
+         trialPos[iTrial].add(pvtPos, bondVec);  
+         boundary().shift(trialPos[iTrial]);
+      }
 
-         #ifndef INTER_NOPAIR
-         trialEnergy = system().pairPotential().atomEnergy(*endPtr);
-         #else
-         trialEnergy = 0.0;
-         #endif
+      // Compute pair energies of all trial positions
+      #ifndef INTER_NOPAIR
+      system().pairPotential()
+              .trialEnergies(*endPtr, trialPos, nTrial, trialEnergy);
+      #else
+      for (iTrial = 0; iTrial < nTrial; ++iTrial) {
+         trialEnergy[iTrial] = 0.0;
+      }
+      #endif
+
+      // Add angle and external energies, and Boltzmann factors
+      for (iTrial = 0; iTrial < nTrial; ++iTrial) {
+         endPtr->position() = trialPos[iTrial];
 
          #ifdef INTER_ANGLE
          if (system().hasAnglePotential()) {
@@ -163,19 +175,19 @@ namespace McMd
                                          pvtPtr->position(), dr2);
             cosTheta = dr1.dot(dr2) / sqrt(rsq1 * rsq2);
    
-            trialEnergy += system().anglePotential()
-                                   .energy(cosTheta, angleTypeId);
+            trialEnergy[iTrial] += system().anglePotential()
+                                           .energy(cosTheta, angleTypeId);
          }
          #endif
 
          #ifdef INTER_EXTERNAL
          if (system().hasExternalPotential()) {
-            trialEnergy += system().externalPotential()
-                                   .atomEnergy(*endPtr);
+            trialEnergy[iTrial] += system().externalPotential()
+                                           .atomEnergy(*endPtr);
          }
          #endif
 
-         rosenbluth += boltzmann(trialEnergy);
+         rosenbluth += boltzmann(trialEnergy[iTrial]);
       }
 
    }
@@ -209,20 +221,29 @@ namespace McMd
       length = 
          system().bondPotential().randomBondLength(&random(), beta, bondType);
    
-      // Loop over nTrial trial positions:
-      rosenbluth = 0.0;
+      // Generate nTrial trial positions
       for (iTrial=0; iTrial < nTrial_; ++iTrial) {
          random().unitVector(bondVec);
          bondVec *= length;
          // trialPos = pvtPos + bondVec
          trialPos[iTrial].add(pvtPos, bondVec); 
          boundary().shift(trialPos[iTrial]);
-         endPtr->position() = trialPos[iTrial];
-         #ifndef INTER_NOPAIR
-         trialEnergy[iTrial] = system().pairPotential().atomEnergy(*endPtr);
-         #else
+      }
+
+      // Compute pair energies of all trial positions
+      #ifndef INTER_NOPAIR
+      system().pairPotential()
+              .trialEnergies(*endPtr, trialPos, nTrial_, trialEnergy);
+      #else
+      for (iTrial=0; iTrial < nTrial_; ++iTrial) {
          trialEnergy[iTrial] = 0.0;
-         #endif
+      }
+      #endif
+
+      // Add angle and external energies, and compute probabilities
+      rosenbluth = 0.0;
+      for (iTrial=0; iTrial < nTrial_; ++iTrial) {
+         endPtr->position() = trialPos[iTrial];
 
          #ifdef INTER_ANGLE
          if (system().hasAnglePotential()) {
@@ -156,7 +156,7 @@ namespace McMd
       Vector  prevPos = prevPtr->position();
       Vector  nextPos = nextPtr->position();
       Vector  partPos = partPtr->position();
-      Vector  bondVec, trialPos, u_20, u_21;
+      Vector  bondVec, u_20, u_21;
       double  trialEnergy, bondEnergy, wExt, length, lengthSq;
       double  l_20, l_21, bias;
       double  prefAng, kappaAng, normConst;
@@ -211,16 +211,19 @@ namespace McMd
       wExt = boltzmann(trialEnergy + bondEnergy);
       
       // Generate "nTrial-1" trial positions based on 1-0 bonding.
+      Vector trialPos[MaxTrial_];
+      double trialEnergies[MaxTrial_];
+      int    nTrial = nTrial_ - 1;
       length = l_21;
-      for (iTrial=0; iTrial < nTrial_ - 1; iTrial++) {
+      for (iTrial=0; iTrial < nTrial; iTrial++) {
          ready = false;
          while (!ready) {
             random().unitVector(bondVec);
             bondVec *= length;
-            trialPos.add(prevPos, bondVec);
-            boundary().shift(trialPos);
+            trialPos[iTrial].add(prevPos, bondVec);
+            boundary().shift(trialPos[iTrial]);
    
-            lengthSq = boundary().distanceSq(trialPos, prevPos, u_21);
+            lengthSq = boundary().distanceSq(trialPos[iTrial], prevPos, u_21);
             l_21  = sqrt(lengthSq);
             u_21 /= l_21;
             orientationBias(u_21, u_20, prefAng, kappaAng, bias);
@@ -230,30 +233,41 @@ namespace McMd
                ready = true;
             }
          }
+      }
+
+      // Compute pair energies of all trial positions
+      #ifndef INTER_NOPAIR
+      system().pairPotential()
+              .trialEnergies(*partPtr, trialPos, nTrial, trialEnergies);
+      #else
+      for (iTrial=0; iTrial < nTrial; iTrial++) {
+         trialEnergies[iTrial] = 0.0;
+      }
+      #endif
+
+      // Add bonded and external energies, and Boltzmann factors
+      for (iTrial=0; iTrial < nTrial; iTrial++) {
          
          // Bond 1-0 potential energy
-         lengthSq   = boundary().distanceSq(trialPos, nextPos);
+         lengthSq   = boundary().distanceSq(trialPos[iTrial], nextPos);
          bondEnergy = system().bondPotential().energy(lengthSq, nextBType);
-         partPtr->position() = trialPos;
-         #ifndef INTER_NOPAIR
-         trialEnergy = system().pairPotential().atomEnergy(*partPtr);
-         #else
-         trialEnergy = 0.0;
-         #endif
+         partPtr->position() = trialPos[iTrial];
 
          #ifdef INTER_ANGLE
          if (system().hasAnglePotential()) {
-            trialEnergy += system().anglePotential().atomEnergy(*partPtr);
+            trialEnergies[iTrial] += 
+                  system().anglePotential().atomEnergy(*partPtr);
          }
          #endif
 
          #ifdef INTER_EXTERNAL
          if (system().hasExternalPotential()) {
-            trialEnergy += system().externalPotential().atomEnergy(*partPtr);
+            trialEnergies[iTrial] += 
+                  system().externalPotential().atomEnergy(*partPtr);
          }
          #endif
 
-         wExt += boltzmann(trialEnergy + bondEnergy);
+         wExt += boltzmann(trialEnergies[iTrial] + bondEnergy);
       }
    
       // Update Rosenbluth weight (orientation bias has been removed earlier)
@@ -319,6 +333,20 @@ namespace McMd
                ready = true;
             }
          }
+      }
+
+      // Compute pair energies of all trial positions
+      #ifndef INTER_NOPAIR
+      system().pairPotential()
+              .trialEnergies(*partPtr, trialPos, nTrial_, trialEnergy);
+      #else
+      for (iTrial=0; iTrial < nTrial_; iTrial++) {
+         trialEnergy[iTrial] = 0.0;
+      }
+      #endif
+
+      // Add bonded and external energies, and compute probabilities
+      for (iTrial=0; iTrial < nTrial_; iTrial++) {
          
          // Bond 1-0 potential energy 
          lengthSq = boundary().distanceSq(trialPos[iTrial], nextPos);
@@ -326,12 +354,6 @@ namespace McMd
             system().bondPotential().energy(lengthSq, nextBType);
          partPtr->position() = trialPos[iTrial];
 
-         #ifndef INTER_NOPAIR
-         trialEnergy[iTrial] = system().pairPotential().atomEnergy(*partPtr);
-         #else
-         trialEnergy[iTrial] = 0.0;
-         #endif
-
          #ifdef INTER_ANGLE
          if (system().hasAnglePotential()) {
             trialEnergy[iTrial] += 
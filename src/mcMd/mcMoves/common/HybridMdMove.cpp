@@ -11,6 +11,9 @@
 #include <mcMd/mdSimulation/MdSystem.h>
 #include <mcMd/simulation/Simulation.h>
 #include <mcMd/chemistry/Atom.h>
+#ifdef MCMD_PERTURB
+#include <mcMd/perturb/Perturbation.h>
+#endif
 #ifndef INTER_NOPAIR
 #include <mcMd/potentials/pair/MdPairPotential.h>
 #include <mcMd/potentials/pair/McPairPotential.h>
@@ -27,11 +30,19 @@ namespace McMd
    HybridMdMove::HybridMdMove(McSystem& system) :
       SystemMove(system),
       mdSystemPtr_(0),
-      nStep_(0)
+      oldLengths_(),
+      oldPotential_(0.0),
+      oldNAtom_(0),
+      nStep_(0),
+      isCached_(false),
+      hasOldForces_(false)
    {
       setClassName("HybridMdMove");
       mdSystemPtr_ = new MdSystem(system);
-      oldPositions_.allocate(simulation().atomCapacity());
+      int atomCapacity = simulation().atomCapacity();
+      oldPositions_.allocate(atomCapacity);
+      oldForces_.allocate(atomCapacity);
+      oldTypeIds_.allocate(atomCapacity);
    }
 
    /*
@@ -74,6 +85,16 @@ namespace McMd
       mdSystemPtr_->saveParameters(ar);
    }
 
+   /*
+   * Invalidate the cached configuration.
+   */
+   void HybridMdMove::setup()
+   {
+      McMove::setup();
+      isCached_ = false;
+      hasOldForces_ = false;
+   }
+
    /*
    * Generate, attempt and accept or reject a Hybrid MD/MC move.
    */
@@ -81,33 +102,96 @@ namespace McMd
    {
       System::MoleculeIterator molIter;
       Molecule::AtomIterator   atomIter;
+      double oldPotential, newPotential;
       double oldEnergy, newEnergy;
-      int    iSpec;
+      int    iSpec, id;
       int    nSpec = simulation().nSpecies();
+      int    nAtom = 0;
+      bool   isCurrent = isCached_;
       bool   accept;
 
       incrementNAttempt();
 
-      // Store old atom positions in oldPositions_ array.
+      // Store old atom positions in oldPositions_ array, and check 
+      // whether the configuration is that left by the previous move.
       for (iSpec = 0; iSpec < nSpec; ++iSpec) {
          mdSystemPtr_->begin(iSpec, molIter);
          for ( ; molIter.notEnd(); ++molIter) {
             for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
-               oldPositions_[atomIter->id()] = atomIter->position();
+               id = atomIter->id();
+               if (isCurrent) {
+                  if (atomIter->position() != oldPositions_[id] ||
+                      atomIter->typeId() != oldTypeIds_[id]) {
+                     isCurrent = false;
+                  }
+               }
+               oldPositions_[id] = atomIter->position();
+               oldTypeIds_[id] = atomIter->typeId();
+               ++nAtom;
+            }
+         }
+      }
+      if (isCurrent) {
+         if (nAtom != oldNAtom_) isCurrent = false;
+         if (system().boundary().lengths() != oldLengths_) isCurrent = false;
+         #ifdef MCMD_PERTURB
+         if (system().hasPerturbation()) {
+            int nParameter = system().perturbation().getNParameters();
+            for (int i = 0; i < nParameter; ++i) {
+               if (system().perturbation().parameter(i) 
+                   != oldParameters_[i]) {
+                  isCurrent = false;
+               }
             }
          }
+         #endif
       }
 
       // Initialize MdSystem
-      #ifndef INTER_NOPAIR
-      mdSystemPtr_->pairPotential().buildPairList();
-      #endif
-      mdSystemPtr_->calculateForces();
+      if (isCurrent) {
+         // The pair list is rebuilt by calculateForces(), potentialEnergy()
+         // or the integrator if the atoms have moved too far since it was 
+         // built, so the cached potential energy and forces are reused.
+         oldPotential = oldPotential_;
+         if (hasOldForces_) {
+            for (iSpec = 0; iSpec < nSpec; ++iSpec) {
+               mdSystemPtr_->begin(iSpec, molIter);
+               for ( ; molIter.notEnd(); ++molIter) {
+                  molIter->begin(atomIter);
+                  for ( ; atomIter.notEnd(); ++atomIter) {
+                     atomIter->force() = oldForces_[atomIter->id()];
+                  }
+               }
+            }
+         } else {
+            mdSystemPtr_->calculateForces();
+         }
+      } else {
+         #ifndef INTER_NOPAIR
+         mdSystemPtr_->pairPotential().buildPairList();
+         #endif
+         mdSystemPtr_->calculateForces();
+         oldPotential = mdSystemPtr_->potentialEnergy();
+      }
+
+      // Store old forces in oldForces_ array, unless already present.
+      if (!(isCurrent && hasOldForces_)) {
+         for (iSpec = 0; iSpec < nSpec; ++iSpec) {
+            mdSystemPtr_->begin(iSpec, molIter);
+            for ( ; molIter.notEnd(); ++molIter) {
+               molIter->begin(atomIter);
+               for ( ; atomIter.notEnd(); ++atomIter) {
+                  oldForces_[atomIter->id()] = atomIter->force();
+               }
+            }
+         }
+      }
+
       mdSystemPtr_->setBoltzmannVelocities(energyEnsemble().temperature());
       mdSystemPtr_->mdIntegrator().setup();
 
       // Store old energy
-      oldEnergy  = mdSystemPtr_->potentialEnergy();
+      oldEnergy  = oldPotential;
       oldEnergy += mdSystemPtr_->kineticEnergy();
 
       // Run a short MD simulation
@@ -116,7 +200,8 @@ namespace McMd
       }
 
       // Calculate new energy
-      newEnergy  = mdSystemPtr_->potentialEnergy();
+      newPotential = mdSystemPtr_->potentialEnergy();
+      newEnergy  = newPotential;
       newEnergy += mdSystemPtr_->kineticEnergy();
 
       // Decide whether to accept or reject
@@ -125,10 +210,23 @@ namespace McMd
       // Accept move
       if (accept) {
 
-         #ifndef INTER_NOPAIR
-         // Rebuild the McSystem cellList using the new positions.
-         system().pairPotential().buildCellList();
-         #endif
+         // Update the McSystem cellList, for atoms that changed cells,
+         // and store the new positions in the oldPositions_ array.
+         for (iSpec = 0; iSpec < nSpec; ++iSpec) {
+            mdSystemPtr_->begin(iSpec, molIter);
+            for ( ; molIter.notEnd(); ++molIter) {
+               molIter->begin(atomIter);
+               for ( ; atomIter.notEnd(); ++atomIter) {
+                  #ifndef INTER_NOPAIR
+                  system().boundary().shift(atomIter->position());
+                  system().pairPotential().updateAtomCell(*atomIter);
+                  #endif
+                  oldPositions_[atomIter->id()] = atomIter->position();
+               }
+            }
+         }
+         oldPotential_ = newPotential;
+         hasOldForces_ = false;
 
          // Increment counter for the number of accepted moves.
          incrementNAccept();
@@ -145,9 +243,32 @@ namespace McMd
                }
             }
          }
+         oldPotential_ = oldPotential;
+         hasOldForces_ = true;
 
       }
 
+      // Record the state of the cached configuration. Changes in 
+      // the topology of a LinkPotential are not detected, so no
+      // configuration is cached if a LinkPotential exists.
+      oldNAtom_ = nAtom;
+      oldLengths_ = system().boundary().lengths();
+      #ifdef MCMD_PERTURB
+      if (system().hasPerturbation()) {
+         int nParameter = system().perturbation().getNParameters();
+         if (!oldParameters_.isAllocated()) {
+            oldParameters_.allocate(nParameter);
+         }
+         for (int i = 0; i < nParameter; ++i) {
+            oldParameters_[i] = system().perturbation().parameter(i);
+         }
+      }
+      #endif
+      isCached_ = true;
+      #ifdef MCMD_LINK
+      if (system().hasLinkPotential()) isCached_ = false;
+      #endif
+
       return accept;
 
    }
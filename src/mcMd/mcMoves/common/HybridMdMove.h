@@ -24,6 +24,18 @@ namespace McMd
    /**
    * HybridMdMove is a hybrid Molecular Dynamics MC move.
    *
+   * Each move attempt begins from the configuration left by the 
+   * previous attempt, unless another move has since modified it. 
+   * The move therefore caches the atomic positions and types, the 
+   * forces and the potential energy of the configuration in which
+   * the previous attempt ended. If these positions, types, the 
+   * number of atoms and the boundary are unchanged at the start of
+   * the next attempt, the MdSystem pair list is rebuilt only if it
+   * is no longer current, the potential energy is not recomputed,
+   * and, after a rejected attempt, the restored forces are reused.
+   * After an accepted attempt, only atoms that moved to a different
+   * cell are moved within the McSystem cell list.
+   *
    * \ingroup McMd_McMove_Module MD_Module
    */
    class HybridMdMove : public SystemMove 
@@ -66,6 +78,23 @@ namespace McMd
       * Generate, attempt and accept or reject a move.
       */
       bool move();
+
+      /**
+      * Setup before a simulation run.
+      *
+      * Invalidates the cached configuration, since potential energy 
+      * parameters may have been modified since the previous run.
+      */
+      virtual void setup();
+
+      /**
+      * Return the potential energy of the cached configuration.
+      *
+      * This is the potential energy of the configuration in which the
+      * most recent attempt ended, which is reused as the initial energy
+      * of the next attempt if that configuration is still current.
+      */
+      double cachedPotential() const;
    
    private:
   
@@ -75,9 +104,43 @@ namespace McMd
       /// Array to store old atomic positions.
       DArray<Vector> oldPositions_; 
 
+      /// Array to store old atomic forces.
+      DArray<Vector> oldForces_; 
+
+      /// Atom type ids of the cached configuration.
+      DArray<int>    oldTypeIds_; 
+
+      #ifdef MCMD_PERTURB
+      /// Perturbation parameters of the cached configuration.
+      DArray<double> oldParameters_; 
+      #endif
+
+      /// Boundary lengths of the cached configuration.
+      Vector         oldLengths_;
+
+      /// Potential energy of the cached configuration.
+      double         oldPotential_;
+
+      /// Number of atoms in the cached configuration.
+      int            oldNAtom_;
+
       /// Number of Md steps per Hybrid MD move
       int            nStep_;
+
+      /// Is the cached configuration valid?
+      bool           isCached_;
+
+      /// Are oldForces_ the forces of the cached configuration?
+      bool           hasOldForces_;
    };
 
+   // Inline method
+
+   /*
+   * Return the potential energy of the cached configuration.
+   */
+   inline double HybridMdMove::cachedPotential() const
+   {  return oldPotential_; }
+
 }      
 #endif
@@ -189,36 +189,52 @@ namespace McMd
       // Add bond energy to total energy in current position
       energy += bondEnergy;
 
-      // Loop over nTrial - 1 additional trial positions:
-      double trialEnergy;
-      for (int iTrial = 0; iTrial < nTrial_ - 1; ++iTrial) {
-
-         // Generate trial position
+      // Generate nTrial - 1 additional trial positions
+      Vector trialPos[MaxTrial_];
+      double trialEnergy[MaxTrial_];
+      #ifdef INTER_ANGLE
+      double trialCosTheta[MaxTrial_];
+      #endif
+      int nTrial = nTrial_ - 1;
+      int iTrial;
+      for (iTrial = 0; iTrial < nTrial; ++iTrial) {
          random().unitVector(u1);
          v1 = u1;
          v1 *= r1;
-         pos0.subtract(pos1, v1);
-         boundary().shift(pos0);
-
-         // Compute trial energy (excluding bond energy)
-         #ifndef INTER_NOPAIR
-         trialEnergy = system().pairPotential().atomEnergy(atom0);
-         #else
-         trialEnergy = 0.0;
+         trialPos[iTrial].subtract(pos1, v1);
+         boundary().shift(trialPos[iTrial]);
+         #ifdef INTER_ANGLE
+         if (hasAngle) {
+            trialCosTheta[iTrial] = u1.dot(u2);
+         }
          #endif
+      }
+
+      // Compute pair energies of all trial positions
+      #ifndef INTER_NOPAIR
+      pairPotential.trialEnergies(atom0, trialPos, nTrial, trialEnergy);
+      #else
+      for (iTrial = 0; iTrial < nTrial; ++iTrial) {
+         trialEnergy[iTrial] = 0.0;
+      }
+      #endif
+
+      // Add angle and external energies (excluding bond energy)
+      for (iTrial = 0; iTrial < nTrial; ++iTrial) {
+         pos0 = trialPos[iTrial];
          #ifdef INTER_ANGLE
          if (hasAngle) {
-            cosTheta = u1.dot(u2);
-            trialEnergy += anglePotential.energy(cosTheta, angleTypeId);
+            trialEnergy[iTrial] += 
+                  anglePotential.energy(trialCosTheta[iTrial], angleTypeId);
          }
          #endif
          #ifdef INTER_EXTERNAL
          if (hasExternal_) {
-            trialEnergy += externalPotential.atomEnergy(atom0);
+            trialEnergy[iTrial] += externalPotential.atomEnergy(atom0);
          }
          #endif
 
-         rosenbluth += boltzmann(trialEnergy);
+         rosenbluth += boltzmann(trialEnergy[iTrial]);
       }
 
    }
@@ -253,7 +269,7 @@ namespace McMd
       #ifdef INTER_ANGLE
       // Calculate vector v2 = pos2 - pos1, r2 = |v2|
       Vector v2, u2;
-      double r2, cosTheta;
+      double r2;
       Vector* pos2Ptr;
       AnglePotential& anglePotential = system().anglePotential();
       int angleTypeId;
@@ -283,32 +299,45 @@ namespace McMd
                                       = system().externalPotential();
       #endif
 
-      // Loop over nTrial trial positions:
+      // Generate nTrial trial positions
       Vector v1, u1;
       Vector trialPos[MaxTrial_];
       double trialProb[MaxTrial_], trialEnergy[MaxTrial_];
-      rosenbluth = 0.0;
+      #ifdef INTER_ANGLE
+      double trialCosTheta[MaxTrial_];
+      #endif
       for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
 
-         // Generate trial bond vector v1 and position pos0
+         // Generate trial bond vector v1 and position
          random().unitVector(u1);
          v1 = u1;
          v1 *= r1;
          trialPos[iTrial].subtract(pos1, v1);
          boundary().shift(trialPos[iTrial]);
-         pos0 = trialPos[iTrial];
+         #ifdef INTER_ANGLE
+         if (hasAngle) {
+            trialCosTheta[iTrial] = u1.dot(u2);
+         }
+         #endif
+      }
 
-         // Compute trial energy (excluding bond energy)
-         #ifndef INTER_NOPAIR
-         trialEnergy[iTrial] = pairPotential.atomEnergy(atom0);
-         #else
+      // Compute pair energies of all trial positions
+      #ifndef INTER_NOPAIR
+      pairPotential.trialEnergies(atom0, trialPos, nTrial_, trialEnergy);
+      #else
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
          trialEnergy[iTrial] = 0.0;
-         #endif
+      }
+      #endif
+
+      // Add angle and external energies (excluding bond energy)
+      rosenbluth = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         pos0 = trialPos[iTrial];
          #ifdef INTER_ANGLE
          if (hasAngle) {
-            cosTheta = u1.dot(u2);
             trialEnergy[iTrial] += 
-                        anglePotential.energy(cosTheta, angleTypeId);
+                  anglePotential.energy(trialCosTheta[iTrial], angleTypeId);
          }
          #endif
          #ifdef INTER_EXTERNAL
@@ -65,6 +65,7 @@ namespace McMd
       paramFilePtr_(0),
       saveFileName_(),
       saveInterval_(0),
+      restartWriter_(),
       isInitialized_(false),
       isRestarting_(false)
    {
@@ -95,6 +96,7 @@ namespace McMd
       paramFilePtr_(0),
       saveFileName_(),
       saveInterval_(0),
+      restartWriter_(),
       isInitialized_(false),
       isRestarting_(false)
    {
@@ -378,11 +380,10 @@ namespace McMd
    {
       if (saveInterval_ > 0) {
          if (iStep_ % saveInterval_ == 0) {
-            Serializable::OArchive ar;
-            std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
-            fileMaster().openRestartOFile(filename, ar.file(), mode);
+            // Serialize to memory, write to file in the background
+            Serializable::OArchive ar(restartWriter_.stream());
             save(ar);
-            ar.file().close();
+            restartWriter_.write(fileMaster().restartFileName(filename));
          }
       }
    }
@@ -450,6 +451,7 @@ namespace McMd
 
             if (command == "FINISH") {
                Log::file() << std::endl;
+               restartWriter_.wait();
                readNext = false;
             } else
             if (command == "SET_CONFIG_IO") {
@@ -718,9 +720,9 @@ namespace McMd
          if (system().hasPerturbation()) {
             if (system().hasReplicaMove()) {
                if (system().replicaMove().isAtInterval(iStep_)) {
-                  bool success = system().replicaMove().move();
+                  bool moved = system().replicaMove().move();
                   #ifndef INTER_NOPAIR
-                  if (success) {
+                  if (moved) {
                      system().pairPotential().buildCellList();
                   }
                   #endif
@@ -742,6 +744,7 @@ namespace McMd
             analyzerManager().sample(iStep_);
          }
       }
+      restartWriter_.wait();
 
       // Output results of all analyzers to output files
       analyzerManager().output();
@@ -784,6 +787,18 @@ namespace McMd
       }
       Log::file() << endl;
 
+      #ifndef INTER_NOPAIR
+      // Print VerletList rebuild statistics
+      if (system().pairPotential().hasVerletList()) {
+         const VerletList& list = system().pairPotential().verletList();
+         Log::file() << "VerletList full rebuilds      "
+                     << list.nFullBuild() << endl;
+         Log::file() << "VerletList single atom builds "
+                     << list.nPartialBuild() << endl;
+         Log::file() << endl;
+      }
+      #endif
+
       #ifdef UTIL_MPI
       #ifdef MCMD_PERTURB
       // Print replica-exchange acceptance statistics
@@ -10,6 +10,7 @@
 
 #include <mcMd/simulation/Simulation.h>   // base class
 #include <mcMd/mcSimulation/McSystem.h>   // class member
+#include <util/misc/AsyncFileWriter.h>     // class member
 #include <util/global.h>
 
 namespace Util { template <typename T> class Factory; }
@@ -182,7 +183,13 @@ namespace McMd
                              std::string classname, std::string filename);
 
       /**
-      * Write restart files.
+      * Write restart files, if iStep is a multiple of saveInterval.
+      *
+      * The state is serialized to a memory buffer, which is written to
+      * disk by an AsyncFileWriter. The file is written in background if
+      * UTIL_CXX11 is defined, and is replaced atomically in either case.
+      *
+      * \param filename base file name for restart file.
       */
       void save(const std::string& filename);
 
@@ -247,6 +254,9 @@ namespace McMd
       /// Interval for writing restart files (no output if 0)
       int saveInterval_;
 
+      /// Double-buffered writer for restart files.
+      AsyncFileWriter restartWriter_;
+
       /// Has readParam been called?
       bool isInitialized_;
 
@@ -126,6 +126,12 @@ namespace McMd
       readFileMaster(in);
       readPotentialStyles(in);
 
+      #ifdef INTER_COULOMB
+      if (simulation().hasCoulomb()) {
+         UTIL_THROW("Coulomb potential not implemented for McSystem");
+      }
+      #endif
+
       #ifndef INTER_NOPAIR
       pairPotentialPtr_ = pairFactory().mcFactory(pairStyle(), *this);
       if (pairPotentialPtr_ == 0) {
@@ -222,6 +228,12 @@ namespace McMd
       loadFileMaster(ar);
       loadPotentialStyles(ar);
 
+      #ifdef INTER_COULOMB
+      if (simulation().hasCoulomb()) {
+         UTIL_THROW("Coulomb potential not implemented for McSystem");
+      }
+      #endif
+
       #ifndef INTER_NOPAIR
       pairPotentialPtr_ = pairFactory().mcFactory(pairStyle(), *this);
       if (pairPotentialPtr_ == 0) {
@@ -0,0 +1,222 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "NveRespaIntegrator.h"
+#include <mcMd/mdSimulation/MdSystem.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/potentials/pair/MdPairPotential.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/archives/Serializable_includes.h>
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   NveRespaIntegrator::NveRespaIntegrator(MdSystem& system)
+   : MdIntegrator(system),
+     slowForces_(),
+     nInner_(1),
+     prefactors_(),
+     innerPrefactors_()
+   {  setClassName("NveRespaIntegrator"); }
+
+   /*
+   * Destructor.
+   */
+   NveRespaIntegrator::~NveRespaIntegrator()
+   {}
+
+   /*
+   * Read parameters.
+   */
+   void NveRespaIntegrator::readParameters(std::istream &in)
+   {
+      read<double>(in, "dt", dt_);
+      read<int>(in, "nInner", nInner_);
+      allocate();
+   }
+
+   /*
+   * Load the internal state from an archive.
+   */
+   void NveRespaIntegrator::loadParameters(Serializable::IArchive& ar)
+   {
+      loadParameter<double>(ar, "dt", dt_);
+      loadParameter<int>(ar, "nInner", nInner_);
+      allocate();
+   }
+
+   /*
+   * Save the internal state to an archive.
+   */
+   void NveRespaIntegrator::save(Serializable::OArchive& ar)
+   {
+      ar & dt_;
+      ar & nInner_;
+   }
+
+   /*
+   * Validate parameters, allocate arrays and set prefactors (private).
+   */
+   void NveRespaIntegrator::allocate()
+   {
+      if (nInner_ < 1) {
+         UTIL_THROW("nInner must be positive");
+      }
+      int nAtomType = simulation().nAtomType();
+      if (!prefactors_.isAllocated()) {
+         prefactors_.allocate(nAtomType);
+         innerPrefactors_.allocate(nAtomType);
+         slowForces_.allocate(simulation().atomCapacity());
+      }
+      double mass;
+      for (int i = 0; i < nAtomType; ++i) {
+         mass = simulation().atomType(i).mass();
+         prefactors_[i] = 0.5*dt_/mass;
+         innerPrefactors_[i] = prefactors_[i]/double(nInner_);
+      }
+   }
+
+   /*
+   * Initialize constants.
+   */
+   void NveRespaIntegrator::setup()
+   {  allocate(); }
+
+   /*
+   * r-RESPA integrator step.
+   *
+   * This method implements the algorithm:
+   *
+   *        fs(n) = f(n) - ff(n)
+   *        v  = v(n) + 0.5*fs(n)*dt/m
+   *
+   *        repeat nInner times, with h = dt/nInner:
+   *            v = v + 0.5*ff*h/m
+   *            x = x + v*h
+   *            calculate fast forces ff
+   *            v = v + 0.5*ff*h/m
+   *
+   *        calculate slow forces fs(n+1)
+   *        v(n+1) = v + 0.5*fs(n+1)*dt/m
+   *
+   * where f is the total force, ff is the fast force and fs is the
+   * slow force. The slow forces include any thermostat forces added
+   * by addThermostatForces().
+   */
+   void NveRespaIntegrator::step()
+   {
+      Vector dv;
+      Vector dr;
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      double h = dt_/double(nInner_);
+      double factor;
+      int iSpecies, nSpecies, typeId, id, k;
+
+      nSpecies = simulation().nSpecies();
+
+      // Store total forces, then compute fast forces
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               slowForces_[atomIter->id()] = atomIter->force();
+            }
+         }
+      }
+      system().setZeroForces();
+      system().addFastForces();
+
+      // Extract slow forces, half step velocity update with slow forces
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               Vector& slowForce = slowForces_[atomIter->id()];
+               slowForce -= atomIter->force();
+               dv.multiply(slowForce, prefactors_[atomIter->typeId()]);
+               atomIter->velocity() += dv;
+            }
+         }
+      }
+
+      // Inner velocity-Verlet loop with fast forces. The second half
+      // velocity update of each inner step is merged with the first
+      // half update of the next.
+      for (k = 0; k < nInner_; ++k) {
+         factor = (k == 0) ? 1.0 : 2.0;
+         for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+            system().begin(iSpecies, molIter);
+            for ( ; molIter.notEnd(); ++molIter) {
+               for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+                  typeId = atomIter->typeId();
+                  dv.multiply(atomIter->force(),
+                              factor*innerPrefactors_[typeId]);
+                  atomIter->velocity() += dv;
+                  dr.multiply(atomIter->velocity(), h);
+                  atomIter->position() += dr;
+               }
+            }
+         }
+         system().setZeroForces();
+         system().addFastForces();
+      }
+
+      // Last inner half step velocity update, and store fast forces
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               dv.multiply(atomIter->force(),
+                           innerPrefactors_[atomIter->typeId()]);
+               atomIter->velocity() += dv;
+               slowForces_[atomIter->id()] = atomIter->force();
+            }
+         }
+      }
+
+      // Add slow forces to fast forces, then extract slow forces
+      system().addSlowForces();
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               id = atomIter->id();
+               slowForces_[id].subtract(atomIter->force(), slowForces_[id]);
+            }
+         }
+      }
+      addThermostatForces();
+
+      // Final half step velocity update with slow forces
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               dv.multiply(slowForces_[atomIter->id()],
+                           prefactors_[atomIter->typeId()]);
+               atomIter->velocity() += dv;
+            }
+         }
+      }
+
+      #ifndef INTER_NOPAIR
+      if (!system().pairPotential().isPairListCurrent()) {
+         system().pairPotential().buildPairList();
+      }
+      #endif
+
+   }
+
+}
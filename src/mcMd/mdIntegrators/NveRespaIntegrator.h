@@ -0,0 +1,146 @@
+#ifndef MCMD_NVE_RESPA_INTEGRATOR_H
+#define MCMD_NVE_RESPA_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mdIntegrators/MdIntegrator.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+
+#include <iostream>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * An NVE multiple time step (r-RESPA) molecular dynamics integrator.
+   *
+   * Forces are split into slowly varying forces, which are computed by
+   * MdSystem::addSlowForces() (pair and coulomb), and rapidly varying
+   * forces, which are computed by MdSystem::addFastForces() (bond,
+   * angle, dihedral, link, external and tether). Each step of length
+   * dt applies a half step velocity update using the slow forces,
+   * nInner velocity-Verlet steps of length dt/nInner using only the
+   * fast forces, and a final half step velocity update using slow
+   * forces evaluated at the new positions. Pair forces are thus
+   * computed once per step, while the time step of the inner loop
+   * resolves stiff covalent bonds.
+   *
+   * On entry to step(), atomic forces must be the total forces, as
+   * computed by MdSystem::calculateForces(). On exit, they are the
+   * total forces at the new positions. The slow forces are recovered
+   * at the beginning of each step by subtracting the fast forces, so
+   * the integrator has no state that must be preserved between steps.
+   * This costs one extra fast force evaluation per step, i.e., nInner+1
+   * fast and one slow force evaluation per step. This is normally small
+   * compared to the cost of pair forces.
+   *
+   * \sa \ref mcMd_integrator_NveRespaIntegrator_page "param file format"
+   *
+   * \ingroup McMd_MdIntegrator_Module
+   */
+   class NveRespaIntegrator : public MdIntegrator
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param system parent MdSystem
+      */
+      NveRespaIntegrator(MdSystem& system);
+
+      /**
+      * Destructor.
+      */
+      virtual ~NveRespaIntegrator();
+
+      /**
+      * Read parameters dt and nInner.
+      *
+      * \param in input file stream.
+      */
+      virtual void readParameters(std::istream &in);
+
+      /**
+      * Load the internal state from an archive.
+      *
+      * \param ar archive object.
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save the internal state to an archive.
+      *
+      * \param ar archive object.
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /**
+      * Setup private variables before main loop.
+      */
+      virtual void setup();
+
+      /**
+      * Take a complete outer integration step.
+      */
+      virtual void step();
+
+      /**
+      * Get number of inner (fast force) steps per outer step.
+      */
+      int nInner() const;
+
+   protected:
+
+      /**
+      * Add thermostat forces to atomic forces and slow forces.
+      *
+      * Called once per step, after the slow forces have been computed
+      * at the new positions and before the final slow velocity update.
+      * Thermostat forces added to slowForces_ are applied in this final
+      * half step and in the first half step of the next step. The
+      * default implementation does nothing.
+      */
+      virtual void addThermostatForces()
+      {}
+
+      /// Slow forces, indexed by Atom::id().
+      DArray<Vector> slowForces_;
+
+      /// Number of inner steps per outer step.
+      int nInner_;
+
+   private:
+
+      /// Factors of 0.5*dt/mass for different atom types (slow forces).
+      DArray<double> prefactors_;
+
+      /// Factors of 0.5*dt/(nInner*mass) for atom types (fast forces).
+      DArray<double> innerPrefactors_;
+
+      /*
+      * Allocate arrays.
+      */
+      void allocate();
+
+   };
+
+   // Inline method
+
+   /*
+   * Get number of inner steps per outer step.
+   */
+   inline int NveRespaIntegrator::nInner() const
+   {  return nInner_; }
+
+}
+#endif
@@ -0,0 +1,138 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "NvtLangevinRespaIntegrator.h"
+#include <mcMd/mdSimulation/MdSystem.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/ensembles/EnergyEnsemble.h>
+#include <util/random/Random.h>
+#include <util/archives/Serializable_includes.h>
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   NvtLangevinRespaIntegrator::NvtLangevinRespaIntegrator(MdSystem& system)
+   : NveRespaIntegrator(system),
+     cv_(),
+     cr_(),
+     gamma_(0.0)
+   {  setClassName("NvtLangevinRespaIntegrator"); }
+
+   /*
+   * Destructor.
+   */
+   NvtLangevinRespaIntegrator::~NvtLangevinRespaIntegrator()
+   {}
+
+   /*
+   * Read parameters.
+   */
+   void NvtLangevinRespaIntegrator::readParameters(std::istream &in)
+   {
+      NveRespaIntegrator::readParameters(in);
+      read<double>(in, "gamma", gamma_);
+      int nAtomType = simulation().nAtomType();
+      cv_.allocate(nAtomType);
+      cr_.allocate(nAtomType);
+   }
+
+   /*
+   * Load the internal state from an archive.
+   */
+   void
+   NvtLangevinRespaIntegrator::loadParameters(Serializable::IArchive& ar)
+   {
+      NveRespaIntegrator::loadParameters(ar);
+      loadParameter<double>(ar, "gamma", gamma_);
+      int nAtomType = simulation().nAtomType();
+      cv_.allocate(nAtomType);
+      cr_.allocate(nAtomType);
+      ar & cv_;
+      ar & cr_;
+   }
+
+   /*
+   * Save the internal state to an archive.
+   */
+   void NvtLangevinRespaIntegrator::save(Serializable::OArchive& ar)
+   {
+      NveRespaIntegrator::save(ar);
+      ar & gamma_;
+      ar & cv_;
+      ar & cr_;
+   }
+
+   /*
+   * Initialize constants.
+   */
+   void NvtLangevinRespaIntegrator::setup()
+   {
+      NveRespaIntegrator::setup();
+      setConstants();
+   }
+
+   /*
+   * Compute Langevin constants (private).
+   */
+   void NvtLangevinRespaIntegrator::setConstants()
+   {
+      const EnergyEnsemble& energyEnsemble = system().energyEnsemble();
+      if (!energyEnsemble.isIsothermal()) {
+         UTIL_THROW("Energy ensemble is not isothermal");
+      }
+      int nAtomType = cv_.capacity();
+      double cv = (exp(-dt_*gamma_) - 1.0)/dt_;
+      double temp = energyEnsemble.temperature();
+      double d = 2.0/(1.0 + exp(-dt_*gamma_));
+      double cr = 12.0*temp*d*(1.0 - exp(-2.0*dt_*gamma_))/(dt_*dt_);
+      double mass;
+      for (int i = 0; i < nAtomType; ++i) {
+         mass = simulation().atomType(i).mass();
+         cv_[i] = mass*cv;
+         cr_[i] = sqrt(mass*cr);
+      }
+   }
+
+   /*
+   * Add Langevin drag and random forces to slow and total forces.
+   */
+   void NvtLangevinRespaIntegrator::addThermostatForces()
+   {
+      Vector df;
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      Random& random = simulation().random();
+      double cr;
+      int iSpecies, nSpecies, typeId, j;
+
+      nSpecies = simulation().nSpecies();
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               typeId = atomIter->typeId();
+               df.multiply(atomIter->velocity(), cv_[typeId]);
+               cr = cr_[typeId];
+               for (j=0; j < Dimension; ++j) {
+                  df[j] += (random.uniform() - 0.5)*cr;
+               }
+               atomIter->force() += df;
+               slowForces_[atomIter->id()] += df;
+            }
+         }
+      }
+   }
+
+}
@@ -0,0 +1,102 @@
+#ifndef MCMD_NVT_LANGEVIN_RESPA_INTEGRATOR_H
+#define MCMD_NVT_LANGEVIN_RESPA_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mdIntegrators/NveRespaIntegrator.h>
+
+#include <iostream>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * A multiple time step (r-RESPA) integrator with a Langevin thermostat.
+   *
+   * This class uses the force splitting of NveRespaIntegrator. The
+   * Langevin drag and random forces of NvtLangevinIntegrator, with
+   * constants computed for the outer time step dt, are added to the
+   * slow forces once per outer step.
+   *
+   * \sa \ref mcMd_integrator_NvtLangevinRespaIntegrator_page "parameter file format"
+   * \sa \ref algorithms_Langevin_page "algorithm"
+   *
+   * \ingroup McMd_MdIntegrator_Module
+   */
+   class NvtLangevinRespaIntegrator : public NveRespaIntegrator
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param system parent MdSystem
+      */
+      NvtLangevinRespaIntegrator(MdSystem& system);
+
+      /**
+      * Destructor.
+      */
+      virtual ~NvtLangevinRespaIntegrator();
+
+      /**
+      * Read parameters dt, nInner and gamma.
+      *
+      * \param in input file stream.
+      */
+      virtual void readParameters(std::istream &in);
+
+      /**
+      * Load the internal state from an archive.
+      *
+      * \param ar archive object.
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save the internal state to an archive.
+      *
+      * \param ar archive object.
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /**
+      * Setup private variables before main loop.
+      */
+      virtual void setup();
+
+   protected:
+
+      /**
+      * Add Langevin drag and random forces.
+      */
+      virtual void addThermostatForces();
+
+   private:
+
+      /// Constant for friction force.
+      DArray<double> cv_;
+
+      /// Constant for random force.
+      DArray<double> cr_;
+
+      /// Velocity autocorrelation decay rate.
+      double gamma_;
+
+      /*
+      * Compute drag and random force constants.
+      */
+      void setConstants();
+
+   };
+
+}
+#endif
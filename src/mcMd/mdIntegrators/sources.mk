@@ -3,6 +3,8 @@ mcMd_mdIntegrators_=\
     mcMd/mdIntegrators/MdIntegratorFactory.cpp \
     mcMd/mdIntegrators/NveVvIntegrator.cpp \
     mcMd/mdIntegrators/NvtLangevinIntegrator.cpp \
+    mcMd/mdIntegrators/NveRespaIntegrator.cpp \
+    mcMd/mdIntegrators/NvtLangevinRespaIntegrator.cpp \
     mcMd/mdIntegrators/NvtDpdVvIntegrator.cpp \
     mcMd/mdIntegrators/NvtNhIntegrator.cpp \
     mcMd/mdIntegrators/NphIntegrator.cpp
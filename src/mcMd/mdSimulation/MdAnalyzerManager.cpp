@@ -18,7 +18,7 @@ namespace McMd
    MdAnalyzerManager::MdAnalyzerManager(MdSimulation& simulation)
     : simulationPtr_(&simulation),
       systemPtr_(&simulation.system())
-   {}
+   {  setSystem(*systemPtr_); }
    //{setClassName("MdAnalyzerManager"); }
 
    // Constructor.
@@ -26,7 +26,7 @@ namespace McMd
 		                            MdSystem& system)
     : simulationPtr_(&simulation),
       systemPtr_(&system)
-   {}
+   {  setSystem(system); }
 
    // Destructor.
    MdAnalyzerManager::~MdAnalyzerManager()
@@ -49,6 +49,7 @@ namespace McMd
       mdAnalyzerManagerPtr_(0),
       saveFileName_(),
       saveInterval_(0),
+      restartWriter_(),
       isInitialized_(false),
       isRestarting_(false)
    {
@@ -71,6 +72,7 @@ namespace McMd
       mdAnalyzerManagerPtr_(0),
       saveFileName_(),
       saveInterval_(0),
+      restartWriter_(),
       isInitialized_(false),
       isRestarting_(false)
    {
@@ -356,6 +358,7 @@ namespace McMd
 
             if (command == "FINISH") {
                Log::file() << std::endl;
+               restartWriter_.wait();
                readNext = false;
             } else 
             if (command == "READ_CONFIG") {
@@ -601,6 +604,7 @@ namespace McMd
             save(saveFileName_);
          }
       }
+      restartWriter_.wait();
 
       // Final analyzer output
       analyzerManager().output();
@@ -802,11 +806,10 @@ namespace McMd
    */
    void MdSimulation::save(const std::string& filename)
    {
-      Serializable::OArchive ar;
-      std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
-      fileMaster().openRestartOFile(filename, ar.file(), mode);
+      // Serialize to memory, write to file in the background
+      Serializable::OArchive ar(restartWriter_.stream());
       save(ar);
-      ar.file().close();
+      restartWriter_.write(fileMaster().restartFileName(filename));
    }
 
    /* 
@@ -10,6 +10,7 @@
 
 #include "MdSystem.h"
 #include <mcMd/simulation/Simulation.h>
+#include <util/misc/AsyncFileWriter.h>
 
 namespace McMd
 {
@@ -187,6 +188,10 @@ namespace McMd
       /**
       * Write a restart file.
       *
+      * The state is serialized to a memory buffer, which is written to
+      * disk by an AsyncFileWriter. The file is written in background if
+      * UTIL_CXX11 is defined, and is replaced atomically in either case.
+      *
       * \param filename base file name for all restart files.
       */
       void save(const std::string& filename);
@@ -220,6 +225,9 @@ namespace McMd
       /// Interval for writing restart files (no output if 0)
       int saveInterval_;
 
+      /// Double-buffered writer for restart files.
+      AsyncFileWriter restartWriter_;
+
       /// Has readParam been called?
       bool isInitialized_;
 
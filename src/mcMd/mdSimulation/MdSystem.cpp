@@ -35,6 +35,9 @@
 #ifdef INTER_EXTERNAL
 #include <mcMd/potentials/external/ExternalPotential.h>
 #endif
+#ifdef INTER_COULOMB
+#include <mcMd/potentials/coulomb/CoulombPotential.h>
+#endif
 #ifdef INTER_TETHER
 #include <mcMd/potentials/tether/TetherPotential.h>
 #include <mcMd/tethers/TetherMaster.h>
@@ -78,6 +81,9 @@ namespace McMd
       #ifdef INTER_EXTERNAL
       externalPotentialPtr_(0),
       #endif
+      #ifdef INTER_COULOMB
+      coulombPotentialPtr_(0),
+      #endif
       #ifdef INTER_TETHER
       tetherPotentialPtr_(0),
       #endif
@@ -109,6 +115,9 @@ namespace McMd
       #ifdef INTER_EXTERNAL
       externalPotentialPtr_(0),
       #endif
+      #ifdef INTER_COULOMB
+      coulombPotentialPtr_(0),
+      #endif
       #ifdef INTER_TETHER
       tetherPotentialPtr_(0),
       #endif
@@ -179,6 +188,9 @@ namespace McMd
       #ifdef INTER_EXTERNAL
       if (!isCopy() && externalPotentialPtr_) delete externalPotentialPtr_;
       #endif
+      #ifdef INTER_COULOMB
+      if (!isCopy() && coulombPotentialPtr_) delete coulombPotentialPtr_;
+      #endif
       #ifdef INTER_TETHER
       if (!isCopy() && tetherPotentialPtr_) delete tetherPotentialPtr_;
       #endif
@@ -219,6 +231,21 @@ namespace McMd
          readPotentialStyles(in);
       }
 
+      #ifdef INTER_COULOMB
+      // Coulomb potential (must precede the pair potential)
+      if (!isCopy()) {
+         assert(coulombPotentialPtr_ == 0);
+         if (simulation().hasCoulomb() > 0) {
+            coulombPotentialPtr_ =
+                       coulombFactory().factory(coulombStyle());
+            if (coulombPotentialPtr_ == 0) {
+               UTIL_THROW("Failed attempt to create coulombPotential");
+            }
+            readParamComposite(in, *coulombPotentialPtr_);
+         }
+      }
+      #endif
+
       #ifndef INTER_NOPAIR
       if (!isCopy()) {
          assert(pairPotentialPtr_ == 0);
@@ -343,6 +370,21 @@ namespace McMd
          loadPotentialStyles(ar);
       }
 
+      #ifdef INTER_COULOMB
+      // Coulomb potential (must precede the pair potential)
+      if (!isCopy()) {
+         assert(coulombPotentialPtr_ == 0);
+         if (simulation().hasCoulomb() > 0) {
+            coulombPotentialPtr_ =
+                       coulombFactory().factory(coulombStyle());
+            if (coulombPotentialPtr_ == 0) {
+               UTIL_THROW("Failed attempt to create coulombPotential");
+            }
+            loadParamComposite(ar, *coulombPotentialPtr_);
+         }
+      }
+      #endif
+
       #ifndef INTER_NOPAIR
       if (!isCopy()) {
          assert(pairPotentialPtr_ == 0);
@@ -465,6 +507,11 @@ namespace McMd
          saveFileMaster(ar);
          savePotentialStyles(ar);
       }
+      #ifdef INTER_COULOMB
+      if (!isCopy() && simulation().hasCoulomb() > 0) {
+         coulombPotentialPtr_->save(ar);
+      }
+      #endif
       #ifndef INTER_NOPAIR
       pairPotentialPtr_->save(ar);
       #endif
@@ -659,11 +706,32 @@ namespace McMd
    void MdSystem::calculateForces()
    {
       setZeroForces();
+      addSlowForces();
+      addFastForces();
+   }
+
+   /*
+   * Add slowly varying (pair and coulomb) forces.
+   */
+   void MdSystem::addSlowForces()
+   {
       #ifndef INTER_NOPAIR
       // This method builds pair list if needed, and shifts atoms if
       // it builds the pair list.
       pairPotential().addForces();
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulombPotential()) {
+         coulombPotential().addForces();
+      }
+      #endif
+   }
+
+   /*
+   * Add rapidly varying (covalent, external and tether) forces.
+   */
+   void MdSystem::addFastForces()
+   {
       #ifdef INTER_BOND
       if (hasBondPotential()) {
          bondPotential().addForces();
@@ -730,6 +798,11 @@ namespace McMd
          energy += externalPotential().energy();
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (hasCoulombPotential()) {
+         energy += coulombPotential().energy();
+      }
+      #endif
       #ifdef INTER_TETHER
       if (tetherPotentialPtr_) {
          energy += tetherPotential().energy();
@@ -848,6 +921,14 @@ namespace McMd
       }
       #endif
 
+      #ifdef INTER_COULOMB
+      if (hasCoulombPotential()) {
+         T coulombStress;
+         coulombPotential().computeStress(coulombStress);
+         stress += coulombStress;
+      }
+      #endif
+
    }
 
    template <>
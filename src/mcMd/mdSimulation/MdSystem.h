@@ -38,6 +38,9 @@ namespace McMd
    #ifdef INTER_EXTERNAL
    class ExternalPotential;
    #endif
+   #ifdef INTER_COULOMB
+   class CoulombPotential;
+   #endif
    #ifdef INTER_TETHER
    class TetherPotential;
    #endif
@@ -141,6 +144,23 @@ namespace McMd
       */
       void calculateForces();
 
+      /**
+      * Add slowly varying forces to all atomic forces.
+      *
+      * Adds pair and coulomb forces, without first zeroing forces.
+      * The pair list is updated if necessary, as in calculateForces().
+      * Used by multiple time step integrators, with addFastForces().
+      */
+      void addSlowForces();
+
+      /**
+      * Add rapidly varying forces to all atomic forces.
+      *
+      * Adds bond, angle, dihedral, link, external and tether forces,
+      * without first zeroing forces.
+      */
+      void addFastForces();
+
       /**
       * Compute and return total kinetic energy.
       */
@@ -264,6 +284,18 @@ namespace McMd
       ExternalPotential& externalPotential() const;
       #endif
 
+      #ifdef INTER_COULOMB
+      /**
+      * Does a Coulomb potential exist?.
+      */
+      bool hasCoulombPotential() const;
+
+      /**
+      * Return CoulombPotential by reference.
+      */
+      CoulombPotential& coulombPotential() const;
+      #endif
+
       #ifdef INTER_TETHER
       /**
       * Return TetherPotential by reference.
@@ -369,6 +401,11 @@ namespace McMd
       ExternalPotential* externalPotentialPtr_;
       #endif
 
+      #ifdef INTER_COULOMB
+      /// Pointer to a CoulombPotential (k-space part). 
+      CoulombPotential* coulombPotentialPtr_;
+      #endif
+
       #ifdef INTER_TETHER
       /// Pointer to an TetherPotential. 
       TetherPotential* tetherPotentialPtr_;
@@ -509,6 +546,25 @@ namespace McMd
    }
    #endif
 
+   #ifdef INTER_COULOMB
+   /*
+   * Does a Coulomb potential exist?
+   */
+   inline bool MdSystem::hasCoulombPotential() const
+   {
+      return bool(coulombPotentialPtr_); 
+   }
+
+   /*
+   * Return Coulomb potential by reference.
+   */
+   inline CoulombPotential& MdSystem::coulombPotential() const
+   {  
+      assert(coulombPotentialPtr_);  
+      return *coulombPotentialPtr_; 
+   }
+   #endif
+
    #ifdef INTER_TETHER
    /*
    * Return tether potential by reference.
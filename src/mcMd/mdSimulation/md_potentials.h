@@ -27,6 +27,9 @@
 #ifdef INTER_EXTERNAL
 #include <mcMd/potentials/external/ExternalPotential.h>
 #endif
+#ifdef INTER_COULOMB
+#include <mcMd/potentials/coulomb/CoulombPotential.h>
+#endif
 #ifdef INTER_TETHER
 #include <mcMd/potentials/tether/MdTetherPotential.h>
 #endif
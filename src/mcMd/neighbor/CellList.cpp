@@ -30,6 +30,8 @@ namespace McMd
       YZCells_ = 0;
       totCells_ = 0;
       atomCapacity_ = 0;
+      cellCapacity_ = 0;
+      nRebuild_ = 0;
    }
 
    /*
@@ -39,17 +41,20 @@ namespace McMd
    {}
 
    /*
-   * Resets all Cell and CellTag objects to empty state.
+   * Resets all cells and CellTag objects to empty state.
    */
    void CellList::clear()
    {
       int i;
 
-      // Clear all Cell objects
-      if (cells_.capacity() > 0) {
-         for (i=0; i < cells_.capacity(); ++i) {
-            cells_[i].clear();
+      // Divide the atom array evenly among cells of the current grid
+      if (cellBegins_.capacity() > 0) {
+         int width = atomPtrs_.capacity()/totCells_;
+         for (i = 0; i < totCells_; ++i) {
+            cellBegins_[i] = i*width;
+            nAtomCells_[i] = 0;
          }
+         cellBegins_[totCells_] = totCells_*width;
       }
 
       // Clear all CellTag objects
@@ -89,7 +94,7 @@ namespace McMd
    }
 
    /*
-   * Allocate cells_ and cellTags_ arrays.
+   * Allocate cell and atom arrays, and cellTags_.
    */
    void 
    CellList::allocate(int atomCapacity, const Boundary &boundary, double cutoff)
@@ -99,17 +104,71 @@ namespace McMd
       if (atomCapacity <= 0) UTIL_THROW("atomCapacity must be > 0");
       if (cutoff       <= 0) UTIL_THROW("cutoff must be > 0");
 
-      // Allocate an array of CellTag objects, indexed by atom Ids.
+      // Allocate arrays for the maximum number of cells
       atomCapacity_ = atomCapacity;
-      cellTags_.allocate(atomCapacity_);
-      
-      // Allocate an Array of Cell objects
       makeGrid(boundary, cutoff);
-      cells_.allocate(totCells_);
+      cellCapacity_ = totCells_;
+      allocateArrays();
       clear();
       
    }
 
+   /*
+   * Allocate arrays, given atomCapacity_ and cellCapacity_ (private).
+   *
+   * After rebuild(), cell ic with n atoms has n + MinSlack + n/4 slots, 
+   * so the atom array needs at most atomCapacity_ + atomCapacity_/4 
+   * + MinSlack*cellCapacity_ elements.
+   */
+   void CellList::allocateArrays()
+   {
+      int capacity = atomCapacity_ + atomCapacity_/4 
+                   + MinSlack*cellCapacity_;
+      cellTags_.allocate(atomCapacity_);
+      atomPtrs_.allocate(capacity);
+      buffer_.allocate(capacity);
+      cellBegins_.allocate(cellCapacity_ + 1);
+      nAtomCells_.allocate(cellCapacity_);
+      for (int i = 0; i < capacity; ++i) {
+         atomPtrs_[i] = 0;
+      }
+   }
+
+   /*
+   * Rebuild the atom array by a counting sort (private).
+   *
+   * Atoms remain in the same order within each cell, so cellTags_
+   * are unchanged.
+   */
+   void CellList::rebuild()
+   {
+      int ic, j, n, oldBegin;
+      int begin = 0;
+
+      // Copy atoms of each cell to its new segment of buffer_
+      for (ic = 0; ic < totCells_; ++ic) {
+         n = nAtomCells_[ic];
+         oldBegin = cellBegins_[ic];
+         for (j = 0; j < n; ++j) {
+            buffer_[begin + j] = atomPtrs_[oldBegin + j];
+         }
+         cellBegins_[ic] = begin;
+         begin += n + MinSlack + n/4;
+      }
+      cellBegins_[totCells_] = begin;
+      assert(begin <= atomPtrs_.capacity());
+
+      // Copy back to atomPtrs_
+      for (ic = 0; ic < totCells_; ++ic) {
+         begin = cellBegins_[ic];
+         n = nAtomCells_[ic];
+         for (j = 0; j < n; ++j) {
+            atomPtrs_[begin + j] = buffer_[begin + j];
+         }
+      }
+      ++nRebuild_;
+   }
+
    /*
    * Create a grid of cells.
    */
@@ -126,12 +185,12 @@ namespace McMd
       if (totCells_ < 1) {
          UTIL_THROW("totCells_ must be > 1");
       }
-      if (cells_.capacity() > 0 && totCells_ > cells_.capacity()) {
+      if (cellCapacity_ > 0 && totCells_ > cellCapacity_) {
          UTIL_THROW("Insufficient cell capacity for this grid");
       }
 
       /*
-      * Note: No Exception is thrown if cells_.capacity() == 0 in order 
+      * Note: No Exception is thrown if cellCapacity_ == 0 in order 
       * to allow makeGrid to be used to determine the number of cells 
       * to be allocated for a maximum boundary during initialization.
       */
@@ -146,30 +205,17 @@ namespace McMd
    CellList::getCellNeighbors(int ic, NeighborArray &neighbors, int &nInCell)
    const
    {
-      const Cell *cellPtr;
-      Atom *atomPtr;
       int   icx, icy, icz;
       int   jc, jcx, jcy, jcz;
-      int   dcx, dcy, dcz, jp;
+      int   dcx, dcy, dcz;
 
       // Determine cell coordinates icx, icy, icz
       cellCoordFromIndex(ic, icx, icy, icz);
 
-      // Zero total number of neighbor atoms and number in cell
-      //nNeighbor = 0;
-      nInCell   = 0;
+      // Add atoms in cell ic. By convention, these appear first in the list.
       neighbors.clear();
-
-      // Loop over atoms in cell ic.
-      // By convention, these appear first in the list.
-      cellPtr = &(cells_[ic]);
-      for (jp=0; jp < cellPtr->firstClearPos(); ++jp) {
-         atomPtr = cellPtr->atomPtr(jp);
-         if (atomPtr != 0) {
-            neighbors.append(atomPtr);
-            ++nInCell;
-         }
-      }
+      appendCell(ic, neighbors);
+      nInCell = nAtomCells_[ic];
 
       // Loop over neighboring cells (excluding cell ic)
 
@@ -185,21 +231,13 @@ namespace McMd
             for (dcz = minDel_[2]; dcz <= maxDel_[2]; ++dcz) {
                jcz = shiftCellCoordAxis(2, icz + dcz);
 
-               // Get cell index jc and Cell pointer cellPtr
+               // Get cell index jc
                jc = cellIndexFromCoord(jcx, jcy, jcz);
 
+               // Add atoms in neighboring cell jc
                if (jc != ic) {
-
-                  // Loop over atoms in neighboring cell jc
-                  cellPtr = &cells_[jc];
-                  for (jp=0; jp < cellPtr->firstClearPos(); ++jp) {
-                     atomPtr  = cellPtr->atomPtr(jp);
-                     if (atomPtr != 0) {
-                        neighbors.append(atomPtr);
-                     }
-                  }
-
-               } // end if (jc != ic)
+                  appendCell(jc, neighbors);
+               }
 
             } // end for dcz
 
@@ -209,6 +247,45 @@ namespace McMd
 
    } 
 
+   /*
+   * Fill an array with atoms in cell ic and neighboring cells jc > ic.
+   *
+   * Every neighboring cell appears exactly once in the loops over
+   * dcx, dcy, dcz, because minDel_ and maxDel_ exclude duplicates for 
+   * grids with fewer than 3 cells along an axis. Because the neighbor 
+   * relation is symmetric, each pair of neighboring cells is then
+   * visited once, from the cell with the lower index.
+   */
+   void 
+   CellList::getHalfCellNeighbors(int ic, NeighborArray &neighbors, 
+                                  int &nInCell) const
+   {
+      int   icx, icy, icz;
+      int   jc, jcx, jcy, jcz;
+      int   dcx, dcy, dcz;
+
+      cellCoordFromIndex(ic, icx, icy, icz);
+
+      neighbors.clear();
+      appendCell(ic, neighbors);
+      nInCell = nAtomCells_[ic];
+
+      for (dcx = minDel_[0]; dcx <= maxDel_[0]; ++dcx) {
+         jcx = shiftCellCoordAxis(0, icx + dcx);
+         for (dcy = minDel_[1]; dcy <= maxDel_[1]; ++dcy) {
+            jcy = shiftCellCoordAxis(1, icy + dcy);
+            for (dcz = minDel_[2]; dcz <= maxDel_[2]; ++dcz) {
+               jcz = shiftCellCoordAxis(2, icz + dcz);
+               jc = cellIndexFromCoord(jcx, jcy, jcz);
+               if (jc > ic) {
+                  appendCell(jc, neighbors);
+               }
+            }
+         }
+      }
+
+   } 
+
    /*
    * Get total number of atoms in this CellList.
    */
@@ -216,7 +293,7 @@ namespace McMd
    {
       int nAtomSum = 0;
       for (int icell = 0; icell < totCells_; ++icell) {
-         nAtomSum += cells_[icell].nAtomCell();
+         nAtomSum += nAtomCells_[icell];
       }
       return nAtomSum;
    }
@@ -224,17 +301,40 @@ namespace McMd
    /*
    * Check validity of CellList, throw an Exception if an error is found.
    *
-   * This method checks consistency of the CellList and Atom data structures.
-   * Calls Cell::isValid internally for each cell. 
+   * This method checks consistency of the cell offsets, atom pointers
+   * and CellTag objects.
    */
    bool CellList::isValid(int nAtom) const
    {
-
-      // Call Cell::isValid for each Cell. Let any Exceptions bubble up.
+      Atom* atomPtr;
       int nAtomSum = 0;
-      for (int icell = 0; icell < totCells_; ++icell) {
-         cells_[icell].isValid(cellTags_, nAtom, icell);
-         nAtomSum += cells_[icell].nAtomCell();
+      int icell, j, atomId;
+
+      if (cellBegins_[0] < 0) {
+         UTIL_THROW("Negative cellBegins_[0]");
+      }
+      for (icell = 0; icell < totCells_; ++icell) {
+         if (cellBegins_[icell] + nAtomCells_[icell] 
+             > cellBegins_[icell + 1]) {
+            UTIL_THROW("Atoms in cell overflow its segment");
+         }
+         for (j = 0; j < nAtomCells_[icell]; ++j) {
+            atomPtr = atomPtrs_[cellBegins_[icell] + j];
+            if (atomPtr == 0) {
+               UTIL_THROW("Null atom pointer in cell");
+            }
+            atomId = atomPtr->id();
+            if (cellTags_[atomId].cellId != icell) {
+               UTIL_THROW("Value in CellTag.cellId inconsistent with icell");
+            }
+            if (cellTags_[atomId].cellPos != j) {
+               UTIL_THROW("Value in CellTag.cellPos inconsistent with cell");
+            }
+         }
+         nAtomSum += nAtomCells_[icell];
+      }
+      if (cellBegins_[totCells_] > atomPtrs_.capacity()) {
+         UTIL_THROW("Cell segments exceed capacity of atom array");
       }
 
       // Check that total number of atoms in all cells equals nAtom.
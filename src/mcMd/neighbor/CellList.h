@@ -8,13 +8,12 @@
 * Distributed under the terms of the GNU General Public License.
 */
 
-#include "Cell.h"
 #include "CellTag.h"
 #include <mcMd/chemistry/Atom.h>
 #include <util/boundary/Boundary.h>
 #include <util/space/IntVector.h>
 #include <util/containers/DArray.h>
-#include <util/containers/FSArray.h>
+#include <util/containers/GArray.h>
 #include <util/global.h>
 
 #include <sstream>
@@ -37,15 +36,15 @@ namespace McMd
    * cutoff distance of any point within a system, as required to 
    * calculate nonbonded energies and forces.
    *
-   * In this implementation, each cell is represented by a Cell
-   * object. Each cell contains an small array of pointers to all
-   * all atoms in the associated volume. This implementation is
-   * designed to allow fast addition and removal of individual 
-   * atoms. This implementation also wastes some memory, compared
-   * to a linked list implementation, because the dimension
-   * Cell::MaxAtomCell of the array of pointers in each Cell must
-   * be large enough to accomodate the maximum number of atoms 
-   * that will ever be encountered in an individual cell.
+   * In this implementation, pointers to all atoms are stored in a
+   * single contiguous array, in which the atoms of each cell occupy
+   * a contiguous segment (a compressed sparse row layout). The
+   * segment of each cell has some unused slack at its end, to allow
+   * fast addition and removal of individual atoms. If an atom is 
+   * added to a cell whose segment is full, all segments are rebuilt
+   * by a counting sort of the atoms by cell, in time proportional to
+   * the number of atoms plus the number of cells. There is thus no
+   * upper limit on the number of atoms in a cell.
    *
    * CellList is a non-polymorphic class, with no virtual functions, 
    * and a non-virtual destructor. Do not derive subclasses from it.
@@ -60,19 +59,19 @@ namespace McMd
       // Static members
 
       /**
-      * Maximum possible number of neighboring atoms.
-      *
-      * Use as dimension of the array neighbor passed to getNeighbors() and
-      * getCellNeighbors().
+      * Minimum number of unused slots per cell after a rebuild.
       */
-      static const int MaxNeighbor = 27*Cell::MaxAtomCell;
+      static const int MinSlack = 4;
 
       /**
-      * Static array for holding neighbors in a cell list.
+      * Array for holding neighbors in a cell list.
+      *
+      * The array grows as needed, and its memory is retained between
+      * calls, so an array that is reused is rarely reallocated.
       *
       * \ingroup McMd_Neighbor_Module
       */
-      typedef FSArray<Atom*, MaxNeighbor> NeighborArray;
+      typedef GArray<Atom*> NeighborArray;
 
       // Public member functions
 
@@ -83,8 +82,6 @@ namespace McMd
 
       /**
       * Destructor.
-      *
-      * Deallocates array of Cell objects, if necessary.
       */
       virtual ~CellList();
 
@@ -94,9 +91,10 @@ namespace McMd
       * This function:
       *
       *   - Allocates an array of atomCapacity CellTag objects.
-      *   - Allocates an array of Cell objects sized for this boundary.
+      *   - Allocates arrays of cell offsets sized for this boundary.
+      *   - Allocates the array of atom pointers, with room for slack.
       *
-      * The capacity of the array of Cells is chosen such that the dimension
+      * The number of cells is chosen such that the dimension
       * each cell within the specified Boundary is greater than or equal to the 
       * parameter "cutoff". The cutoff parameter must be greater than or equal 
       * to the maximum range of the nonbonded pair potential. The Boundary object 
@@ -138,7 +136,10 @@ namespace McMd
       void makeGrid (const Boundary &boundary, double cutoff);
 
       /**
-      * Sets all Cell objects to empty state (no Atoms).
+      * Sets all cells to empty state (no Atoms).
+      *
+      * The unused capacity of the atom array is divided evenly among
+      * the cells of the current grid.
       */
       void clear();
 
@@ -157,6 +158,19 @@ namespace McMd
       */
       void addAtom(Atom &atom);
 
+      /**
+      * Add a Atom to the cell that contains a specified position.
+      *
+      * The position should be equivalent to atom.position() under
+      * periodic boundary conditions, but must lie within the primary
+      * cell. This allows atoms whose positions have not been shifted 
+      * into the primary cell to be added without modifying them.
+      *
+      * \param atom  Atom object to be added.
+      * \param position position of atom within the primary cell
+      */
+      void addAtom(Atom &atom, const Vector &position);
+
       /**
       * Delete a Atom object from its cell.
       *
@@ -168,8 +182,8 @@ namespace McMd
       * Update CellList to reflect a new atom position.
       *
       * If a new atom position pos lies in a new cell, with a cell index
-      * icell != atom.cellId, then delete the atom from the old Cell
-      * object and add it to the new one. If the new cell is the same as the
+      * icell != atom.cellId, then delete the atom from the old cell
+      * and add it to the new one. If the new cell is the same as the
       * old one (icell == atom.CellId), do nothing and return.
       *
       * This function updates the CellList, but does not update the coordinates
@@ -186,8 +200,7 @@ namespace McMd
       *
       * Upon return, array neighbors contains pointers to all Atom objects 
       * in the cell containing the position pos, and in all neighboring cells.
-      * The number of such Atoms is given by the size() of this FSArray < Atom* >
-      * array.
+      * The number of such Atoms is given by neighbors.size().
       *
       * \param pos        position Vector, pos = {x, y, z}
       * \param neighbors  array of pointers to neighbor Atoms.
@@ -200,7 +213,7 @@ namespace McMd
       *
       * Upon return, the NeighborArray neighbors contains pointers to all of
       * the atoms in cell number ic and all neighboring cells.  The number 
-      * of such Atoms is given by the size() of this FSArray < Atom* > array.
+      * of such Atoms is given by neighbors.size().
       * Also, upon return, nInCell is the number of Atoms in cell ic. 
       * Pointers to the atoms in cell ic are listed in the elements
       * neighbors[0], ... , neighbors[nInCell-1] of the neighbors array, 
@@ -208,12 +221,29 @@ namespace McMd
       * ... , neighbors[neighbors.size()-1].
       *
       * \param ic        cell index
-      * \param neighbors FSArray containing pointers to neighbor Atoms
+      * \param neighbors array containing pointers to neighbor Atoms
       * \param nInCell   number of Atoms in cell ic.
       */
       void 
       getCellNeighbors(int ic, NeighborArray &neighbors, int &nInCell) const;
 
+      /**
+      * Fill an array with atoms in a cell and half of its neighboring cells.
+      *
+      * Identical to getCellNeighbors(), except that only neighboring 
+      * cells with a cell index greater than ic are included. A loop over 
+      * all cells ic, in which each atom neighbors[i] with i < nInCell is 
+      * paired with each atom neighbors[j] with j > i, then visits every 
+      * pair of atoms in neighboring cells exactly once.
+      *
+      * \param ic        cell index
+      * \param neighbors array containing pointers to neighbor Atoms
+      * \param nInCell   number of Atoms in cell ic.
+      */
+      void 
+      getHalfCellNeighbors(int ic, NeighborArray &neighbors, int &nInCell) 
+      const;
+
       /**
       * Number of cells along axis i.
       *
@@ -231,6 +261,20 @@ namespace McMd
       */
       int nAtom() const;
 
+      /**
+      * Get number of atoms in cell ic.
+      *
+      * \param ic cell index
+      */
+      int nAtomCell(int ic) const;
+
+      /**
+      * Get the number of times the atom array has been rebuilt.
+      *
+      * This counts rebuilds triggered by overflow of a cell segment.
+      */
+      int nRebuild() const;
+
       /**
       * Has memory been allocated for this CellList?
       */
@@ -249,8 +293,17 @@ namespace McMd
 
    private:
 
-      /// Array of Cell objects
-      DArray<Cell>    cells_;
+      /// Pointers to atoms, stored contiguously by cell.
+      DArray<Atom*>   atomPtrs_;
+
+      /// Work array used to rebuild atomPtrs_.
+      DArray<Atom*>   buffer_;
+
+      /// Index in atomPtrs_ of the first slot of each cell (totCells_ + 1).
+      DArray<int>     cellBegins_;
+
+      /// Number of atoms in each cell.
+      DArray<int>     nAtomCells_;
 
       /// Array of CellTag objects for quick retrieval
       DArray<CellTag> cellTags_;
@@ -298,6 +351,12 @@ namespace McMd
       /// Maximum atom id.
       int    atomCapacity_;        
 
+      /// Maximum number of cells (capacity of cellBegins_ - 1).
+      int    cellCapacity_;        
+
+      /// Number of rebuilds caused by overflow of a cell.
+      int    nRebuild_;        
+
       /// Pointer to associated Boundary (set in makeGrid)
       const Boundary* boundaryPtr_; 
 
@@ -338,6 +397,21 @@ namespace McMd
       */
       void cellCoordFromIndex(int i, int &cx, int &cy, int &cz) const;
 
+      /**
+      * Allocate arrays for atomCapacity_ atoms and cellCapacity_ cells.
+      */
+      void allocateArrays();
+
+      /**
+      * Append atoms in cell jc to neighbors array.
+      */
+      void appendCell(int jc, NeighborArray &neighbors) const;
+
+      /**
+      * Rebuild atomPtrs_ so every cell has at least MinSlack free slots.
+      */
+      void rebuild();
+
       /**
       * Return true if atomId is valid, i.e., if 0 <= 0 < atomCapacity.
       */
@@ -387,26 +461,49 @@ namespace McMd
    }
 
    /*
-   * Remove an Atom object from its Cell.
+   * Remove an Atom object from its cell.
+   *
+   * The last atom in the cell is moved into the vacated slot.
    */
    inline void CellList::deleteAtom(Atom &atom)
    {
       int atomId   = atom.id();
       assert(isValidAtomId(atomId));
       CellTag& cellTag = cellTags_[atomId];
-      cells_[cellTag.cellId].deleteAtom(cellTag);
+      int ic   = cellTag.cellId;
+      int last = nAtomCells_[ic] - 1;
+      assert(ic >= 0);
+      Atom*& lastPtr = atomPtrs_[cellBegins_[ic] + last];
+      atomPtrs_[cellBegins_[ic] + cellTag.cellPos] = lastPtr;
+      cellTags_[lastPtr->id()].cellPos = cellTag.cellPos;
+      lastPtr = 0;
+      nAtomCells_[ic] = last;
+      cellTag.clear();
    }
 
    /*
    * Add a Atom to the appropriate cell, based on its position.
    */
    inline void CellList::addAtom(Atom &atom)
+   {  addAtom(atom, atom.position()); }
+
+   /*
+   * Add atom to the cell containing a specified position.
+   */
+   inline void CellList::addAtom(Atom &atom, const Vector &position)
    {
-      Vector position = atom.position();
-      int    cellId   = cellIndexFromPosition(position);
-      int    atomId   = atom.id();
+      int cellId = cellIndexFromPosition(position);
+      int atomId = atom.id();
       assert(isValidAtomId(atomId));
-      cells_[cellId].addAtom(cellTags_[atomId], atom, cellId);
+      if (cellBegins_[cellId] + nAtomCells_[cellId] 
+          == cellBegins_[cellId + 1]) {
+         rebuild();
+      }
+      int pos = nAtomCells_[cellId];
+      atomPtrs_[cellBegins_[cellId] + pos] = &atom;
+      cellTags_[atomId].cellId  = cellId;
+      cellTags_[atomId].cellPos = pos;
+      nAtomCells_[cellId] = pos + 1;
    }
 
    /*
@@ -416,12 +513,19 @@ namespace McMd
    {
       int atomId = atom.id();
       assert(isValidAtomId(atomId));
-      CellTag& cellTag = cellTags_[atomId];
-      int      oldCell = cellTag.cellId;
-      int      newCell = cellIndexFromPosition(pos);
+      int oldCell = cellTags_[atomId].cellId;
+      int newCell = cellIndexFromPosition(pos);
       if (oldCell != newCell) {
-         cells_[oldCell].deleteAtom(cellTag);
-         cells_[newCell].addAtom(cellTag, atom, newCell);
+         deleteAtom(atom);
+         if (cellBegins_[newCell] + nAtomCells_[newCell] 
+             == cellBegins_[newCell + 1]) {
+            rebuild();
+         }
+         int cellPos = nAtomCells_[newCell];
+         atomPtrs_[cellBegins_[newCell] + cellPos] = &atom;
+         cellTags_[atomId].cellId  = newCell;
+         cellTags_[atomId].cellPos = cellPos;
+         nAtomCells_[newCell] = cellPos + 1;
       }
    }
 
@@ -473,7 +577,26 @@ namespace McMd
    {  return numCells_[i]; }
 
    inline bool CellList::isAllocated() const
-   {  return (cells_.capacity() > 0); }
+   {  return (cellBegins_.capacity() > 0); }
+
+   inline int CellList::nAtomCell(int ic) const
+   {  return nAtomCells_[ic]; }
+
+   inline int CellList::nRebuild() const
+   {  return nRebuild_; }
+
+   /*
+   * Append atoms in cell jc to an array (private).
+   */
+   inline 
+   void CellList::appendCell(int jc, NeighborArray &neighbors) const
+   {
+      int begin = cellBegins_[jc];
+      int end   = begin + nAtomCells_[jc];
+      for (int j = begin; j < end; ++j) {
+         neighbors.append(atomPtrs_[j]);
+      }
+   }
 
    /*
    * Serialize to/from an Archive.
@@ -492,8 +615,8 @@ namespace McMd
       ar & totCells_;   
       ar & atomCapacity_;
       if (ar.is_loading()) {
-         cells_.allocate(totCells_);
-         cellTags_.allocate(atomCapacity_);
+         cellCapacity_ = totCells_;
+         allocateArrays();
       }
       clear();
    }
@@ -15,10 +15,10 @@ namespace McMd
    * Location of the pointer to a particular Atom in a CellList.
    *
    * A CellList contains a array of CellTag objects, which are indexed by 
-   * Atom Id, and an array of Cell objects, each of which stores pointers
-   * of all Atoms in one cell. Each CellTag contains the information 
+   * Atom Id, and an array of pointers to Atoms in which the Atoms of each
+   * cell are stored contiguously. Each CellTag contains the information 
    * necessary to locate a particular Atom within the CellList, to allow
-   * fast deletion of a specified Atom from its Cell.
+   * fast deletion of a specified Atom from its cell.
    *
    * The CellTag class is used only by the CellList class.
    *
@@ -35,7 +35,7 @@ namespace McMd
       /// Cell index of Cell containing associated Atom.
       int cellId;   
 
-      /// Array index of Atom pointer in a Cell::part_ array.
+      /// Position of Atom pointer within the segment for its cell.
       int cellPos;  
    
       /// Default constructor.
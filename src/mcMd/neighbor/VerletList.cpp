@@ -0,0 +1,305 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "VerletList.h"
+#include <mcMd/chemistry/Atom.h>
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   VerletList::VerletList()
+    : cellList_(),
+      candidates_(),
+      neighborPtrs_(),
+      nNeighbors_(),
+      refPositions_(),
+      isPresent_(),
+      boundaryPtr_(0),
+      skin_(0.0),
+      cutoff_(0.0),
+      cutoffSq_(0.0),
+      halfSkinSq_(0.0),
+      neighborCapacity_(0),
+      atomCapacity_(0),
+      nFullBuild_(0),
+      nPartialBuild_(0)
+   {  setClassName("VerletList"); }
+
+   /*
+   * Destructor.
+   */
+   VerletList::~VerletList()
+   {}
+
+   /*
+   * Read parameters from file.
+   */
+   void VerletList::readParameters(std::istream& in)
+   {
+      read<double>(in, "skin", skin_);
+      read<int>(in, "neighborCapacity", neighborCapacity_);
+   }
+
+   /*
+   * Load parameters from an archive, but do not allocate.
+   */
+   void VerletList::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<double>(ar, "skin", skin_);
+      loadParameter<int>(ar, "neighborCapacity", neighborCapacity_);
+   }
+
+   /*
+   * Save parameters to an archive.
+   */
+   void VerletList::save(Serializable::OArchive &ar)
+   {
+      ar << skin_;
+      ar << neighborCapacity_;
+   }
+
+   /*
+   * Allocate arrays and internal CellList.
+   */
+   void VerletList::allocate(int atomCapacity, const Boundary& boundary,
+                             double potentialCutoff)
+   {
+      if (skin_ <= 0.0) {
+         UTIL_THROW("skin must be positive");
+      }
+      if (neighborCapacity_ <= 0) {
+         UTIL_THROW("neighborCapacity must be positive");
+      }
+      if (isAllocated()) {
+         UTIL_THROW("VerletList is already allocated");
+      }
+
+      atomCapacity_ = atomCapacity;
+      cutoff_ = potentialCutoff + skin_;
+      cutoffSq_ = cutoff_*cutoff_;
+      halfSkinSq_ = 0.25*skin_*skin_;
+
+      cellList_.allocate(atomCapacity_, boundary, cutoff_);
+      neighborPtrs_.allocate(atomCapacity_*neighborCapacity_);
+      nNeighbors_.allocate(atomCapacity_);
+      refPositions_.allocate(atomCapacity_);
+      isPresent_.allocate(atomCapacity_);
+      for (int i = 0; i < atomCapacity_; ++i) {
+         nNeighbors_[i] = 0;
+         refPositions_[i].zero();
+         isPresent_[i] = false;
+      }
+   }
+
+   /*
+   * Make cell grid and remove all atoms.
+   */
+   void VerletList::clear(const Boundary& boundary)
+   {
+      assert(isAllocated());
+      boundaryPtr_ = &boundary;
+      cellList_.makeGrid(boundary, cutoff_);
+      cellList_.clear();
+      for (int i = 0; i < atomCapacity_; ++i) {
+         nNeighbors_[i] = 0;
+         isPresent_[i] = false;
+      }
+      ++nFullBuild_;
+   }
+
+   /*
+   * Add an atom and build its list.
+   */
+   void VerletList::addAtom(Atom& atom)
+   {
+      int id = atom.id();
+      assert(boundaryPtr_);
+      assert(!isPresent_[id]);
+      refPositions_[id] = atom.position();
+      cellList_.addAtom(atom);
+      isPresent_[id] = true;
+      buildAtom(atom);
+   }
+
+   /*
+   * Remove an atom from all lists.
+   */
+   void VerletList::deleteAtom(Atom& atom)
+   {
+      int id = atom.id();
+      assert(isPresent_[id]);
+      removeAtom(atom);
+      cellList_.deleteAtom(atom);
+      isPresent_[id] = false;
+   }
+
+   /*
+   * Is the list of an atom valid for a trial position?
+   *
+   * Not inline: This is called once per energy evaluation, and inlining
+   * it into every McPairPotentialImpl instantiation exhausts the inline
+   * budget needed for the inner loops.
+   */
+   bool VerletList::isCurrent(const Atom &atom, const Vector &position) const
+   {
+      int id = atom.id();
+      if (!isPresent_[id]) return false;
+      return (boundaryPtr_->distanceSq(position, refPositions_[id])
+              < halfSkinSq_);
+   }
+
+   /*
+   * Rebuild the list of one atom if it has moved more than skin/2.
+   */
+   void VerletList::updateAtom(Atom& atom)
+   {
+      int id = atom.id();
+      assert(isPresent_[id]);
+      if (isCurrent(atom)) return;
+
+      removeAtom(atom);
+      refPositions_[id] = atom.position();
+      cellList_.updateAtomCell(atom, atom.position());
+      buildAtom(atom);
+      ++nPartialBuild_;
+   }
+
+   /*
+   * Find all neighbors of an atom, and add pairs to both lists (private).
+   *
+   * Precondition: atom is present, and its list is empty.
+   */
+   void VerletList::buildAtom(Atom& atom)
+   {
+      Atom* jAtomPtr;
+      const Vector& iPos = refPositions_[atom.id()];
+      int id = atom.id();
+      int j, jId, nCandidate;
+
+      cellList_.getNeighbors(iPos, candidates_);
+      nCandidate = candidates_.size();
+      for (j = 0; j < nCandidate; ++j) {
+         jAtomPtr = candidates_[j];
+         jId = jAtomPtr->id();
+         if (jId != id) {
+            if (boundaryPtr_->distanceSq(iPos, refPositions_[jId])
+                < cutoffSq_) {
+               append(id, *jAtomPtr);
+               append(jId, atom);
+            }
+         }
+      }
+   }
+
+   /*
+   * Remove atom from the lists of its neighbors, and clear its list (private).
+   */
+   void VerletList::removeAtom(Atom& atom)
+   {
+      Atom** iBegin;
+      Atom** jBegin;
+      int id = atom.id();
+      int i, j, jId, nj;
+
+      iBegin = &neighborPtrs_[id*neighborCapacity_];
+      for (i = 0; i < nNeighbors_[id]; ++i) {
+         jId = iBegin[i]->id();
+         jBegin = &neighborPtrs_[jId*neighborCapacity_];
+         nj = nNeighbors_[jId];
+
+         // Find atom in list of jId, and replace it by the last element
+         for (j = 0; j < nj; ++j) {
+            if (jBegin[j] == &atom) break;
+         }
+         assert(j < nj);
+         jBegin[j] = jBegin[nj - 1];
+         nNeighbors_[jId] = nj - 1;
+      }
+      nNeighbors_[id] = 0;
+   }
+
+   /*
+   * Append a neighbor to the list of atom iId (private).
+   */
+   void VerletList::append(int iId, Atom& jAtom)
+   {
+      int n = nNeighbors_[iId];
+      if (n >= neighborCapacity_) {
+         UTIL_THROW("Overflow: Increase VerletList neighborCapacity");
+      }
+      neighborPtrs_[iId*neighborCapacity_ + n] = &jAtom;
+      nNeighbors_[iId] = n + 1;
+   }
+
+   /*
+   * Clear statistical counters.
+   */
+   void VerletList::clearStatistics()
+   {
+      nFullBuild_ = 0;
+      nPartialBuild_ = 0;
+   }
+
+   /*
+   * Check validity of lists against reference positions.
+   */
+   bool VerletList::isValid(const Boundary& boundary) const
+   {
+      Atom* jAtomPtr;
+      int i, j, k, jId, nFound;
+      bool isNeighbor;
+
+      if (!isAllocated()) UTIL_THROW("VerletList is not allocated");
+      for (i = 0; i < atomCapacity_; ++i) {
+         if (!isPresent_[i]) {
+            if (nNeighbors_[i] != 0) {
+               UTIL_THROW("Atom that is not present has neighbors");
+            }
+            continue;
+         }
+         nFound = 0;
+         for (j = 0; j < nNeighbors_[i]; ++j) {
+            jAtomPtr = neighborPtr(i, j);
+            jId = jAtomPtr->id();
+            if (jId == i) UTIL_THROW("Atom is listed as its own neighbor");
+            if (!isPresent_[jId]) UTIL_THROW("Neighbor is not present");
+            if (boundary.distanceSq(refPositions_[i], refPositions_[jId])
+                >= cutoffSq_) {
+               UTIL_THROW("Listed neighbor is beyond cutoff");
+            }
+
+            // Check that i is listed as a neighbor of jId
+            isNeighbor = false;
+            for (k = 0; k < nNeighbors_[jId]; ++k) {
+               if (neighborPtr(jId, k)->id() == i) isNeighbor = true;
+            }
+            if (!isNeighbor) UTIL_THROW("Asymmetric neighbor lists");
+         }
+
+         // Count all atoms within cutoff of reference position
+         for (jId = 0; jId < atomCapacity_; ++jId) {
+            if (jId != i && isPresent_[jId]) {
+               if (boundary.distanceSq(refPositions_[i], refPositions_[jId])
+                   < cutoffSq_) {
+                  ++nFound;
+               }
+            }
+         }
+         if (nFound != nNeighbors_[i]) {
+            UTIL_THROW("Number of neighbors inconsistent with positions");
+         }
+      }
+      return true;
+   }
+
+}
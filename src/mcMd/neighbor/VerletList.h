@@ -0,0 +1,337 @@
+#ifndef MCMD_VERLET_LIST_H
+#define MCMD_VERLET_LIST_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CellList.h"
+#include <util/boundary/Boundary.h>
+#include <util/param/ParamComposite.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class Atom;
+
+   /**
+   * Per-atom Verlet neighbor lists that are updated incrementally.
+   *
+   * A VerletList stores, for each atom, a list of pointers to all other
+   * atoms whose reference positions lie within a distance cutoff + skin
+   * of its own reference position, where cutoff is the range of the pair
+   * potential, passed to allocate(), and skin is a parameter. The lists
+   * are symmetric: if atom j is a neighbor of atom i, then i is also a
+   * neighbor of j. Masked (bonded) pairs are not excluded.
+   *
+   * Unlike a PairList, which is rebuilt for all atoms at once, the list
+   * of an individual atom is rebuilt when that atom is updated after
+   * moving more than skin/2 from its reference position. This makes the
+   * class suitable for MC simulations, in which atoms are moved one or
+   * a few at a time. The reference position of an atom is its position
+   * when it was last added or rebuilt. Every atom that is present in
+   * the list is thus within skin/2 of its reference position after each
+   * call to updateAtom().
+   *
+   * The list of an atom i may be used to compute the energy of atom i
+   * at a trial position if isCurrent(atom) returns true, i.e., if the
+   * atom is present in the list and its trial position is less than
+   * skin/2 from its reference position, and if every other atom that
+   * has been displaced since its last update has either been removed
+   * by deleteAtom() or been translated rigidly with atom i.
+   *
+   * An internal CellList, with cells of width at least cutoff + skin,
+   * is used to find neighbors when an atom list is rebuilt. Atoms are
+   * filed in this CellList by their reference positions.
+   *
+   * \ingroup McMd_Neighbor_Module
+   */
+   class VerletList : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      VerletList();
+
+      /**
+      * Destructor.
+      */
+      virtual ~VerletList();
+
+      /**
+      * Read skin and neighborCapacity.
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream &in);
+
+      /**
+      * Load skin and neighborCapacity from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save skin and neighborCapacity to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /// \name Mutators
+      //@{
+
+      /**
+      * Allocate memory for lists and for the internal CellList.
+      *
+      * \param atomCapacity    maximum allowed atom id, plus 1
+      * \param boundary        Boundary object with maximum dimensions
+      * \param potentialCutoff range of pair potential
+      */
+      void
+      allocate(int atomCapacity, const Boundary &boundary,
+               double potentialCutoff);
+
+      /**
+      * Make the grid of the internal CellList, and remove all atoms.
+      *
+      * After this function is called, every atom in the system must be
+      * added by addAtom() before the list is used. This counts as a
+      * full rebuild.
+      *
+      * \param boundary current Boundary object
+      */
+      void clear(const Boundary &boundary);
+
+      /**
+      * Add an atom at its current position, and build its list.
+      *
+      * The atom is also added to the list of each of its neighbors.
+      *
+      * \param atom Atom to be added
+      */
+      void addAtom(Atom &atom);
+
+      /**
+      * Remove an atom, and remove it from the lists of its neighbors.
+      *
+      * \param atom Atom to be removed
+      */
+      void deleteAtom(Atom &atom);
+
+      /**
+      * Update the list after a change in atom position.
+      *
+      * If the atom has moved a distance greater than skin/2 from its
+      * reference position, its list is rebuilt, and the new position
+      * becomes its reference position. Otherwise, nothing is done.
+      *
+      * \param atom Atom whose position has been modified.
+      */
+      void updateAtom(Atom &atom);
+
+      //@}
+      /// \name Accessors
+      //@{
+
+      /**
+      * Can the list of this atom be used for its current position?
+      *
+      * Returns true if the atom has been added and is less than skin/2
+      * from its reference position, and false otherwise.
+      *
+      * \param atom Atom of interest
+      */
+      bool isCurrent(const Atom &atom) const;
+
+      /**
+      * Can the list of this atom be used for a trial position?
+      *
+      * Returns true if the atom has been added and position is less 
+      * than skin/2 from its reference position, and false otherwise.
+      *
+      * \param atom     Atom of interest
+      * \param position trial position of the atom
+      */
+      bool isCurrent(const Atom &atom, const Vector &position) const;
+
+      /**
+      * Get the number of neighbors of an atom.
+      *
+      * \param atomId id of the atom
+      */
+      int nNeighbor(int atomId) const;
+
+      /**
+      * Get a pointer to a neighbor of an atom.
+      *
+      * \param atomId id of the atom
+      * \param j      index of the neighbor, 0 <= j < nNeighbor(atomId)
+      */
+      Atom* neighborPtr(int atomId, int j) const;
+
+      /**
+      * Get the array of pointers to neighbors of an atom.
+      *
+      * \param atomId id of the atom
+      * \return array of nNeighbor(atomId) neighbor pointers
+      */
+      Atom* const* neighborPtrs(int atomId) const;
+
+      /**
+      * Get the list cutoff (potential cutoff + skin).
+      */
+      double cutoff() const;
+
+      /**
+      * Get the skin.
+      */
+      double skin() const;
+
+      /**
+      * Has memory been allocated?
+      */
+      bool isAllocated() const;
+
+      /**
+      * Return true if valid, or throw Exception.
+      *
+      * Checks symmetry of the lists and, for each pair of atoms that
+      * are present, checks that the pair is listed iff the distance
+      * between reference positions is less than the list cutoff.
+      * This is an O(N^2) test, intended for use in unit tests.
+      *
+      * \param boundary current Boundary object
+      */
+      bool isValid(const Boundary &boundary) const;
+
+      //@}
+      /// \name Statistics
+      //@{
+
+      /**
+      * Number of full rebuilds (calls to clear()) thus far.
+      */
+      int nFullBuild() const;
+
+      /**
+      * Number of single atom list rebuilds by updateAtom() thus far.
+      */
+      int nPartialBuild() const;
+
+      /**
+      * Clear nFullBuild and nPartialBuild counters.
+      */
+      void clearStatistics();
+
+      //@}
+
+   private:
+
+      /// CellList, with atoms filed by reference position.
+      CellList cellList_;
+
+      /// Work array of candidate neighbors returned by cellList_.
+      CellList::NeighborArray candidates_;
+
+      /// Neighbor pointers, neighborCapacity_ consecutive elements per atom.
+      DArray<Atom*> neighborPtrs_;
+
+      /// Number of neighbors of each atom, indexed by atom id.
+      DArray<int> nNeighbors_;
+
+      /// Reference positions, indexed by atom id.
+      DArray<Vector> refPositions_;
+
+      /// Is each atom present in the list? Indexed by atom id.
+      DArray<bool> isPresent_;
+
+      /// Pointer to current boundary, set by clear().
+      const Boundary* boundaryPtr_;
+
+      /// Extra distance added to the pair potential cutoff.
+      double skin_;
+
+      /// List cutoff (potential cutoff + skin_).
+      double cutoff_;
+
+      /// Square of cutoff_.
+      double cutoffSq_;
+
+      /// Square of skin_/2.
+      double halfSkinSq_;
+
+      /// Maximum number of neighbors per atom.
+      int neighborCapacity_;
+
+      /// Maximum atom id + 1.
+      int atomCapacity_;
+
+      /// Number of calls to clear().
+      int nFullBuild_;
+
+      /// Number of single-atom rebuilds in updateAtom().
+      int nPartialBuild_;
+
+      /*
+      * Add neighbors of atom to its list, symmetrically.
+      */
+      void buildAtom(Atom &atom);
+
+      /*
+      * Remove atom from the lists of all its neighbors, and clear its list.
+      */
+      void removeAtom(Atom &atom);
+
+      /*
+      * Append jAtom to the list of atom iId.
+      */
+      void append(int iId, Atom &jAtom);
+
+   };
+
+   // Inline functions
+
+   inline bool VerletList::isCurrent(const Atom &atom) const
+   {  return isCurrent(atom, atom.position()); }
+
+   inline int VerletList::nNeighbor(int atomId) const
+   {  return nNeighbors_[atomId]; }
+
+   inline Atom* VerletList::neighborPtr(int atomId, int j) const
+   {
+      assert(j < nNeighbors_[atomId]);
+      return neighborPtrs_[atomId*neighborCapacity_ + j];
+   }
+
+   inline Atom* const* VerletList::neighborPtrs(int atomId) const
+   {  return &neighborPtrs_[atomId*neighborCapacity_]; }
+
+   inline double VerletList::cutoff() const
+   {  return cutoff_; }
+
+   inline double VerletList::skin() const
+   {  return skin_; }
+
+   inline bool VerletList::isAllocated() const
+   {  return nNeighbors_.isAllocated(); }
+
+   inline int VerletList::nFullBuild() const
+   {  return nFullBuild_; }
+
+   inline int VerletList::nPartialBuild() const
+   {  return nPartialBuild_; }
+
+}
+#endif
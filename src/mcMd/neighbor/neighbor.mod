@@ -7,7 +7,7 @@ namespace McMd
    *
    * \brief Classes used to keep track of nonbonded neighbors.
    *
-   * The Cell and CellTag classes are used only in the implementation of 
+   * The CellTag class is used only in the implementation of 
    * a CellList.
    */
 
@@ -1,7 +1,7 @@
 
-mcMd_neighbor_=mcMd/neighbor/Cell.cpp \
-    mcMd/neighbor/CellList.cpp \
-    mcMd/neighbor/PairList.cpp 
+mcMd_neighbor_=mcMd/neighbor/CellList.cpp \
+    mcMd/neighbor/PairList.cpp \
+    mcMd/neighbor/VerletList.cpp 
 
 mcMd_neighbor_SRCS=\
      $(addprefix $(SRC_DIR)/, $(mcMd_neighbor_))
@@ -59,6 +59,21 @@ namespace McMd
       */
       virtual double difference(DArray<double> iPartnerParameter) const;
 
+      /**
+      * Evaluate differences and derivatives for several partner systems.
+      *
+      * Each derivative is computed once, and all differences are then
+      * obtained from the linear dependence on the parameters.
+      *
+      * \param ids  indices of partner systems
+      * \param nPartner  number of partner systems
+      * \param differences  array of nPartner differences (output)
+      * \param derivatives  array of nParameters derivatives (output)
+      */
+      virtual void evaluate(const DArray<int>& ids, int nPartner,
+                            DArray<double>& differences, 
+                            DArray<double>& derivatives) const;
+
       /**
       * Get the associated System by reference.
       */
@@ -101,6 +116,30 @@ namespace McMd
       return difference;
    }
 
+   /*
+   * Evaluate differences and derivatives, computing each derivative once.
+   */
+   template <class SystemType>
+   void 
+   LinearPerturbation<SystemType>::evaluate(const DArray<int>& ids, 
+                                            int nPartner,
+                                            DArray<double>& differences, 
+                                            DArray<double>& derivatives) const
+   {
+      int nParameters = getNParameters();
+      int i, k;
+      for (i = 0; i < nParameters; ++i) {
+         derivatives[i] = derivative(i);
+      }
+      for (k = 0; k < nPartner; ++k) {
+         differences[k] = 0.0;
+         for (i = 0; i < nParameters; ++i) {
+            differences[k] += (parameters_(ids[k], i) - parameter(i)) 
+                              * derivatives[i];
+         }
+      }
+   }
+
    /*
    * Return associated System by reference.
    */
@@ -114,6 +114,27 @@ namespace McMd
       setParameter();           // Modify associated System.
    }
 
+   /*
+   * Evaluate differences and derivatives for several partner systems.
+   */
+   void Perturbation::evaluate(const DArray<int>& ids, int nPartner,
+                               DArray<double>& differences, 
+                               DArray<double>& derivatives) const
+   {
+      DArray<double> partnerParameter;
+      partnerParameter.allocate(nParameters_);
+      int i, k;
+      for (i = 0; i < nParameters_; ++i) {
+         derivatives[i] = derivative(i);
+      }
+      for (k = 0; k < nPartner; ++k) {
+         for (i = 0; i < nParameters_; ++i) {
+            partnerParameter[i] = parameters_(ids[k], i);
+         }
+         differences[k] = difference(partnerParameter);
+      }
+   }
+
    /*
    * Get parameter i of system id.
    */
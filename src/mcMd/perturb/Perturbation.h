@@ -141,6 +141,28 @@ namespace McMd
       */
       virtual double difference(DArray<double> iPartnerParameter) const = 0;
 
+      /**
+      * Evaluate differences and derivatives for several partner systems.
+      *
+      * For the current microstate X, this method sets differences[k] =
+      * W(X, p[ids[k]]) - W(X, p) for k = 0, ..., nPartner - 1, where 
+      * p[id] denotes the perturbation parameters of system id, and sets
+      * derivatives[i] = dW(X, p)/dp[i] for all i < getNParameters().
+      *
+      * The default implementation calls derivative() and difference(),
+      * each of which may require a separate sweep over the system. 
+      * Subclasses should override this method if all quantities can be 
+      * obtained from a single sweep.
+      *
+      * \param ids  indices of partner systems
+      * \param nPartner  number of partner systems
+      * \param differences  array of nPartner differences (output)
+      * \param derivatives  array of nParameters derivatives (output)
+      */
+      virtual void evaluate(const DArray<int>& ids, int nPartner,
+                            DArray<double>& differences, 
+                            DArray<double>& derivatives) const;
+
       //@}
 
    protected:
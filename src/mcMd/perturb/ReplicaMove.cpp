@@ -19,6 +19,7 @@
 #include <util/archives/MemoryIArchive.h>
 #include <util/archives/MemoryCounter.h>
 #include <util/random/Random.h>
+#include <util/param/Parameter.h>
 #include <util/misc/Observer.h>
 
 #include <sstream>
@@ -46,7 +47,13 @@ namespace McMd
       ptPositionPtr_(0),
       myPositionPtr_(0),
       swapAttempt_(0),
-      swapAccept_(0)
+      swapAccept_(0),
+      stateIds_(),
+      ids_(),
+      differences_(),
+      derivatives_(),
+      allDifferences_(),
+      isParameterSwap_(false)
    {
       // Precondition
       if (!system.hasPerturbation()) {
@@ -97,11 +104,13 @@ namespace McMd
       if (nSampling_ <= 0) {
          UTIL_THROW("Invalid value input for nSampling_");
       }
+      isParameterSwap_ = false; // default value
+      readOptional<bool>(in, "parameterSwap", isParameterSwap_);
 
-      // Allocate memory
-      int nAtom = system().simulation().atomCapacity();
-      ptPositionPtr_ = new Vector[nAtom];
-      myPositionPtr_ = new Vector[nAtom];
+      allocate();
+      for (int i = 0; i < nProcs_; ++i) {
+         stateIds_[i] = i;
+      }
    }
 
    /*
@@ -112,6 +121,8 @@ namespace McMd
       // Load parameters
       loadParameter<long>(ar, "interval", interval_);
       loadParameter<int>(ar, "nSampling", nSampling_);
+      isParameterSwap_ = false; // default value
+      loadParameter<bool>(ar, "parameterSwap", isParameterSwap_, false);
       ar & swapAttempt_;
       ar & swapAccept_;
 
@@ -123,10 +134,14 @@ namespace McMd
          UTIL_THROW("Invalid value input for nSampling_");
       }
 
-      // Allocate memory
-      int nAtom = system().simulation().atomCapacity();
-      ptPositionPtr_ = new Vector[nAtom];
-      myPositionPtr_ = new Vector[nAtom];
+      allocate();
+      if (isParameterSwap_) {
+         ar & stateIds_;
+      } else {
+         for (int i = 0; i < nProcs_; ++i) {
+            stateIds_[i] = i;
+         }
+      }
    }
 
    /*
@@ -136,18 +151,53 @@ namespace McMd
    {
       ar & interval_;
       ar & nSampling_;
+      Parameter::saveOptional(ar, isParameterSwap_, isParameterSwap_);
       ar & swapAttempt_;
       ar & swapAccept_;
+      if (isParameterSwap_) {
+         ar & stateIds_;
+      }
+   }
 
-      int nAtom = system().simulation().atomCapacity();
-      ptPositionPtr_ = new Vector[nAtom];
-      myPositionPtr_ = new Vector[nAtom];
+   /*
+   * Allocate memory (private).
+   */
+   void ReplicaMove::allocate()
+   {
+      stateIds_.allocate(nProcs_);
+      if (isParameterSwap_) {
+         ids_.allocate(nProcs_);
+         differences_.allocate(nProcs_);
+         derivatives_.allocate(nParameters_);
+         for (int i = 0; i < nProcs_; ++i) {
+            ids_[i] = i;
+         }
+         if (myId_ == 0) {
+            allDifferences_.allocate(nProcs_*nProcs_);
+         }
+      } else {
+         int nAtom = system().simulation().atomCapacity();
+         ptPositionPtr_ = new Vector[nAtom];
+         myPositionPtr_ = new Vector[nAtom];
+      }
    }
    
    /*
    * Perform replica exchange move.
    */
    bool ReplicaMove::move()
+   {
+      if (isParameterSwap_) {
+         return exchangeParameters();
+      } else {
+         return exchangeConfigurations();
+      }
+   }
+
+   /*
+   * Exchange configurations among processors (private).
+   */
+   bool ReplicaMove::exchangeConfigurations()
    {
       MPI::Request request[4];
       MPI::Status  status;
@@ -262,7 +312,7 @@ namespace McMd
       if (recvPt == myId_ || sendPt == myId_) {
          // no exchange necessary
          outputFile_ << sendPt << std::endl;
-         return true;
+         return false;
       }
 
       assert(recvPt != myId_ && sendPt != myId_);
@@ -332,6 +382,85 @@ namespace McMd
 
    }
 
+   /*
+   * Sample a permutation of states by Metropolis swaps of state pairs.
+   */
+   int ReplicaMove::sampleStates(const double* differences, int nReplica,
+                                 int nSampling, Random& random, 
+                                 int* stateIds)
+   {
+      const double* Di;
+      const double* Dj;
+      double weight;
+      int i, j, si, sj;
+      int nAccept = 0;
+      for (int n = 0; n < nSampling; ++n) {
+
+         // choose a pair i,j, i!= j at random
+         i = random.uniformInt(0, nReplica);
+         j = random.uniformInt(0, nReplica - 1);
+         if (i <= j) j++;
+         si = stateIds[i];
+         sj = stateIds[j];
+         Di = differences + i*nReplica;
+         Dj = differences + j*nReplica;
+
+         // apply acceptance criterium for swapping states of i and j
+         weight = Di[sj] - Di[si] + Dj[si] - Dj[sj];
+         if (random.metropolis(exp(-weight))) {
+            ++nAccept;
+            stateIds[i] = sj;
+            stateIds[j] = si;
+         }
+      }
+      return nAccept;
+   }
+
+   /*
+   * Exchange perturbation parameters among processors (private).
+   */
+   bool ReplicaMove::exchangeParameters()
+   {
+      int oldStateId = stateIds_[myId_];
+
+      // Compute W(X, p_k) - W(X, p) for all states k, in one evaluation
+      system().perturbation().evaluate(ids_, nProcs_, differences_,
+                                       derivatives_);
+
+      // Gather the matrix of differences on processor with rank 0
+      communicatorPtr_->Gather(&differences_[0], nProcs_, MPI::DOUBLE,
+                               myId_ == 0 ? &allDifferences_[0] : 0,
+                               nProcs_, MPI::DOUBLE, 0);
+
+      // Sample a permutation of states on processor with rank 0
+      if (myId_ == 0) {
+         swapAttempt_ += nSampling_;
+         swapAccept_ += sampleStates(&allDifferences_[0], nProcs_, 
+                                     nSampling_, 
+                                     system().simulation().random(),
+                                     &stateIds_[0]);
+      }
+
+      // Send new state assignments to all processors
+      communicatorPtr_->Bcast(&stateIds_[0], nProcs_, MPI::INT, 0);
+
+      // Adopt the perturbation parameters of the new state
+      int newStateId = stateIds_[myId_];
+      if (newStateId != oldStateId) {
+         DArray<double> parameter;
+         parameter.allocate(nParameters_);
+         for (int i = 0; i < nParameters_; ++i) {
+            parameter[i] = system().perturbation().parameter(i, newStateId);
+         }
+         system().perturbation().setParameter(parameter);
+      }
+
+      // Log the state of this processor to file
+      outputFile_ << newStateId << std::endl;
+
+      return false;
+   }
+
 }
 #endif // ifdef UTIL_MPI
 #endif // ifdef MCMD_PERTURB
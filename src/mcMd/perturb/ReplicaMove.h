@@ -22,6 +22,8 @@
 
 #include <fstream>
 
+namespace Util { class Random; }
+
 namespace McMd
 {
 
@@ -58,6 +60,18 @@ namespace McMd
    *
    * The technique is described in detail in
    * John D. Chodera and Michael R. Shirts, J. Chem. Phys. 135, 194110 (2011)
+   *
+   * If the optional parameter \b parameterSwap is true, configurations
+   * are never exchanged. Instead, each processor keeps its configuration 
+   * and adopts the perturbation parameters of the state to which it is
+   * assigned by the sampled permutation. The acceptance criterion is then
+   * evaluated from the matrix of differences W(X_i, p_k) - W(X_i, p_i),
+   * which is obtained with a single call to Perturbation::evaluate() and 
+   * a single collective gather. Because no atomic positions are moved, 
+   * no cell list needs to be rebuilt, and exchanges may be attempted at
+   * short intervals. The index of the state currently assigned to each 
+   * processor is returned by stateId() and written to the output file
+   * "repx" after every exchange attempt.
    * 
    * \ingroup McMd_Perturb_Module
    */
@@ -88,6 +102,10 @@ namespace McMd
       * Empirically, \b nSampling should be on the order of P^3 .. P^5,
       * where P is the number of processors.
       *
+      * The optional bool parameter \b parameterSwap (default false)
+      * selects exchange of perturbation parameters rather than of
+      * configurations.
+      *
       * \param in input stream from which to read parameters.
       */
       virtual void readParameters(std::istream& in);
@@ -108,6 +126,8 @@ namespace McMd
 
       /**
       * Attempt, and accept or reject a replica exchange move.
+      *
+      * \return true if atomic positions were changed, false otherwise.
       */
       virtual bool move();
 
@@ -131,6 +151,18 @@ namespace McMd
       */
       void notifyObservers(sendRecvPair partners);
  
+      /**
+      * Are perturbation parameters exchanged instead of configurations?
+      */
+      bool isParameterSwap() const;
+
+      /**
+      * Index of the state (perturbation parameters) of this processor.
+      *
+      * This is equal to the communicator rank unless parameterSwap is true.
+      */
+      int stateId() const;
+
       /**
       * Number of swap attempts
       */
@@ -141,6 +173,25 @@ namespace McMd
       */
       long nAccept(); 
 
+      /**
+      * Sample a permutation of states by Metropolis swaps of state pairs.
+      *
+      * Row i of the nReplica x nReplica matrix differences contains the
+      * differences W(X_i, p_k) - W(X_i, p_(s_i)) for replica i and all
+      * states k, in which s_i = stateIds[i] is the state of replica i on
+      * entry. Each of nSampling steps proposes to swap the states of a
+      * random pair of replicas, and stateIds is updated in place.
+      *
+      * \param differences  matrix of differences, in row-major order
+      * \param nReplica  number of replicas (and states)
+      * \param nSampling  number of attempted swaps
+      * \param random  random number generator
+      * \param stateIds  state of each replica (input and output)
+      * \return number of accepted swaps
+      */
+      static int sampleStates(const double* differences, int nReplica,
+                              int nSampling, Random& random, int* stateIds);
+
    protected:
 
       /**
@@ -186,6 +237,39 @@ namespace McMd
       /// Count of accepted swaps
       long  swapAccept_;
 
+      /// State index for each processor (used only if isParameterSwap_).
+      DArray<int> stateIds_;
+
+      /// Indices of all states, 0, ..., nProcs_ - 1.
+      DArray<int> ids_;
+
+      /// Differences W(X, p_k) - W(X, p) for this processor.
+      DArray<double> differences_;
+
+      /// Derivatives dW/dp[i] for this processor (workspace).
+      DArray<double> derivatives_;
+
+      /// Matrix of differences for all processors (rank 0 only).
+      DArray<double> allDifferences_;
+
+      /// Exchange perturbation parameters instead of configurations?
+      bool  isParameterSwap_;
+
+      /*
+      * Allocate memory, after reading parameters.
+      */
+      void allocate();
+
+      /*
+      * Exchange configurations among processors.
+      */
+      bool exchangeConfigurations();
+
+      /*
+      * Exchange perturbation parameters among processors.
+      */
+      bool exchangeParameters();
+
    };
    // Inline methods
 
@@ -201,6 +285,18 @@ namespace McMd
    inline bool ReplicaMove::isAtInterval(long counter) const
    { return (counter%interval_ == 0); }
    
+   /*
+   * Are perturbation parameters exchanged instead of configurations?
+   */
+   inline bool ReplicaMove::isParameterSwap() const
+   { return isParameterSwap_; }
+
+   /*
+   * Index of the state of this processor.
+   */
+   inline int ReplicaMove::stateId() const
+   { return stateIds_[myId_]; }
+
    /*
    * Number of attempts in given direction.
    */
@@ -0,0 +1,398 @@
+#ifdef  MCMD_PERTURB
+#ifndef INTER_NOPAIR
+#ifndef MCMD_MC_SOFT_CORE_PERTURBATION_H
+#define MCMD_MC_SOFT_CORE_PERTURBATION_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/perturb/Perturbation.h>            // base class
+#include <mcMd/neighbor/CellList.h>               // member
+
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/potentials/pair/McPairPotentialImpl.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/ensembles/EnergyEnsemble.h>
+#include <util/containers/DArray.h>               // member
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class McSystem;
+
+   /**
+   * A Perturbation in the coupling parameter lambda(0,1) of a soft-core
+   * pair interaction.
+   *
+   * The perturbation parameter is the coupling parameter lambda(0, 1)
+   * for interactions between atoms of types 0 and 1, for any pair
+   * interaction that provides setLambda(), lambda(), dEnergyDLambda()
+   * and energies(), such as SoftCoreLJPair. Because the energy is not
+   * a linear function of lambda, differences W(X, p') - W(X, p) are
+   * computed from pair energies at the partner parameter values. The
+   * evaluate() method obtains the derivative and the differences for
+   * all partner systems in a single sweep over the cell list.
+   *
+   * \ingroup McMd_Perturb_Module
+   */
+   template < class Interaction >
+   class McSoftCorePerturbation : public Perturbation
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param system parent McSystem
+      * \param size   number of systems (communicator size)
+      * \param rank   id of this system (communicator rank)
+      */
+      McSoftCorePerturbation(McSystem& system, int size, int rank);
+
+      /**
+      * Destructor
+      */
+      virtual ~McSoftCorePerturbation();
+
+      /**
+      * Read parameter lambda(0, 1) from file.
+      *
+      * \param in input stream (file or std in).
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Set coupling parameter lambda(0,1) for this System.
+      */
+      virtual void setParameter();
+
+      /**
+      * Return the coupling parameter lambda(0,1) for this System.
+      *
+      * \param i index of the perturbation parameter (always 0).
+      */
+      virtual double parameter(int i) const;
+
+      /**
+      * Return d(0-1 pair energy)/dlambda divided by kT.
+      *
+      * \param i index of the perturbation parameter (always 0).
+      */
+      virtual double derivative(int i) const;
+
+      /**
+      * Returns the difference W(X, p') - W(X, p).
+      *
+      * \param iPartnerParameter perturbation parameters for partner system.
+      */
+      virtual double difference(DArray<double> iPartnerParameter) const;
+
+      /**
+      * Evaluate differences and derivative in a single sweep.
+      *
+      * \param ids  indices of partner systems
+      * \param nPartner  number of partner systems
+      * \param differences  array of nPartner differences (output)
+      * \param derivatives  array containing the derivative (output)
+      */
+      virtual void evaluate(const DArray<int>& ids, int nPartner,
+                            DArray<double>& differences,
+                            DArray<double>& derivatives) const;
+
+      /**
+      * Return the pair potential interaction.
+      */
+      Interaction& interaction() const;
+
+      /**
+      * Get the parent McSystem.
+      */
+      McSystem& system() const;
+
+   private:
+
+      /// Neighbor array for internal use
+      mutable CellList::NeighborArray neighbors_;
+
+      /// Values of lambda, with the value for this system first.
+      mutable DArray<double> lambdas_;
+
+      /// Total 0-1 pair energies for elements of lambdas_.
+      mutable DArray<double> energies_;
+
+      /// Pair energies for elements of lambdas_ (workspace).
+      mutable DArray<double> pairEnergies_;
+
+      /// Pointer to interaction
+      mutable Interaction* interactionPtr_;
+
+      /// Pointer to parent system
+      McSystem* systemPtr_;
+
+      /*
+      * Allocate workspace arrays.
+      */
+      void allocate();
+
+      /*
+      * Compute 0-1 pair energies for the first n elements of lambdas_,
+      * and return the derivative of the 0-1 pair energy with respect to
+      * lambda, in a single sweep over the cell list.
+      */
+      double sweep(int n) const;
+
+      /*
+      * Return beta, checking that the ensemble is isothermal.
+      */
+      double beta() const;
+
+   };
+
+   /// Implementation
+
+   /*
+   * Constructor.
+   */
+   template < class Interaction >
+   McSoftCorePerturbation<Interaction>
+      ::McSoftCorePerturbation(McSystem& system, int size, int rank)
+    : Perturbation(size, rank),
+      interactionPtr_(0),
+      systemPtr_(&system)
+   {  setClassName("McSoftCorePerturbation"); }
+
+   /*
+   * Destructor.
+   */
+   template < class Interaction >
+   McSoftCorePerturbation<Interaction>::~McSoftCorePerturbation()
+   {}
+
+   /*
+   * Read lambda(0,1) from file.
+   */
+   template < class Interaction >
+   void McSoftCorePerturbation<Interaction>::readParameters(std::istream& in)
+   {
+      Perturbation::readParameters(in);
+      allocate();
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   template < class Interaction >
+   void
+   McSoftCorePerturbation<Interaction>::loadParameters(Serializable::IArchive& ar)
+   {
+      Perturbation::loadParameters(ar);
+      allocate();
+   }
+
+   /*
+   * Allocate workspace arrays (private).
+   */
+   template < class Interaction >
+   void McSoftCorePerturbation<Interaction>::allocate()
+   {
+      if (nParameters_ != 1) {
+         UTIL_THROW("McSoftCorePerturbation requires nParameters = 1");
+      }
+      if (!lambdas_.isAllocated()) {
+         lambdas_.allocate(size_ + 1);
+         energies_.allocate(size_ + 1);
+         pairEnergies_.allocate(size_ + 1);
+      }
+   }
+
+   /*
+   * Return the pair interaction by reference.
+   */
+   template < class Interaction >
+   Interaction& McSoftCorePerturbation<Interaction>::interaction() const
+   {
+      if (interactionPtr_ == 0) {
+         McPairPotential* pairPtr = &(system().pairPotential());
+         McPairPotentialImpl< Interaction >* implPtr = 0;
+         implPtr = dynamic_cast< McPairPotentialImpl< Interaction >* >(pairPtr);
+         if (implPtr == 0) {
+            UTIL_THROW("Failed dynamic cast of McPairPotential");
+         }
+         interactionPtr_ = &implPtr->interaction();
+      }
+      return *interactionPtr_;
+   }
+
+   /*
+   * Return parent system by reference.
+   */
+   template < class Interaction >
+   inline McSystem& McSoftCorePerturbation<Interaction>::system() const
+   {  return *systemPtr_; }
+
+   /*
+   * Set the parameter lambda(0,1) for this McSystem.
+   */
+   template < class Interaction >
+   void McSoftCorePerturbation<Interaction>::setParameter()
+   {  interaction().setLambda(0, 1, parameter_[0]); }
+
+   /*
+   * Get the coupling parameter from the pair interaction.
+   */
+   template < class Interaction >
+   double McSoftCorePerturbation<Interaction>::parameter(int i) const
+   {
+      if (i >= nParameters_) {
+         UTIL_THROW("perturbation parameter index is out of bounds");
+      }
+      return interaction().lambda(0, 1);
+   }
+
+   /*
+   * Return d(0-1 pair energy)/dlambda, divided by kT.
+   */
+   template < class Interaction >
+   double McSoftCorePerturbation<Interaction>::derivative(int i) const
+   {
+      if (i >= nParameters_) {
+         UTIL_THROW("perturbation parameter index is out of bounds");
+      }
+      return beta()*sweep(0);
+   }
+
+   /*
+   * Return W(X, p') - W(X, p).
+   */
+   template < class Interaction >
+   double McSoftCorePerturbation<Interaction>
+          ::difference(DArray<double> iPartnerParameter) const
+   {
+      lambdas_[0] = parameter(0);
+      lambdas_[1] = iPartnerParameter[0];
+      sweep(2);
+      return beta()*(energies_[1] - energies_[0]);
+   }
+
+   /*
+   * Evaluate differences and derivative in a single sweep.
+   */
+   template < class Interaction >
+   void McSoftCorePerturbation<Interaction>
+        ::evaluate(const DArray<int>& ids, int nPartner,
+                   DArray<double>& differences,
+                   DArray<double>& derivatives) const
+   {
+      if (nPartner > size_) {
+         UTIL_THROW("Too many partner systems");
+      }
+      int k;
+      lambdas_[0] = parameter(0);
+      for (k = 0; k < nPartner; ++k) {
+         lambdas_[k+1] = parameters_(ids[k], 0);
+      }
+      double b = beta();
+      derivatives[0] = b*sweep(nPartner + 1);
+      for (k = 0; k < nPartner; ++k) {
+         differences[k] = b*(energies_[k+1] - energies_[0]);
+      }
+   }
+
+   /*
+   * Return beta, checking for an isothermal ensemble (private).
+   */
+   template < class Interaction >
+   double McSoftCorePerturbation<Interaction>::beta() const
+   {
+      if (!system().energyEnsemble().isIsothermal()) {
+         UTIL_THROW("Non isothermal ensemble for McSoftCorePerturbation.");
+      }
+      return system().energyEnsemble().beta();
+   }
+
+   /*
+   * Sweep over 0-1 pairs, computing energies and dE/dlambda (private).
+   */
+   template < class Interaction >
+   double McSoftCorePerturbation<Interaction>::sweep(int n) const
+   {
+      const Interaction& pair = interaction();
+      const Boundary& boundary = system().boundary();
+      const CellList& cellList = system().pairPotential().cellList();
+      const double* lambdas = &lambdas_[0];
+      double* pairEnergies = &pairEnergies_[0];
+      Atom  *jAtomPtr, *kAtomPtr;
+      double rsq, dEnergy;
+      int nNeighbor, nInCell;
+      int ic, nc, j, k, l, jId, kId, jType, kType;
+
+      for (l = 0; l < n; ++l) {
+         energies_[l] = 0.0;
+      }
+      dEnergy = 0.0;
+
+      // Loop over cells
+      nc = cellList.totCells();
+      for (ic = 0; ic < nc; ++ic) {
+         cellList.getCellNeighbors(ic, neighbors_, nInCell);
+         nNeighbor = neighbors_.size();
+
+         // Loop over primary atoms in this cell
+         for (j = 0; j < nInCell; ++j) {
+            jAtomPtr = neighbors_[j];
+            jId      = jAtomPtr->id();
+            jType    = jAtomPtr->typeId();
+            if (jType > 1) continue;
+
+            // Loop over secondary atoms in this and neighboring cells
+            for (k = 0; k < nNeighbor; ++k) {
+               kAtomPtr = neighbors_[k];
+               kId      = kAtomPtr->id();
+               kType    = kAtomPtr->typeId();
+
+               // Count each 0-1 pair only once, and exclude masked pairs
+               if (kId > jId && kType + jType == 1 && kType <= 1) {
+                  if (!jAtomPtr->mask().isMasked(*kAtomPtr)) {
+                     rsq = boundary.distanceSq(jAtomPtr->position(),
+                                               kAtomPtr->position());
+                     if (rsq < pair.cutoffSq(jType, kType)) {
+                        dEnergy += pair.dEnergyDLambda(rsq, jType, kType);
+                        if (n > 0) {
+                           pair.energies(rsq, jType, kType, lambdas, n,
+                                         pairEnergies);
+                           for (l = 0; l < n; ++l) {
+                              energies_[l] += pairEnergies[l];
+                           }
+                        }
+                     }
+                  }
+               }
+
+            } // secondary atoms
+
+         } // primary atoms
+
+      } // cells
+
+      return dEnergy;
+   }
+
+}
+
+#endif
+#endif  // #ifndef INTER_NOPAIR
+#endif  // ifdef MCMD_PERTURB
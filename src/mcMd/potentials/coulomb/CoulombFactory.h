@@ -0,0 +1,52 @@
+#ifndef MCMD_COULOMB_FACTORY_H
+#define MCMD_COULOMB_FACTORY_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/Factory.h>                        // base class template
+#include <mcMd/potentials/coulomb/CoulombPotential.h>  // template argument
+
+#include <string>
+
+namespace McMd
+{
+
+   class System;
+
+   /**
+   * Factory for CoulombPotential objects.
+   *
+   * The coulombStyle string is the name of a k-space solver class,
+   * "EwaldKSpace" or "SpmeKSpace".
+   *
+   * \ingroup McMd_Coulomb_Module
+   */
+   class CoulombFactory : public Factory<CoulombPotential>
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      CoulombFactory(System& system);
+
+      /**
+      * Return a pointer to a new CoulombPotential, if possible.
+      */
+      CoulombPotential* factory(const std::string& subclass) const;
+
+   private:
+
+      // Pointer to the parent System.
+      System* systemPtr_;
+
+   };
+
+}
+#endif
@@ -0,0 +1,121 @@
+#ifndef MCMD_COULOMB_POTENTIAL_H
+#define MCMD_COULOMB_POTENTIAL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>      // base class
+#include <inter/coulomb/EwaldInteraction.h> // member
+
+#include <string>
+
+namespace Util
+{
+   class Vector;
+   class Tensor;
+}
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Inter;
+
+   /**
+   * Long range (k-space) part of an Ewald Coulomb potential.
+   *
+   * A CoulombPotential computes the k-space part of the Ewald sum, and
+   * the associated self and background energies, for all atoms in a
+   * System. The real space part is computed by a CoulombPair pair
+   * interaction, which is given a copy of the EwaldInteraction held by
+   * this object by the pair potential factory. Charges are given by
+   * AtomType::charge().
+   *
+   * \ingroup McMd_Coulomb_Module
+   */
+   class CoulombPotential : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      CoulombPotential()
+       : ewald_()
+      {  setClassName("CoulombPotential"); }
+
+      /**
+      * Destructor (does nothing).
+      */
+      virtual ~CoulombPotential()
+      {}
+
+      /**
+      * Get Ewald parameters (epsilon, alpha and rSpaceCutoff).
+      */
+      const EwaldInteraction& ewaldInteraction() const
+      {  return ewald_; }
+
+      /**
+      * Return name of k-space solver class (e.g., "SpmeKSpace").
+      */
+      virtual std::string kSpaceClassName() const = 0;
+
+      /// \name System energy, force, and stress.
+      //@{
+
+      /**
+      * Add k-space forces to all atoms in this System.
+      */
+      virtual void addForces() = 0;
+
+      /**
+      * Return total k-space, self and background energy.
+      */
+      virtual double energy() const = 0;
+
+      /**
+      * Compute k-space and background pressure.
+      *
+      * \param stress (output) pressure.
+      */
+      virtual void computeStress(double& stress) const = 0;
+
+      /**
+      * Compute k-space and background x, y, z pressure components.
+      *
+      * \param stress (output) pressures.
+      */
+      virtual void computeStress(Util::Vector& stress) const = 0;
+
+      /**
+      * Compute k-space and background stress tensor.
+      *
+      * \param stress (output) stress tensor.
+      */
+      virtual void computeStress(Util::Tensor& stress) const = 0;
+
+      //@}
+
+   protected:
+
+      /**
+      * Get Ewald parameters by non-const reference.
+      */
+      EwaldInteraction& ewaldInteraction()
+      {  return ewald_; }
+
+   private:
+
+      // Ewald parameters.
+      EwaldInteraction ewald_;
+
+   };
+
+}
+#endif
@@ -0,0 +1,374 @@
+#ifndef MCMD_COULOMB_POTENTIAL_IMPL_H
+#define MCMD_COULOMB_POTENTIAL_IMPL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/potentials/coulomb/CoulombPotential.h>  // base class
+#include <mcMd/simulation/SubSystem.h>                 // base class
+#include <util/containers/DArray.h>                    // member
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class System;
+
+   /**
+   * Implementation template for a CoulombPotential.
+   *
+   * The KSpace template argument is a k-space solver class, such as
+   * Inter::EwaldKSpace or Inter::SpmeKSpace. The parameter file block
+   * contains the EwaldInteraction parameters, followed by the parameters
+   * of the KSpace class.
+   *
+   * \ingroup McMd_Coulomb_Module
+   */
+   template <class KSpace>
+   class CoulombPotentialImpl : public CoulombPotential, public SubSystem
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      CoulombPotentialImpl(System& system);
+
+      /**
+      * Destructor.
+      */
+      virtual ~CoulombPotentialImpl();
+
+      /**
+      * Read Ewald and k-space parameters.
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Return k-space solver class name.
+      */
+      virtual std::string kSpaceClassName() const;
+
+      /// \name System energy, force, and stress.
+      //@{
+
+      /**
+      * Add k-space forces to all atoms in this System.
+      */
+      virtual void addForces();
+
+      /**
+      * Return total k-space, self and background energy.
+      */
+      virtual double energy() const;
+
+      /**
+      * Compute k-space and background pressure.
+      */
+      virtual void computeStress(double& stress) const;
+
+      /**
+      * Compute k-space and background x, y, z pressure components.
+      */
+      virtual void computeStress(Util::Vector& stress) const;
+
+      /**
+      * Compute k-space and background stress tensor.
+      */
+      virtual void computeStress(Util::Tensor& stress) const;
+
+      //@}
+
+   private:
+
+      // K-space solver (mutable, because energy and stress are const).
+      mutable KSpace kSpace_;
+
+      // Charge of each atom type.
+      DArray<double> charges_;
+
+      /*
+      * Copy atom type charges into charges_.
+      */
+      void initialize();
+
+      /*
+      * Accumulate charges, solve, and optionally add forces.
+      */
+      void solve(bool needForce) const;
+
+      /*
+      * Compute sum of charges and sum of squared charges.
+      */
+      void chargeSums(double& chargeSum, double& chargeSqSum) const;
+
+      /*
+      * Compute k-space and background stress tensor.
+      */
+      void computeStressTensor(Tensor& stress) const;
+
+   };
+
+}
+
+#include <mcMd/simulation/System.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/boundary/Boundary.h>
+#include <util/space/Vector.h>
+#include <util/space/Tensor.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   template <class KSpace>
+   CoulombPotentialImpl<KSpace>::CoulombPotentialImpl(System& system)
+    : CoulombPotential(),
+      SubSystem(system),
+      kSpace_(),
+      charges_()
+   {}
+
+   /*
+   * Destructor.
+   */
+   template <class KSpace>
+   CoulombPotentialImpl<KSpace>::~CoulombPotentialImpl()
+   {}
+
+   /*
+   * Read parameters from file.
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::readParameters(std::istream &in)
+   {
+      bool nextIndent = false; // Do not indent blocks
+      addParamComposite(ewaldInteraction(), nextIndent);
+      ewaldInteraction().readParameters(in);
+      addParamComposite(kSpace_, nextIndent);
+      kSpace_.readParameters(in);
+      initialize();
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   template <class KSpace>
+   void
+   CoulombPotentialImpl<KSpace>::loadParameters(Serializable::IArchive &ar)
+   {
+      bool nextIndent = false; // Do not indent blocks
+      addParamComposite(ewaldInteraction(), nextIndent);
+      ewaldInteraction().loadParameters(ar);
+      addParamComposite(kSpace_, nextIndent);
+      kSpace_.loadParameters(ar);
+      initialize();
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::save(Serializable::OArchive &ar)
+   {
+      ewaldInteraction().save(ar);
+      kSpace_.save(ar);
+   }
+
+   /*
+   * Return k-space class name.
+   */
+   template <class KSpace>
+   std::string CoulombPotentialImpl<KSpace>::kSpaceClassName() const
+   {  return kSpace_.className(); }
+
+   /*
+   * Add k-space forces to all atoms.
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::addForces()
+   {  solve(true); }
+
+   /*
+   * Return total k-space, self and background energy.
+   */
+   template <class KSpace>
+   double CoulombPotentialImpl<KSpace>::energy() const
+   {
+      solve(false);
+      double chargeSum, chargeSqSum;
+      chargeSums(chargeSum, chargeSqSum);
+      double energy = kSpace_.energy();
+      energy += ewaldInteraction().selfEnergy(chargeSqSum);
+      energy += ewaldInteraction().backgroundEnergy(chargeSum,
+                                                    boundary().volume());
+      return energy;
+   }
+
+   /*
+   * Compute pressure.
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::computeStress(double& stress) const
+   {
+      Tensor tensor;
+      computeStressTensor(tensor);
+      stress = 0.0;
+      for (int i = 0; i < Dimension; ++i) {
+         stress += tensor(i, i);
+      }
+      stress /= double(Dimension);
+   }
+
+   /*
+   * Compute x, y, z pressure components.
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::computeStress(Util::Vector& stress) 
+        const
+   {
+      Tensor tensor;
+      computeStressTensor(tensor);
+      for (int i = 0; i < Dimension; ++i) {
+         stress[i] = tensor(i, i);
+      }
+   }
+
+   /*
+   * Compute stress tensor.
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::computeStress(Util::Tensor& stress) 
+        const
+   {  computeStressTensor(stress); }
+
+   /*
+   * Copy atom type charges (private).
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::initialize()
+   {
+      int nAtomType = simulation().nAtomType();
+      charges_.allocate(nAtomType);
+      for (int i = 0; i < nAtomType; ++i) {
+         charges_[i] = simulation().atomType(i).charge();
+      }
+   }
+
+   /*
+   * Accumulate charges and solve k-space problem (private).
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::solve(bool needForce) const
+   {
+      System::ConstMoleculeIterator molIter;
+      Molecule::ConstAtomIterator atomIter;
+      double charge;
+      int iSpec;
+      int nSpecies = simulation().nSpecies();
+
+      kSpace_.setup(boundary(), ewaldInteraction());
+      kSpace_.clear();
+      for (iSpec = 0; iSpec < nSpecies; ++iSpec) {
+         for (begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               charge = charges_[atomIter->typeId()];
+               if (charge != 0.0) {
+                  kSpace_.addCharge(atomIter->position(), charge);
+               }
+            }
+         }
+      }
+      kSpace_.solve();
+
+      if (needForce) {
+         // Forces are modified through const iterators, as in atomEnergy
+         Atom* atomPtr;
+         for (iSpec = 0; iSpec < nSpecies; ++iSpec) {
+            for (begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
+               for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+                  charge = charges_[atomIter->typeId()];
+                  if (charge != 0.0) {
+                     atomPtr = const_cast<Atom*>(atomIter.get());
+                     kSpace_.addForce(atomPtr->position(), charge, 
+                                      atomPtr->force());
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   /*
+   * Compute charge sums (private).
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::chargeSums(double& chargeSum,
+                                                 double& chargeSqSum) const
+   {
+      System::ConstMoleculeIterator molIter;
+      Molecule::ConstAtomIterator atomIter;
+      double charge;
+      chargeSum = 0.0;
+      chargeSqSum = 0.0;
+      for (int iSpec = 0; iSpec < simulation().nSpecies(); ++iSpec) {
+         for (begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               charge = charges_[atomIter->typeId()];
+               chargeSum += charge;
+               chargeSqSum += charge*charge;
+            }
+         }
+      }
+   }
+
+   /*
+   * Compute k-space and background stress tensor (private).
+   */
+   template <class KSpace>
+   void CoulombPotentialImpl<KSpace>::computeStressTensor(Tensor& stress) 
+        const
+   {
+      solve(false);
+      double chargeSum, chargeSqSum;
+      chargeSums(chargeSum, chargeSqSum);
+      double volume = boundary().volume();
+      double background;
+      background = ewaldInteraction().backgroundEnergy(chargeSum, volume);
+      stress = kSpace_.stress();
+      for (int i = 0; i < Dimension; ++i) {
+         stress(i, i) += background/volume;
+      }
+   }
+
+}
+#endif
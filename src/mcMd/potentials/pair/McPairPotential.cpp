@@ -16,6 +16,10 @@
 
 #include <fstream>
 
+#ifdef UTIL_OPENMP
+#include <omp.h>
+#endif
+
 namespace McMd
 {
 
@@ -26,8 +30,17 @@ namespace McMd
    */
    McPairPotential::McPairPotential(System& system)
     : ParamComposite(),
-      SubSystem(system)
-   {  setClassName("McPairPotential"); }
+      SubSystem(system),
+      nThread_(1)
+   {  
+      setClassName("McPairPotential"); 
+      #ifdef UTIL_OPENMP
+      nThread_ = omp_get_max_threads();
+      if (nThread_ > 1) {
+         threadNeighbors_.allocate(nThread_);
+      }
+      #endif
+   }
  
    /* 
    * Destructor. 
@@ -46,6 +59,9 @@ namespace McMd
 
       // Clear the cellList
       cellList_.clear();
+      if (verletList_.isActive()) {
+         verletList_.clear(boundary());
+      }
 
       // Add all atoms to cellList_ 
       System::MoleculeIterator molIter;
@@ -55,6 +71,9 @@ namespace McMd
             for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
                boundary().shift(atomIter->position());
                cellList_.addAtom(*atomIter);
+               if (verletList_.isActive()) {
+                  verletList_.addAtom(*atomIter);
+               }
             }
          }
       }
@@ -12,6 +12,7 @@
 #include <mcMd/simulation/SubSystem.h>             // base class
 #include <mcMd/potentials/pair/PairPotential.h>    // base class
 #include <mcMd/neighbor/CellList.h>                // member
+#include <mcMd/neighbor/VerletList.h>              // member
 
 #include <util/global.h>
 
@@ -25,6 +26,11 @@ namespace McMd
    /**
    * A PairPotential for MC simulations (abstract).
    *
+   * An McPairPotential maintains a CellList of atom positions. It may
+   * also maintain an optional VerletList, which is used by atomEnergy()
+   * and moleculeEnergy() when the list is current for the atoms of
+   * interest. Both are updated by the cell list management functions.
+   *
    * \ingroup McMd_Pair_Module
    */
    class McPairPotential : public ParamComposite, public SubSystem,
@@ -68,6 +74,24 @@ namespace McMd
       */
       virtual double moleculeEnergy(const Molecule& molecule) const = 0;
 
+      /**
+      * Calculate nonbonded pair energies of one Atom at trial positions.
+      *
+      * Upon return, energies[i] is equal to the value that atomEnergy()
+      * would return if atom.position() were set to positions[i], for
+      * 0 <= i < nTrial. The position of the atom is not modified. The
+      * trials are independent, and are divided among nThread() threads 
+      * if nThread() > 1. This is intended for use by configuration bias
+      * moves, which evaluate many trial positions for one atom.
+      *
+      * \param atom      Atom object of interest
+      * \param positions array of nTrial trial positions
+      * \param nTrial    number of trial positions
+      * \param energies  array of nTrial trial energies (out)
+      */
+      virtual void trialEnergies(const Atom& atom, const Vector* positions,
+                                 int nTrial, double* energies) const = 0;
+
       //@}
       /// \name Cell List Management
       //@{
@@ -78,7 +102,8 @@ namespace McMd
       * Calls CellList::clear() to clear the CellList,
       * then adds every Atom in this System. Each Atom
       * position is shifted into the primary box by
-      * Boundary::shift() before being added.
+      * Boundary::shift() before being added. Also rebuilds
+      * the VerletList, if any.
       */
       void buildCellList();
 
@@ -123,6 +148,25 @@ namespace McMd
       */
       const CellList& cellList() const;
 
+      /**
+      * Is the optional VerletList in use?
+      */
+      bool hasVerletList() const;
+
+      /** 
+      * Get the VerletList by const reference.
+      */
+      const VerletList& verletList() const;
+
+      /**
+      * Get number of threads used by trialEnergies().
+      *
+      * If UTIL_OPENMP is defined, this is the maximum number of OpenMP
+      * threads when the object was constructed, which may be set by 
+      * the OMP_NUM_THREADS environment variable. Otherwise, it is 1.
+      */
+      int nThread() const;
+
       //@}
 
    protected:
@@ -139,32 +183,67 @@ namespace McMd
       /// Maximum boundary (used to allocated memory for CellList).
       Boundary maxBoundary_;
 
+      /// Optional per-atom Verlet lists (active only if read).
+      VerletList verletList_;
+
+      #ifdef UTIL_OPENMP
+      /// Neighbor arrays used by trialEnergies(), one per thread.
+      mutable DArray<CellList::NeighborArray> threadNeighbors_;
+      #endif
+
+   private:
+
+      /// Number of threads used by trialEnergies().
+      int nThread_;
+
    };
 
    // Inline functions
   
    // Add an atom to CellList.
    inline void McPairPotential::addAtom(Atom &atom)
-   {  cellList_.addAtom(atom); }
+   {
+      cellList_.addAtom(atom);
+      if (verletList_.isActive()) verletList_.addAtom(atom);
+   }
 
    // Delete an atom from the CellList.
    inline void McPairPotential::deleteAtom(Atom &atom)
-   {  cellList_.deleteAtom(atom); }
+   {
+      cellList_.deleteAtom(atom);
+      if (verletList_.isActive()) verletList_.deleteAtom(atom);
+   }
 
    // Update the cell list to reflect a new Atom position.
    inline void McPairPotential::updateAtomCell(Atom &atom)
-   {  cellList_.updateAtomCell(atom, atom.position()); }
+   {
+      cellList_.updateAtomCell(atom, atom.position());
+      if (verletList_.isActive()) verletList_.updateAtom(atom);
+   }
 
    // Move atom to a new position.
    inline void McPairPotential::moveAtom(Atom &atom, const Vector &position)
    {
       atom.position() = position;
       cellList_.updateAtomCell(atom, position);
+      if (verletList_.isActive()) verletList_.updateAtom(atom);
    }
 
    // Get the cellList by const reference.
    inline const CellList& McPairPotential::cellList() const
    { return cellList_; }
 
+   // Is the VerletList in use?
+   inline bool McPairPotential::hasVerletList() const
+   { return verletList_.isActive(); }
+
+   // Get the VerletList by const reference.
+   inline const VerletList& McPairPotential::verletList() const
+   { return verletList_; }
+
+   // Get number of threads used by trialEnergies().
+   inline int McPairPotential::nThread() const
+   { return nThread_; }
+
 } 
 #endif
@@ -52,7 +52,8 @@ namespace McMd
       * This method reads the maxBoundary and Interaction parameter blocks,
       * and then allocates memory for an internal CellList. It passes
       * simulation().nAtomType() as an argument Interaction::setNAtomType() 
-      * before calling Interaction::readParameters().
+      * before calling Interaction::readParameters(). An optional 
+      * VerletList block may follow maxBoundary.
       */
       virtual void readParameters(std::istream& in);
 
@@ -144,6 +145,17 @@ namespace McMd
       */
       double moleculeEnergy(const Molecule& molecule) const;
 
+      /**
+      * Calculate nonbonded pair energies of one Atom at trial positions.
+      *
+      * \param atom      Atom object of interest
+      * \param positions array of nTrial trial positions
+      * \param nTrial    number of trial positions
+      * \param energies  array of nTrial trial energies (out)
+      */
+      void trialEnergies(const Atom& atom, const Vector* positions,
+                         int nTrial, double* energies) const;
+
       /**
       * Return total nonbonded pair potential energy of this System.
       */
@@ -179,6 +191,27 @@ namespace McMd
       template <typename T>
       void computeStressImpl(T& stress) const;
 
+      /*
+      * Pair energy of atom at a specified position.
+      *
+      * The neighbors array is used as workspace for a cell list search.
+      */
+      double 
+      positionEnergy(const Atom& atom, const Vector& position, 
+                     CellList::NeighborArray& neighbors) const;
+
+      /*
+      * Pair energy of atom at a position, from an array of neighbors.
+      *
+      * The array may be a Verlet list or a cell list neighbor array. If
+      * moleculePtr is not null, pairs with a lower-id atom of that
+      * molecule are skipped, so that intramolecular pairs count once.
+      */
+      double 
+      neighborEnergy(const Atom& atom, const Vector& position, 
+                     Atom* const* neighborPtrs, int nNeighbor,
+                     const Molecule* moleculePtr) const;
+
    };
 
 }
@@ -196,6 +229,10 @@ namespace McMd
 
 #include <fstream>
 
+#ifdef UTIL_OPENMP
+#include <omp.h>
+#endif
+
 namespace McMd
 {
 
@@ -235,6 +272,13 @@ namespace McMd
       // Allocate memory for the CellList.
       cellList_.allocate(simulation().atomCapacity(), maxBoundary_, 
                          maxPairCutoff());
+
+      // Optional VerletList
+      readParamCompositeOptional(in, verletList_);
+      if (verletList_.isActive()) {
+         verletList_.allocate(simulation().atomCapacity(), maxBoundary_, 
+                              maxPairCutoff());
+      }
    }
 
    /*
@@ -257,6 +301,13 @@ namespace McMd
       // Allocate memory for the CellList.
       cellList_.allocate(simulation().atomCapacity(), maxBoundary_, 
                          maxPairCutoff());
+
+      // Optional VerletList
+      loadParamCompositeOptional(ar, verletList_);
+      if (verletList_.isActive()) {
+         verletList_.allocate(simulation().atomCapacity(), maxBoundary_, 
+                              maxPairCutoff());
+      }
    }
 
    /*
@@ -267,6 +318,7 @@ namespace McMd
    {
       interaction().save(ar);
       ar << maxBoundary_;
+      verletList_.saveOptional(ar);
    }
 
    /*
@@ -301,21 +353,80 @@ namespace McMd
    */
    template <class Interaction>
    double McPairPotentialImpl<Interaction>::atomEnergy(const Atom &atom) const
+   {  return positionEnergy(atom, atom.position(), neighbors_); }
+
+   /*
+   * Return nonbonded pair energies of one Atom at trial positions.
+   */
+   template <class Interaction>
+   void 
+   McPairPotentialImpl<Interaction>::trialEnergies(const Atom &atom, 
+                                                   const Vector* positions, 
+                                                   int nTrial, 
+                                                   double* energies) const
+   {
+      #ifdef UTIL_OPENMP
+      if (nThread() > 1 && nTrial > 1) {
+         #pragma omp parallel for num_threads(nThread()) schedule(static)
+         for (int i = 0; i < nTrial; ++i) {
+            energies[i] = positionEnergy(atom, positions[i], 
+                                   threadNeighbors_[omp_get_thread_num()]);
+         }
+         return;
+      }
+      #endif
+      for (int i = 0; i < nTrial; ++i) {
+         energies[i] = positionEnergy(atom, positions[i], neighbors_);
+      }
+   }
+
+   /*
+   * Return nonbonded pair energy of one Atom at a specified position.
+   */
+   template <class Interaction>
+   double 
+   McPairPotentialImpl<Interaction>::positionEnergy(const Atom &atom, 
+                                       const Vector& position,
+                                       CellList::NeighborArray& neighbors)
+   const
+   {
+      int id = atom.id();
+
+      // Use the Verlet list, if it is current for this position.
+      if (verletList_.isActive() && verletList_.isCurrent(atom, position)) {
+         return neighborEnergy(atom, position, verletList_.neighborPtrs(id),
+                               verletList_.nNeighbor(id), 0);
+      }
+
+      // Otherwise, get array of neighbors from the cell list
+      cellList_.getNeighbors(position, neighbors);
+      int nNeighbor = neighbors.size();
+      if (nNeighbor == 0) return 0.0;
+      return neighborEnergy(atom, position, &neighbors[0], nNeighbor, 0);
+   }
+
+   /*
+   * Return pair energy of one Atom at a position, from an array of neighbors.
+   */
+   template <class Interaction>
+   double 
+   McPairPotentialImpl<Interaction>::neighborEnergy(const Atom &atom, 
+                                        const Vector& position,
+                                        Atom* const* neighborPtrs,
+                                        int nNeighbor,
+                                        const Molecule* moleculePtr)
+   const
    {
-      Atom   *jAtomPtr;
+      const Atom* jAtomPtr;
       double  energy;
       double  rsq;
-      int     j, jId, nNeighbor;
+      int     j, jId;
       int     id = atom.id();
 
-      // Get array of neighbors
-      cellList_.getNeighbors(atom.position(), neighbors_);
-      nNeighbor = neighbors_.size();
-
       // Loop over neighboring atoms
       energy = 0.0;
       for (j = 0; j < nNeighbor; ++j) {
-         jAtomPtr = neighbors_[j];
+         jAtomPtr = neighborPtrs[j];
          jId      = jAtomPtr->id();
 
          // Check if atoms are the same
@@ -323,10 +434,14 @@ namespace McMd
 
             // Check if atoms are bonded
             if (!atom.mask().isMasked(*jAtomPtr)) {
-               rsq = boundary().
-                     distanceSq(atom.position(), jAtomPtr->position());
-               energy += interaction().
-                         energy(rsq, atom.typeId(), jAtomPtr->typeId());
+
+               // Count intramolecular pairs once, if required
+               if (moleculePtr == 0 || id < jId ||
+                   &jAtomPtr->molecule() != moleculePtr) {
+                  rsq = boundary().distanceSq(position, jAtomPtr->position());
+                  energy += interaction().
+                            energy(rsq, atom.typeId(), jAtomPtr->typeId());
+               }
             }
          }
       } 
@@ -340,39 +455,31 @@ namespace McMd
    double McPairPotentialImpl<Interaction>::moleculeEnergy(const Molecule &molecule) const
    {
       const Atom* iAtomPtr;
-      const Atom* jAtomPtr;
       double  energy;
-      double  rsq;
-      int     i, iId, j, jId, nNeighbor;
+      int     i, iId, nNeighbor;
+
+      // Use the Verlet list only if it is current for every atom, so 
+      // that intramolecular pairs are found from either side.
+      bool useVerlet = verletList_.isActive();
+      for (i = 0; useVerlet && i < molecule.nAtom(); ++i) { 
+         useVerlet = verletList_.isCurrent(molecule.atom(i));
+      }
 
       energy = 0.0;
       for (i = 0; i < molecule.nAtom(); ++i) { 
          iAtomPtr = &molecule.atom(i);
          iId      = iAtomPtr->id();
-
-         // Get array of neighbors
-         cellList_.getNeighbors(iAtomPtr->position(), neighbors_);
-         nNeighbor = neighbors_.size();
-   
-         // Loop over neighboring atoms
-         for (j = 0; j < nNeighbor; ++j) {
-            jAtomPtr = neighbors_[j];
-            jId      = jAtomPtr->id();
-   
-            // Check if atoms are the same
-            if (jId != iId) {
-   
-               // Check if atoms are bonded
-               if (!(iAtomPtr->mask().isMasked(*jAtomPtr))) {
-
-                  if ( (&iAtomPtr->molecule() != &jAtomPtr->molecule()) ||
-                       (iId < jId) ) {
-                     rsq = boundary().distanceSq(iAtomPtr->position(), 
-                                                 jAtomPtr->position());
-                     energy += interaction().energy(rsq, iAtomPtr->typeId(), 
-                                                           jAtomPtr->typeId());
-                  }
-               }
+         if (useVerlet) {
+            energy += neighborEnergy(*iAtomPtr, iAtomPtr->position(),
+                                     verletList_.neighborPtrs(iId),
+                                     verletList_.nNeighbor(iId), &molecule);
+         } else {
+            cellList_.getNeighbors(iAtomPtr->position(), neighbors_);
+            nNeighbor = neighbors_.size();
+            if (nNeighbor > 0) {
+               energy += neighborEnergy(*iAtomPtr, iAtomPtr->position(),
+                                        &neighbors_[0], nNeighbor, 
+                                        &molecule);
             }
          }
       } 
@@ -389,38 +496,31 @@ namespace McMd
       double energy;
       double  rsq;
       int    nNeighbor, nInCell;
-      int    i, j, iId, jId, ic;
+      int    i, j, ic;
 
       // Loop over cells
       energy = 0.0;
       for (ic=0; ic < cellList_.totCells(); ++ic) {
 
-         // Get array of neighbors
-         cellList_.getCellNeighbors(ic, neighbors_, nInCell);
+         // Get atoms in this cell and in neighboring cells with index > ic
+         cellList_.getHalfCellNeighbors(ic, neighbors_, nInCell);
          nNeighbor = neighbors_.size();
   
          // Loop over primary atoms in this cell
          for (i = 0; i < nInCell; ++i) {
             iAtomPtr = neighbors_[i];
-            iId      = iAtomPtr->id();
           
-            // Loop over secondary atoms in this and neighboring cells
-            for (j = 0; j < nNeighbor; ++j) {
+            // Loop over secondary atoms, each pair visited once
+            for (j = i + 1; j < nNeighbor; ++j) {
                jAtomPtr = neighbors_[j];
-               jId      = jAtomPtr->id();
      
-               // Count each pair only once 
-               if (jId > iId) {
-
-                  // Exclude masked pairs
-                  if (!iAtomPtr->mask().isMasked(*jAtomPtr)) {
-
-                     rsq = boundary().distanceSq(iAtomPtr->position(), 
-                                                 jAtomPtr->position());
-                     energy += interaction().energy(rsq, iAtomPtr->typeId(), 
-                                                  jAtomPtr->typeId());
-                  }
+               // Exclude masked pairs
+               if (!iAtomPtr->mask().isMasked(*jAtomPtr)) {
 
+                  rsq = boundary().distanceSq(iAtomPtr->position(), 
+                                              jAtomPtr->position());
+                  energy += interaction().energy(rsq, iAtomPtr->typeId(), 
+                                                 jAtomPtr->typeId());
                }
 
             } // secondary atoms
@@ -449,8 +549,8 @@ namespace McMd
       // Loop over cells
       for (int ic=0; ic < cellList_.totCells(); ++ic) {
 
-         // Get array of neighbors
-         cellList_.getCellNeighbors(ic, neighbors_, nInCell);
+         // Get atoms in this cell and in neighboring cells with index > ic
+         cellList_.getHalfCellNeighbors(ic, neighbors_, nInCell);
          nNeighbor = neighbors_.size();
   
          // Loop over primary atoms in this cell.
@@ -458,26 +558,20 @@ namespace McMd
             atom0Ptr = neighbors_[ia];
             type0 = atom0Ptr->typeId();
           
-            // Loop over secondary atoms in the neighboring cells.
-            for (ja = 0; ja < nNeighbor; ++ja) {
+            // Loop over secondary atoms, each pair visited once.
+            for (ja = ia + 1; ja < nNeighbor; ++ja) {
                atom1Ptr = neighbors_[ja];
                type1 = atom1Ptr->typeId();
      
-               // Count each pair only once.
-               if (atom1Ptr->id() > atom0Ptr->id()) {
-
-                  // Exclude masked pairs.
-                  if (!atom0Ptr->mask().isMasked(*atom1Ptr)) {
-                     rsq = boundary().distanceSq(atom0Ptr->position(),
-                                                 atom1Ptr->position(), dr);
-                     if (rsq < interaction().cutoffSq(type0, type1)) {
-                        force = dr;
-                        force *= interaction().forceOverR(rsq, type0, type1);
-                        incrementPairStress(force, dr, stress);
-                     }
-
+               // Exclude masked pairs.
+               if (!atom0Ptr->mask().isMasked(*atom1Ptr)) {
+                  rsq = boundary().distanceSq(atom0Ptr->position(),
+                                              atom1Ptr->position(), dr);
+                  if (rsq < interaction().cutoffSq(type0, type1)) {
+                     force = dr;
+                     force *= interaction().forceOverR(rsq, type0, type1);
+                     incrementPairStress(force, dr, stress);
                   }
-
                }
 
             } // secondary atoms
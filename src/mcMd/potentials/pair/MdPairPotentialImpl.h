@@ -168,8 +168,9 @@ namespace McMd
       */
       virtual void computeStress(Util::Tensor& stress) const;
 
-   protected:
-
+      /**
+      * Return reference to underlying pair interaction.
+      */
       Interaction& interaction() const
       {  return *interactionPtr_; }
 
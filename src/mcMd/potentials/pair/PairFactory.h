@@ -107,6 +107,76 @@ namespace McMd
       */
       MdPairPotential* tryMdSubfactories(McPairPotential& potential) const;
 
+      /**
+      * Create a tabulated or soft-core McPairPotential, if possible.
+      *
+      * Defined in PairFactoryTable.cpp, so that these instantiations
+      * are compiled in a separate translation unit.
+      *
+      * \param  className name of subclass
+      * \param  system    associated System
+      * \return base class pointer to new McPairPotential, or a null pointer.
+      */
+      McPairPotential* mcTableFactory(const std::string& className, System& system) const;
+
+      /**
+      * Create a tabulated or soft-core MdPairPotential, if possible.
+      *
+      * \param  className name of subclass
+      * \param  system    associated System
+      * \return base class pointer to new MdPairPotential, or a null pointer.
+      */
+      MdPairPotential* mdTableFactory(const std::string& className, System& system) const;
+
+      /**
+      * Convert a tabulated or soft-core McPairPotential, if possible.
+      *
+      * \param  potential McPairPotential to be cloned
+      * \return base class pointer to new MdPairPotential, or a null pointer.
+      */
+      MdPairPotential* mdTableFactory(McPairPotential& potential) const;
+
+      /**
+      * Create a TabulatedPair<...> McPairPotential, if possible.
+      *
+      * Defined in PairFactoryTabulated.cpp, and called by mcTableFactory.
+      *
+      * \param  className name of subclass
+      * \param  system    associated System
+      * \return base class pointer to new McPairPotential, or a null pointer.
+      */
+      McPairPotential* mcTabulatedFactory(const std::string& className, System& system) const;
+
+      /**
+      * Create a TabulatedPair<...> MdPairPotential, if possible.
+      *
+      * \param  className name of subclass
+      * \param  system    associated System
+      * \return base class pointer to new MdPairPotential, or a null pointer.
+      */
+      MdPairPotential* mdTabulatedFactory(const std::string& className, System& system) const;
+
+      /**
+      * Convert a TabulatedPair<...> McPairPotential, if possible.
+      *
+      * \param  potential McPairPotential to be cloned
+      * \return base class pointer to new MdPairPotential, or a null pointer.
+      */
+      MdPairPotential* mdTabulatedFactory(McPairPotential& potential) const;
+
+      #ifdef INTER_COULOMB
+      /**
+      * Create a CoulombPair<...> MdPairPotential, if possible.
+      *
+      * Defined in PairFactoryCoulomb.cpp.
+      *
+      * \param  className name of subclass
+      * \param  system    associated System
+      * \return base class pointer to new MdPairPotential, or a null pointer.
+      */
+      MdPairPotential* mdCoulombFactory(const std::string& className, System& system) const;
+      #endif
+
    private:
 
       /// Vector of pointers to child PairFactory objects.
@@ -0,0 +1,84 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/potentials/pair/PairFactory.h>
+
+#include <mcMd/mdSimulation/MdSystem.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/potentials/coulomb/CoulombPotential.h>
+
+// PairPotential interfaces and implementation classes
+#include <mcMd/potentials/pair/MdPairPotential.h>
+#include <mcMd/potentials/pair/MdPairPotentialImpl.h>
+
+// Pair Potential interaction classes
+#include <inter/pair/LJPair.h>
+#include <inter/pair/WcaPair.h>
+#include <inter/coulomb/CoulombPair.h>
+
+/*
+* CoulombPair<...> pair potentials are instantiated here, rather than in
+* PairFactory.cpp, for the same reason as in PairFactoryTable.cpp.
+*/
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Inter;
+
+   namespace {
+
+      /*
+      * Create an MdPairPotential with a real space Coulomb interaction.
+      *
+      * The Ewald parameters are copied from the CoulombPotential of the
+      * parent MdSystem, which must thus have been read before the pair
+      * potential. Coulomb interactions are not available in McSystem.
+      */
+      template <class BasePair>
+      MdPairPotential* newCoulombPair(System& system)
+      {
+         MdSystem* mdSystemPtr = dynamic_cast<MdSystem*>(&system);
+         if (mdSystemPtr == 0) {
+            UTIL_THROW("CoulombPair pair style requires an MdSystem");
+         }
+         if (!mdSystemPtr->hasCoulombPotential()) {
+            UTIL_THROW("CoulombPair pair style requires hasCoulomb");
+         }
+         MdPairPotentialImpl< CoulombPair<BasePair> >* ptr
+                 = new MdPairPotentialImpl< CoulombPair<BasePair> >(system);
+         const CoulombPotential& coulomb = mdSystemPtr->coulombPotential();
+         const Simulation& simulation = system.simulation();
+         CoulombPair<BasePair>& interaction = ptr->interaction();
+         interaction.setNAtomType(simulation.nAtomType());
+         interaction.setEwaldInteraction(coulomb.ewaldInteraction());
+         for (int i = 0; i < simulation.nAtomType(); ++i) {
+            interaction.setCharge(i, simulation.atomType(i).charge());
+         }
+         return ptr;
+      }
+
+   }
+
+   /*
+   * Return a pointer to a new CoulombPair<...> MdPairPotential.
+   */
+   MdPairPotential* 
+   PairFactory::mdCoulombFactory(const std::string& name, System& system) const
+   {
+      MdPairPotential* ptr = 0;
+      if (name == "CoulombPair<LJPair>") {
+         ptr = newCoulombPair<LJPair>(system);
+      } else
+      if (name == "CoulombPair<WcaPair>") {
+         ptr = newCoulombPair<WcaPair>(system);
+      }
+      return ptr;
+   }
+
+}
@@ -0,0 +1,98 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/potentials/pair/PairFactory.h>
+
+#include <mcMd/simulation/System.h>
+
+// PairPotential interfaces and implementation classes
+#include <mcMd/potentials/pair/MdPairPotential.h>
+#include <mcMd/potentials/pair/MdPairPotentialImpl.h>
+#include <mcMd/potentials/pair/McPairPotential.h>
+#include <mcMd/potentials/pair/McPairPotentialImpl.h>
+
+// Pair Potential interaction classes
+#include <inter/pair/TablePair.h>
+#include <inter/pair/SoftCoreLJPair.h>
+
+/*
+* Tabulated and soft-core pair potentials are instantiated here, rather
+* than in PairFactory.cpp, to keep the number of McPairPotentialImpl and 
+* MdPairPotentialImpl instantiations per translation unit small enough
+* for the compiler to inline the inner loop functions. TabulatedPair<...>
+* potentials are instantiated in PairFactoryTabulated.cpp.
+*/
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Inter;
+
+   /*
+   * Return a pointer to a new tabulated or soft-core McPairPotential.
+   */
+   McPairPotential* 
+   PairFactory::mcTableFactory(const std::string& name, System& system) const
+   {
+      McPairPotential* ptr = 0;
+      if (name == "TablePair") {
+         ptr = new McPairPotentialImpl<TablePair>(system);
+      } else
+      if (name == "SoftCoreLJPair") {
+         ptr = new McPairPotentialImpl<SoftCoreLJPair>(system);
+      }
+      if (ptr) return ptr;
+
+      // TabulatedPair<...> interactions
+      return mcTabulatedFactory(name, system);
+   }
+
+   /*
+   * Return a pointer to a new tabulated or soft-core MdPairPotential.
+   */
+   MdPairPotential* 
+   PairFactory::mdTableFactory(const std::string& name, System& system) const
+   {
+      MdPairPotential* ptr = 0;
+      if (name == "TablePair") {
+         ptr = new MdPairPotentialImpl<TablePair>(system);
+      } else
+      if (name == "SoftCoreLJPair") {
+         ptr = new MdPairPotentialImpl<SoftCoreLJPair>(system);
+      } 
+      if (ptr) return ptr;
+
+      // TabulatedPair<...> interactions
+      return mdTabulatedFactory(name, system);
+   }
+
+   /*
+   * Convert a tabulated or soft-core McPairPotential to an MdPairPotential.
+   */
+   MdPairPotential* 
+   PairFactory::mdTableFactory(McPairPotential& potential) const
+   {
+      std::string name = potential.interactionClassName();
+      MdPairPotential* ptr = 0;
+      if (name == "TablePair") {
+         McPairPotentialImpl<TablePair>* mcPtr 
+             = dynamic_cast< McPairPotentialImpl<TablePair>* >(&potential);
+         ptr = new MdPairPotentialImpl<TablePair>(*mcPtr);
+      } else
+      if (name == "SoftCoreLJPair") {
+         McPairPotentialImpl<SoftCoreLJPair>* mcPtr 
+             = dynamic_cast< McPairPotentialImpl<SoftCoreLJPair>* >(&potential);
+         ptr = new MdPairPotentialImpl<SoftCoreLJPair>(*mcPtr);
+      } 
+      if (ptr) return ptr;
+
+      // TabulatedPair<...> interactions
+      return mdTabulatedFactory(potential);
+   }
+
+}
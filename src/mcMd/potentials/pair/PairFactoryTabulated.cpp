@@ -0,0 +1,101 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/potentials/pair/PairFactory.h>
+
+#include <mcMd/simulation/System.h>
+
+// PairPotential interfaces and implementation classes
+#include <mcMd/potentials/pair/MdPairPotential.h>
+#include <mcMd/potentials/pair/MdPairPotentialImpl.h>
+#include <mcMd/potentials/pair/McPairPotential.h>
+#include <mcMd/potentials/pair/McPairPotentialImpl.h>
+
+// Pair Potential interaction classes
+#include <inter/pair/LJPair.h>
+#include <inter/pair/WcaPair.h>
+#include <inter/pair/DpdPair.h>
+#include <inter/pair/TabulatedPair.h>
+
+/*
+* TabulatedPair<...> pair potentials are instantiated here, rather than
+* in PairFactoryTable.cpp, for the same reason as in PairFactoryTable.cpp.
+*/
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Inter;
+
+   /*
+   * Return a pointer to a new TabulatedPair<...> McPairPotential.
+   */
+   McPairPotential*
+   PairFactory::mcTabulatedFactory(const std::string& name, System& system)
+   const
+   {
+      McPairPotential* ptr = 0;
+      if (name == "TabulatedPair<LJPair>") {
+         ptr = new McPairPotentialImpl< TabulatedPair<LJPair> >(system);
+      } else
+      if (name == "TabulatedPair<WcaPair>") {
+         ptr = new McPairPotentialImpl< TabulatedPair<WcaPair> >(system);
+      } else
+      if (name == "TabulatedPair<DpdPair>") {
+         ptr = new McPairPotentialImpl< TabulatedPair<DpdPair> >(system);
+      }
+      return ptr;
+   }
+
+   /*
+   * Return a pointer to a new TabulatedPair<...> MdPairPotential.
+   */
+   MdPairPotential*
+   PairFactory::mdTabulatedFactory(const std::string& name, System& system)
+   const
+   {
+      MdPairPotential* ptr = 0;
+      if (name == "TabulatedPair<LJPair>") {
+         ptr = new MdPairPotentialImpl< TabulatedPair<LJPair> >(system);
+      } else
+      if (name == "TabulatedPair<WcaPair>") {
+         ptr = new MdPairPotentialImpl< TabulatedPair<WcaPair> >(system);
+      } else
+      if (name == "TabulatedPair<DpdPair>") {
+         ptr = new MdPairPotentialImpl< TabulatedPair<DpdPair> >(system);
+      }
+      return ptr;
+   }
+
+   /*
+   * Convert a TabulatedPair<...> McPairPotential to an MdPairPotential.
+   */
+   MdPairPotential*
+   PairFactory::mdTabulatedFactory(McPairPotential& potential) const
+   {
+      std::string name = potential.interactionClassName();
+      MdPairPotential* ptr = 0;
+      if (name == "TabulatedPair<LJPair>") {
+         McPairPotentialImpl< TabulatedPair<LJPair> >* mcPtr
+             = dynamic_cast< McPairPotentialImpl< TabulatedPair<LJPair> >* >(&potential);
+         ptr = new MdPairPotentialImpl< TabulatedPair<LJPair> >(*mcPtr);
+      } else
+      if (name == "TabulatedPair<WcaPair>") {
+         McPairPotentialImpl< TabulatedPair<WcaPair> >* mcPtr
+             = dynamic_cast< McPairPotentialImpl< TabulatedPair<WcaPair> >* >(&potential);
+         ptr = new MdPairPotentialImpl< TabulatedPair<WcaPair> >(*mcPtr);
+      } else
+      if (name == "TabulatedPair<DpdPair>") {
+         McPairPotentialImpl< TabulatedPair<DpdPair> >* mcPtr
+             = dynamic_cast< McPairPotentialImpl< TabulatedPair<DpdPair> >* >(&potential);
+         ptr = new MdPairPotentialImpl< TabulatedPair<DpdPair> >(*mcPtr);
+      }
+      return ptr;
+   }
+
+}
@@ -1,7 +1,14 @@
 mcMd_potentials_pair_=\
     mcMd/potentials/pair/McPairPotential.cpp \
     mcMd/potentials/pair/MdPairPotential.cpp \
-    mcMd/potentials/pair/PairFactory.cpp
+    mcMd/potentials/pair/PairFactory.cpp \
+    mcMd/potentials/pair/PairFactoryTable.cpp \
+    mcMd/potentials/pair/PairFactoryTabulated.cpp
+
+ifdef INTER_COULOMB
+mcMd_potentials_pair_+=\
+    mcMd/potentials/pair/PairFactoryCoulomb.cpp
+endif
 
 mcMd_potentials_pair_SRCS=\
      $(addprefix $(SRC_DIR)/, $(mcMd_potentials_pair_))
@@ -69,4 +69,11 @@ namespace McMd
    * \brief    External one-body potentials.
    */
 
+   /**
+   * \defgroup McMd_Coulomb_Module Coulomb Potentials
+   * \ingroup McMd_Potential_Module
+   *
+   * \brief    Classes that represent long range Coulomb potentials.
+   */
+
 }
@@ -31,6 +31,11 @@ include $(SRC_DIR)/mcMd/potentials/external/sources.mk
 mcMd_potentials_+=$(mcMd_potentials_external_) 
 endif
 
+ifdef INTER_COULOMB
+include $(SRC_DIR)/mcMd/potentials/coulomb/sources.mk
+mcMd_potentials_+=$(mcMd_potentials_coulomb_) 
+endif
+
 mcMd_potentials_SRCS=\
      $(addprefix $(SRC_DIR)/, $(mcMd_potentials_))
 mcMd_potentials_OBJS=\
@@ -51,6 +51,9 @@ namespace McMd
       #ifdef INTER_EXTERNAL
       hasExternal_(-1),
       #endif
+      #ifdef INTER_COULOMB
+      hasCoulomb_(-1),
+      #endif
       #ifdef MCMD_LINK
       nLinkType_(-1),
       #endif
@@ -114,6 +117,9 @@ namespace McMd
       #ifdef INTER_EXTERNAL
       hasExternal_(-1),
       #endif
+      #ifdef INTER_COULOMB
+      hasCoulomb_(-1),
+      #endif
       #ifdef MCMD_LINK
       nLinkType_(-1),
       #endif
@@ -219,6 +225,14 @@ namespace McMd
          UTIL_THROW("hasExternal must be >= 0");
       }
       #endif
+      #ifdef INTER_COULOMB
+      hasCoulomb_ = 0; // Default value 
+      readOptional<int>(in, "hasCoulomb", hasCoulomb_); 
+      if (hasCoulomb_ < 0) {
+         UTIL_THROW("hasCoulomb must be >= 0");
+      }
+      AtomType::setHasCharge(hasCoulomb_);
+      #endif
       #ifdef MCMD_LINK
       nLinkType_ = 0; // Default value
       readOptional<int>(in, "nLinkType", nLinkType_); 
@@ -241,6 +255,12 @@ namespace McMd
       readDArray<AtomType>(in, "atomTypes", atomTypes_, nAtomType_);
 
       read<MaskPolicy>(in, "maskedPairPolicy", maskedPairPolicy_);
+      #ifdef INTER_COULOMB
+      // The k-space sum includes all pairs, so no pairs may be masked.
+      if (hasCoulomb_ && maskedPairPolicy_ != MaskNone) {
+         UTIL_THROW("hasCoulomb requires maskedPairPolicy = MaskNone");
+      }
+      #endif
 
       readParamComposite(in, *speciesManagerPtr_);
       for (int iSpecies = 0; iSpecies < nSpecies(); ++iSpecies) {
@@ -277,6 +297,11 @@ namespace McMd
       hasExternal_ = false;
       loadParameter<int>(ar, "hasExternal", hasExternal_, false);
       #endif
+      #ifdef INTER_COULOMB
+      hasCoulomb_ = 0;
+      loadParameter<int>(ar, "hasCoulomb", hasCoulomb_, false);
+      AtomType::setHasCharge(hasCoulomb_);
+      #endif
       #ifdef MCMD_LINK
       nLinkType_ = 0;
       loadParameter<int>(ar, "nLinkType", nLinkType_, false);
@@ -323,6 +348,9 @@ namespace McMd
       #ifdef INTER_EXTERNAL
       Parameter::saveOptional(ar, hasExternal_, hasExternal_);
       #endif
+      #ifdef INTER_COULOMB
+      Parameter::saveOptional(ar, hasCoulomb_, (bool)hasCoulomb_);
+      #endif
       #ifdef MCMD_LINK
       Parameter::saveOptional(ar, nLinkType_, (bool)nLinkType_);
       #endif
@@ -264,6 +264,13 @@ namespace McMd
       int hasExternal() const;
       #endif
 
+      #ifdef INTER_COULOMB
+      /**
+      * Does a Coulomb potential exist?
+      */
+      int hasCoulomb() const;
+      #endif
+
       #ifdef MCMD_LINK
       /**
       * Get the number of link types.
@@ -573,6 +580,11 @@ namespace McMd
       int hasExternal_;
       #endif
 
+      #ifdef INTER_COULOMB
+      /// Does a Coulomb potential exist? (0 false or 1 true)
+      int hasCoulomb_;
+      #endif
+
       #ifdef MCMD_LINK
       /// Number of link types.
       int nLinkType_;
@@ -710,6 +722,11 @@ namespace McMd
    {  return hasExternal_; }
    #endif
 
+   #ifdef INTER_COULOMB
+   inline int Simulation::hasCoulomb() const
+   {  return hasCoulomb_; }
+   #endif
+
    #ifdef MCMD_LINK
    inline int Simulation::nLinkType() const
    {  return nLinkType_; }
@@ -33,6 +33,9 @@
 #ifdef INTER_EXTERNAL
 #include <mcMd/potentials/external/ExternalFactory.h>
 #endif
+#ifdef INTER_COULOMB
+#include <mcMd/potentials/coulomb/CoulombFactory.h>
+#endif
 #ifdef MCMD_LINK
 #include <mcMd/potentials/link/LinkFactory.h>
 #include <mcMd/links/LinkMaster.h>
@@ -93,6 +96,9 @@ namespace McMd
       #ifdef INTER_EXTERNAL
       externalFactoryPtr_(0),
       #endif
+      #ifdef INTER_COULOMB
+      coulombFactoryPtr_(0),
+      #endif
       #ifdef MCMD_LINK
       linkFactoryPtr_(0),
       #endif
@@ -126,6 +132,9 @@ namespace McMd
       #ifdef INTER_EXTERNAL
       externalStyle_(),
       #endif
+      #ifdef INTER_COULOMB
+      coulombStyle_(),
+      #endif
       #ifdef MCMD_LINK
       linkStyle_(),
       #endif
@@ -180,6 +189,9 @@ namespace McMd
       #ifdef INTER_EXTERNAL
       externalFactoryPtr_(other.externalFactoryPtr_),
       #endif
+      #ifdef INTER_COULOMB
+      coulombFactoryPtr_(other.coulombFactoryPtr_),
+      #endif
       #ifdef MCMD_LINK
       linkFactoryPtr_(other.linkFactoryPtr_),
       #endif
@@ -213,6 +225,9 @@ namespace McMd
       #ifdef INTER_EXTERNAL
       externalStyle_(other.externalStyle_),
       #endif
+      #ifdef INTER_COULOMB
+      coulombStyle_(other.coulombStyle_),
+      #endif
       #ifdef MCMD_LINK
       linkStyle_(other.linkStyle_),
       #endif
@@ -268,6 +283,11 @@ namespace McMd
             delete externalFactoryPtr_;
          }
          #endif
+         #ifdef INTER_COULOMB
+         if (coulombFactoryPtr_) {
+            delete coulombFactoryPtr_;
+         }
+         #endif
          #ifdef MCMD_LINK
          if (linkMasterPtr_) {
             delete linkMasterPtr_;
@@ -450,6 +470,11 @@ namespace McMd
          read<std::string>(in, "externalStyle", externalStyle_);
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (simulation().hasCoulomb()) {
+         read<std::string>(in, "coulombStyle", coulombStyle_);
+      }
+      #endif
       #ifdef MCMD_LINK
       if (simulation().nLinkType() > 0) {
          read<std::string>(in, "linkStyle", linkStyle_);
@@ -490,6 +515,11 @@ namespace McMd
          loadParameter<std::string>(ar, "externalStyle", externalStyle_);
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (simulation().hasCoulomb()) {
+         loadParameter<std::string>(ar, "coulombStyle", coulombStyle_);
+      }
+      #endif
       #ifdef MCMD_LINK
       if (simulation().nLinkType() > 0) {
          loadParameter<std::string>(ar, "linkStyle", linkStyle_);
@@ -530,6 +560,11 @@ namespace McMd
          ar << externalStyle_;
       }
       #endif
+      #ifdef INTER_COULOMB
+      if (simulation().hasCoulomb()) {
+         ar << coulombStyle_;
+      }
+      #endif
       #ifdef MCMD_LINK
       if (simulation().nLinkType() > 0) {
          ar << linkStyle_;
@@ -1190,6 +1225,26 @@ namespace McMd
    {  return externalStyle_;  }
    #endif
 
+   #ifdef INTER_COULOMB
+   /*
+   * Return the CoulombFactory by reference.
+   */
+   Factory<CoulombPotential>& System::coulombFactory()
+   {
+      if (coulombFactoryPtr_ == 0) {
+         coulombFactoryPtr_ = new CoulombFactory(*this);
+      }
+      assert(coulombFactoryPtr_);
+      return *coulombFactoryPtr_;
+   }
+
+   /*
+   * Get the Coulomb style string.
+   */
+   std::string System::coulombStyle() const
+   {  return coulombStyle_;  }
+   #endif
+
    #ifdef MCMD_LINK
    /*
    * Return the Link factory by reference.
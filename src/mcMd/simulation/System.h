@@ -68,6 +68,9 @@ namespace McMd
    #ifdef INTER_EXTERNAL
    class ExternalPotential;
    #endif
+   #ifdef INTER_COULOMB
+   class CoulombPotential;
+   #endif
    #ifdef MCMD_LINK
    class LinkPotential;
    class LinkMaster;
@@ -454,6 +457,18 @@ namespace McMd
       std::string externalStyle() const;
       #endif
 
+      #ifdef INTER_COULOMB
+      /**
+      * Get the associated CoulombPotential factory by reference.
+      */
+      Factory<CoulombPotential>& coulombFactory();
+
+      /**
+      * Return Coulomb (k-space) potential style string.
+      */
+      std::string coulombStyle() const;
+      #endif
+
       #ifdef MCMD_LINK
       /**
       * Get the associated Link factory by reference.
@@ -836,6 +851,11 @@ namespace McMd
       /// Pointer to ExternalPotential factory
       Factory<ExternalPotential>* externalFactoryPtr_;
       #endif
+
+      #ifdef INTER_COULOMB
+      /// Pointer to CoulombPotential factory
+      Factory<CoulombPotential>* coulombFactoryPtr_;
+      #endif
   
       #ifdef MCMD_LINK
       /// Pointer to Link Factory
@@ -900,6 +920,11 @@ namespace McMd
       std::string externalStyle_;
       #endif
 
+      #ifdef INTER_COULOMB
+      /// Name of Coulomb (k-space) potential style.
+      std::string coulombStyle_;
+      #endif
+
       #ifdef MCMD_LINK
       /// Name of link potential style.
       std::string linkStyle_;
@@ -10,6 +10,8 @@
 #include "simulation/SimulationTestComposite.h"
 #include "mcSimulation/McSimulationTest.h"
 #include "mdSimulation/MdSimulationTest.h"
+#include "mcSimulation/AnalyzerManagerTest.h"
+#include "perturb/ReplicaMoveTest.h"
 
 // Define a class McMdNsTestComposite
 TEST_COMPOSITE_BEGIN(McMdNsTestComposite)
@@ -19,6 +21,12 @@ addChild(new NeighborTestComposite, "neighbor/");
 addChild(new SimulationTestComposite, "simulation/");
 addChild(new TEST_RUNNER(McSimulationTest), "mcSimulation/");
 addChild(new TEST_RUNNER(MdSimulationTest), "mdSimulation/");
+addChild(new TEST_RUNNER(AnalyzerManagerTest), "mcSimulation/");
+#ifdef MCMD_PERTURB
+#ifdef UTIL_MPI
+addChild(new TEST_RUNNER(ReplicaMoveTest), "perturb/");
+#endif
+#endif
 TEST_COMPOSITE_END
 
 int main(int argc, char* argv[])
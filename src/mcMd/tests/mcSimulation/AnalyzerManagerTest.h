@@ -0,0 +1,245 @@
+#ifndef MCMD_ANALYZER_MANAGER_TEST_H
+#define MCMD_ANALYZER_MANAGER_TEST_H
+
+#include <mcMd/mcSimulation/McSimulation.h>
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/mcSimulation/McAnalyzerManager.h>
+#include <mcMd/analyzers/Analyzer.h>
+#include <mcMd/analyzers/SystemSnapshot.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+
+#include <test/ParamFileTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <sstream>
+#include <cmath>
+#include <stdexcept>
+#ifdef UTIL_CXX11
+#include <thread>
+#include <chrono>
+#endif
+
+using namespace Util;
+using namespace McMd;
+
+/*
+* Snapshot analyzer that checks the order and content of snapshots.
+*
+* The test sets the x coordinate of the first atom to the step index
+* times dx before each call to AnalyzerManager::sample(). The analyzer
+* is slower than the main loop, so that sample() must wait for free
+* snapshots.
+*/
+class SnapshotCheckAnalyzer : public Analyzer
+{
+
+public:
+
+   static const double dx;
+
+   SnapshotCheckAnalyzer()
+    : lastStep(-1),
+      errorStep(-1),
+      nSample(0),
+      isOk(true),
+      isStdError(false)
+   {  setClassName("SnapshotCheckAnalyzer"); }
+
+   virtual void readParameters(std::istream& in)
+   {  readInterval(in); }
+
+   virtual void sample(long iStep)
+   {  UTIL_THROW("sample() called for a snapshot analyzer"); }
+
+   virtual void sampleSnapshot(const SystemSnapshot& snapshot)
+   {
+      #ifdef UTIL_CXX11
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      #endif
+      long iStep = snapshot.iStep();
+      if (iStep <= lastStep) isOk = false;
+      if (fabs(snapshot.position(0)[0] - dx*double(iStep)) > 1.0E-10) {
+         isOk = false;
+      }
+      lastStep = iStep;
+      ++nSample;
+      if (iStep == errorStep) {
+         if (isStdError) {
+            throw std::runtime_error("Planned std::exception");
+         } else {
+            UTIL_THROW("Planned Exception");
+         }
+      }
+   }
+
+   virtual bool isSnapshotAnalyzer() const
+   {  return true; }
+
+   long lastStep;
+   long errorStep;
+   int  nSample;
+   bool isOk;
+   bool isStdError;
+
+};
+
+const double SnapshotCheckAnalyzer::dx = 0.001;
+
+class AnalyzerManagerTest : public ParamFileTest
+{
+
+public:
+
+   AnalyzerManagerTest()
+    : ParamFileTest(),
+      system_(simulation_.system()),
+      managerPtr_(0),
+      analyzerPtr_(0)
+   {}
+
+   virtual void setUp()
+   {
+      simulation_.fileMaster().setRootPrefix(filePrefix());
+      openFile("in/McSimulation");
+      simulation_.readParam(file());
+      file().close();
+      openFile("in/config");
+      system_.readConfig(file());
+      file().close();
+   }
+
+   virtual void tearDown()
+   {
+      if (managerPtr_) {
+         delete managerPtr_;
+         managerPtr_ = 0;
+      }
+   }
+
+   void testRing();
+   void testError();
+   void testStdError();
+   void testSynchronous();
+
+private:
+
+   McSimulation simulation_;
+   McSystem& system_;
+   McAnalyzerManager* managerPtr_;
+   SnapshotCheckAnalyzer* analyzerPtr_;
+
+   /*
+   * Create a manager with a single SnapshotCheckAnalyzer.
+   */
+   void makeManager(int nSnapshot)
+   {
+      std::stringstream in;
+      in << "AnalyzerManager{" << std::endl
+         << "  nSnapshot  " << nSnapshot << std::endl
+         << "  baseInterval  1" << std::endl << std::endl
+         << "}" << std::endl;
+      managerPtr_ = new McAnalyzerManager(simulation_, system_);
+      managerPtr_->readParam(in);
+
+      std::stringstream analyzerIn;
+      analyzerIn << "SnapshotCheckAnalyzer{" << std::endl
+                 << "  interval  1" << std::endl
+                 << "}" << std::endl;
+      analyzerPtr_ = new SnapshotCheckAnalyzer;
+      analyzerPtr_->readParam(analyzerIn);
+      managerPtr_->append(*analyzerPtr_, "SnapshotCheckAnalyzer");
+   }
+
+   /*
+   * Move the first atom and call sample, for nStep steps.
+   */
+   void run(int nStep)
+   {
+      System::MoleculeIterator molIter;
+      system_.begin(0, molIter);
+      Vector& position = molIter->atom(0).position();
+      for (int iStep = 0; iStep < nStep; ++iStep) {
+         position[0] = SnapshotCheckAnalyzer::dx*double(iStep);
+         managerPtr_->sample(iStep);
+      }
+   }
+
+};
+
+void AnalyzerManagerTest::testRing()
+{
+   printMethod(TEST_FUNC);
+   makeManager(3);
+   TEST_ASSERT(managerPtr_->nSnapshot() == 3);
+
+   run(40);
+   managerPtr_->wait();
+   TEST_ASSERT(analyzerPtr_->nSample == 40);
+   TEST_ASSERT(analyzerPtr_->lastStep == 39);
+   TEST_ASSERT(analyzerPtr_->isOk);
+}
+
+void AnalyzerManagerTest::testError()
+{
+   printMethod(TEST_FUNC);
+   makeManager(3);
+   analyzerPtr_->errorStep = 19;
+
+   bool thrown = false;
+   try {
+      run(20);
+   } catch (Exception& e) {
+      thrown = true;
+   }
+   try {
+      managerPtr_->wait();
+   } catch (Exception& e) {
+      thrown = true;
+   }
+   TEST_ASSERT(thrown);
+   TEST_ASSERT(analyzerPtr_->nSample == 20);
+   TEST_ASSERT(analyzerPtr_->isOk);
+
+   // The error is reported only once
+   managerPtr_->wait();
+}
+
+void AnalyzerManagerTest::testStdError()
+{
+   printMethod(TEST_FUNC);
+   makeManager(3);
+   analyzerPtr_->errorStep = 5;
+   analyzerPtr_->isStdError = true;
+
+   bool thrown = false;
+   try {
+      run(20);
+      managerPtr_->wait();
+   } catch (Exception& e) {
+      thrown = true;
+   } catch (std::exception& e) {
+      thrown = true;
+   }
+   TEST_ASSERT(thrown);
+}
+
+void AnalyzerManagerTest::testSynchronous()
+{
+   printMethod(TEST_FUNC);
+   makeManager(0);
+   TEST_ASSERT(managerPtr_->nSnapshot() == 0);
+
+   run(10);
+   TEST_ASSERT(analyzerPtr_->nSample == 10);
+   TEST_ASSERT(analyzerPtr_->isOk);
+}
+
+TEST_BEGIN(AnalyzerManagerTest)
+TEST_ADD(AnalyzerManagerTest, testRing)
+TEST_ADD(AnalyzerManagerTest, testError)
+TEST_ADD(AnalyzerManagerTest, testStdError)
+TEST_ADD(AnalyzerManagerTest, testSynchronous)
+TEST_END(AnalyzerManagerTest)
+
+#endif
@@ -4,6 +4,7 @@
 #include <mcMd/mcSimulation/McSimulation.h>
 #include <mcMd/mcSimulation/McSystem.h>
 #include <mcMd/mdSimulation/MdSystem.h>
+#include <mcMd/mcMoves/common/HybridMdMove.h>
 #include <mcMd/species/Species.h>
 #include <mcMd/chemistry/Molecule.h>
 #include <mcMd/chemistry/Atom.h>
@@ -23,6 +24,7 @@
 
 #include <string>
 #include <fstream>
+#include <cmath>
 
 using namespace Util;
 using namespace McMd;
@@ -39,12 +41,17 @@ public:
    void testReadParamBond();
    void testReadConfigBond();
    void testPairEnergy();
+   void testTrialEnergies();
    void testBondEnergy();
    void testActivate();
    void testMdSystemCopy();
    void testSimulateBond();
    void testWriteRestartBond();
    void testReadRestart();
+   void testHybridMdMoveReject();
+   void testHybridMdMoveBoundary();
+   void testHybridMdMoveTypeId();
+   void testHybridMdMoveParameter();
 
    #ifdef INTER_ANGLE
    void testReadParamAngle();
@@ -60,6 +67,7 @@ private:
    // Utility functions
    void readParam(const char* filename);
    void readConfig(const char* filename);
+   void readMove(const char* filename, McMove& move);
 
 };
 
@@ -90,6 +98,14 @@ void McSimulationTest::readConfig(const char* filename)
    file().close();
 }
 
+void McSimulationTest::readMove(const char* filename, McMove& move)
+{  
+   std::ifstream moveFile;
+   openInputFile(filename, moveFile); 
+   move.readParam(moveFile);
+   moveFile.close();
+}
+
 // Test methods
 
 void McSimulationTest::testReadParamBond()
@@ -169,6 +185,47 @@ void McSimulationTest::testPairEnergy()
    TEST_ASSERT(eq(0.5*energy, total));
 }
 
+void McSimulationTest::testTrialEnergies()
+{ 
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulation"); 
+   readConfig("in/config");
+
+   McPairPotential& potential = system_.pairPotential();
+   Random& random = simulation_.random();
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   const int nTrial = 7;
+   Vector positions[nTrial];
+   double energies[nTrial];
+   Vector oldPos, dr;
+   double energy;
+   int i, j;
+   for (int is=0; is < simulation_.nSpecies(); ++is) {
+      for (system_.begin(is, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            oldPos = atomIter->position();
+            for (i = 0; i < nTrial; ++i) {
+               for (j = 0; j < Dimension; ++j) {
+                  dr[j] = random.uniform(-0.5, 0.5);
+               }
+               positions[i].add(oldPos, dr);
+               system_.boundary().shift(positions[i]);
+            }
+            potential.trialEnergies(*atomIter, positions, nTrial, energies);
+            TEST_ASSERT(atomIter->position() == oldPos);
+            for (i = 0; i < nTrial; ++i) {
+               atomIter->position() = positions[i];
+               energy = potential.atomEnergy(*atomIter);
+               TEST_ASSERT(eq(energy, energies[i]));
+            }
+            atomIter->position() = oldPos;
+         }
+      }
+   }
+}
+
 void McSimulationTest::testBondEnergy()
 { 
    printMethod(TEST_FUNC);
@@ -395,16 +452,148 @@ void McSimulationTest::testReadRestart()
    simulation_.save(baseFileName);
 }
 
+void McSimulationTest::testHybridMdMoveReject()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulationHybrid"); 
+   readConfig("in/md.config"); 
+
+   HybridMdMove move(system_);
+   readMove("in/HybridMdMove", move);
+   move.setup();
+
+   // After an accepted or a rejected attempt, the cached energy must be
+   // that of the current (new or restored) configuration.
+   int nAccept = 0;
+   int nReject = 0;
+   for (int i = 0; i < 40; ++i) {
+      if (move.move()) {
+         ++nAccept;
+      } else {
+         ++nReject;
+      }
+      TEST_ASSERT(std::fabs(move.cachedPotential() 
+                            - system_.potentialEnergy()) < 1.0E-8);
+   }
+   TEST_ASSERT(nAccept > 0);
+   TEST_ASSERT(nReject > 0);
+}
+
+void McSimulationTest::testHybridMdMoveBoundary()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulationHybrid"); 
+   readConfig("in/md.config"); 
+
+   // With nStep = 0, an attempt is accepted iff the cached energy 
+   // of the initial configuration is correct.
+   HybridMdMove move(system_);
+   readMove("in/HybridMdMoveStatic", move);
+   move.setup();
+   TEST_ASSERT(move.move());
+   double oldEnergy = system_.potentialEnergy();
+   TEST_ASSERT(std::fabs(move.cachedPotential() - oldEnergy) < 1.0E-8);
+
+   // Enlarge the boundary without moving any atom, stretching bonds
+   // that cross the boundary.
+   Vector lengths = system_.boundary().lengths();
+   lengths[2] = 4.5;
+   system_.boundary().setOrthorhombic(lengths);
+   system_.pairPotential().buildCellList();
+   double newEnergy = system_.potentialEnergy();
+   TEST_ASSERT(newEnergy > oldEnergy + 1.0);
+
+   // Reuse of the stale energy would cause the attempt to be rejected
+   TEST_ASSERT(move.move());
+   TEST_ASSERT(std::fabs(move.cachedPotential() - newEnergy) < 1.0E-8);
+}
+
+void McSimulationTest::testHybridMdMoveTypeId()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulationHybrid"); 
+   readConfig("in/md.config"); 
+
+   HybridMdMove move(system_);
+   readMove("in/HybridMdMoveStatic", move);
+   move.setup();
+   TEST_ASSERT(move.move());
+   double oldEnergy = system_.potentialEnergy();
+   TEST_ASSERT(std::fabs(move.cachedPotential() - oldEnergy) < 1.0E-8);
+
+   // Change the type of one atom, so as to increase the pair energy.
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   double newEnergy = oldEnergy;
+   int typeId;
+   bool found = false;
+   for (int is=0; is < simulation_.nSpecies() && !found; ++is) {
+      system_.begin(is, molIter);
+      for ( ; molIter.notEnd() && !found; ++molIter) {
+         molIter->begin(atomIter);
+         for ( ; atomIter.notEnd() && !found; ++atomIter) {
+            typeId = atomIter->typeId();
+            atomIter->setTypeId(1 - typeId);
+            newEnergy = system_.potentialEnergy();
+            if (newEnergy > oldEnergy + 0.1) {
+               found = true;
+            } else {
+               atomIter->setTypeId(typeId);
+            }
+         }
+      }
+   }
+   TEST_ASSERT(found);
+
+   // Reuse of the stale energy would cause the attempt to be rejected
+   TEST_ASSERT(move.move());
+   TEST_ASSERT(std::fabs(move.cachedPotential() - newEnergy) < 1.0E-8);
+}
+
+void McSimulationTest::testHybridMdMoveParameter()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulationHybrid"); 
+   readConfig("in/md.config"); 
+
+   HybridMdMove move(system_);
+   readMove("in/HybridMdMoveStatic", move);
+   move.setup();
+   TEST_ASSERT(move.move());
+   double oldEnergy = system_.potentialEnergy();
+   TEST_ASSERT(std::fabs(move.cachedPotential() - oldEnergy) < 1.0E-8);
+
+   // Modify a pair parameter without moving any atom, as done by a 
+   // SET_PAIR command. The following run calls setup().
+   system_.pairPotential().set("epsilon", 0, 0, 3.0);
+   double newEnergy = system_.potentialEnergy();
+   TEST_ASSERT(newEnergy > oldEnergy + 0.1);
+   move.setup();
+
+   // Reuse of the stale energy would cause the attempt to be rejected
+   TEST_ASSERT(move.move());
+   TEST_ASSERT(std::fabs(move.cachedPotential() - newEnergy) < 1.0E-8);
+}
+
 TEST_BEGIN(McSimulationTest)
 TEST_ADD(McSimulationTest, testReadParamBond)
 TEST_ADD(McSimulationTest, testReadConfigBond)
 TEST_ADD(McSimulationTest, testPairEnergy)
+TEST_ADD(McSimulationTest, testTrialEnergies)
 TEST_ADD(McSimulationTest, testBondEnergy)
 TEST_ADD(McSimulationTest, testActivate)
 TEST_ADD(McSimulationTest, testMdSystemCopy)
 TEST_ADD(McSimulationTest, testSimulateBond)
 TEST_ADD(McSimulationTest, testWriteRestartBond)
 //TEST_ADD(McSimulationTest, testReadRestart)
+TEST_ADD(McSimulationTest, testHybridMdMoveReject)
+TEST_ADD(McSimulationTest, testHybridMdMoveBoundary)
+TEST_ADD(McSimulationTest, testHybridMdMoveTypeId)
+TEST_ADD(McSimulationTest, testHybridMdMoveParameter)
 #ifdef INTER_ANGLE
 TEST_ADD(McSimulationTest, testReadParamAngle)
 TEST_ADD(McSimulationTest, testAngleEnergy)
@@ -4,12 +4,16 @@
 #include <mcMd/mdSimulation/MdSimulation.h>
 #include <mcMd/mdSimulation/MdSystem.h>
 #include <mcMd/mdIntegrators/MdIntegrator.h>
+#include <mcMd/mdIntegrators/NveRespaIntegrator.h>
 #include <mcMd/potentials/pair/MdPairPotential.h>
 #include <mcMd/potentials/bond/BondPotential.h>
 #include <mcMd/species/Species.h>
 #include <mcMd/chemistry/Molecule.h>
 #include <mcMd/chemistry/Atom.h>
 
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+
 #include <test/UnitTestRunner.h>
 #include <test/UnitTest.h>
 
@@ -37,12 +41,18 @@ public:
    void testSimulate();
    void testWriteRestart();
    void testReadRestart();
+   void testRespaSingleInnerStep();
+   void testRespaEnergyDrift();
 
 private:
 
    MdSimulation simulation_;
    MdSystem&    system_;
 
+   void getState(DArray<Vector>& positions, DArray<Vector>& velocities);
+   void setState(const DArray<Vector>& positions, 
+                 const DArray<Vector>& velocities);
+
 };
 
 
@@ -57,6 +67,42 @@ void MdSimulationTest::setUp()
    //setVerbose(2);
 }
 
+/*
+* Copy all atomic positions and velocities, indexed by atom id.
+*/
+void MdSimulationTest::getState(DArray<Vector>& positions, 
+                                DArray<Vector>& velocities)
+{
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   for (int iSpec = 0; iSpec < simulation_.nSpecies(); ++iSpec) {
+      for (system_.begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            positions[atomIter->id()] = atomIter->position();
+            velocities[atomIter->id()] = atomIter->velocity();
+         }
+      }
+   }
+}
+
+/*
+* Set all atomic positions and velocities, indexed by atom id.
+*/
+void MdSimulationTest::setState(const DArray<Vector>& positions, 
+                                const DArray<Vector>& velocities)
+{
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   for (int iSpec = 0; iSpec < simulation_.nSpecies(); ++iSpec) {
+      for (system_.begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            atomIter->position() = positions[atomIter->id()];
+            atomIter->velocity() = velocities[atomIter->id()];
+         }
+      }
+   }
+}
+
 void MdSimulationTest::testReadParam()
 {
    printMethod(TEST_FUNC);
@@ -353,6 +399,110 @@ void MdSimulationTest::testReadRestart()
    configFile.close();
 }
 
+void MdSimulationTest::testRespaSingleInnerStep()
+{
+   printMethod(TEST_FUNC);
+   std::cout << std::endl;
+
+   std::ifstream paramFile;
+   openInputFile("in/MdSimulation", paramFile); 
+   simulation_.readParam(paramFile);
+   paramFile.close();
+   simulation_.readCommands();
+
+   // Only one MdSimulation may exist at a time (Atom arrays are static),
+   // so both integrators act on system_, from the same initial state.
+   NveRespaIntegrator respa(system_);
+   openInputFile("in/NveRespaIntegrator", paramFile); 
+   respa.readParam(paramFile);
+   paramFile.close();
+   TEST_ASSERT(respa.nInner() == 1);
+
+   int capacity = simulation_.atomCapacity();
+   DArray<Vector> positions, velocities;
+   DArray<Vector> vvPositions, vvVelocities;
+   positions.allocate(capacity);
+   velocities.allocate(capacity);
+   vvPositions.allocate(capacity);
+   vvVelocities.allocate(capacity);
+   for (int id = 0; id < capacity; ++id) {
+      positions[id].zero();
+      velocities[id].zero();
+      vvPositions[id].zero();
+      vvVelocities[id].zero();
+   }
+   getState(positions, velocities);
+
+   // Reference trajectory, with NveVvIntegrator
+   int nStep = 200;
+   system_.pairPotential().buildPairList();
+   system_.calculateForces();
+   system_.mdIntegrator().setup();
+   for (int i = 0; i < nStep; ++i) {
+      system_.mdIntegrator().step();
+   }
+   getState(vvPositions, vvVelocities);
+
+   // Trajectory from the same state, with NveRespaIntegrator
+   setState(positions, velocities);
+   system_.pairPotential().buildPairList();
+   system_.calculateForces();
+   respa.setup();
+   for (int i = 0; i < nStep; ++i) {
+      respa.step();
+   }
+   getState(positions, velocities);
+
+   // Same trajectory, to within round-off error
+   for (int id = 0; id < capacity; ++id) {
+      for (int i = 0; i < Dimension; ++i) {
+         TEST_ASSERT(eq(positions[id][i], vvPositions[id][i]));
+         TEST_ASSERT(eq(velocities[id][i], vvVelocities[id][i]));
+      }
+   }
+}
+
+void MdSimulationTest::testRespaEnergyDrift()
+{
+   printMethod(TEST_FUNC);
+   std::cout << std::endl;
+
+   // NveRespaIntegrator with dt = 0.004 and nInner = 4, for 8-bead
+   // chains with very stiff bonds (kappa = 2000). With NveVvIntegrator
+   // and the same dt, the maximum deviation is ~8.0E-4 per atom.
+   std::ifstream paramFile;
+   openInputFile("in/MdSimulationRespa", paramFile); 
+   simulation_.readParam(paramFile);
+   paramFile.close();
+   simulation_.readCommands();
+
+   system_.pairPotential().buildPairList();
+   system_.calculateForces();
+   system_.mdIntegrator().setup();
+   double energy0 = system_.kineticEnergy() + system_.potentialEnergy();
+
+   // Maximum deviation of total energy, sampled every 100 steps
+   double energy, deviation;
+   double maxDeviation = 0.0;
+   for (int i = 1; i <= 2000; ++i) {
+      system_.mdIntegrator().step();
+      if (i % 100 == 0) {
+         energy = system_.kineticEnergy() + system_.potentialEnergy();
+         deviation = fabs(energy - energy0);
+         if (deviation > maxDeviation) {
+            maxDeviation = deviation;
+         }
+      }
+   }
+
+   // Deviation per atom is bounded
+   double drift = maxDeviation/double(system_.nAtom());
+   if (verbose() > 0) {
+      std::cout << "Energy drift per atom = " << drift << std::endl;
+   }
+   TEST_ASSERT(drift < 4.0E-4);
+}
+
 TEST_BEGIN(MdSimulationTest)
 TEST_ADD(MdSimulationTest, testReadParam)
 TEST_ADD(MdSimulationTest, testSetZeroVelocities)
@@ -367,6 +517,8 @@ TEST_ADD(MdSimulationTest, testStep)
 TEST_ADD(MdSimulationTest, testSimulate)
 TEST_ADD(MdSimulationTest, testWriteRestart)
 TEST_ADD(MdSimulationTest, testReadRestart)
+TEST_ADD(MdSimulationTest, testRespaSingleInnerStep)
+TEST_ADD(MdSimulationTest, testRespaEnergyDrift)
 TEST_END(MdSimulationTest)
 
 #endif
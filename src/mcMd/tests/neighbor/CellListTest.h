@@ -190,8 +190,9 @@ public:
 
       cellList.addAtom(atoms[atomId]);
 
-      TEST_ASSERT(cellList.cells_[cellId].nAtomCell_ == 1);
-      TEST_ASSERT(cellList.cells_[cellId].firstEmptyPos_ == 1);
+      TEST_ASSERT(cellList.nAtomCells_[cellId] == 1);
+      TEST_ASSERT(cellList.atomPtrs_[cellList.cellBegins_[cellId]] 
+                  == &atoms[atomId]);
 
       TEST_ASSERT(cellList.cellTags_[atomId].cellId == cellId);
       TEST_ASSERT(cellList.cellTags_[atomId].cellPos == 0);
@@ -235,8 +236,8 @@ public:
       cellList.addAtom(atoms[atomId]);
       cellList.deleteAtom(atoms[atomId]);
 
-      TEST_ASSERT(cellList.cells_[cellId].nAtomCell_ == 0);
-      TEST_ASSERT(cellList.cells_[cellId].firstEmptyPos_ == 0);
+      TEST_ASSERT(cellList.nAtomCells_[cellId] == 0);
+      TEST_ASSERT(cellList.cellTags_[atomId].cellId == CellTag::NullIndex);
 
       try { 
          cellList.isValid(0);
@@ -283,9 +284,9 @@ public:
          atoms[i].position() = r[i];
          cellList.addAtom(atoms[i]);
 
-         TEST_ASSERT(cellList.cells_[cellId[i]].nAtomCell_ == i+1);
-         TEST_ASSERT(cellList.cells_[cellId[i]].firstEmptyPos_ == i+1);
-         TEST_ASSERT(cellList.cells_[cellId[i]].atoms_[i] == &atoms[i]);
+         TEST_ASSERT(cellList.nAtomCells_[cellId[i]] == i+1);
+         TEST_ASSERT(cellList.atomPtrs_[cellList.cellBegins_[cellId[i]] + i] 
+                     == &atoms[i]);
 
          TEST_ASSERT(cellList.cellTags_[i].cellId  == cellId[i]);
          TEST_ASSERT(cellList.cellTags_[i].cellPos == i);
@@ -293,14 +294,16 @@ public:
 
       i = cellId[0];
 
-      TEST_ASSERT(cellList.cells_[i].nAtomCell_ == N_PART);
-      TEST_ASSERT(cellList.cells_[i].firstEmptyPos_ == N_PART);
+      TEST_ASSERT(cellList.nAtomCells_[i] == N_PART);
 
-      // Remove atom j from cell (not the last one)
+      // Remove atom j from cell (not the last one). 
+      // The last atom is moved into its slot.
       cellList.deleteAtom(atoms[j]);
 
-      TEST_ASSERT(cellList.cells_[i].nAtomCell_ == N_PART - 1);
-      TEST_ASSERT(cellList.cells_[i].firstEmptyPos_ == j);
+      TEST_ASSERT(cellList.nAtomCells_[i] == N_PART - 1);
+      TEST_ASSERT(cellList.atomPtrs_[cellList.cellBegins_[i] + j] 
+                  == &atoms[N_PART-1]);
+      TEST_ASSERT(cellList.cellTags_[N_PART-1].cellPos == j);
 
       // Put back atom j, with modified position and label
       r[j] = Vector(0.9, 2.4, 1.1);
@@ -309,23 +312,16 @@ public:
       TEST_ASSERT(i == cellId[j]);  // Check that its the same cell
       cellList.addAtom(atoms[j]);
 
-      TEST_ASSERT(cellList.cells_[i].nAtomCell_ == N_PART);
-      TEST_ASSERT(cellList.cells_[i].firstEmptyPos_ == N_PART);
+      TEST_ASSERT(cellList.nAtomCells_[i] == N_PART);
 
+      // Atom j is now last in the cell
       for (k=0; k < N_PART; k++) {
-
-         TEST_ASSERT(cellList.cells_[i].atoms_[k] == &atoms[k]);
-
          TEST_ASSERT(cellList.cellTags_[k].cellId  == i);
-         TEST_ASSERT(cellList.cellTags_[k].cellPos == k);
-      }
-
-      for (k=N_PART; k < Cell::MaxAtomCell; k++) {
-         TEST_ASSERT(cellList.cells_[i].atoms_[k] == 0);
+         TEST_ASSERT(cellList.atomPtrs_[cellList.cellBegins_[i] 
+                                        + cellList.cellTags_[k].cellPos] 
+                     == &atoms[k]);
       }
-
-      TEST_ASSERT(cellList.cellTags_[j].cellId  == i);
-      TEST_ASSERT(cellList.cellTags_[j].cellPos == j);
+      TEST_ASSERT(cellList.cellTags_[j].cellPos == N_PART - 1);
 
       try { 
          cellList.isValid(N_PART);
@@ -576,6 +572,126 @@ public:
       Atom::deallocate();
    }
 
+   void testManyAtomsInCell()
+   {
+      printMethod(TEST_FUNC);
+      const int nAtom = 500;
+      double    cutoff  = 1.2;
+      Vector    pos;
+      Random    random;
+      int       i, ic;
+
+      // One cell in x and two cells in y and z
+      Vector Lin(2.0, 3.0, 3.0);
+      boundary.setOrthorhombic(Lin);  
+      cellList.allocate(nAtom, boundary, cutoff);
+      cellList.makeGrid(boundary, cutoff);
+      TEST_ASSERT(cellList.totCells() == 4);
+
+      RArray<Atom> atoms;
+      Atom::allocate(nAtom, atoms);
+
+      // Add all atoms to a single cell, forcing rebuilds
+      random.setSeed(7430125);
+      cellList.clear();
+      for (i = 0; i < nAtom; ++i) {
+         pos[0] = random.uniform(0.0, 2.0);
+         pos[1] = random.uniform(0.0, 1.5);
+         pos[2] = random.uniform(0.0, 1.5);
+         atoms[i].position() = pos;
+         cellList.addAtom(atoms[i]);
+      }
+      ic = cellList.cellIndexFromPosition(atoms[0].position());
+      TEST_ASSERT(cellList.nAtomCell(ic) == nAtom);
+      TEST_ASSERT(cellList.nRebuild() > 0);
+      try {
+         cellList.isValid(nAtom);
+      } catch (Exception e) {
+         e.write(std::cout);
+         TEST_ASSERT(0);
+      }
+
+      // Move all atoms to random positions, one at a time
+      for (i = 0; i < nAtom; ++i) {
+         boundary.randomPosition(random, pos);
+         atoms[i].position() = pos;
+         cellList.updateAtomCell(atoms[i], pos);
+      }
+      try {
+         cellList.isValid(nAtom);
+      } catch (Exception e) {
+         e.write(std::cout);
+         TEST_ASSERT(0);
+      }
+
+      // Check that getNeighbors returns all atoms (all cells neighbor)
+      CellList::NeighborArray neighbors;
+      cellList.getNeighbors(atoms[0].position(), neighbors);
+      TEST_ASSERT(neighbors.size() == nAtom);
+
+      Atom::deallocate();
+   }
+
+   void testHalfCellNeighbors()
+   {
+      printMethod(TEST_FUNC);
+      const int nAtom = 200;
+      double    cutoff = 1.2;
+      Vector    pos;
+      Random    random;
+      RArray<Atom> atoms;
+      CellList::NeighborArray neighbors;
+      int i, j, ic, nInCell, nNeighbor, nPair, nPairTest, iLin;
+      double rSq;
+
+      // Grids with 1, 2, 3 or more cells along each axis
+      Vector Lins[3];
+      Lins[0] = Vector(2.0, 3.0, 4.0);
+      Lins[1] = Vector(6.0, 2.5, 3.7);
+      Lins[2] = Vector(6.5, 6.1, 7.3);
+
+      Atom::allocate(nAtom, atoms);
+      random.setSeed(5124871);
+      for (iLin = 0; iLin < 3; ++iLin) {
+         boundary.setOrthorhombic(Lins[iLin]);  
+         CellList list;
+         list.allocate(nAtom, boundary, cutoff);
+         list.clear();
+         for (i = 0; i < nAtom; ++i) {
+            boundary.randomPosition(random, pos);
+            atoms[i].position() = pos;
+            list.addAtom(atoms[i]);
+         }
+
+         // Count pairs within cutoff using half cell neighbors
+         nPair = 0;
+         for (ic = 0; ic < list.totCells(); ++ic) {
+            list.getHalfCellNeighbors(ic, neighbors, nInCell);
+            nNeighbor = neighbors.size();
+            for (i = 0; i < nInCell; ++i) {
+               for (j = i + 1; j < nNeighbor; ++j) {
+                  rSq = boundary.distanceSq(neighbors[i]->position(), 
+                                            neighbors[j]->position());
+                  if (rSq < cutoff*cutoff) ++nPair;
+               }
+            }
+         }
+
+         // Count pairs by brute force
+         nPairTest = 0;
+         for (i = 0; i < nAtom; ++i) {
+            for (j = i + 1; j < nAtom; ++j) {
+               rSq = boundary.distanceSq(atoms[i].position(), 
+                                         atoms[j].position());
+               if (rSq < cutoff*cutoff) ++nPairTest;
+            }
+         }
+         TEST_ASSERT(nPair == nPairTest);
+      }
+
+      Atom::deallocate();
+   }
+
    void writeCellConfiguration()
    {
       printf("numCells: %i %i %i \n", 
@@ -601,6 +717,8 @@ TEST_ADD(CellListTest, testAddRandomAtoms)
 TEST_ADD(CellListTest, testBuild)
 TEST_ADD(CellListTest, testUpdateAtomCell)
 TEST_ADD(CellListTest, testGetNeighbors)
+TEST_ADD(CellListTest, testManyAtomsInCell)
+TEST_ADD(CellListTest, testHalfCellNeighbors)
 TEST_END(CellListTest)
 
 #endif
@@ -0,0 +1,169 @@
+#ifndef MCMD_VERLET_LIST_TEST_H
+#define MCMD_VERLET_LIST_TEST_H
+
+#include <test/UnitTest.h>
+#include <mcMd/neighbor/VerletList.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/random/Random.h>
+
+#include <iostream>
+#include <fstream>
+
+using namespace Util;
+using namespace McMd;
+
+class VerletListTest : public UnitTest 
+{
+
+private:
+
+   Boundary   boundary;
+   VerletList verletList;
+
+   /*
+   * Check that every pair within potentialCutoff is listed.
+   */
+   bool hasAllPairs(RArray<Atom>& atoms, int nAtom, double potentialCutoff)
+   {
+      double rSq;
+      int i, j, k;
+      bool found;
+      for (i = 0; i < nAtom; ++i) {
+         if (!verletList.isCurrent(atoms[i])) continue;
+         for (j = 0; j < nAtom; ++j) {
+            if (j == i || !verletList.isCurrent(atoms[j])) continue;
+            rSq = boundary.distanceSq(atoms[i].position(), 
+                                      atoms[j].position());
+            if (rSq < potentialCutoff*potentialCutoff) {
+               found = false;
+               for (k = 0; k < verletList.nNeighbor(i); ++k) {
+                  if (verletList.neighborPtr(i, k) == &atoms[j]) {
+                     found = true;
+                  }
+               }
+               if (!found) return false;
+            }
+         }
+      }
+      return true;
+   }
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}
+
+   void testReadParam()
+   {
+      printMethod(TEST_FUNC);
+      double potentialCutoff = 1.2;
+      int    nAtom           = 20;
+
+      Vector Lin(4.0, 5.0, 6.0);
+      boundary.setOrthorhombic(Lin);  
+
+      std::ifstream in;
+      openInputFile("in/VerletList", in);
+      verletList.readParam(in);
+      verletList.allocate(nAtom, boundary, potentialCutoff);
+
+      TEST_ASSERT(eq(verletList.skin(), 0.3));
+      TEST_ASSERT(eq(verletList.cutoff(), 1.5));
+      TEST_ASSERT(verletList.isAllocated());
+      if (verbose() > 0) {
+         verletList.writeParam(std::cout);
+      }
+   }
+
+   void testUpdate()
+   {
+      printMethod(TEST_FUNC);
+      const int    nAtom = 200;
+      const double potentialCutoff = 1.2;
+      const double maxDisplacement = 0.25;
+      int i, iStep;
+
+      Vector Lin(6.0, 6.0, 6.0);
+      boundary.setOrthorhombic(Lin);  
+
+      std::ifstream in;
+      openInputFile("in/VerletList", in);
+      verletList.readParam(in);
+      verletList.allocate(nAtom, boundary, potentialCutoff);
+
+      // Allocate Atoms and place them at random
+      RArray<Atom> atoms;
+      Atom::allocate(nAtom, atoms);
+      Vector pos;
+      Random random;
+      random.setSeed(6482941);
+      for (i = 0; i < nAtom; ++i) {
+         boundary.randomPosition(random, pos);
+         atoms[i].setTypeId(0);
+         atoms[i].position() = pos;
+      }
+
+      // Full build
+      verletList.clear(boundary);
+      for (i = 0; i < nAtom; ++i) {
+         verletList.addAtom(atoms[i]);
+      }
+      TEST_ASSERT(verletList.nFullBuild() == 1);
+      try {
+         verletList.isValid(boundary);
+      } catch (Exception e) {
+         std::cout << e.message();
+         TEST_ASSERT(false);
+      }
+      TEST_ASSERT(hasAllPairs(atoms, nAtom, potentialCutoff));
+
+      // Random single atom displacements, deletions and insertions
+      Vector dr;
+      for (iStep = 0; iStep < 4000; ++iStep) {
+         i = random.uniformInt(0, nAtom);
+         if (iStep % 10 == 0) {
+            verletList.deleteAtom(atoms[i]);
+            TEST_ASSERT(!verletList.isCurrent(atoms[i]));
+            boundary.randomPosition(random, pos);
+            atoms[i].position() = pos;
+            verletList.addAtom(atoms[i]);
+         } else {
+            for (int k = 0; k < Dimension; ++k) {
+               dr[k] = random.uniform(-maxDisplacement, maxDisplacement);
+            }
+            atoms[i].position() += dr;
+            boundary.shift(atoms[i].position());
+            verletList.updateAtom(atoms[i]);
+         }
+         TEST_ASSERT(verletList.isCurrent(atoms[i]));
+      }
+      TEST_ASSERT(verletList.nFullBuild() == 1);
+      TEST_ASSERT(verletList.nPartialBuild() > 0);
+      try {
+         verletList.isValid(boundary);
+      } catch (Exception e) {
+         std::cout << e.message();
+         TEST_ASSERT(false);
+      }
+      TEST_ASSERT(hasAllPairs(atoms, nAtom, potentialCutoff));
+
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         std::cout << "nPartialBuild = " << verletList.nPartialBuild()
+                   << std::endl;
+      }
+
+      Atom::deallocate();
+   }
+
+};
+
+TEST_BEGIN(VerletListTest)
+TEST_ADD(VerletListTest, testReadParam)
+TEST_ADD(VerletListTest, testUpdate)
+TEST_END(VerletListTest)
+
+#endif
@@ -0,0 +1,141 @@
+#ifdef MCMD_PERTURB
+#ifdef UTIL_MPI
+#ifndef MCMD_REPLICA_MOVE_TEST_H
+#define MCMD_REPLICA_MOVE_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+#include <mcMd/perturb/ReplicaMove.h>
+#include <util/random/Random.h>
+#include <util/containers/DArray.h>
+
+using namespace Util;
+using namespace McMd;
+
+class ReplicaMoveTest : public UnitTest
+{
+
+private:
+
+   static const int nReplica_ = 4;
+
+   Random random_;
+   DArray<double> differences_;
+   DArray<int> stateIds_;
+
+   /*
+   * Set W(X_i, p_k) - W(X_i, p_(s_i)) for all replicas i and states k,
+   * for a reduced energy w(i, k) = 0 if k == preferred[i], and w(i, k)
+   * = penalty otherwise.
+   */
+   void setDifferences(const int* preferred, double penalty)
+   {
+      double wi;
+      int i, k;
+      for (i = 0; i < nReplica_; ++i) {
+         wi = (stateIds_[i] == preferred[i]) ? 0.0 : penalty;
+         for (k = 0; k < nReplica_; ++k) {
+            differences_[i*nReplica_ + k]
+                    = ((k == preferred[i]) ? 0.0 : penalty) - wi;
+         }
+      }
+   }
+
+   /*
+   * Return true if stateIds_ is a permutation of 0, ..., nReplica_ - 1.
+   */
+   bool isPermutation()
+   {
+      int i, j;
+      for (i = 0; i < nReplica_; ++i) {
+         if (stateIds_[i] < 0 || stateIds_[i] >= nReplica_) return false;
+         for (j = 0; j < i; ++j) {
+            if (stateIds_[i] == stateIds_[j]) return false;
+         }
+      }
+      return true;
+   }
+
+public:
+
+   void setUp()
+   {
+      random_.setSeed(7654321);
+      differences_.allocate(nReplica_*nReplica_);
+      stateIds_.allocate(nReplica_);
+      for (int i = 0; i < nReplica_; ++i) {
+         stateIds_[i] = i;
+      }
+   }
+
+   void tearDown()
+   {}
+
+   void testAcceptAll()
+   {
+      printMethod(TEST_FUNC);
+
+      // Equal weights for all states: every swap is accepted
+      for (int k = 0; k < nReplica_*nReplica_; ++k) {
+         differences_[k] = 0.0;
+      }
+      int nAccept = ReplicaMove::sampleStates(&differences_[0], nReplica_,
+                                              100, random_, &stateIds_[0]);
+      TEST_ASSERT(nAccept == 100);
+      TEST_ASSERT(isPermutation());
+   }
+
+   void testRejectAll()
+   {
+      printMethod(TEST_FUNC);
+
+      // Each replica strongly prefers its current state
+      int preferred[nReplica_] = {0, 1, 2, 3};
+      setDifferences(preferred, 200.0);
+      int nAccept = ReplicaMove::sampleStates(&differences_[0], nReplica_,
+                                              100, random_, &stateIds_[0]);
+      TEST_ASSERT(nAccept == 0);
+      for (int i = 0; i < nReplica_; ++i) {
+         TEST_ASSERT(stateIds_[i] == i);
+      }
+   }
+
+   void testRemap()
+   {
+      printMethod(TEST_FUNC);
+
+      // Each replica strongly prefers another state: states are remapped
+      // so that each replica reaches its preferred state
+      int preferred[nReplica_] = {2, 0, 3, 1};
+      int nAccept;
+      int n = 0;
+      for (int iStep = 0; iStep < 10; ++iStep) {
+         setDifferences(preferred, 200.0);
+         nAccept = ReplicaMove::sampleStates(&differences_[0], nReplica_,
+                                             20, random_, &stateIds_[0]);
+         TEST_ASSERT(isPermutation());
+         n += nAccept;
+      }
+      TEST_ASSERT(n > 0);
+      for (int i = 0; i < nReplica_; ++i) {
+         TEST_ASSERT(stateIds_[i] == preferred[i]);
+      }
+
+      // Once every replica has its preferred state, swaps are rejected
+      setDifferences(preferred, 200.0);
+      nAccept = ReplicaMove::sampleStates(&differences_[0], nReplica_,
+                                          100, random_, &stateIds_[0]);
+      TEST_ASSERT(nAccept == 0);
+   }
+
+};
+
+TEST_BEGIN(ReplicaMoveTest)
+TEST_ADD(ReplicaMoveTest, testAcceptAll)
+TEST_ADD(ReplicaMoveTest, testRejectAll)
+TEST_ADD(ReplicaMoveTest, testRemap)
+TEST_END(ReplicaMoveTest)
+
+#endif
+#endif // ifdef UTIL_MPI
+#endif // ifdef MCMD_PERTURB
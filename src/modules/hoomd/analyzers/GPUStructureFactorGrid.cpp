@@ -25,7 +25,7 @@ namespace McMd
          Molecule::ConstAtomIterator  atomIter;
          int  nSpecies, iSpecies, typeId, i, j;
 
-         makeWaveVectors();
+         makeWaveVectors(system().boundary());
 
         
          // allocate temporary arrays
@@ -36,6 +36,12 @@ namespace McMd
       * \param iStep step counter
       */
       void sample(long iStep);
+
+      /**
+      * Return false: sampling uses the GPU, and is not run on snapshots.
+      */
+      virtual bool isSnapshotAnalyzer() const
+      {  return false; }
     
    };
 
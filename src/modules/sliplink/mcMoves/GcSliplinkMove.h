@@ -41,6 +41,12 @@ namespace McMd
 
       /// Array to hold neighbors returned by a CellList.
       mutable CellList::NeighborArray neighbors_;
+
+      /// Cumulative probability distribution for choice of a neighbor.
+      GArray<double> cdf_;
+
+      /// Indices in neighbors_ of atoms with entries in cdf_.
+      GArray<int> idNeighbors_;
       
       double cutoff_;
 
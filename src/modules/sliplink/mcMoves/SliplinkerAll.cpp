@@ -25,16 +25,26 @@
 
 namespace McMd
 {
-  
+
    using namespace Util;
 
    // Constructor
    SliplinkerAll::SliplinkerAll(McSystem& system) :
       SystemMove(system),
+      stamp_(0),
       cutoff_(0),
       mu_(0),
       speciesId_(0)
-   {  setClassName("SliplinkerAll"); }
+   {
+      setClassName("SliplinkerAll");
+      int atomCapacity = simulation().atomCapacity();
+      begins_.allocate(atomCapacity);
+      nCandidates_.allocate(atomCapacity);
+      stamps_.allocate(atomCapacity);
+      for (int i = 0; i < atomCapacity; ++i) {
+         stamps_[i] = 0;
+      }
+   }
 
    void SliplinkerAll::readParameters(std::istream& in)
    {
@@ -42,157 +52,155 @@ namespace McMd
       read<double>(in, "cutoff", cutoff_);
       read<double>(in, "mu", mu_);
       read<int>(in, "speciesId", speciesId_);
-      
+   }
+
+   /*
+   * Index candidates of an atom, if not yet indexed in this move().
+   */
+   int SliplinkerAll::indexCandidates(Atom& atom)
+   {
+      int id = atom.id();
+      if (stamps_[id] == stamp_) {
+         return nCandidates_[id];
+      }
 
+      // Get array of neighbors
+      system().pairPotential().cellList()
+              .getNeighbors(atom.position(), neighbors_);
+      int nNeighbor = neighbors_.size();
+      double cutoffSq = cutoff_*cutoff_;
+      double rsq, energy;
+      double sum = 0.0;
+      Atom* neighborPtr;
+      int n = 0;
+
+      // Append unmasked neighbors within the cutoff, and the cumulative
+      // distribution of their Boltzmann weights, to the index.
+      begins_[id] = candidates_.size();
+      for (int j = 0; j < nNeighbor; ++j) {
+         neighborPtr = neighbors_[j];
+         if (neighborPtr != &atom) {
+            if (!atom.mask().isMasked(*neighborPtr)) {
+               rsq = system().boundary().distanceSq(atom.position(),
+                                                    neighborPtr->position());
+               if (rsq <= cutoffSq) {
+                  energy = system().linkPotential().energy(rsq, 0);
+                  sum = sum + boltzmann(energy);
+                  candidates_.append(neighborPtr);
+                  cdf_.append(sum);
+                  ++n;
+               }
+            }
+         }
+      }
+      nCandidates_[id] = n;
+      stamps_[id] = stamp_;
+      return n;
    }
 
+   /*
+   * Choose a candidate of an indexed atom, by bisection of its cdf.
+   */
+   Atom* SliplinkerAll::chooseCandidate(const Atom& atom)
+   {
+      int first = begins_[atom.id()];
+      int last = first + nCandidates_[atom.id()] - 1;
+      double rnd = random().uniform(0.0, 1.0);
+      double norm = 1.0/cdf_[last];
+      int mid;
+
+      // Find the first candidate j for which rnd <= cdf_[j]*norm
+      while (first < last) {
+         mid = (first + last)/2;
+         if (rnd > cdf_[mid]*norm) {
+            first = mid + 1;
+         } else {
+            last = mid;
+         }
+      }
+      return candidates_[first];
+   }
 
    // Create or destroy the slip-springs.
-   bool SliplinkerAll::move() 
+   bool SliplinkerAll::move()
    {
-     System::MoleculeIterator molIter;
-     Molecule::AtomIterator   atomIter;
-     Atom                    *atom0Ptr, *atom1Ptr;
-     Atom*                    atomPtr;
-     Molecule                *mol0Ptr, *mol1Ptr;
-     Molecule*                molIPtr;
-     double                   prob, dRSq, mindRSq=cutoff_*cutoff_, rnd, norm;
-     int                      i, ntrials, j, nNeighbor, idLink, iAtom, id1, id0;
-     int                      iAtom0, iAtom1, iMolecule0, iMolecule1, n0;
-     Link*                    linkPtr;
-     static const int         maxNeighbor = CellList::MaxNeighbor;
-     double                   cdf[maxNeighbor], energy, sum;
-     int                      idneighbors[maxNeighbor];
-
-     
-     ntrials = 2 * system().simulation().atomCapacity();
-     for (i=0; i < ntrials; ++i){   
-       
-       //Choose to create or destroy a link with prob 0.5
-       if (random().uniform(0.0, 1.0) > 0.5){         
-	  // Try to create a link. 
-	  incrementNAttempt();		
-	  // Choose a molecule and atom at random
-	  molIPtr  = &(system().randomMolecule(speciesId_));
-	  iMolecule0 = system().moleculeId(*molIPtr);
-	  iAtom   = random().uniformInt(0, molIPtr->nAtom());
-	  atomPtr = &molIPtr->atom(iAtom);
-	  id0 = atomPtr->id();
-	  
-	  // Get array of neighbors
-	  system().pairPotential().cellList().getNeighbors(atomPtr->position(), neighbors_);
-	  nNeighbor = neighbors_.size();
-	    
-	  n0 = 0;
-	  sum = 0;
-	  // Loop over neighboring atoms
-	  for (j = 0; j < nNeighbor; ++j) {
-	    atom1Ptr = neighbors_[j];
-	    mol1Ptr = &atom1Ptr->molecule();
-	    iMolecule1 = system().moleculeId(*mol1Ptr);	
-	    id1 = atom1Ptr->id();
-	    
-            // Check if atoms are the same
-            if (id0 != id1){	    	    
-	      // Exclude masked pairs	    
-	      if (!atomPtr->mask().isMasked(*atom1Ptr)) {
-		// Identify possible partners and calculate the cumulative distribution function
-		dRSq = system().boundary().distanceSq(atomPtr->position(), atom1Ptr->position());
-		if (dRSq <= mindRSq) {
-		  energy = system().linkPotential().energy(dRSq, 0);
-		  //energy = 0.5*dRSq;
-		  sum = sum + boltzmann(energy);
-		  cdf[n0] = sum;
-		  idneighbors[n0] = j;
-		  n0++;
-		}    
-	      }
-	    }
-	  }   
-	    
-	  // If at least 1 candidate has been found.  
-	  if (n0 > 0) {
-	    // Choose a partner with probability cdf[j]/cdf[n0-1]
-	    j = 0;
-	    rnd = random().uniform(0.0, 1.0);
-	    norm = 1.0/cdf[n0-1];
-	    while (rnd > cdf[j]*norm ){
-	      j = j + 1;
-	    }     
-	    atom1Ptr = neighbors_[idneighbors[j]];	  	  
-	    // Create a slip-link between the selected atoms with probability = prob
-	    prob = 2.0 * (system().linkMaster().nLink() + 1.0);
-	    prob = system().simulation().atomCapacity() * boltzmann(-mu_) * cdf[n0-1]/ prob ;
-	    //prob = 2.0 * system().nMolecule(speciesId_) * boltzmann(-mu_) * cdf[n0-1]/ prob ;	      
-	    if (system().simulation().random().uniform(0.0, 1.0) < prob) {        
-	      system().linkMaster().addLink(*atomPtr, *atom1Ptr, 0); 
-	      incrementNAccept();	    
-	    }      
-	  }    
-       }
-       else {
-	  // Try to destroy a link
-	  incrementNAttempt();
-	  // Choose a link at random
-	  if (system().linkMaster().nLink() > 0){
-	    idLink = random().uniformInt(0, system().linkMaster().nLink());
-	    // Indentify the atoms for this link.
-	    linkPtr = &(system().linkMaster().link(idLink));
-	    atom0Ptr = &(linkPtr->atom0());
-	    mol0Ptr = &atom0Ptr->molecule();
-	    iMolecule0 = system().moleculeId(*mol0Ptr);
-	    iAtom0 = atom0Ptr->indexInMolecule();	    
-	    atom1Ptr = &(linkPtr->atom1());
-	    mol1Ptr = &atom1Ptr->molecule();
-	    iMolecule1 = system().moleculeId(*mol1Ptr);
-	    iAtom1 = atom1Ptr->indexInMolecule();
-	    // try to delete the slip-spring	
-	    dRSq = system().boundary().distanceSq(atom0Ptr->position(), atom1Ptr->position());
-	    // try to delete the link if the bond is smaller than the cutoff
-	    if (dRSq <= mindRSq) {    
-	      // Get array of neighbors
-	      system().pairPotential().cellList().getNeighbors(atom0Ptr->position(), neighbors_);
-	      nNeighbor = neighbors_.size();
-	      id0 = atom0Ptr->id();
-	      n0 = 0;
-	      sum = 0;
-	      // Loop over neighboring atoms
-	      for (j = 0; j < nNeighbor; ++j) {
-		atom1Ptr = neighbors_[j];
-		mol1Ptr = &atom1Ptr->molecule();
-		iMolecule1 = system().moleculeId(*mol1Ptr);
-	        id1 = atom1Ptr->id();
-	    
-                // Check if atoms are the same
-                if (id0 != id1){	    					
-		  // Exclude masked pairs	    
-		  if (!atom0Ptr->mask().isMasked(*atom1Ptr)) {
-		    // Identify possible partners and calculate the cumulative distribution function
-		    dRSq = system().boundary().distanceSq(atom0Ptr->position(), atom1Ptr->position());
-		    if (dRSq <= mindRSq) {
-		      energy = system().linkPotential().energy(dRSq, 0);
-		      //energy = 0.5*dRSq;
-		      sum = sum + boltzmann(energy);
-		      cdf[n0] = sum;
-		      idneighbors[n0] = j;
-		      n0++;
-		    }    
-		  }
-	        }
-	      }    
-	      // Destroy the slip-link between the selected atoms with probability = prob	  
-	      //prob = 2.0 * system().nMolecule(speciesId_) * boltzmann(-mu_) * cdf[n0-1];	
-	      prob = system().simulation().atomCapacity() * boltzmann(-mu_) * cdf[n0-1];	    
-	      prob = 2.0 * system().linkMaster().nLink() / prob; 	            
-	      if (system().simulation().random().uniform(0.0, 1.0) < prob) {        
-		system().linkMaster().removeLink(idLink); 
-		incrementNAccept();  
-	      }  
-	    }
-          }
-       }
-     }
-     return true;
+      Atom      *atom0Ptr, *atom1Ptr;
+      Molecule  *molIPtr;
+      Link      *linkPtr;
+      double     prob, dRSq, mindRSq=cutoff_*cutoff_;
+      int        i, ntrials, idLink, iAtom, n0;
+
+      // Clear the index of link candidates
+      ++stamp_;
+      candidates_.clear();
+      cdf_.clear();
+
+      ntrials = 2 * system().simulation().atomCapacity();
+      for (i=0; i < ntrials; ++i) {
+
+         // Choose to create or destroy a link with prob 0.5
+         if (random().uniform(0.0, 1.0) > 0.5) {
+
+            // Try to create a link.
+            incrementNAttempt();
+
+            // Choose a molecule and atom at random
+            molIPtr  = &(system().randomMolecule(speciesId_));
+            iAtom    = random().uniformInt(0, molIPtr->nAtom());
+            atom0Ptr = &molIPtr->atom(iAtom);
+
+            // If at least 1 candidate has been found.
+            n0 = indexCandidates(*atom0Ptr);
+            if (n0 > 0) {
+
+               // Choose a partner with probability proportional to weight
+               atom1Ptr = chooseCandidate(*atom0Ptr);
+
+               // Create a slip-link between the selected atoms
+               prob = 2.0 * (system().linkMaster().nLink() + 1.0);
+               prob = system().simulation().atomCapacity() * boltzmann(-mu_)
+                      * cdf_[begins_[atom0Ptr->id()] + n0 - 1] / prob;
+               if (system().simulation().random().uniform(0.0, 1.0) < prob) {
+                  system().linkMaster().addLink(*atom0Ptr, *atom1Ptr, 0);
+                  incrementNAccept();
+               }
+
+            }
+
+         } else {
+
+            // Try to destroy a link
+            incrementNAttempt();
+
+            // Choose a link at random
+            if (system().linkMaster().nLink() > 0) {
+               idLink = random().uniformInt(0, system().linkMaster().nLink());
+               linkPtr = &(system().linkMaster().link(idLink));
+               atom0Ptr = &(linkPtr->atom0());
+               atom1Ptr = &(linkPtr->atom1());
+
+               // Try to delete the link if it is shorter than the cutoff
+               dRSq = system().boundary().distanceSq(atom0Ptr->position(),
+                                                     atom1Ptr->position());
+               n0 = 0;
+               if (dRSq <= mindRSq) {
+                  n0 = indexCandidates(*atom0Ptr);
+               }
+               if (n0 > 0) {
+                  prob = system().simulation().atomCapacity()
+                         * boltzmann(-mu_)
+                         * cdf_[begins_[atom0Ptr->id()] + n0 - 1];
+                  prob = 2.0 * system().linkMaster().nLink() / prob;
+                  if (system().simulation().random().uniform(0.0, 1.0) < prob) {
+                     system().linkMaster().removeLink(idLink);
+                     incrementNAccept();
+                  }
+               }
+            }
+
+         }
+      }
+      return true;
    }
 
 }
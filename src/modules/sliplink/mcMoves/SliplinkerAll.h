@@ -11,6 +11,8 @@
 #include <mcMd/mcMoves/SystemMove.h>  // base class
 #include <mcMd/simulation/System.h>
 #include <mcMd/neighbor/CellList.h>
+#include <util/containers/DArray.h>
+#include <util/containers/GArray.h>
 #include <util/global.h>
 
 namespace McMd
@@ -20,6 +22,22 @@ namespace McMd
   
    /**
    * Move to create and destroy slip-springs.
+   *
+   * Each call to move() makes 2*atomCapacity attempts to create or
+   * destroy a slip-spring. The link candidates of an atom (unmasked 
+   * atoms within the cutoff) and their cumulative Boltzmann weights 
+   * are found from the cell list the first time that atom is chosen
+   * within a call to move(), and stored in an index that is reused 
+   * by later attempts involving the same atom. Because atom positions
+   * and masks do not change during move(), and creation or removal
+   * of a link does not change either, the index remains exact until
+   * the end of the call, and is cleared at the start of the next.
+   *
+   * Indexing an atom costs one cell list scan, and a partner is then
+   * chosen by bisection of its cdf, in a time logarithmic in its
+   * number of candidates. The index is not kept between calls, since
+   * other moves displace atoms between calls, and LinkMaster events
+   * report only changes in links, which do not change the candidates.
    * 
    * \ingroup McMove_Module MD_Module
    */
@@ -41,10 +59,41 @@ namespace McMd
 
       /// Array to hold neighbors returned by a CellList.
       mutable CellList::NeighborArray neighbors_;
+
+      /// Link candidates of all indexed atoms, stored in consecutive blocks.
+      GArray<Atom*> candidates_;
+
+      /// Cumulative Boltzmann weights of candidates, within each block.
+      GArray<double> cdf_;
+
+      /// Index in candidates_ of the first candidate of each atom.
+      DArray<int> begins_;
+
+      /// Number of candidates of each atom.
+      DArray<int> nCandidates_;
+
+      /// Value of stamp_ when each atom was last indexed.
+      DArray<int> stamps_;
+
+      /// Counter of calls to move(), used to invalidate the index.
+      int stamp_;
       
       double cutoff_;
       double mu_;
       int speciesId_;
+
+      /*
+      * Index candidates of an atom, if not yet indexed in this move().
+      *
+      * Returns the number of candidates.
+      */
+      int indexCandidates(Atom& atom);
+
+      /*
+      * Choose a candidate of an indexed atom with probability
+      * proportional to its Boltzmann weight.
+      */
+      Atom* chooseCandidate(const Atom& atom);
    
    };
 
@@ -61,7 +61,7 @@ namespace Tools
    void AtomMSD::readParameters(std::istream& in) 
    {
 
-      // Read interval and parameters for AutoCorrArray
+      // Read interval and parameters for accumulator
       readInterval(in);
       readOutputFileName(in);
       read<int>(in, "speciesId", speciesId_);
@@ -94,7 +94,7 @@ namespace Tools
       oldPositions_.allocate(speciesCapacity);
       shifts_.allocate(speciesCapacity);
 
-      // Allocate memory for the AutoCorrArray accumulator
+      // Allocate memory for the accumulator
       accumulator_.setParam(speciesCapacity, capacity_);
 
       isInitialized_ = true;
@@ -195,7 +195,7 @@ namespace Tools
       outputFile_ << std::endl;
       outputFile_ << "nMolecule      " << accumulator_.nEnsemble() 
                   << std::endl;
-      outputFile_ << "buffercapacity " << accumulator_.bufferCapacity()  
+      outputFile_ << "capacity       " << accumulator_.capacity()  
                   << std::endl;
       outputFile_ << "nSample        " << accumulator_.nSample() 
                   << std::endl;
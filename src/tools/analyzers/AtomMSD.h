@@ -9,7 +9,7 @@
 */
 
 #include <tools/analyzers/Analyzer.h>           // base class template
-#include <util/accumulators/MeanSqDispArray.h>  // member template 
+#include <util/accumulators/FftMeanSqDispArray.h> // member
 #include <util/space/Vector.h>                  // member template parameter
 #include <util/containers/DArray.h>             // member template
 
@@ -21,6 +21,11 @@ namespace Tools
    /**
    * Mean-squared displacement of specific atoms in specific species.
    *
+   * Positions of all samples are stored, and the MSD is computed for
+   * all time separations by FFT when output() is called (see
+   * Util::FftMeanSqDispArray). Parameter capacity is the maximum number
+   * of samples (i.e., of analyzed frames).
+   *
    * \ingroup Tools_Analyzer_Module
    */
    class AtomMSD : public Analyzer
@@ -73,7 +78,7 @@ namespace Tools
       std::ofstream outputFile_;
 
       /// Statistical accumulator
-      MeanSqDispArray<Vector> accumulator_;
+      FftMeanSqDispArray accumulator_;
 
       /// Array of position vectors, one per molecule of species.
       DArray<Vector> truePositions_;
@@ -93,7 +98,7 @@ namespace Tools
       /// Number of molecules in the species (must not change).
       int nMolecule_;
    
-      /// Maximum length of each sequence in AutoCorrArray.
+      /// Maximum number of samples of each sequence.
       int capacity_;
    
       /// Has readParam been called?
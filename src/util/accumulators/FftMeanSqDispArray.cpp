@@ -0,0 +1,206 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "FftMeanSqDispArray.h"
+#include <util/format/Int.h>
+#include <util/format/Dbl.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /*
+   * Constructor.
+   */
+   FftMeanSqDispArray::FftMeanSqDispArray()
+    : values_(),
+      work_(),
+      fft_(),
+      ensembleCapacity_(0),
+      capacity_(0),
+      nEnsemble_(0),
+      nSample_(0)
+   {  setClassName("FftMeanSqDispArray"); }
+
+   /*
+   * Destructor.
+   */
+   FftMeanSqDispArray::~FftMeanSqDispArray()
+   {}
+
+   /*
+   * Read parameters from file.
+   */
+   void FftMeanSqDispArray::readParameters(std::istream& in)
+   {
+      read<int>(in, "ensembleCapacity", ensembleCapacity_);
+      read<int>(in, "capacity", capacity_);
+      nEnsemble_ = ensembleCapacity_;
+      allocate();
+   }
+
+   /*
+   * Set parameters and initialize.
+   */
+   void FftMeanSqDispArray::setParam(int ensembleCapacity, int capacity)
+   {
+      ensembleCapacity_ = ensembleCapacity;
+      capacity_ = capacity;
+      nEnsemble_ = ensembleCapacity;
+      allocate();
+   }
+
+   /*
+   * Set or reset nEnsemble.
+   */
+   void FftMeanSqDispArray::setNEnsemble(int nEnsemble)
+   {
+      if (ensembleCapacity_ == 0) {
+         UTIL_THROW("No memory has been allocated: ensembleCapacity_ == 0");
+      }
+      if (nEnsemble > ensembleCapacity_) {
+         UTIL_THROW("nEnsemble > ensembleCapacity_");
+      }
+      nEnsemble_ = nEnsemble;
+   }
+
+   /*
+   * Discard all stored values.
+   */
+   void FftMeanSqDispArray::clear()
+   {  nSample_ = 0; }
+
+   /*
+   * Allocate memory (private).
+   */
+   void FftMeanSqDispArray::allocate()
+   {
+      if (capacity_ <= 0) {
+         UTIL_THROW("capacity must be positive");
+      }
+      if (ensembleCapacity_ <= 0) {
+         UTIL_THROW("ensembleCapacity must be positive");
+      }
+      int n = 1;
+      while (n < 2*capacity_) {
+         n *= 2;
+      }
+      values_.allocate(ensembleCapacity_*capacity_);
+      work_.allocate(n);
+      clear();
+   }
+
+   /*
+   * Store one value of each sequence.
+   */
+   void FftMeanSqDispArray::sample(const Array<Vector>& values)
+   {
+      if (nSample_ >= capacity_) {
+         UTIL_THROW("Number of samples exceeds capacity");
+      }
+      Vector* current = &values_[nSample_*ensembleCapacity_];
+      for (int i = 0; i < nEnsemble_; ++i) {
+         current[i] = values[i];
+      }
+      ++nSample_;
+   }
+
+   /*
+   * Compute mean-squared displacement for all lags.
+   */
+   void FftMeanSqDispArray::computeMeanSqDisp(DArray<double>& msd)
+   {
+      const int nt = nSample_;
+      if (nt == 0) {
+         UTIL_THROW("No samples");
+      }
+      if (!msd.isAllocated()) {
+         msd.allocate(capacity_);
+      } else
+      if (msd.capacity() < nt) {
+         UTIL_THROW("msd array capacity < nSample");
+      }
+
+      // Smallest power of 2 >= 2*nt avoids circular wrap around
+      int nPad = 1;
+      while (nPad < 2*nt) {
+         nPad *= 2;
+      }
+      if (fft_.size() != nPad) {
+         fft_.setup(nPad);
+      }
+
+      // Accumulate sum_i x(i).x(i+j) over all sequences in msd[j].
+      // Two real sequences (components) a, b are packed as z = a + ib,
+      // for which Re[sum_i conj(z(i)) z(i+j)] is the sum of the real
+      // autocorrelations of a and b.
+      const int nComponent = nEnsemble_*Dimension;
+      int i, j, k;
+      for (j = 0; j < nt; ++j) {
+         msd[j] = 0.0;
+      }
+      for (k = 0; k < nComponent; k += 2) {
+         if (k + 1 < nComponent) {
+            for (i = 0; i < nt; ++i) {
+               work_[i] = std::complex<double>(component(i, k),
+                                               component(i, k+1));
+            }
+         } else {
+            for (i = 0; i < nt; ++i) {
+               work_[i] = std::complex<double>(component(i, k), 0.0);
+            }
+         }
+         for (i = nt; i < nPad; ++i) {
+            work_[i] = 0.0;
+         }
+         fft_.forward(work_);
+         for (i = 0; i < nPad; ++i) {
+            work_[i] = std::norm(work_[i]);
+         }
+         fft_.inverse(work_);
+         for (j = 0; j < nt; ++j) {
+            msd[j] += work_[j].real();
+         }
+      }
+
+      // Combine with recursively computed sums of squares:
+      // q(j) = sum_{i=0}^{nt-j-1} [ x^2(i) + x^2(i+j) ]
+      double q = 0.0;
+      for (i = 0; i < nt; ++i) {
+         for (k = 0; k < nEnsemble_; ++k) {
+            q += 2.0*values_[i*ensembleCapacity_ + k].square();
+         }
+      }
+      double norm = 1.0/double(nPad);
+      double sqFirst, sqLast;
+      for (j = 0; j < nt; ++j) {
+         if (j > 0) {
+            sqFirst = 0.0;
+            sqLast = 0.0;
+            for (k = 0; k < nEnsemble_; ++k) {
+               sqFirst += values_[(j-1)*ensembleCapacity_ + k].square();
+               sqLast += values_[(nt-j)*ensembleCapacity_ + k].square();
+            }
+            q -= sqFirst + sqLast;
+         }
+         msd[j] = (q - 2.0*norm*msd[j])/double((nt - j)*nEnsemble_);
+      }
+   }
+
+   /*
+   * Compute and output mean-squared displacement.
+   */
+   void FftMeanSqDispArray::output(std::ostream& out)
+   {
+      DArray<double> msd;
+      computeMeanSqDisp(msd);
+      for (int j = 0; j < nSample_; ++j) {
+         out << Int(j) << Dbl(msd[j]) << std::endl;
+      }
+   }
+
+}
@@ -0,0 +1,177 @@
+#ifndef UTIL_FFT_MEAN_SQ_DISP_ARRAY_H
+#define UTIL_FFT_MEAN_SQ_DISP_ARRAY_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>       // base class
+#include <util/containers/DArray.h>          // member template
+#include <util/containers/Array.h>
+#include <util/space/Vector.h>               // member template parameter
+#include <util/space/Dimension.h>
+#include <util/math/Fft.h>                   // member
+
+#include <complex>
+
+namespace Util
+{
+
+   /**
+   * Mean-squared displacement of an ensemble of stored trajectories, by FFT.
+   *
+   * This class computes the same mean-squared displacement as
+   * MeanSqDispArray<Vector>, <|x(i) - x(i-j)|^2>, for an ensemble of
+   * Vector sequences, but for all lags 0 <= j < T of a trajectory of
+   * T samples. It is intended for post-processing of stored trajectories,
+   * for which the number of frames is known in advance. All sampled
+   * values are stored, and the MSD is computed when output() is called,
+   * using
+   * \f[
+   *    MSD(j) = \frac{1}{T-j} \sum_{i=0}^{T-j-1}
+   *             \left ( x^2(i) + x^2(i+j) \right )
+   *           - \frac{2}{T-j} \sum_{i=0}^{T-j-1} x(i) \cdot x(i+j) .
+   * \f]
+   * The first sum is evaluated by a recursion over j, and the second
+   * (an autocorrelation) by a zero-padded FFT, so that the total cost
+   * is O(N T log T) for N sequences, rather than O(N T^2) for a direct
+   * sum over all pairs of samples. Pairs of Cartesian components are
+   * packed into the real and imaginary parts of one complex transform.
+   *
+   * \ingroup Accumulators_Module
+   */
+   class FftMeanSqDispArray : public ParamComposite
+   {
+
+   public:
+
+      /// Constructor.
+      FftMeanSqDispArray();
+
+      /// Destructor.
+      ~FftMeanSqDispArray();
+
+      /**
+      * Read parameters, allocate memory and clear history.
+      *
+      * Reads parameters ensembleCapacity and capacity (the maximum
+      * number of samples of each sequence), and allocates memory.
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Set parameters, allocate memory, and clear history.
+      *
+      * \param ensembleCapacity maximum number of sequences in ensemble
+      * \param capacity         maximum number of samples per sequence
+      */
+      void setParam(int ensembleCapacity, int capacity);
+
+      /**
+      * Set actual number of sequences in ensemble.
+      *
+      * \pre readParameters() or setParam() must have been called previously
+      * \pre nEnsemble <= ensembleCapacity
+      *
+      * \param nEnsemble actual number of sequences in ensemble
+      */
+      void setNEnsemble(int nEnsemble);
+
+      /**
+      * Reset to empty state.
+      */
+      void clear();
+
+      /**
+      * Store an array of current values.
+      *
+      * \throw Exception if nSample() == capacity.
+      *
+      * \param values Array of current values
+      */
+      void sample(const Array<Vector>& values);
+
+      /**
+      * Compute and output the mean-squared displacement for all lags.
+      *
+      * Each line contains a lag, in units of the sampling interval,
+      * and the corresponding mean-squared displacement.
+      *
+      * \param out output stream
+      */
+      void output(std::ostream& out);
+
+      /**
+      * Compute the mean-squared displacement for all lags.
+      *
+      * Upon return, msd[j] contains the MSD for lag j, for all j
+      * < nSample(). The array is allocated if necessary.
+      *
+      * \param msd array of mean-squared displacements (output)
+      */
+      void computeMeanSqDisp(DArray<double>& msd);
+
+      /**
+      * Return maximum number of samples per sequence.
+      */
+      int capacity() const
+      {  return capacity_; }
+
+      /**
+      * Return number of sequences in the ensemble.
+      */
+      int nEnsemble() const
+      {  return nEnsemble_; }
+
+      /**
+      * Return number of values sampled from each sequence thus far.
+      */
+      int nSample() const
+      {  return nSample_; }
+
+   private:
+
+      /// Stored values, [sample*ensembleCapacity_ + sequence].
+      DArray<Vector> values_;
+
+      /// Zero-padded work array for transforms.
+      DArray< std::complex<double> > work_;
+
+      /// One dimensional FFT of size work_.capacity().
+      Fft fft_;
+
+      /// Maximum number of sequences.
+      int ensembleCapacity_;
+
+      /// Maximum number of samples per sequence.
+      int capacity_;
+
+      /// Actual number of sequences.
+      int nEnsemble_;
+
+      /// Number of samples stored.
+      int nSample_;
+
+      /*
+      * Allocate memory and clear.
+      */
+      void allocate();
+
+      /*
+      * Get one Cartesian component of one stored value.
+      */
+      double component(int sampleId, int k) const
+      {
+         return values_[sampleId*ensembleCapacity_ + k/Dimension]
+                                                    [k%Dimension];
+      }
+
+   };
+
+}
+#endif
@@ -0,0 +1,631 @@
+#ifndef UTIL_MULTI_TAU_AUTO_CORR_ARRAY_H
+#define UTIL_MULTI_TAU_AUTO_CORR_ARRAY_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>       // base class
+#include <util/containers/DArray.h>          // member template
+#include <util/containers/Array.h>
+
+#include <util/accumulators/setToZero.h>
+#include <util/accumulators/product.h>
+#include <util/space/Vector.h>
+#include <util/format/Int.h>
+#include <util/format/Dbl.h>
+
+#include <complex>
+using std::complex;
+
+namespace Util
+{
+
+   /**
+   * Multiple-tau auto-correlation function for an ensemble of sequences.
+   *
+   * This class calculates the same autocorrelation function as
+   * AutoCorrArray, C(j) = <x(i-j), x(i)>, for an ensemble of
+   * statistically equivalent sequences of values of type Data, but
+   * uses the hierarchical (or "multiple-tau") algorithm of AutoCorrStage
+   * to reach long lag times with bounded memory and cost.
+   *
+   * Stage 0 stores the last bufferCapacity values of each sequence, and
+   * computes C(j) for 0 <= j < bufferCapacity. For each n > 0, stage n
+   * stores averages of blocks of blockFactor consecutive values of the
+   * sequence of stage n-1, and so computes C(j) at lags j that are
+   * multiples of blockFactor^n, up to bufferCapacity*blockFactor^n.
+   * Stages are created as needed, up to maxStageId, so that memory is
+   * O(nEnsemble*bufferCapacity*log(T)) after T samples, and the cost
+   * per sample is O(nEnsemble*bufferCapacity), independent of T.
+   *
+   * Values of all sequences are stored together for each stage, in a
+   * ring buffer with a common head, so that sums over the ensemble for
+   * each lag are contiguous loops over memory.
+   *
+   * \ingroup Accumulators_Module
+   */
+   template <typename Data, typename Product>
+   class MultiTauAutoCorrArray : public ParamComposite
+   {
+
+   public:
+
+      /// Default constructor.
+      MultiTauAutoCorrArray();
+
+      /// Default destructor.
+      ~MultiTauAutoCorrArray();
+
+      /**
+      * Read parameters, allocate memory and clear history.
+      *
+      * Reads parameters ensembleCapacity, bufferCapacity, maxStageId
+      * and blockFactor, allocates memory, sets nEnsemble to
+      * ensembleCapacity, and calls clear().
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Set parameters, allocate memory, and clear history.
+      *
+      * \param ensembleCapacity maximum number of sequences in ensemble
+      * \param bufferCapacity   number of values stored per stage
+      * \param maxStageId       maximum stage index (0 = primary)
+      * \param blockFactor      ratio of block sizes of successive stages
+      */
+      void setParam(int ensembleCapacity, int bufferCapacity,
+                    int maxStageId = 20, int blockFactor = 2);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Set actual number of sequences in ensemble.
+      *
+      * \pre readParam() or setParam() must have been called previously
+      * \pre nEnsemble <= ensembleCapacity
+      *
+      * \param nEnsemble actual number of sequences in ensemble
+      */
+      void setNEnsemble(int nEnsemble);
+
+      /**
+      * Reset to empty state, and release all stages above stage 0.
+      */
+      void clear();
+
+      /**
+      * Sample an array of current values.
+      *
+      * \param values Array of current values
+      */
+      void sample(const Array<Data>& values);
+
+      /**
+      * Output the autocorrelation function.
+      *
+      * Each line contains a lag, in units of the sampling interval,
+      * and the corresponding value of the autocorrelation function.
+      */
+      void output(std::ostream& out);
+
+      /**
+      * Serialize to/from an archive.
+      *
+      * \param ar       input or output archive
+      * \param version  file version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
+      /**
+      * Return number of values stored in each stage.
+      */
+      int bufferCapacity() const;
+
+      /**
+      * Return nEnsemble.
+      */
+      int nEnsemble() const;
+
+      /**
+      * Return the number of stages that have been created.
+      */
+      int nStage() const;
+
+      /**
+      * Return the total number of samples per sequence thus far.
+      */
+      long nSample() const;
+
+      /**
+      * Return average of sampled values.
+      */
+      Data average() const;
+
+      /**
+      * Return autocorrelation at a lag that is computed by some stage.
+      *
+      * \param stageId stage index
+      * \param j       lag in units of the stage interval blockFactor^stageId
+      */
+      Product autoCorrelation(int stageId, int j) const;
+
+   private:
+
+      /// Stored values, [stage][slot*ensembleCapacity_ + sequence].
+      DArray< DArray<Data> > buffers_;
+
+      /// Sums of products, [stage][lag].
+      DArray< DArray<Product> > corr_;
+
+      /// Number of products added to each element of corr_.
+      DArray< DArray<long> > nCorr_;
+
+      /// Sums of values in the current block, [stage][sequence].
+      DArray< DArray<Data> > blockSums_;
+
+      /// Index of most recent value in buffer, for each stage.
+      DArray<int> heads_;
+
+      /// Number of values in buffer, for each stage.
+      DArray<int> sizes_;
+
+      /// Number of values in the current block, for each stage.
+      DArray<int> blockCounts_;
+
+      /// Sum of all sampled values.
+      Data sum_;
+
+      /// Maximum number of sequences for which memory is allocated.
+      int ensembleCapacity_;
+
+      /// Number of values stored per stage.
+      int bufferCapacity_;
+
+      /// Maximum stage index.
+      int maxStageId_;
+
+      /// Ratio of block sizes of successive stages.
+      int blockFactor_;
+
+      /// Actual number of sequences.
+      int nEnsemble_;
+
+      /// Number of stages created thus far.
+      int nStage_;
+
+      /// Total number of sampled values per sequence.
+      long nSample_;
+
+      /*
+      * Allocate per-stage arrays, and call clear.
+      */
+      void allocate();
+
+      /*
+      * Allocate arrays indexed by stage, if not already allocated.
+      */
+      void allocateStages();
+
+      /*
+      * Allocate and zero arrays for stage nStage_, and increment nStage_.
+      */
+      void addStage();
+
+      /*
+      * Add values to one stage, and pass block averages to the next.
+      */
+      void sampleStage(int stageId, const Data* values);
+
+      /*
+      * Return the smallest lag index computed by a stage.
+      */
+      int firstLag(int stageId) const;
+
+   };
+
+   /*
+   * Default constructor.
+   */
+   template <typename Data, typename Product>
+   MultiTauAutoCorrArray<Data, Product>::MultiTauAutoCorrArray()
+    : buffers_(),
+      corr_(),
+      nCorr_(),
+      blockSums_(),
+      heads_(),
+      sizes_(),
+      blockCounts_(),
+      ensembleCapacity_(0),
+      bufferCapacity_(0),
+      maxStageId_(0),
+      blockFactor_(2),
+      nEnsemble_(0),
+      nStage_(0),
+      nSample_(0)
+   {
+      setClassName("MultiTauAutoCorrArray");
+      setToZero(sum_);
+   }
+
+   /*
+   * Destructor.
+   */
+   template <typename Data, typename Product>
+   MultiTauAutoCorrArray<Data, Product>::~MultiTauAutoCorrArray()
+   {}
+
+   /*
+   * Read parameters from file.
+   */
+   template <typename Data, typename Product>
+   void MultiTauAutoCorrArray<Data, Product>::readParameters(std::istream& in)
+   {
+      read<int>(in, "ensembleCapacity", ensembleCapacity_);
+      read<int>(in, "bufferCapacity", bufferCapacity_);
+      read<int>(in, "maxStageId", maxStageId_);
+      read<int>(in, "blockFactor", blockFactor_);
+      nEnsemble_ = ensembleCapacity_;
+      allocate();
+   }
+
+   /*
+   * Set parameters and initialize.
+   */
+   template <typename Data, typename Product>
+   void
+   MultiTauAutoCorrArray<Data, Product>::setParam(int ensembleCapacity,
+                                                  int bufferCapacity,
+                                                  int maxStageId,
+                                                  int blockFactor)
+   {
+      ensembleCapacity_ = ensembleCapacity;
+      bufferCapacity_ = bufferCapacity;
+      maxStageId_ = maxStageId;
+      blockFactor_ = blockFactor;
+      nEnsemble_ = ensembleCapacity;
+      allocate();
+   }
+
+   /*
+   * Load internal state from archive.
+   */
+   template <typename Data, typename Product>
+   void
+   MultiTauAutoCorrArray<Data, Product>::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<int>(ar, "ensembleCapacity", ensembleCapacity_);
+      loadParameter<int>(ar, "bufferCapacity", bufferCapacity_);
+      loadParameter<int>(ar, "maxStageId", maxStageId_);
+      loadParameter<int>(ar, "blockFactor", blockFactor_);
+      allocate();
+      ar & nEnsemble_;
+      ar & sum_;
+      ar & nSample_;
+      int nStage;
+      ar & nStage;
+      while (nStage_ < nStage) {
+         addStage();
+      }
+      for (int k = 0; k < nStage_; ++k) {
+         ar & buffers_[k];
+         ar & corr_[k];
+         ar & nCorr_[k];
+         ar & blockSums_[k];
+         ar & heads_[k];
+         ar & sizes_[k];
+         ar & blockCounts_[k];
+      }
+   }
+
+   /*
+   * Save internal state to archive.
+   */
+   template <typename Data, typename Product>
+   void MultiTauAutoCorrArray<Data, Product>::save(Serializable::OArchive &ar)
+   {  ar & *this; }
+
+   /*
+   * Set or reset nEnsemble.
+   */
+   template <typename Data, typename Product>
+   void MultiTauAutoCorrArray<Data, Product>::setNEnsemble(int nEnsemble)
+   {
+      if (ensembleCapacity_ == 0) {
+         UTIL_THROW("No memory has been allocated: ensembleCapacity_ == 0");
+      }
+      if (nEnsemble > ensembleCapacity_) {
+         UTIL_THROW("nEnsemble > ensembleCapacity_");
+      }
+      nEnsemble_ = nEnsemble;
+   }
+
+   /*
+   * Set accumulator to initial empty state.
+   */
+   template <typename Data, typename Product>
+   void MultiTauAutoCorrArray<Data, Product>::clear()
+   {
+      setToZero(sum_);
+      nSample_ = 0;
+      for (int k = 0; k < nStage_; ++k) {
+         buffers_[k].deallocate();
+         corr_[k].deallocate();
+         nCorr_[k].deallocate();
+         blockSums_[k].deallocate();
+      }
+      nStage_ = 0;
+      if (bufferCapacity_ > 0) {
+         addStage();
+      }
+   }
+
+   /*
+   * Allocate arrays of stages (private).
+   */
+   template <typename Data, typename Product>
+   void MultiTauAutoCorrArray<Data, Product>::allocate()
+   {
+      if (bufferCapacity_ <= 0) {
+         UTIL_THROW("bufferCapacity must be positive");
+      }
+      if (maxStageId_ < 0) {
+         UTIL_THROW("Negative maxStageId");
+      }
+      if (blockFactor_ < 2 || blockFactor_ > bufferCapacity_) {
+         UTIL_THROW("blockFactor must satisfy 2 <= blockFactor <= bufferCapacity");
+      }
+      allocateStages();
+      clear();
+   }
+
+   /*
+   * Allocate arrays indexed by stage (private).
+   */
+   template <typename Data, typename Product>
+   void MultiTauAutoCorrArray<Data, Product>::allocateStages()
+   {
+      if (!heads_.isAllocated()) {
+         int n = maxStageId_ + 1;
+         buffers_.allocate(n);
+         corr_.allocate(n);
+         nCorr_.allocate(n);
+         blockSums_.allocate(n);
+         heads_.allocate(n);
+         sizes_.allocate(n);
+         blockCounts_.allocate(n);
+      }
+   }
+
+   /*
+   * Create and zero the next stage (private).
+   */
+   template <typename Data, typename Product>
+   void MultiTauAutoCorrArray<Data, Product>::addStage()
+   {
+      assert(nStage_ <= maxStageId_);
+      const int k = nStage_;
+      int i;
+      buffers_[k].allocate(bufferCapacity_*ensembleCapacity_);
+      corr_[k].allocate(bufferCapacity_);
+      nCorr_[k].allocate(bufferCapacity_);
+      blockSums_[k].allocate(ensembleCapacity_);
+      for (i = 0; i < bufferCapacity_; ++i) {
+         setToZero(corr_[k][i]);
+         nCorr_[k][i] = 0;
+      }
+      for (i = 0; i < ensembleCapacity_; ++i) {
+         setToZero(blockSums_[k][i]);
+      }
+      heads_[k] = bufferCapacity_ - 1;
+      sizes_[k] = 0;
+      blockCounts_[k] = 0;
+      ++nStage_;
+   }
+
+   /*
+   * Return first lag computed by a stage (private).
+   *
+   * Stage k > 0 computes only lags that are not already computed by
+   * stage k-1, i.e., lags j with j*blockFactor > bufferCapacity - 1.
+   */
+   template <typename Data, typename Product>
+   inline
+   int MultiTauAutoCorrArray<Data, Product>::firstLag(int stageId) const
+   {  return (stageId == 0) ? 0 : (bufferCapacity_ - 1)/blockFactor_ + 1; }
+
+   /*
+   * Sample an array of values.
+   */
+   template <typename Data, typename Product>
+   void MultiTauAutoCorrArray<Data, Product>::sample(const Array<Data>& values)
+   {
+      ++nSample_;
+      for (int i = 0; i < nEnsemble_; ++i) {
+         sum_ += values[i];
+      }
+      sampleStage(0, &values[0]);
+   }
+
+   /*
+   * Add values to one stage (private).
+   */
+   template <typename Data, typename Product>
+   void
+   MultiTauAutoCorrArray<Data, Product>::sampleStage(int stageId,
+                                                     const Data* values)
+   {
+      const int n = nEnsemble_;
+      const int p = bufferCapacity_;
+      int i, j, slot;
+
+      // Store values in the next slot of the ring buffer
+      int head = heads_[stageId] + 1;
+      if (head == p) head = 0;
+      heads_[stageId] = head;
+      if (sizes_[stageId] < p) ++sizes_[stageId];
+      Data* buffer = &buffers_[stageId][0];
+      Data* current = buffer + head*ensembleCapacity_;
+      for (i = 0; i < n; ++i) {
+         current[i] = values[i];
+      }
+
+      // Accumulate products with stored values, for each lag
+      const Data* previous;
+      Product sum;
+      DArray<Product>& corr = corr_[stageId];
+      DArray<long>& nCorr = nCorr_[stageId];
+      const int size = sizes_[stageId];
+      for (j = firstLag(stageId); j < size; ++j) {
+         slot = head - j;
+         if (slot < 0) slot += p;
+         previous = buffer + slot*ensembleCapacity_;
+         setToZero(sum);
+         for (i = 0; i < n; ++i) {
+            sum += product(previous[i], values[i]);
+         }
+         corr[j] += sum;
+         ++nCorr[j];
+      }
+
+      // Pass block averages to the next stage
+      if (stageId < maxStageId_) {
+         Data* blockSums = &blockSums_[stageId][0];
+         for (i = 0; i < n; ++i) {
+            blockSums[i] += values[i];
+         }
+         ++blockCounts_[stageId];
+         if (blockCounts_[stageId] == blockFactor_) {
+            for (i = 0; i < n; ++i) {
+               blockSums[i] /= double(blockFactor_);
+            }
+            if (stageId + 1 == nStage_) {
+               addStage();
+            }
+            sampleStage(stageId + 1, blockSums);
+            for (i = 0; i < n; ++i) {
+               setToZero(blockSums[i]);
+            }
+            blockCounts_[stageId] = 0;
+         }
+      }
+   }
+
+   /*
+   * Return capacity of history buffer for each stage.
+   */
+   template <typename Data, typename Product>
+   int MultiTauAutoCorrArray<Data, Product>::bufferCapacity() const
+   {  return bufferCapacity_; }
+
+   /*
+   * Return number of independent sequences.
+   */
+   template <typename Data, typename Product>
+   int MultiTauAutoCorrArray<Data, Product>::nEnsemble() const
+   {  return nEnsemble_; }
+
+   /*
+   * Return number of stages.
+   */
+   template <typename Data, typename Product>
+   int MultiTauAutoCorrArray<Data, Product>::nStage() const
+   {  return nStage_; }
+
+   /*
+   * Return number of sampled values.
+   */
+   template <typename Data, typename Product>
+   long MultiTauAutoCorrArray<Data, Product>::nSample() const
+   {  return nSample_; }
+
+   /*
+   * Return average of sampled values.
+   */
+   template <typename Data, typename Product>
+   Data MultiTauAutoCorrArray<Data, Product>::average() const
+   {
+      Data ave = sum_;
+      ave /= double(nSample_*nEnsemble_);
+      return ave;
+   }
+
+   /*
+   * Return autocorrelation for one stage and lag.
+   */
+   template <typename Data, typename Product>
+   Product
+   MultiTauAutoCorrArray<Data, Product>::autoCorrelation(int stageId, int j)
+   const
+   {
+      assert(stageId < nStage_);
+      assert(j < bufferCapacity_);
+      assert(nCorr_[stageId][j] > 0);
+      Product value = corr_[stageId][j];
+      value /= double(nCorr_[stageId][j]*nEnsemble_);
+      return value;
+   }
+
+   /*
+   * Final output.
+   */
+   template <typename Data, typename Product>
+   void MultiTauAutoCorrArray<Data, Product>::output(std::ostream& out)
+   {
+      long interval = 1;
+      for (int k = 0; k < nStage_; ++k) {
+         for (int j = firstLag(k); j < sizes_[k]; ++j) {
+            out << Int(j*interval) << Dbl(autoCorrelation(k, j)) << std::endl;
+         }
+         interval *= blockFactor_;
+      }
+   }
+
+   /*
+   * Serialize this MultiTauAutoCorrArray.
+   */
+   template <typename Data, typename Product>
+   template <class Archive>
+   void MultiTauAutoCorrArray<Data, Product>::serialize(Archive& ar,
+                                                        const unsigned int version)
+   {
+      ar & ensembleCapacity_;
+      ar & bufferCapacity_;
+      ar & maxStageId_;
+      ar & blockFactor_;
+      allocateStages();
+      ar & nEnsemble_;
+      ar & sum_;
+      ar & nSample_;
+      ar & nStage_;
+      for (int k = 0; k < nStage_; ++k) {
+         ar & buffers_[k];
+         ar & corr_[k];
+         ar & nCorr_[k];
+         ar & blockSums_[k];
+         ar & heads_[k];
+         ar & sizes_[k];
+         ar & blockCounts_[k];
+      }
+   }
+
+}
+#endif
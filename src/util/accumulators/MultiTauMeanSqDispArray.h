@@ -0,0 +1,586 @@
+#ifndef UTIL_MULTI_TAU_MEAN_SQ_DISP_ARRAY_H
+#define UTIL_MULTI_TAU_MEAN_SQ_DISP_ARRAY_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>       // base class
+#include <util/containers/DArray.h>          // member template
+#include <util/containers/Array.h>
+
+#include <util/space/Vector.h>
+#include <util/format/Int.h>
+#include <util/format/Dbl.h>
+
+namespace Util
+{
+
+   /**
+   * Multiple-tau mean-squared displacement for an ensemble of sequences.
+   *
+   * This class calculates the same mean-squared difference as
+   * MeanSqDispArray, <|x(i) - x(i-j)|^2>, for an ensemble of statistically
+   * equivalent sequences, but reaches long lag times with bounded memory
+   * and cost by using a hierarchy of stages.
+   *
+   * Stage 0 stores the last bufferCapacity values of each sequence, and
+   * computes the MSD for 0 <= j < bufferCapacity. For each n > 0, stage
+   * n stores every blockFactor-th value passed to stage n-1, and so
+   * computes the MSD at lags that are multiples of blockFactor^n, up to
+   * bufferCapacity*blockFactor^n. Values are decimated rather than block
+   * averaged (as in MultiTauAutoCorrArray), so the MSD at every output
+   * lag is an exact average over pairs of sampled values, without the
+   * smoothing of a block average. Stages are created as needed, up to
+   * maxStageId, so that memory is O(nEnsemble*bufferCapacity*log(T))
+   * after T samples.
+   *
+   * The meaning of |a - b|^2 is defined for int, double, and Vector data
+   * by explicit specializations of the private method sqDiff().
+   *
+   * \ingroup Accumulators_Module
+   */
+   template <typename Data>
+   class MultiTauMeanSqDispArray : public ParamComposite
+   {
+
+   public:
+
+      /// Constructor.
+      MultiTauMeanSqDispArray();
+
+      /// Destructor.
+      ~MultiTauMeanSqDispArray();
+
+      /**
+      * Read parameters, allocate memory and clear history.
+      *
+      * Reads parameters ensembleCapacity, bufferCapacity, maxStageId
+      * and blockFactor, allocates memory, sets nEnsemble to
+      * ensembleCapacity, and calls clear().
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Set parameters, allocate memory, and clear history.
+      *
+      * \param ensembleCapacity maximum number of sequences in ensemble
+      * \param bufferCapacity   number of values stored per stage
+      * \param maxStageId       maximum stage index (0 = primary)
+      * \param blockFactor      ratio of sampling intervals of stages
+      */
+      void setParam(int ensembleCapacity, int bufferCapacity,
+                    int maxStageId = 20, int blockFactor = 2);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Serialize to/from an archive.
+      *
+      * \param ar       input or output archive
+      * \param version  file version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
+      /**
+      * Set actual number of sequences in ensemble.
+      *
+      * \pre readParameters() or setParam() must have been called previously
+      * \pre nEnsemble <= ensembleCapacity
+      *
+      * \param nEnsemble actual number of sequences in ensemble
+      */
+      void setNEnsemble(int nEnsemble);
+
+      /**
+      * Reset to empty state, and release all stages above stage 0.
+      */
+      void clear();
+
+      /**
+      * Sample an array of current values.
+      *
+      * \param values Array of current values
+      */
+      void sample(const Array<Data>& values);
+
+      /**
+      * Output the mean-squared displacement.
+      *
+      * Each line contains a lag, in units of the sampling interval,
+      * and the corresponding mean-squared displacement.
+      */
+      void output(std::ostream& out);
+
+      /**
+      * Return number of values stored in each stage.
+      */
+      int bufferCapacity() const
+      {  return bufferCapacity_; }
+
+      /**
+      * Return number of sequences in the ensemble.
+      */
+      int nEnsemble() const
+      {  return nEnsemble_; }
+
+      /**
+      * Return the number of stages that have been created.
+      */
+      int nStage() const
+      {  return nStage_; }
+
+      /**
+      * Return number of values sampled from each sequence thus far.
+      */
+      long nSample() const
+      {  return nSample_; }
+
+      /**
+      * Return mean-squared displacement at a lag computed by some stage.
+      *
+      * \param stageId stage index
+      * \param j       lag in units of the stage interval blockFactor^stageId
+      */
+      double meanSqDisp(int stageId, int j) const;
+
+   private:
+
+      /// Stored values, [stage][slot*ensembleCapacity_ + sequence].
+      DArray< DArray<Data> > buffers_;
+
+      /// Sums of square differences, [stage][lag].
+      DArray< DArray<double> > sqDiffSums_;
+
+      /// Number of values added to each element of sqDiffSums_.
+      DArray< DArray<long> > nValues_;
+
+      /// Index of most recent value in buffer, for each stage.
+      DArray<int> heads_;
+
+      /// Number of values in buffer, for each stage.
+      DArray<int> sizes_;
+
+      /// Number of values received since last passed on, for each stage.
+      DArray<int> counts_;
+
+      /// Maximum number of sequences for which memory is allocated.
+      int ensembleCapacity_;
+
+      /// Number of values stored per stage.
+      int bufferCapacity_;
+
+      /// Maximum stage index.
+      int maxStageId_;
+
+      /// Ratio of sampling intervals of successive stages.
+      int blockFactor_;
+
+      /// Actual number of sequences.
+      int nEnsemble_;
+
+      /// Number of stages created thus far.
+      int nStage_;
+
+      /// Total number of sampled values per sequence.
+      long nSample_;
+
+      /*
+      * Allocate per-stage arrays, and call clear.
+      */
+      void allocate();
+
+      /*
+      * Allocate arrays indexed by stage, if not already allocated.
+      */
+      void allocateStages();
+
+      /*
+      * Allocate and zero arrays for stage nStage_, and increment nStage_.
+      */
+      void addStage();
+
+      /*
+      * Add values to one stage, and pass every blockFactor-th to the next.
+      */
+      void sampleStage(int stageId, const Data* values);
+
+      /*
+      * Return the smallest lag index computed by a stage.
+      */
+      int firstLag(int stageId) const
+      {  return (stageId == 0) ? 0 : (bufferCapacity_ - 1)/blockFactor_ + 1; }
+
+      /*
+      * Square difference |data1 - data2|^2 of two Data values.
+      */
+      double sqDiff(const Data& data1, const Data& data2) const;
+
+   };
+
+   /*
+   * Default constructor.
+   */
+   template <typename Data>
+   MultiTauMeanSqDispArray<Data>::MultiTauMeanSqDispArray()
+    : buffers_(),
+      sqDiffSums_(),
+      nValues_(),
+      heads_(),
+      sizes_(),
+      counts_(),
+      ensembleCapacity_(0),
+      bufferCapacity_(0),
+      maxStageId_(0),
+      blockFactor_(2),
+      nEnsemble_(0),
+      nStage_(0),
+      nSample_(0)
+   {  setClassName("MultiTauMeanSqDispArray"); }
+
+   /*
+   * Destructor.
+   */
+   template <typename Data>
+   MultiTauMeanSqDispArray<Data>::~MultiTauMeanSqDispArray()
+   {}
+
+   /*
+   * Read parameters from file.
+   */
+   template <typename Data>
+   void MultiTauMeanSqDispArray<Data>::readParameters(std::istream& in)
+   {
+      read<int>(in, "ensembleCapacity", ensembleCapacity_);
+      read<int>(in, "bufferCapacity", bufferCapacity_);
+      read<int>(in, "maxStageId", maxStageId_);
+      read<int>(in, "blockFactor", blockFactor_);
+      nEnsemble_ = ensembleCapacity_;
+      allocate();
+   }
+
+   /*
+   * Set parameters and initialize.
+   */
+   template <typename Data>
+   void
+   MultiTauMeanSqDispArray<Data>::setParam(int ensembleCapacity,
+                                           int bufferCapacity,
+                                           int maxStageId, int blockFactor)
+   {
+      ensembleCapacity_ = ensembleCapacity;
+      bufferCapacity_ = bufferCapacity;
+      maxStageId_ = maxStageId;
+      blockFactor_ = blockFactor;
+      nEnsemble_ = ensembleCapacity;
+      allocate();
+   }
+
+   /*
+   * Set or reset nEnsemble.
+   */
+   template <typename Data>
+   void MultiTauMeanSqDispArray<Data>::setNEnsemble(int nEnsemble)
+   {
+      if (ensembleCapacity_ == 0) {
+         UTIL_THROW("No memory has been allocated: ensembleCapacity_ == 0");
+      }
+      if (nEnsemble > ensembleCapacity_) {
+         UTIL_THROW("nEnsemble > ensembleCapacity_");
+      }
+      nEnsemble_ = nEnsemble;
+   }
+
+   /*
+   * Load internal state from archive.
+   */
+   template <typename Data>
+   void
+   MultiTauMeanSqDispArray<Data>::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<int>(ar, "ensembleCapacity", ensembleCapacity_);
+      loadParameter<int>(ar, "bufferCapacity", bufferCapacity_);
+      loadParameter<int>(ar, "maxStageId", maxStageId_);
+      loadParameter<int>(ar, "blockFactor", blockFactor_);
+      allocate();
+      ar & nEnsemble_;
+      ar & nSample_;
+      int nStage;
+      ar & nStage;
+      while (nStage_ < nStage) {
+         addStage();
+      }
+      for (int k = 0; k < nStage_; ++k) {
+         ar & buffers_[k];
+         ar & sqDiffSums_[k];
+         ar & nValues_[k];
+         ar & heads_[k];
+         ar & sizes_[k];
+         ar & counts_[k];
+      }
+   }
+
+   /*
+   * Serialize this MultiTauMeanSqDispArray.
+   */
+   template <typename Data>
+   template <class Archive>
+   void MultiTauMeanSqDispArray<Data>::serialize(Archive& ar,
+                                                 const unsigned int version)
+   {
+      ar & ensembleCapacity_;
+      ar & bufferCapacity_;
+      ar & maxStageId_;
+      ar & blockFactor_;
+      allocateStages();
+      ar & nEnsemble_;
+      ar & nSample_;
+      ar & nStage_;
+      for (int k = 0; k < nStage_; ++k) {
+         ar & buffers_[k];
+         ar & sqDiffSums_[k];
+         ar & nValues_[k];
+         ar & heads_[k];
+         ar & sizes_[k];
+         ar & counts_[k];
+      }
+   }
+
+   /*
+   * Save internal state to archive.
+   */
+   template <typename Data>
+   void MultiTauMeanSqDispArray<Data>::save(Serializable::OArchive &ar)
+   {  ar & *this; }
+
+   /*
+   * Set to initial empty state.
+   */
+   template <typename Data>
+   void MultiTauMeanSqDispArray<Data>::clear()
+   {
+      nSample_ = 0;
+      for (int k = 0; k < nStage_; ++k) {
+         buffers_[k].deallocate();
+         sqDiffSums_[k].deallocate();
+         nValues_[k].deallocate();
+      }
+      nStage_ = 0;
+      if (bufferCapacity_ > 0) {
+         addStage();
+      }
+   }
+
+   /*
+   * Allocate arrays of stages (private).
+   */
+   template <typename Data>
+   void MultiTauMeanSqDispArray<Data>::allocate()
+   {
+      if (bufferCapacity_ <= 0) {
+         UTIL_THROW("bufferCapacity must be positive");
+      }
+      if (maxStageId_ < 0) {
+         UTIL_THROW("Negative maxStageId");
+      }
+      if (blockFactor_ < 2 || blockFactor_ > bufferCapacity_) {
+         UTIL_THROW("blockFactor must satisfy 2 <= blockFactor <= bufferCapacity");
+      }
+      allocateStages();
+      clear();
+   }
+
+   /*
+   * Allocate arrays indexed by stage (private).
+   */
+   template <typename Data>
+   void MultiTauMeanSqDispArray<Data>::allocateStages()
+   {
+      if (!heads_.isAllocated()) {
+         int n = maxStageId_ + 1;
+         buffers_.allocate(n);
+         sqDiffSums_.allocate(n);
+         nValues_.allocate(n);
+         heads_.allocate(n);
+         sizes_.allocate(n);
+         counts_.allocate(n);
+      }
+   }
+
+   /*
+   * Create and zero the next stage (private).
+   */
+   template <typename Data>
+   void MultiTauMeanSqDispArray<Data>::addStage()
+   {
+      assert(nStage_ <= maxStageId_);
+      const int k = nStage_;
+      buffers_[k].allocate(bufferCapacity_*ensembleCapacity_);
+      sqDiffSums_[k].allocate(bufferCapacity_);
+      nValues_[k].allocate(bufferCapacity_);
+      for (int i = 0; i < bufferCapacity_; ++i) {
+         sqDiffSums_[k][i] = 0.0;
+         nValues_[k][i] = 0;
+      }
+      heads_[k] = bufferCapacity_ - 1;
+      sizes_[k] = 0;
+      counts_[k] = 0;
+      ++nStage_;
+   }
+
+   /*
+   * Sample an array of values.
+   */
+   template <typename Data>
+   void MultiTauMeanSqDispArray<Data>::sample(const Array<Data>& values)
+   {
+      ++nSample_;
+      sampleStage(0, &values[0]);
+   }
+
+   /*
+   * Add values to one stage (private).
+   */
+   template <typename Data>
+   void
+   MultiTauMeanSqDispArray<Data>::sampleStage(int stageId, const Data* values)
+   {
+      const int n = nEnsemble_;
+      const int p = bufferCapacity_;
+      int i, j, slot;
+
+      // Store values in the next slot of the ring buffer
+      int head = heads_[stageId] + 1;
+      if (head == p) head = 0;
+      heads_[stageId] = head;
+      if (sizes_[stageId] < p) ++sizes_[stageId];
+      Data* buffer = &buffers_[stageId][0];
+      Data* current = buffer + head*ensembleCapacity_;
+      for (i = 0; i < n; ++i) {
+         current[i] = values[i];
+      }
+
+      // Accumulate square differences with stored values, for each lag
+      const Data* previous;
+      double sum;
+      DArray<double>& sqDiffSums = sqDiffSums_[stageId];
+      DArray<long>& nValues = nValues_[stageId];
+      const int size = sizes_[stageId];
+      for (j = firstLag(stageId); j < size; ++j) {
+         slot = head - j;
+         if (slot < 0) slot += p;
+         previous = buffer + slot*ensembleCapacity_;
+         sum = 0.0;
+         for (i = 0; i < n; ++i) {
+            sum += sqDiff(previous[i], values[i]);
+         }
+         sqDiffSums[j] += sum;
+         ++nValues[j];
+      }
+
+      // Pass every blockFactor-th set of values to the next stage
+      if (stageId < maxStageId_) {
+         ++counts_[stageId];
+         if (counts_[stageId] == blockFactor_) {
+            counts_[stageId] = 0;
+            if (stageId + 1 == nStage_) {
+               addStage();
+            }
+            sampleStage(stageId + 1, current);
+         }
+      }
+   }
+
+   /*
+   * Return mean-squared displacement for one stage and lag.
+   */
+   template <typename Data>
+   double MultiTauMeanSqDispArray<Data>::meanSqDisp(int stageId, int j) const
+   {
+      assert(stageId < nStage_);
+      assert(j < bufferCapacity_);
+      assert(nValues_[stageId][j] > 0);
+      return sqDiffSums_[stageId][j]/double(nValues_[stageId][j]*nEnsemble_);
+   }
+
+   /*
+   * Output mean-squared displacement.
+   */
+   template <typename Data>
+   void MultiTauMeanSqDispArray<Data>::output(std::ostream& out)
+   {
+      long interval = 1;
+      for (int k = 0; k < nStage_; ++k) {
+         for (int j = firstLag(k); j < sizes_[k]; ++j) {
+            out << Int(j*interval) << Dbl(meanSqDisp(k, j)) << std::endl;
+         }
+         interval *= blockFactor_;
+      }
+   }
+
+   /**
+   * Square difference for integer data = double(|data1 - data2|^2) .
+   *
+   * \param data1 first integer
+   * \param data2 second integer
+   */
+   template <>
+   inline double
+   MultiTauMeanSqDispArray<int>::sqDiff(const int& data1, const int& data2)
+   const
+   {
+      int diff = data1 - data2;
+      return double(diff*diff);
+   }
+
+   /**
+   * Square difference for double data = |data1 - data2|^2.
+   *
+   * \param data1 first value
+   * \param data2 second value
+   */
+   template <>
+   inline double
+   MultiTauMeanSqDispArray<double>::sqDiff(const double& data1,
+                                           const double& data2) const
+   {
+      double diff = data1 - data2;
+      return diff*diff;
+   }
+
+   /**
+   * Square difference for Vector data = |data1 - data2|^2 .
+   *
+   * \param data1 first vector
+   * \param data2 second vector
+   */
+   template <>
+   inline double
+   MultiTauMeanSqDispArray<Vector>::sqDiff(const Vector& data1,
+                                           const Vector& data2) const
+   {
+      Vector diff;
+      diff.subtract(data1, data2);
+      return diff.square();
+   }
+
+}
+#endif
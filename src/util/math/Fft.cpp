@@ -0,0 +1,200 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "Fft.h"
+#include <util/math/Constants.h>
+
+#include <cmath>
+
+namespace Util
+{
+
+   /*
+   * Constructor.
+   */
+   Fft::Fft()
+    : twiddles_(),
+      twiddleOffsets_(0),
+      line_(),
+      dimensions_(0),
+      size_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   Fft::~Fft()
+   {}
+
+   /*
+   * Set up a one dimensional transform.
+   */
+   void Fft::setup(int n)
+   {
+      IntVector dimensions;
+      for (int i = 0; i < Dimension - 1; ++i) {
+         dimensions[i] = 1;
+      }
+      dimensions[Dimension - 1] = n;
+      setup(dimensions);
+   }
+
+   /*
+   * Set up a three dimensional transform.
+   */
+   void Fft::setup(const IntVector& dimensions)
+   {
+      int i, k, n;
+      int maxDimension = 1;
+      int nTwiddle = 0;
+      size_ = 1;
+      for (i = 0; i < Dimension; ++i) {
+         n = dimensions[i];
+         if (!isPowerOfTwo(n)) {
+            UTIL_THROW("Fft grid dimension is not a power of two");
+         }
+         twiddleOffsets_[i] = nTwiddle;
+         nTwiddle += n/2;
+         if (n > maxDimension) {
+            maxDimension = n;
+         }
+         size_ *= n;
+      }
+
+      // Twiddle factors for all axes, stored consecutively
+      if (twiddles_.isAllocated()) {
+         twiddles_.deallocate();
+      }
+      if (nTwiddle > 0) {
+         twiddles_.allocate(nTwiddle);
+         for (i = 0; i < Dimension; ++i) {
+            n = dimensions[i];
+            for (k = 0; k < n/2; ++k) {
+               twiddles_[twiddleOffsets_[i] + k] =
+                       std::polar(1.0, -2.0*Constants::Pi*double(k)/double(n));
+            }
+         }
+      }
+      dimensions_ = dimensions;
+      if (line_.isAllocated()) {
+         line_.deallocate();
+      }
+      line_.allocate(maxDimension);
+   }
+
+   /*
+   * Compute forward transform in place.
+   */
+   void Fft::forward(DArray< std::complex<double> >& data)
+   {  transform(data, -1); }
+
+   /*
+   * Compute inverse transform in place.
+   */
+   void Fft::inverse(DArray< std::complex<double> >& data)
+   {  transform(data, +1); }
+
+   /*
+   * Is n a positive integer power of two?
+   */
+   bool Fft::isPowerOfTwo(int n)
+   {
+      if (n <= 0) {
+         return false;
+      }
+      return ((n & (n - 1)) == 0);
+   }
+
+   /*
+   * Transform all lines along all axes (private).
+   */
+   void Fft::transform(DArray< std::complex<double> >& data, int sign)
+   {
+      if (size_ == 0) {
+         UTIL_THROW("Fft not set up");
+      }
+      if (data.capacity() < size_) {
+         UTIL_THROW("Data array smaller than Fft grid");
+      }
+
+      std::complex<double>* ptr;
+      int axis, n, stride, nBlock, blockSize, block, offset, k;
+      stride = 1;
+      for (axis = Dimension - 1; axis >= 0; --axis) {
+         n = dimensions_[axis];
+         if (n > 1) {
+            blockSize = n*stride;
+            nBlock = size_/blockSize;
+            for (block = 0; block < nBlock; ++block) {
+               for (offset = 0; offset < stride; ++offset) {
+                  ptr = &data[block*blockSize + offset];
+                  if (stride == 1) {
+                     transformLine(ptr, axis, sign);
+                  } else {
+                     for (k = 0; k < n; ++k) {
+                        line_[k] = ptr[k*stride];
+                     }
+                     transformLine(&line_[0], axis, sign);
+                     for (k = 0; k < n; ++k) {
+                        ptr[k*stride] = line_[k];
+                     }
+                  }
+               }
+            }
+         }
+         stride *= n;
+      }
+   }
+
+   /*
+   * Transform one contiguous line in place (private).
+   */
+   void
+   Fft::transformLine(std::complex<double>* data, int axis, int sign)
+   {
+      const int n = dimensions_[axis];
+      const std::complex<double>* twiddles
+                                 = &twiddles_[twiddleOffsets_[axis]];
+      std::complex<double> t, u, w;
+      int i, j, bit, length, half, step, start, k;
+
+      // Bit reversal permutation
+      j = 0;
+      for (i = 1; i < n; ++i) {
+         bit = n >> 1;
+         while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+         }
+         j ^= bit;
+         if (i < j) {
+            t = data[i];
+            data[i] = data[j];
+            data[j] = t;
+         }
+      }
+
+      // Butterflies
+      for (length = 2; length <= n; length <<= 1) {
+         half = length >> 1;
+         step = n/length;
+         for (start = 0; start < n; start += length) {
+            for (k = 0; k < half; ++k) {
+               w = twiddles[k*step];
+               if (sign > 0) {
+                  w = std::conj(w);
+               }
+               u = data[start + k];
+               t = w*data[start + k + half];
+               data[start + k] = u + t;
+               data[start + k + half] = u - t;
+            }
+         }
+      }
+   }
+
+}
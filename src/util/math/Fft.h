@@ -0,0 +1,146 @@
+#ifndef UTIL_FFT_H
+#define UTIL_FFT_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/DArray.h>
+#include <util/space/IntVector.h>
+#include <util/space/Dimension.h>
+#include <util/global.h>
+
+#include <complex>
+
+namespace Util
+{
+
+   /**
+   * Fast Fourier transform of complex data on a one or three
+   * dimensional grid.
+   *
+   * This class implements an in-place radix-2 Cooley-Tukey algorithm,
+   * and so requires that every grid dimension be a power of two.
+   * Data on a three dimensional grid is stored in a one-dimensional
+   * array, in which the element with grid position (i, j, k) has index
+   * (i*n1 + j)*n2 + k, where n1 and n2 are the dimensions along axes 1
+   * and 2. This is the same ordering as that used by Util::Grid.
+   *
+   * The forward transform computes
+   * \f[
+   *     \hat{f}(m) = \sum_{x} f(x) \exp(-2\pi i m\cdot x/n)
+   * \f]
+   * and the inverse transform uses the opposite sign in the exponent.
+   * Neither transform is normalized, so that applying forward() and
+   * then inverse() multiplies the data by size().
+   *
+   * \ingroup Math_Module
+   */
+   class Fft
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      Fft();
+
+      /**
+      * Destructor.
+      */
+      ~Fft();
+
+      /**
+      * Set up a one dimensional transform of n points.
+      *
+      * \param n number of points (must be a power of two)
+      */
+      void setup(int n);
+
+      /**
+      * Set up a three dimensional transform.
+      *
+      * \param dimensions number of grid points along each axis
+      */
+      void setup(const IntVector& dimensions);
+
+      /**
+      * Compute forward transform in place.
+      *
+      * \param data array of size() complex values
+      */
+      void forward(DArray< std::complex<double> >& data);
+
+      /**
+      * Compute inverse transform in place (not normalized).
+      *
+      * \param data array of size() complex values
+      */
+      void inverse(DArray< std::complex<double> >& data);
+
+      /**
+      * Get grid dimensions (1, 1, n for a one dimensional transform).
+      */
+      const IntVector& dimensions() const;
+
+      /**
+      * Get total number of grid points.
+      */
+      int size() const;
+
+      /**
+      * Is n a positive integer power of two (including 1)?
+      *
+      * \param n integer to test
+      */
+      static bool isPowerOfTwo(int n);
+
+   private:
+
+      /// Twiddle factors exp(-2 pi i k/n) for k < n/2, for all axes.
+      DArray< std::complex<double> > twiddles_;
+
+      /// Index in twiddles_ of the first factor for each axis.
+      IntVector twiddleOffsets_;
+
+      /// Work space for one line of data along a strided axis.
+      DArray< std::complex<double> > line_;
+
+      /// Number of grid points along each axis.
+      IntVector dimensions_;
+
+      /// Total number of grid points.
+      int size_;
+
+      /*
+      * Transform all lines along all axes, with specified sign.
+      */
+      void transform(DArray< std::complex<double> >& data, int sign);
+
+      /*
+      * Transform one contiguous line along an axis in place.
+      */
+      void transformLine(std::complex<double>* data, int axis, int sign);
+
+   };
+
+   // Inline functions
+
+   /*
+   * Get grid dimensions.
+   */
+   inline const IntVector& Fft::dimensions() const
+   {  return dimensions_; }
+
+   /*
+   * Get total number of grid points.
+   */
+   inline int Fft::size() const
+   {  return size_; }
+
+}
+#endif
@@ -0,0 +1,254 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "FourierSum.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace Util
+{
+
+   /*
+   * Constructor.
+   */
+   FourierSum::FourierSum()
+    : waveIntVectors_(),
+      typeWeights_(),
+      basis_(),
+      maxIndex_(0),
+      tableBegin_(0),
+      cosTable_(),
+      sinTable_(),
+      weights_(),
+      re_(),
+      im_(),
+      sumRe_(),
+      sumIm_(),
+      nWave_(0),
+      nMode_(0),
+      nAtomType_(0),
+      nBlock_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   FourierSum::~FourierSum()
+   {}
+
+   /*
+   * Set wavevectors and modes, and allocate memory.
+   */
+   void FourierSum::setup(const DArray<IntVector>& waveIntVectors, int nWave,
+                          const DMatrix<double>& modes)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("FourierSum is already allocated");
+      }
+      if (nWave <= 0) {
+         UTIL_THROW("nWave must be positive");
+      }
+      int i, j, n;
+
+      nWave_ = nWave;
+      nMode_ = modes.capacity1();
+      nAtomType_ = modes.capacity2();
+
+      // Copy wavevectors, and find maximum index along each axis
+      waveIntVectors_.allocate(nWave_);
+      maxIndex_ = IntVector(0);
+      for (i = 0; i < nWave_; ++i) {
+         waveIntVectors_[i] = waveIntVectors[i];
+         for (j = 0; j < Dimension; ++j) {
+            n = std::abs(waveIntVectors[i][j]);
+            if (n > maxIndex_[j]) maxIndex_[j] = n;
+         }
+      }
+
+      // Store mode coefficients by atom type
+      typeWeights_.allocate(nAtomType_*nMode_);
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nMode_; ++j) {
+            typeWeights_[i*nMode_ + j] = modes(j, i);
+         }
+      }
+
+      // Phase tables, with rows n = 0, ..., maxIndex_[j] for each axis.
+      // Row 1 is always allocated, because it is set by addAtom().
+      n = 0;
+      for (j = 0; j < Dimension; ++j) {
+         tableBegin_[j] = n*BlockSize;
+         n += (maxIndex_[j] > 0) ? maxIndex_[j] + 1 : 2;
+      }
+      cosTable_.allocate(n*BlockSize);
+      sinTable_.allocate(n*BlockSize);
+
+      weights_.allocate(nMode_*BlockSize);
+      re_.allocate(BlockSize);
+      im_.allocate(BlockSize);
+      sumRe_.allocate(nWave_*nMode_);
+      sumIm_.allocate(nWave_*nMode_);
+      for (i = 0; i < nWave_*nMode_; ++i) {
+         sumRe_[i] = 0.0;
+         sumIm_[i] = 0.0;
+      }
+      nBlock_ = 0;
+   }
+
+   /*
+   * Zero accumulators and set reciprocal basis vectors.
+   */
+   void FourierSum::clear(const Boundary& boundary)
+   {
+      assert(isAllocated());
+      for (int i = 0; i < nWave_*nMode_; ++i) {
+         sumRe_[i] = 0.0;
+         sumIm_[i] = 0.0;
+      }
+      for (int j = 0; j < Dimension; ++j) {
+         basis_[j] = boundary.reciprocalBasisVector(j);
+      }
+      nBlock_ = 0;
+   }
+
+   /*
+   * Add one particle to the current block.
+   */
+   void FourierSum::addAtom(const Vector& position, int typeId)
+   {
+      assert(isAllocated());
+      assert(typeId >= 0 && typeId < nAtomType_);
+      double theta;
+      int j, k;
+
+      // Row n = 1 of each phase table holds exp(i b_j . r)
+      for (j = 0; j < Dimension; ++j) {
+         theta = basis_[j].dot(position);
+         k = tableBegin_[j] + BlockSize + nBlock_;
+         cosTable_[k] = cos(theta);
+         sinTable_[k] = sin(theta);
+      }
+      const double* typeWeights = &typeWeights_[typeId*nMode_];
+      for (j = 0; j < nMode_; ++j) {
+         weights_[j*BlockSize + nBlock_] = typeWeights[j];
+      }
+
+      ++nBlock_;
+      if (nBlock_ == BlockSize) {
+         flush();
+      }
+   }
+
+   /*
+   * Add contributions of all buffered particles to the sums.
+   */
+   void FourierSum::flush()
+   {
+      const int nb = nBlock_;
+      if (nb == 0) return;
+
+      double* cb;
+      double* sb;
+      double* c0;
+      double* s0;
+      double* c1;
+      double* s1;
+      double* c;
+      double* s;
+      double sign[Dimension];
+      double x, y, sumRe, sumIm;
+      int i, j, k, n, a;
+
+      // Complete phase tables, by recurrence in the index n.
+      for (j = 0; j < Dimension; ++j) {
+         cb = &cosTable_[tableBegin_[j]];
+         sb = &sinTable_[tableBegin_[j]];
+         for (a = 0; a < nb; ++a) {
+            cb[a] = 1.0;
+            sb[a] = 0.0;
+         }
+         c1 = cb + BlockSize;
+         s1 = sb + BlockSize;
+         for (n = 2; n <= maxIndex_[j]; ++n) {
+            c0 = cb + (n-1)*BlockSize;
+            s0 = sb + (n-1)*BlockSize;
+            c = c0 + BlockSize;
+            s = s0 + BlockSize;
+            for (a = 0; a < nb; ++a) {
+               c[a] = c0[a]*c1[a] - s0[a]*s1[a];
+               s[a] = c0[a]*s1[a] + s0[a]*c1[a];
+            }
+         }
+      }
+
+      // Loop over wavevectors
+      const double* cx;
+      const double* sx;
+      const double* cy;
+      const double* sy;
+      const double* cz;
+      const double* sz;
+      const double* w;
+      double* re = &re_[0];
+      double* im = &im_[0];
+      for (i = 0; i < nWave_; ++i) {
+         const IntVector& m = waveIntVectors_[i];
+         for (j = 0; j < Dimension; ++j) {
+            sign[j] = (m[j] < 0) ? -1.0 : 1.0;
+         }
+         cx = &cosTable_[tableBegin_[0] + std::abs(m[0])*BlockSize];
+         sx = &sinTable_[tableBegin_[0] + std::abs(m[0])*BlockSize];
+         cy = &cosTable_[tableBegin_[1] + std::abs(m[1])*BlockSize];
+         sy = &sinTable_[tableBegin_[1] + std::abs(m[1])*BlockSize];
+         cz = &cosTable_[tableBegin_[2] + std::abs(m[2])*BlockSize];
+         sz = &sinTable_[tableBegin_[2] + std::abs(m[2])*BlockSize];
+
+         // Phase factor exp(i k . r) for each particle
+         for (a = 0; a < nb; ++a) {
+            x = cx[a]*cy[a] - sign[0]*sign[1]*sx[a]*sy[a];
+            y = sign[1]*cx[a]*sy[a] + sign[0]*sx[a]*cy[a];
+            re[a] = x*cz[a] - sign[2]*y*sz[a];
+            im[a] = sign[2]*x*sz[a] + y*cz[a];
+         }
+
+         // Weighted sums over particles for each mode
+         for (k = 0; k < nMode_; ++k) {
+            w = &weights_[k*BlockSize];
+            sumRe = 0.0;
+            sumIm = 0.0;
+            for (a = 0; a < nb; ++a) {
+               sumRe += w[a]*re[a];
+               sumIm += w[a]*im[a];
+            }
+            sumRe_[i*nMode_ + k] += sumRe;
+            sumIm_[i*nMode_ + k] += sumIm;
+         }
+      }
+
+      nBlock_ = 0;
+   }
+
+   /*
+   * Complete sums and copy to a matrix of complex values.
+   */
+   void FourierSum::computeModes(DMatrix< std::complex<double> >& modes)
+   {
+      assert(isAllocated());
+      assert(modes.capacity1() >= nWave_);
+      assert(modes.capacity2() >= nMode_);
+      flush();
+      int i, j, k;
+      for (i = 0; i < nWave_; ++i) {
+         for (j = 0; j < nMode_; ++j) {
+            k = i*nMode_ + j;
+            modes(i, j) = std::complex<double>(sumRe_[k], sumIm_[k]);
+         }
+      }
+   }
+
+}
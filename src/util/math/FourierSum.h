@@ -0,0 +1,188 @@
+#ifndef UTIL_FOURIER_SUM_H
+#define UTIL_FOURIER_SUM_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/boundary/Boundary.h>
+#include <util/containers/DArray.h>
+#include <util/containers/DMatrix.h>
+#include <util/containers/FArray.h>
+#include <util/space/IntVector.h>
+#include <util/space/Vector.h>
+#include <util/space/Dimension.h>
+#include <util/global.h>
+
+#include <complex>
+
+namespace Util
+{
+
+   /**
+   * Fourier components of weighted particle densities.
+   *
+   * A FourierSum computes, for each of a set of reciprocal lattice
+   * wavevectors k and each of a set of modes m, the sum
+   * \f[
+   *     \rho_{m}(k) = \sum_{i} v(m, a_i)\exp( i k \cdot r_i )
+   * \f]
+   * over particles i, in which \f$a_i\f$ is the type of particle i and
+   * \f$v(m, a)\f$ is a matrix of mode coefficients. Each wavevector is
+   * specified by an IntVector of Miller indices, so that
+   * \f$k = \sum_{j} n_j b_j\f$, where \f$b_j\f$ are the reciprocal
+   * basis vectors of the Boundary.
+   *
+   * Because \f$\exp(i k\cdot r) = \prod_{j} \exp(i n_j b_j\cdot r)\f$,
+   * the phase factor for every wavevector may be obtained as a product
+   * of one factor per axis. For each particle, the factors
+   * \f$\exp(i n b_j \cdot r)\f$ for all required values of the integer
+   * n are computed by complex multiplication recurrences, so that only
+   * one sine and cosine per axis are evaluated per particle, rather
+   * than one complex exponential per particle and wavevector.
+   *
+   * Particles are buffered in blocks of BlockSize, and the phase tables
+   * and the sums over particles for each wavevector are computed by
+   * loops over the particles of a block, using separate arrays for
+   * real and imaginary parts so that these loops may be vectorized by
+   * the compiler.
+   *
+   * Usage:
+   * \code
+   *    FourierSum sum;
+   *    sum.setup(waveIntVectors, nWave, modes);
+   *
+   *    // For each sample:
+   *    sum.clear(boundary);
+   *    for ( each particle ) {
+   *       sum.addAtom(position, typeId);
+   *    }
+   *    sum.computeModes(fourierModes);
+   * \endcode
+   *
+   * \ingroup Math_Module
+   */
+   class FourierSum
+   {
+
+   public:
+
+      /// Number of particles processed together in one block.
+      static const int BlockSize = 64;
+
+      /**
+      * Constructor.
+      */
+      FourierSum();
+
+      /**
+      * Destructor.
+      */
+      ~FourierSum();
+
+      /**
+      * Set wavevectors and mode coefficients, and allocate memory.
+      *
+      * \param waveIntVectors Miller indices of wavevectors
+      * \param nWave          number of wavevectors
+      * \param modes          mode coefficients (mode index, atom type)
+      */
+      void setup(const DArray<IntVector>& waveIntVectors, int nWave,
+                 const DMatrix<double>& modes);
+
+      /**
+      * Zero all sums and set the reciprocal basis vectors.
+      *
+      * \param boundary current Boundary
+      */
+      void clear(const Boundary& boundary);
+
+      /**
+      * Add the contribution of one particle.
+      *
+      * \param position particle position
+      * \param typeId   particle type index
+      */
+      void addAtom(const Vector& position, int typeId);
+
+      /**
+      * Complete the sums and copy them to a matrix.
+      *
+      * Upon return, modes(i, j) contains the sum for wavevector i and
+      * mode j. The matrix must be allocated with dimensions at least
+      * nWave x nMode.
+      *
+      * \param modes matrix of Fourier components (wave index, mode)
+      */
+      void computeModes(DMatrix< std::complex<double> >& modes);
+
+      /**
+      * Has setup been called?
+      */
+      bool isAllocated() const;
+
+   private:
+
+      /// Miller indices of wavevectors.
+      DArray<IntVector> waveIntVectors_;
+
+      /// Mode coefficients, indexed by typeId*nMode_ + modeId.
+      DArray<double> typeWeights_;
+
+      /// Reciprocal basis vectors of current boundary.
+      FArray<Vector, Dimension> basis_;
+
+      /// Maximum absolute Miller index along each axis.
+      IntVector maxIndex_;
+
+      /// Offset of the phase table for each axis within cosTable_.
+      IntVector tableBegin_;
+
+      /// Real parts of phase factors, maxIndex_ + 1 (>= 2) rows per axis.
+      DArray<double> cosTable_;
+
+      /// Imaginary parts of phase factors, with the same layout.
+      DArray<double> sinTable_;
+
+      /// Mode weights of buffered particles, nMode_ rows of BlockSize.
+      DArray<double> weights_;
+
+      /// Real and imaginary parts of one phase factor per particle.
+      DArray<double> re_;
+      DArray<double> im_;
+
+      /// Accumulated real parts, indexed by waveId*nMode_ + modeId.
+      DArray<double> sumRe_;
+
+      /// Accumulated imaginary parts, with the same layout.
+      DArray<double> sumIm_;
+
+      /// Number of wavevectors.
+      int nWave_;
+
+      /// Number of modes.
+      int nMode_;
+
+      /// Number of atom types.
+      int nAtomType_;
+
+      /// Number of particles in the current block.
+      int nBlock_;
+
+      /*
+      * Add contributions of all buffered particles, and empty buffer.
+      */
+      void flush();
+
+   };
+
+   // Inline function
+
+   inline bool FourierSum::isAllocated() const
+   {  return sumRe_.isAllocated(); }
+
+}
+#endif
@@ -0,0 +1,238 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "GridFourierSum.h"
+#include <util/math/Constants.h>
+#include <util/math/bSpline.h>
+
+#include <cmath>
+#include <cstdlib>
+
+namespace Util
+{
+
+   /*
+   * Constructor.
+   */
+   GridFourierSum::GridFourierSum()
+    : densities_(),
+      transforms_(),
+      factors_(),
+      typeWeights_(),
+      grid_(),
+      fft_(),
+      boundaryPtr_(0),
+      order_(0),
+      nMode_(0),
+      nAtomType_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   GridFourierSum::~GridFourierSum()
+   {}
+
+   /*
+   * Set grid, order and modes, and allocate memory.
+   */
+   void GridFourierSum::setup(const IntVector& gridDimensions, int order,
+                              const DMatrix<double>& modes)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("GridFourierSum is already allocated");
+      }
+      if (order < 2 || order > MaxOrder) {
+         UTIL_THROW("B-spline order must satisfy 2 <= order <= MaxOrder");
+      }
+      int i, j, k, n, m;
+      for (i = 0; i < Dimension; ++i) {
+         if (gridDimensions[i] < order) {
+            UTIL_THROW("Grid dimension less than B-spline order");
+         }
+      }
+      order_ = order;
+      nMode_ = modes.capacity1();
+      nAtomType_ = modes.capacity2();
+      fft_.setup(gridDimensions);
+      grid_.setDimensions(gridDimensions);
+
+      // Store mode coefficients by atom type
+      typeWeights_.allocate(nAtomType_*nMode_);
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nMode_; ++j) {
+            typeWeights_[i*nMode_ + j] = modes(j, i);
+         }
+      }
+
+      densities_.allocate(nMode_);
+      transforms_.allocate(nMode_);
+      for (j = 0; j < nMode_; ++j) {
+         densities_[j].allocate(gridDimensions);
+         transforms_[j].allocate(grid_.size());
+      }
+
+      // Deconvolution factors, b(m) = exp(2 pi i (p-1) m/K)
+      //                               / sum_k M_p(k+1) exp(2 pi i m k/K)
+      double w[MaxOrder];
+      double dw[MaxOrder];
+      bSpline(0.0, order_, w, dw);
+      std::complex<double> sum;
+      double arg;
+      n = 0;
+      for (i = 0; i < Dimension; ++i) {
+         if (gridDimensions[i] > n) n = gridDimensions[i];
+      }
+      factors_.allocate(Dimension, n);
+      for (i = 0; i < Dimension; ++i) {
+         n = gridDimensions[i];
+         for (m = 0; m < n; ++m) {
+            sum = 0.0;
+            for (k = 0; k < order_ - 1; ++k) {
+               arg = 2.0*Constants::Pi*double(m*k)/double(n);
+               sum += w[k+1]*std::complex<double>(cos(arg), sin(arg));
+            }
+            arg = 2.0*Constants::Pi*double((order_ - 1)*m)/double(n);
+            factors_(i, m) = std::complex<double>(cos(arg), sin(arg))/sum;
+         }
+      }
+   }
+
+   /*
+   * Zero density grids and set boundary.
+   */
+   void GridFourierSum::clear(const Boundary& boundary)
+   {
+      assert(isAllocated());
+      const int size = grid_.size();
+      for (int j = 0; j < nMode_; ++j) {
+         GridArray<double>& density = densities_[j];
+         for (int i = 0; i < size; ++i) {
+            density[i] = 0.0;
+         }
+      }
+      boundaryPtr_ = &boundary;
+   }
+
+   /*
+   * Assign one particle to all mode density grids.
+   */
+   void GridFourierSum::addAtom(const Vector& position, int typeId)
+   {
+      assert(isAllocated());
+      assert(boundaryPtr_);
+      assert(typeId >= 0 && typeId < nAtomType_);
+      double w[Dimension][MaxOrder];
+      double dw[Dimension][MaxOrder];
+      int index[Dimension][MaxOrder];
+      Vector r;
+      double u;
+      int i, j, n, iu;
+
+      // B-spline weights and grid indices along each axis
+      boundaryPtr_->transformCartToGen(position, r);
+      for (i = 0; i < Dimension; ++i) {
+         n = grid_.dimension(i);
+         u = double(n)*(r[i] - floor(r[i]));
+         iu = int(u);
+         if (iu >= n) {
+            iu -= n;
+            u -= double(n);
+         }
+         bSpline(u - double(iu), order_, w[i], dw[i]);
+         for (j = 0; j < order_; ++j) {
+            index[i][j] = iu - j < 0 ? iu - j + n : iu - j;
+         }
+      }
+
+      const int n1 = grid_.dimension(1);
+      const int n2 = grid_.dimension(2);
+      const double* typeWeights = &typeWeights_[typeId*nMode_];
+      double q0, q01;
+      int j0, j1, j2, k0, k01;
+      for (int m = 0; m < nMode_; ++m) {
+         if (typeWeights[m] == 0.0) continue;
+         GridArray<double>& density = densities_[m];
+         for (j0 = 0; j0 < order_; ++j0) {
+            q0 = typeWeights[m]*w[0][j0];
+            k0 = index[0][j0]*n1;
+            for (j1 = 0; j1 < order_; ++j1) {
+               q01 = q0*w[1][j1];
+               k01 = (k0 + index[1][j1])*n2;
+               for (j2 = 0; j2 < order_; ++j2) {
+                  density[k01 + index[2][j2]] += q01*w[2][j2];
+               }
+            }
+         }
+      }
+   }
+
+   /*
+   * Fourier transform all mode densities.
+   */
+   void GridFourierSum::transform()
+   {
+      assert(isAllocated());
+      const int size = grid_.size();
+      for (int j = 0; j < nMode_; ++j) {
+         GridArray<double>& density = densities_[j];
+         DArray< std::complex<double> >& data = transforms_[j];
+         for (int i = 0; i < size; ++i) {
+            data[i] = std::complex<double>(density[i], 0.0);
+         }
+         // Inverse (unnormalized) transform has the sign of exp(i k.r)
+         fft_.inverse(data);
+      }
+   }
+
+   /*
+   * Return one deconvolved Fourier component.
+   */
+   std::complex<double>
+   GridFourierSum::mode(const IntVector& waveIntVector, int modeId) const
+   {
+      assert(isAllocated());
+      IntVector position;
+      std::complex<double> b(1.0, 0.0);
+      int n, m;
+      for (int i = 0; i < Dimension; ++i) {
+         n = grid_.dimension(i);
+         m = waveIntVector[i];
+         assert(2*std::abs(m) < n);
+         if (m < 0) m += n;
+         position[i] = m;
+         b *= factors_(i, m);
+      }
+      return b*transforms_[modeId][grid_.rank(position)];
+   }
+
+   /*
+   * Transform, and copy components for a list of wavevectors.
+   */
+   void GridFourierSum::computeModes(const DArray<IntVector>& waveIntVectors,
+                                     int nWave,
+                                     DMatrix< std::complex<double> >& modes)
+   {
+      assert(modes.capacity1() >= nWave);
+      assert(modes.capacity2() >= nMode_);
+      int i, j;
+      for (i = 0; i < nWave; ++i) {
+         for (j = 0; j < Dimension; ++j) {
+            if (2*std::abs(waveIntVectors[i][j]) >= grid_.dimension(j)) {
+               UTIL_THROW("Miller index not below Nyquist index of grid");
+            }
+         }
+      }
+      transform();
+      for (i = 0; i < nWave; ++i) {
+         for (j = 0; j < nMode_; ++j) {
+            modes(i, j) = mode(waveIntVectors[i], j);
+         }
+      }
+   }
+
+}
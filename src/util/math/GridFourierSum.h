@@ -0,0 +1,215 @@
+#ifndef UTIL_GRID_FOURIER_SUM_H
+#define UTIL_GRID_FOURIER_SUM_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/math/Fft.h>
+#include <util/boundary/Boundary.h>
+#include <util/containers/DArray.h>
+#include <util/containers/DMatrix.h>
+#include <util/containers/GridArray.h>
+#include <util/space/Grid.h>
+#include <util/space/IntVector.h>
+#include <util/space/Vector.h>
+#include <util/space/Dimension.h>
+#include <util/global.h>
+
+#include <complex>
+
+namespace Util
+{
+
+   /**
+   * Fourier components of weighted particle densities, computed by FFT.
+   *
+   * A GridFourierSum approximates the same sums as a FourierSum,
+   * \f[
+   *     \rho_{m}(k) = \sum_{i} v(m, a_i)\exp( i k \cdot r_i ) ,
+   * \f]
+   * for all reciprocal lattice wavevectors k with Miller indices
+   * \f$|n_j| < K_j/2\f$, where \f$K_j\f$ is the number of grid points
+   * along axis j. Each particle is assigned to a regular grid in
+   * generalized (fractional) coordinates, using cardinal B-spline
+   * weights of a chosen order (order 2 is cloud-in-cell, order 3 is
+   * triangular-shaped-cloud). A 3D FFT of each mode density then gives
+   * all Fourier components at once. The smoothing introduced by the
+   * assignment is removed by dividing by the Fourier transform of the
+   * B-spline along each axis, exactly as in the smooth particle mesh
+   * Ewald method (Essmann et al., J. Chem. Phys. 103, 8577 (1995)).
+   *
+   * The cost per sample is O(N p^3) for assignment of N particles with
+   * a spline of order p, plus O(M log M) per mode for a grid of M points,
+   * rather than O(N nWave) for a direct sum. The remaining aliasing
+   * error in each component is of relative order (2|n_j|/K_j)^p, and
+   * so is smallest for wavevectors well below the Nyquist index
+   * K_j/2 and for higher spline orders.
+   *
+   * The mode density grids may be summed over processors, through the
+   * density() accessor, before transform() is called.
+   *
+   * Usage:
+   * \code
+   *    GridFourierSum sum;
+   *    sum.setup(gridDimensions, order, modes);
+   *
+   *    // For each sample:
+   *    sum.clear(boundary);
+   *    for ( each particle ) {
+   *       sum.addAtom(position, typeId);
+   *    }
+   *    sum.transform();
+   *    rho = sum.mode(waveIntVector, modeId);
+   * \endcode
+   *
+   * \ingroup Math_Module
+   */
+   class GridFourierSum
+   {
+
+   public:
+
+      /// Maximum allowed B-spline order.
+      static const int MaxOrder = 12;
+
+      /**
+      * Constructor.
+      */
+      GridFourierSum();
+
+      /**
+      * Destructor.
+      */
+      ~GridFourierSum();
+
+      /**
+      * Set grid, assignment order and mode coefficients, and allocate.
+      *
+      * Each grid dimension must be a power of 2 (a restriction of
+      * Util::Fft) and no less than the order.
+      *
+      * \param gridDimensions number of grid points along each axis
+      * \param order          B-spline order, 2 <= order <= MaxOrder
+      * \param modes          mode coefficients (mode index, atom type)
+      */
+      void setup(const IntVector& gridDimensions, int order,
+                 const DMatrix<double>& modes);
+
+      /**
+      * Zero all density grids, and set the boundary.
+      *
+      * \param boundary current Boundary (retained by pointer)
+      */
+      void clear(const Boundary& boundary);
+
+      /**
+      * Assign one particle to the density grids of all modes.
+      *
+      * \param position particle position
+      * \param typeId   particle type index
+      */
+      void addAtom(const Vector& position, int typeId);
+
+      /**
+      * Fourier transform the density grids of all modes.
+      */
+      void transform();
+
+      /**
+      * Return a Fourier component, after transform().
+      *
+      * \param waveIntVector Miller indices, with 2|n_j| < K_j
+      * \param modeId        mode index
+      */
+      std::complex<double> mode(const IntVector& waveIntVector,
+                                int modeId) const;
+
+      /**
+      * Transform, and copy Fourier components for a list of wavevectors.
+      *
+      * Upon return, modes(i, j) contains the component for wavevector
+      * i and mode j.
+      *
+      * \param waveIntVectors Miller indices of wavevectors
+      * \param nWave          number of wavevectors
+      * \param modes          matrix of Fourier components (wave, mode)
+      */
+      void computeModes(const DArray<IntVector>& waveIntVectors, int nWave,
+                        DMatrix< std::complex<double> >& modes);
+
+      /**
+      * Get the real space density grid for one mode.
+      *
+      * \param modeId mode index
+      */
+      GridArray<double>& density(int modeId);
+
+      /**
+      * Get the grid.
+      */
+      const Grid& grid() const;
+
+      /**
+      * Get the B-spline order.
+      */
+      int order() const;
+
+      /**
+      * Has setup been called?
+      */
+      bool isAllocated() const;
+
+   private:
+
+      /// Density grid for each mode.
+      DArray< GridArray<double> > densities_;
+
+      /// Fourier transform of the density of each mode.
+      DArray< DArray< std::complex<double> > > transforms_;
+
+      /// Deconvolution factors b_j(n) along each axis, factors_(j, n).
+      DMatrix< std::complex<double> > factors_;
+
+      /// Mode coefficients, indexed by typeId*nMode_ + modeId.
+      DArray<double> typeWeights_;
+
+      /// Dimensions and ranks of grid points.
+      Grid grid_;
+
+      /// Fast Fourier transform.
+      Fft fft_;
+
+      /// Pointer to current boundary.
+      const Boundary* boundaryPtr_;
+
+      /// B-spline order.
+      int order_;
+
+      /// Number of modes.
+      int nMode_;
+
+      /// Number of atom types.
+      int nAtomType_;
+
+   };
+
+   // Inline functions
+
+   inline GridArray<double>& GridFourierSum::density(int modeId)
+   {  return densities_[modeId]; }
+
+   inline const Grid& GridFourierSum::grid() const
+   {  return grid_; }
+
+   inline int GridFourierSum::order() const
+   {  return order_; }
+
+   inline bool GridFourierSum::isAllocated() const
+   {  return densities_.isAllocated(); }
+
+}
+#endif
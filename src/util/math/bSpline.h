@@ -0,0 +1,58 @@
+#ifndef UTIL_B_SPLINE_H
+#define UTIL_B_SPLINE_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+namespace Util
+{
+
+   /**
+   * Compute values and derivatives of a cardinal B-spline.
+   *
+   * On return, w[j] = M_p(u + j) and dw[j] = M_p'(u + j) for
+   * j = 0, ..., p-1, where M_p is the cardinal B-spline of order
+   * p = order, which is nonzero only on the interval 0 < x < p.
+   * Order 2 gives linear (cloud-in-cell) interpolation weights.
+   *
+   * \param u     fractional coordinate, 0 <= u < 1
+   * \param order B-spline order p (>= 2)
+   * \param w     array of p values (output)
+   * \param dw    array of p derivatives (output)
+   *
+   * \ingroup Math_Module
+   */
+   inline void bSpline(double u, int order, double* w, double* dw)
+   {
+      double div;
+      int n, j;
+      w[0] = u;
+      w[1] = 1.0 - u;
+      if (order == 2) {
+         dw[0] = 1.0;
+         dw[1] = -1.0;
+         return;
+      }
+      for (n = 3; n <= order; ++n) {
+         if (n == order) {
+            dw[0] = w[0];
+            for (j = 1; j < n - 1; ++j) {
+               dw[j] = w[j] - w[j-1];
+            }
+            dw[n-1] = -w[n-2];
+         }
+         div = 1.0/double(n - 1);
+         w[n-1] = div*(1.0 - u)*w[n-2];
+         for (j = n - 2; j > 0; --j) {
+            w[j] = div*((u + j)*w[j] + (n - u - j)*w[j-1]);
+         }
+         w[0] = div*u*w[0];
+      }
+   }
+
+}
+#endif
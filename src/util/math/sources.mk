@@ -1,4 +1,7 @@
-util_math_=util/math/Constants.cpp 
+util_math_=util/math/Constants.cpp \
+    util/math/Fft.cpp \
+    util/math/FourierSum.cpp \
+    util/math/GridFourierSum.cpp 
 
 util_math_SRCS=$(addprefix $(SRC_DIR)/, $(util_math_))
 util_math_OBJS=$(addprefix $(BLD_DIR)/, $(util_math_:.cpp=.o))
@@ -0,0 +1,114 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "AsyncFileWriter.h"
+#include <util/misc/Log.h>
+
+#include <cstdio>
+
+namespace Util
+{
+
+   /*
+   * Constructor.
+   */
+   AsyncFileWriter::AsyncFileWriter()
+    : front_(std::ios_base::out | std::ios_base::binary),
+      stream_(),
+      back_(),
+      filename_(),
+      isOk_(true)
+   {  stream_.std::ios::rdbuf(&front_); }
+
+   /*
+   * Destructor.
+   */
+   AsyncFileWriter::~AsyncFileWriter()
+   {
+      join();
+      if (!isOk_) {
+         Log::file() << "Failed to write file " << filename_ << std::endl;
+      }
+   }
+
+   /*
+   * Clear front buffer and return associated stream.
+   */
+   std::ofstream& AsyncFileWriter::stream()
+   {
+      front_.str(std::string());
+      stream_.clear();
+      return stream_;
+   }
+
+   /*
+   * Swap buffers and write the back buffer to file.
+   */
+   void AsyncFileWriter::write(const std::string& filename)
+   {
+      wait();
+      if (!stream_.good()) {
+         UTIL_THROW("Error writing to front buffer");
+      }
+      back_ = front_.str();
+      front_.str(std::string());
+      filename_ = filename;
+      #ifdef UTIL_CXX11
+      thread_ = std::thread(&AsyncFileWriter::flush, this);
+      #else
+      flush();
+      wait();
+      #endif
+   }
+
+   /*
+   * Wait for completion of any pending write.
+   */
+   void AsyncFileWriter::wait()
+   {
+      join();
+      if (!isOk_) {
+         isOk_ = true;
+         Log::file() << "Failed to write file " << filename_ << std::endl;
+         UTIL_THROW("Error writing file");
+      }
+   }
+
+   /*
+   * Join the writer thread, if any (private).
+   */
+   void AsyncFileWriter::join()
+   {
+      #ifdef UTIL_CXX11
+      if (thread_.joinable()) {
+         thread_.join();
+      }
+      #endif
+   }
+
+   /*
+   * Write back buffer to a temporary file, then rename (private).
+   */
+   void AsyncFileWriter::flush()
+   {
+      std::string tmpname(filename_);
+      tmpname += ".tmp";
+      std::ofstream out(tmpname.c_str(),
+                        std::ios_base::out | std::ios_base::binary);
+      if (out.is_open()) {
+         out.write(back_.data(), back_.size());
+         out.close();
+         isOk_ = !out.fail();
+         if (isOk_) {
+            isOk_ = (std::rename(tmpname.c_str(), filename_.c_str()) == 0);
+         }
+      } else {
+         isOk_ = false;
+      }
+   }
+
+}
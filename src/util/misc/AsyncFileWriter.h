@@ -0,0 +1,137 @@
+#ifndef UTIL_ASYNC_FILE_WRITER_H
+#define UTIL_ASYNC_FILE_WRITER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/global.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef UTIL_CXX11
+#include <thread>
+#endif
+
+namespace Util
+{
+
+   /**
+   * Double-buffered file writer with atomic replacement of the file.
+   *
+   * Data is first written into an in-memory front buffer, through the
+   * std::ofstream returned by stream(). A subsequent call to write()
+   * moves the contents of the front buffer into a back buffer, writes
+   * the back buffer to a temporary file "filename.tmp", and then
+   * renames the temporary file to "filename". Because rename replaces
+   * an existing file atomically on POSIX file systems, a complete copy
+   * of either the old or the new file exists at all times, even if the
+   * program is killed while a file is being written.
+   *
+   * If UTIL_CXX11 is defined, the back buffer is written to disk by a
+   * background thread, and write() returns as soon as the buffers have
+   * been swapped. Each call to write() or wait() first waits for any
+   * preceding write to finish. If UTIL_CXX11 is not defined, write()
+   * writes the file before returning.
+   *
+   * Typical usage, to write a restart file with a binary archive:
+   * \code
+   *    AsyncFileWriter writer;
+   *    BinaryFileOArchive ar(writer.stream());
+   *    object.save(ar);
+   *    writer.write(filename);
+   * \endcode
+   *
+   * \ingroup Misc_Module
+   */
+   class AsyncFileWriter
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      AsyncFileWriter();
+
+      /**
+      * Destructor.
+      *
+      * Waits for completion of any pending write. A destructor cannot
+      * throw, so a failure of that write is only reported to Log::file().
+      * Owners should call wait() before exiting to detect failures.
+      */
+      ~AsyncFileWriter();
+
+      /**
+      * Clear the front buffer and return a stream that writes to it.
+      *
+      * The returned std::ofstream is not associated with any file, and
+      * should not be opened or closed by the caller.
+      */
+      std::ofstream& stream();
+
+      /**
+      * Write contents of the front buffer to a file.
+      *
+      * Waits for completion of any preceding write, then swaps the
+      * buffers and writes the back buffer to the specified file.
+      *
+      * \param filename path to the file
+      */
+      void write(const std::string& filename);
+
+      /**
+      * Wait for completion of any pending write.
+      *
+      * Throws an Exception if the preceding write failed.
+      */
+      void wait();
+
+   private:
+
+      /// Front buffer, written through stream_.
+      std::stringbuf front_;
+
+      /// Stream associated with the front buffer.
+      std::ofstream stream_;
+
+      /// Back buffer, written to file.
+      std::string back_;
+
+      /// Path to the file being written.
+      std::string filename_;
+
+      /// Did the most recent write succeed?
+      bool isOk_;
+
+      #ifdef UTIL_CXX11
+      /// Background writer thread.
+      std::thread thread_;
+      #endif
+
+      /*
+      * Write back_ to a temporary file, and rename it to filename_.
+      */
+      void flush();
+
+      /*
+      * Join the writer thread, if any.
+      */
+      void join();
+
+      /// Copy constructor - private and not implemented.
+      AsyncFileWriter(const AsyncFileWriter& other);
+
+      /// Assignment - private and not implemented.
+      AsyncFileWriter& operator = (const AsyncFileWriter& other);
+
+   };
+
+}
+#endif
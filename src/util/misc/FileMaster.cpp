@@ -256,15 +256,7 @@ namespace Util
    void 
    FileMaster::openRestartOFile(const std::string& name, std::ofstream& out,
                                 std::ios_base::openmode mode) const
-   {
-      // Construct filename = outputPrefix_ + name
-      std::string filename(rootPrefix_);
-      if (hasDirectoryId_) {
-         filename = directoryIdPrefix_;
-      }
-      filename += name;
-      open(filename, out, mode);
-   }
+   {  open(restartFileName(name), out, mode); }
 
    /*
    * Open an input dat file with specified mode.
@@ -272,6 +264,21 @@ namespace Util
    void
    FileMaster::openInputFile(const std::string& name, std::ifstream& in,
                              std::ios_base::openmode mode) const
+   {  open(inputFileName(name), in, mode); }
+
+   /*
+   * Open an output data file in specified mode.
+   */
+   void
+   FileMaster::openOutputFile(const std::string& name, 
+                              std::ofstream& out, 
+                              std::ios_base::openmode mode) const
+   {  open(outputFileName(name), out, mode); }
+
+   /*
+   * Return path to an input data file.
+   */
+   std::string FileMaster::inputFileName(const std::string& name) const
    {
       // Construct filename = inputPrefix_ + name
       std::string filename(rootPrefix_);
@@ -280,16 +287,13 @@ namespace Util
       }
       filename += inputPrefix_;
       filename += name;
-      open(filename, in, mode);
+      return filename;
    }
 
    /*
-   * Open an output data file in specified mode.
+   * Return path to an output data file.
    */
-   void
-   FileMaster::openOutputFile(const std::string& name, 
-                              std::ofstream& out, 
-                              std::ios_base::openmode mode) const
+   std::string FileMaster::outputFileName(const std::string& name) const
    {
       // Construct path
       std::string filename(rootPrefix_);
@@ -298,8 +302,20 @@ namespace Util
       }
       filename += outputPrefix_;
       filename += name;
+      return filename;
+   }
 
-      open(filename, out, mode);
+   /*
+   * Return path to a restart file.
+   */
+   std::string FileMaster::restartFileName(const std::string& name) const
+   {
+      std::string filename(rootPrefix_);
+      if (hasDirectoryId_) {
+         filename += directoryIdPrefix_;
+      }
+      filename += name;
+      return filename;
    }
 
    /*
@@ -352,6 +352,38 @@ namespace Util
                      std::ios_base::openmode mode = std::ios_base::out) 
       const;
 
+      /**
+      * Return the path to an input file.
+      *
+      * The path is constructed as in openInputFile. This is useful for 
+      * files that are not opened as C++ streams, such as files opened 
+      * for parallel MPI input.
+      *
+      * \param  filename  file name, without any prefix
+      * \return full path: [rootPrefix] + [directoryIdPrefix] + inputPrefix + filename
+      */
+      std::string inputFileName(const std::string& filename) const;
+
+      /**
+      * Return the path to an output file.
+      *
+      * The path is constructed as in openOutputFile.
+      *
+      * \param  filename  file name, without any prefix
+      * \return full path: [rootPrefix] + [directoryIdPrefix] + outputPrefix + filename
+      */
+      std::string outputFileName(const std::string& filename) const;
+
+      /**
+      * Return the path to a restart file.
+      *
+      * The path is constructed as in openRestartIFile.
+      *
+      * \param  name  base file name, without any prefix
+      * \return full path: [rootPrefix] + [directoryIdPrefix] + name
+      */
+      std::string restartFileName(const std::string& name) const;
+
       //@}
       /// \name Control Files
       //@{
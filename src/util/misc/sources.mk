@@ -1,5 +1,6 @@
 
 util_misc_=\
+    util/misc/AsyncFileWriter.cpp \
     util/misc/Bit.cpp \
     util/misc/Exception.cpp \
     util/misc/FileMaster.cpp \
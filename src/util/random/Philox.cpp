@@ -0,0 +1,187 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "Philox.h"
+#include <util/global.h>
+
+namespace Util
+{
+
+   // Philox4x32 multipliers and Weyl sequence key increments.
+   static const Philox::UInt PhiloxM0 = 0xD2511F53u;
+   static const Philox::UInt PhiloxM1 = 0xCD9E8D57u;
+   static const Philox::UInt PhiloxW0 = 0x9E3779B9u;
+   static const Philox::UInt PhiloxW1 = 0xBB67AE85u;
+
+   /*
+   * Default constructor.
+   */
+   Philox::Philox()
+    : seed_(0),
+      stream_(0)
+   {  setSeed(0, 0); }
+
+   /*
+   * Constructor.
+   */
+   Philox::Philox(SeedType seed, UInt stream)
+    : seed_(0),
+      stream_(0)
+   {  setSeed(seed, stream); }
+
+   /*
+   * Set the key from a seed, and set the stream index.
+   */
+   void Philox::setSeed(SeedType seed, UInt stream)
+   {
+      if (sizeof(UInt) != 4) {
+         UTIL_THROW("Philox requires a 32 bit unsigned int");
+      }
+      seed_ = seed;
+      stream_ = stream;
+      key_[0] = UInt(seed & 0xFFFFFFFFul);
+      key_[1] = UInt(((seed >> 16) >> 16) & 0xFFFFFFFFul);
+   }
+
+   /*
+   * Apply 10 Philox rounds to n counters (private).
+   *
+   * Each round maps (c0, c1, c2, c3) to
+   * (hi(M1*c2)^c1^k0, lo(M1*c2), hi(M0*c0)^c3^k1, lo(M0*c0)),
+   * after which the key is incremented by (W0, W1).
+   */
+   void Philox::rounds(UInt* c0, UInt* c1, UInt* c2, UInt* c3, int n) const
+   {
+      unsigned long long p0, p1;
+      UInt k0 = key_[0];
+      UInt k1 = key_[1];
+      int r, i;
+      for (r = 0; r < 10; ++r) {
+         for (i = 0; i < n; ++i) {
+            p0 = (unsigned long long)(PhiloxM0) * c0[i];
+            p1 = (unsigned long long)(PhiloxM1) * c2[i];
+            c0[i] = UInt(p1 >> 32) ^ c1[i] ^ k0;
+            c2[i] = UInt(p0 >> 32) ^ c3[i] ^ k1;
+            c1[i] = UInt(p1);
+            c3[i] = UInt(p0);
+         }
+         k0 += PhiloxW0;
+         k1 += PhiloxW1;
+      }
+   }
+
+   /*
+   * Generate 4 uniform random numbers in (0, 1).
+   */
+   void Philox::uniform(UInt step, UInt id0, UInt id1, double x[]) const
+   {
+      UInt c[4];
+      c[0] = id0;
+      c[1] = id1;
+      c[2] = step;
+      c[3] = stream_;
+      rounds(&c[0], &c[1], &c[2], &c[3], 1);
+      for (int j = 0; j < 4; ++j) {
+         x[j] = toUniform(c[j]);
+      }
+   }
+
+   /*
+   * Generate 4 Gaussian random numbers.
+   */
+   void Philox::gaussian(UInt step, UInt id0, UInt id1, double x[]) const
+   {
+      uniform(step, id0, id1, x);
+      boxMuller(x[0], x[1], x[2], x[3]);
+   }
+
+   /*
+   * Generate one uniform random Vector per id.
+   */
+   void Philox::uniformVectors(UInt step, const int ids[], int n, Vector v[])
+   const
+   {
+      UInt c0[Chunk], c1[Chunk], c2[Chunk], c3[Chunk];
+      int begin, m, i;
+      for (begin = 0; begin < n; begin += Chunk) {
+         m = (n - begin < Chunk) ? n - begin : Chunk;
+         for (i = 0; i < m; ++i) {
+            c0[i] = UInt(ids[begin + i]);
+            c1[i] = 0;
+            c2[i] = step;
+            c3[i] = stream_;
+         }
+         rounds(c0, c1, c2, c3, m);
+         for (i = 0; i < m; ++i) {
+            Vector& r = v[begin + i];
+            r[0] = toUniform(c0[i]);
+            r[1] = toUniform(c1[i]);
+            r[2] = toUniform(c2[i]);
+         }
+      }
+   }
+
+   /*
+   * Generate one Gaussian random Vector per id.
+   */
+   void Philox::gaussianVectors(UInt step, const int ids[], int n, Vector v[])
+   const
+   {
+      UInt c0[Chunk], c1[Chunk], c2[Chunk], c3[Chunk];
+      double x0, x1, x2, x3;
+      int begin, m, i;
+      for (begin = 0; begin < n; begin += Chunk) {
+         m = (n - begin < Chunk) ? n - begin : Chunk;
+         for (i = 0; i < m; ++i) {
+            c0[i] = UInt(ids[begin + i]);
+            c1[i] = 0;
+            c2[i] = step;
+            c3[i] = stream_;
+         }
+         rounds(c0, c1, c2, c3, m);
+         for (i = 0; i < m; ++i) {
+            x0 = toUniform(c0[i]);
+            x1 = toUniform(c1[i]);
+            x2 = toUniform(c2[i]);
+            x3 = toUniform(c3[i]);
+            boxMuller(x0, x1, x2, x3);
+            Vector& r = v[begin + i];
+            r[0] = x0;
+            r[1] = x1;
+            r[2] = x2;
+         }
+      }
+   }
+
+   /*
+   * Generate one Gaussian random number per unordered pair of ids.
+   */
+   void Philox::gaussianPairs(UInt step, const int ids0[], const int ids1[],
+                              int n, double x[]) const
+   {
+      UInt c0[Chunk], c1[Chunk], c2[Chunk], c3[Chunk];
+      const double twoPi = 6.28318530717958647692;
+      int begin, m, i, a, b;
+      for (begin = 0; begin < n; begin += Chunk) {
+         m = (n - begin < Chunk) ? n - begin : Chunk;
+         for (i = 0; i < m; ++i) {
+            a = ids0[begin + i];
+            b = ids1[begin + i];
+            c0[i] = UInt(a < b ? a : b);
+            c1[i] = UInt(a < b ? b : a);
+            c2[i] = step;
+            c3[i] = stream_;
+         }
+         rounds(c0, c1, c2, c3, m);
+         for (i = 0; i < m; ++i) {
+            x[begin + i] = sqrt(-2.0*log(toUniform(c0[i])))
+                         * cos(twoPi*toUniform(c1[i]));
+         }
+      }
+   }
+
+}
@@ -0,0 +1,240 @@
+#ifndef UTIL_PHILOX_H
+#define UTIL_PHILOX_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/space/Vector.h>
+#include <cmath>
+
+namespace Util
+{
+
+   /**
+   * Counter-based random number generator (Philox4x32-10).
+   *
+   * A counter-based generator has no sequential internal state: each
+   * call maps a 128 bit counter and a 64 bit key to 128 random bits,
+   * using 10 rounds of the Philox4x32 bijection of Salmon et al. (SC11).
+   * The key is set from an integer seed, and the counter is constructed
+   * by the caller from a time step index, one or two particle ids, and
+   * a stream index that distinguishes independent uses. Random numbers
+   * associated with a particular atom or pair at a particular step are
+   * thus reproducible, independent of the order in which atoms or pairs
+   * are visited, of the number of threads, and of the domain
+   * decomposition.
+   *
+   * Each call returns 4 numbers, which may be either uniform or Gaussian.
+   * Batch functions generate values for arrays of atoms or pairs, with
+   * inner loops that the compiler can vectorize.
+   *
+   * Unlike Random, this class does not read its seed from a parameter
+   * file. Users normally copy the seed of a Random object.
+   *
+   * \ingroup Random_Module
+   */
+   class Philox
+   {
+
+   public:
+
+      /// Unsigned 32 bit integer.
+      typedef unsigned int UInt;
+
+      /// Random seed type (as for Random).
+      typedef unsigned long SeedType;
+
+      /**
+      * Default constructor (seed = 0, stream = 0).
+      */
+      Philox();
+
+      /**
+      * Constructor.
+      *
+      * \param seed   seed used to construct the key
+      * \param stream stream index (last word of every counter)
+      */
+      Philox(SeedType seed, UInt stream = 0);
+
+      /**
+      * Set the key from a seed, and set the stream index.
+      *
+      * \param seed   seed used to construct the key
+      * \param stream stream index (last word of every counter)
+      */
+      void setSeed(SeedType seed, UInt stream = 0);
+
+      /**
+      * Generate 128 random bits for one counter.
+      *
+      * \param counter 128 bit counter, as 4 32 bit words
+      * \param result  128 random bits (output)
+      */
+      void generate(const UInt counter[], UInt result[]) const;
+
+      /**
+      * Generate 4 uniform random numbers in (0, 1).
+      *
+      * \param step   time step index
+      * \param id0    first particle id
+      * \param id1    second particle id
+      * \param x      array of 4 uniform random numbers (output)
+      */
+      void uniform(UInt step, UInt id0, UInt id1, double x[]) const;
+
+      /**
+      * Generate 4 Gaussian random numbers with zero mean, unit variance.
+      *
+      * \param step   time step index
+      * \param id0    first particle id
+      * \param id1    second particle id
+      * \param x      array of 4 Gaussian random numbers (output)
+      */
+      void gaussian(UInt step, UInt id0, UInt id1, double x[]) const;
+
+      /**
+      * Generate one Vector of uniform random components in (0,1) per id.
+      *
+      * The value for ids[i] is the same as that returned by uniform()
+      * with id0 = ids[i] and id1 = 0, discarding the last element.
+      *
+      * \param step   time step index
+      * \param ids    array of n particle ids
+      * \param n      number of particles
+      * \param v      array of n random vectors (output)
+      */
+      void uniformVectors(UInt step, const int ids[], int n, Vector v[])
+      const;
+
+      /**
+      * Generate one Vector of Gaussian components per id.
+      *
+      * The value for ids[i] is equal, to within round-off error, to that
+      * returned by gaussian() with id0 = ids[i] and id1 = 0, discarding
+      * the last element.
+      *
+      * \param step   time step index
+      * \param ids    array of n particle ids
+      * \param n      number of particles
+      * \param v      array of n random vectors (output)
+      */
+      void gaussianVectors(UInt step, const int ids[], int n, Vector v[])
+      const;
+
+      /**
+      * Generate one Gaussian random number per unordered pair of ids.
+      *
+      * The counter for each pair uses the smaller id as id0, so that the
+      * value is independent of the order of ids0[i] and ids1[i]. The
+      * value is equal, to within round-off error, to the first element
+      * returned by gaussian() for the same step and ordered pair of ids.
+      *
+      * \param step   time step index
+      * \param ids0   array of n first particle ids
+      * \param ids1   array of n second particle ids
+      * \param n      number of pairs
+      * \param x      array of n Gaussian random numbers (output)
+      */
+      void gaussianPairs(UInt step, const int ids0[], const int ids1[],
+                         int n, double x[]) const;
+
+      /**
+      * Return the seed.
+      */
+      SeedType seed() const;
+
+      /**
+      * Return the stream index.
+      */
+      UInt stream() const;
+
+      /**
+      * Convert 32 random bits to a uniform double in (0, 1).
+      *
+      * \param i random unsigned integer
+      */
+      static double toUniform(UInt i);
+
+   private:
+
+      /// Maximum number of counters processed together in batch functions.
+      static const int Chunk = 64;
+
+      /// Seed.
+      SeedType seed_;
+
+      /// Key words.
+      UInt key_[2];
+
+      /// Stream index.
+      UInt stream_;
+
+      /*
+      * Apply 10 Philox rounds to n counters stored as 4 arrays of words.
+      */
+      void rounds(UInt* c0, UInt* c1, UInt* c2, UInt* c3, int n) const;
+
+      /*
+      * Convert 4 uniform values to 4 Gaussian values (Box-Muller).
+      */
+      static void boxMuller(double& x0, double& x1, double& x2, double& x3);
+
+   };
+
+   // Inline functions
+
+   /*
+   * Generate 128 random bits for one counter.
+   */
+   inline void Philox::generate(const UInt counter[], UInt result[]) const
+   {
+      result[0] = counter[0];
+      result[1] = counter[1];
+      result[2] = counter[2];
+      result[3] = counter[3];
+      rounds(&result[0], &result[1], &result[2], &result[3], 1);
+   }
+
+   /*
+   * Convert 32 random bits to a uniform double in (0, 1).
+   */
+   inline double Philox::toUniform(UInt i)
+   {  return (double(i) + 0.5)*(1.0/4294967296.0); }
+
+   /*
+   * Convert 4 uniform values to 4 Gaussian values (Box-Muller).
+   */
+   inline
+   void Philox::boxMuller(double& x0, double& x1, double& x2, double& x3)
+   {
+      const double twoPi = 6.28318530717958647692;
+      double r, theta;
+      r = sqrt(-2.0*log(x0));
+      theta = twoPi*x1;
+      x0 = r*cos(theta);
+      x1 = r*sin(theta);
+      r = sqrt(-2.0*log(x2));
+      theta = twoPi*x3;
+      x2 = r*cos(theta);
+      x3 = r*sin(theta);
+   }
+
+   /*
+   * Return the seed.
+   */
+   inline Philox::SeedType Philox::seed() const
+   {  return seed_; }
+
+   /*
+   * Return the stream index.
+   */
+   inline Philox::UInt Philox::stream() const
+   {  return stream_; }
+
+}
+#endif
@@ -14,8 +14,9 @@
 #include "containers/ContainersTestComposite.h"
 #include "crystal/CrystalTestComposite.h"
 #include "format/FormatTest.h"
+#include "math/MathTestComposite.h"
 #include "param/serial/ParamTestComposite.h"
-#include "random/RandomTest.h"
+#include "random/RandomTestComposite.h"
 #include "space/SpaceTestComposite.h"
 #include "misc/MiscTestComposite.h"
 
@@ -35,8 +36,9 @@ addChild(new BoundaryTestComposite, "boundary/");
 addChild(new ContainersTestComposite, "containers/");
 addChild(new CrystalTestComposite, "crystal/");
 addChild(new TEST_RUNNER(FormatTest), "format/");
+addChild(new MathTestComposite, "math/");
 addChild(new ParamTestComposite, "param/serial/");
-addChild(new TEST_RUNNER(RandomTest), "random/");
+addChild(new RandomTestComposite, "random/");
 addChild(new SpaceTestComposite, "space/");
 addChild(new MiscTestComposite, "misc/");
 #ifdef UTIL_MPI
@@ -0,0 +1,225 @@
+#ifndef MEAN_SQ_DISP_TEST_H
+#define MEAN_SQ_DISP_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/accumulators/MeanSqDispArray.h>
+#include <util/accumulators/MultiTauMeanSqDispArray.h>
+#include <util/accumulators/FftMeanSqDispArray.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryIArchive.h>
+#include <util/archives/MemoryCounter.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cmath>
+
+using namespace Util;
+
+class MeanSqDispTest : public UnitTest
+{
+
+   /// Random walk trajectories, [sample][sequence].
+   DArray< DArray<Vector> > walks_;
+
+public:
+
+   void setUp();
+   void tearDown();
+
+   void testReadParam();
+   void testMultiTauStageZero();
+   void testMultiTauDrift();
+   void testMultiTauSerialize();
+   void testFft();
+
+};
+
+/*
+* Construct random walks of 4 sequences from steps read from in/data.
+*/
+void MeanSqDispTest::setUp()
+{
+   const int nSequence = 4;
+   std::ifstream dataFile;
+   openInputFile("in/data", dataFile);
+   int m;
+   dataFile >> m;
+   int nSample = m/(nSequence*Dimension);
+   walks_.allocate(nSample);
+   Vector step;
+   for (int i = 0; i < nSample; ++i) {
+      walks_[i].allocate(nSequence);
+      for (int j = 0; j < nSequence; ++j) {
+         dataFile >> step;
+         if (i == 0) {
+            walks_[i][j] = step;
+         } else {
+            walks_[i][j].add(walks_[i-1][j], step);
+         }
+      }
+   }
+   dataFile.close();
+}
+
+void MeanSqDispTest::tearDown()
+{}
+
+void MeanSqDispTest::testReadParam()
+{
+   printMethod(TEST_FUNC);
+
+   MultiTauMeanSqDispArray<Vector> accumulator;
+   std::ifstream paramFile;
+   openInputFile("in/MultiTauMeanSqDispArray", paramFile);
+   accumulator.readParam(paramFile);
+   paramFile.close();
+
+   printEndl();
+   accumulator.writeParam(std::cout);
+   TEST_ASSERT(accumulator.nEnsemble() == 4);
+   TEST_ASSERT(accumulator.nStage() == 1);
+}
+
+/*
+* Stage 0 must reproduce MeanSqDispArray exactly.
+*/
+void MeanSqDispTest::testMultiTauStageZero()
+{
+   printMethod(TEST_FUNC);
+
+   MultiTauMeanSqDispArray<Vector> accumulator;
+   MeanSqDispArray<Vector> reference;
+   accumulator.setParam(4, 16);
+   reference.setParam(4, 16);
+   for (int i = 0; i < walks_.capacity(); ++i) {
+      accumulator.sample(walks_[i]);
+      reference.sample(walks_[i]);
+   }
+
+   std::stringstream out, refOut;
+   accumulator.output(out);
+   reference.output(refOut);
+   std::string line, refLine;
+   for (int j = 0; j < 16; ++j) {
+      std::getline(out, line);
+      std::getline(refOut, refLine);
+      TEST_ASSERT(line == refLine);
+   }
+}
+
+/*
+* For uniform motion x(t) = v t, MSD(lag) = |v|^2 lag^2 at every stage.
+*/
+void MeanSqDispTest::testMultiTauDrift()
+{
+   printMethod(TEST_FUNC);
+
+   MultiTauMeanSqDispArray<Vector> accumulator;
+   accumulator.setParam(3, 8, 6, 2);
+   DArray<Vector> velocities;
+   DArray<Vector> positions;
+   velocities.allocate(3);
+   positions.allocate(3);
+   velocities[0] = Vector(1.0, 0.0, 0.0);
+   velocities[1] = Vector(0.0, -2.0, 0.0);
+   velocities[2] = Vector(1.0, 1.0, 1.0);
+   double v2 = (1.0 + 4.0 + 3.0)/3.0;
+   for (int t = 0; t < 2000; ++t) {
+      for (int i = 0; i < 3; ++i) {
+         positions[i].multiply(velocities[i], double(t));
+      }
+      accumulator.sample(positions);
+   }
+   TEST_ASSERT(accumulator.nStage() == 7);
+
+   long interval = 1;
+   double lag;
+   for (int k = 0; k < accumulator.nStage(); ++k) {
+      for (int j = 4; j < 8; ++j) {
+         lag = double(j*interval);
+         TEST_ASSERT(std::abs(accumulator.meanSqDisp(k, j) - v2*lag*lag)
+                     < 1.0E-8*lag*lag);
+      }
+      interval *= 2;
+   }
+}
+
+void MeanSqDispTest::testMultiTauSerialize()
+{
+   printMethod(TEST_FUNC);
+
+   MultiTauMeanSqDispArray<Vector> accumulator;
+   accumulator.setParam(4, 8);
+   int half = walks_.capacity()/2;
+   int i;
+   for (i = 0; i < half; ++i) {
+      accumulator.sample(walks_[i]);
+   }
+
+   int size = memorySize(accumulator);
+   MemoryOArchive u;
+   u.allocate(size);
+   u << accumulator;
+   TEST_ASSERT(u.cursor() == u.begin() + size);
+
+   MemoryIArchive v;
+   v = u;
+   MultiTauMeanSqDispArray<Vector> clone;
+   v & clone;
+
+   for (i = half; i < walks_.capacity(); ++i) {
+      accumulator.sample(walks_[i]);
+      clone.sample(walks_[i]);
+   }
+   TEST_ASSERT(clone.nStage() == accumulator.nStage());
+   std::stringstream out, cloneOut;
+   accumulator.output(out);
+   clone.output(cloneOut);
+   TEST_ASSERT(out.str() == cloneOut.str());
+}
+
+/*
+* The FFT algorithm must agree with a direct sum over all pairs.
+*/
+void MeanSqDispTest::testFft()
+{
+   printMethod(TEST_FUNC);
+
+   const int nSample = walks_.capacity();
+   FftMeanSqDispArray accumulator;
+   MeanSqDispArray<Vector> reference;
+   accumulator.setParam(4, nSample);
+   reference.setParam(4, nSample);
+   for (int i = 0; i < nSample; ++i) {
+      accumulator.sample(walks_[i]);
+      reference.sample(walks_[i]);
+   }
+
+   DArray<double> msd;
+   accumulator.computeMeanSqDisp(msd);
+
+   std::stringstream refOut;
+   reference.output(refOut);
+   int lag;
+   double value;
+   for (int j = 0; j < nSample; ++j) {
+      refOut >> lag >> value;
+      TEST_ASSERT(lag == j);
+      // Reference values are output with 8 significant digits
+      TEST_ASSERT(std::abs(msd[j] - value) < 1.0E-6*(1.0 + value));
+   }
+}
+
+TEST_BEGIN(MeanSqDispTest)
+TEST_ADD(MeanSqDispTest, testReadParam)
+TEST_ADD(MeanSqDispTest, testMultiTauStageZero)
+TEST_ADD(MeanSqDispTest, testMultiTauDrift)
+TEST_ADD(MeanSqDispTest, testMultiTauSerialize)
+TEST_ADD(MeanSqDispTest, testFft)
+TEST_END(MeanSqDispTest)
+
+#endif
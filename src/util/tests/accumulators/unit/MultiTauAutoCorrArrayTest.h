@@ -0,0 +1,230 @@
+#ifndef MULTI_TAU_AUTOCORR_ARRAY_TEST_H
+#define MULTI_TAU_AUTOCORR_ARRAY_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/accumulators/MultiTauAutoCorrArray.h>
+#include <util/accumulators/AutoCorrArray.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryIArchive.h>
+#include <util/archives/MemoryCounter.h>
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/archives/BinaryFileOArchive.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cmath>
+
+using namespace Util;
+
+class MultiTauAutoCorrArrayTest : public UnitTest
+{
+
+   MultiTauAutoCorrArray<double, double> accumulator_;
+
+public:
+
+   void setUp();
+   void tearDown();
+
+   void readData(MultiTauAutoCorrArray<double, double>& accumulator,
+                 int nSample);
+   void testReadParam();
+   void testSample();
+   void testStageZero();
+   void testConstant();
+   void testSerialize();
+   void testSaveLoad();
+
+};
+
+void MultiTauAutoCorrArrayTest::setUp()
+{
+   std::ifstream paramFile;
+   openInputFile("in/MultiTauAutoCorrArray", paramFile);
+   accumulator_.readParam(paramFile);
+   paramFile.close();
+}
+
+void MultiTauAutoCorrArrayTest::tearDown()
+{}
+
+void MultiTauAutoCorrArrayTest::readData(
+                     MultiTauAutoCorrArray<double, double>& accumulator,
+                     int nSample)
+{
+   DArray<double> data;
+   int i, j, m, n, p;
+
+   std::ifstream dataFile;
+   openInputFile("in/data", dataFile);
+   dataFile >> m;
+   n = accumulator.nEnsemble();
+   data.allocate(n);
+   p = m / n;
+   if (nSample < p) p = nSample;
+   for (i = 0; i < p; ++i) {
+      for (j = 0; j < n; ++j) {
+        dataFile >> data[j];
+      }
+      accumulator.sample(data);
+   }
+   dataFile.close();
+}
+
+void MultiTauAutoCorrArrayTest::testReadParam()
+{
+   printMethod(TEST_FUNC);
+
+   printEndl();
+   accumulator_.writeParam(std::cout);
+   TEST_ASSERT(accumulator_.nStage() == 1);
+   TEST_ASSERT(accumulator_.bufferCapacity() == 16);
+   TEST_ASSERT(accumulator_.nEnsemble() == 4);
+}
+
+void MultiTauAutoCorrArrayTest::testSample()
+{
+   printMethod(TEST_FUNC);
+
+   readData(accumulator_, 250);
+
+   // Stage n is created after 2^n samples
+   TEST_ASSERT(accumulator_.nSample() == 250);
+   TEST_ASSERT(accumulator_.nStage() == 8);
+
+   printEndl();
+   accumulator_.output(std::cout);
+}
+
+/*
+* Stage 0 must reproduce AutoCorrArray exactly.
+*/
+void MultiTauAutoCorrArrayTest::testStageZero()
+{
+   printMethod(TEST_FUNC);
+
+   AutoCorrArray<double, double> reference;
+   reference.setParam(4, 16);
+
+   DArray<double> data;
+   data.allocate(4);
+   std::ifstream dataFile;
+   openInputFile("in/data", dataFile);
+   int i, j, m;
+   dataFile >> m;
+   for (i = 0; i < m/4; ++i) {
+      for (j = 0; j < 4; ++j) {
+        dataFile >> data[j];
+      }
+      accumulator_.sample(data);
+      reference.sample(data);
+   }
+   dataFile.close();
+
+   // Output of stage 0 precedes that of higher stages
+   std::stringstream out, refOut;
+   accumulator_.output(out);
+   reference.output(refOut);
+   std::string line, refLine;
+   for (j = 0; j < 16; ++j) {
+      std::getline(out, line);
+      std::getline(refOut, refLine);
+      TEST_ASSERT(line == refLine);
+   }
+}
+
+/*
+* Block averages of a constant sequence are equal to the constant.
+*/
+void MultiTauAutoCorrArrayTest::testConstant()
+{
+   printMethod(TEST_FUNC);
+
+   MultiTauAutoCorrArray<Vector, double> accumulator;
+   accumulator.setParam(3, 8, 4, 4);
+   DArray<Vector> data;
+   data.allocate(3);
+   for (int i = 0; i < 3; ++i) {
+      data[i] = Vector(1.0, double(i), -2.0);
+   }
+   for (int i = 0; i < 5000; ++i) {
+      accumulator.sample(data);
+   }
+   TEST_ASSERT(accumulator.nStage() == 5);
+   double expected = (5.0 + 6.0 + 9.0)/3.0;
+   for (int k = 0; k < accumulator.nStage(); ++k) {
+      TEST_ASSERT(std::abs(accumulator.autoCorrelation(k, 7) - expected) 
+                  < 1.0E-10);
+   }
+}
+
+void MultiTauAutoCorrArrayTest::testSerialize()
+{
+   printMethod(TEST_FUNC);
+
+   readData(accumulator_, 100);
+
+   int size = memorySize(accumulator_);
+   MemoryOArchive u;
+   u.allocate(size);
+   u << accumulator_;
+   TEST_ASSERT(u.cursor() == u.begin() + size);
+
+   MemoryIArchive v;
+   v = u;
+   MultiTauAutoCorrArray<double, double> clone;
+   v & clone;
+   TEST_ASSERT(clone.nStage() == accumulator_.nStage());
+   TEST_ASSERT(clone.nSample() == accumulator_.nSample());
+
+   // Continue sampling both, and compare
+   readData(accumulator_, 100);
+   readData(clone, 100);
+   TEST_ASSERT(clone.nStage() == accumulator_.nStage());
+   std::stringstream out, cloneOut;
+   accumulator_.output(out);
+   clone.output(cloneOut);
+   TEST_ASSERT(out.str() == cloneOut.str());
+}
+
+void MultiTauAutoCorrArrayTest::testSaveLoad()
+{
+   printMethod(TEST_FUNC);
+
+   readData(accumulator_, 200);
+
+   BinaryFileOArchive u;
+   openOutputFile("binary", u.file());
+   accumulator_.save(u);
+   u.file().close();
+
+   MultiTauAutoCorrArray<double, double> clone;
+   BinaryFileIArchive v;
+   openInputFile("binary", v.file());
+   clone.load(v);
+   v.file().close();
+
+   TEST_ASSERT(clone.nStage() == accumulator_.nStage());
+   TEST_ASSERT(clone.nEnsemble() == accumulator_.nEnsemble());
+   std::stringstream out, cloneOut;
+   accumulator_.output(out);
+   clone.output(cloneOut);
+   TEST_ASSERT(out.str() == cloneOut.str());
+   printEndl();
+   clone.writeParam(std::cout);
+}
+
+TEST_BEGIN(MultiTauAutoCorrArrayTest)
+TEST_ADD(MultiTauAutoCorrArrayTest, testReadParam)
+TEST_ADD(MultiTauAutoCorrArrayTest, testSample)
+TEST_ADD(MultiTauAutoCorrArrayTest, testStageZero)
+TEST_ADD(MultiTauAutoCorrArrayTest, testConstant)
+TEST_ADD(MultiTauAutoCorrArrayTest, testSerialize)
+TEST_ADD(MultiTauAutoCorrArrayTest, testSaveLoad)
+TEST_END(MultiTauAutoCorrArrayTest)
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef FFT_TEST_H
+#define FFT_TEST_H
+
+#include <util/math/Fft.h>
+#include <util/math/Constants.h>
+#include <util/containers/DArray.h>
+#include <util/space/IntVector.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <complex>
+#include <cmath>
+
+using namespace Util;
+
+class FftTest : public UnitTest 
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}
+
+   void testIsPowerOfTwo()
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(Fft::isPowerOfTwo(1));
+      TEST_ASSERT(Fft::isPowerOfTwo(2));
+      TEST_ASSERT(Fft::isPowerOfTwo(64));
+      TEST_ASSERT(!Fft::isPowerOfTwo(0));
+      TEST_ASSERT(!Fft::isPowerOfTwo(12));
+      TEST_ASSERT(!Fft::isPowerOfTwo(-4));
+   }
+
+   void testForward1D()
+   {
+      printMethod(TEST_FUNC);
+
+      // Compare to a direct discrete Fourier transform
+      const int n = 16;
+      DArray< std::complex<double> > data;
+      DArray< std::complex<double> > input;
+      data.allocate(n);
+      input.allocate(n);
+      int j, m;
+      for (j = 0; j < n; ++j) {
+         input[j] = std::complex<double>(cos(0.3*j*j), sin(0.7*j) - 0.2);
+         data[j] = input[j];
+      }
+
+      Fft fft;
+      fft.setup(n);
+      TEST_ASSERT(fft.size() == n);
+      fft.forward(data);
+
+      std::complex<double> sum;
+      double arg;
+      for (m = 0; m < n; ++m) {
+         sum = std::complex<double>(0.0, 0.0);
+         for (j = 0; j < n; ++j) {
+            arg = -2.0*Constants::Pi*double(m*j)/double(n);
+            sum += input[j]*std::polar(1.0, arg);
+         }
+         TEST_ASSERT(std::abs(sum - data[m]) < 1.0E-10);
+      }
+   }
+
+   void testForward3D()
+   {
+      printMethod(TEST_FUNC);
+
+      // Compare to a direct discrete Fourier transform
+      IntVector dimensions(4, 2, 8);
+      int size = 64;
+      DArray< std::complex<double> > data;
+      DArray< std::complex<double> > input;
+      data.allocate(size);
+      input.allocate(size);
+      int i, j;
+      for (i = 0; i < size; ++i) {
+         input[i] = std::complex<double>(sin(1.3*i), cos(0.1*i*i));
+         data[i] = input[i];
+      }
+
+      Fft fft;
+      fft.setup(dimensions);
+      TEST_ASSERT(fft.size() == size);
+      fft.forward(data);
+
+      std::complex<double> sum;
+      double arg;
+      int m0, m1, m2, x0, x1, x2;
+      for (m0 = 0; m0 < 4; ++m0) {
+         for (m1 = 0; m1 < 2; ++m1) {
+            for (m2 = 0; m2 < 8; ++m2) {
+               sum = std::complex<double>(0.0, 0.0);
+               for (x0 = 0; x0 < 4; ++x0) {
+                  for (x1 = 0; x1 < 2; ++x1) {
+                     for (x2 = 0; x2 < 8; ++x2) {
+                        j = (x0*2 + x1)*8 + x2;
+                        arg = double(m0*x0)/4.0 + double(m1*x1)/2.0
+                            + double(m2*x2)/8.0;
+                        arg *= -2.0*Constants::Pi;
+                        sum += input[j]*std::polar(1.0, arg);
+                     }
+                  }
+               }
+               i = (m0*2 + m1)*8 + m2;
+               TEST_ASSERT(std::abs(sum - data[i]) < 1.0E-10);
+            }
+         }
+      }
+   }
+
+   void testInverse()
+   {
+      printMethod(TEST_FUNC);
+
+      IntVector dimensions(8, 4, 4);
+      int size = 128;
+      DArray< std::complex<double> > data;
+      DArray< std::complex<double> > input;
+      data.allocate(size);
+      input.allocate(size);
+      int i;
+      for (i = 0; i < size; ++i) {
+         input[i] = std::complex<double>(cos(0.5*i) + 0.1, sin(0.01*i*i));
+         data[i] = input[i];
+      }
+
+      Fft fft;
+      fft.setup(dimensions);
+      fft.forward(data);
+      fft.inverse(data);
+      for (i = 0; i < size; ++i) {
+         TEST_ASSERT(std::abs(data[i]/double(size) - input[i]) < 1.0E-12);
+      }
+   }
+
+};
+
+TEST_BEGIN(FftTest)
+TEST_ADD(FftTest, testIsPowerOfTwo)
+TEST_ADD(FftTest, testForward1D)
+TEST_ADD(FftTest, testForward3D)
+TEST_ADD(FftTest, testInverse)
+TEST_END(FftTest)
+
+#endif
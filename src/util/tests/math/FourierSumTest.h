@@ -0,0 +1,117 @@
+#ifndef FOURIER_SUM_TEST_H
+#define FOURIER_SUM_TEST_H
+
+#include <util/math/FourierSum.h>
+#include <util/math/Constants.h>
+#include <util/boundary/Boundary.h>
+#include <util/containers/DArray.h>
+#include <util/containers/DMatrix.h>
+#include <util/random/Random.h>
+#include <util/space/Vector.h>
+#include <util/space/IntVector.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <complex>
+#include <cmath>
+
+using namespace Util;
+
+class FourierSumTest : public UnitTest 
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}
+
+   void testSums()
+   {
+      printMethod(TEST_FUNC);
+
+      // Orthorhombic box, and a set of wavevectors of mixed signs
+      Boundary boundary;
+      boundary.setOrthorhombic(Vector(3.0, 4.0, 5.0));
+      const int nWave = 6;
+      DArray<IntVector> waves;
+      waves.allocate(nWave);
+      waves[0] = IntVector(0, 0, 0);
+      waves[1] = IntVector(1, 0, 0);
+      waves[2] = IntVector(0, -2, 0);
+      waves[3] = IntVector(3, 1, -1);
+      waves[4] = IntVector(-4, 2, 5);
+      waves[5] = IntVector(-1, -3, 2);
+
+      // Two atom types, and modes for density and composition
+      const int nMode = 2;
+      const int nAtomType = 2;
+      DMatrix<double> modes;
+      modes.allocate(nMode, nAtomType);
+      modes(0, 0) = 1.0;
+      modes(0, 1) = 1.0;
+      modes(1, 0) = 1.0;
+      modes(1, 1) = -1.0;
+
+      // Random particles (more than one block)
+      const int nAtom = 2*FourierSum::BlockSize + 17;
+      DArray<Vector> positions;
+      DArray<int> typeIds;
+      positions.allocate(nAtom);
+      typeIds.allocate(nAtom);
+      Random random;
+      random.setSeed(8371);
+      int i, j, k;
+      for (i = 0; i < nAtom; ++i) {
+         boundary.randomPosition(random, positions[i]);
+         typeIds[i] = random.uniformInt(0, nAtomType);
+      }
+
+      FourierSum sum;
+      sum.setup(waves, nWave, modes);
+      TEST_ASSERT(sum.isAllocated());
+      DMatrix< std::complex<double> > result;
+      result.allocate(nWave, nMode);
+
+      // Repeat, to check that clear() resets the sums
+      for (int iter = 0; iter < 2; ++iter) {
+         sum.clear(boundary);
+         for (i = 0; i < nAtom; ++i) {
+            sum.addAtom(positions[i], typeIds[i]);
+         }
+         sum.computeModes(result);
+
+         // Compare to direct evaluation of complex exponentials
+         Vector wave, dWave;
+         std::complex<double> expected;
+         double product;
+         for (i = 0; i < nWave; ++i) {
+            wave = Vector::Zero;
+            for (j = 0; j < Dimension; ++j) {
+               dWave = boundary.reciprocalBasisVector(j);
+               dWave *= waves[i][j];
+               wave += dWave;
+            }
+            for (j = 0; j < nMode; ++j) {
+               expected = std::complex<double>(0.0, 0.0);
+               for (k = 0; k < nAtom; ++k) {
+                  product = positions[k].dot(wave);
+                  expected += modes(j, typeIds[k])
+                              *exp(product*Constants::Im);
+               }
+               TEST_ASSERT(std::abs(result(i, j) - expected) < 1.0E-10);
+            }
+         }
+      }
+   }
+
+};
+
+TEST_BEGIN(FourierSumTest)
+TEST_ADD(FourierSumTest, testSums)
+TEST_END(FourierSumTest)
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef GRID_FOURIER_SUM_TEST_H
+#define GRID_FOURIER_SUM_TEST_H
+
+#include <util/math/GridFourierSum.h>
+#include <util/math/FourierSum.h>
+#include <util/boundary/Boundary.h>
+#include <util/containers/DArray.h>
+#include <util/containers/DMatrix.h>
+#include <util/random/Random.h>
+#include <util/space/Vector.h>
+#include <util/space/IntVector.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <complex>
+#include <cmath>
+
+using namespace Util;
+
+class GridFourierSumTest : public UnitTest 
+{
+
+private:
+
+   Boundary boundary_;
+   DArray<IntVector> waves_;
+   DMatrix<double> modes_;
+   DArray<Vector> positions_;
+   DArray<int> typeIds_;
+   DMatrix< std::complex<double> > expected_;
+   int nWave_;
+   int nMode_;
+   int nAtom_;
+
+public:
+
+   void setUp()
+   {
+      // Orthorhombic box, and wavevectors with |n_j| <= 2
+      boundary_.setOrthorhombic(Vector(3.0, 4.0, 5.0));
+      nWave_ = 125;
+      waves_.allocate(nWave_);
+      int h, k, l, i, j;
+      i = 0;
+      for (h = -2; h <= 2; ++h) {
+         for (k = -2; k <= 2; ++k) {
+            for (l = -2; l <= 2; ++l) {
+               waves_[i] = IntVector(h, k, l);
+               ++i;
+            }
+         }
+      }
+
+      // Two atom types, and modes for density and composition
+      nMode_ = 2;
+      modes_.allocate(nMode_, 2);
+      modes_(0, 0) = 1.0;
+      modes_(0, 1) = 1.0;
+      modes_(1, 0) = 1.0;
+      modes_(1, 1) = -1.0;
+
+      // Random particles
+      nAtom_ = 500;
+      positions_.allocate(nAtom_);
+      typeIds_.allocate(nAtom_);
+      Random random;
+      random.setSeed(2915);
+      for (i = 0; i < nAtom_; ++i) {
+         boundary_.randomPosition(random, positions_[i]);
+         typeIds_[i] = random.uniformInt(0, 2);
+      }
+
+      // Reference values from direct sums
+      FourierSum sum;
+      sum.setup(waves_, nWave_, modes_);
+      sum.clear(boundary_);
+      for (i = 0; i < nAtom_; ++i) {
+         sum.addAtom(positions_[i], typeIds_[i]);
+      }
+      expected_.allocate(nWave_, nMode_);
+      sum.computeModes(expected_);
+   }
+
+   void tearDown()
+   {}
+
+   /*
+   * Return the maximum of |rho_grid - rho_direct|/sqrt(N).
+   */
+   double maxError(int order, const IntVector& gridDimensions)
+   {
+      GridFourierSum sum;
+      sum.setup(gridDimensions, order, modes_);
+      TEST_ASSERT(sum.isAllocated());
+      TEST_ASSERT(sum.order() == order);
+      DMatrix< std::complex<double> > result;
+      result.allocate(nWave_, nMode_);
+
+      // Shift some particles by lattice vectors, which has no effect
+      Vector position;
+      int i, j;
+      sum.clear(boundary_);
+      for (i = 0; i < nAtom_; ++i) {
+         position = positions_[i];
+         if (i % 3 == 0) {
+            position[0] += boundary_.lengths()[0];
+            position[2] -= 2.0*boundary_.lengths()[2];
+         }
+         sum.addAtom(position, typeIds_[i]);
+      }
+      sum.computeModes(waves_, nWave_, result);
+
+      double error = 0.0;
+      double diff;
+      for (i = 0; i < nWave_; ++i) {
+         for (j = 0; j < nMode_; ++j) {
+            diff = std::abs(result(i, j) - expected_(i, j));
+            if (diff > error) error = diff;
+         }
+      }
+      return error/sqrt(double(nAtom_));
+   }
+
+   void testZeroWave()
+   {
+      printMethod(TEST_FUNC);
+
+      // B-spline weights sum to one, so rho(0) is exact for any order
+      GridFourierSum sum;
+      sum.setup(IntVector(8, 8, 8), 3, modes_);
+      sum.clear(boundary_);
+      int i;
+      double total = 0.0;
+      for (i = 0; i < nAtom_; ++i) {
+         sum.addAtom(positions_[i], typeIds_[i]);
+         total += modes_(1, typeIds_[i]);
+      }
+      sum.transform();
+      std::complex<double> rho = sum.mode(IntVector(0), 1);
+      TEST_ASSERT(std::abs(rho - std::complex<double>(total, 0.0)) < 1.0E-8);
+   }
+
+   void testCloudInCell()
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(maxError(2, IntVector(32, 32, 64)) < 0.2);
+   }
+
+   void testHighOrder()
+   {
+      printMethod(TEST_FUNC);
+
+      // Error decreases with increasing order and grid size
+      double error4 = maxError(4, IntVector(16, 16, 32));
+      double error6 = maxError(6, IntVector(16, 16, 32));
+      double error6Fine = maxError(6, IntVector(32, 32, 32));
+      TEST_ASSERT(error4 < 1.0E-2);
+      TEST_ASSERT(error6 < error4);
+      TEST_ASSERT(error6Fine < error6);
+      TEST_ASSERT(error6Fine < 1.0E-4);
+   }
+
+};
+
+TEST_BEGIN(GridFourierSumTest)
+TEST_ADD(GridFourierSumTest, testZeroWave)
+TEST_ADD(GridFourierSumTest, testCloudInCell)
+TEST_ADD(GridFourierSumTest, testHighOrder)
+TEST_END(GridFourierSumTest)
+
+#endif
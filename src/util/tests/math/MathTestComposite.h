@@ -0,0 +1,16 @@
+#ifndef MATH_TEST_COMPOSITE_H
+#define MATH_TEST_COMPOSITE_H
+
+#include <test/CompositeTestRunner.h>
+
+#include "FftTest.h"
+#include "FourierSumTest.h"
+#include "GridFourierSumTest.h"
+
+TEST_COMPOSITE_BEGIN(MathTestComposite)
+TEST_COMPOSITE_ADD_UNIT(FftTest);
+TEST_COMPOSITE_ADD_UNIT(FourierSumTest);
+TEST_COMPOSITE_ADD_UNIT(GridFourierSumTest);
+TEST_COMPOSITE_END
+
+#endif
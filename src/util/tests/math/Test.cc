@@ -0,0 +1,7 @@
+#include "MathTestComposite.h"
+
+int main()
+{
+   MathTestComposite runner;
+   runner.run();
+}
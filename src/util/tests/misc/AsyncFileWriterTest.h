@@ -0,0 +1,164 @@
+#ifndef ASYNC_FILE_WRITER_TEST_H
+#define ASYNC_FILE_WRITER_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/misc/AsyncFileWriter.h>
+#include <util/misc/Log.h>
+#include <util/global.h>
+#include <util/archives/BinaryFileOArchive.h>
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/space/Vector.h>
+
+#include <fstream>
+#include <string>
+
+using namespace Util;
+
+class AsyncFileWriterTest : public UnitTest
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}
+
+   void testWrite();
+   void testRewrite();
+   void testFailedWrite();
+   #ifdef UTIL_CXX11
+   void testFailedWriteDestructor();
+   #endif
+
+};
+
+void AsyncFileWriterTest::testWrite()
+{
+   printMethod(TEST_FUNC);
+
+   int i1 = 7;
+   double d1 = 3.5;
+   std::string s1 = "Restart data";
+   Vector v1(1.0, -2.0, 3.0);
+
+   AsyncFileWriter writer;
+   BinaryFileOArchive oar(writer.stream());
+   oar << i1;
+   oar << d1;
+   oar << s1;
+   oar << v1;
+   writer.write(filePrefix() + "async");
+   writer.wait();
+
+   int i2;
+   double d2;
+   std::string s2;
+   Vector v2;
+   BinaryFileIArchive iar;
+   openInputFile("async", iar.file());
+   iar >> i2;
+   iar >> d2;
+   iar >> s2;
+   iar >> v2;
+   iar.file().close();
+
+   TEST_ASSERT(i1 == i2);
+   TEST_ASSERT(d1 == d2);
+   TEST_ASSERT(s1 == s2);
+   TEST_ASSERT(v1 == v2);
+
+   // Temporary file is renamed after writing
+   std::string tmpname = filePrefix() + "async.tmp";
+   std::ifstream tmp(tmpname.c_str());
+   TEST_ASSERT(!tmp.is_open());
+}
+
+void AsyncFileWriterTest::testRewrite()
+{
+   printMethod(TEST_FUNC);
+
+   AsyncFileWriter writer;
+   int i;
+   for (i = 0; i < 3; ++i) {
+      BinaryFileOArchive oar(writer.stream());
+      oar << i;
+      writer.write(filePrefix() + "async");
+   }
+   writer.wait();
+
+   int j;
+   BinaryFileIArchive iar;
+   openInputFile("async", iar.file());
+   iar >> j;
+   TEST_ASSERT(j == 2);
+   iar.file().close();
+}
+
+void AsyncFileWriterTest::testFailedWrite()
+{
+   printMethod(TEST_FUNC);
+
+   std::ofstream logFile;
+   openOutputFile("asyncLog", logFile);
+   Log::setFile(logFile);
+
+   // A write into a missing directory fails. The Exception is thrown 
+   // by wait(), or by write() if the file is written synchronously.
+   int i = 7;
+   AsyncFileWriter writer;
+   BinaryFileOArchive oar(writer.stream());
+   oar << i;
+   bool hasThrown = false;
+   try {
+      writer.write(filePrefix() + "missing/async");
+      writer.wait();
+   } catch (Exception&) {
+      hasThrown = true;
+   }
+   Log::close();
+   TEST_ASSERT(hasThrown);
+}
+
+#ifdef UTIL_CXX11
+void AsyncFileWriterTest::testFailedWriteDestructor()
+{
+   printMethod(TEST_FUNC);
+
+   std::ofstream logFile;
+   openOutputFile("asyncLog", logFile);
+   Log::setFile(logFile);
+
+   // Destroying a writer after a failed write does not throw, but 
+   // reports the failure to the log file.
+   int i = 7;
+   {
+      AsyncFileWriter writer;
+      BinaryFileOArchive oar(writer.stream());
+      oar << i;
+      writer.write(filePrefix() + "missing/async");
+   }
+   Log::close();
+
+   std::ifstream in;
+   openInputFile("asyncLog", in);
+   std::string line;
+   std::getline(in, line);
+   in.close();
+   TEST_ASSERT(line.find("Failed to write file") != std::string::npos);
+}
+#endif
+
+TEST_BEGIN(AsyncFileWriterTest)
+TEST_ADD(AsyncFileWriterTest, testWrite)
+TEST_ADD(AsyncFileWriterTest, testRewrite)
+TEST_ADD(AsyncFileWriterTest, testFailedWrite)
+#ifdef UTIL_CXX11
+TEST_ADD(AsyncFileWriterTest, testFailedWriteDestructor)
+#endif
+TEST_END(AsyncFileWriterTest)
+
+#endif
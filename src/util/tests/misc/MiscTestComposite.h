@@ -7,12 +7,14 @@
 #include "BitTest.h"
 #include "ioUtilTest.h"
 #include "XmlTest.h"
+#include "AsyncFileWriterTest.h"
 
 TEST_COMPOSITE_BEGIN(MiscTestComposite)
 TEST_COMPOSITE_ADD_UNIT(SetableTest);
 TEST_COMPOSITE_ADD_UNIT(BitTest);
 TEST_COMPOSITE_ADD_UNIT(ioUtilTest);
 TEST_COMPOSITE_ADD_UNIT(XmlTest);
+TEST_COMPOSITE_ADD_UNIT(AsyncFileWriterTest);
 TEST_COMPOSITE_END
 
 #endif
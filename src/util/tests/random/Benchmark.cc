@@ -0,0 +1,145 @@
+/*
+* Throughput of Util::Random and Util::Philox.
+*
+* Generates the random components of 3D Langevin-type forces, one
+* Vector per atom for nAtom atoms, for nStep steps, and reports the
+* number of random values generated per second by:
+*
+*   Random::uniform() and Random::gaussian(), called once per component,
+*   Philox::uniform() and Philox::gaussian(), called once per atom, and
+*   Philox::uniformVectors() and gaussianVectors(), called once per step.
+*
+* Usage: Benchmark [nAtom [nStep]]
+*/
+
+#include <util/random/Random.h>
+#include <util/random/Philox.h>
+#include <util/containers/DArray.h>
+#include <util/misc/Timer.h>
+#include <util/format/Dbl.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+
+using namespace Util;
+
+/*
+* Print values per second, and a checksum that prevents optimization.
+*/
+void report(const std::string& name, Timer& timer, double nValue, 
+            double sum)
+{
+   std::cout << name << Dbl(nValue/timer.time(), 14, 4) 
+             << "  values/s   (sum " << sum << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+   int nAtom = 100000;
+   int nStep = 100;
+   if (argc > 1) nAtom = atoi(argv[1]);
+   if (argc > 2) nStep = atoi(argv[2]);
+   const double nValue = double(Dimension)*nAtom*nStep;
+
+   Random random;
+   random.setSeed(728929936);
+   Philox philox(728929936);
+
+   DArray<int> ids;
+   DArray<Vector> v;
+   ids.allocate(nAtom);
+   v.allocate(nAtom);
+   for (int i = 0; i < nAtom; ++i) {
+      ids[i] = i;
+   }
+
+   Timer timer;
+   double sum;
+   double x[4];
+   int i, j, step;
+
+   // Random::uniform
+   sum = 0.0;
+   timer.clear();
+   timer.start();
+   for (step = 0; step < nStep; ++step) {
+      for (i = 0; i < nAtom; ++i) {
+         for (j = 0; j < Dimension; ++j) {
+            v[i][j] = random.uniform();
+         }
+      }
+      sum += v[nAtom-1][0];
+   }
+   timer.stop();
+   report("Random::uniform          ", timer, nValue, sum);
+
+   // Philox::uniform
+   sum = 0.0;
+   timer.clear();
+   timer.start();
+   for (step = 0; step < nStep; ++step) {
+      for (i = 0; i < nAtom; ++i) {
+         philox.uniform(step, i, 0, x);
+         for (j = 0; j < Dimension; ++j) {
+            v[i][j] = x[j];
+         }
+      }
+      sum += v[nAtom-1][0];
+   }
+   timer.stop();
+   report("Philox::uniform          ", timer, nValue, sum);
+
+   // Philox::uniformVectors
+   sum = 0.0;
+   timer.clear();
+   timer.start();
+   for (step = 0; step < nStep; ++step) {
+      philox.uniformVectors(step, &ids[0], nAtom, &v[0]);
+      sum += v[nAtom-1][0];
+   }
+   timer.stop();
+   report("Philox::uniformVectors   ", timer, nValue, sum);
+
+   // Random::gaussian
+   sum = 0.0;
+   timer.clear();
+   timer.start();
+   for (step = 0; step < nStep; ++step) {
+      for (i = 0; i < nAtom; ++i) {
+         for (j = 0; j < Dimension; ++j) {
+            v[i][j] = random.gaussian();
+         }
+      }
+      sum += v[nAtom-1][0];
+   }
+   timer.stop();
+   report("Random::gaussian         ", timer, nValue, sum);
+
+   // Philox::gaussian
+   sum = 0.0;
+   timer.clear();
+   timer.start();
+   for (step = 0; step < nStep; ++step) {
+      for (i = 0; i < nAtom; ++i) {
+         philox.gaussian(step, i, 0, x);
+         for (j = 0; j < Dimension; ++j) {
+            v[i][j] = x[j];
+         }
+      }
+      sum += v[nAtom-1][0];
+   }
+   timer.stop();
+   report("Philox::gaussian         ", timer, nValue, sum);
+
+   // Philox::gaussianVectors
+   sum = 0.0;
+   timer.clear();
+   timer.start();
+   for (step = 0; step < nStep; ++step) {
+      philox.gaussianVectors(step, &ids[0], nAtom, &v[0]);
+      sum += v[nAtom-1][0];
+   }
+   timer.stop();
+   report("Philox::gaussianVectors  ", timer, nValue, sum);
+}
@@ -0,0 +1,156 @@
+#ifndef PHILOX_TEST_H
+#define PHILOX_TEST_H
+
+#include <util/random/Philox.h>
+#include <util/containers/DArray.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <cmath>
+
+using namespace Util;
+
+class PhiloxTest : public UnitTest 
+{
+
+public:
+
+   typedef Philox::UInt UInt;
+
+   void setUp()
+   {  setVerbose(0); }
+
+   void tearDown()
+   {}
+
+   // Compare to known answers from the Random123 reference implementation.
+   void testKnownAnswers() 
+   {
+      printMethod(TEST_FUNC);
+      UInt c[4];
+      UInt r[4];
+
+      Philox p0(0);
+      c[0] = 0; c[1] = 0; c[2] = 0; c[3] = 0;
+      p0.generate(c, r);
+      TEST_ASSERT(r[0] == 0x6627e8d5u);
+      TEST_ASSERT(r[1] == 0xe169c58du);
+      TEST_ASSERT(r[2] == 0xbc57ac4cu);
+      TEST_ASSERT(r[3] == 0x9b00dbd8u);
+
+      // Key words (0xa4093822, 0x299f31d0) require a 64 bit seed
+      if (sizeof(Philox::SeedType) >= 8) {
+         Philox::SeedType seed = 0x299f31d0ul;
+         seed = ((seed << 16) << 16) | 0xa4093822ul;
+         Philox p1(seed);
+         c[0] = 0x243f6a88u; c[1] = 0x85a308d3u; 
+         c[2] = 0x13198a2eu; c[3] = 0x03707344u;
+         p1.generate(c, r);
+         TEST_ASSERT(r[0] == 0xd16cfe09u);
+         TEST_ASSERT(r[1] == 0x94fdccebu);
+         TEST_ASSERT(r[2] == 0x5001e420u);
+         TEST_ASSERT(r[3] == 0x24126ea1u);
+      }
+   }
+
+   // Batch functions must agree with scalar functions. Gaussian values
+   // may differ by round-off if the batch loops use vector math functions.
+   void testBatches() 
+   {
+      printMethod(TEST_FUNC);
+      const int n = 150;
+      Philox philox(8012345, 3);
+      DArray<int> ids0, ids1;
+      DArray<Vector> u, g;
+      DArray<double> x, y;
+      ids0.allocate(n);
+      ids1.allocate(n);
+      u.allocate(n);
+      g.allocate(n);
+      x.allocate(n);
+      y.allocate(n);
+      int i, j;
+      for (i = 0; i < n; ++i) {
+         ids0[i] = 7*i + 2;
+         ids1[i] = (13*i) % 101;
+      }
+      UInt step = 1234;
+      philox.uniformVectors(step, &ids0[0], n, &u[0]);
+      philox.gaussianVectors(step, &ids0[0], n, &g[0]);
+      philox.gaussianPairs(step, &ids0[0], &ids1[0], n, &x[0]);
+      philox.gaussianPairs(step, &ids1[0], &ids0[0], n, &y[0]);
+
+      double a[4];
+      double b[4];
+      UInt lo, hi;
+      for (i = 0; i < n; ++i) {
+         philox.uniform(step, ids0[i], 0, a);
+         philox.gaussian(step, ids0[i], 0, b);
+         for (j = 0; j < Dimension; ++j) {
+            TEST_ASSERT(a[j] == u[i][j]);
+            TEST_ASSERT(std::abs(b[j] - g[i][j]) < 1.0E-10);
+         }
+         lo = ids0[i] < ids1[i] ? ids0[i] : ids1[i];
+         hi = ids0[i] < ids1[i] ? ids1[i] : ids0[i];
+         philox.gaussian(step, lo, hi, b);
+         TEST_ASSERT(std::abs(x[i] - b[0]) < 1.0E-10);
+         TEST_ASSERT(x[i] == y[i]);
+      }
+
+      // Different steps and streams give different values
+      philox.uniform(step + 1, ids0[0], 0, b);
+      TEST_ASSERT(b[0] != u[0][0]);
+      Philox other(8012345, 4);
+      other.uniform(step, ids0[0], 0, b);
+      TEST_ASSERT(b[0] != u[0][0]);
+   }
+
+   // Check first and second moments of uniform and Gaussian values.
+   void testMoments() 
+   {
+      printMethod(TEST_FUNC);
+      Philox philox(56789);
+      const int nSample = 100000;
+      double a[4];
+      double b[4];
+      double sumU = 0.0, sumU2 = 0.0, sumG = 0.0, sumG2 = 0.0;
+      int i, j;
+      for (i = 0; i < nSample; ++i) {
+         philox.uniform(i, 17, 0, a);
+         philox.gaussian(i, 17, 0, b);
+         for (j = 0; j < 4; ++j) {
+            TEST_ASSERT(a[j] > 0.0);
+            TEST_ASSERT(a[j] < 1.0);
+            sumU += a[j];
+            sumU2 += a[j]*a[j];
+            sumG += b[j];
+            sumG2 += b[j]*b[j];
+         }
+      }
+      double m = 4.0*nSample;
+      double aveU = sumU/m;
+      double varU = sumU2/m - aveU*aveU;
+      double aveG = sumG/m;
+      double varG = sumG2/m - aveG*aveG;
+      if (verbose() > 0) {
+         printEndl();
+         std::cout << aveU << "  " << varU << "  " 
+                   << aveG << "  " << varG << std::endl;
+      }
+      // Tolerances are about 5 standard deviations
+      TEST_ASSERT(std::abs(aveU - 0.5) < 0.003);
+      TEST_ASSERT(std::abs(varU - 1.0/12.0) < 0.001);
+      TEST_ASSERT(std::abs(aveG) < 0.01);
+      TEST_ASSERT(std::abs(varG - 1.0) < 0.015);
+   }
+
+};
+
+TEST_BEGIN(PhiloxTest)
+TEST_ADD(PhiloxTest, testKnownAnswers)
+TEST_ADD(PhiloxTest, testBatches)
+TEST_ADD(PhiloxTest, testMoments)
+TEST_END(PhiloxTest)
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef RANDOM_TEST_COMPOSITE_H
+#define RANDOM_TEST_COMPOSITE_H
+
+#include <test/CompositeTestRunner.h>
+
+#include "RandomTest.h"
+#include "PhiloxTest.h"
+
+TEST_COMPOSITE_BEGIN(RandomTestComposite)
+TEST_COMPOSITE_ADD_UNIT(RandomTest);
+TEST_COMPOSITE_ADD_UNIT(PhiloxTest);
+TEST_COMPOSITE_END
+
+#endif
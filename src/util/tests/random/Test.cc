@@ -1,7 +1,7 @@
-#include "RandomTest.h"
+#include "RandomTestComposite.h"
+
 int main()
 {
-   TEST_RUNNER(RandomTest) runner;
+   RandomTestComposite runner;
    runner.run();
 }
-